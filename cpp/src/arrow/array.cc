@@ -343,7 +343,9 @@ DecimalArray::DecimalArray(const std::shared_ptr<DataType>& type, int64_t length
 }
 
 bool DecimalArray::IsNegative(int64_t i) const {
-  return sign_bitmap_data_ != nullptr ? BitUtil::GetBit(sign_bitmap_data_, i) : false;
+  return sign_bitmap_data_ != nullptr
+             ? BitUtil::GetBit(sign_bitmap_data_, i + data_->offset)
+             : false;
 }
 
 const uint8_t* DecimalArray::GetValue(int64_t i) const {
@@ -494,6 +496,87 @@ std::shared_ptr<Array> DictionaryArray::Slice(int64_t offset, int64_t length) co
   return std::make_shared<DictionaryArray>(SliceData(*data_, offset, length));
 }
 
+// ----------------------------------------------------------------------
+// RunEndEncodedArray
+
+RunEndEncodedArray::RunEndEncodedArray(const std::shared_ptr<ArrayData>& data) {
+  DCHECK_EQ(data->type->id(), Type::RUN_END_ENCODED);
+  SetData(data);
+}
+
+RunEndEncodedArray::RunEndEncodedArray(const std::shared_ptr<DataType>& type,
+    int64_t length, const std::shared_ptr<Array>& run_ends,
+    const std::shared_ptr<Array>& values, int64_t offset) {
+  DCHECK_EQ(type->id(), Type::RUN_END_ENCODED);
+  DCHECK_EQ(run_ends->type_id(), Type::INT32);
+  BufferVector buffers = {nullptr};
+  auto internal_data =
+      std::make_shared<ArrayData>(type, length, std::move(buffers), 0, offset);
+  internal_data->child_data = {run_ends->data(), values->data()};
+  SetData(internal_data);
+}
+
+void RunEndEncodedArray::SetData(const std::shared_ptr<ArrayData>& data) {
+  this->Array::SetData(data);
+  DCHECK_EQ(data_->child_data.size(), 2);
+  DCHECK(internal::MakeArray(data_->child_data[0], &run_ends_).ok());
+  DCHECK(internal::MakeArray(data_->child_data[1], &values_).ok());
+  raw_run_ends_ = static_cast<const Int32Array&>(*run_ends_).raw_values();
+}
+
+int64_t RunEndEncodedArray::FindPhysicalIndex(int64_t i) const {
+  const int32_t* end = raw_run_ends_ + run_ends_->length();
+  return std::upper_bound(raw_run_ends_, end, data_->offset + i) - raw_run_ends_;
+}
+
+int64_t RunEndEncodedArray::physical_offset() const {
+  return FindPhysicalIndex(0);
+}
+
+int64_t RunEndEncodedArray::physical_length() const {
+  if (data_->length == 0) { return 0; }
+  return FindPhysicalIndex(data_->length - 1) + 1 - physical_offset();
+}
+
+std::shared_ptr<Array> RunEndEncodedArray::Slice(int64_t offset, int64_t length) const {
+  return std::make_shared<RunEndEncodedArray>(SliceData(*data_, offset, length));
+}
+
+// ----------------------------------------------------------------------
+// BitPackedArray
+
+BitPackedArray::BitPackedArray(const std::shared_ptr<ArrayData>& data) {
+  DCHECK_EQ(data->type->id(), Type::BIT_PACKED);
+  SetData(data);
+}
+
+BitPackedArray::BitPackedArray(const std::shared_ptr<DataType>& type, int64_t length,
+    const std::shared_ptr<Buffer>& data, const std::shared_ptr<Buffer>& null_bitmap,
+    int64_t null_count, int64_t offset) {
+  DCHECK_EQ(type->id(), Type::BIT_PACKED);
+  BufferVector buffers = {null_bitmap, data};
+  SetData(
+      std::make_shared<ArrayData>(type, length, std::move(buffers), null_count, offset));
+}
+
+void BitPackedArray::SetData(const std::shared_ptr<ArrayData>& data) {
+  this->Array::SetData(data);
+  const auto& type = static_cast<const BitPackedType&>(*data_->type);
+  auto values = data_->buffers[1];
+  raw_values_ = values == nullptr ? nullptr : values->data();
+  bit_width_ = type.bit_width();
+  const bool is_signed = static_cast<const Integer&>(*type.value_type()).is_signed();
+  sign_bit_ = is_signed ? uint64_t(1) << (bit_width_ - 1) : 0;
+}
+
+std::shared_ptr<DataType> BitPackedArray::value_type() const {
+  return static_cast<const BitPackedType&>(*data_->type).value_type();
+}
+
+std::shared_ptr<Array> BitPackedArray::Slice(int64_t offset, int64_t length) const {
+  return std::make_shared<BitPackedArray>(SliceData(*data_, offset, length));
+}
+
 // ----------------------------------------------------------------------
 // Implement Array::Accept as inline visitor
 
@@ -625,6 +708,55 @@ struct ValidateVisitor {
     }
     return Status::OK();
   }
+  Status Visit(const RunEndEncodedArray& array) {
+    if (array.length() < 0) { return Status::Invalid("Length was negative"); }
+    if (array.null_count() != 0) {
+      return Status::Invalid("Run-end encoded arrays store nulls in their values");
+    }
+
+    const std::shared_ptr<Array> run_ends = array.run_ends();
+    if (run_ends->type_id() != Type::INT32 || run_ends->null_count() != 0) {
+      return Status::Invalid("Run ends must be non-null int32");
+    }
+    if (array.values()->length() != run_ends->length()) {
+      return Status::Invalid("Run ends and values have different lengths");
+    }
+
+    const int32_t* ends = array.raw_run_ends();
+    int32_t prev_end = 0;
+    for (int64_t i = 0; i < run_ends->length(); ++i) {
+      if (ends[i] <= prev_end) {
+        std::stringstream ss;
+        ss << "Run ends must be positive and strictly increasing, not at run " << i;
+        return Status::Invalid(ss.str());
+      }
+      prev_end = ends[i];
+    }
+    if (array.offset() + array.length() > prev_end) {
+      return Status::Invalid("Run ends do not cover the length of the array");
+    }
+
+    const Status values_valid = ValidateArray(*array.values());
+    if (!values_valid.ok()) {
+      std::stringstream ss;
+      ss << "Values array invalid: " << values_valid.ToString();
+      return Status::Invalid(ss.str());
+    }
+    return Status::OK();
+  }
+
+  Status Visit(const BitPackedArray& array) {
+    if (array.length() < 0) { return Status::Invalid("Length was negative"); }
+    const int64_t needed_bytes =
+        BitUtil::BytesForBits((array.offset() + array.length()) * array.bit_width());
+    if (array.length() > 0 &&
+        (!array.values() || array.values()->size() < needed_bytes)) {
+      std::stringstream ss;
+      ss << "Packed data holds fewer than " << needed_bytes << " bytes";
+      return Status::Invalid(ss.str());
+    }
+    return Status::OK();
+  }
 };
 
 Status ValidateArray(const Array& array) {
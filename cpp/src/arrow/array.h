@@ -673,6 +673,103 @@ class ARROW_EXPORT DictionaryArray : public Array {
   std::shared_ptr<Array> indices_;
 };
 
+// ----------------------------------------------------------------------
+// Encoded arrays (run-end encoded and bit-packed in memory)
+
+/// \brief Array of values stored as runs
+///
+/// Slot i holds the value of the first run whose end is past offset() + i.
+/// The run ends are not adjusted when slicing, so a slice may start and end
+/// within a run. Nulls are stored as null run values: IsNull() and
+/// null_count() of the encoded array itself are always false and 0.
+/// arrow::compute::Decode expands the runs to a flat array
+class ARROW_EXPORT RunEndEncodedArray : public Array {
+ public:
+  using TypeClass = RunEndEncodedType;
+
+  explicit RunEndEncodedArray(const std::shared_ptr<internal::ArrayData>& data);
+
+  /// \param type a RunEndEncodedType
+  /// \param length the logical length of the array
+  /// \param run_ends non-null int32 array of strictly increasing run ends
+  /// \param values the value of every run, as long as run_ends
+  /// \param offset the logical offset of the first slot
+  RunEndEncodedArray(const std::shared_ptr<DataType>& type, int64_t length,
+      const std::shared_ptr<Array>& run_ends, const std::shared_ptr<Array>& values,
+      int64_t offset = 0);
+
+  /// The ends of all runs, including any outside of a slice
+  std::shared_ptr<Array> run_ends() const { return run_ends_; }
+
+  /// The values of all runs, including any outside of a slice
+  std::shared_ptr<Array> values() const { return values_; }
+
+  /// Accounts for the slice offset of the run ends, not of this array
+  const int32_t* raw_run_ends() const { return raw_run_ends_; }
+
+  /// \brief Index into values() of the run holding slot i
+  ///
+  /// A binary search over the run ends. Does not boundscheck
+  int64_t FindPhysicalIndex(int64_t i) const;
+
+  /// \brief The runs holding the slots of this array are the
+  /// physical_length() runs starting at physical_offset()
+  int64_t physical_offset() const;
+  int64_t physical_length() const;
+
+  std::shared_ptr<Array> Slice(int64_t offset, int64_t length) const override;
+
+ private:
+  void SetData(const std::shared_ptr<internal::ArrayData>& data);
+
+  std::shared_ptr<Array> run_ends_;
+  std::shared_ptr<Array> values_;
+  const int32_t* raw_run_ends_;
+};
+
+/// \brief Array of integers packed into bit_width() bits each
+///
+/// Values are decoded one at a time with Value(), or all at once to the
+/// value type's NumericArray with arrow::compute::Decode
+class ARROW_EXPORT BitPackedArray : public Array {
+ public:
+  using TypeClass = BitPackedType;
+
+  explicit BitPackedArray(const std::shared_ptr<internal::ArrayData>& data);
+
+  BitPackedArray(const std::shared_ptr<DataType>& type, int64_t length,
+      const std::shared_ptr<Buffer>& data,
+      const std::shared_ptr<Buffer>& null_bitmap = nullptr, int64_t null_count = 0,
+      int64_t offset = 0);
+
+  /// The packed values. Does not account for any slice offset
+  std::shared_ptr<Buffer> values() const { return data_->buffers[1]; }
+
+  const uint8_t* raw_values() const { return raw_values_; }
+
+  int bit_width() const { return bit_width_; }
+
+  std::shared_ptr<DataType> value_type() const;
+
+  /// \brief Decode slot i, sign-extended for signed value types. Unsigned
+  /// 64-bit values are returned as their two's complement
+  int64_t Value(int64_t i) const {
+    const uint64_t bits = BitUtil::LoadBitmapWord(
+        raw_values_, (i + data_->offset) * bit_width_, bit_width_);
+    return static_cast<int64_t>((bits ^ sign_bit_) - sign_bit_);
+  }
+
+  std::shared_ptr<Array> Slice(int64_t offset, int64_t length) const override;
+
+ private:
+  void SetData(const std::shared_ptr<internal::ArrayData>& data);
+
+  const uint8_t* raw_values_;
+  int bit_width_;
+  // The highest bit of a value for signed value types, otherwise 0
+  uint64_t sign_bit_;
+};
+
 // ----------------------------------------------------------------------
 // extern templates and other details
 
@@ -19,6 +19,7 @@
 
 #include "arrow/compare.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -268,6 +269,36 @@ class RangeEqualsVisitor {
     return Status::OK();
   }
 
+  // Walk both arrays a stretch at a time, each stretch lying within a single
+  // run on either side
+  bool CompareRunEndEncoded(const RunEndEncodedArray& left) {
+    const auto& right = static_cast<const RunEndEncodedArray&>(right_);
+    if (left_start_idx_ >= left_end_idx_) { return true; }
+
+    const std::shared_ptr<Array>& left_values = left.values();
+    const std::shared_ptr<Array>& right_values = right.values();
+    const int32_t* left_ends = left.raw_run_ends();
+    const int32_t* right_ends = right.raw_run_ends();
+
+    int64_t left_run = left.FindPhysicalIndex(left_start_idx_);
+    int64_t right_run = right.FindPhysicalIndex(right_start_idx_);
+    int64_t i = left_start_idx_;
+    int64_t o_i = right_start_idx_;
+    while (i < left_end_idx_) {
+      if (!left_values->RangeEquals(left_run, left_run + 1, right_run, right_values)) {
+        return false;
+      }
+      const int64_t left_remaining = left_ends[left_run] - left.offset() - i;
+      const int64_t right_remaining = right_ends[right_run] - right.offset() - o_i;
+      const int64_t step = std::min(left_remaining, right_remaining);
+      i += step;
+      o_i += step;
+      if (step == left_remaining) { ++left_run; }
+      if (step == right_remaining) { ++right_run; }
+    }
+    return true;
+  }
+
   Status Visit(const NullArray& left) {
     UNUSED(left);
     result_ = true;
@@ -306,6 +337,13 @@ class RangeEqualsVisitor {
     return Status::OK();
   }
 
+  Status Visit(const RunEndEncodedArray& left) {
+    result_ = CompareRunEndEncoded(left);
+    return Status::OK();
+  }
+
+  Status Visit(const BitPackedArray& left) { return CompareValues(left); }
+
   bool result() const { return result_; }
 
  protected:
@@ -545,6 +583,8 @@ class ArrayEqualsVisitor : public RangeEqualsVisitor {
     return Status::OK();
   }
 
+  Status Visit(const BitPackedArray& left) { return RangeEqualsVisitor::Visit(left); }
+
   template <typename T>
   typename std::enable_if<std::is_base_of<NestedType, typename T::TypeClass>::value,
       Status>::type
@@ -773,6 +813,15 @@ class TypeEqualsVisitor {
     return Status::OK();
   }
 
+  Status Visit(const RunEndEncodedType& left) { return VisitChildren(left); }
+
+  Status Visit(const BitPackedType& left) {
+    const auto& right = static_cast<const BitPackedType&>(right_);
+    result_ = left.bit_width() == right.bit_width() &&
+              left.value_type()->Equals(right.value_type());
+    return Status::OK();
+  }
+
   Status Visit(const DictionaryType& left) {
     const auto& right = static_cast<const DictionaryType&>(right_);
     result_ = left.index_type()->Equals(right.index_type()) &&
@@ -0,0 +1,149 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Helpers shared by the compute kernels; not part of the public API
+
+#ifndef ARROW_COMPUTE_COMPUTE_INTERNAL_H
+#define ARROW_COMPUTE_COMPUTE_INTERNAL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+#include "arrow/array.h"
+#include "arrow/buffer.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/type.h"
+#include "arrow/util/bit-util.h"
+
+namespace arrow {
+namespace compute {
+
+/// \brief Growable vector of plain values backed by a pool-allocated buffer,
+/// so that finished state can be handed to an array without copying
+template <typename T>
+class StateVector {
+ public:
+  explicit StateVector(MemoryPool* pool) : pool_(pool), size_(0) { Reset(); }
+
+  Status Resize(int64_t new_size, T initial) {
+    if (new_size > size_) {
+      const int64_t nbytes = new_size * static_cast<int64_t>(sizeof(T));
+      if (nbytes > buffer_->capacity()) {
+        RETURN_NOT_OK(buffer_->Reserve(std::max(nbytes, buffer_->capacity() * 2)));
+      }
+      RETURN_NOT_OK(buffer_->Resize(nbytes, false));
+      std::fill(data() + size_, data() + new_size, initial);
+    }
+    size_ = new_size;
+    return Status::OK();
+  }
+
+  Status Append(const T* values, int64_t length) {
+    const int64_t old_size = size_;
+    RETURN_NOT_OK(Resize(size_ + length, T()));
+    if (length > 0) { memcpy(data() + old_size, values, length * sizeof(T)); }
+    return Status::OK();
+  }
+
+  T* data() { return reinterpret_cast<T*>(buffer_->mutable_data()); }
+  const T* data() const { return reinterpret_cast<const T*>(buffer_->data()); }
+  int64_t size() const { return size_; }
+  int64_t memory_usage() const { return buffer_->capacity(); }
+
+  /// Hand over the underlying buffer and start over empty
+  std::shared_ptr<Buffer> Finish() {
+    std::shared_ptr<Buffer> result = buffer_;
+    Reset();
+    return result;
+  }
+
+  void Reset() {
+    buffer_ = std::make_shared<PoolBuffer>(pool_);
+    size_ = 0;
+  }
+
+ private:
+  MemoryPool* pool_;
+  std::shared_ptr<PoolBuffer> buffer_;
+  int64_t size_;
+};
+
+/// \brief Convert one validity byte per slot into a validity bitmap. No
+/// bitmap is produced when every slot is valid
+static inline Status BytesToBitmap(MemoryPool* pool, const uint8_t* valid,
+    int64_t length, std::shared_ptr<Buffer>* out, int64_t* null_count) {
+  int64_t nulls = 0;
+  for (int64_t i = 0; i < length; ++i) {
+    nulls += valid[i] == 0;
+  }
+  *null_count = nulls;
+  if (nulls == 0) {
+    *out = nullptr;
+    return Status::OK();
+  }
+  std::shared_ptr<MutableBuffer> bitmap;
+  RETURN_NOT_OK(GetEmptyBitmap(pool, length, &bitmap));
+  uint8_t* bits = bitmap->mutable_data();
+  for (int64_t i = 0; i < length; ++i) {
+    if (valid[i]) { BitUtil::SetBit(bits, i); }
+  }
+  *out = bitmap;
+  return Status::OK();
+}
+
+/// \brief The validity bitmap for the output of an elementwise kernel, shared
+/// with the input unless the input is a slice
+static inline Status OutputValidity(
+    MemoryPool* pool, const Array& values, std::shared_ptr<Buffer>* out) {
+  if (values.null_count() == 0) {
+    *out = nullptr;
+    return Status::OK();
+  }
+  if (values.offset() == 0) {
+    *out = values.null_bitmap();
+    return Status::OK();
+  }
+  return CopyBitmap(
+      pool, values.null_bitmap_data(), values.offset(), values.length(), out);
+}
+
+/// \brief Accumulator type of SUM: int64 for signed integers, uint64 for unsigned
+/// integers and double for floating point
+template <typename ArrowType>
+struct SumTraits {
+  using c_type = typename ArrowType::c_type;
+  using type = typename std::conditional<std::is_floating_point<c_type>::value,
+      DoubleType, typename std::conditional<std::is_signed<c_type>::value, Int64Type,
+                      UInt64Type>::type>::type;
+};
+
+/// \brief The type of the values a possibly dictionary-encoded column holds
+static inline std::shared_ptr<DataType> DenseType(const std::shared_ptr<DataType>& type) {
+  if (type->id() == Type::DICTIONARY) {
+    return static_cast<const DictionaryType&>(*type).dictionary()->type();
+  }
+  return type;
+}
+
+}  // namespace compute
+}  // namespace arrow
+
+#endif  // ARROW_COMPUTE_COMPUTE_INTERNAL_H
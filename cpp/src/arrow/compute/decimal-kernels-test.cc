@@ -0,0 +1,195 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "arrow/array.h"
+#include "arrow/compute/decimal-kernels.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/test-util.h"
+#include "arrow/type.h"
+
+namespace arrow {
+namespace compute {
+
+static std::shared_ptr<Array> Strings(const std::vector<std::string>& values) {
+  std::vector<bool> is_valid;
+  for (const std::string& value : values) {
+    is_valid.push_back(value != "null");
+  }
+  std::shared_ptr<Array> out;
+  ArrayFromVector<StringType, std::string>(is_valid, values, &out);
+  return out;
+}
+
+static std::vector<std::string> Formatted(const Array& values) {
+  const auto& decimals = static_cast<const DecimalArray&>(values);
+  std::vector<std::string> out;
+  for (int64_t i = 0; i < decimals.length(); ++i) {
+    out.push_back(decimals.IsNull(i) ? "null" : decimals.FormatValue(i));
+  }
+  return out;
+}
+
+static std::shared_ptr<Array> Decimals(
+    const std::shared_ptr<DataType>& type, const std::vector<std::string>& values) {
+  std::shared_ptr<Array> out;
+  EXPECT_OK(DecimalFromString(default_memory_pool(), *Strings(values), type, &out));
+  return out;
+}
+
+// Precisions stored in 32, 64 and 128 bits
+class TestDecimalKernels : public ::testing::TestWithParam<int> {};
+
+TEST_P(TestDecimalKernels, FromString) {
+  auto type = std::make_shared<DecimalType>(GetParam(), 2);
+  std::shared_ptr<Array> result;
+  ASSERT_OK(DecimalFromString(default_memory_pool(),
+      *Strings({"1.5", "null", "-12.25", "0", "+3.000", "-.07"}), type, &result));
+  ASSERT_TRUE(result->type()->Equals(*type));
+  ASSERT_EQ(1, result->null_count());
+  ASSERT_EQ(std::vector<std::string>({"1.50", "null", "-12.25", "0.00", "3.00", "-0.07"}),
+      Formatted(*result));
+
+  ASSERT_OK(DecimalFromString(default_memory_pool(),
+      *Strings({"1", "null", "2.5"})->Slice(1), type, &result));
+  ASSERT_EQ(std::vector<std::string>({"null", "2.50"}), Formatted(*result));
+}
+
+TEST_P(TestDecimalKernels, FromStringInvalid) {
+  auto type = std::make_shared<DecimalType>(GetParam(), 2);
+  std::shared_ptr<Array> result;
+  // Malformed, digits lost and too many digits
+  ASSERT_RAISES(
+      Invalid, DecimalFromString(default_memory_pool(), *Strings({"1", "1.2.3"}), type,
+                   &result));
+  ASSERT_RAISES(Invalid,
+      DecimalFromString(default_memory_pool(), *Strings({"1.234"}), type, &result));
+  const std::string too_long(GetParam() - 1, '9');
+  ASSERT_RAISES(Invalid,
+      DecimalFromString(default_memory_pool(), *Strings({too_long}), type, &result));
+  ASSERT_OK(DecimalFromString(
+      default_memory_pool(), *Strings({too_long.substr(1)}), type, &result));
+}
+
+TEST_P(TestDecimalKernels, ToString) {
+  auto type = std::make_shared<DecimalType>(GetParam(), 3);
+  auto decimals = Decimals(type, {"0.5", "null", "-1.25", "10"});
+  std::shared_ptr<Array> result, expected;
+  ASSERT_OK(DecimalToString(default_memory_pool(), *decimals, &result));
+  expected = Strings({"0.500", "null", "-1.250", "10.000"});
+  ASSERT_TRUE(result->Equals(expected));
+
+  ASSERT_OK(DecimalToString(default_memory_pool(), *decimals->Slice(2), &result));
+  ASSERT_TRUE(result->Equals(expected->Slice(2)));
+}
+
+TEST_P(TestDecimalKernels, Rescale) {
+  const int precision = GetParam();
+  auto type = std::make_shared<DecimalType>(precision, 2);
+  auto decimals = Decimals(type, {"1.5", "null", "-12.25", "0"});
+  std::shared_ptr<Array> result;
+
+  auto wider = std::make_shared<DecimalType>(std::min(precision + 2, 38), 4);
+  ASSERT_OK(RescaleDecimal(default_memory_pool(), *decimals, wider, &result));
+  ASSERT_TRUE(result->type()->Equals(*wider));
+  ASSERT_EQ(std::vector<std::string>({"1.5000", "null", "-12.2500", "0.0000"}),
+      Formatted(*result));
+
+  // Back down, the extra digits being zeros
+  ASSERT_OK(RescaleDecimal(default_memory_pool(), *result, type, &result));
+  ASSERT_TRUE(result->Equals(decimals));
+
+  // Across storage widths
+  for (int other_precision : {9, 18, 38}) {
+    auto other = std::make_shared<DecimalType>(other_precision, 2);
+    ASSERT_OK(RescaleDecimal(default_memory_pool(), *decimals, other, &result));
+    ASSERT_EQ(Formatted(*decimals), Formatted(*result));
+  }
+
+  ASSERT_OK(RescaleDecimal(default_memory_pool(), *decimals->Slice(2), wider, &result));
+  ASSERT_EQ(std::vector<std::string>({"-12.2500", "0.0000"}), Formatted(*result));
+}
+
+TEST_P(TestDecimalKernels, RescaleInvalid) {
+  const int precision = GetParam();
+  auto type = std::make_shared<DecimalType>(precision, 2);
+  std::shared_ptr<Array> result;
+
+  // Digits dropped
+  auto narrower = std::make_shared<DecimalType>(precision, 1);
+  ASSERT_RAISES(Invalid, RescaleDecimal(default_memory_pool(),
+                             *Decimals(type, {"1.5", "1.25"}), narrower, &result));
+
+  // The scaled up value no longer fits the precision
+  auto shifted = std::make_shared<DecimalType>(precision, 3);
+  const std::string largest = std::string(precision - 2, '9') + ".99";
+  ASSERT_RAISES(Invalid, RescaleDecimal(default_memory_pool(),
+                             *Decimals(type, {"1", "null", largest}), shifted, &result));
+  ASSERT_OK(RescaleDecimal(
+      default_memory_pool(), *Decimals(type, {"1", "null", "-1"}), shifted, &result));
+}
+
+TEST_P(TestDecimalKernels, Add) {
+  auto type = std::make_shared<DecimalType>(GetParam(), 2);
+  auto left = Decimals(type, {"1.5", "null", "-12.25", "0", "7"});
+  auto right = Decimals(type, {"2.25", "1", "null", "-0.01", "-7"});
+  std::shared_ptr<Array> result;
+  ASSERT_OK(AddDecimal(default_memory_pool(), *left, *right, &result));
+  ASSERT_EQ(2, result->null_count());
+  ASSERT_EQ(std::vector<std::string>({"3.75", "null", "null", "-0.01", "0.00"}),
+      Formatted(*result));
+
+  ASSERT_OK(
+      AddDecimal(default_memory_pool(), *left->Slice(3), *right->Slice(3), &result));
+  ASSERT_EQ(std::vector<std::string>({"-0.01", "0.00"}), Formatted(*result));
+}
+
+TEST_P(TestDecimalKernels, AddInvalid) {
+  const int precision = GetParam();
+  auto type = std::make_shared<DecimalType>(precision, 0);
+  const std::string largest(precision, '9');
+  std::shared_ptr<Array> result;
+
+  // Sums beyond the precision, a null sum being ignored
+  auto left = Decimals(type, {"1", largest, largest});
+  auto right = Decimals(type, {"1", "null", "1"});
+  ASSERT_RAISES(Invalid, AddDecimal(default_memory_pool(), *left, *right, &result));
+  ASSERT_OK(AddDecimal(
+      default_memory_pool(), *left->Slice(0, 2), *right->Slice(0, 2), &result));
+  auto smallest = Decimals(type, {"-" + largest});
+  ASSERT_RAISES(
+      Invalid, AddDecimal(default_memory_pool(), *smallest, *smallest, &result));
+
+  auto other = std::make_shared<DecimalType>(precision, 1);
+  auto mismatched = Decimals(other, {"1", "2", "3"});
+  ASSERT_RAISES(
+      Invalid, AddDecimal(default_memory_pool(), *left, *mismatched, &result));
+}
+
+INSTANTIATE_TEST_CASE_P(
+    StorageWidths, TestDecimalKernels, ::testing::Values(5, 9, 15, 18, 30, 38));
+
+}  // namespace compute
+}  // namespace arrow
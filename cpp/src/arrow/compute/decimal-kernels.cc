@@ -0,0 +1,554 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/compute/decimal-kernels.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/buffer.h"
+#include "arrow/compute/compute-internal.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/type.h"
+#include "arrow/util/bit-util.h"
+#include "arrow/util/decimal.h"
+#include "arrow/util/logging.h"
+
+namespace arrow {
+namespace compute {
+
+using decimal::Decimal;
+using decimal::Int128;
+
+namespace {
+
+Status CheckDecimalType(const DataType& type) {
+  if (type.id() != Type::DECIMAL) {
+    std::stringstream ss;
+    ss << "Decimal kernels need decimal types, got " << type.ToString();
+    return Status::Invalid(ss.str());
+  }
+  return Status::OK();
+}
+
+Status ValueError(int64_t i, const Status& status) {
+  std::stringstream ss;
+  ss << "Decimal value at index " << i << ": " << status.message();
+  return Status::Invalid(ss.str());
+}
+
+Status PrecisionError(int64_t i, const DecimalType& type) {
+  std::stringstream ss;
+  ss << "Decimal value at index " << i << " does not fit " << type.ToString();
+  return Status::Invalid(ss.str());
+}
+
+// The largest unscaled value of a precision, in the storage type T
+template <typename T>
+T MaxUnscaled(int precision) {
+  return static_cast<T>(static_cast<int64_t>(decimal::PowerOfTen(precision) - 1));
+}
+
+template <>
+Int128 MaxUnscaled(int precision) {
+  return decimal::PowerOfTen(precision) - 1;
+}
+
+template <typename T>
+inline bool OutOfBounds(const T& value, const T& bound) {
+  return (value > bound) | (value < -bound);
+}
+
+template <>
+inline bool OutOfBounds(const Int128& value, const Int128& bound) {
+  const Int128 magnitude = value.Abs();
+  return magnitude > bound || magnitude.IsNegative();
+}
+
+template <typename T>
+T Narrow(const Int128& value) {
+  return static_cast<T>(static_cast<int64_t>(value));
+}
+
+template <>
+Int128 Narrow(const Int128& value) {
+  return value;
+}
+
+// Unscaled values of a decimal array, relative to its offset
+template <typename T>
+class DecimalReader {
+ public:
+  explicit DecimalReader(const DecimalArray& array)
+      : values_(reinterpret_cast<const T*>(array.raw_values()) + array.offset()) {}
+
+  T operator[](int64_t i) const { return values_[i]; }
+  const T* data() const { return values_; }
+
+ private:
+  const T* values_;
+};
+
+// 128-bit decimals hold their magnitude and keep the signs in a bitmap
+template <>
+class DecimalReader<Int128> {
+ public:
+  explicit DecimalReader(const DecimalArray& array)
+      : bytes_(array.raw_values() + array.offset() * 16),
+        signs_(array.sign_bitmap() ? array.sign_bitmap()->data() : nullptr),
+        offset_(array.offset()) {}
+
+  Int128 operator[](int64_t i) const {
+    decimal::Decimal128 value;
+    decimal::FromBytes(bytes_ + i * 16,
+        signs_ != nullptr && BitUtil::GetBit(signs_, offset_ + i), &value);
+    return value.value;
+  }
+
+ private:
+  const uint8_t* bytes_;
+  const uint8_t* signs_;
+  int64_t offset_;
+};
+
+// The zero-initialized value buffers of a decimal array under construction
+template <typename T>
+class DecimalWriter {
+ public:
+  Status Init(MemoryPool* pool, int64_t length) {
+    RETURN_NOT_OK(AllocateBuffer(pool, length * sizeof(T), &values_));
+    memset(values_->mutable_data(), 0, static_cast<size_t>(values_->size()));
+    return Status::OK();
+  }
+
+  void Set(int64_t i, const T& value) { data()[i] = value; }
+  T* data() { return reinterpret_cast<T*>(values_->mutable_data()); }
+
+  void Finish(std::vector<std::shared_ptr<Buffer>>* buffers) {
+    buffers->push_back(values_);
+    buffers->push_back(nullptr);
+  }
+
+ private:
+  std::shared_ptr<MutableBuffer> values_;
+};
+
+template <>
+class DecimalWriter<Int128> {
+ public:
+  Status Init(MemoryPool* pool, int64_t length) {
+    RETURN_NOT_OK(AllocateBuffer(pool, length * 16, &values_));
+    memset(values_->mutable_data(), 0, static_cast<size_t>(values_->size()));
+    return GetEmptyBitmap(pool, length, &signs_);
+  }
+
+  void Set(int64_t i, const Int128& value) {
+    uint8_t* bytes = values_->mutable_data() + i * 16;
+    bool is_negative;
+    decimal::ToBytes(decimal::Decimal128(value), &bytes, &is_negative);
+    if (is_negative) { BitUtil::SetBit(signs_->mutable_data(), i); }
+  }
+
+  void Finish(std::vector<std::shared_ptr<Buffer>>* buffers) {
+    buffers->push_back(values_);
+    buffers->push_back(signs_);
+  }
+
+ private:
+  std::shared_ptr<MutableBuffer> values_;
+  std::shared_ptr<MutableBuffer> signs_;
+};
+
+template <typename T>
+Status FinishDecimal(const std::shared_ptr<DataType>& type, int64_t length,
+    std::shared_ptr<Buffer> validity, int64_t null_count, DecimalWriter<T>* writer,
+    std::shared_ptr<Array>* out) {
+  std::vector<std::shared_ptr<Buffer>> buffers = {validity};
+  writer->Finish(&buffers);
+  *out = std::make_shared<DecimalArray>(std::make_shared<internal::ArrayData>(
+      type, length, std::move(buffers), null_count));
+  return Status::OK();
+}
+
+// ----------------------------------------------------------------------
+// Parsing
+
+template <typename T>
+Status ParseDecimals(MemoryPool* pool, const BinaryArray& values,
+    const std::shared_ptr<DataType>& type, std::shared_ptr<Array>* out) {
+  const auto& decimal_type = static_cast<const DecimalType&>(*type);
+  const int type_precision = decimal_type.precision();
+  const int type_scale = decimal_type.scale();
+  const T bound = MaxUnscaled<T>(type_precision);
+  const int64_t length = values.length();
+
+  std::shared_ptr<Buffer> validity;
+  RETURN_NOT_OK(OutputValidity(pool, values, &validity));
+  DecimalWriter<T> writer;
+  RETURN_NOT_OK(writer.Init(pool, length));
+
+  const int32_t* offsets = length > 0 ? values.raw_value_offsets() : nullptr;
+  const uint8_t* data = values.value_data() ? values.value_data()->data() : nullptr;
+  const bool has_nulls = values.null_count() > 0;
+  for (int64_t i = 0; i < length; ++i) {
+    if (has_nulls && values.IsNull(i)) { continue; }
+    Decimal<T> value;
+    int precision, scale;
+    Status status = decimal::FromString(reinterpret_cast<const char*>(data + offsets[i]),
+        offsets[i + 1] - offsets[i], &value, &precision, &scale);
+    if (!status.ok()) { return ValueError(i, status); }
+
+    // The common cases need no bounds checks: the digits of the value fit the
+    // precision of the type, scaled up if need be
+    const int scale_up = type_scale - scale;
+    if (scale_up >= 0 && precision + scale_up <= type_precision) {
+      if (scale_up > 0) { value.value *= Narrow<T>(decimal::PowerOfTen(scale_up)); }
+    } else {
+      status = decimal::Rescale(value, scale, type_scale, &value);
+      if (!status.ok()) { return ValueError(i, status); }
+      if (OutOfBounds(value.value, bound)) { return PrecisionError(i, decimal_type); }
+    }
+    writer.Set(i, value.value);
+  }
+  return FinishDecimal(type, length, validity, values.null_count(), &writer, out);
+}
+
+// ----------------------------------------------------------------------
+// Formatting
+
+template <typename T>
+Status FormatDecimals(
+    MemoryPool* pool, const DecimalArray& values, std::shared_ptr<Array>* out) {
+  const auto& type = static_cast<const DecimalType&>(*values.type());
+  const int64_t length = values.length();
+  const DecimalReader<T> reader(values);
+
+  std::vector<std::shared_ptr<Buffer>> buffers(3);
+  RETURN_NOT_OK(OutputValidity(pool, values, &buffers[0]));
+
+  std::shared_ptr<MutableBuffer> offsets_buffer;
+  RETURN_NOT_OK(AllocateBuffer(pool, (length + 1) * sizeof(int32_t), &offsets_buffer));
+  auto offsets = reinterpret_cast<int32_t*>(offsets_buffer->mutable_data());
+  buffers[1] = offsets_buffer;
+
+  // Room for the longest string is made before formatting each value, the
+  // buffer growing geometrically
+  auto data = std::make_shared<PoolBuffer>(pool);
+  int64_t position = 0;
+  const bool has_nulls = values.null_count() > 0;
+  for (int64_t i = 0; i < length; ++i) {
+    offsets[i] = static_cast<int32_t>(position);
+    if (has_nulls && values.IsNull(i)) { continue; }
+    if (position + decimal::kMaxDecimalStringLength > data->capacity()) {
+      RETURN_NOT_OK(data->Reserve(std::max(
+          data->capacity() * 2, position + 64 * decimal::kMaxDecimalStringLength)));
+    }
+    position += decimal::FormatDecimal(Decimal<T>(reader[i]), type.precision(),
+        type.scale(), reinterpret_cast<char*>(data->mutable_data()) + position);
+  }
+  offsets[length] = static_cast<int32_t>(position);
+  RETURN_NOT_OK(data->Resize(position));
+  buffers[2] = data;
+
+  auto result = std::make_shared<internal::ArrayData>(
+      utf8(), length, std::move(buffers), values.null_count());
+  return internal::MakeArray(result, out);
+}
+
+// ----------------------------------------------------------------------
+// Rescaling and addition
+
+// Branch-free loops over the unscaled values of 32 and 64-bit decimals, which
+// the compiler can vectorize. Results are computed as unsigned integers, null
+// slots may hold anything. Each returns whether any value was out of bounds
+template <typename T>
+bool MultiplyValues(const T* values, int64_t length, T multiplier, T bound, T* out) {
+  using U = typename std::make_unsigned<T>::type;
+  bool out_of_bounds = false;
+  for (int64_t i = 0; i < length; ++i) {
+    out_of_bounds |= OutOfBounds(values[i], bound);
+    out[i] = static_cast<T>(static_cast<U>(values[i]) * static_cast<U>(multiplier));
+  }
+  return out_of_bounds;
+}
+
+template <typename T>
+bool AddValues(const T* left, const T* right, int64_t length, T bound, T* out) {
+  using U = typename std::make_unsigned<T>::type;
+  bool out_of_bounds = false;
+  for (int64_t i = 0; i < length; ++i) {
+    out[i] = static_cast<T>(static_cast<U>(left[i]) + static_cast<U>(right[i]));
+    out_of_bounds |= OutOfBounds(out[i], bound);
+  }
+  return out_of_bounds;
+}
+
+// Rescale one value through Int128, false if digits would be lost or the
+// result exceeds bound
+bool RescaleValue(const Int128& value, int delta, const Int128& bound, Int128* out) {
+  const int max_delta = decimal::DecimalPrecision<Int128>::maximum;
+  if (value == 0) {
+    *out = value;
+    return true;
+  }
+  if (delta >= 0) {
+    if (delta > max_delta || OutOfBounds(value, bound)) { return false; }
+    *out = delta > 0 ? value * decimal::PowerOfTen(delta) : value;
+    return true;
+  }
+  if (delta < -max_delta) { return false; }
+  Int128 remainder;
+  DCHECK(value.Divide(decimal::PowerOfTen(-delta), out, &remainder).ok());
+  return remainder == 0 && !OutOfBounds(*out, bound);
+}
+
+// Scaling up between decimals of the same width, in one vectorizable pass.
+// False when not applicable or some value is out of bounds
+template <typename In, typename Out>
+struct FastRescale {
+  static bool Run(const DecimalArray& values, int delta, const Int128& in_bound,
+      DecimalWriter<Out>* writer) {
+    return false;
+  }
+};
+
+template <typename T>
+struct FastRescale<T, T> {
+  static bool Run(const DecimalArray& values, int delta, const Int128& in_bound,
+      DecimalWriter<T>* writer) {
+    if (delta < 0 || delta > std::numeric_limits<T>::digits10) { return false; }
+    return !MultiplyValues(DecimalReader<T>(values).data(), values.length(),
+        Narrow<T>(decimal::PowerOfTen(delta)), Narrow<T>(in_bound), writer->data());
+  }
+};
+
+template <>
+struct FastRescale<Int128, Int128> {
+  static bool Run(const DecimalArray& values, int delta, const Int128& in_bound,
+      DecimalWriter<Int128>* writer) {
+    return false;
+  }
+};
+
+template <typename In, typename Out>
+Status RescaleDecimals(MemoryPool* pool, const DecimalArray& values,
+    const std::shared_ptr<DataType>& type, std::shared_ptr<Array>* out) {
+  const auto& in_type = static_cast<const DecimalType&>(*values.type());
+  const auto& out_type = static_cast<const DecimalType&>(*type);
+  const int delta = out_type.scale() - in_type.scale();
+  const int64_t length = values.length();
+  const DecimalReader<In> reader(values);
+
+  std::shared_ptr<Buffer> validity;
+  RETURN_NOT_OK(OutputValidity(pool, values, &validity));
+  DecimalWriter<Out> writer;
+  RETURN_NOT_OK(writer.Init(pool, length));
+
+  // The bound on input values that keeps the scaled up result within the
+  // precision of the output type
+  const Int128 out_bound = MaxUnscaled<Int128>(out_type.precision());
+  const Int128 in_bound =
+      delta > 0 && delta <= decimal::DecimalPrecision<Int128>::maximum
+          ? out_bound / decimal::PowerOfTen(delta)
+          : out_bound;
+
+  // The exact slot is only looked for when the fast path finds something
+  // out of bounds
+  if (FastRescale<In, Out>::Run(values, delta, in_bound, &writer)) {
+    return FinishDecimal(type, length, validity, values.null_count(), &writer, out);
+  }
+
+  const bool has_nulls = values.null_count() > 0;
+  Int128 result;
+  for (int64_t i = 0; i < length; ++i) {
+    if (has_nulls && values.IsNull(i)) { continue; }
+    if (!RescaleValue(Int128(reader[i]), delta, delta > 0 ? in_bound : out_bound,
+            &result)) {
+      return PrecisionError(i, out_type);
+    }
+    writer.Set(i, Narrow<Out>(result));
+  }
+  return FinishDecimal(type, length, validity, values.null_count(), &writer, out);
+}
+
+// The validity of a sum is the intersection of the validity of the operands
+Status AddValidity(MemoryPool* pool, const Array& left, const Array& right,
+    std::shared_ptr<Buffer>* validity, int64_t* null_count) {
+  if (left.null_count() > 0 && right.null_count() > 0) {
+    *null_count = kUnknownNullCount;
+    return BitmapAnd(pool, left.null_bitmap_data(), left.offset(),
+        right.null_bitmap_data(), right.offset(), left.length(), 0, validity);
+  }
+  const Array& operand = left.null_count() > 0 ? left : right;
+  *null_count = operand.null_count();
+  return OutputValidity(pool, operand, validity);
+}
+
+template <typename T>
+Status AddDecimals(MemoryPool* pool, const DecimalArray& left, const DecimalArray& right,
+    std::shared_ptr<Array>* out) {
+  const auto& type = static_cast<const DecimalType&>(*left.type());
+  const int64_t length = left.length();
+  const T bound = MaxUnscaled<T>(type.precision());
+
+  std::shared_ptr<Buffer> validity;
+  int64_t null_count;
+  RETURN_NOT_OK(AddValidity(pool, left, right, &validity, &null_count));
+  DecimalWriter<T> writer;
+  RETURN_NOT_OK(writer.Init(pool, length));
+
+  const T* sums = writer.data();
+  if (AddValues(DecimalReader<T>(left).data(), DecimalReader<T>(right).data(), length,
+          bound, writer.data())) {
+    for (int64_t i = 0; i < length; ++i) {
+      if (OutOfBounds(sums[i], bound) && !left.IsNull(i) && !right.IsNull(i)) {
+        return PrecisionError(i, type);
+      }
+    }
+  }
+  return FinishDecimal(left.type(), length, validity, null_count, &writer, out);
+}
+
+template <>
+Status AddDecimals<Int128>(MemoryPool* pool, const DecimalArray& left,
+    const DecimalArray& right, std::shared_ptr<Array>* out) {
+  const auto& type = static_cast<const DecimalType&>(*left.type());
+  const int64_t length = left.length();
+  const Int128 bound = MaxUnscaled<Int128>(type.precision());
+  const DecimalReader<Int128> left_reader(left);
+  const DecimalReader<Int128> right_reader(right);
+
+  std::shared_ptr<Buffer> validity;
+  int64_t null_count;
+  RETURN_NOT_OK(AddValidity(pool, left, right, &validity, &null_count));
+  DecimalWriter<Int128> writer;
+  RETURN_NOT_OK(writer.Init(pool, length));
+
+  const bool has_nulls = left.null_count() > 0 || right.null_count() > 0;
+  for (int64_t i = 0; i < length; ++i) {
+    if (has_nulls && (left.IsNull(i) || right.IsNull(i))) { continue; }
+    const Int128 left_value = left_reader[i];
+    const Int128 right_value = right_reader[i];
+    const Int128 sum = left_value + right_value;
+    // Operands of 38 digits may wrap around, flipping the sign
+    const bool wrapped = left_value.IsNegative() == right_value.IsNegative() &&
+                         sum.IsNegative() != left_value.IsNegative();
+    if (wrapped || OutOfBounds(sum, bound)) { return PrecisionError(i, type); }
+    writer.Set(i, sum);
+  }
+  return FinishDecimal(left.type(), length, validity, null_count, &writer, out);
+}
+
+}  // namespace
+
+Status DecimalFromString(MemoryPool* pool, const Array& values,
+    const std::shared_ptr<DataType>& type, std::shared_ptr<Array>* out) {
+  if (values.type_id() != Type::BINARY && values.type_id() != Type::STRING) {
+    std::stringstream ss;
+    ss << "DecimalFromString needs binary or string input, got "
+       << values.type()->ToString();
+    return Status::Invalid(ss.str());
+  }
+  RETURN_NOT_OK(CheckDecimalType(*type));
+  const auto& binary = static_cast<const BinaryArray&>(values);
+  switch (static_cast<const DecimalType&>(*type).byte_width()) {
+    case 4:
+      return ParseDecimals<int32_t>(pool, binary, type, out);
+    case 8:
+      return ParseDecimals<int64_t>(pool, binary, type, out);
+    default:
+      return ParseDecimals<Int128>(pool, binary, type, out);
+  }
+}
+
+Status DecimalToString(
+    MemoryPool* pool, const Array& values, std::shared_ptr<Array>* out) {
+  RETURN_NOT_OK(CheckDecimalType(*values.type()));
+  const auto& decimals = static_cast<const DecimalArray&>(values);
+  switch (decimals.byte_width()) {
+    case 4:
+      return FormatDecimals<int32_t>(pool, decimals, out);
+    case 8:
+      return FormatDecimals<int64_t>(pool, decimals, out);
+    default:
+      return FormatDecimals<Int128>(pool, decimals, out);
+  }
+}
+
+template <typename In>
+static Status RescaleFrom(MemoryPool* pool, const DecimalArray& values,
+    const std::shared_ptr<DataType>& type, std::shared_ptr<Array>* out) {
+  switch (static_cast<const DecimalType&>(*type).byte_width()) {
+    case 4:
+      return RescaleDecimals<In, int32_t>(pool, values, type, out);
+    case 8:
+      return RescaleDecimals<In, int64_t>(pool, values, type, out);
+    default:
+      return RescaleDecimals<In, Int128>(pool, values, type, out);
+  }
+}
+
+Status RescaleDecimal(MemoryPool* pool, const Array& values,
+    const std::shared_ptr<DataType>& type, std::shared_ptr<Array>* out) {
+  RETURN_NOT_OK(CheckDecimalType(*values.type()));
+  RETURN_NOT_OK(CheckDecimalType(*type));
+  const auto& decimals = static_cast<const DecimalArray&>(values);
+  switch (decimals.byte_width()) {
+    case 4:
+      return RescaleFrom<int32_t>(pool, decimals, type, out);
+    case 8:
+      return RescaleFrom<int64_t>(pool, decimals, type, out);
+    default:
+      return RescaleFrom<Int128>(pool, decimals, type, out);
+  }
+}
+
+Status AddDecimal(MemoryPool* pool, const Array& left, const Array& right,
+    std::shared_ptr<Array>* out) {
+  RETURN_NOT_OK(CheckDecimalType(*left.type()));
+  if (!left.type()->Equals(*right.type())) {
+    std::stringstream ss;
+    ss << "Decimal addition needs identical types, got " << left.type()->ToString()
+       << " and " << right.type()->ToString();
+    return Status::Invalid(ss.str());
+  }
+  if (left.length() != right.length()) {
+    return Status::Invalid("Decimal addition needs arrays of the same length");
+  }
+  const auto& left_decimals = static_cast<const DecimalArray&>(left);
+  const auto& right_decimals = static_cast<const DecimalArray&>(right);
+  switch (left_decimals.byte_width()) {
+    case 4:
+      return AddDecimals<int32_t>(pool, left_decimals, right_decimals, out);
+    case 8:
+      return AddDecimals<int64_t>(pool, left_decimals, right_decimals, out);
+    default:
+      return AddDecimals<Int128>(pool, left_decimals, right_decimals, out);
+  }
+}
+
+}  // namespace compute
+}  // namespace arrow
@@ -0,0 +1,87 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Vectorized kernels on decimal arrays
+
+#ifndef ARROW_COMPUTE_DECIMAL_KERNELS_H
+#define ARROW_COMPUTE_DECIMAL_KERNELS_H
+
+#include <memory>
+
+#include "arrow/util/visibility.h"
+
+namespace arrow {
+
+class Array;
+class DataType;
+class MemoryPool;
+class Status;
+
+namespace compute {
+
+// The kernels work directly on the value buffers of DecimalArray. 32 and
+// 64-bit decimals are processed as plain integer loops; 128-bit decimals go
+// through decimal::Int128. Null input slots produce null output slots.
+
+/// \brief Parse every string into a decimal
+///
+/// Strings with fewer digits after the decimal point than the scale of type
+/// are scaled up. Strings with more digits are accepted only when the extra
+/// digits are zeros.
+///
+/// \param[in] pool memory pool to allocate the result from
+/// \param[in] values binary or string array
+/// \param[in] type the decimal type of the result
+/// \param[out] out a DecimalArray
+/// \return Status, Invalid for malformed strings or values that do not fit
+Status ARROW_EXPORT DecimalFromString(MemoryPool* pool, const Array& values,
+    const std::shared_ptr<DataType>& type, std::shared_ptr<Array>* out);
+
+/// \brief Format every decimal as a string
+///
+/// \param[in] pool memory pool to allocate the result from
+/// \param[in] values decimal array
+/// \param[out] out a StringArray
+/// \return Status
+Status ARROW_EXPORT DecimalToString(
+    MemoryPool* pool, const Array& values, std::shared_ptr<Array>* out);
+
+/// \brief Convert every decimal to another precision and scale
+///
+/// \param[in] pool memory pool to allocate the result from
+/// \param[in] values decimal array
+/// \param[in] type the decimal type of the result
+/// \param[out] out a DecimalArray
+/// \return Status, Invalid when reducing the scale would drop nonzero digits
+/// or a value does not fit the precision of type
+Status ARROW_EXPORT RescaleDecimal(MemoryPool* pool, const Array& values,
+    const std::shared_ptr<DataType>& type, std::shared_ptr<Array>* out);
+
+/// \brief Add two decimal arrays of the same type elementwise
+///
+/// \param[in] pool memory pool to allocate the result from
+/// \param[in] left decimal array
+/// \param[in] right decimal array of the same type and length
+/// \param[out] out a DecimalArray of the same type
+/// \return Status, Invalid when a sum does not fit the precision of the type
+Status ARROW_EXPORT AddDecimal(MemoryPool* pool, const Array& left, const Array& right,
+    std::shared_ptr<Array>* out);
+
+}  // namespace compute
+}  // namespace arrow
+
+#endif  // ARROW_COMPUTE_DECIMAL_KERNELS_H
@@ -0,0 +1,247 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/compute/dictionary-unifier.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/table.h"
+#include "arrow/test-util.h"
+#include "arrow/type.h"
+
+namespace arrow {
+namespace compute {
+
+// The dictionary value of every slot of a dictionary array of strings
+static std::vector<std::string> DecodeStrings(const Array& array) {
+  const auto& dict_array = static_cast<const DictionaryArray&>(array);
+  const auto& dictionary = static_cast<const StringArray&>(*dict_array.dictionary());
+  const Array& indices = *dict_array.indices();
+  std::vector<std::string> out;
+  for (int64_t i = 0; i < array.length(); ++i) {
+    if (indices.IsNull(i)) {
+      out.push_back("<null>");
+      continue;
+    }
+    int64_t index;
+    switch (indices.type_id()) {
+      case Type::INT8:
+        index = static_cast<const Int8Array&>(indices).Value(i);
+        break;
+      case Type::INT16:
+        index = static_cast<const Int16Array&>(indices).Value(i);
+        break;
+      case Type::INT32:
+        index = static_cast<const Int32Array&>(indices).Value(i);
+        break;
+      default:
+        index = static_cast<const Int64Array&>(indices).Value(i);
+        break;
+    }
+    out.push_back(dictionary.GetString(index));
+  }
+  return out;
+}
+
+TEST(TestDictionaryUnifier, Basics) {
+  std::shared_ptr<Array> dict1, dict2, expected, result;
+  ArrayFromVector<StringType, std::string>({"a", "b", "c"}, &dict1);
+  ArrayFromVector<StringType, std::string>({"c", "d", "a"}, &dict2);
+  ArrayFromVector<StringType, std::string>({"a", "b", "c", "d"}, &expected);
+
+  std::unique_ptr<DictionaryUnifier> unifier;
+  ASSERT_OK(DictionaryUnifier::Make(utf8(), default_memory_pool(), &unifier));
+  std::vector<int32_t> transpose_map;
+  ASSERT_OK(unifier->Unify(*dict1, &transpose_map));
+  ASSERT_EQ(std::vector<int32_t>({0, 1, 2}), transpose_map);
+  ASSERT_OK(unifier->Unify(*dict2, &transpose_map));
+  ASSERT_EQ(std::vector<int32_t>({2, 3, 0}), transpose_map);
+  ASSERT_OK(unifier->GetResult(&result));
+  ASSERT_TRUE(result->Equals(expected));
+
+  std::shared_ptr<Array> ints;
+  ArrayFromVector<Int32Type, int32_t>({1, 2}, &ints);
+  ASSERT_RAISES(Invalid, unifier->Unify(*ints, &transpose_map));
+}
+
+TEST(TestDictionaryUnifier, Transpose) {
+  std::shared_ptr<Array> dict, indices, expected_indices, result;
+  ArrayFromVector<StringType, std::string>({"x", "y", "z"}, &dict);
+  ArrayFromVector<Int8Type, int8_t>(
+      {true, false, true, true, true}, {2, 100, 0, 1, 2}, &indices);
+  DictionaryArray values(dictionary(int8(), dict), indices);
+
+  std::shared_ptr<Array> new_dictionary;
+  ArrayFromVector<StringType, std::string>({"z", "w", "x", "y"}, &new_dictionary);
+  auto new_type = dictionary(int32(), new_dictionary);
+  const std::vector<int32_t> transpose_map = {2, 3, 0};
+
+  // Nulls keep their place regardless of the index stored under them
+  ArrayFromVector<Int32Type, int32_t>(
+      {true, false, true, true, true}, {0, 0, 2, 3, 0}, &expected_indices);
+  ASSERT_OK(
+      Transpose(default_memory_pool(), values, new_type, transpose_map, &result));
+  ASSERT_TRUE(result->type()->Equals(new_type));
+  ASSERT_TRUE(static_cast<const DictionaryArray&>(*result).indices()->Equals(
+      expected_indices));
+
+  auto sliced = values.Slice(2, 3);
+  ASSERT_OK(Transpose(default_memory_pool(), static_cast<const DictionaryArray&>(*sliced),
+      new_type, transpose_map, &result));
+  ASSERT_EQ(DecodeStrings(*sliced), DecodeStrings(*result));
+}
+
+TEST(TestDictionaryUnifier, TransposeOutOfBounds) {
+  std::shared_ptr<Array> dict, result;
+  ArrayFromVector<StringType, std::string>({"x", "y", "z"}, &dict);
+  auto new_type = dictionary(int32(), dict);
+  const std::vector<int32_t> transpose_map = {0, 1, 2};
+
+  for (int8_t index : {3, -1}) {
+    std::shared_ptr<Array> indices;
+    ArrayFromVector<Int8Type, int8_t>({true, true}, {0, index}, &indices);
+    DictionaryArray values(dictionary(int8(), dict), indices);
+    ASSERT_RAISES(Invalid,
+        Transpose(default_memory_pool(), values, new_type, transpose_map, &result));
+  }
+}
+
+// Long enough for the vectorized gather, over every pair of index types
+TEST(TestDictionaryUnifier, TransposeIndexTypes) {
+  const int64_t length = 1003;
+  std::vector<std::string> strings;
+  for (int i = 0; i < 100; ++i) {
+    strings.push_back(std::to_string(i));
+  }
+  std::shared_ptr<Array> dict;
+  ArrayFromVector<StringType, std::string>(strings, &dict);
+  std::vector<int32_t> transpose_map(strings.size());
+  for (size_t i = 0; i < transpose_map.size(); ++i) {
+    transpose_map[i] = static_cast<int32_t>(transpose_map.size() - 1 - i);
+  }
+  std::reverse(strings.begin(), strings.end());
+  std::shared_ptr<Array> new_dictionary;
+  ArrayFromVector<StringType, std::string>(strings, &new_dictionary);
+
+  std::vector<int32_t> positions(length);
+  test::rand_uniform_int(length, 0, 0, 99, positions.data());
+  std::vector<std::shared_ptr<Array>> all_indices(4);
+  ArrayFromVector<Int8Type, int8_t>(
+      std::vector<int8_t>(positions.begin(), positions.end()), &all_indices[0]);
+  ArrayFromVector<Int16Type, int16_t>(
+      std::vector<int16_t>(positions.begin(), positions.end()), &all_indices[1]);
+  ArrayFromVector<Int32Type, int32_t>(positions, &all_indices[2]);
+  ArrayFromVector<Int64Type, int64_t>(
+      std::vector<int64_t>(positions.begin(), positions.end()), &all_indices[3]);
+
+  for (const auto& indices : all_indices) {
+    DictionaryArray values(dictionary(indices->type(), dict), indices);
+    for (const auto& index_type : {int8(), int16(), int32(), int64()}) {
+      std::shared_ptr<Array> result;
+      ASSERT_OK(Transpose(default_memory_pool(), values,
+          dictionary(index_type, new_dictionary), transpose_map, &result));
+      ASSERT_EQ(DecodeStrings(values), DecodeStrings(*result));
+      auto sliced = values.Slice(3, length - 3);
+      ASSERT_OK(Transpose(default_memory_pool(),
+          static_cast<const DictionaryArray&>(*sliced),
+          dictionary(index_type, new_dictionary), transpose_map, &result));
+      ASSERT_EQ(DecodeStrings(*sliced), DecodeStrings(*result));
+    }
+  }
+}
+
+TEST(TestDictionaryUnifier, TransposeMapOutOfRange) {
+  std::shared_ptr<Array> dict, indices, result;
+  ArrayFromVector<StringType, std::string>({"x", "y"}, &dict);
+  ArrayFromVector<Int8Type, int8_t>({0, 0}, &indices);
+  DictionaryArray values(dictionary(int8(), dict), indices);
+
+  // Positions must fit the index type of the result, even if unused
+  ASSERT_RAISES(Invalid, Transpose(default_memory_pool(), values,
+      dictionary(int8(), dict), {0, 128}, &result));
+  ASSERT_RAISES(Invalid, Transpose(default_memory_pool(), values,
+      dictionary(int16(), dict), {0, 40000}, &result));
+  ASSERT_RAISES(Invalid, Transpose(default_memory_pool(), values,
+      dictionary(int32(), dict), {0, -1}, &result));
+  ASSERT_OK(Transpose(default_memory_pool(), values, dictionary(int16(), dict),
+      {0, 128}, &result));
+}
+
+TEST(TestDictionaryUnifier, UnifyChunks) {
+  std::shared_ptr<Array> dict1, dict2, indices1, indices2;
+  ArrayFromVector<StringType, std::string>({"foo", "bar"}, &dict1);
+  ArrayFromVector<StringType, std::string>({"baz", "foo", "quux"}, &dict2);
+  ArrayFromVector<Int8Type, int8_t>({true, true, false}, {1, 0, 0}, &indices1);
+  ArrayFromVector<Int16Type, int16_t>({0, 2, 1, 1}, &indices2);
+  auto chunk1 = std::make_shared<DictionaryArray>(dictionary(int8(), dict1), indices1);
+  auto chunk2 = std::make_shared<DictionaryArray>(dictionary(int16(), dict2), indices2);
+  ChunkedArray values({chunk1, chunk2});
+
+  std::shared_ptr<ChunkedArray> result;
+  ASSERT_OK(UnifyDictionaries(default_memory_pool(), values, &result));
+  ASSERT_EQ(2, result->num_chunks());
+  // The widest index type of the input is kept
+  ASSERT_TRUE(result->chunk(0)->type()->Equals(result->chunk(1)->type()));
+  const auto& type = static_cast<const DictionaryType&>(*result->chunk(0)->type());
+  ASSERT_TRUE(type.index_type()->Equals(int16()));
+  ASSERT_EQ(4, type.dictionary()->length());
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_EQ(DecodeStrings(*values.chunk(i)), DecodeStrings(*result->chunk(i)));
+  }
+}
+
+TEST(TestDictionaryUnifier, WidenIndices) {
+  // 200 distinct values do not fit int8 indices
+  ArrayVector chunks;
+  for (int i = 0; i < 2; ++i) {
+    std::vector<std::string> dict_values;
+    for (int j = 0; j < 100; ++j) {
+      dict_values.push_back(std::to_string(i * 100 + j));
+    }
+    std::shared_ptr<Array> dict, indices;
+    ArrayFromVector<StringType, std::string>(dict_values, &dict);
+    ArrayFromVector<Int8Type, int8_t>({0, 99, 42}, &indices);
+    chunks.push_back(
+        std::make_shared<DictionaryArray>(dictionary(int8(), dict), indices));
+  }
+  ChunkedArray values(chunks);
+
+  std::shared_ptr<ChunkedArray> result;
+  ASSERT_OK(UnifyDictionaries(default_memory_pool(), values, &result));
+  const auto& type = static_cast<const DictionaryType&>(*result->chunk(1)->type());
+  ASSERT_TRUE(type.index_type()->Equals(int16()));
+  ASSERT_EQ(200, type.dictionary()->length());
+  ASSERT_EQ(std::vector<std::string>({"100", "199", "142"}),
+      DecodeStrings(*result->chunk(1)));
+
+  std::shared_ptr<Array> dense;
+  ArrayFromVector<Int32Type, int32_t>({1}, &dense);
+  ASSERT_RAISES(Invalid, UnifyDictionaries(default_memory_pool(),
+                             ChunkedArray({chunks[0], dense}), &result));
+}
+
+}  // namespace compute
+}  // namespace arrow
@@ -0,0 +1,339 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/compute/dictionary-unifier.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/buffer.h"
+#include "arrow/compute/compute-internal.h"
+#include "arrow/compute/hash-table.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/table.h"
+#include "arrow/type.h"
+#include "arrow/util/dispatch.h"
+
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+#include <immintrin.h>
+#endif
+
+namespace arrow {
+namespace compute {
+
+// ----------------------------------------------------------------------
+// DictionaryUnifier
+
+DictionaryUnifier::DictionaryUnifier(const std::shared_ptr<DataType>& value_type,
+    std::unique_ptr<KeyHashTable> hash_table)
+    : value_type_(value_type), hash_table_(std::move(hash_table)) {}
+
+DictionaryUnifier::~DictionaryUnifier() {}
+
+Status DictionaryUnifier::Make(const std::shared_ptr<DataType>& value_type,
+    MemoryPool* pool, std::unique_ptr<DictionaryUnifier>* out) {
+  std::unique_ptr<KeyHashTable> hash_table;
+  RETURN_NOT_OK(KeyHashTable::Make({value_type}, pool, &hash_table));
+  out->reset(new DictionaryUnifier(value_type, std::move(hash_table)));
+  return Status::OK();
+}
+
+Status DictionaryUnifier::Unify(
+    const Array& dictionary, std::vector<int32_t>* transpose_map) {
+  if (!dictionary.type()->Equals(value_type_)) {
+    std::stringstream ss;
+    ss << "Cannot unify a dictionary of type " << dictionary.type()->ToString()
+       << " with dictionaries of type " << value_type_->ToString();
+    return Status::Invalid(ss.str());
+  }
+  // The hash table ids are the positions in the unified dictionary
+  std::shared_ptr<Array> values;
+  RETURN_NOT_OK(internal::MakeArray(dictionary.data(), &values));
+  transpose_map->resize(dictionary.length());
+  return hash_table_->GetOrInsert({values}, dictionary.length(), transpose_map->data());
+}
+
+Status DictionaryUnifier::GetResult(std::shared_ptr<Array>* out) {
+  std::vector<std::shared_ptr<Array>> keys;
+  RETURN_NOT_OK(hash_table_->Finish(&keys));
+  *out = keys[0];
+  return Status::OK();
+}
+
+// ----------------------------------------------------------------------
+// Transpose
+
+// The indices of null slots are arbitrary and must not be looked up
+template <typename InType>
+static Status CheckIndices(const Array& indices, const InType* in, int64_t map_length) {
+  const int64_t length = indices.length();
+  for (int64_t i = 0; i < length; ++i) {
+    if ((in[i] < 0 || in[i] >= map_length) && !indices.IsNull(i)) {
+      std::stringstream ss;
+      ss << "Dictionary index " << static_cast<int64_t>(in[i]) << " at position " << i
+         << " is out of bounds for a transpose map of length " << map_length;
+      return Status::Invalid(ss.str());
+    }
+  }
+  return Status::OK();
+}
+
+// Every position in the map must be representable as an output index, so
+// that the gather never narrows a value
+template <typename OutType>
+static Status CheckTransposeMap(const std::vector<int32_t>& transpose_map) {
+  if (transpose_map.empty()) { return Status::OK(); }
+  const auto range = std::minmax_element(transpose_map.begin(), transpose_map.end());
+  if (*range.first < 0 || *range.second > std::numeric_limits<OutType>::max()) {
+    std::stringstream ss;
+    ss << "Transpose map positions from " << *range.first << " to " << *range.second
+       << " do not fit " << sizeof(OutType) * 8 << "-bit dictionary indices";
+    return Status::Invalid(ss.str());
+  }
+  return Status::OK();
+}
+
+template <typename InType, typename OutType>
+using GatherFunc = void (*)(const InType*, int64_t, const int32_t*, OutType*);
+
+template <typename InType, typename OutType>
+static void GatherScalar(
+    const InType* in, int64_t length, const int32_t* map, OutType* out) {
+  for (int64_t i = 0; i < length; ++i) {
+    out[i] = static_cast<OutType>(map[in[i]]);
+  }
+}
+
+// The AVX2 gather takes 32-bit lanes of indices and of map positions, so it
+// covers indices of up to 32 bits and outputs of 32 bits or more
+template <typename InType, typename OutType>
+struct HasGatherAvx2
+    : std::integral_constant<bool, sizeof(InType) <= 4 && sizeof(OutType) >= 4> {};
+
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+
+ARROW_TARGET_AVX2 inline __m256i LoadIndices(const int8_t* in) {
+  int64_t word;
+  memcpy(&word, in, sizeof(word));
+  return _mm256_cvtepi8_epi32(_mm_cvtsi64_si128(word));
+}
+
+ARROW_TARGET_AVX2 inline __m256i LoadIndices(const int16_t* in) {
+  return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)));
+}
+
+ARROW_TARGET_AVX2 inline __m256i LoadIndices(const int32_t* in) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+}
+
+ARROW_TARGET_AVX2 inline void StorePositions(__m256i positions, int32_t* out) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), positions);
+}
+
+ARROW_TARGET_AVX2 inline void StorePositions(__m256i positions, int64_t* out) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+      _mm256_cvtepi32_epi64(_mm256_castsi256_si128(positions)));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 4),
+      _mm256_cvtepi32_epi64(_mm256_extracti128_si256(positions, 1)));
+}
+
+template <typename InType, typename OutType>
+ARROW_TARGET_AVX2 static void GatherAvx2(
+    const InType* in, int64_t length, const int32_t* map, OutType* out) {
+  int64_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    StorePositions(_mm256_i32gather_epi32(map, LoadIndices(in + i), 4), out + i);
+  }
+  GatherScalar(in + i, length - i, map, out + i);
+}
+
+#endif  // ARROW_HAVE_RUNTIME_AVX2
+
+template <typename InType, typename OutType>
+static typename std::enable_if<!HasGatherAvx2<InType, OutType>::value>::type Gather(
+    const InType* in, int64_t length, const int32_t* map, OutType* out) {
+  GatherScalar(in, length, map, out);
+}
+
+template <typename InType, typename OutType>
+static typename std::enable_if<HasGatherAvx2<InType, OutType>::value>::type Gather(
+    const InType* in, int64_t length, const int32_t* map, OutType* out) {
+  static DynamicDispatch<GatherFunc<InType, OutType>> dispatch({
+      {DispatchLevel::NONE, GatherScalar<InType, OutType>},
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+      {DispatchLevel::AVX2, GatherAvx2<InType, OutType>},
+#endif
+  });
+  dispatch.func(in, length, map, out);
+}
+
+// A gather through the transpose map. Every non-null index and every map
+// position is checked first, so that the gather itself has no branches. The
+// indices under nulls are arbitrary and may not be loaded, so arrays with
+// nulls take a scalar loop
+template <typename InType, typename OutType>
+static Status TransposeIndices(const Array& indices,
+    const std::vector<int32_t>& transpose_map, uint8_t* out_data) {
+  const InType* in =
+      reinterpret_cast<const InType*>(indices.data()->buffers[1]->data()) +
+      indices.offset();
+  const int64_t map_length = static_cast<int64_t>(transpose_map.size());
+  RETURN_NOT_OK(CheckTransposeMap<OutType>(transpose_map));
+  RETURN_NOT_OK(CheckIndices(indices, in, map_length));
+  const int32_t* map = transpose_map.data();
+  OutType* out = reinterpret_cast<OutType*>(out_data);
+  const int64_t length = indices.length();
+  if (indices.null_count() == 0) {
+    Gather(in, length, map, out);
+  } else {
+    for (int64_t i = 0; i < length; ++i) {
+      out[i] = indices.IsNull(i) ? 0 : static_cast<OutType>(map[in[i]]);
+    }
+  }
+  return Status::OK();
+}
+
+template <typename InType>
+static Status TransposeFrom(const Array& indices, Type::type out_type,
+    const std::vector<int32_t>& transpose_map, uint8_t* out) {
+  switch (out_type) {
+    case Type::INT8:
+      return TransposeIndices<InType, int8_t>(indices, transpose_map, out);
+    case Type::INT16:
+      return TransposeIndices<InType, int16_t>(indices, transpose_map, out);
+    case Type::INT32:
+      return TransposeIndices<InType, int32_t>(indices, transpose_map, out);
+    case Type::INT64:
+      return TransposeIndices<InType, int64_t>(indices, transpose_map, out);
+    default:
+      return Status::NotImplemented("Dictionary indices must be signed integers");
+  }
+}
+
+Status Transpose(MemoryPool* pool, const DictionaryArray& values,
+    const std::shared_ptr<DataType>& type, const std::vector<int32_t>& transpose_map,
+    std::shared_ptr<Array>* out) {
+  if (type->id() != Type::DICTIONARY) {
+    return Status::Invalid("Transpose needs a dictionary type to produce");
+  }
+  const auto& out_index_type = static_cast<const DictionaryType&>(*type).index_type();
+  const Array& indices = *values.indices();
+  const int64_t length = indices.length();
+
+  std::vector<std::shared_ptr<Buffer>> buffers(2);
+  RETURN_NOT_OK(OutputValidity(pool, indices, &buffers[0]));
+  std::shared_ptr<MutableBuffer> data;
+  const int byte_width =
+      static_cast<const FixedWidthType&>(*out_index_type).bit_width() / 8;
+  RETURN_NOT_OK(AllocateBuffer(pool, length * byte_width, &data));
+  buffers[1] = data;
+
+  uint8_t* out_data = data->mutable_data();
+  const Type::type out_id = out_index_type->id();
+  switch (indices.type_id()) {
+    case Type::INT8:
+      RETURN_NOT_OK(TransposeFrom<int8_t>(indices, out_id, transpose_map, out_data));
+      break;
+    case Type::INT16:
+      RETURN_NOT_OK(TransposeFrom<int16_t>(indices, out_id, transpose_map, out_data));
+      break;
+    case Type::INT32:
+      RETURN_NOT_OK(TransposeFrom<int32_t>(indices, out_id, transpose_map, out_data));
+      break;
+    case Type::INT64:
+      RETURN_NOT_OK(TransposeFrom<int64_t>(indices, out_id, transpose_map, out_data));
+      break;
+    default:
+      return Status::NotImplemented("Dictionary indices must be signed integers");
+  }
+
+  auto result = std::make_shared<internal::ArrayData>(
+      out_index_type, length, std::move(buffers), indices.null_count());
+  std::shared_ptr<Array> out_indices;
+  RETURN_NOT_OK(internal::MakeArray(result, &out_indices));
+  *out = std::make_shared<DictionaryArray>(type, out_indices);
+  return Status::OK();
+}
+
+// ----------------------------------------------------------------------
+// UnifyDictionaries
+
+// The narrowest signed integer type of at least min_bit_width bits that can
+// index a dictionary of the given length
+static std::shared_ptr<DataType> IndexTypeFor(int min_bit_width, int64_t length) {
+  if (min_bit_width <= 8 && length <= std::numeric_limits<int8_t>::max() + 1) {
+    return int8();
+  } else if (min_bit_width <= 16 && length <= std::numeric_limits<int16_t>::max() + 1) {
+    return int16();
+  } else if (min_bit_width <= 32 &&
+             length <= static_cast<int64_t>(std::numeric_limits<int32_t>::max()) + 1) {
+    return int32();
+  }
+  return int64();
+}
+
+Status UnifyDictionaries(
+    MemoryPool* pool, const ChunkedArray& values, std::shared_ptr<ChunkedArray>* out) {
+  if (values.num_chunks() == 0) {
+    *out = std::make_shared<ChunkedArray>(values.chunks());
+    return Status::OK();
+  }
+  for (const auto& chunk : values.chunks()) {
+    if (chunk->type_id() != Type::DICTIONARY) {
+      return Status::Invalid("Only dictionary-encoded chunks can be unified");
+    }
+  }
+
+  const auto& first = static_cast<const DictionaryArray&>(*values.chunk(0));
+  std::unique_ptr<DictionaryUnifier> unifier;
+  RETURN_NOT_OK(DictionaryUnifier::Make(first.dictionary()->type(), pool, &unifier));
+
+  std::vector<std::vector<int32_t>> transpose_maps(values.num_chunks());
+  int index_bit_width = 8;
+  for (int i = 0; i < values.num_chunks(); ++i) {
+    const auto& chunk = static_cast<const DictionaryArray&>(*values.chunk(i));
+    RETURN_NOT_OK(unifier->Unify(*chunk.dictionary(), &transpose_maps[i]));
+    const auto& index_type =
+        static_cast<const FixedWidthType&>(*chunk.dict_type()->index_type());
+    index_bit_width = std::max(index_bit_width, index_type.bit_width());
+  }
+  std::shared_ptr<Array> dictionary;
+  RETURN_NOT_OK(unifier->GetResult(&dictionary));
+  auto type = std::make_shared<DictionaryType>(
+      IndexTypeFor(index_bit_width, dictionary->length()), dictionary);
+
+  ArrayVector chunks;
+  for (int i = 0; i < values.num_chunks(); ++i) {
+    const auto& chunk = static_cast<const DictionaryArray&>(*values.chunk(i));
+    std::shared_ptr<Array> transposed;
+    RETURN_NOT_OK(Transpose(pool, chunk, type, transpose_maps[i], &transposed));
+    chunks.push_back(transposed);
+  }
+  *out = std::make_shared<ChunkedArray>(chunks);
+  return Status::OK();
+}
+
+}  // namespace compute
+}  // namespace arrow
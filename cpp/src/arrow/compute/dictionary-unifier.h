@@ -0,0 +1,113 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Merging of the dictionaries of dictionary-encoded arrays
+
+#ifndef ARROW_COMPUTE_DICTIONARY_UNIFIER_H
+#define ARROW_COMPUTE_DICTIONARY_UNIFIER_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "arrow/util/visibility.h"
+
+namespace arrow {
+
+class Array;
+class ChunkedArray;
+class DataType;
+class DictionaryArray;
+class MemoryPool;
+class Status;
+
+namespace compute {
+
+class KeyHashTable;
+
+/// \class DictionaryUnifier
+/// \brief Merges any number of dictionaries into one
+///
+/// Every distinct value is assigned a position in the unified dictionary
+/// through a hash table, in order of first appearance. For every dictionary
+/// added, a transpose map gives the unified position of each of its entries,
+/// which Transpose then applies to the indices of the arrays using that
+/// dictionary.
+class ARROW_EXPORT DictionaryUnifier {
+ public:
+  ~DictionaryUnifier();
+
+  /// \brief Create a unifier for dictionaries of the given value type
+  ///
+  /// \param[in] value_type the type of the dictionary values
+  /// \param[in] pool memory pool for the hash table and the result
+  /// \param[out] out the created unifier
+  /// \return Status
+  static Status Make(const std::shared_ptr<DataType>& value_type, MemoryPool* pool,
+      std::unique_ptr<DictionaryUnifier>* out);
+
+  /// \brief Add the values of a dictionary
+  ///
+  /// \param[in] dictionary the dictionary values
+  /// \param[out] transpose_map the unified position of every entry of
+  /// dictionary
+  /// \return Status
+  Status Unify(const Array& dictionary, std::vector<int32_t>* transpose_map);
+
+  /// \brief Produce the unified dictionary of every value added so far. The
+  /// unifier is empty afterwards
+  Status GetResult(std::shared_ptr<Array>* out);
+
+ private:
+  DictionaryUnifier(const std::shared_ptr<DataType>& value_type,
+      std::unique_ptr<KeyHashTable> hash_table);
+
+  std::shared_ptr<DataType> value_type_;
+  std::unique_ptr<KeyHashTable> hash_table_;
+};
+
+/// \brief Remap the indices of a dictionary-encoded array to a new dictionary
+///
+/// \param[in] pool memory pool to allocate the new indices from
+/// \param[in] values the array to remap
+/// \param[in] type the dictionary type of the result, with the new dictionary
+/// and the index type to produce
+/// \param[in] transpose_map the new position of every entry of the dictionary
+/// of values. A non-null index outside of it is an error
+/// \param[out] out the remapped array
+/// \return Status
+Status ARROW_EXPORT Transpose(MemoryPool* pool, const DictionaryArray& values,
+    const std::shared_ptr<DataType>& type, const std::vector<int32_t>& transpose_map,
+    std::shared_ptr<Array>* out);
+
+/// \brief Rewrite the chunks of a dictionary-encoded column to share a single
+/// dictionary
+///
+/// The result uses the widest index type of the chunks, widened further if
+/// the unified dictionary needs it.
+///
+/// \param[in] pool memory pool to allocate the result from
+/// \param[in] values chunks with dictionary types of the same value type
+/// \param[out] out the chunks of values, all with the same dictionary type
+/// \return Status
+Status ARROW_EXPORT UnifyDictionaries(MemoryPool* pool, const ChunkedArray& values,
+    std::shared_ptr<ChunkedArray>* out);
+
+}  // namespace compute
+}  // namespace arrow
+
+#endif  // ARROW_COMPUTE_DICTIONARY_UNIFIER_H
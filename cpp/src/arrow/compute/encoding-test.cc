@@ -0,0 +1,368 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/compute/encoding.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/test-util.h"
+#include "arrow/type.h"
+
+namespace arrow {
+namespace compute {
+
+class TestEncoding : public ::testing::Test {
+ public:
+  // Encoding values and decoding the result gives the values back, also for
+  // slices of the encoded array
+  void CheckRoundTrip(const std::shared_ptr<Array>& encoded,
+      const std::shared_ptr<Array>& values) {
+    ASSERT_OK(ValidateArray(*encoded));
+    ASSERT_EQ(values->length(), encoded->length());
+
+    std::shared_ptr<Array> decoded;
+    ASSERT_OK(Decode(default_memory_pool(), *encoded, &decoded));
+    ASSERT_TRUE(decoded->type()->Equals(values->type()));
+    ASSERT_EQ(values->null_count(), decoded->null_count());
+    ASSERT_TRUE(decoded->Equals(values));
+
+    const int64_t length = values->length();
+    for (int64_t offset : {int64_t(1), length / 3, length - 1}) {
+      if (offset < 0 || offset > length) { continue; }
+      const int64_t slice_length = (length - offset) / 2 + 1;
+      std::shared_ptr<Array> slice = encoded->Slice(offset, slice_length);
+      std::shared_ptr<Array> expected = values->Slice(offset, slice_length);
+      ASSERT_OK(ValidateArray(*slice));
+      ASSERT_OK(Decode(default_memory_pool(), *slice, &decoded));
+      ASSERT_TRUE(decoded->Equals(expected));
+    }
+  }
+
+  // Reducing the encoded array gives the result of reducing the values
+  void CheckReduce(const std::shared_ptr<Array>& encoded,
+      const std::shared_ptr<Array>& values) {
+    for (auto function :
+        {AggregateFunction::COUNT, AggregateFunction::SUM, AggregateFunction::MIN,
+            AggregateFunction::MAX, AggregateFunction::MEAN}) {
+      std::shared_ptr<Array> result, expected;
+      ASSERT_OK(Reduce(default_memory_pool(), *encoded, function, &result));
+      ASSERT_OK(Reduce(default_memory_pool(), *values, function, &expected));
+      ASSERT_EQ(1, result->length());
+      ASSERT_TRUE(result->ApproxEquals(expected)) << result->ToString() << " vs "
+                                                  << expected->ToString();
+    }
+  }
+};
+
+TEST_F(TestEncoding, EncodedTypes) {
+  auto ree = run_end_encoded(int16());
+  ASSERT_EQ(Type::RUN_END_ENCODED, ree->id());
+  ASSERT_EQ("run_end_encoded<int16>", ree->ToString());
+  ASSERT_EQ(2, ree->num_children());
+  ASSERT_TRUE(ree->Equals(run_end_encoded(int16())));
+  ASSERT_FALSE(ree->Equals(run_end_encoded(int32())));
+
+  auto packed = bit_packed(int32(), 5);
+  ASSERT_EQ(Type::BIT_PACKED, packed->id());
+  ASSERT_EQ("bit_packed<int32, bits=5>", packed->ToString());
+  ASSERT_EQ(5, static_cast<const FixedWidthType&>(*packed).bit_width());
+  ASSERT_TRUE(packed->Equals(bit_packed(int32(), 5)));
+  ASSERT_FALSE(packed->Equals(bit_packed(int32(), 6)));
+  ASSERT_FALSE(packed->Equals(bit_packed(uint32(), 5)));
+}
+
+TEST_F(TestEncoding, RunEndEncodePrimitive) {
+  std::shared_ptr<Array> values, encoded, expected_ends, expected_values;
+  ArrayFromVector<Int32Type, int32_t>({true, true, false, false, true, true, true, true},
+      {1, 1, 0, 0, 2, 2, 2, 1}, &values);
+  ASSERT_OK(RunEndEncode(default_memory_pool(), *values, &encoded));
+  ASSERT_TRUE(encoded->type()->Equals(run_end_encoded(int32())));
+  ASSERT_EQ(0, encoded->null_count());
+
+  const auto& runs = static_cast<const RunEndEncodedArray&>(*encoded);
+  ArrayFromVector<Int32Type, int32_t>({2, 4, 7, 8}, &expected_ends);
+  ArrayFromVector<Int32Type, int32_t>(
+      {true, false, true, true}, {1, 0, 2, 1}, &expected_values);
+  ASSERT_TRUE(runs.run_ends()->Equals(expected_ends));
+  ASSERT_TRUE(runs.values()->Equals(expected_values));
+  ASSERT_EQ(0, runs.FindPhysicalIndex(1));
+  ASSERT_EQ(1, runs.FindPhysicalIndex(2));
+  ASSERT_EQ(3, runs.FindPhysicalIndex(7));
+  ASSERT_EQ(0, runs.physical_offset());
+  ASSERT_EQ(4, runs.physical_length());
+
+  // A slice starting and ending within runs
+  auto slice = std::static_pointer_cast<RunEndEncodedArray>(encoded->Slice(3, 3));
+  ASSERT_EQ(1, slice->physical_offset());
+  ASSERT_EQ(2, slice->physical_length());
+  ASSERT_EQ(2, slice->FindPhysicalIndex(1));
+
+  CheckRoundTrip(encoded, values);
+  CheckReduce(encoded, values);
+}
+
+TEST_F(TestEncoding, RunEndEncodeOtherTypes) {
+  std::shared_ptr<Array> values, encoded;
+  ArrayFromVector<StringType, std::string>({true, true, true, false, true},
+      {"foo", "foo", "bar", "", "bar"}, &values);
+  ASSERT_OK(RunEndEncode(default_memory_pool(), *values, &encoded));
+  ASSERT_EQ(4, static_cast<const RunEndEncodedArray&>(*encoded).values()->length());
+  CheckRoundTrip(encoded, values);
+
+  ArrayFromVector<BooleanType, bool>({true, true, false, false, false, true}, &values);
+  ASSERT_OK(RunEndEncode(default_memory_pool(), *values, &encoded));
+  ASSERT_EQ(3, static_cast<const RunEndEncodedArray&>(*encoded).values()->length());
+  CheckRoundTrip(encoded, values);
+
+  ArrayFromVector<DoubleType, double>({}, &values);
+  ASSERT_OK(RunEndEncode(default_memory_pool(), *values, &encoded));
+  ASSERT_EQ(0, encoded->length());
+  std::shared_ptr<Array> decoded;
+  ASSERT_OK(Decode(default_memory_pool(), *encoded, &decoded));
+  ASSERT_EQ(0, decoded->length());
+}
+
+TEST_F(TestEncoding, RunEndEncodedEquality) {
+  std::shared_ptr<Array> values, encoded, encoded_slice;
+  ArrayFromVector<Int64Type, int64_t>({5, 5, 5, 6, 6, 7, 7, 7, 7}, &values);
+  ASSERT_OK(RunEndEncode(default_memory_pool(), *values, &encoded));
+
+  // Slices compare by value, whatever the layout of their runs
+  ASSERT_OK(RunEndEncode(default_memory_pool(), *values->Slice(2, 5), &encoded_slice));
+  ASSERT_TRUE(encoded->Slice(2, 5)->Equals(encoded_slice));
+  ASSERT_TRUE(encoded->RangeEquals(2, 7, 0, encoded_slice));
+  ASSERT_FALSE(encoded->Slice(1, 5)->Equals(encoded_slice));
+}
+
+TEST_F(TestEncoding, RunEndEncodedValidate) {
+  std::shared_ptr<Array> run_ends, run_values;
+  ArrayFromVector<Int32Type, int32_t>({1, 2, 3}, &run_values);
+  auto type = run_end_encoded(int32());
+
+  ArrayFromVector<Int32Type, int32_t>({2, 2, 4}, &run_ends);
+  ASSERT_RAISES(
+      Invalid, ValidateArray(RunEndEncodedArray(type, 4, run_ends, run_values)));
+
+  ArrayFromVector<Int32Type, int32_t>({2, 3, 4}, &run_ends);
+  ASSERT_OK(ValidateArray(RunEndEncodedArray(type, 4, run_ends, run_values)));
+  ASSERT_RAISES(
+      Invalid, ValidateArray(RunEndEncodedArray(type, 5, run_ends, run_values)));
+  ASSERT_RAISES(Invalid,
+      ValidateArray(RunEndEncodedArray(type, 2, run_ends, run_values->Slice(1))));
+}
+
+TEST_F(TestEncoding, BitPackMinimalWidth) {
+  std::shared_ptr<Array> values, packed;
+  ArrayFromVector<UInt32Type, uint32_t>(
+      {true, true, false, true}, {0, 5, 1000, 7}, &values);
+  ASSERT_OK(BitPack(default_memory_pool(), *values, 0, &packed));
+  ASSERT_TRUE(packed->type()->Equals(bit_packed(uint32(), 3)));
+  ASSERT_EQ(1, packed->null_count());
+  ASSERT_EQ(7, static_cast<const BitPackedArray&>(*packed).Value(3));
+  CheckRoundTrip(packed, values);
+
+  ArrayFromVector<Int16Type, int16_t>({-4, 3, -1, 0, 2}, &values);
+  ASSERT_OK(BitPack(default_memory_pool(), *values, 0, &packed));
+  ASSERT_TRUE(packed->type()->Equals(bit_packed(int16(), 3)));
+  ASSERT_EQ(-4, static_cast<const BitPackedArray&>(*packed).Value(0));
+  ASSERT_EQ(-1, static_cast<const BitPackedArray&>(*packed).Value(2));
+  CheckRoundTrip(packed, values);
+
+  // All zero or null values take a single bit
+  ArrayFromVector<Int8Type, int8_t>({true, false}, {0, 0}, &values);
+  ASSERT_OK(BitPack(default_memory_pool(), *values, 0, &packed));
+  ASSERT_TRUE(packed->type()->Equals(bit_packed(int8(), 1)));
+}
+
+TEST_F(TestEncoding, BitPackExplicitWidth) {
+  std::shared_ptr<Array> values, packed;
+  ArrayFromVector<Int32Type, int32_t>({-8, 7, 0}, &values);
+  ASSERT_OK(BitPack(default_memory_pool(), *values, 11, &packed));
+  ASSERT_TRUE(packed->type()->Equals(bit_packed(int32(), 11)));
+  CheckRoundTrip(packed, values);
+
+  ASSERT_RAISES(Invalid, BitPack(default_memory_pool(), *values, 3, &packed));
+  ASSERT_RAISES(Invalid, BitPack(default_memory_pool(), *values, 33, &packed));
+  ASSERT_RAISES(Invalid, BitPack(default_memory_pool(), *values, -1, &packed));
+
+  ArrayFromVector<DoubleType, double>({1.5}, &values);
+  ASSERT_RAISES(NotImplemented, BitPack(default_memory_pool(), *values, 0, &packed));
+}
+
+template <typename ArrowType>
+void MakeRandomIntegers(int64_t length, int bit_width, std::shared_ptr<Array>* out) {
+  using c_type = typename ArrowType::c_type;
+  std::mt19937_64 gen(bit_width);
+  std::uniform_int_distribution<uint64_t> bits;
+  std::uniform_int_distribution<int> valid(0, 9);
+  std::vector<bool> is_valid;
+  std::vector<c_type> values;
+  const int shift = 64 - bit_width;
+  for (int64_t i = 0; i < length; ++i) {
+    // Sign-extends from bit_width bits for signed types
+    const uint64_t value = bits(gen) << shift;
+    values.push_back(std::is_signed<c_type>::value
+                         ? static_cast<c_type>(static_cast<int64_t>(value) >> shift)
+                         : static_cast<c_type>(value >> shift));
+    is_valid.push_back(valid(gen) != 0);
+  }
+  ArrayFromVector<ArrowType, c_type>(is_valid, values, out);
+}
+
+TEST_F(TestEncoding, BitPackRandom) {
+  // Long enough to be decoded by the block kernels, with unaligned slices
+  const int64_t length = 3000;
+  std::shared_ptr<Array> values, packed;
+  for (int bit_width : {1, 3, 7, 8}) {
+    MakeRandomIntegers<Int8Type>(length, bit_width, &values);
+    ASSERT_OK(BitPack(default_memory_pool(), *values, bit_width, &packed));
+    CheckRoundTrip(packed, values);
+    CheckReduce(packed, values);
+  }
+  for (int bit_width : {5, 13, 16}) {
+    MakeRandomIntegers<UInt16Type>(length, bit_width, &values);
+    ASSERT_OK(BitPack(default_memory_pool(), *values, bit_width, &packed));
+    CheckRoundTrip(packed, values);
+  }
+  for (int bit_width : {17, 31, 32}) {
+    MakeRandomIntegers<Int32Type>(length, bit_width, &values);
+    ASSERT_OK(BitPack(default_memory_pool(), *values, 0, &packed));
+    CheckRoundTrip(packed, values);
+    CheckReduce(packed, values);
+  }
+  for (int bit_width : {33, 63, 64}) {
+    MakeRandomIntegers<UInt64Type>(length, bit_width, &values);
+    ASSERT_OK(BitPack(default_memory_pool(), *values, bit_width, &packed));
+    CheckRoundTrip(packed, values);
+    MakeRandomIntegers<Int64Type>(length, bit_width, &values);
+    ASSERT_OK(BitPack(default_memory_pool(), *values, bit_width, &packed));
+    CheckRoundTrip(packed, values);
+  }
+}
+
+TEST_F(TestEncoding, IntegerEncodings) {
+  std::shared_ptr<Array> values, decoded;
+  std::shared_ptr<Buffer> encoded;
+  auto type = timestamp(TimeUnit::MILLI);
+  std::vector<bool> is_valid;
+  std::vector<int64_t> timestamps;
+  for (int64_t i = 0; i < 1000; ++i) {
+    is_valid.push_back(i % 7 != 0);
+    timestamps.push_back(i % 7 != 0 ? 1500000000000 + 10 * i + i % 3 : 0);
+  }
+  ArrayFromVector<TimestampType, int64_t>(type, is_valid, timestamps, &values);
+
+  for (auto encoding : {IntegerEncoding::DELTA, IntegerEncoding::FRAME_OF_REFERENCE,
+           IntegerEncoding::ZIGZAG_VLQ}) {
+    ASSERT_OK(EncodeIntegerArray(default_memory_pool(), *values, encoding, &encoded));
+    ASSERT_OK(DecodeIntegerArray(default_memory_pool(), type, *encoded,
+        values->null_bitmap(), values->null_count(), &decoded));
+    ASSERT_TRUE(decoded->Equals(values));
+
+    // A slice without nulls
+    auto slice = values->Slice(1, 6);
+    ASSERT_OK(EncodeIntegerArray(default_memory_pool(), *slice, encoding, &encoded));
+    ASSERT_OK(
+        DecodeIntegerArray(default_memory_pool(), type, *encoded, nullptr, 0, &decoded));
+    ASSERT_TRUE(decoded->Equals(slice));
+  }
+
+  // Nulls repeat the preceding value, so regular steps take a few bits per value
+  ASSERT_OK(EncodeIntegerArray(
+      default_memory_pool(), *values, IntegerEncoding::DELTA, &encoded));
+  ASSERT_LT(encoded->size(), values->length());
+
+  ArrayFromVector<Date32Type, int32_t>({17000, 17001, 17003}, &values);
+  ASSERT_OK(EncodeIntegerArray(
+      default_memory_pool(), *values, IntegerEncoding::DELTA, &encoded));
+  ASSERT_OK(DecodeIntegerArray(
+      default_memory_pool(), date32(), *encoded, nullptr, 0, &decoded));
+  ASSERT_TRUE(decoded->Equals(values));
+  ASSERT_RAISES(Invalid,
+      DecodeIntegerArray(default_memory_pool(), int64(), *encoded, nullptr, 0, &decoded));
+
+  ArrayFromVector<Int16Type, int16_t>({1, 2}, &values);
+  ASSERT_RAISES(Invalid, EncodeIntegerArray(default_memory_pool(), *values,
+                             IntegerEncoding::DELTA, &encoded));
+}
+
+TEST_F(TestEncoding, ReduceRuns) {
+  std::shared_ptr<Array> values, encoded;
+  std::vector<bool> is_valid;
+  std::vector<double> data;
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int> run_length(1, 50);
+  std::uniform_int_distribution<int> value(-100, 100);
+  while (data.size() < 5000) {
+    const int n = run_length(gen);
+    const int v = value(gen);
+    data.insert(data.end(), n, v * 0.5);
+    is_valid.insert(is_valid.end(), n, v % 7 != 0);
+  }
+  ArrayFromVector<DoubleType, double>(is_valid, data, &values);
+  ASSERT_OK(RunEndEncode(default_memory_pool(), *values, &encoded));
+  CheckRoundTrip(encoded, values);
+  CheckReduce(encoded, values);
+  CheckReduce(encoded->Slice(17, 3000), values->Slice(17, 3000));
+
+  std::shared_ptr<Array> result, expected;
+  ASSERT_OK(Reduce(default_memory_pool(), *encoded, AggregateFunction::SUM, &result));
+  ASSERT_TRUE(result->type()->Equals(float64()));
+}
+
+TEST_F(TestEncoding, ReduceResults) {
+  std::shared_ptr<Array> values, encoded, result, expected;
+  ArrayFromVector<Int8Type, int8_t>({100, 100, 100, -3}, &values);
+  ASSERT_OK(RunEndEncode(default_memory_pool(), *values, &encoded));
+
+  // Integer sums do not overflow the input type
+  ASSERT_OK(Reduce(default_memory_pool(), *encoded, AggregateFunction::SUM, &result));
+  ArrayFromVector<Int64Type, int64_t>({297}, &expected);
+  ASSERT_TRUE(result->Equals(expected));
+
+  ASSERT_OK(Reduce(default_memory_pool(), *encoded, AggregateFunction::MIN, &result));
+  ArrayFromVector<Int8Type, int8_t>({-3}, &expected);
+  ASSERT_TRUE(result->Equals(expected));
+
+  ASSERT_OK(Reduce(default_memory_pool(), *encoded, AggregateFunction::MEAN, &result));
+  ArrayFromVector<DoubleType, double>({74.25}, &expected);
+  ASSERT_TRUE(result->Equals(expected));
+
+  // Only COUNT is valid without any non-null value
+  ArrayFromVector<Int8Type, int8_t>({false, false}, {0, 0}, &values);
+  ASSERT_OK(RunEndEncode(default_memory_pool(), *values, &encoded));
+  ASSERT_OK(Reduce(default_memory_pool(), *encoded, AggregateFunction::COUNT, &result));
+  ArrayFromVector<Int64Type, int64_t>({0}, &expected);
+  ASSERT_TRUE(result->Equals(expected));
+  ASSERT_OK(Reduce(default_memory_pool(), *encoded, AggregateFunction::MAX, &result));
+  ASSERT_EQ(1, result->null_count());
+
+  ArrayFromVector<StringType, std::string>({"a"}, &values);
+  ASSERT_RAISES(NotImplemented,
+      Reduce(default_memory_pool(), *values, AggregateFunction::SUM, &result));
+}
+
+}  // namespace compute
+}  // namespace arrow
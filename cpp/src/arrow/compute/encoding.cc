@@ -0,0 +1,618 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "arrow/compute/encoding.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <type_traits>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/buffer.h"
+#include "arrow/builder.h"
+#include "arrow/compute/compute-internal.h"
+#include "arrow/compute/take.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/type.h"
+#include "arrow/type_traits.h"
+#include "arrow/util/bit-util.h"
+#include "arrow/util/bpacking.h"
+#include "arrow/util/int-encoding.h"
+#include "arrow/visitor_inline.h"
+
+namespace arrow {
+namespace compute {
+
+namespace {
+
+// ----------------------------------------------------------------------
+// Run-end encoding
+
+// Append the end and the first slot of every run of values. equal(i, j)
+// compares the non-null slots i and j
+template <typename Equal>
+void FindRuns(const Array& values, Equal&& equal, std::vector<int32_t>* run_ends,
+    std::vector<int64_t>* run_starts) {
+  const int64_t length = values.length();
+  if (length == 0) { return; }
+  run_starts->push_back(0);
+  bool prev_null = values.IsNull(0);
+  for (int64_t i = 1; i < length; ++i) {
+    const bool is_null = values.IsNull(i);
+    if (is_null != prev_null || (!is_null && !equal(i - 1, i))) {
+      run_ends->push_back(static_cast<int32_t>(i));
+      run_starts->push_back(i);
+    }
+    prev_null = is_null;
+  }
+  run_ends->push_back(static_cast<int32_t>(length));
+}
+
+// Fixed-width values are compared as unsigned integers of their width, so
+// that equal bit patterns (such as NaNs) share a run
+template <typename T>
+void FindFixedWidthRuns(const Array& values, std::vector<int32_t>* run_ends,
+    std::vector<int64_t>* run_starts) {
+  const T* data =
+      reinterpret_cast<const T*>(values.data()->buffers[1]->data()) + values.offset();
+  FindRuns(values, [data](int64_t i, int64_t j) { return data[i] == data[j]; },
+      run_ends, run_starts);
+}
+
+Status FindValueRuns(const Array& values, std::vector<int32_t>* run_ends,
+    std::vector<int64_t>* run_starts) {
+  const Type::type type_id = values.type_id();
+  if (type_id == Type::BOOL) {
+    const uint8_t* bits = static_cast<const BooleanArray&>(values).values()->data();
+    const int64_t offset = values.offset();
+    FindRuns(values,
+        [bits, offset](int64_t i, int64_t j) {
+          return BitUtil::GetBit(bits, offset + i) == BitUtil::GetBit(bits, offset + j);
+        },
+        run_ends, run_starts);
+  } else if (type_id == Type::BINARY || type_id == Type::STRING) {
+    const auto& binary = static_cast<const BinaryArray&>(values);
+    FindRuns(values,
+        [&binary](int64_t i, int64_t j) {
+          int32_t i_length, j_length;
+          const uint8_t* i_data = binary.GetValue(i, &i_length);
+          const uint8_t* j_data = binary.GetValue(j, &j_length);
+          return i_length == j_length && memcmp(i_data, j_data, i_length) == 0;
+        },
+        run_ends, run_starts);
+  } else if (type_id == Type::DICTIONARY || type_id == Type::FIXED_SIZE_BINARY ||
+             (is_primitive(type_id) && type_id != Type::NA)) {
+    // Empty arrays may have no data buffer
+    if (values.length() == 0) { return Status::OK(); }
+    const int byte_width =
+        static_cast<const FixedWidthType&>(*values.type()).bit_width() / 8;
+    switch (byte_width) {
+      case 1:
+        FindFixedWidthRuns<uint8_t>(values, run_ends, run_starts);
+        break;
+      case 2:
+        FindFixedWidthRuns<uint16_t>(values, run_ends, run_starts);
+        break;
+      case 4:
+        FindFixedWidthRuns<uint32_t>(values, run_ends, run_starts);
+        break;
+      case 8:
+        FindFixedWidthRuns<uint64_t>(values, run_ends, run_starts);
+        break;
+      default: {
+        const uint8_t* data =
+            values.data()->buffers[1]->data() + values.offset() * byte_width;
+        FindRuns(values,
+            [data, byte_width](int64_t i, int64_t j) {
+              return memcmp(data + i * byte_width, data + j * byte_width, byte_width) ==
+                     0;
+            },
+            run_ends, run_starts);
+      } break;
+    }
+  } else {
+    std::stringstream ss;
+    ss << "Run-end encoding is not implemented for type " << values.type()->ToString();
+    return Status::NotImplemented(ss.str());
+  }
+  return Status::OK();
+}
+
+// ----------------------------------------------------------------------
+// Bit-packing
+
+inline void StoreWord(uint64_t word, uint8_t* out) {
+#if __BYTE_ORDER != __LITTLE_ENDIAN
+  word = BitUtil::ByteSwap(word);
+#endif
+  memcpy(out, &word, sizeof(word));
+}
+
+// Pack the low bit_width bits of every value, least significant bit first.
+// Null slots are packed as zero
+template <typename CType>
+void PackValues(
+    const Array& array, const CType* values, int bit_width, uint8_t* out) {
+  const uint64_t mask = bit_width == 64 ? ~static_cast<uint64_t>(0)
+                                        : (static_cast<uint64_t>(1) << bit_width) - 1;
+  uint64_t buffered = 0;
+  int num_buffered = 0;
+  for (int64_t i = 0; i < array.length(); ++i) {
+    const uint64_t value = array.IsNull(i) ? 0 : static_cast<uint64_t>(values[i]) & mask;
+    buffered |= value << num_buffered;
+    num_buffered += bit_width;
+    if (num_buffered >= 64) {
+      StoreWord(buffered, out);
+      out += sizeof(uint64_t);
+      num_buffered -= 64;
+      // The bits of the value that did not fit in the stored word
+      buffered = num_buffered == 0 ? 0 : value >> (bit_width - num_buffered);
+    }
+  }
+  for (int shift = 0; shift < num_buffered; shift += 8) {
+    *out++ = static_cast<uint8_t>(buffered >> shift);
+  }
+}
+
+// Bits needed for a value: its magnitude, plus the sign bit for signed types.
+// Negative values are complemented, -1 needing a single bit like 0
+template <typename CType>
+typename std::enable_if<std::is_signed<CType>::value, uint64_t>::type Magnitude(
+    CType value) {
+  return static_cast<uint64_t>(value < 0 ? ~static_cast<int64_t>(value) : value);
+}
+
+template <typename CType>
+typename std::enable_if<std::is_unsigned<CType>::value, uint64_t>::type Magnitude(
+    CType value) {
+  return value;
+}
+
+class BitPacker {
+ public:
+  BitPacker(MemoryPool* pool, const Array& values, int bit_width,
+      std::shared_ptr<Array>* out)
+      : pool_(pool), values_(values), bit_width_(bit_width), out_(out) {}
+
+  template <typename T>
+  typename std::enable_if<std::is_base_of<Integer, T>::value, Status>::type Visit(
+      const T& type) {
+    using c_type = typename T::c_type;
+    const c_type* values = static_cast<const NumericArray<T>&>(values_).raw_values();
+    const int64_t length = values_.length();
+
+    uint64_t magnitudes = 0;
+    for (int64_t i = 0; i < length; ++i) {
+      if (!values_.IsNull(i)) { magnitudes |= Magnitude(values[i]); }
+    }
+    const int needed_bits = std::max(
+        BitUtil::NumRequiredBits(magnitudes) + (std::is_signed<c_type>::value ? 1 : 0),
+        1);
+    const int bit_width = bit_width_ == 0 ? needed_bits : bit_width_;
+    if (bit_width < needed_bits || bit_width > type.bit_width()) {
+      std::stringstream ss;
+      ss << "Cannot pack " << type.ToString() << " values needing " << needed_bits
+         << " bits into " << bit_width << " bits";
+      return Status::Invalid(ss.str());
+    }
+
+    std::shared_ptr<MutableBuffer> packed;
+    RETURN_NOT_OK(
+        AllocateBuffer(pool_, BitUtil::BytesForBits(length * bit_width), &packed));
+    PackValues(values_, values, bit_width, packed->mutable_data());
+
+    std::shared_ptr<Buffer> validity;
+    RETURN_NOT_OK(OutputValidity(pool_, values_, &validity));
+    *out_ = std::make_shared<BitPackedArray>(bit_packed(values_.type(), bit_width),
+        length, packed, validity, values_.null_count());
+    return Status::OK();
+  }
+
+  Status Visit(const DataType& type) {
+    std::stringstream ss;
+    ss << "Bit-packing is not implemented for type " << type.ToString();
+    return Status::NotImplemented(ss.str());
+  }
+
+ private:
+  MemoryPool* pool_;
+  const Array& values_;
+  int bit_width_;
+  std::shared_ptr<Array>* out_;
+};
+
+// Decode length slots of a bit-packed array starting at slot start. Values of
+// at most 32 bits are unpacked 32 at a time by the vectorized unpack32 kernels
+// once the slot is a multiple of 32, where the packed data is word aligned
+template <typename CType>
+void UnpackValues(
+    const BitPackedArray& array, int64_t start, int64_t length, CType* out) {
+  static constexpr int64_t kBlockSize = 1024;
+  const int bit_width = array.bit_width();
+  int64_t i = 0;
+  if (bit_width <= 32) {
+    const int64_t first = array.offset() + start;
+    const int64_t head = std::min(length, (32 - first % 32) % 32);
+    for (; i < head; ++i) {
+      out[i] = static_cast<CType>(array.Value(start + i));
+    }
+    const uint64_t sign_bit =
+        std::is_signed<CType>::value ? static_cast<uint64_t>(1) << (bit_width - 1) : 0;
+    uint32_t unpacked[kBlockSize];
+    while (length - i >= 32) {
+      const int64_t batch = std::min(kBlockSize, (length - i) / 32 * 32);
+      const uint8_t* packed = array.raw_values() + (first + i) / 8 * bit_width;
+      unpack32(reinterpret_cast<const uint32_t*>(packed), unpacked,
+          static_cast<int>(batch), bit_width);
+      for (int64_t k = 0; k < batch; ++k) {
+        out[i + k] = static_cast<CType>((unpacked[k] ^ sign_bit) - sign_bit);
+      }
+      i += batch;
+    }
+  }
+  for (; i < length; ++i) {
+    out[i] = static_cast<CType>(array.Value(start + i));
+  }
+}
+
+class BitPackedDecoder {
+ public:
+  BitPackedDecoder(
+      MemoryPool* pool, const BitPackedArray& array, std::shared_ptr<Array>* out)
+      : pool_(pool), array_(array), out_(out) {}
+
+  template <typename T>
+  typename std::enable_if<std::is_base_of<Integer, T>::value, Status>::type Visit(
+      const T& type) {
+    using c_type = typename T::c_type;
+    const int64_t length = array_.length();
+    std::vector<std::shared_ptr<Buffer>> buffers(1);
+    RETURN_NOT_OK(OutputValidity(pool_, array_, &buffers[0]));
+    std::shared_ptr<MutableBuffer> data;
+    RETURN_NOT_OK(AllocateBuffer(pool_, length * sizeof(c_type), &data));
+    UnpackValues(array_, 0, length, reinterpret_cast<c_type*>(data->mutable_data()));
+    buffers.push_back(data);
+
+    auto result = std::make_shared<internal::ArrayData>(
+        array_.value_type(), length, std::move(buffers), array_.null_count());
+    return internal::MakeArray(result, out_);
+  }
+
+  Status Visit(const DataType& type) {
+    return Status::Invalid("Bit-packed values must be integers");
+  }
+
+ private:
+  MemoryPool* pool_;
+  const BitPackedArray& array_;
+  std::shared_ptr<Array>* out_;
+};
+
+Status DecodeRuns(
+    MemoryPool* pool, const RunEndEncodedArray& array, std::shared_ptr<Array>* out) {
+  const int32_t* run_ends = array.raw_run_ends();
+  const int64_t end = array.offset() + array.length();
+  std::vector<int64_t> indices(array.length());
+  int64_t run_start = array.offset();
+  for (int64_t j = array.physical_offset(); run_start < end; ++j) {
+    const int64_t run_end = std::min<int64_t>(run_ends[j], end);
+    std::fill(indices.begin() + (run_start - array.offset()),
+        indices.begin() + (run_end - array.offset()), j);
+    run_start = run_end;
+  }
+  return Take(pool, *array.values(), indices.data(), array.length(), out);
+}
+
+// ----------------------------------------------------------------------
+// Aggregation
+
+template <typename ArrowType>
+Status MakeScalarArray(MemoryPool* pool, const std::shared_ptr<DataType>& type,
+    bool is_valid, typename ArrowType::c_type value, std::shared_ptr<Array>* out) {
+  NumericBuilder<ArrowType> builder(pool, type);
+  RETURN_NOT_OK(is_valid ? builder.Append(value) : builder.AppendNull());
+  return builder.Finish(out);
+}
+
+// Running state of every aggregate function. A value can stand for a run of
+// weight equal values
+template <typename ArrowType>
+class Reducer {
+ public:
+  using c_type = typename ArrowType::c_type;
+  using SumType = typename SumTraits<ArrowType>::type;
+  using sum_type = typename SumType::c_type;
+
+  Reducer()
+      : count_(0),
+        sum_(0),
+        mean_sum_(0),
+        min_(std::numeric_limits<c_type>::max()),
+        max_(std::numeric_limits<c_type>::lowest()) {}
+
+  void Update(c_type value, int64_t weight) {
+    count_ += weight;
+    sum_ += static_cast<sum_type>(value) * static_cast<sum_type>(weight);
+    mean_sum_ += static_cast<double>(value) * static_cast<double>(weight);
+    min_ = std::min(min_, value);
+    max_ = std::max(max_, value);
+  }
+
+  Status Finish(MemoryPool* pool, AggregateFunction::type function,
+      const std::shared_ptr<DataType>& type, std::shared_ptr<Array>* out) const {
+    const bool is_valid = count_ > 0;
+    switch (function) {
+      case AggregateFunction::COUNT:
+        return MakeScalarArray<Int64Type>(pool, int64(), true, count_, out);
+      case AggregateFunction::SUM:
+        return MakeScalarArray<SumType>(
+            pool, TypeTraits<SumType>::type_singleton(), is_valid, sum_, out);
+      case AggregateFunction::MIN:
+        return MakeScalarArray<ArrowType>(pool, type, is_valid, min_, out);
+      case AggregateFunction::MAX:
+        return MakeScalarArray<ArrowType>(pool, type, is_valid, max_, out);
+      case AggregateFunction::MEAN:
+        return MakeScalarArray<DoubleType>(pool, float64(), is_valid,
+            is_valid ? mean_sum_ / static_cast<double>(count_) : 0, out);
+    }
+    return Status::Invalid("Unknown aggregate function");
+  }
+
+ private:
+  int64_t count_;
+  sum_type sum_;
+  double mean_sum_;
+  c_type min_;
+  c_type max_;
+};
+
+class ReduceVisitor {
+ public:
+  ReduceVisitor(MemoryPool* pool, const Array& values, AggregateFunction::type function,
+      std::shared_ptr<Array>* out)
+      : pool_(pool), values_(values), function_(function), out_(out) {}
+
+  template <typename T>
+  typename std::enable_if<(std::is_base_of<Integer, T>::value ||
+                              std::is_base_of<FloatingPoint, T>::value) &&
+                              !std::is_same<HalfFloatType, T>::value,
+      Status>::type
+  Visit(const T& type) {
+    Reducer<T> reducer;
+    std::shared_ptr<DataType> value_type;
+    switch (values_.type_id()) {
+      case Type::RUN_END_ENCODED: {
+        const auto& array = static_cast<const RunEndEncodedArray&>(values_);
+        ReduceRuns(array, &reducer);
+        value_type = array.values()->type();
+      } break;
+      case Type::BIT_PACKED: {
+        const auto& array = static_cast<const BitPackedArray&>(values_);
+        ReduceBitPacked(array, &reducer);
+        value_type = array.value_type();
+      } break;
+      default:
+        ReduceFlat(static_cast<const NumericArray<T>&>(values_), &reducer);
+        value_type = values_.type();
+        break;
+    }
+    return reducer.Finish(pool_, function_, value_type, out_);
+  }
+
+  Status Visit(const DataType& type) {
+    std::stringstream ss;
+    ss << "Reduce is not implemented for type " << values_.type()->ToString();
+    return Status::NotImplemented(ss.str());
+  }
+
+ private:
+  // Every run is visited once, whatever its length
+  template <typename T>
+  void ReduceRuns(const RunEndEncodedArray& array, Reducer<T>* reducer) {
+    const auto& values = static_cast<const NumericArray<T>&>(*array.values());
+    const int32_t* run_ends = array.raw_run_ends();
+    const int64_t end = array.offset() + array.length();
+    int64_t run_start = array.offset();
+    for (int64_t j = array.physical_offset(); run_start < end; ++j) {
+      const int64_t run_end = std::min<int64_t>(run_ends[j], end);
+      if (!values.IsNull(j)) { reducer->Update(values.Value(j), run_end - run_start); }
+      run_start = run_end;
+    }
+  }
+
+  template <typename T>
+  void ReduceBitPacked(const BitPackedArray& array, Reducer<T>* reducer) {
+    static constexpr int64_t kBlockSize = 1024;
+    typename T::c_type block[kBlockSize];
+    for (int64_t start = 0; start < array.length(); start += kBlockSize) {
+      const int64_t length = std::min(kBlockSize, array.length() - start);
+      UnpackValues(array, start, length, block);
+      for (int64_t k = 0; k < length; ++k) {
+        if (!array.IsNull(start + k)) { reducer->Update(block[k], 1); }
+      }
+    }
+  }
+
+  template <typename T>
+  void ReduceFlat(const NumericArray<T>& array, Reducer<T>* reducer) {
+    for (int64_t i = 0; i < array.length(); ++i) {
+      if (!array.IsNull(i)) { reducer->Update(array.Value(i), 1); }
+    }
+  }
+
+  MemoryPool* pool_;
+  const Array& values_;
+  AggregateFunction::type function_;
+  std::shared_ptr<Array>* out_;
+};
+
+// Byte width of the values of the arrays EncodeIntegerArray accepts, or 0
+int EncodedIntegerWidth(const DataType& type) {
+  switch (type.id()) {
+    case Type::INT32:
+    case Type::UINT32:
+    case Type::DATE32:
+    case Type::TIME32:
+      return 4;
+    case Type::INT64:
+    case Type::UINT64:
+    case Type::DATE64:
+    case Type::TIME64:
+    case Type::TIMESTAMP:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+template <typename T>
+Status EncodeIntegerValues(MemoryPool* pool, const Array& values,
+    IntegerEncoding encoding, std::shared_ptr<Buffer>* out) {
+  const auto& array = static_cast<const PrimitiveArray&>(values);
+  const T* raw_values = reinterpret_cast<const T*>(array.raw_values()) + array.offset();
+  if (array.null_count() == 0) {
+    return EncodeIntegers(pool, encoding, raw_values, array.length(), out);
+  }
+  // Leading nulls take the first valid value
+  std::vector<T> filled(raw_values, raw_values + array.length());
+  T previous = 0;
+  for (int64_t i = 0; i < array.length(); ++i) {
+    if (!array.IsNull(i)) {
+      previous = filled[i];
+      break;
+    }
+  }
+  for (int64_t i = 0; i < array.length(); ++i) {
+    if (array.IsNull(i)) {
+      filled[i] = previous;
+    } else {
+      previous = filled[i];
+    }
+  }
+  return EncodeIntegers(pool, encoding, filled.data(), array.length(), out);
+}
+
+}  // namespace
+
+Status RunEndEncode(MemoryPool* pool, const Array& values, std::shared_ptr<Array>* out) {
+  if (values.length() > std::numeric_limits<int32_t>::max()) {
+    return Status::Invalid("Run-end encoded arrays are limited to 2^31 - 1 slots");
+  }
+  std::vector<int32_t> ends;
+  std::vector<int64_t> starts;
+  RETURN_NOT_OK(FindValueRuns(values, &ends, &starts));
+
+  std::shared_ptr<Array> run_values;
+  RETURN_NOT_OK(Take(pool, values, starts.data(), static_cast<int64_t>(starts.size()),
+      &run_values));
+
+  std::shared_ptr<MutableBuffer> ends_buffer;
+  const int64_t num_runs = static_cast<int64_t>(ends.size());
+  RETURN_NOT_OK(AllocateBuffer(pool, num_runs * sizeof(int32_t), &ends_buffer));
+  if (num_runs > 0) {
+    memcpy(ends_buffer->mutable_data(), ends.data(), num_runs * sizeof(int32_t));
+  }
+  auto run_ends = std::make_shared<Int32Array>(num_runs, ends_buffer);
+
+  *out = std::make_shared<RunEndEncodedArray>(
+      run_end_encoded(values.type()), values.length(), run_ends, run_values);
+  return Status::OK();
+}
+
+Status BitPack(MemoryPool* pool, const Array& values, int bit_width,
+    std::shared_ptr<Array>* out) {
+  if (bit_width < 0) { return Status::Invalid("Bit width must not be negative"); }
+  BitPacker packer(pool, values, bit_width, out);
+  return VisitTypeInline(*values.type(), &packer);
+}
+
+Status Decode(MemoryPool* pool, const Array& values, std::shared_ptr<Array>* out) {
+  switch (values.type_id()) {
+    case Type::RUN_END_ENCODED:
+      return DecodeRuns(pool, static_cast<const RunEndEncodedArray&>(values), out);
+    case Type::BIT_PACKED: {
+      const auto& array = static_cast<const BitPackedArray&>(values);
+      BitPackedDecoder decoder(pool, array, out);
+      return VisitTypeInline(*array.value_type(), &decoder);
+    }
+    default:
+      return internal::MakeArray(values.data(), out);
+  }
+}
+
+Status EncodeIntegerArray(MemoryPool* pool, const Array& values,
+    IntegerEncoding encoding, std::shared_ptr<Buffer>* out) {
+  switch (EncodedIntegerWidth(*values.type())) {
+    case 4:
+      return EncodeIntegerValues<int32_t>(pool, values, encoding, out);
+    case 8:
+      return EncodeIntegerValues<int64_t>(pool, values, encoding, out);
+    default:
+      return Status::Invalid(
+          "Integer encodings support 32 and 64-bit integers, not " +
+          values.type()->ToString());
+  }
+}
+
+Status DecodeIntegerArray(MemoryPool* pool, const std::shared_ptr<DataType>& type,
+    const Buffer& encoded, const std::shared_ptr<Buffer>& null_bitmap,
+    int64_t null_count, std::shared_ptr<Array>* out) {
+  IntegerEncoding encoding;
+  int byte_width;
+  int64_t length;
+  RETURN_NOT_OK(ReadIntegerEncodingHeader(
+      encoded.data(), encoded.size(), &encoding, &byte_width, &length));
+  if (byte_width != EncodedIntegerWidth(*type)) {
+    return Status::Invalid("Encoded integers do not match type " + type->ToString());
+  }
+  if (null_bitmap != nullptr && null_bitmap->size() < BitUtil::BytesForBits(length)) {
+    return Status::Invalid("Validity bitmap too short for the encoded values");
+  }
+
+  std::shared_ptr<MutableBuffer> values;
+  RETURN_NOT_OK(AllocateBuffer(pool, length * byte_width, &values));
+  if (byte_width == 4) {
+    RETURN_NOT_OK(DecodeIntegers(encoded.data(), encoded.size(),
+        reinterpret_cast<int32_t*>(values->mutable_data())));
+  } else {
+    RETURN_NOT_OK(DecodeIntegers(encoded.data(), encoded.size(),
+        reinterpret_cast<int64_t*>(values->mutable_data())));
+  }
+  auto result = std::make_shared<internal::ArrayData>(type, length,
+      std::vector<std::shared_ptr<Buffer>>{null_bitmap, values},
+      null_bitmap == nullptr ? 0 : null_count);
+  return internal::MakeArray(result, out);
+}
+
+Status Reduce(MemoryPool* pool, const Array& values, AggregateFunction::type function,
+    std::shared_ptr<Array>* out) {
+  std::shared_ptr<DataType> value_type = values.type();
+  if (values.type_id() == Type::RUN_END_ENCODED) {
+    value_type = static_cast<const RunEndEncodedType&>(*value_type).value_type();
+  } else if (values.type_id() == Type::BIT_PACKED) {
+    value_type = static_cast<const BitPackedType&>(*value_type).value_type();
+  }
+  ReduceVisitor visitor(pool, values, function, out);
+  return VisitTypeInline(*value_type, &visitor);
+}
+
+}  // namespace compute
+}  // namespace arrow
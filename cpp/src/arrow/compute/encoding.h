@@ -0,0 +1,117 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+// Run-end encoding and bit-packing of arrays, and aggregation of the encoded
+// data without decoding it first
+
+#ifndef ARROW_COMPUTE_ENCODING_H
+#define ARROW_COMPUTE_ENCODING_H
+
+#include <memory>
+
+#include "arrow/compute/group-by.h"
+#include "arrow/util/int-encoding.h"
+#include "arrow/util/visibility.h"
+
+namespace arrow {
+
+class Array;
+class Buffer;
+class DataType;
+class MemoryPool;
+class Status;
+
+namespace compute {
+
+/// \brief Encode an array as runs of equal consecutive values
+///
+/// Consecutive nulls form a single null run. Boolean, fixed-width (including
+/// dictionary-encoded) and variable-length binary / string arrays are
+/// supported, and the length must fit in int32.
+///
+/// \param[in] pool memory pool to allocate the result from
+/// \param[in] values the array to encode
+/// \param[out] out a RunEndEncodedArray of the same length
+/// \return Status
+Status ARROW_EXPORT RunEndEncode(
+    MemoryPool* pool, const Array& values, std::shared_ptr<Array>* out);
+
+/// \brief Pack an integer array into a fixed number of bits per value
+///
+/// Null slots are packed as zero.
+///
+/// \param[in] pool memory pool to allocate the result from
+/// \param[in] values the array to pack
+/// \param[in] bit_width bits per value, or 0 for the fewest bits holding every
+/// non-null value. Returns Invalid if a value does not fit
+/// \param[out] out a BitPackedArray of the same length
+/// \return Status
+Status ARROW_EXPORT BitPack(MemoryPool* pool, const Array& values, int bit_width,
+    std::shared_ptr<Array>* out);
+
+/// \brief Expand a run-end encoded or bit-packed array to a flat array of its
+/// value type. Any other array is returned unchanged
+Status ARROW_EXPORT Decode(
+    MemoryPool* pool, const Array& values, std::shared_ptr<Array>* out);
+
+/// \brief Encode the values of an array of 32 or 64-bit integers
+///
+/// Int32, UInt32, Date32, Time32, Int64, UInt64, Date64, Time64 and Timestamp
+/// arrays are supported. The validity bitmap is not part of the result, and
+/// null slots repeat the preceding value so that they do not widen deltas.
+///
+/// \param[in] pool memory pool to allocate the result from
+/// \param[in] values the array to encode
+/// \param[in] encoding the encoding to use
+/// \param[out] out a self-describing buffer, see IntegerEncoding
+/// \return Status
+Status ARROW_EXPORT EncodeIntegerArray(MemoryPool* pool, const Array& values,
+    IntegerEncoding encoding, std::shared_ptr<Buffer>* out);
+
+/// \brief Decode a buffer written by EncodeIntegerArray into an array
+///
+/// \param[in] pool memory pool to allocate the values from
+/// \param[in] type the type of the array, of the width of the encoded values
+/// \param[in] encoded the encoded values
+/// \param[in] null_bitmap the validity bitmap of the array, may be null
+/// \param[in] null_count the number of nulls in the array
+/// \param[out] out the decoded array
+/// \return Status, Invalid if the buffer is truncated or malformed
+Status ARROW_EXPORT DecodeIntegerArray(MemoryPool* pool,
+    const std::shared_ptr<DataType>& type, const Buffer& encoded,
+    const std::shared_ptr<Buffer>& null_bitmap, int64_t null_count,
+    std::shared_ptr<Array>* out);
+
+/// \brief Aggregate a numeric array to a single value
+///
+/// Result types and null handling are those of the group-by aggregates: the
+/// result is null if there is no non-null value, except for COUNT. Run-end
+/// encoded arrays are aggregated a run at a time without being decoded, each
+/// run weighted by the number of its slots in the array. Bit-packed arrays
+/// are decoded in small blocks.
+///
+/// \param[in] pool memory pool to allocate the result from
+/// \param[in] values a numeric array, or an encoded array of numeric values
+/// \param[in] function the aggregate to compute
+/// \param[out] out an array of length 1
+/// \return Status
+Status ARROW_EXPORT Reduce(MemoryPool* pool, const Array& values,
+    AggregateFunction::type function, std::shared_ptr<Array>* out);
+
+}  // namespace compute
+}  // namespace arrow
+
+#endif  // ARROW_COMPUTE_ENCODING_H
@@ -0,0 +1,388 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/compute/group-by.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/table.h"
+#include "arrow/test-util.h"
+#include "arrow/type.h"
+#include "arrow/util/bit-util.h"
+
+namespace arrow {
+namespace compute {
+
+static std::shared_ptr<Schema> MakeSchema(
+    const std::vector<std::shared_ptr<Field>>& fields) {
+  return std::make_shared<Schema>(fields);
+}
+
+// Concatenate the chunks of one numeric result column
+template <typename ArrowType>
+static void ColumnValues(const Table& table, int i,
+    std::vector<typename ArrowType::c_type>* values, std::vector<bool>* is_valid) {
+  const auto& chunks = *table.column(i)->data();
+  for (int j = 0; j < chunks.num_chunks(); ++j) {
+    const auto& chunk = static_cast<const NumericArray<ArrowType>&>(*chunks.chunk(j));
+    for (int64_t k = 0; k < chunk.length(); ++k) {
+      values->push_back(chunk.Value(k));
+      is_valid->push_back(!chunk.IsNull(k));
+    }
+  }
+}
+
+static void StringColumnValues(
+    const Table& table, int i, std::vector<std::string>* values) {
+  const auto& chunks = *table.column(i)->data();
+  for (int j = 0; j < chunks.num_chunks(); ++j) {
+    const auto& chunk = static_cast<const StringArray&>(*chunks.chunk(j));
+    for (int64_t k = 0; k < chunk.length(); ++k) {
+      values->push_back(chunk.IsNull(k) ? "<null>" : chunk.GetString(k));
+    }
+  }
+}
+
+class TestGroupBy : public ::testing::Test {
+ public:
+  void SetUp() { pool_ = default_memory_pool(); }
+
+  void MakeAggregator(const std::shared_ptr<Schema>& schema,
+      const std::vector<std::string>& keys, const std::vector<Aggregate>& aggregates,
+      const GroupByOptions& options = GroupByOptions()) {
+    ASSERT_OK(
+        GroupByAggregator::Make(schema, keys, aggregates, options, pool_, &aggregator_));
+  }
+
+ protected:
+  MemoryPool* pool_;
+  std::unique_ptr<GroupByAggregator> aggregator_;
+};
+
+TEST_F(TestGroupBy, IntegerKeys) {
+  auto schema = MakeSchema({field("k", int32()), field("v", int32())});
+  MakeAggregator(schema, {"k"},
+      {Aggregate(AggregateFunction::COUNT, "v"), Aggregate(AggregateFunction::SUM, "v"),
+          Aggregate(AggregateFunction::MIN, "v"), Aggregate(AggregateFunction::MAX, "v"),
+          Aggregate(AggregateFunction::MEAN, "v", "avg")});
+
+  std::shared_ptr<Array> keys, values;
+  ArrayFromVector<Int32Type, int32_t>(
+      {true, true, true, false, true, true}, {2, 1, 2, 0, 1, 3}, &keys);
+  ArrayFromVector<Int32Type, int32_t>(
+      {true, true, true, true, false, false}, {5, -1, 7, 4, 0, 0}, &values);
+  RecordBatch batch(schema, 6, {keys, values});
+  ASSERT_OK(aggregator_->Consume(batch));
+  ASSERT_OK(aggregator_->Consume(*batch.Slice(4)));
+  ASSERT_EQ(4, aggregator_->num_groups());
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK(aggregator_->Finish(&result));
+
+  auto expected_schema = MakeSchema({field("k", int32()), field("count(v)", int64()),
+      field("sum(v)", int64()), field("min(v)", int32()), field("max(v)", int32()),
+      field("avg", float64())});
+  ASSERT_TRUE(result->schema()->Equals(*expected_schema));
+
+  // Groups are emitted in order of first appearance
+  std::shared_ptr<Array> ex_keys, ex_count, ex_sum, ex_min, ex_max, ex_mean;
+  ArrayFromVector<Int32Type, int32_t>({true, true, false, true}, {2, 1, 0, 3}, &ex_keys);
+  ArrayFromVector<Int64Type, int64_t>({2, 1, 1, 0}, &ex_count);
+  ArrayFromVector<Int64Type, int64_t>({true, true, true, false}, {12, -1, 4, 0}, &ex_sum);
+  ArrayFromVector<Int32Type, int32_t>({true, true, true, false}, {5, -1, 4, 0}, &ex_min);
+  ArrayFromVector<Int32Type, int32_t>({true, true, true, false}, {7, -1, 4, 0}, &ex_max);
+  ArrayFromVector<DoubleType, double>(
+      {true, true, true, false}, {6.0, -1.0, 4.0, 0}, &ex_mean);
+  RecordBatch expected_batch(
+      expected_schema, 4, {ex_keys, ex_count, ex_sum, ex_min, ex_max, ex_mean});
+  std::shared_ptr<Table> expected;
+  ASSERT_OK(Table::FromRecordBatches({std::make_shared<RecordBatch>(expected_batch)},
+      &expected));
+  ASSERT_TRUE(result->Equals(*expected));
+}
+
+TEST_F(TestGroupBy, MultipleStringAndIntegerKeys) {
+  auto schema = MakeSchema(
+      {field("s", utf8()), field("k", int64()), field("v", float64())});
+  MakeAggregator(schema, {"s", "k"}, {Aggregate(AggregateFunction::SUM, "v")});
+
+  std::shared_ptr<Array> strings, keys, values;
+  ArrayFromVector<StringType, std::string>({true, true, true, false, true},
+      {"a", "bb", "a", "", "bb"}, &strings);
+  ArrayFromVector<Int64Type, int64_t>({1, 1, 1, 1, 2}, &keys);
+  ArrayFromVector<DoubleType, double>({0.5, 1.0, 1.5, 2.0, 2.5}, &values);
+  ASSERT_OK(aggregator_->Consume(RecordBatch(schema, 5, {strings, keys, values})));
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK(aggregator_->Finish(&result));
+  ASSERT_EQ(4, result->num_rows());
+
+  std::vector<std::string> result_strings;
+  StringColumnValues(*result, 0, &result_strings);
+  std::vector<int64_t> result_keys;
+  std::vector<double> result_sums;
+  std::vector<bool> is_valid;
+  ColumnValues<Int64Type>(*result, 1, &result_keys, &is_valid);
+  ColumnValues<DoubleType>(*result, 2, &result_sums, &is_valid);
+
+  ASSERT_EQ(std::vector<std::string>({"a", "bb", "<null>", "bb"}), result_strings);
+  ASSERT_EQ(std::vector<int64_t>({1, 1, 1, 2}), result_keys);
+  ASSERT_EQ(std::vector<double>({2.0, 1.0, 2.0, 2.5}), result_sums);
+}
+
+TEST_F(TestGroupBy, DictionaryKeys) {
+  std::shared_ptr<Array> dict1, dict2, indices1, indices2, values;
+  ArrayFromVector<StringType, std::string>({"x", "y", "z"}, &dict1);
+  ArrayFromVector<StringType, std::string>({"z", "x"}, &dict2);
+  ArrayFromVector<Int8Type, int8_t>({true, true, false, true}, {0, 2, 0, 0}, &indices1);
+  ArrayFromVector<Int8Type, int8_t>({0, 1, 1, 0}, &indices2);
+  ArrayFromVector<Int64Type, int64_t>({1, 2, 3, 4}, &values);
+
+  auto type1 = dictionary(int8(), dict1);
+  auto type2 = dictionary(int8(), dict2);
+  auto schema1 = MakeSchema({field("d", type1), field("v", int64())});
+  auto schema2 = MakeSchema({field("d", type2), field("v", int64())});
+  auto keys1 = std::make_shared<DictionaryArray>(type1, indices1);
+  auto keys2 = std::make_shared<DictionaryArray>(type2, indices2);
+
+  MakeAggregator(schema1, {"d"}, {Aggregate(AggregateFunction::SUM, "v")});
+  ASSERT_OK(aggregator_->Consume(RecordBatch(schema1, 4, {keys1, values})));
+  ASSERT_OK(aggregator_->Consume(RecordBatch(schema2, 4, {keys2, values})));
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK(aggregator_->Finish(&result));
+  ASSERT_TRUE(result->schema()->field(0)->type()->Equals(utf8()));
+
+  std::vector<std::string> result_keys;
+  StringColumnValues(*result, 0, &result_keys);
+  std::vector<int64_t> result_sums;
+  std::vector<bool> is_valid;
+  ColumnValues<Int64Type>(*result, 1, &result_sums, &is_valid);
+  ASSERT_EQ(std::vector<std::string>({"x", "z", "<null>"}), result_keys);
+  ASSERT_EQ(std::vector<int64_t>({1 + 4 + 2 + 3, 2 + 1 + 4, 3}), result_sums);
+}
+
+TEST_F(TestGroupBy, FloatingPointKeys) {
+  // -0.0 groups with 0.0, and NaNs with each other whatever their bits
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  double other_nan;
+  const uint64_t other_nan_bits = 0xfff8000000000123ULL;
+  memcpy(&other_nan, &other_nan_bits, sizeof(double));
+
+  auto schema = MakeSchema({field("k", float64()), field("v", int64())});
+  MakeAggregator(schema, {"k"}, {Aggregate(AggregateFunction::SUM, "v")});
+  std::shared_ptr<Array> keys, values;
+  ArrayFromVector<DoubleType, double>({true, true, true, true, true, false},
+      {-0.0, 1.5, nan, 0.0, other_nan, 0.0}, &keys);
+  ArrayFromVector<Int64Type, int64_t>({1, 2, 3, 4, 5, 6}, &values);
+  ASSERT_OK(aggregator_->Consume(RecordBatch(schema, 6, {keys, values})));
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK(aggregator_->Finish(&result));
+  std::vector<double> result_keys;
+  std::vector<int64_t> result_sums;
+  std::vector<bool> keys_valid, sums_valid;
+  ColumnValues<DoubleType>(*result, 0, &result_keys, &keys_valid);
+  ColumnValues<Int64Type>(*result, 1, &result_sums, &sums_valid);
+  ASSERT_EQ(4, static_cast<int>(result_keys.size()));
+  ASSERT_EQ(0.0, result_keys[0]);
+  ASSERT_FALSE(std::signbit(result_keys[0]));
+  ASSERT_EQ(1.5, result_keys[1]);
+  ASSERT_TRUE(std::isnan(result_keys[2]));
+  ASSERT_EQ(std::vector<bool>({true, true, true, false}), keys_valid);
+  ASSERT_EQ(std::vector<int64_t>({1 + 4, 2, 3 + 5, 6}), result_sums);
+}
+
+TEST_F(TestGroupBy, AllNullKeysWithoutValues) {
+  auto schema = MakeSchema({field("k", int32()), field("v", int64())});
+  MakeAggregator(schema, {"k"}, {Aggregate(AggregateFunction::SUM, "v")});
+
+  std::shared_ptr<MutableBuffer> null_bitmap;
+  ASSERT_OK(GetEmptyBitmap(pool_, 3, &null_bitmap));
+  auto keys = std::make_shared<Int32Array>(3, nullptr, null_bitmap, 3);
+  std::shared_ptr<Array> values;
+  ArrayFromVector<Int64Type, int64_t>({1, 2, 3}, &values);
+  ASSERT_OK(aggregator_->Consume(RecordBatch(schema, 3, {keys, values})));
+  ASSERT_EQ(1, aggregator_->num_groups());
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK(aggregator_->Finish(&result));
+  std::vector<int64_t> result_sums;
+  std::vector<bool> is_valid;
+  ColumnValues<Int64Type>(*result, 1, &result_sums, &is_valid);
+  ASSERT_EQ(std::vector<int64_t>({6}), result_sums);
+}
+
+TEST_F(TestGroupBy, SumWrapsAround) {
+  auto schema = MakeSchema({field("k", int32()), field("v", int64())});
+  MakeAggregator(schema, {"k"}, {Aggregate(AggregateFunction::SUM, "v")});
+
+  const int64_t max = std::numeric_limits<int64_t>::max();
+  const int64_t min = std::numeric_limits<int64_t>::min();
+  std::shared_ptr<Array> keys, values;
+  ArrayFromVector<Int32Type, int32_t>({0, 0, 1, 1, 2, 2}, &keys);
+  ArrayFromVector<Int64Type, int64_t>({max, 1, min, -1, max - 1, 1}, &values);
+  ASSERT_OK(aggregator_->Consume(RecordBatch(schema, 6, {keys, values})));
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK(aggregator_->Finish(&result));
+  std::vector<int64_t> result_sums;
+  std::vector<bool> is_valid;
+  ColumnValues<Int64Type>(*result, 1, &result_sums, &is_valid);
+  ASSERT_EQ(std::vector<int64_t>({min, max, max}), result_sums);
+}
+
+TEST_F(TestGroupBy, Errors) {
+  auto schema = MakeSchema({field("k", int32()), field("s", utf8())});
+  std::unique_ptr<GroupByAggregator> aggregator;
+  GroupByOptions options;
+
+  ASSERT_RAISES(Invalid, GroupByAggregator::Make(schema, {"missing"}, {}, options, pool_,
+                             &aggregator));
+  ASSERT_RAISES(Invalid, GroupByAggregator::Make(schema, {}, {}, options, pool_,
+                             &aggregator));
+  ASSERT_RAISES(NotImplemented,
+      GroupByAggregator::Make(schema, {"k"}, {Aggregate(AggregateFunction::SUM, "s")},
+          options, pool_, &aggregator));
+
+  MakeAggregator(schema, {"k"}, {});
+  auto other_schema = MakeSchema({field("k", int64()), field("s", utf8())});
+  std::shared_ptr<Array> keys, strings;
+  ArrayFromVector<Int64Type, int64_t>({1}, &keys);
+  ArrayFromVector<StringType, std::string>({"a"}, &strings);
+  ASSERT_RAISES(
+      Invalid, aggregator_->Consume(RecordBatch(other_schema, 1, {keys, strings})));
+}
+
+// Aggregate random batches with and without spilling and compare both against
+// a straightforward std::map computation
+class TestGroupBySpill : public TestGroupBy {
+ public:
+  struct Expected {
+    Expected() : count(0), sum(0), min(0), max(0) {}
+    int64_t count, sum;
+    int32_t min, max;
+  };
+
+  void SetUp() {
+    TestGroupBy::SetUp();
+    schema_ = MakeSchema({field("k", int64()), field("v", int32())});
+    aggregates_ = {Aggregate(AggregateFunction::COUNT, "v"),
+        Aggregate(AggregateFunction::SUM, "v"), Aggregate(AggregateFunction::MIN, "v"),
+        Aggregate(AggregateFunction::MAX, "v")};
+
+    const int64_t batch_size = 1000;
+    for (int b = 0; b < 20; ++b) {
+      std::vector<int64_t> keys(batch_size);
+      std::vector<int32_t> values(batch_size);
+      std::vector<uint8_t> valid_bytes(batch_size);
+      test::rand_uniform_int(batch_size, b, int64_t(0), int64_t(5000), keys.data());
+      test::rand_uniform_int(batch_size, b + 100, -1000, 1000, values.data());
+      test::random_null_bytes(batch_size, 0.1, valid_bytes.data());
+
+      std::vector<bool> is_valid;
+      for (int64_t i = 0; i < batch_size; ++i) {
+        is_valid.push_back(valid_bytes[i] != 0);
+        Expected& e = expected_[keys[i]];
+        if (!valid_bytes[i]) { continue; }
+        e.min = e.count == 0 ? values[i] : std::min(e.min, values[i]);
+        e.max = e.count == 0 ? values[i] : std::max(e.max, values[i]);
+        e.sum += values[i];
+        ++e.count;
+      }
+      std::shared_ptr<Array> key_array, value_array;
+      ArrayFromVector<Int64Type, int64_t>(keys, &key_array);
+      ArrayFromVector<Int32Type, int32_t>(is_valid, values, &value_array);
+      std::vector<std::shared_ptr<Array>> columns = {key_array, value_array};
+      batches_.push_back(std::make_shared<RecordBatch>(schema_, batch_size, columns));
+    }
+  }
+
+  void CheckResult(const Table& result) {
+    std::vector<int64_t> keys, counts, sums;
+    std::vector<int32_t> mins, maxs;
+    std::vector<bool> key_valid, count_valid, sum_valid, min_valid, max_valid;
+    ColumnValues<Int64Type>(result, 0, &keys, &key_valid);
+    ColumnValues<Int64Type>(result, 1, &counts, &count_valid);
+    ColumnValues<Int64Type>(result, 2, &sums, &sum_valid);
+    ColumnValues<Int32Type>(result, 3, &mins, &min_valid);
+    ColumnValues<Int32Type>(result, 4, &maxs, &max_valid);
+
+    ASSERT_EQ(expected_.size(), keys.size());
+    std::map<int64_t, bool> seen;
+    for (size_t i = 0; i < keys.size(); ++i) {
+      ASSERT_TRUE(seen.find(keys[i]) == seen.end()) << "duplicate group " << keys[i];
+      seen[keys[i]] = true;
+      const Expected& e = expected_[keys[i]];
+      ASSERT_EQ(e.count, counts[i]);
+      ASSERT_EQ(e.count > 0, sum_valid[i]);
+      if (e.count > 0) {
+        ASSERT_EQ(e.sum, sums[i]);
+        ASSERT_EQ(e.min, mins[i]);
+        ASSERT_EQ(e.max, maxs[i]);
+      }
+    }
+  }
+
+ protected:
+  std::shared_ptr<Schema> schema_;
+  std::vector<Aggregate> aggregates_;
+  std::vector<std::shared_ptr<RecordBatch>> batches_;
+  std::map<int64_t, Expected> expected_;
+};
+
+TEST_F(TestGroupBySpill, InMemory) {
+  MakeAggregator(schema_, {"k"}, aggregates_);
+  for (const auto& batch : batches_) {
+    ASSERT_OK(aggregator_->Consume(*batch));
+  }
+  std::shared_ptr<Table> result;
+  ASSERT_OK(aggregator_->Finish(&result));
+  ASSERT_EQ(0, aggregator_->num_spills());
+  CheckResult(*result);
+}
+
+TEST_F(TestGroupBySpill, SpillToDisk) {
+  GroupByOptions options;
+  options.memory_budget = 1 << 16;
+  options.num_spill_partitions = 4;
+  MakeAggregator(schema_, {"k"}, aggregates_, options);
+  for (const auto& batch : batches_) {
+    ASSERT_OK(aggregator_->Consume(*batch));
+  }
+  ASSERT_GT(aggregator_->num_spills(), 1);
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK(aggregator_->Finish(&result));
+  CheckResult(*result);
+}
+
+}  // namespace compute
+}  // namespace arrow
@@ -0,0 +1,842 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/compute/group-by.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/buffer.h"
+#include "arrow/compute/compute-internal.h"
+#include "arrow/compute/hash-table.h"
+#include "arrow/compute/take.h"
+#include "arrow/io/file.h"
+#include "arrow/ipc/reader.h"
+#include "arrow/ipc/writer.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/table.h"
+#include "arrow/type.h"
+#include "arrow/type_traits.h"
+
+namespace arrow {
+namespace compute {
+
+Aggregate::Aggregate(AggregateFunction::type function, const std::string& column_name,
+    const std::string& output_name)
+    : function(function), column_name(column_name), output_name(output_name) {}
+
+GroupByOptions::GroupByOptions()
+    : memory_budget(0), spill_directory("."), num_spill_partitions(16) {}
+
+static const char* AggregateFunctionName(AggregateFunction::type function) {
+  switch (function) {
+    case AggregateFunction::COUNT:
+      return "count";
+    case AggregateFunction::SUM:
+      return "sum";
+    case AggregateFunction::MIN:
+      return "min";
+    case AggregateFunction::MAX:
+      return "max";
+    case AggregateFunction::MEAN:
+      return "mean";
+  }
+  return "unknown";
+}
+
+// ----------------------------------------------------------------------
+// Aggregate states, one value per group
+//
+// Every aggregator can emit its state as one or more "partial" columns and
+// later fold such columns back in with Merge; spilling relies on this
+
+class GroupAggregator {
+ public:
+  virtual ~GroupAggregator() = default;
+
+  /// \brief Extend the state to cover num_groups groups
+  virtual Status Resize(int64_t num_groups) = 0;
+
+  /// \brief Update the state of the groups the rows of values belong to
+  virtual void Consume(const Array& values, const int32_t* group_ids) = 0;
+
+  /// \brief Fold partial columns produced by Finish(true, ...) into the state
+  virtual void Merge(const std::shared_ptr<Array>* partial, const int32_t* group_ids) = 0;
+
+  /// \brief Append the partial or final columns of every group to out and
+  /// clear the state
+  virtual Status Finish(bool partial, std::vector<std::shared_ptr<Array>>* out) = 0;
+
+  /// \brief The fields of the partial columns
+  virtual std::vector<std::shared_ptr<Field>> partial_fields(
+      const std::string& name) const = 0;
+
+  virtual std::shared_ptr<DataType> out_type() const = 0;
+
+  virtual int64_t memory_usage() const = 0;
+};
+
+// Calls visit(group, value) for every non-null value
+template <typename ArrowType, typename Visitor>
+static void VisitValues(const Array& array, const int32_t* group_ids, Visitor&& visit) {
+  const auto& typed = static_cast<const NumericArray<ArrowType>&>(array);
+  const auto* values = typed.raw_values();
+  const int64_t length = typed.length();
+  if (typed.null_count() == 0) {
+    for (int64_t i = 0; i < length; ++i) {
+      visit(group_ids[i], values[i]);
+    }
+  } else {
+    for (int64_t i = 0; i < length; ++i) {
+      if (!typed.IsNull(i)) { visit(group_ids[i], values[i]); }
+    }
+  }
+}
+
+template <typename ArrowType>
+static Status MakeNumericArray(MemoryPool* pool, const std::shared_ptr<DataType>& type,
+    StateVector<typename ArrowType::c_type>* values, StateVector<uint8_t>* valid,
+    std::shared_ptr<Array>* out) {
+  const int64_t length = values->size();
+  std::vector<std::shared_ptr<Buffer>> buffers(1);
+  int64_t null_count = 0;
+  if (valid != nullptr) {
+    RETURN_NOT_OK(BytesToBitmap(pool, valid->data(), length, &buffers[0], &null_count));
+    valid->Reset();
+  }
+  buffers.push_back(values->Finish());
+  auto result =
+      std::make_shared<internal::ArrayData>(type, length, std::move(buffers), null_count);
+  return internal::MakeArray(result, out);
+}
+
+class CountAggregator : public GroupAggregator {
+ public:
+  explicit CountAggregator(MemoryPool* pool) : pool_(pool), counts_(pool) {}
+
+  Status Resize(int64_t num_groups) override { return counts_.Resize(num_groups, 0); }
+
+  void Consume(const Array& values, const int32_t* group_ids) override {
+    int64_t* counts = counts_.data();
+    const int64_t length = values.length();
+    if (values.null_count() == 0) {
+      for (int64_t i = 0; i < length; ++i) {
+        ++counts[group_ids[i]];
+      }
+    } else {
+      for (int64_t i = 0; i < length; ++i) {
+        counts[group_ids[i]] += !values.IsNull(i);
+      }
+    }
+  }
+
+  void Merge(const std::shared_ptr<Array>* partial, const int32_t* group_ids) override {
+    int64_t* counts = counts_.data();
+    VisitValues<Int64Type>(*partial[0], group_ids,
+        [counts](int32_t group, int64_t count) { counts[group] += count; });
+  }
+
+  Status Finish(bool partial, std::vector<std::shared_ptr<Array>>* out) override {
+    std::shared_ptr<Array> result;
+    RETURN_NOT_OK(
+        MakeNumericArray<Int64Type>(pool_, int64(), &counts_, nullptr, &result));
+    out->push_back(result);
+    return Status::OK();
+  }
+
+  std::vector<std::shared_ptr<Field>> partial_fields(
+      const std::string& name) const override {
+    return {field(name, int64(), false)};
+  }
+
+  std::shared_ptr<DataType> out_type() const override { return int64(); }
+
+  int64_t memory_usage() const override { return counts_.memory_usage(); }
+
+ private:
+  MemoryPool* pool_;
+  StateVector<int64_t> counts_;
+};
+
+// Integer sums wrap around on overflow, which signed addition would leave
+// undefined
+template <typename T>
+static inline typename std::enable_if<std::is_integral<T>::value, T>::type AddToSum(
+    T sum, T value) {
+  using unsigned_type = typename std::make_unsigned<T>::type;
+  return static_cast<T>(
+      static_cast<unsigned_type>(sum) + static_cast<unsigned_type>(value));
+}
+
+template <typename T>
+static inline typename std::enable_if<std::is_floating_point<T>::value, T>::type
+AddToSum(T sum, T value) {
+  return sum + value;
+}
+
+template <typename ArrowType>
+class SumAggregator : public GroupAggregator {
+ public:
+  using SumType = typename SumTraits<ArrowType>::type;
+  using sum_type = typename SumType::c_type;
+
+  explicit SumAggregator(MemoryPool* pool) : pool_(pool), sums_(pool), valid_(pool) {}
+
+  Status Resize(int64_t num_groups) override {
+    RETURN_NOT_OK(sums_.Resize(num_groups, 0));
+    return valid_.Resize(num_groups, 0);
+  }
+
+  void Consume(const Array& values, const int32_t* group_ids) override {
+    sum_type* sums = sums_.data();
+    uint8_t* valid = valid_.data();
+    VisitValues<ArrowType>(values, group_ids,
+        [sums, valid](int32_t group, typename ArrowType::c_type value) {
+          sums[group] = AddToSum(sums[group], static_cast<sum_type>(value));
+          valid[group] = 1;
+        });
+  }
+
+  void Merge(const std::shared_ptr<Array>* partial, const int32_t* group_ids) override {
+    sum_type* sums = sums_.data();
+    uint8_t* valid = valid_.data();
+    VisitValues<SumType>(
+        *partial[0], group_ids, [sums, valid](int32_t group, sum_type value) {
+          sums[group] = AddToSum(sums[group], value);
+          valid[group] = 1;
+        });
+  }
+
+  Status Finish(bool partial, std::vector<std::shared_ptr<Array>>* out) override {
+    std::shared_ptr<Array> result;
+    RETURN_NOT_OK(MakeNumericArray<SumType>(
+        pool_, TypeTraits<SumType>::type_singleton(), &sums_, &valid_, &result));
+    out->push_back(result);
+    return Status::OK();
+  }
+
+  std::vector<std::shared_ptr<Field>> partial_fields(
+      const std::string& name) const override {
+    return {field(name, out_type())};
+  }
+
+  std::shared_ptr<DataType> out_type() const override {
+    return TypeTraits<SumType>::type_singleton();
+  }
+
+  int64_t memory_usage() const override {
+    return sums_.memory_usage() + valid_.memory_usage();
+  }
+
+ private:
+  MemoryPool* pool_;
+  StateVector<sum_type> sums_;
+  StateVector<uint8_t> valid_;
+};
+
+template <typename ArrowType, bool kIsMin>
+class MinMaxAggregator : public GroupAggregator {
+ public:
+  using c_type = typename ArrowType::c_type;
+
+  MinMaxAggregator(const std::shared_ptr<DataType>& type, MemoryPool* pool)
+      : type_(type), pool_(pool), values_(pool), valid_(pool) {}
+
+  Status Resize(int64_t num_groups) override {
+    RETURN_NOT_OK(values_.Resize(num_groups, 0));
+    return valid_.Resize(num_groups, 0);
+  }
+
+  void Consume(const Array& values, const int32_t* group_ids) override {
+    c_type* state = values_.data();
+    uint8_t* valid = valid_.data();
+    VisitValues<ArrowType>(
+        values, group_ids, [state, valid](int32_t group, c_type value) {
+          if (!valid[group] || (kIsMin ? value < state[group] : state[group] < value)) {
+            state[group] = value;
+            valid[group] = 1;
+          }
+        });
+  }
+
+  void Merge(const std::shared_ptr<Array>* partial, const int32_t* group_ids) override {
+    Consume(*partial[0], group_ids);
+  }
+
+  Status Finish(bool partial, std::vector<std::shared_ptr<Array>>* out) override {
+    std::shared_ptr<Array> result;
+    RETURN_NOT_OK(MakeNumericArray<ArrowType>(pool_, type_, &values_, &valid_, &result));
+    out->push_back(result);
+    return Status::OK();
+  }
+
+  std::vector<std::shared_ptr<Field>> partial_fields(
+      const std::string& name) const override {
+    return {field(name, type_)};
+  }
+
+  std::shared_ptr<DataType> out_type() const override { return type_; }
+
+  int64_t memory_usage() const override {
+    return values_.memory_usage() + valid_.memory_usage();
+  }
+
+ private:
+  std::shared_ptr<DataType> type_;
+  MemoryPool* pool_;
+  StateVector<c_type> values_;
+  StateVector<uint8_t> valid_;
+};
+
+// Partial state is the sum as double and the non-null count
+template <typename ArrowType>
+class MeanAggregator : public GroupAggregator {
+ public:
+  explicit MeanAggregator(MemoryPool* pool) : pool_(pool), sums_(pool), counts_(pool) {}
+
+  Status Resize(int64_t num_groups) override {
+    RETURN_NOT_OK(sums_.Resize(num_groups, 0));
+    return counts_.Resize(num_groups, 0);
+  }
+
+  void Consume(const Array& values, const int32_t* group_ids) override {
+    double* sums = sums_.data();
+    int64_t* counts = counts_.data();
+    VisitValues<ArrowType>(values, group_ids,
+        [sums, counts](int32_t group, typename ArrowType::c_type value) {
+          sums[group] += static_cast<double>(value);
+          ++counts[group];
+        });
+  }
+
+  void Merge(const std::shared_ptr<Array>* partial, const int32_t* group_ids) override {
+    double* sums = sums_.data();
+    int64_t* counts = counts_.data();
+    VisitValues<DoubleType>(*partial[0], group_ids,
+        [sums](int32_t group, double value) { sums[group] += value; });
+    VisitValues<Int64Type>(*partial[1], group_ids,
+        [counts](int32_t group, int64_t count) { counts[group] += count; });
+  }
+
+  Status Finish(bool partial, std::vector<std::shared_ptr<Array>>* out) override {
+    std::shared_ptr<Array> result;
+    if (partial) {
+      RETURN_NOT_OK(
+          MakeNumericArray<DoubleType>(pool_, float64(), &sums_, nullptr, &result));
+      out->push_back(result);
+      RETURN_NOT_OK(
+          MakeNumericArray<Int64Type>(pool_, int64(), &counts_, nullptr, &result));
+      out->push_back(result);
+      return Status::OK();
+    }
+
+    const int64_t length = sums_.size();
+    StateVector<uint8_t> valid(pool_);
+    RETURN_NOT_OK(valid.Resize(length, 0));
+    double* sums = sums_.data();
+    const int64_t* counts = counts_.data();
+    for (int64_t i = 0; i < length; ++i) {
+      if (counts[i] > 0) {
+        sums[i] /= static_cast<double>(counts[i]);
+        valid.data()[i] = 1;
+      }
+    }
+    counts_.Reset();
+    RETURN_NOT_OK(
+        MakeNumericArray<DoubleType>(pool_, float64(), &sums_, &valid, &result));
+    out->push_back(result);
+    return Status::OK();
+  }
+
+  std::vector<std::shared_ptr<Field>> partial_fields(
+      const std::string& name) const override {
+    return {field(name + ".sum", float64(), false),
+        field(name + ".count", int64(), false)};
+  }
+
+  std::shared_ptr<DataType> out_type() const override { return float64(); }
+
+  int64_t memory_usage() const override {
+    return sums_.memory_usage() + counts_.memory_usage();
+  }
+
+ private:
+  MemoryPool* pool_;
+  StateVector<double> sums_;
+  StateVector<int64_t> counts_;
+};
+
+template <typename ArrowType>
+static Status MakeTypedAggregator(AggregateFunction::type function,
+    const std::shared_ptr<DataType>& type, MemoryPool* pool,
+    std::unique_ptr<GroupAggregator>* out) {
+  switch (function) {
+    case AggregateFunction::COUNT:
+      out->reset(new CountAggregator(pool));
+      break;
+    case AggregateFunction::SUM:
+      out->reset(new SumAggregator<ArrowType>(pool));
+      break;
+    case AggregateFunction::MIN:
+      out->reset(new MinMaxAggregator<ArrowType, true>(type, pool));
+      break;
+    case AggregateFunction::MAX:
+      out->reset(new MinMaxAggregator<ArrowType, false>(type, pool));
+      break;
+    case AggregateFunction::MEAN:
+      out->reset(new MeanAggregator<ArrowType>(pool));
+      break;
+  }
+  return Status::OK();
+}
+
+#define AGGREGATOR_CASE(TYPE_CLASS) \
+  case TYPE_CLASS::type_id:         \
+    return MakeTypedAggregator<TYPE_CLASS>(function, type, pool, out);
+
+static Status MakeAggregator(AggregateFunction::type function,
+    const std::shared_ptr<DataType>& type, MemoryPool* pool,
+    std::unique_ptr<GroupAggregator>* out) {
+  switch (type->id()) {
+    AGGREGATOR_CASE(UInt8Type);
+    AGGREGATOR_CASE(Int8Type);
+    AGGREGATOR_CASE(UInt16Type);
+    AGGREGATOR_CASE(Int16Type);
+    AGGREGATOR_CASE(UInt32Type);
+    AGGREGATOR_CASE(Int32Type);
+    AGGREGATOR_CASE(UInt64Type);
+    AGGREGATOR_CASE(Int64Type);
+    AGGREGATOR_CASE(FloatType);
+    AGGREGATOR_CASE(DoubleType);
+    default:
+      break;
+  }
+  std::stringstream ss;
+  ss << "Cannot compute " << AggregateFunctionName(function) << " of "
+     << type->ToString() << " columns";
+  return Status::NotImplemented(ss.str());
+}
+
+#undef AGGREGATOR_CASE
+
+// ----------------------------------------------------------------------
+// GroupTable: the keys and aggregate states of the groups held in memory
+
+class GroupTable {
+ public:
+  explicit GroupTable(MemoryPool* pool) : pool_(pool) {}
+
+  Status Init(const std::vector<std::shared_ptr<DataType>>& key_types) {
+    return KeyHashTable::Make(key_types, pool_, &keys_);
+  }
+
+  Status AddAggregate(
+      AggregateFunction::type function, const std::shared_ptr<DataType>& type) {
+    std::unique_ptr<GroupAggregator> aggregator;
+    RETURN_NOT_OK(MakeAggregator(function, type, pool_, &aggregator));
+    aggregators_.push_back(std::move(aggregator));
+    return Status::OK();
+  }
+
+  const std::vector<std::unique_ptr<GroupAggregator>>& aggregators() const {
+    return aggregators_;
+  }
+
+  /// \brief Update the groups from a batch of keys and aggregated columns
+  Status Consume(const std::vector<std::shared_ptr<Array>>& keys,
+      const std::vector<std::shared_ptr<Array>>& values, int64_t length) {
+    RETURN_NOT_OK(LookupGroups(keys, length));
+    for (size_t i = 0; i < aggregators_.size(); ++i) {
+      aggregators_[i]->Consume(*values[i], group_ids_.data());
+    }
+    return Status::OK();
+  }
+
+  /// \brief Fold a batch of partial results into the groups
+  Status Merge(const std::vector<std::shared_ptr<Array>>& keys,
+      const std::vector<std::shared_ptr<Array>>& partials, int64_t length) {
+    RETURN_NOT_OK(LookupGroups(keys, length));
+    size_t column = 0;
+    for (const auto& aggregator : aggregators_) {
+      aggregator->Merge(&partials[column], group_ids_.data());
+      column += aggregator->partial_fields("").size();
+    }
+    return Status::OK();
+  }
+
+  /// \brief Emit the key columns followed by the partial or final aggregate
+  /// columns of every group, and clear the table
+  Status Finish(bool partial, std::vector<std::shared_ptr<Array>>* out) {
+    RETURN_NOT_OK(keys_->Finish(out));
+    for (const auto& aggregator : aggregators_) {
+      RETURN_NOT_OK(aggregator->Finish(partial, out));
+    }
+    return Status::OK();
+  }
+
+  int64_t num_groups() const { return keys_->size(); }
+
+  const uint64_t* group_hashes() const { return keys_->key_hashes(); }
+
+  int64_t memory_usage() const {
+    int64_t total = keys_->memory_usage();
+    for (const auto& aggregator : aggregators_) {
+      total += aggregator->memory_usage();
+    }
+    return total;
+  }
+
+ private:
+  // Compute group_ids_ for a batch of keys, creating groups as needed
+  Status LookupGroups(const std::vector<std::shared_ptr<Array>>& keys, int64_t length) {
+    group_ids_.resize(length);
+    RETURN_NOT_OK(keys_->GetOrInsert(keys, length, group_ids_.data()));
+    for (const auto& aggregator : aggregators_) {
+      RETURN_NOT_OK(aggregator->Resize(keys_->size()));
+    }
+    return Status::OK();
+  }
+
+  MemoryPool* pool_;
+  std::unique_ptr<KeyHashTable> keys_;
+  std::vector<std::unique_ptr<GroupAggregator>> aggregators_;
+
+  // Per-batch scratch space
+  std::vector<int32_t> group_ids_;
+};
+
+// ----------------------------------------------------------------------
+// GroupByAggregator implementation
+
+class GroupByAggregator::GroupByAggregatorImpl {
+ public:
+  GroupByAggregatorImpl() : num_spills_(0) {}
+
+  ~GroupByAggregatorImpl() { RemoveSpillFiles(); }
+
+  Status Init(const std::shared_ptr<Schema>& schema,
+      const std::vector<std::string>& key_names, const std::vector<Aggregate>& aggregates,
+      const GroupByOptions& options, MemoryPool* pool) {
+    schema_ = schema;
+    aggregates_ = aggregates;
+    options_ = options;
+    pool_ = pool;
+
+    if (key_names.empty()) { return Status::Invalid("No group-by keys given"); }
+    if (options_.memory_budget > 0 && options_.num_spill_partitions < 1) {
+      return Status::Invalid("The number of spill partitions must be positive");
+    }
+
+    std::vector<std::shared_ptr<Field>> key_fields;
+    for (const std::string& name : key_names) {
+      int index;
+      RETURN_NOT_OK(FindColumn(name, &index));
+      key_indices_.push_back(index);
+      const auto& input_field = schema_->field(index);
+      key_fields.push_back(field(name, DenseType(input_field->type())));
+    }
+
+    std::vector<std::shared_ptr<Field>> partial_fields(key_fields);
+    std::vector<std::shared_ptr<Field>> result_fields(key_fields);
+    for (Aggregate& aggregate : aggregates_) {
+      int index;
+      RETURN_NOT_OK(FindColumn(aggregate.column_name, &index));
+      value_indices_.push_back(index);
+      if (aggregate.output_name.empty()) {
+        aggregate.output_name = std::string(AggregateFunctionName(aggregate.function)) +
+                                "(" + aggregate.column_name + ")";
+      }
+    }
+
+    RETURN_NOT_OK(MakeGroupTable(&table_));
+    const auto& aggregators = table_->aggregators();
+    for (size_t i = 0; i < aggregates_.size(); ++i) {
+      const std::string& name = aggregates_[i].output_name;
+      for (const auto& partial_field : aggregators[i]->partial_fields(name)) {
+        partial_fields.push_back(partial_field);
+      }
+      result_fields.push_back(field(name, aggregators[i]->out_type()));
+    }
+    partial_schema_ = std::make_shared<Schema>(partial_fields);
+    result_schema_ = std::make_shared<Schema>(result_fields);
+    return Status::OK();
+  }
+
+  Status Consume(const RecordBatch& batch) {
+    RETURN_NOT_OK(CheckBatch(batch));
+    if (batch.num_rows() == 0) { return Status::OK(); }
+
+    std::vector<std::shared_ptr<Array>> keys, values;
+    for (int index : key_indices_) {
+      keys.push_back(batch.column(index));
+    }
+    for (int index : value_indices_) {
+      values.push_back(batch.column(index));
+    }
+    RETURN_NOT_OK(table_->Consume(keys, values, batch.num_rows()));
+
+    if (options_.memory_budget > 0 && table_->memory_usage() > options_.memory_budget) {
+      RETURN_NOT_OK(Spill());
+    }
+    return Status::OK();
+  }
+
+  Status Finish(std::shared_ptr<Table>* out) {
+    std::vector<std::shared_ptr<RecordBatch>> batches;
+    if (num_spills_ == 0) {
+      std::vector<std::shared_ptr<Array>> columns;
+      const int64_t num_groups = table_->num_groups();
+      RETURN_NOT_OK(table_->Finish(false, &columns));
+      batches.push_back(
+          std::make_shared<RecordBatch>(result_schema_, num_groups, columns));
+      return Table::FromRecordBatches(batches, out);
+    }
+
+    // Flush what is left so that every group lives in exactly one partition
+    if (table_->num_groups() > 0) { RETURN_NOT_OK(Spill()); }
+    for (SpillFile& file : spill_files_) {
+      RETURN_NOT_OK(file.writer->Close());
+      RETURN_NOT_OK(file.sink->Close());
+    }
+
+    for (const SpillFile& file : spill_files_) {
+      std::shared_ptr<RecordBatch> batch;
+      RETURN_NOT_OK(MergeSpillFile(file.path, &batch));
+      if (batch->num_rows() > 0 || batches.empty()) { batches.push_back(batch); }
+    }
+    RemoveSpillFiles();
+    return Table::FromRecordBatches(batches, out);
+  }
+
+  std::shared_ptr<Schema> result_schema() const { return result_schema_; }
+
+  int64_t num_groups() const { return table_->num_groups(); }
+
+  int64_t num_spills() const { return num_spills_; }
+
+ private:
+  struct SpillFile {
+    std::string path;
+    std::shared_ptr<io::FileOutputStream> sink;
+    std::shared_ptr<ipc::RecordBatchFileWriter> writer;
+  };
+
+  Status FindColumn(const std::string& name, int* index) const {
+    const int64_t i = schema_->GetFieldIndex(name);
+    if (i < 0) {
+      std::stringstream ss;
+      ss << "Column '" << name << "' not found in schema";
+      return Status::Invalid(ss.str());
+    }
+    *index = static_cast<int>(i);
+    return Status::OK();
+  }
+
+  // Dictionaries are allowed to differ between batches, so only the value
+  // types of the columns are compared
+  Status CheckBatch(const RecordBatch& batch) const {
+    const Schema& batch_schema = *batch.schema();
+    bool equal = batch_schema.num_fields() == schema_->num_fields();
+    for (int i = 0; equal && i < schema_->num_fields(); ++i) {
+      equal = batch_schema.field(i)->name() == schema_->field(i)->name() &&
+              DenseType(batch_schema.field(i)->type())
+                  ->Equals(DenseType(schema_->field(i)->type()));
+    }
+    if (!equal) {
+      std::stringstream ss;
+      ss << "Record batch schema does not match the aggregator schema: \n"
+         << batch_schema.ToString() << "\nvs\n"
+         << schema_->ToString();
+      return Status::Invalid(ss.str());
+    }
+    return Status::OK();
+  }
+
+  Status MakeGroupTable(std::unique_ptr<GroupTable>* out) const {
+    std::unique_ptr<GroupTable> table(new GroupTable(pool_));
+    std::vector<std::shared_ptr<DataType>> key_types;
+    for (int index : key_indices_) {
+      key_types.push_back(DenseType(schema_->field(index)->type()));
+    }
+    RETURN_NOT_OK(table->Init(key_types));
+    for (size_t i = 0; i < aggregates_.size(); ++i) {
+      const auto& type = DenseType(schema_->field(value_indices_[i])->type());
+      RETURN_NOT_OK(table->AddAggregate(aggregates_[i].function, type));
+    }
+    *out = std::move(table);
+    return Status::OK();
+  }
+
+  Status OpenSpillFiles() {
+    static std::atomic<int64_t> spill_counter(0);
+    const int64_t id = spill_counter++;
+    for (int i = 0; i < options_.num_spill_partitions; ++i) {
+      SpillFile file;
+      std::stringstream ss;
+      ss << options_.spill_directory << "/arrow-group-by-" << id << "-"
+         << reinterpret_cast<uintptr_t>(this) << "-" << i << ".arrow";
+      file.path = ss.str();
+      RETURN_NOT_OK(io::FileOutputStream::Open(file.path, &file.sink));
+      // Record the file right away so it is removed even if opening the
+      // writer fails
+      spill_files_.push_back(file);
+      RETURN_NOT_OK(ipc::RecordBatchFileWriter::Open(
+          file.sink.get(), partial_schema_, &spill_files_.back().writer));
+    }
+    return Status::OK();
+  }
+
+  void RemoveSpillFiles() {
+    for (const SpillFile& file : spill_files_) {
+      std::remove(file.path.c_str());
+    }
+    spill_files_.clear();
+  }
+
+  // Write the partial state of every group to the spill file of its hash
+  // partition and clear the in-memory state
+  Status Spill() {
+    if (spill_files_.empty()) { RETURN_NOT_OK(OpenSpillFiles()); }
+
+    const int num_partitions = options_.num_spill_partitions;
+    const int64_t num_groups = table_->num_groups();
+    const uint64_t* hashes = table_->group_hashes();
+
+    // The hash table uses the low bits of the hash, partition on the high ones
+    std::vector<std::vector<int64_t>> partitions(num_partitions);
+    for (int64_t group = 0; group < num_groups; ++group) {
+      partitions[(hashes[group] >> 32) % num_partitions].push_back(group);
+    }
+
+    std::vector<std::shared_ptr<Array>> columns;
+    RETURN_NOT_OK(table_->Finish(true, &columns));
+
+    for (int i = 0; i < num_partitions; ++i) {
+      const std::vector<int64_t>& groups = partitions[i];
+      if (groups.empty()) { continue; }
+      std::vector<std::shared_ptr<Array>> partition_columns(columns.size());
+      for (size_t j = 0; j < columns.size(); ++j) {
+        RETURN_NOT_OK(Take(pool_, *columns[j], groups.data(),
+            static_cast<int64_t>(groups.size()), &partition_columns[j]));
+      }
+      RecordBatch batch(
+          partial_schema_, static_cast<int64_t>(groups.size()), partition_columns);
+      RETURN_NOT_OK(spill_files_[i].writer->WriteRecordBatch(batch));
+    }
+    ++num_spills_;
+    return Status::OK();
+  }
+
+  // Merge the partial states of one spill file into final results. Groups
+  // never straddle partitions, so the result is complete for its groups
+  Status MergeSpillFile(const std::string& path, std::shared_ptr<RecordBatch>* out) {
+    std::shared_ptr<io::ReadableFile> source;
+    RETURN_NOT_OK(io::ReadableFile::Open(path, pool_, &source));
+    std::shared_ptr<ipc::RecordBatchFileReader> reader;
+    RETURN_NOT_OK(ipc::RecordBatchFileReader::Open(source, &reader));
+
+    std::unique_ptr<GroupTable> table;
+    RETURN_NOT_OK(MakeGroupTable(&table));
+    const size_t num_keys = key_indices_.size();
+    for (int i = 0; i < reader->num_record_batches(); ++i) {
+      std::shared_ptr<RecordBatch> batch;
+      RETURN_NOT_OK(reader->ReadRecordBatch(i, &batch));
+      std::vector<std::shared_ptr<Array>> keys, partials;
+      for (int j = 0; j < batch->num_columns(); ++j) {
+        if (static_cast<size_t>(j) < num_keys) {
+          keys.push_back(batch->column(j));
+        } else {
+          partials.push_back(batch->column(j));
+        }
+      }
+      RETURN_NOT_OK(table->Merge(keys, partials, batch->num_rows()));
+    }
+    RETURN_NOT_OK(source->Close());
+
+    std::vector<std::shared_ptr<Array>> columns;
+    const int64_t num_groups = table->num_groups();
+    RETURN_NOT_OK(table->Finish(false, &columns));
+    *out = std::make_shared<RecordBatch>(result_schema_, num_groups, columns);
+    return Status::OK();
+  }
+
+  std::shared_ptr<Schema> schema_;
+  std::vector<Aggregate> aggregates_;
+  GroupByOptions options_;
+  MemoryPool* pool_;
+
+  std::vector<int> key_indices_;
+  std::vector<int> value_indices_;
+  std::shared_ptr<Schema> partial_schema_;
+  std::shared_ptr<Schema> result_schema_;
+
+  std::unique_ptr<GroupTable> table_;
+  std::vector<SpillFile> spill_files_;
+  int64_t num_spills_;
+};
+
+GroupByAggregator::GroupByAggregator() {}
+
+GroupByAggregator::~GroupByAggregator() {}
+
+Status GroupByAggregator::Make(const std::shared_ptr<Schema>& schema,
+    const std::vector<std::string>& key_names, const std::vector<Aggregate>& aggregates,
+    const GroupByOptions& options, MemoryPool* pool,
+    std::unique_ptr<GroupByAggregator>* out) {
+  std::unique_ptr<GroupByAggregator> result(new GroupByAggregator());
+  result->impl_.reset(new GroupByAggregatorImpl());
+  RETURN_NOT_OK(result->impl_->Init(schema, key_names, aggregates, options, pool));
+  *out = std::move(result);
+  return Status::OK();
+}
+
+Status GroupByAggregator::Consume(const RecordBatch& batch) {
+  return impl_->Consume(batch);
+}
+
+Status GroupByAggregator::Consume(ipc::RecordBatchReader* reader) {
+  std::shared_ptr<RecordBatch> batch;
+  while (true) {
+    RETURN_NOT_OK(reader->ReadNextRecordBatch(&batch));
+    if (batch == nullptr) { break; }
+    RETURN_NOT_OK(impl_->Consume(*batch));
+  }
+  return Status::OK();
+}
+
+Status GroupByAggregator::Finish(std::shared_ptr<Table>* out) {
+  return impl_->Finish(out);
+}
+
+std::shared_ptr<Schema> GroupByAggregator::result_schema() const {
+  return impl_->result_schema();
+}
+
+int64_t GroupByAggregator::num_groups() const { return impl_->num_groups(); }
+
+int64_t GroupByAggregator::num_spills() const { return impl_->num_spills(); }
+
+}  // namespace compute
+}  // namespace arrow
@@ -0,0 +1,153 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Streaming hash aggregation over record batches
+
+#ifndef ARROW_COMPUTE_GROUP_BY_H
+#define ARROW_COMPUTE_GROUP_BY_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/util/visibility.h"
+
+namespace arrow {
+
+class MemoryPool;
+class RecordBatch;
+class Schema;
+class Status;
+class Table;
+
+namespace ipc {
+
+class RecordBatchReader;
+
+}  // namespace ipc
+
+namespace compute {
+
+struct AggregateFunction {
+  enum type { COUNT, SUM, MIN, MAX, MEAN };
+};
+
+/// \brief An aggregate computed over one input column for every group
+///
+/// COUNT counts the non-null values of the column. SUM yields int64 for
+/// signed integers, uint64 for unsigned integers and double for floating
+/// point input, integer sums wrapping around on overflow; MIN and MAX
+/// preserve the input type and MEAN always yields double. Groups without
+/// any non-null value are null for every function except COUNT.
+struct ARROW_EXPORT Aggregate {
+  Aggregate(AggregateFunction::type function, const std::string& column_name,
+      const std::string& output_name = "");
+
+  AggregateFunction::type function;
+  std::string column_name;
+
+  /// Name of the result column. If empty, "<function>(<column_name>)" is used
+  std::string output_name;
+};
+
+struct ARROW_EXPORT GroupByOptions {
+  GroupByOptions();
+
+  /// Approximate number of bytes of aggregation state to hold in memory
+  /// before spilling it to disk. Zero (the default) disables spilling
+  int64_t memory_budget;
+
+  /// Directory in which spill files are created; must exist and be writeable
+  std::string spill_directory;
+
+  /// Number of hash partitions the spilled state is split into. Each
+  /// partition is merged on its own when finishing, so this bounds the memory
+  /// needed for the final pass
+  int num_spill_partitions;
+};
+
+/// \class GroupByAggregator
+/// \brief Incremental hash group-by over a stream of record batches
+///
+/// Batches are consumed one at a time: the key columns of each batch are
+/// hashed column-at-a-time, looked up in an open-addressing hash table to
+/// obtain a group id per row, and the aggregate states are then updated
+/// column-at-a-time using those group ids.
+///
+/// Key columns may be integers, temporal types, fixed size binary, binary,
+/// strings or dictionary-encoded versions of those; dictionary keys are
+/// grouped by their dictionary value, so batches may carry differing
+/// dictionaries. Nulls form a group of their own. Aggregated columns must be
+/// integer or floating point.
+///
+/// When a memory budget is configured and exceeded, the partial aggregation
+/// state is hash partitioned and appended to one Arrow IPC file per partition,
+/// and the in-memory state is cleared. Finish then merges every partition
+/// independently.
+class ARROW_EXPORT GroupByAggregator {
+ public:
+  ~GroupByAggregator();
+
+  /// \brief Create a new aggregator
+  ///
+  /// \param[in] schema the schema of the batches to be consumed
+  /// \param[in] key_names the names of the grouping columns
+  /// \param[in] aggregates the aggregates to compute
+  /// \param[in] options memory budget and spilling options
+  /// \param[in] pool memory pool for the aggregation state and results
+  /// \param[out] out the created aggregator
+  /// \return Status
+  static Status Make(const std::shared_ptr<Schema>& schema,
+      const std::vector<std::string>& key_names, const std::vector<Aggregate>& aggregates,
+      const GroupByOptions& options, MemoryPool* pool,
+      std::unique_ptr<GroupByAggregator>* out);
+
+  /// \brief Accumulate a record batch. Its schema must equal the schema the
+  /// aggregator was created with
+  Status Consume(const RecordBatch& batch);
+
+  /// \brief Accumulate every remaining record batch of a reader, for example
+  /// a RecordBatchStreamReader
+  Status Consume(ipc::RecordBatchReader* reader);
+
+  /// \brief Produce the result table, with the key columns followed by one
+  /// column per aggregate. Dictionary-encoded keys are emitted densely
+  ///
+  /// The aggregator must not be used after calling Finish
+  Status Finish(std::shared_ptr<Table>* out);
+
+  /// \return the schema of the result table
+  std::shared_ptr<Schema> result_schema() const;
+
+  /// \return the number of groups currently held in memory
+  int64_t num_groups() const;
+
+  /// \return the number of times the in-memory state was spilled
+  int64_t num_spills() const;
+
+ private:
+  GroupByAggregator();
+
+  class ARROW_NO_EXPORT GroupByAggregatorImpl;
+  std::unique_ptr<GroupByAggregatorImpl> impl_;
+};
+
+}  // namespace compute
+}  // namespace arrow
+
+#endif  // ARROW_COMPUTE_GROUP_BY_H
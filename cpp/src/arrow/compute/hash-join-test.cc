@@ -0,0 +1,327 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/compute/hash-join.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/table.h"
+#include "arrow/test-util.h"
+#include "arrow/type.h"
+
+namespace arrow {
+namespace compute {
+
+// Split an array into zero-copy slices of the given lengths
+static ArrayVector SplitArray(
+    const std::shared_ptr<Array>& array, const std::vector<int64_t>& lengths) {
+  ArrayVector chunks;
+  int64_t offset = 0;
+  for (int64_t length : lengths) {
+    chunks.push_back(array->Slice(offset, length));
+    offset += length;
+  }
+  if (offset < array->length()) { chunks.push_back(array->Slice(offset)); }
+  return chunks;
+}
+
+static std::shared_ptr<Table> MakeTable(const std::vector<std::string>& names,
+    const std::vector<ArrayVector>& chunks) {
+  std::vector<std::shared_ptr<Field>> fields;
+  std::vector<std::shared_ptr<Column>> columns;
+  for (size_t i = 0; i < names.size(); ++i) {
+    auto field = std::make_shared<Field>(names[i], chunks[i][0]->type());
+    fields.push_back(field);
+    columns.push_back(std::make_shared<Column>(field, chunks[i]));
+  }
+  auto schema = std::make_shared<Schema>(fields);
+  return std::make_shared<Table>(schema, columns);
+}
+
+static std::string FormatValue(const Array& array, int64_t i) {
+  if (array.IsNull(i)) { return "null"; }
+  std::stringstream ss;
+  switch (array.type_id()) {
+    case Type::INT32:
+      ss << static_cast<const Int32Array&>(array).Value(i);
+      break;
+    case Type::INT64:
+      ss << static_cast<const Int64Array&>(array).Value(i);
+      break;
+    case Type::STRING:
+      ss << static_cast<const StringArray&>(array).GetString(i);
+      break;
+    case Type::DICTIONARY: {
+      const auto& dict_array = static_cast<const DictionaryArray&>(array);
+      const auto& indices = static_cast<const Int32Array&>(*dict_array.indices());
+      return FormatValue(*dict_array.dictionary(), indices.Value(i));
+    }
+    default:
+      ss << "?";
+  }
+  return ss.str();
+}
+
+// The rows of a table as sorted strings, since join output is unordered
+static std::vector<std::string> TableRows(const Table& table) {
+  std::vector<std::string> rows(table.num_rows());
+  for (int i = 0; i < table.num_columns(); ++i) {
+    const ChunkedArray& data = *table.column(i)->data();
+    int64_t row = 0;
+    for (int j = 0; j < data.num_chunks(); ++j) {
+      const Array& chunk = *data.chunk(j);
+      for (int64_t k = 0; k < chunk.length(); ++k) {
+        rows[row] += (i == 0 ? "" : "|") + FormatValue(chunk, k);
+        ++row;
+      }
+    }
+    EXPECT_EQ(table.num_rows(), row);
+  }
+  std::sort(rows.begin(), rows.end());
+  return rows;
+}
+
+class TestHashJoin : public ::testing::Test {
+ public:
+  void CheckJoin(const Table& left, const Table& right,
+      const std::vector<std::string>& left_keys,
+      const std::vector<std::string>& right_keys, const HashJoinOptions& options,
+      std::vector<std::string> expected) {
+    std::shared_ptr<Table> result;
+    ASSERT_OK(
+        HashJoin(left, right, left_keys, right_keys, options, default_memory_pool(),
+            &result));
+    std::sort(expected.begin(), expected.end());
+    ASSERT_EQ(expected, TableRows(*result));
+  }
+
+  HashJoinOptions Options(JoinType::type join_type) {
+    HashJoinOptions options;
+    options.join_type = join_type;
+    return options;
+  }
+};
+
+TEST_F(TestHashJoin, JoinTypes) {
+  std::shared_ptr<Array> left_key, left_value, right_key, right_value;
+  ArrayFromVector<Int64Type, int64_t>(
+      {true, true, true, false, true}, {1, 2, 2, 0, 5}, &left_key);
+  ArrayFromVector<Int32Type, int32_t>({10, 20, 21, 30, 50}, &left_value);
+  ArrayFromVector<Int64Type, int64_t>(
+      {true, true, true, false, true, true}, {2, 3, 1, 0, 1, 7}, &right_key);
+  ArrayFromVector<StringType, std::string>({"b", "c", "a", "n", "A", "z"}, &right_value);
+
+  // The left table is the smaller one, so it is the build side
+  auto left = MakeTable({"k", "x"}, {{left_key}, {left_value}});
+  auto right = MakeTable({"k", "y"}, {{right_key}, {right_value}});
+  ASSERT_LT(left->num_rows(), right->num_rows());
+
+  const std::vector<std::string> inner = {
+      "1|10|a", "1|10|A", "2|20|b", "2|21|b"};
+  const std::vector<std::string> left_outer = {
+      "1|10|a", "1|10|A", "2|20|b", "2|21|b", "null|30|null", "5|50|null"};
+  const std::vector<std::string> left_semi = {"1|10", "2|20", "2|21"};
+  const std::vector<std::string> left_anti = {"null|30", "5|50"};
+
+  CheckJoin(*left, *right, {"k"}, {"k"}, Options(JoinType::INNER), inner);
+  CheckJoin(*left, *right, {"k"}, {"k"}, Options(JoinType::LEFT_OUTER), left_outer);
+  CheckJoin(*left, *right, {"k"}, {"k"}, Options(JoinType::LEFT_SEMI), left_semi);
+  CheckJoin(*left, *right, {"k"}, {"k"}, Options(JoinType::LEFT_ANTI), left_anti);
+
+  // Same tables with the right table as the build side
+  auto small_right = MakeTable({"k", "y"}, {{right_key->Slice(0, 3)},
+      {right_value->Slice(0, 3)}});
+  ASSERT_GT(left->num_rows(), small_right->num_rows());
+  CheckJoin(*left, *small_right, {"k"}, {"k"}, Options(JoinType::INNER),
+      {"1|10|a", "2|20|b", "2|21|b"});
+  CheckJoin(*left, *small_right, {"k"}, {"k"}, Options(JoinType::LEFT_OUTER),
+      {"1|10|a", "2|20|b", "2|21|b", "null|30|null", "5|50|null"});
+  CheckJoin(*left, *small_right, {"k"}, {"k"}, Options(JoinType::LEFT_SEMI),
+      left_semi);
+  CheckJoin(*left, *small_right, {"k"}, {"k"}, Options(JoinType::LEFT_ANTI),
+      left_anti);
+}
+
+TEST_F(TestHashJoin, StringAndDictionaryKeys) {
+  std::shared_ptr<Array> dict, indices, left_k2, left_value, right_k1, right_k2;
+  ArrayFromVector<StringType, std::string>({"foo", "bar"}, &dict);
+  ArrayFromVector<Int32Type, int32_t>({true, true, false, true}, {0, 1, 0, 1}, &indices);
+  auto left_k1 = std::make_shared<DictionaryArray>(dictionary(int32(), dict), indices);
+  ArrayFromVector<Int32Type, int32_t>({1, 1, 1, 2}, &left_k2);
+  ArrayFromVector<Int64Type, int64_t>({100, 200, 300, 400}, &left_value);
+
+  ArrayFromVector<StringType, std::string>(
+      {true, true, true, false}, {"foo", "bar", "bar", ""}, &right_k1);
+  ArrayFromVector<Int32Type, int32_t>({1, 1, 2, 1}, &right_k2);
+
+  auto left = MakeTable({"k1", "k2", "x"}, {{left_k1}, {left_k2}, {left_value}});
+  auto right = MakeTable({"a", "b"}, {{right_k1}, {right_k2}});
+
+  // Both keys of the right table are join keys, so they are not repeated
+  CheckJoin(*left, *right, {"k1", "k2"}, {"a", "b"}, Options(JoinType::INNER),
+      {"foo|1|100", "bar|1|200", "bar|2|400"});
+  CheckJoin(*left, *right, {"k1", "k2"}, {"a", "b"}, Options(JoinType::LEFT_ANTI),
+      {"null|1|300"});
+}
+
+TEST_F(TestHashJoin, ChunkedDictionaryKeys) {
+  // The chunks of the dictionary-encoded key have different dictionaries
+  std::shared_ptr<Array> dict1, dict2, indices1, indices2, left_value, right_key;
+  ArrayFromVector<StringType, std::string>({"foo", "bar"}, &dict1);
+  ArrayFromVector<StringType, std::string>({"baz", "bar", "foo"}, &dict2);
+  ArrayFromVector<Int32Type, int32_t>({0, 1}, &indices1);
+  ArrayFromVector<Int32Type, int32_t>({true, true, false}, {0, 2, 0}, &indices2);
+  ArrayVector left_keys = {
+      std::make_shared<DictionaryArray>(dictionary(int32(), dict1), indices1),
+      std::make_shared<DictionaryArray>(dictionary(int32(), dict2), indices2)};
+  ArrayFromVector<Int64Type, int64_t>({1, 2, 3, 4, 5}, &left_value);
+  ArrayFromVector<StringType, std::string>(
+      {"foo", "baz", "bar", "foo", "qux", "bar"}, &right_key);
+
+  // The left table is the smaller one, so its chunked columns are gathered
+  auto left = MakeTable({"k", "x"}, {left_keys, SplitArray(left_value, {2})});
+  auto right = MakeTable({"k"}, {{right_key}});
+  CheckJoin(*left, *right, {"k"}, {"k"}, Options(JoinType::INNER),
+      {"foo|1", "foo|1", "bar|2", "bar|2", "baz|3", "foo|4", "foo|4"});
+  CheckJoin(*left, *right, {"k"}, {"k"}, Options(JoinType::LEFT_ANTI), {"null|5"});
+}
+
+TEST_F(TestHashJoin, ChunkedParallel) {
+  const int64_t kSmall = 300;
+  const int64_t kLarge = 2000;
+
+  std::vector<int64_t> keys(kSmall + kLarge);
+  std::vector<uint8_t> valid_bytes(kSmall + kLarge);
+  test::rand_uniform_int<int64_t>(kSmall + kLarge, 0, 0, 150, keys.data());
+  test::random_null_bytes(kSmall + kLarge, 0.05, valid_bytes.data());
+  std::vector<bool> is_valid(valid_bytes.begin(), valid_bytes.end());
+
+  std::vector<int32_t> payload(kSmall + kLarge);
+  for (int64_t i = 0; i < kSmall + kLarge; ++i) {
+    payload[i] = static_cast<int32_t>(i);
+  }
+
+  auto MakeSide = [&](int64_t offset, int64_t length, const std::string& value_name) {
+    std::shared_ptr<Array> key, value;
+    ArrayFromVector<Int64Type, int64_t>(
+        std::vector<bool>(is_valid.begin() + offset, is_valid.begin() + offset + length),
+        std::vector<int64_t>(keys.begin() + offset, keys.begin() + offset + length),
+        &key);
+    ArrayFromVector<Int32Type, int32_t>(
+        std::vector<int32_t>(
+            payload.begin() + offset, payload.begin() + offset + length),
+        &value);
+    // Chunk boundaries differ between the columns
+    return MakeTable({"k", value_name},
+        {SplitArray(key, {7, 0, 100, 33}), SplitArray(value, {50, 51})});
+  };
+
+  auto small = MakeSide(0, kSmall, "x");
+  auto large = MakeSide(kSmall, kLarge, "y");
+
+  // Nested loop reference join
+  auto Reference = [&](const Table& left, const Table& right, JoinType::type join_type) {
+    const int64_t left_offset = &left == small.get() ? 0 : kSmall;
+    const int64_t right_offset = &right == small.get() ? 0 : kSmall;
+    std::vector<std::string> rows;
+    for (int64_t i = 0; i < left.num_rows(); ++i) {
+      const int64_t l = left_offset + i;
+      const std::string key = is_valid[l] ? std::to_string(keys[l]) : "null";
+      const std::string left_row = key + "|" + std::to_string(payload[l]);
+      bool matched = false;
+      for (int64_t j = 0; j < right.num_rows(); ++j) {
+        const int64_t r = right_offset + j;
+        if (!is_valid[l] || !is_valid[r] || keys[l] != keys[r]) { continue; }
+        matched = true;
+        if (join_type == JoinType::INNER || join_type == JoinType::LEFT_OUTER) {
+          rows.push_back(left_row + "|" + std::to_string(payload[r]));
+        }
+      }
+      if (join_type == JoinType::LEFT_OUTER && !matched) {
+        rows.push_back(left_row + "|null");
+      } else if ((join_type == JoinType::LEFT_SEMI && matched) ||
+                 (join_type == JoinType::LEFT_ANTI && !matched)) {
+        rows.push_back(left_row);
+      }
+    }
+    return rows;
+  };
+
+  for (auto join_type : {JoinType::INNER, JoinType::LEFT_OUTER, JoinType::LEFT_SEMI,
+           JoinType::LEFT_ANTI}) {
+    for (int num_threads : {1, 4}) {
+      HashJoinOptions options = Options(join_type);
+      options.num_threads = num_threads;
+      options.morsel_size = 37;
+      CheckJoin(*small, *large, {"k"}, {"k"}, options,
+          Reference(*small, *large, join_type));
+      CheckJoin(*large, *small, {"k"}, {"k"}, options,
+          Reference(*large, *small, join_type));
+    }
+  }
+}
+
+TEST_F(TestHashJoin, Empty) {
+  std::shared_ptr<Array> key, empty_key;
+  ArrayFromVector<Int64Type, int64_t>({1, 2}, &key);
+  ArrayFromVector<Int64Type, int64_t>({}, &empty_key);
+  auto left = MakeTable({"k"}, {{key}});
+  auto right = MakeTable({"k"}, {{empty_key}});
+
+  CheckJoin(*left, *right, {"k"}, {"k"}, Options(JoinType::INNER), {});
+  CheckJoin(*right, *left, {"k"}, {"k"}, Options(JoinType::LEFT_OUTER), {});
+  CheckJoin(*left, *right, {"k"}, {"k"}, Options(JoinType::LEFT_ANTI), {"1", "2"});
+}
+
+TEST_F(TestHashJoin, Errors) {
+  std::shared_ptr<Array> int_key, string_key;
+  ArrayFromVector<Int64Type, int64_t>({1, 2}, &int_key);
+  ArrayFromVector<StringType, std::string>({"1", "2"}, &string_key);
+  auto left = MakeTable({"k"}, {{int_key}});
+  auto right = MakeTable({"k"}, {{string_key}});
+
+  std::shared_ptr<Table> result;
+  MemoryPool* pool = default_memory_pool();
+  HashJoinOptions options;
+  ASSERT_RAISES(Invalid, HashJoin(*left, *left, {"k"}, {"missing"}, options, pool,
+                             &result));
+  ASSERT_RAISES(Invalid, HashJoin(*left, *right, {"k"}, {"k"}, options, pool, &result));
+  ASSERT_RAISES(Invalid, HashJoin(*left, *left, {}, {}, options, pool, &result));
+
+  // Non-key columns named alike on both sides
+  auto with_value = MakeTable({"k", "v"}, {{int_key}, {int_key}});
+  ASSERT_RAISES(Invalid, HashJoin(*with_value, *with_value, {"k"}, {"k"}, options, pool,
+                             &result));
+  options.join_type = JoinType::LEFT_SEMI;
+  ASSERT_OK(HashJoin(*with_value, *with_value, {"k"}, {"k"}, options, pool, &result));
+
+  options.morsel_size = 0;
+  ASSERT_RAISES(Invalid, HashJoin(*left, *left, {"k"}, {"k"}, options, pool, &result));
+}
+
+}  // namespace compute
+}  // namespace arrow
@@ -0,0 +1,461 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/compute/hash-join.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/compute/compute-internal.h"
+#include "arrow/compute/hash-table.h"
+#include "arrow/compute/take.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/table.h"
+#include "arrow/type.h"
+
+namespace arrow {
+namespace compute {
+
+HashJoinOptions::HashJoinOptions()
+    : join_type(JoinType::INNER), num_threads(0), morsel_size(1 << 16) {}
+
+using ChunkedArrayVector = std::vector<std::shared_ptr<ChunkedArray>>;
+
+// Split a table into batches of aligned, zero-copy slices of its columns, with
+// at most max_rows rows each
+static void SliceTable(
+    const Table& table, int64_t max_rows, std::vector<ArrayVector>* out) {
+  const int num_columns = table.num_columns();
+  std::vector<int> chunk_index(num_columns, 0);
+  std::vector<int64_t> chunk_offset(num_columns, 0);
+
+  int64_t remaining = table.num_rows();
+  while (remaining > 0) {
+    int64_t length = std::min(remaining, max_rows);
+    for (int i = 0; i < num_columns; ++i) {
+      const ChunkedArray& data = *table.column(i)->data();
+      // Skip exhausted and empty chunks
+      while (chunk_offset[i] == data.chunk(chunk_index[i])->length()) {
+        ++chunk_index[i];
+        chunk_offset[i] = 0;
+      }
+      length =
+          std::min(length, data.chunk(chunk_index[i])->length() - chunk_offset[i]);
+    }
+
+    ArrayVector batch;
+    for (int i = 0; i < num_columns; ++i) {
+      const auto& chunk = table.column(i)->data()->chunk(chunk_index[i]);
+      batch.push_back(chunk->Slice(chunk_offset[i], length));
+      chunk_offset[i] += length;
+    }
+    out->push_back(std::move(batch));
+    remaining -= length;
+  }
+}
+
+// Whether any key of a row is null, looking through dictionaries
+static void KeyNulls(
+    const ArrayVector& keys, int64_t length, std::vector<uint8_t>* has_null) {
+  has_null->assign(length, 0);
+  for (const auto& key : keys) {
+    if (key->type_id() == Type::DICTIONARY) {
+      const auto& dict_array = static_cast<const DictionaryArray&>(*key);
+      const Array& dictionary = *dict_array.dictionary();
+      const Array& indices = *dict_array.indices();
+      // Dictionary indices are signed integers of any width
+      for (int64_t i = 0; i < length; ++i) {
+        if (indices.IsNull(i)) {
+          (*has_null)[i] = 1;
+          continue;
+        }
+        int64_t position;
+        switch (indices.type_id()) {
+          case Type::INT8:
+            position = static_cast<const Int8Array&>(indices).Value(i);
+            break;
+          case Type::INT16:
+            position = static_cast<const Int16Array&>(indices).Value(i);
+            break;
+          case Type::INT32:
+            position = static_cast<const Int32Array&>(indices).Value(i);
+            break;
+          default:
+            position = static_cast<const Int64Array&>(indices).Value(i);
+            break;
+        }
+        (*has_null)[i] |= dictionary.IsNull(position);
+      }
+    } else if (key->null_count() > 0) {
+      for (int64_t i = 0; i < length; ++i) {
+        (*has_null)[i] |= key->IsNull(i);
+      }
+    }
+  }
+}
+
+class HashJoiner {
+ public:
+  HashJoiner(const Table& left, const Table& right, const HashJoinOptions& options,
+      MemoryPool* pool)
+      : left_(left), right_(right), options_(options), pool_(pool) {}
+
+  Status Init(const std::vector<std::string>& left_keys,
+      const std::vector<std::string>& right_keys) {
+    if (left_keys.empty() || left_keys.size() != right_keys.size()) {
+      return Status::Invalid("Joins need the same, non-zero number of keys on each side");
+    }
+    if (options_.morsel_size <= 0) {
+      return Status::Invalid("Join morsel size must be positive");
+    }
+
+    std::vector<std::shared_ptr<DataType>> key_types;
+    for (size_t i = 0; i < left_keys.size(); ++i) {
+      int left_index, right_index;
+      RETURN_NOT_OK(FindColumn(left_, left_keys[i], &left_index));
+      RETURN_NOT_OK(FindColumn(right_, right_keys[i], &right_index));
+      const auto left_type = DenseType(left_.column(left_index)->type());
+      const auto right_type = DenseType(right_.column(right_index)->type());
+      if (!left_type->Equals(right_type)) {
+        std::stringstream ss;
+        ss << "Join key types differ: " << left_type->ToString() << " vs "
+           << right_type->ToString();
+        return Status::Invalid(ss.str());
+      }
+      left_key_indices_.push_back(left_index);
+      right_key_indices_.push_back(right_index);
+      key_types.push_back(left_type);
+    }
+
+    // All left columns, then the right columns that are not keys
+    std::vector<std::shared_ptr<Field>> fields;
+    for (int i = 0; i < left_.num_columns(); ++i) {
+      left_output_.push_back(i);
+      fields.push_back(left_.schema()->field(i));
+    }
+    if (options_.join_type == JoinType::INNER ||
+        options_.join_type == JoinType::LEFT_OUTER) {
+      for (int i = 0; i < right_.num_columns(); ++i) {
+        if (std::find(right_key_indices_.begin(), right_key_indices_.end(), i) !=
+            right_key_indices_.end()) {
+          continue;
+        }
+        right_output_.push_back(i);
+        fields.push_back(right_.schema()->field(i));
+      }
+    }
+    for (size_t i = 0; i < fields.size(); ++i) {
+      for (size_t j = 0; j < i; ++j) {
+        if (fields[i]->name() == fields[j]->name()) {
+          std::stringstream ss;
+          ss << "Join output has duplicate column name '" << fields[i]->name() << "'";
+          return Status::Invalid(ss.str());
+        }
+      }
+    }
+    schema_ = std::make_shared<Schema>(fields);
+
+    // Build on the smaller side
+    build_is_left_ = left_.num_rows() < right_.num_rows();
+    return KeyHashTable::Make(key_types, pool_, &hash_table_);
+  }
+
+  Status Build() {
+    const Table& build = build_is_left_ ? left_ : right_;
+    const std::vector<int>& key_indices =
+        build_is_left_ ? left_key_indices_ : right_key_indices_;
+
+    std::vector<ArrayVector> batches;
+    SliceTable(build, build.num_rows(), &batches);
+
+    // Key id of every build row, -1 for rows that can never match
+    std::vector<int32_t> row_ids(build.num_rows());
+    int64_t offset = 0;
+    std::vector<uint8_t> has_null;
+    for (const ArrayVector& batch : batches) {
+      ArrayVector keys;
+      for (int index : key_indices) {
+        keys.push_back(batch[index]);
+      }
+      const int64_t length = batch[0]->length();
+      RETURN_NOT_OK(hash_table_->GetOrInsert(keys, length, row_ids.data() + offset));
+      KeyNulls(keys, length, &has_null);
+      for (int64_t i = 0; i < length; ++i) {
+        if (has_null[i]) { row_ids[offset + i] = -1; }
+      }
+      offset += length;
+    }
+
+    // Group the build rows by key id
+    const int64_t num_keys = hash_table_->size();
+    key_offsets_.assign(num_keys + 1, 0);
+    for (int32_t id : row_ids) {
+      if (id >= 0) { ++key_offsets_[id + 1]; }
+    }
+    for (int64_t i = 0; i < num_keys; ++i) {
+      key_offsets_[i + 1] += key_offsets_[i];
+    }
+    key_rows_.resize(key_offsets_[num_keys]);
+    std::vector<int64_t> next(key_offsets_.begin(), key_offsets_.end() - 1);
+    for (int64_t row = 0; row < static_cast<int64_t>(row_ids.size()); ++row) {
+      if (row_ids[row] >= 0) { key_rows_[next[row_ids[row]]++] = row; }
+    }
+    return Status::OK();
+  }
+
+  Status Probe(std::shared_ptr<Table>* out) {
+    const Table& probe = build_is_left_ ? right_ : left_;
+    const Table& build = build_is_left_ ? left_ : right_;
+    std::vector<ArrayVector> morsels;
+    SliceTable(probe, options_.morsel_size, &morsels);
+
+    const int64_t num_tasks = static_cast<int64_t>(morsels.size());
+    std::vector<ArrayVector> results(num_tasks);
+    // Whether each build row matched, shared by the threads. Flags only ever
+    // go from 0 to 1, so relaxed stores suffice, the joins ordering them
+    // before they are read
+    std::unique_ptr<std::atomic<uint8_t>[]> build_matched;
+
+    int num_threads = options_.num_threads > 0
+                          ? options_.num_threads
+                          : static_cast<int>(std::thread::hardware_concurrency());
+    num_threads = static_cast<int>(std::max<int64_t>(
+        1, std::min<int64_t>(num_threads, num_tasks)));
+    if (build_is_left_) {
+      build_matched.reset(new std::atomic<uint8_t>[build.num_rows()]());
+    }
+
+    auto RunTask = [&](int64_t task) {
+      return ProbeMorsel(morsels[task], build_matched.get(), &results[task]);
+    };
+
+    if (num_threads == 1) {
+      for (int64_t task = 0; task < num_tasks; ++task) {
+        RETURN_NOT_OK(RunTask(task));
+      }
+    } else {
+      std::vector<std::thread> thread_pool;
+      thread_pool.reserve(num_threads);
+      std::atomic<int64_t> task_counter(0);
+
+      std::mutex error_mtx;
+      bool error_occurred = false;
+      Status error;
+
+      for (int thread_id = 0; thread_id < num_threads; ++thread_id) {
+        thread_pool.emplace_back([&]() {
+          while (true) {
+            {
+              std::lock_guard<std::mutex> lock(error_mtx);
+              if (error_occurred) { break; }
+            }
+            const int64_t task = task_counter.fetch_add(1);
+            if (task >= num_tasks) { break; }
+            Status s = RunTask(task);
+            if (!s.ok()) {
+              std::lock_guard<std::mutex> lock(error_mtx);
+              error_occurred = true;
+              error = s;
+              break;
+            }
+          }
+        });
+      }
+      for (auto&& thread : thread_pool) {
+        thread.join();
+      }
+      if (error_occurred) { return error; }
+    }
+
+    if (build_is_left_ && options_.join_type != JoinType::INNER) {
+      // Emit the left rows that depend on the match flags
+      const bool want_matched = options_.join_type == JoinType::LEFT_SEMI;
+      std::vector<int64_t> left_rows;
+      for (int64_t i = 0; i < build.num_rows(); ++i) {
+        const bool matched = build_matched[i].load(std::memory_order_relaxed) != 0;
+        if (matched == want_matched) { left_rows.push_back(i); }
+      }
+      // Unmatched rows of a left outer join get null right columns
+      std::vector<int64_t> right_rows(left_rows.size(), -1);
+      results.emplace_back();
+      RETURN_NOT_OK(
+          Gather(TableColumns(left_), left_rows, TableColumns(right_), right_rows,
+              &results.back()));
+    }
+
+    return Concatenate(results, out);
+  }
+
+ private:
+  static Status FindColumn(const Table& table, const std::string& name, int* index) {
+    const int64_t i = table.schema()->GetFieldIndex(name);
+    if (i < 0) {
+      std::stringstream ss;
+      ss << "Join column '" << name << "' not found in table";
+      return Status::Invalid(ss.str());
+    }
+    *index = static_cast<int>(i);
+    return Status::OK();
+  }
+
+  static ChunkedArrayVector TableColumns(const Table& table) {
+    ChunkedArrayVector columns;
+    for (int i = 0; i < table.num_columns(); ++i) {
+      columns.push_back(table.column(i)->data());
+    }
+    return columns;
+  }
+
+  static ChunkedArrayVector MorselColumns(const ArrayVector& morsel) {
+    ChunkedArrayVector columns;
+    for (const auto& column : morsel) {
+      columns.push_back(std::make_shared<ChunkedArray>(ArrayVector({column})));
+    }
+    return columns;
+  }
+
+  // Find the matches of one probe batch and gather its output columns. Build
+  // rows with a match are flagged in build_matched when the build side is the
+  // left table
+  Status ProbeMorsel(const ArrayVector& morsel, std::atomic<uint8_t>* build_matched,
+      ArrayVector* out) const {
+    const std::vector<int>& key_indices =
+        build_is_left_ ? right_key_indices_ : left_key_indices_;
+    ArrayVector keys;
+    for (int index : key_indices) {
+      keys.push_back(morsel[index]);
+    }
+    const int64_t length = morsel[0]->length();
+    std::vector<int32_t> ids(length);
+    RETURN_NOT_OK(hash_table_->Lookup(keys, length, ids.data()));
+
+    const JoinType::type join_type = options_.join_type;
+    std::vector<int64_t> probe_rows, build_rows;
+    for (int64_t row = 0; row < length; ++row) {
+      const int32_t id = ids[row];
+      const int64_t begin = id < 0 ? 0 : key_offsets_[id];
+      const int64_t end = id < 0 ? 0 : key_offsets_[id + 1];
+      if (build_is_left_) {
+        for (int64_t i = begin; i < end; ++i) {
+          // Test first, to not write shared cache lines needlessly
+          std::atomic<uint8_t>& matched = build_matched[key_rows_[i]];
+          if (!matched.load(std::memory_order_relaxed)) {
+            matched.store(1, std::memory_order_relaxed);
+          }
+        }
+        if (join_type == JoinType::LEFT_SEMI || join_type == JoinType::LEFT_ANTI) {
+          continue;
+        }
+      } else if (join_type == JoinType::LEFT_SEMI || join_type == JoinType::LEFT_ANTI) {
+        if ((begin < end) == (join_type == JoinType::LEFT_SEMI)) {
+          probe_rows.push_back(row);
+        }
+        continue;
+      }
+      for (int64_t i = begin; i < end; ++i) {
+        probe_rows.push_back(row);
+        build_rows.push_back(key_rows_[i]);
+      }
+      if (begin == end && join_type == JoinType::LEFT_OUTER && !build_is_left_) {
+        probe_rows.push_back(row);
+        build_rows.push_back(-1);
+      }
+    }
+
+    if (build_is_left_) {
+      if (join_type == JoinType::LEFT_SEMI || join_type == JoinType::LEFT_ANTI) {
+        return Status::OK();
+      }
+      return Gather(TableColumns(left_), build_rows, MorselColumns(morsel), probe_rows,
+          out);
+    }
+    return Gather(MorselColumns(morsel), probe_rows, TableColumns(right_), build_rows,
+        out);
+  }
+
+  Status Gather(const ChunkedArrayVector& left_columns,
+      const std::vector<int64_t>& left_rows, const ChunkedArrayVector& right_columns,
+      const std::vector<int64_t>& right_rows, ArrayVector* out) const {
+    const int64_t length = static_cast<int64_t>(left_rows.size());
+    if (length == 0) { return Status::OK(); }
+    std::shared_ptr<Array> column;
+    for (int i : left_output_) {
+      RETURN_NOT_OK(Take(pool_, *left_columns[i], left_rows.data(), length, &column));
+      out->push_back(column);
+    }
+    for (int i : right_output_) {
+      RETURN_NOT_OK(Take(pool_, *right_columns[i], right_rows.data(), length, &column));
+      out->push_back(column);
+    }
+    return Status::OK();
+  }
+
+  Status Concatenate(
+      const std::vector<ArrayVector>& batches, std::shared_ptr<Table>* out) const {
+    std::vector<std::shared_ptr<Column>> columns;
+    int64_t num_rows = 0;
+    for (int i = 0; i < schema_->num_fields(); ++i) {
+      ArrayVector chunks;
+      for (const ArrayVector& batch : batches) {
+        if (batch.empty()) { continue; }
+        chunks.push_back(batch[i]);
+        if (i == 0) { num_rows += batch[i]->length(); }
+      }
+      columns.push_back(std::make_shared<Column>(schema_->field(i), chunks));
+    }
+    *out = std::make_shared<Table>(schema_, columns, num_rows);
+    return Status::OK();
+  }
+
+  const Table& left_;
+  const Table& right_;
+  HashJoinOptions options_;
+  MemoryPool* pool_;
+
+  std::vector<int> left_key_indices_;
+  std::vector<int> right_key_indices_;
+  std::vector<int> left_output_;
+  std::vector<int> right_output_;
+  std::shared_ptr<Schema> schema_;
+  bool build_is_left_;
+
+  std::unique_ptr<KeyHashTable> hash_table_;
+  // The build rows of key id i are key_rows_[key_offsets_[i]:key_offsets_[i + 1]]
+  std::vector<int64_t> key_offsets_;
+  std::vector<int64_t> key_rows_;
+};
+
+Status HashJoin(const Table& left, const Table& right,
+    const std::vector<std::string>& left_keys, const std::vector<std::string>& right_keys,
+    const HashJoinOptions& options, MemoryPool* pool, std::shared_ptr<Table>* out) {
+  HashJoiner joiner(left, right, options, pool);
+  RETURN_NOT_OK(joiner.Init(left_keys, right_keys));
+  RETURN_NOT_OK(joiner.Build());
+  return joiner.Probe(out);
+}
+
+}  // namespace compute
+}  // namespace arrow
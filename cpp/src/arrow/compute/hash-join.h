@@ -0,0 +1,94 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// In-memory equi-join of two tables
+
+#ifndef ARROW_COMPUTE_HASH_JOIN_H
+#define ARROW_COMPUTE_HASH_JOIN_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/util/visibility.h"
+
+namespace arrow {
+
+class MemoryPool;
+class Status;
+class Table;
+
+namespace compute {
+
+struct JoinType {
+  enum type {
+    /// Every pair of matching left and right rows
+    INNER,
+    /// Like INNER, plus the left rows without a match, with null right columns
+    LEFT_OUTER,
+    /// The left rows with at least one match, each emitted once
+    LEFT_SEMI,
+    /// The left rows without any match
+    LEFT_ANTI
+  };
+};
+
+struct ARROW_EXPORT HashJoinOptions {
+  HashJoinOptions();
+
+  JoinType::type join_type;
+
+  /// Number of threads probing the hash table. Zero (the default) uses the
+  /// hardware concurrency
+  int num_threads;
+
+  /// Maximum number of rows probed as one task
+  int64_t morsel_size;
+};
+
+/// \brief Join two tables on equality of their key columns
+///
+/// The hash table is built on the key columns of the smaller table. The
+/// other table is split into batches of at most morsel_size rows, which are
+/// probed in parallel; the output columns of every batch are gathered with
+/// Take.
+///
+/// INNER and LEFT_OUTER joins produce the left columns followed by the right
+/// columns that are not join keys; LEFT_SEMI and LEFT_ANTI produce the left
+/// columns only, and their names must be unique: rename the columns of either
+/// table first if needed. A row with a null in any of its keys matches no
+/// row. The order of the result rows is unspecified.
+///
+/// \param[in] left the left table
+/// \param[in] right the right table
+/// \param[in] left_keys the names of the left join columns
+/// \param[in] right_keys the names of the right join columns, compared
+/// pairwise with left_keys. Types must match, dictionary-encoded columns
+/// match on their dictionary values
+/// \param[in] options join type and parallelism
+/// \param[in] pool memory pool for the hash table and the result
+/// \param[out] out the joined table
+/// \return Status
+Status ARROW_EXPORT HashJoin(const Table& left, const Table& right,
+    const std::vector<std::string>& left_keys, const std::vector<std::string>& right_keys,
+    const HashJoinOptions& options, MemoryPool* pool, std::shared_ptr<Table>* out);
+
+}  // namespace compute
+}  // namespace arrow
+
+#endif  // ARROW_COMPUTE_HASH_JOIN_H
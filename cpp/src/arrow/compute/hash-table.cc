@@ -0,0 +1,605 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/compute/hash-table.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/buffer.h"
+#include "arrow/compute/compute-internal.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/type.h"
+#include "arrow/util/hash-util.h"
+
+namespace arrow {
+namespace compute {
+
+// Seed of the key hashes
+static constexpr uint64_t kHashSeed = 0x2545f4914f6cdd1dULL;
+
+// ----------------------------------------------------------------------
+// Key columns: store the distinct keys and compare them with batch input
+
+template <typename IndexType>
+static void DictionaryPositions(const Array& indices, int64_t* out) {
+  const auto& typed = static_cast<const NumericArray<IndexType>&>(indices);
+  const auto* values = typed.raw_values();
+  for (int64_t i = 0; i < typed.length(); ++i) {
+    out[i] = typed.IsNull(i) ? -1 : static_cast<int64_t>(values[i]);
+  }
+}
+
+// Floating point keys are hashed and compared by their bits, so -0.0 is made
+// 0.0 and every NaN the same NaN
+template <typename T>
+static Status NormalizeFloatingKeys(
+    const Array& array, MemoryPool* pool, std::shared_ptr<Array>* out) {
+  const int64_t length = array.length();
+  std::vector<std::shared_ptr<Buffer>> buffers(2);
+  if (array.null_count() > 0) {
+    RETURN_NOT_OK(CopyBitmap(
+        pool, array.null_bitmap_data(), array.offset(), length, &buffers[0]));
+  }
+  if (array.data()->buffers[1]) {
+    auto values = std::make_shared<PoolBuffer>(pool);
+    RETURN_NOT_OK(values->Resize(length * sizeof(T)));
+    const T* in =
+        reinterpret_cast<const T*>(array.data()->buffers[1]->data()) + array.offset();
+    T* normalized = reinterpret_cast<T*>(values->mutable_data());
+    for (int64_t i = 0; i < length; ++i) {
+      const T value = in[i];
+      normalized[i] = value == 0 ? static_cast<T>(0)
+                                 : (value != value ? std::numeric_limits<T>::quiet_NaN()
+                                                   : value);
+    }
+    buffers[1] = values;
+  }
+  auto result = std::make_shared<internal::ArrayData>(
+      array.type(), length, std::move(buffers), array.null_count());
+  return internal::MakeArray(result, out);
+}
+
+static Status NormalizeKeys(const std::shared_ptr<Array>& array, MemoryPool* pool,
+    std::shared_ptr<Array>* out) {
+  switch (array->type_id()) {
+    case Type::FLOAT:
+      return NormalizeFloatingKeys<float>(*array, pool, out);
+    case Type::DOUBLE:
+      return NormalizeFloatingKeys<double>(*array, pool, out);
+    case Type::DICTIONARY: {
+      const auto& dict_type = static_cast<const DictionaryType&>(*array->type());
+      std::shared_ptr<Array> normalized;
+      RETURN_NOT_OK(NormalizeKeys(dict_type.dictionary(), pool, &normalized));
+      if (normalized == dict_type.dictionary()) {
+        *out = array;
+      } else {
+        *out = std::make_shared<DictionaryArray>(
+            std::make_shared<DictionaryType>(
+                dict_type.index_type(), normalized, dict_type.ordered()),
+            static_cast<const DictionaryArray&>(*array).indices());
+      }
+      return Status::OK();
+    }
+    default:
+      *out = array;
+      return Status::OK();
+  }
+}
+
+// One key column of a batch, resolved to the array holding its values
+struct KeyInput {
+  // The column, normalized for hashing
+  std::shared_ptr<Array> array;
+  // The column itself, or its dictionary if dictionary-encoded
+  const Array* values;
+  // Start of the fixed-width values, accounting for the slice offset
+  const uint8_t* raw_values;
+  // Dictionary position of every row, -1 for null indices. Empty unless the
+  // column is dictionary-encoded
+  std::vector<int64_t> positions;
+  int64_t length;
+
+  // Position of a row in values, or -1 if the row is null
+  int64_t Position(int64_t row) const {
+    const int64_t position = positions.empty() ? row : positions[row];
+    return (position < 0 || values->IsNull(position)) ? -1 : position;
+  }
+};
+
+class KeyColumn {
+ public:
+  KeyColumn(const std::shared_ptr<DataType>& type, int32_t byte_width, MemoryPool* pool)
+      : type_(type), byte_width_(byte_width), pool_(pool), valid_(pool) {}
+
+  virtual ~KeyColumn() = default;
+
+  /// \brief Resolve a batch column for hashing and comparison.
+  /// Dictionary-encoded columns are mapped to positions in their dictionary
+  Status Bind(const Array& array, KeyInput* input) const {
+    if (array.type_id() == Type::DICTIONARY) {
+      const auto& dict_array = static_cast<const DictionaryArray&>(array);
+      const auto& dict_type = static_cast<const DictionaryType&>(*array.type());
+      input->values = dict_type.dictionary().get();
+      input->positions.resize(array.length());
+      const Array& indices = *dict_array.indices();
+      switch (indices.type_id()) {
+        case Type::INT8:
+          DictionaryPositions<Int8Type>(indices, input->positions.data());
+          break;
+        case Type::INT16:
+          DictionaryPositions<Int16Type>(indices, input->positions.data());
+          break;
+        case Type::INT32:
+          DictionaryPositions<Int32Type>(indices, input->positions.data());
+          break;
+        case Type::INT64:
+          DictionaryPositions<Int64Type>(indices, input->positions.data());
+          break;
+        default:
+          return Status::NotImplemented("Dictionary indices must be signed integers");
+      }
+    } else {
+      input->values = &array;
+      input->positions.clear();
+    }
+    input->length = array.length();
+    input->raw_values = nullptr;
+    // Empty and all-null arrays may have no values buffer, no value being
+    // read from them then
+    const Array& values = *input->values;
+    if (byte_width_ > 0 && values.data()->buffers[1]) {
+      input->raw_values =
+          values.data()->buffers[1]->data() + values.offset() * byte_width_;
+    }
+    return Status::OK();
+  }
+
+  bool Equals(const KeyInput& input, int32_t id, int64_t row) const {
+    const int64_t position = input.Position(row);
+    const bool key_valid = valid_.data()[id] != 0;
+    if (position < 0 || !key_valid) { return position < 0 && !key_valid; }
+    return ValueEquals(input, id, position);
+  }
+
+  Status Append(const KeyInput& input, int64_t row) {
+    const int64_t position = input.Position(row);
+    const uint8_t valid = position >= 0;
+    RETURN_NOT_OK(valid_.Append(&valid, 1));
+    return AppendValue(input, position);
+  }
+
+  /// \brief Produce the stored keys and clear the column
+  Status Finish(std::shared_ptr<Array>* out) {
+    const int64_t length = valid_.size();
+    std::vector<std::shared_ptr<Buffer>> buffers(1);
+    int64_t null_count;
+    RETURN_NOT_OK(BytesToBitmap(pool_, valid_.data(), length, &buffers[0], &null_count));
+    valid_.Reset();
+    RETURN_NOT_OK(FinishValues(&buffers));
+    auto result = std::make_shared<internal::ArrayData>(
+        type_, length, std::move(buffers), null_count);
+    return internal::MakeArray(result, out);
+  }
+
+  int64_t memory_usage() const { return valid_.memory_usage() + values_memory_usage(); }
+
+ protected:
+  virtual bool ValueEquals(const KeyInput& input, int32_t id, int64_t position) const = 0;
+  // position is -1 for a null key
+  virtual Status AppendValue(const KeyInput& input, int64_t position) = 0;
+  virtual Status FinishValues(std::vector<std::shared_ptr<Buffer>>* buffers) = 0;
+  virtual int64_t values_memory_usage() const = 0;
+
+  std::shared_ptr<DataType> type_;
+  // Zero for variable-width keys
+  int32_t byte_width_;
+  MemoryPool* pool_;
+  StateVector<uint8_t> valid_;
+};
+
+// Keys of 1, 2, 4 or 8 bytes, compared as integers
+template <typename T>
+class IntegerKeyColumn : public KeyColumn {
+ public:
+  IntegerKeyColumn(const std::shared_ptr<DataType>& type, MemoryPool* pool)
+      : KeyColumn(type, sizeof(T), pool), keys_(pool) {}
+
+ protected:
+  bool ValueEquals(const KeyInput& input, int32_t id, int64_t position) const override {
+    return keys_.data()[id] == reinterpret_cast<const T*>(input.raw_values)[position];
+  }
+
+  Status AppendValue(const KeyInput& input, int64_t position) override {
+    const T value = position < 0
+                        ? static_cast<T>(0)
+                        : reinterpret_cast<const T*>(input.raw_values)[position];
+    return keys_.Append(&value, 1);
+  }
+
+  Status FinishValues(std::vector<std::shared_ptr<Buffer>>* buffers) override {
+    buffers->push_back(keys_.Finish());
+    return Status::OK();
+  }
+
+  int64_t values_memory_usage() const override { return keys_.memory_usage(); }
+
+ private:
+  StateVector<T> keys_;
+};
+
+// Keys of any other fixed width, compared bytewise
+class FixedWidthKeyColumn : public KeyColumn {
+ public:
+  FixedWidthKeyColumn(
+      const std::shared_ptr<DataType>& type, int32_t byte_width, MemoryPool* pool)
+      : KeyColumn(type, byte_width, pool), keys_(pool) {}
+
+ protected:
+  bool ValueEquals(const KeyInput& input, int32_t id, int64_t position) const override {
+    const uint8_t* key = keys_.data() + id * byte_width_;
+    return memcmp(key, input.raw_values + position * byte_width_, byte_width_) == 0;
+  }
+
+  Status AppendValue(const KeyInput& input, int64_t position) override {
+    const int64_t old_size = keys_.size();
+    RETURN_NOT_OK(keys_.Resize(old_size + byte_width_, 0));
+    if (position >= 0) {
+      memcpy(keys_.data() + old_size, input.raw_values + position * byte_width_,
+          byte_width_);
+    }
+    return Status::OK();
+  }
+
+  Status FinishValues(std::vector<std::shared_ptr<Buffer>>* buffers) override {
+    buffers->push_back(keys_.Finish());
+    return Status::OK();
+  }
+
+  int64_t values_memory_usage() const override { return keys_.memory_usage(); }
+
+ private:
+  StateVector<uint8_t> keys_;
+};
+
+class BinaryKeyColumn : public KeyColumn {
+ public:
+  BinaryKeyColumn(const std::shared_ptr<DataType>& type, MemoryPool* pool)
+      : KeyColumn(type, 0, pool), offsets_(pool), data_(pool) {}
+
+ protected:
+  bool ValueEquals(const KeyInput& input, int32_t id, int64_t position) const override {
+    const int32_t* offsets = offsets_.data();
+    int32_t nbytes;
+    const uint8_t* value =
+        static_cast<const BinaryArray&>(*input.values).GetValue(position, &nbytes);
+    return offsets[id + 1] - offsets[id] == nbytes &&
+           memcmp(data_.data() + offsets[id], value, nbytes) == 0;
+  }
+
+  Status AppendValue(const KeyInput& input, int64_t position) override {
+    RETURN_NOT_OK(EnsureFirstOffset());
+    if (position >= 0) {
+      int32_t nbytes;
+      const uint8_t* value =
+          static_cast<const BinaryArray&>(*input.values).GetValue(position, &nbytes);
+      if (data_.size() + nbytes > std::numeric_limits<int32_t>::max()) {
+        return Status::Invalid("Keys exceed the maximum binary array size");
+      }
+      RETURN_NOT_OK(data_.Append(value, nbytes));
+    }
+    const int32_t end = static_cast<int32_t>(data_.size());
+    return offsets_.Append(&end, 1);
+  }
+
+  Status FinishValues(std::vector<std::shared_ptr<Buffer>>* buffers) override {
+    RETURN_NOT_OK(EnsureFirstOffset());
+    buffers->push_back(offsets_.Finish());
+    buffers->push_back(data_.Finish());
+    return Status::OK();
+  }
+
+  int64_t values_memory_usage() const override {
+    return offsets_.memory_usage() + data_.memory_usage();
+  }
+
+ private:
+  Status EnsureFirstOffset() {
+    if (offsets_.size() > 0) { return Status::OK(); }
+    const int32_t zero = 0;
+    return offsets_.Append(&zero, 1);
+  }
+
+  StateVector<int32_t> offsets_;
+  StateVector<uint8_t> data_;
+};
+
+static Status MakeKeyColumn(const std::shared_ptr<DataType>& type, MemoryPool* pool,
+    std::unique_ptr<KeyColumn>* out) {
+  const Type::type type_id = type->id();
+  if (type_id == Type::BINARY || type_id == Type::STRING) {
+    out->reset(new BinaryKeyColumn(type, pool));
+    return Status::OK();
+  }
+  if (type_id == Type::FIXED_SIZE_BINARY || type_id == Type::DECIMAL ||
+      (is_primitive(type_id) && type_id != Type::BOOL && type_id != Type::NA)) {
+    const int bit_width = static_cast<const FixedWidthType&>(*type).bit_width();
+    switch (bit_width) {
+      case 8:
+        out->reset(new IntegerKeyColumn<uint8_t>(type, pool));
+        break;
+      case 16:
+        out->reset(new IntegerKeyColumn<uint16_t>(type, pool));
+        break;
+      case 32:
+        out->reset(new IntegerKeyColumn<uint32_t>(type, pool));
+        break;
+      case 64:
+        out->reset(new IntegerKeyColumn<uint64_t>(type, pool));
+        break;
+      default:
+        out->reset(new FixedWidthKeyColumn(type, bit_width / 8, pool));
+        break;
+    }
+    return Status::OK();
+  }
+  std::stringstream ss;
+  ss << "Hashing " << type->ToString() << " keys is not supported";
+  return Status::NotImplemented(ss.str());
+}
+
+// ----------------------------------------------------------------------
+// KeyHashTable implementation
+
+class KeyHashTable::KeyHashTableImpl {
+ public:
+  static constexpr int32_t kEmptySlot = -1;
+  static constexpr int64_t kInitialCapacity = 1024;
+
+  // Rows ahead whose table slot is prefetched while probing
+  static constexpr int64_t kPrefetchDistance = 16;
+
+  explicit KeyHashTableImpl(MemoryPool* pool)
+      : pool_(pool), capacity_(0), size_(0), key_hashes_(pool) {}
+
+  Status Init(const std::vector<std::shared_ptr<DataType>>& key_types) {
+    if (key_types.empty()) { return Status::Invalid("No key columns given"); }
+    for (const auto& type : key_types) {
+      std::unique_ptr<KeyColumn> key;
+      RETURN_NOT_OK(MakeKeyColumn(type, pool_, &key));
+      keys_.push_back(std::move(key));
+    }
+    return AllocateSlots(kInitialCapacity);
+  }
+
+  Status GetOrInsert(
+      const std::vector<std::shared_ptr<Array>>& keys, int64_t length, int32_t* ids) {
+    std::vector<KeyInput> inputs;
+    std::vector<uint64_t> hashes;
+    RETURN_NOT_OK(HashKeys(keys, length, &inputs, &hashes));
+
+    for (int64_t row = 0; row < length; ++row) {
+      const uint64_t mask = static_cast<uint64_t>(capacity_ - 1);
+      Slot* table = slots();
+      Prefetch(table, hashes, row, length, mask);
+      const uint64_t hash = hashes[row];
+      uint64_t index = hash & mask;
+      while (true) {
+        const Slot& slot = table[index];
+        if (slot.id == kEmptySlot) {
+          if (size_ == std::numeric_limits<int32_t>::max()) {
+            return Status::Invalid("Too many distinct keys");
+          }
+          const int32_t id = static_cast<int32_t>(size_++);
+          table[index].hash = hash;
+          table[index].id = id;
+          for (size_t i = 0; i < keys_.size(); ++i) {
+            RETURN_NOT_OK(keys_[i]->Append(inputs[i], row));
+          }
+          RETURN_NOT_OK(key_hashes_.Append(&hash, 1));
+          ids[row] = id;
+          // Keep the load factor at or below one half
+          if (size_ * 2 > capacity_) { RETURN_NOT_OK(Grow()); }
+          break;
+        }
+        if (slot.hash == hash && KeysEqual(inputs, slot.id, row)) {
+          ids[row] = slot.id;
+          break;
+        }
+        index = (index + 1) & mask;
+      }
+    }
+    return Status::OK();
+  }
+
+  Status Lookup(const std::vector<std::shared_ptr<Array>>& keys, int64_t length,
+      int32_t* ids) const {
+    std::vector<KeyInput> inputs;
+    std::vector<uint64_t> hashes;
+    RETURN_NOT_OK(HashKeys(keys, length, &inputs, &hashes));
+
+    const uint64_t mask = static_cast<uint64_t>(capacity_ - 1);
+    const Slot* table = slots();
+    for (int64_t row = 0; row < length; ++row) {
+      Prefetch(table, hashes, row, length, mask);
+      const uint64_t hash = hashes[row];
+      uint64_t index = hash & mask;
+      ids[row] = kEmptySlot;
+      while (table[index].id != kEmptySlot) {
+        const Slot& slot = table[index];
+        if (slot.hash == hash && KeysEqual(inputs, slot.id, row)) {
+          ids[row] = slot.id;
+          break;
+        }
+        index = (index + 1) & mask;
+      }
+    }
+    return Status::OK();
+  }
+
+  Status Finish(std::vector<std::shared_ptr<Array>>* out) {
+    for (const auto& key : keys_) {
+      std::shared_ptr<Array> column;
+      RETURN_NOT_OK(key->Finish(&column));
+      out->push_back(column);
+    }
+    size_ = 0;
+    key_hashes_.Reset();
+    return AllocateSlots(kInitialCapacity);
+  }
+
+  int64_t size() const { return size_; }
+
+  const uint64_t* key_hashes() const { return key_hashes_.data(); }
+
+  int64_t memory_usage() const {
+    int64_t total =
+        capacity_ * static_cast<int64_t>(sizeof(Slot)) + key_hashes_.memory_usage();
+    for (const auto& key : keys_) {
+      total += key->memory_usage();
+    }
+    return total;
+  }
+
+ private:
+  struct Slot {
+    uint64_t hash;
+    int32_t id;
+  };
+
+  Slot* slots() { return reinterpret_cast<Slot*>(slots_->mutable_data()); }
+  const Slot* slots() const { return reinterpret_cast<const Slot*>(slots_->data()); }
+
+  Status AllocateSlots(int64_t capacity) {
+    auto buffer = std::make_shared<PoolBuffer>(pool_);
+    RETURN_NOT_OK(buffer->Resize(capacity * sizeof(Slot)));
+    Slot* new_slots = reinterpret_cast<Slot*>(buffer->mutable_data());
+    for (int64_t i = 0; i < capacity; ++i) {
+      new_slots[i].id = kEmptySlot;
+    }
+    slots_ = buffer;
+    capacity_ = capacity;
+    return Status::OK();
+  }
+
+  // Double the capacity, reinserting every key from its stored hash
+  Status Grow() {
+    RETURN_NOT_OK(AllocateSlots(capacity_ * 2));
+    const uint64_t mask = static_cast<uint64_t>(capacity_ - 1);
+    Slot* table = slots();
+    const uint64_t* hashes = key_hashes_.data();
+    for (int32_t id = 0; id < size_; ++id) {
+      uint64_t index = hashes[id] & mask;
+      while (table[index].id != kEmptySlot) {
+        index = (index + 1) & mask;
+      }
+      table[index].hash = hashes[id];
+      table[index].id = id;
+    }
+    return Status::OK();
+  }
+
+  Status HashKeys(const std::vector<std::shared_ptr<Array>>& keys, int64_t length,
+      std::vector<KeyInput>* inputs, std::vector<uint64_t>* hashes) const {
+    if (keys.size() != keys_.size()) {
+      return Status::Invalid("Wrong number of key columns");
+    }
+    inputs->resize(keys_.size());
+    hashes->resize(length);
+    for (size_t i = 0; i < keys_.size(); ++i) {
+      KeyInput& input = (*inputs)[i];
+      RETURN_NOT_OK(NormalizeKeys(keys[i], pool_, &input.array));
+      RETURN_NOT_OK(keys_[i]->Bind(*input.array, &input));
+      if (i == 0) {
+        RETURN_NOT_OK(HashUtil::HashArray(*input.array, hashes->data(), kHashSeed));
+      } else {
+        RETURN_NOT_OK(HashUtil::CombineHashArray(*input.array, hashes->data()));
+      }
+    }
+    return Status::OK();
+  }
+
+  static void Prefetch(const Slot* table, const std::vector<uint64_t>& hashes,
+      int64_t row, int64_t length, uint64_t mask) {
+#if defined(__GNUC__)
+    if (row + kPrefetchDistance < length) {
+      __builtin_prefetch(&table[hashes[row + kPrefetchDistance] & mask]);
+    }
+#endif
+  }
+
+  bool KeysEqual(const std::vector<KeyInput>& inputs, int32_t id, int64_t row) const {
+    for (size_t i = 0; i < keys_.size(); ++i) {
+      if (!keys_[i]->Equals(inputs[i], id, row)) { return false; }
+    }
+    return true;
+  }
+
+  MemoryPool* pool_;
+  std::vector<std::unique_ptr<KeyColumn>> keys_;
+
+  std::shared_ptr<PoolBuffer> slots_;
+  int64_t capacity_;
+  int64_t size_;
+  StateVector<uint64_t> key_hashes_;
+};
+
+constexpr int32_t KeyHashTable::KeyHashTableImpl::kEmptySlot;
+constexpr int64_t KeyHashTable::KeyHashTableImpl::kInitialCapacity;
+constexpr int64_t KeyHashTable::KeyHashTableImpl::kPrefetchDistance;
+
+KeyHashTable::KeyHashTable() {}
+
+KeyHashTable::~KeyHashTable() {}
+
+Status KeyHashTable::Make(const std::vector<std::shared_ptr<DataType>>& key_types,
+    MemoryPool* pool, std::unique_ptr<KeyHashTable>* out) {
+  std::unique_ptr<KeyHashTable> result(new KeyHashTable());
+  result->impl_.reset(new KeyHashTableImpl(pool));
+  RETURN_NOT_OK(result->impl_->Init(key_types));
+  *out = std::move(result);
+  return Status::OK();
+}
+
+Status KeyHashTable::GetOrInsert(
+    const std::vector<std::shared_ptr<Array>>& keys, int64_t length, int32_t* ids) {
+  return impl_->GetOrInsert(keys, length, ids);
+}
+
+Status KeyHashTable::Lookup(const std::vector<std::shared_ptr<Array>>& keys,
+    int64_t length, int32_t* ids) const {
+  return impl_->Lookup(keys, length, ids);
+}
+
+int64_t KeyHashTable::size() const { return impl_->size(); }
+
+const uint64_t* KeyHashTable::key_hashes() const { return impl_->key_hashes(); }
+
+int64_t KeyHashTable::memory_usage() const { return impl_->memory_usage(); }
+
+Status KeyHashTable::Finish(std::vector<std::shared_ptr<Array>>* out) {
+  return impl_->Finish(out);
+}
+
+}  // namespace compute
+}  // namespace arrow
@@ -0,0 +1,98 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Hash table over the rows of one or more key columns, shared by the hash
+// aggregation and hash join operators
+
+#ifndef ARROW_COMPUTE_HASH_TABLE_H
+#define ARROW_COMPUTE_HASH_TABLE_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "arrow/util/visibility.h"
+
+namespace arrow {
+
+class Array;
+class DataType;
+class MemoryPool;
+class Status;
+
+namespace compute {
+
+/// \class KeyHashTable
+/// \brief Assigns dense ids to the distinct rows of a set of key columns
+///
+/// Each key column of a batch is hashed column-at-a-time; rows are then
+/// resolved against an open-addressing table with linear probing, which
+/// stores the hash of every key next to its id. The distinct keys themselves
+/// are stored column-wise.
+///
+/// Keys may be integers, temporal types, fixed size binary, binary, strings
+/// or dictionary-encoded versions of those; dictionary-encoded input is
+/// matched on its dictionary values. Null keys compare equal to each other.
+class ARROW_EXPORT KeyHashTable {
+ public:
+  ~KeyHashTable();
+
+  /// \brief Create an empty table
+  ///
+  /// \param[in] key_types the (non-dictionary) types of the key columns
+  /// \param[in] pool memory pool for the table and the keys
+  /// \param[out] out the created table
+  /// \return Status
+  static Status Make(const std::vector<std::shared_ptr<DataType>>& key_types,
+      MemoryPool* pool, std::unique_ptr<KeyHashTable>* out);
+
+  /// \brief Compute the id of every row, inserting the keys not seen before.
+  /// New keys receive consecutive ids in order of first appearance
+  Status GetOrInsert(
+      const std::vector<std::shared_ptr<Array>>& keys, int64_t length, int32_t* ids);
+
+  /// \brief Compute the id of every row, or -1 for keys not in the table
+  ///
+  /// Lookup does not modify the table and may be called from several threads
+  /// at once, provided no thread inserts at the same time
+  Status Lookup(const std::vector<std::shared_ptr<Array>>& keys, int64_t length,
+      int32_t* ids) const;
+
+  /// \return the number of distinct keys
+  int64_t size() const;
+
+  /// \return the hash of every distinct key, indexed by id
+  const uint64_t* key_hashes() const;
+
+  /// \return the approximate number of bytes held by the table
+  int64_t memory_usage() const;
+
+  /// \brief Produce one array per key column holding the distinct keys in id
+  /// order, and clear the table
+  Status Finish(std::vector<std::shared_ptr<Array>>* out);
+
+ private:
+  KeyHashTable();
+
+  class ARROW_NO_EXPORT KeyHashTableImpl;
+  std::unique_ptr<KeyHashTableImpl> impl_;
+};
+
+}  // namespace compute
+}  // namespace arrow
+
+#endif  // ARROW_COMPUTE_HASH_TABLE_H
@@ -0,0 +1,162 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/compute/string-kernels.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/test-util.h"
+#include "arrow/type.h"
+
+namespace arrow {
+namespace compute {
+
+typedef Status (*MatchKernel)(
+    MemoryPool*, const Array&, const std::string&, std::shared_ptr<Array>*);
+
+class TestStringKernels : public ::testing::Test {
+ public:
+  void SetUp() {
+    ArrayFromVector<StringType, std::string>({true, true, false, true, true, true},
+        {"apple", "", "", "pineapple", "Apple Pie", "grape"}, &values_);
+  }
+
+  void CheckMatch(MatchKernel kernel, const std::shared_ptr<Array>& values,
+      const std::string& pattern, const std::vector<bool>& expected_values) {
+    std::vector<bool> is_valid;
+    for (int64_t i = 0; i < values->length(); ++i) {
+      is_valid.push_back(!values->IsNull(i));
+    }
+    std::shared_ptr<Array> expected, result;
+    ArrayFromVector<BooleanType, bool>(is_valid, expected_values, &expected);
+    ASSERT_OK(kernel(default_memory_pool(), *values, pattern, &result));
+    ASSERT_TRUE(result->Equals(expected)) << "pattern: " << pattern;
+  }
+
+ protected:
+  std::shared_ptr<Array> values_;
+};
+
+TEST_F(TestStringKernels, Length) {
+  std::shared_ptr<Array> expected, result;
+  ArrayFromVector<Int32Type, int32_t>(
+      {true, true, false, true, true, true}, {5, 0, 0, 9, 9, 5}, &expected);
+  ASSERT_OK(Length(default_memory_pool(), *values_, &result));
+  ASSERT_TRUE(result->Equals(expected));
+
+  ASSERT_OK(Length(default_memory_pool(), *values_->Slice(3), &result));
+  ASSERT_TRUE(result->Equals(expected->Slice(3)));
+}
+
+TEST_F(TestStringKernels, StartsWith) {
+  CheckMatch(StartsWith, values_, "app", {true, false, false, false, false, false});
+  CheckMatch(StartsWith, values_, "", {true, true, false, true, true, true});
+  CheckMatch(StartsWith, values_->Slice(2), "pine", {false, true, false, false});
+}
+
+TEST_F(TestStringKernels, Contains) {
+  CheckMatch(Contains, values_, "apple", {true, false, false, true, false, false});
+  CheckMatch(Contains, values_, "p", {true, false, false, true, true, true});
+  CheckMatch(Contains, values_, "", {true, true, false, true, true, true});
+  CheckMatch(Contains, values_, "xyz", {false, false, false, false, false, false});
+
+  // Needles and haystacks longer than a 16-byte SSE block, with partial
+  // matches that straddle block boundaries
+  std::shared_ptr<Array> long_values;
+  ArrayFromVector<StringType, std::string>(
+      {"0123456789abcdef0123456789abcdeX0123456789abcdef0123456789abcdefXY",
+          "0123456789abcdeX0123456789abcdef", "xx0123456789abcdef0123456789abcdef",
+          "0123456789abcde"},
+      &long_values);
+  CheckMatch(Contains, long_values, "0123456789abcdef0123456789abcdef",
+      {true, false, true, false});
+  CheckMatch(Contains, long_values, "efXY", {true, false, false, false});
+  CheckMatch(Contains, long_values, "deX0", {true, true, false, false});
+  CheckMatch(Contains, long_values, "abcdef", {true, true, true, false});
+}
+
+TEST_F(TestStringKernels, Like) {
+  CheckMatch(Like, values_, "apple", {true, false, false, false, false, false});
+  CheckMatch(Like, values_, "%apple", {true, false, false, true, false, false});
+  CheckMatch(Like, values_, "%pie", {false, false, false, false, false, false});
+  CheckMatch(Like, values_, "%Pie", {false, false, false, false, true, false});
+  CheckMatch(Like, values_, "%app%", {true, false, false, true, false, false});
+  CheckMatch(Like, values_, "_pple%", {true, false, false, false, true, false});
+  CheckMatch(Like, values_, "%a%e", {true, false, false, true, false, true});
+  CheckMatch(Like, values_, "p%a%e", {false, false, false, true, false, false});
+  CheckMatch(Like, values_, "_____", {true, false, false, false, false, true});
+  CheckMatch(Like, values_, "%", {true, true, false, true, true, true});
+  CheckMatch(Like, values_, "", {false, true, false, false, false, false});
+  CheckMatch(Like, values_, "%%e", {true, false, false, true, true, true});
+
+  std::shared_ptr<Array> special;
+  ArrayFromVector<StringType, std::string>({"100%", "100", "a_b", "axb"}, &special);
+  CheckMatch(Like, special, "%\\%", {true, false, false, false});
+  CheckMatch(Like, special, "a\\_b", {false, false, true, false});
+  CheckMatch(Like, special, "a_b", {false, false, true, true});
+}
+
+TEST_F(TestStringKernels, CaseFolding) {
+  std::shared_ptr<Array> lower, upper, result;
+  ArrayFromVector<StringType, std::string>({true, true, false, true, true, true},
+      {"apple", "", "", "pineapple", "apple pie", "grape"}, &lower);
+  ArrayFromVector<StringType, std::string>({true, true, false, true, true, true},
+      {"APPLE", "", "", "PINEAPPLE", "APPLE PIE", "GRAPE"}, &upper);
+
+  ASSERT_OK(AsciiLower(default_memory_pool(), *values_, &result));
+  ASSERT_TRUE(result->Equals(lower));
+  ASSERT_OK(AsciiUpper(default_memory_pool(), *values_, &result));
+  ASSERT_TRUE(result->Equals(upper));
+
+  // Sliced input gets fresh offsets
+  ASSERT_OK(AsciiUpper(default_memory_pool(), *values_->Slice(3, 2), &result));
+  ASSERT_TRUE(result->Equals(upper->Slice(3, 2)));
+
+  // Non-ASCII bytes are left alone
+  std::shared_ptr<Array> utf8, expected;
+  ArrayFromVector<StringType, std::string>({"\xc3\x89t\xc3\xa9"}, &utf8);
+  ArrayFromVector<StringType, std::string>({"\xc3\x89T\xc3\xa9"}, &expected);
+  ASSERT_OK(AsciiUpper(default_memory_pool(), *utf8, &result));
+  ASSERT_TRUE(result->Equals(expected));
+}
+
+TEST_F(TestStringKernels, Binary) {
+  std::shared_ptr<Array> values, result, expected;
+  ArrayFromVector<BinaryType, std::string>({"ab\x01", "\x01" "ab"}, &values);
+  ArrayFromVector<BooleanType, bool>({true, false}, &expected);
+  ASSERT_OK(StartsWith(default_memory_pool(), *values, "ab", &result));
+  ASSERT_TRUE(result->Equals(expected));
+}
+
+TEST_F(TestStringKernels, Errors) {
+  std::shared_ptr<Array> values, result;
+  ArrayFromVector<Int32Type, int32_t>({1, 2}, &values);
+  ASSERT_RAISES(Invalid, Length(default_memory_pool(), *values, &result));
+  ASSERT_RAISES(Invalid, Contains(default_memory_pool(), *values, "1", &result));
+  ASSERT_RAISES(Invalid, AsciiLower(default_memory_pool(), *values, &result));
+}
+
+}  // namespace compute
+}  // namespace arrow
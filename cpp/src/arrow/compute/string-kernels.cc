@@ -0,0 +1,438 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/compute/string-kernels.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "arrow/util/dispatch.h"
+
+#ifdef ARROW_HAVE_RUNTIME_SSE4_2
+#include <nmmintrin.h>
+#endif
+
+#include "arrow/array.h"
+#include "arrow/buffer.h"
+#include "arrow/compute/compute-internal.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/type.h"
+#include "arrow/util/bit-util.h"
+#include "arrow/util/logging.h"
+#include "arrow/util/sse-util.h"
+
+namespace arrow {
+namespace compute {
+
+static Status CheckBinary(const Array& values) {
+  if (values.type_id() != Type::BINARY && values.type_id() != Type::STRING) {
+    std::stringstream ss;
+    ss << "String kernels need binary or string input, got "
+       << values.type()->ToString();
+    return Status::Invalid(ss.str());
+  }
+  return Status::OK();
+}
+
+static const uint8_t* ValueData(const BinaryArray& values) {
+  return values.value_data() ? values.value_data()->data() : nullptr;
+}
+
+// Evaluate a predicate over the bytes of every non-null value into a boolean
+// mask. The predicate is called as predicate(const uint8_t* data, int32_t length)
+template <typename Predicate>
+static Status MatchValues(MemoryPool* pool, const Array& values,
+    const Predicate& predicate, std::shared_ptr<Array>* out) {
+  RETURN_NOT_OK(CheckBinary(values));
+  const auto& binary = static_cast<const BinaryArray&>(values);
+  const int64_t length = binary.length();
+
+  std::vector<std::shared_ptr<Buffer>> buffers(2);
+  RETURN_NOT_OK(OutputValidity(pool, values, &buffers[0]));
+  std::shared_ptr<MutableBuffer> bits;
+  RETURN_NOT_OK(GetEmptyBitmap(pool, length, &bits));
+  buffers[1] = bits;
+
+  uint8_t* out_bits = bits->mutable_data();
+  const int32_t* offsets = binary.raw_value_offsets();
+  const uint8_t* data = ValueData(binary);
+  const bool has_nulls = binary.null_count() > 0;
+  for (int64_t i = 0; i < length; ++i) {
+    if (has_nulls && binary.IsNull(i)) { continue; }
+    if (predicate(data + offsets[i], offsets[i + 1] - offsets[i])) {
+      BitUtil::SetBit(out_bits, i);
+    }
+  }
+
+  auto result = std::make_shared<internal::ArrayData>(
+      boolean(), length, std::move(buffers), binary.null_count());
+  return internal::MakeArray(result, out);
+}
+
+// Apply a byte-to-byte function to the data of every value. The offsets of the
+// input are reused when they start at zero
+template <typename Transform>
+static Status TransformValues(MemoryPool* pool, const Array& values,
+    const Transform& transform, std::shared_ptr<Array>* out) {
+  RETURN_NOT_OK(CheckBinary(values));
+  const auto& binary = static_cast<const BinaryArray&>(values);
+  const int64_t length = binary.length();
+
+  std::vector<std::shared_ptr<Buffer>> buffers(3);
+  RETURN_NOT_OK(OutputValidity(pool, values, &buffers[0]));
+
+  const int32_t* offsets = length > 0 ? binary.raw_value_offsets() : nullptr;
+  const int32_t first_offset = length > 0 ? offsets[0] : 0;
+  const int32_t data_length = length > 0 ? offsets[length] - first_offset : 0;
+
+  if (length > 0 && binary.offset() == 0 && first_offset == 0) {
+    buffers[1] = binary.value_offsets();
+  } else {
+    std::shared_ptr<MutableBuffer> out_offsets;
+    RETURN_NOT_OK(AllocateBuffer(pool, (length + 1) * sizeof(int32_t), &out_offsets));
+    auto raw_out_offsets = reinterpret_cast<int32_t*>(out_offsets->mutable_data());
+    raw_out_offsets[0] = 0;
+    for (int64_t i = 0; i < length; ++i) {
+      raw_out_offsets[i + 1] = offsets[i + 1] - first_offset;
+    }
+    buffers[1] = out_offsets;
+  }
+
+  std::shared_ptr<MutableBuffer> data;
+  RETURN_NOT_OK(AllocateBuffer(pool, data_length, &data));
+  if (data_length > 0) {
+    const uint8_t* in = ValueData(binary) + first_offset;
+    uint8_t* out_data = data->mutable_data();
+    // Null slots are transformed too, which keeps this loop branch-free
+    for (int32_t i = 0; i < data_length; ++i) {
+      out_data[i] = transform(in[i]);
+    }
+  }
+  buffers[2] = data;
+
+  auto result = std::make_shared<internal::ArrayData>(
+      values.type(), length, std::move(buffers), binary.null_count());
+  return internal::MakeArray(result, out);
+}
+
+// ----------------------------------------------------------------------
+// Substring search
+
+// The needle is neither empty nor longer than the haystack, and can be read
+// for at least 16 bytes. Bytes of the haystack up to limit, which may be past
+// its end, must be readable
+typedef bool (*FindFunc)(const uint8_t*, int32_t, const uint8_t*, int32_t,
+    const uint8_t*);
+
+// Look for the first byte of the needle, then compare the rest
+static bool FindScalar(const uint8_t* needle, int32_t needle_length,
+    const uint8_t* haystack, int32_t length, const uint8_t* limit) {
+  const int32_t last = length - needle_length;
+  int32_t pos = 0;
+  while (pos <= last) {
+    const void* found = memchr(haystack + pos, needle[0], last - pos + 1);
+    if (found == nullptr) { return false; }
+    pos = static_cast<int32_t>(static_cast<const uint8_t*>(found) - haystack);
+    if (memcmp(haystack + pos, needle, needle_length) == 0) { return true; }
+    ++pos;
+  }
+  return false;
+}
+
+#ifdef ARROW_HAVE_RUNTIME_SSE4_2
+// Locate candidates for the first 16 bytes of the needle one 16-byte block of
+// the haystack at a time, then verify them with memcmp
+static ARROW_TARGET_SSE4_2 bool FindSse42(const uint8_t* needle, int32_t needle_length,
+    const uint8_t* haystack, int32_t length, const uint8_t* limit) {
+  static constexpr int kBlockSize = SSEUtil::CHARS_PER_128_BIT_REGISTER;
+  const __m128i prefix = _mm_loadu_si128(reinterpret_cast<const __m128i*>(needle));
+  const int prefix_length = std::min(needle_length, kBlockSize);
+  const int32_t last = length - needle_length;
+  int32_t pos = 0;
+  while (pos <= last) {
+    const int block_length = std::min(length - pos, kBlockSize);
+    __m128i block;
+    if (haystack + pos + kBlockSize <= limit) {
+      block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + pos));
+    } else {
+      // Do not read past the end of the data buffer
+      uint8_t padded[kBlockSize] = {0};
+      memcpy(padded, haystack + pos, block_length);
+      block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(padded));
+    }
+    const int index =
+        _mm_cmpestri(prefix, prefix_length, block, block_length, SSEUtil::STRSTR_MODE);
+    if (index == kBlockSize) {
+      pos += kBlockSize;
+      continue;
+    }
+    if (pos + index > last) { return false; }
+    if (memcmp(haystack + pos + index, needle, needle_length) == 0) { return true; }
+    pos += index + 1;
+  }
+  return false;
+}
+#endif
+
+static FindFunc GetFind() {
+  static DynamicDispatch<FindFunc> dispatch({
+      {DispatchLevel::NONE, FindScalar},
+#ifdef ARROW_HAVE_RUNTIME_SSE4_2
+      {DispatchLevel::SSE4_2, FindSse42},
+#endif
+  });
+  return dispatch.func;
+}
+
+class SubstringMatcher {
+ public:
+  explicit SubstringMatcher(const std::string& needle)
+      : needle_(needle), needle_length_(static_cast<int32_t>(needle.size())),
+        find_(GetFind()) {
+    // Pad the needle so that its first 16 bytes can always be loaded at once
+    if (needle_length_ < SSEUtil::CHARS_PER_128_BIT_REGISTER) {
+      needle_.resize(SSEUtil::CHARS_PER_128_BIT_REGISTER, '\0');
+    }
+  }
+
+  /// \brief Whether the needle occurs in haystack. Bytes up to limit, which
+  /// may be past the end of haystack, must be readable
+  bool Find(const uint8_t* haystack, int32_t length, const uint8_t* limit) const {
+    if (needle_length_ == 0) { return true; }
+    if (length < needle_length_) { return false; }
+    return find_(reinterpret_cast<const uint8_t*>(needle_.data()), needle_length_,
+        haystack, length, limit);
+  }
+
+ private:
+  std::string needle_;
+  int32_t needle_length_;
+  FindFunc find_;
+};
+
+static bool HasPrefix(
+    const uint8_t* data, int32_t length, const uint8_t* prefix, int32_t prefix_length) {
+  return length >= prefix_length && memcmp(data, prefix, prefix_length) == 0;
+}
+
+static bool HasSuffix(
+    const uint8_t* data, int32_t length, const uint8_t* suffix, int32_t suffix_length) {
+  return length >= suffix_length &&
+         memcmp(data + length - suffix_length, suffix, suffix_length) == 0;
+}
+
+// ----------------------------------------------------------------------
+// LIKE patterns
+
+// A LIKE pattern split on '%' into segments of literal bytes and '_' wildcards
+class LikePattern {
+ public:
+  struct Segment {
+    std::string bytes;
+    // Whether each byte is a '_' wildcard
+    std::vector<uint8_t> wildcard;
+    bool has_wildcard;
+  };
+
+  explicit LikePattern(const std::string& pattern)
+      : anchored_start_(true), anchored_end_(true) {
+    Segment current = {"", {}, false};
+    bool after_percent = false;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+      char c = pattern[i];
+      after_percent = false;
+      if (c == '%') {
+        if (i == 0) { anchored_start_ = false; }
+        if (!current.bytes.empty()) { segments_.push_back(current); }
+        current = {"", {}, false};
+        after_percent = true;
+        continue;
+      }
+      bool wildcard = c == '_';
+      if (c == '\\' && i + 1 < pattern.size()) {
+        c = pattern[++i];
+        wildcard = false;
+      }
+      current.bytes.push_back(c);
+      current.wildcard.push_back(wildcard);
+      current.has_wildcard |= wildcard;
+    }
+    if (after_percent) { anchored_end_ = false; }
+    if (!current.bytes.empty()) { segments_.push_back(current); }
+  }
+
+  const std::vector<Segment>& segments() const { return segments_; }
+  bool anchored_start() const { return anchored_start_; }
+  bool anchored_end() const { return anchored_end_; }
+
+  bool Match(const uint8_t* data, int32_t length) const {
+    const size_t num_segments = segments_.size();
+    int32_t pos = 0;
+    for (size_t k = 0; k < num_segments; ++k) {
+      const Segment& segment = segments_[k];
+      const int32_t segment_length = static_cast<int32_t>(segment.bytes.size());
+      if (k == num_segments - 1 && anchored_end_) {
+        const int32_t start = length - segment_length;
+        if (start < pos || (k == 0 && anchored_start_ && start != 0)) { return false; }
+        return MatchAt(segment, data + start);
+      }
+      if (k == 0 && anchored_start_) {
+        if (length < segment_length || !MatchAt(segment, data)) { return false; }
+        pos = segment_length;
+        continue;
+      }
+      // The leftmost match leaves the most room for the remaining segments
+      while (pos + segment_length <= length && !MatchAt(segment, data + pos)) {
+        ++pos;
+      }
+      if (pos + segment_length > length) { return false; }
+      pos += segment_length;
+    }
+    return !anchored_end_ || pos == length;
+  }
+
+ private:
+  static bool MatchAt(const Segment& segment, const uint8_t* data) {
+    if (!segment.has_wildcard) {
+      return memcmp(data, segment.bytes.data(), segment.bytes.size()) == 0;
+    }
+    for (size_t i = 0; i < segment.bytes.size(); ++i) {
+      if (!segment.wildcard[i] && data[i] != static_cast<uint8_t>(segment.bytes[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::vector<Segment> segments_;
+  bool anchored_start_;
+  bool anchored_end_;
+};
+
+// ----------------------------------------------------------------------
+// Kernels
+
+Status Length(MemoryPool* pool, const Array& values, std::shared_ptr<Array>* out) {
+  RETURN_NOT_OK(CheckBinary(values));
+  const auto& binary = static_cast<const BinaryArray&>(values);
+  const int64_t length = binary.length();
+
+  std::vector<std::shared_ptr<Buffer>> buffers(2);
+  RETURN_NOT_OK(OutputValidity(pool, values, &buffers[0]));
+  std::shared_ptr<MutableBuffer> data;
+  RETURN_NOT_OK(AllocateBuffer(pool, length * sizeof(int32_t), &data));
+  auto lengths = reinterpret_cast<int32_t*>(data->mutable_data());
+  const int32_t* offsets = binary.raw_value_offsets();
+  for (int64_t i = 0; i < length; ++i) {
+    lengths[i] = offsets[i + 1] - offsets[i];
+  }
+  buffers[1] = data;
+
+  auto result = std::make_shared<internal::ArrayData>(
+      int32(), length, std::move(buffers), binary.null_count());
+  return internal::MakeArray(result, out);
+}
+
+Status StartsWith(MemoryPool* pool, const Array& values, const std::string& prefix,
+    std::shared_ptr<Array>* out) {
+  const auto raw_prefix = reinterpret_cast<const uint8_t*>(prefix.data());
+  const auto prefix_length = static_cast<int32_t>(prefix.size());
+  return MatchValues(pool, values,
+      [&](const uint8_t* data, int32_t length) {
+        return HasPrefix(data, length, raw_prefix, prefix_length);
+      },
+      out);
+}
+
+Status Contains(MemoryPool* pool, const Array& values, const std::string& substring,
+    std::shared_ptr<Array>* out) {
+  RETURN_NOT_OK(CheckBinary(values));
+  const auto& binary = static_cast<const BinaryArray&>(values);
+  const uint8_t* limit =
+      binary.value_data() ? ValueData(binary) + binary.value_data()->size() : nullptr;
+  SubstringMatcher matcher(substring);
+  return MatchValues(pool, values,
+      [&](const uint8_t* data, int32_t length) {
+        return matcher.Find(data, length, limit);
+      },
+      out);
+}
+
+Status Like(MemoryPool* pool, const Array& values, const std::string& pattern,
+    std::shared_ptr<Array>* out) {
+  LikePattern like(pattern);
+  const auto& segments = like.segments();
+
+  // Without '_' wildcards, a pattern with at most one segment is a plain
+  // prefix, suffix, substring or equality test
+  if (segments.empty()) {
+    const bool match_all = !like.anchored_start() || !like.anchored_end();
+    return MatchValues(pool, values,
+        [&](const uint8_t* data, int32_t length) { return match_all || length == 0; },
+        out);
+  }
+  if (segments.size() == 1 && !segments[0].has_wildcard) {
+    const std::string& bytes = segments[0].bytes;
+    const auto raw_bytes = reinterpret_cast<const uint8_t*>(bytes.data());
+    const auto bytes_length = static_cast<int32_t>(bytes.size());
+    if (like.anchored_start() && like.anchored_end()) {
+      return MatchValues(pool, values,
+          [&](const uint8_t* data, int32_t length) {
+            return length == bytes_length && memcmp(data, raw_bytes, length) == 0;
+          },
+          out);
+    } else if (like.anchored_start()) {
+      return StartsWith(pool, values, bytes, out);
+    } else if (like.anchored_end()) {
+      return MatchValues(pool, values,
+          [&](const uint8_t* data, int32_t length) {
+            return HasSuffix(data, length, raw_bytes, bytes_length);
+          },
+          out);
+    }
+    return Contains(pool, values, bytes, out);
+  }
+
+  return MatchValues(pool, values,
+      [&](const uint8_t* data, int32_t length) { return like.Match(data, length); },
+      out);
+}
+
+static inline uint8_t AsciiToLower(uint8_t c) {
+  return (c >= 'A' && c <= 'Z') ? static_cast<uint8_t>(c + ('a' - 'A')) : c;
+}
+
+static inline uint8_t AsciiToUpper(uint8_t c) {
+  return (c >= 'a' && c <= 'z') ? static_cast<uint8_t>(c - ('a' - 'A')) : c;
+}
+
+Status AsciiLower(MemoryPool* pool, const Array& values, std::shared_ptr<Array>* out) {
+  return TransformValues(pool, values, AsciiToLower, out);
+}
+
+Status AsciiUpper(MemoryPool* pool, const Array& values, std::shared_ptr<Array>* out) {
+  return TransformValues(pool, values, AsciiToUpper, out);
+}
+
+}  // namespace compute
+}  // namespace arrow
@@ -0,0 +1,109 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Vectorized kernels on binary and string arrays
+
+#ifndef ARROW_COMPUTE_STRING_KERNELS_H
+#define ARROW_COMPUTE_STRING_KERNELS_H
+
+#include <memory>
+#include <string>
+
+#include "arrow/util/visibility.h"
+
+namespace arrow {
+
+class Array;
+class MemoryPool;
+class Status;
+
+namespace compute {
+
+// All kernels accept BinaryArray and StringArray input and work directly on
+// its offsets and data buffers. Null input slots produce null output slots;
+// the validity bitmap of the input is shared with the output when possible.
+
+/// \brief Compute the length in bytes of every value
+///
+/// \param[in] pool memory pool to allocate the result from
+/// \param[in] values binary or string array
+/// \param[out] out an Int32Array of lengths
+/// \return Status
+Status ARROW_EXPORT Length(
+    MemoryPool* pool, const Array& values, std::shared_ptr<Array>* out);
+
+/// \brief Test whether every value starts with prefix
+///
+/// \param[in] pool memory pool to allocate the result from
+/// \param[in] values binary or string array
+/// \param[in] prefix the bytes to look for
+/// \param[out] out a BooleanArray mask
+/// \return Status
+Status ARROW_EXPORT StartsWith(MemoryPool* pool, const Array& values,
+    const std::string& prefix, std::shared_ptr<Array>* out);
+
+/// \brief Test whether every value contains substring
+///
+/// Uses the SSE4.2 string instructions when the CPU supports them.
+///
+/// \param[in] pool memory pool to allocate the result from
+/// \param[in] values binary or string array
+/// \param[in] substring the bytes to look for
+/// \param[out] out a BooleanArray mask
+/// \return Status
+Status ARROW_EXPORT Contains(MemoryPool* pool, const Array& values,
+    const std::string& substring, std::shared_ptr<Array>* out);
+
+/// \brief Test every value against a SQL LIKE pattern
+///
+/// '%' matches any sequence of bytes and '_' matches exactly one byte; a
+/// backslash makes the next character of the pattern match literally.
+/// Patterns that reduce to a prefix, suffix or substring test are dispatched
+/// to the corresponding fast path.
+///
+/// \param[in] pool memory pool to allocate the result from
+/// \param[in] values binary or string array
+/// \param[in] pattern the LIKE pattern
+/// \param[out] out a BooleanArray mask
+/// \return Status
+Status ARROW_EXPORT Like(MemoryPool* pool, const Array& values,
+    const std::string& pattern, std::shared_ptr<Array>* out);
+
+/// \brief Convert the ASCII letters of every value to lower case. Other bytes,
+/// including those of multi-byte UTF-8 sequences, are left unchanged
+///
+/// \param[in] pool memory pool to allocate the result from
+/// \param[in] values binary or string array
+/// \param[out] out an array of the same type as values
+/// \return Status
+Status ARROW_EXPORT AsciiLower(
+    MemoryPool* pool, const Array& values, std::shared_ptr<Array>* out);
+
+/// \brief Convert the ASCII letters of every value to upper case. Other bytes,
+/// including those of multi-byte UTF-8 sequences, are left unchanged
+///
+/// \param[in] pool memory pool to allocate the result from
+/// \param[in] values binary or string array
+/// \param[out] out an array of the same type as values
+/// \return Status
+Status ARROW_EXPORT AsciiUpper(
+    MemoryPool* pool, const Array& values, std::shared_ptr<Array>* out);
+
+}  // namespace compute
+}  // namespace arrow
+
+#endif  // ARROW_COMPUTE_STRING_KERNELS_H
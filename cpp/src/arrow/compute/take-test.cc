@@ -0,0 +1,120 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "arrow/array.h"
+#include "arrow/builder.h"
+#include "arrow/compute/take.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/table.h"
+#include "arrow/test-util.h"
+#include "arrow/type.h"
+
+namespace arrow {
+namespace compute {
+
+class TestTake : public ::testing::Test {
+ public:
+  void CheckTake(const std::shared_ptr<Array>& values,
+      const std::vector<int64_t>& indices, const std::shared_ptr<Array>& expected) {
+    std::shared_ptr<Array> result;
+    ASSERT_OK(Take(default_memory_pool(), *values, indices.data(),
+        static_cast<int64_t>(indices.size()), &result));
+    ASSERT_EQ(expected->length(), result->length());
+    ASSERT_EQ(expected->null_count(), result->null_count());
+    ASSERT_TRUE(result->Equals(expected));
+  }
+};
+
+TEST_F(TestTake, Primitive) {
+  std::shared_ptr<Array> values, expected;
+  ArrayFromVector<Int32Type, int32_t>(
+      {true, false, true, true}, {10, 0, 30, 40}, &values);
+  ArrayFromVector<Int32Type, int32_t>(
+      {true, true, false, false, true}, {40, 10, 0, 0, 30}, &expected);
+  CheckTake(values, {3, 0, 1, -1, 2}, expected);
+
+  // Slices are gathered relative to their offset
+  ArrayFromVector<Int32Type, int32_t>({true, true}, {40, 30}, &expected);
+  CheckTake(values->Slice(2), {1, 0}, expected);
+}
+
+TEST_F(TestTake, Boolean) {
+  std::shared_ptr<Array> values, expected;
+  ArrayFromVector<BooleanType, bool>({true, true, false}, {true, false, false}, &values);
+  ArrayFromVector<BooleanType, bool>(
+      {false, true, true, true}, {false, false, true, true}, &expected);
+  CheckTake(values, {2, 1, 0, 0}, expected);
+}
+
+TEST_F(TestTake, String) {
+  std::shared_ptr<Array> values, expected;
+  ArrayFromVector<StringType, std::string>(
+      {true, false, true}, {"foo", "", "quux"}, &values);
+  ArrayFromVector<StringType, std::string>(
+      {true, true, false, false}, {"quux", "foo", "", ""}, &expected);
+  CheckTake(values, {2, 0, 1, -1}, expected);
+
+  ArrayFromVector<StringType, std::string>({true}, {"quux"}, &expected);
+  CheckTake(values->Slice(1), {1}, expected);
+}
+
+TEST_F(TestTake, Empty) {
+  std::shared_ptr<Array> values, expected;
+  ArrayFromVector<DoubleType, double>({1.5, 2.5}, &values);
+  ArrayFromVector<DoubleType, double>({}, &expected);
+  CheckTake(values, {}, expected);
+}
+
+TEST_F(TestTake, OutOfBounds) {
+  std::shared_ptr<Array> values, result;
+  ArrayFromVector<Int64Type, int64_t>({1, 2, 3}, &values);
+  std::vector<int64_t> indices = {0, 3};
+  ASSERT_RAISES(Invalid, Take(default_memory_pool(), *values, indices.data(),
+                             static_cast<int64_t>(indices.size()), &result));
+}
+
+TEST_F(TestTake, ChunkedArray) {
+  std::shared_ptr<Array> a, b, c, expected;
+  ArrayFromVector<StringType, std::string>({true, false}, {"a", ""}, &a);
+  ArrayFromVector<StringType, std::string>({}, &b);
+  ArrayFromVector<StringType, std::string>({"c", "d", "e"}, &c);
+  // Empty chunks and sliced chunks are skipped over
+  ChunkedArray values({a, b, c->Slice(1)});
+
+  ArrayFromVector<StringType, std::string>(
+      {true, true, false, false, true}, {"e", "a", "", "", "d"}, &expected);
+  std::vector<int64_t> indices = {3, 0, 1, -1, 2};
+  std::shared_ptr<Array> result;
+  ASSERT_OK(Take(default_memory_pool(), values, indices.data(),
+      static_cast<int64_t>(indices.size()), &result));
+  ASSERT_TRUE(result->Equals(expected));
+
+  indices = {4};
+  ASSERT_RAISES(Invalid, Take(default_memory_pool(), values, indices.data(),
+                             static_cast<int64_t>(indices.size()), &result));
+}
+
+}  // namespace compute
+}  // namespace arrow
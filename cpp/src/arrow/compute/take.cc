@@ -0,0 +1,320 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/compute/take.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/buffer.h"
+#include "arrow/compute/dictionary-unifier.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/table.h"
+#include "arrow/type.h"
+#include "arrow/util/bit-util.h"
+
+namespace arrow {
+namespace compute {
+
+// Locators map each output slot to a chunk and a position within that chunk;
+// the chunk is negative for slots that become null because of a negative
+// index. The single array case avoids any precomputation
+
+class ArrayLocator {
+ public:
+  explicit ArrayLocator(const int64_t* indices) : indices_(indices) {}
+
+  int chunk(int64_t i) const { return indices_[i] < 0 ? -1 : 0; }
+  int64_t index(int64_t i) const { return indices_[i]; }
+
+ private:
+  const int64_t* indices_;
+};
+
+class ChunkedLocator {
+ public:
+  ChunkedLocator(
+      const std::vector<const Array*>& chunks, const int64_t* indices, int64_t length)
+      : chunks_(length), positions_(length) {
+    std::vector<int64_t> chunk_offsets(1, 0);
+    for (const Array* chunk : chunks) {
+      chunk_offsets.push_back(chunk_offsets.back() + chunk->length());
+    }
+    for (int64_t i = 0; i < length; ++i) {
+      const int64_t index = indices[i];
+      if (index < 0) {
+        chunks_[i] = -1;
+        continue;
+      }
+      // Index of the last chunk starting at or before index
+      const auto it =
+          std::upper_bound(chunk_offsets.begin() + 1, chunk_offsets.end(), index);
+      chunks_[i] = static_cast<int>(it - chunk_offsets.begin()) - 1;
+      positions_[i] = index - chunk_offsets[chunks_[i]];
+    }
+  }
+
+  int chunk(int64_t i) const { return chunks_[i]; }
+  int64_t index(int64_t i) const { return positions_[i]; }
+
+ private:
+  std::vector<int> chunks_;
+  std::vector<int64_t> positions_;
+};
+
+// Build the validity bitmap of the result. No bitmap is allocated when neither
+// the values nor the indices can produce a null
+template <typename Locator>
+static Status TakeValidity(MemoryPool* pool, const std::vector<const Array*>& chunks,
+    const Locator& locator, int64_t length, std::shared_ptr<Buffer>* out,
+    int64_t* null_count) {
+  bool any_null = false;
+  for (int64_t i = 0; i < length; ++i) {
+    any_null |= locator.chunk(i) < 0;
+  }
+  for (const Array* chunk : chunks) {
+    any_null |= chunk->null_count() > 0;
+  }
+  if (!any_null) {
+    *out = nullptr;
+    *null_count = 0;
+    return Status::OK();
+  }
+
+  std::shared_ptr<MutableBuffer> bitmap;
+  RETURN_NOT_OK(GetEmptyBitmap(pool, length, &bitmap));
+  uint8_t* bits = bitmap->mutable_data();
+  int64_t nulls = 0;
+  for (int64_t i = 0; i < length; ++i) {
+    const int chunk = locator.chunk(i);
+    if (chunk >= 0 && !chunks[chunk]->IsNull(locator.index(i))) {
+      BitUtil::SetBit(bits, i);
+    } else {
+      ++nulls;
+    }
+  }
+  *out = bitmap;
+  *null_count = nulls;
+  return Status::OK();
+}
+
+template <typename T, typename Locator>
+static void TakeFixedWidth(const std::vector<const uint8_t*>& chunk_values,
+    const Locator& locator, int64_t length, uint8_t* out) {
+  T* out_values = reinterpret_cast<T*>(out);
+  for (int64_t i = 0; i < length; ++i) {
+    const int chunk = locator.chunk(i);
+    out_values[i] =
+        chunk >= 0 ? reinterpret_cast<const T*>(chunk_values[chunk])[locator.index(i)]
+                   : static_cast<T>(0);
+  }
+}
+
+template <typename Locator>
+static Status TakeFixedWidthValues(MemoryPool* pool,
+    const std::vector<const Array*>& chunks, const Locator& locator, int64_t length,
+    std::shared_ptr<Buffer>* out) {
+  const auto& type = static_cast<const FixedWidthType&>(*chunks[0]->type());
+  const int bit_width = type.bit_width();
+
+  std::shared_ptr<MutableBuffer> result;
+  if (bit_width == 1) {
+    RETURN_NOT_OK(GetEmptyBitmap(pool, length, &result));
+    uint8_t* out_bits = result->mutable_data();
+    for (int64_t i = 0; i < length; ++i) {
+      const int chunk = locator.chunk(i);
+      if (chunk < 0) { continue; }
+      const Array& values = *chunks[chunk];
+      if (BitUtil::GetBit(
+              values.data()->buffers[1]->data(), locator.index(i) + values.offset())) {
+        BitUtil::SetBit(out_bits, i);
+      }
+    }
+    *out = result;
+    return Status::OK();
+  }
+
+  const int64_t byte_width = bit_width / 8;
+  std::vector<const uint8_t*> chunk_values;
+  for (const Array* chunk : chunks) {
+    // Empty chunks may have no data buffer, nothing is taken from them
+    const auto& data = chunk->data()->buffers[1];
+    chunk_values.push_back(
+        data ? data->data() + chunk->offset() * byte_width : nullptr);
+  }
+
+  RETURN_NOT_OK(AllocateBuffer(pool, length * byte_width, &result));
+  uint8_t* out_data = result->mutable_data();
+  switch (byte_width) {
+    case 1:
+      TakeFixedWidth<uint8_t>(chunk_values, locator, length, out_data);
+      break;
+    case 2:
+      TakeFixedWidth<uint16_t>(chunk_values, locator, length, out_data);
+      break;
+    case 4:
+      TakeFixedWidth<uint32_t>(chunk_values, locator, length, out_data);
+      break;
+    case 8:
+      TakeFixedWidth<uint64_t>(chunk_values, locator, length, out_data);
+      break;
+    default:
+      for (int64_t i = 0; i < length; ++i) {
+        const int chunk = locator.chunk(i);
+        if (chunk >= 0) {
+          memcpy(out_data + i * byte_width,
+              chunk_values[chunk] + locator.index(i) * byte_width, byte_width);
+        } else {
+          memset(out_data + i * byte_width, 0, byte_width);
+        }
+      }
+      break;
+  }
+  *out = result;
+  return Status::OK();
+}
+
+template <typename Locator>
+static Status TakeBinaryValues(MemoryPool* pool, const std::vector<const Array*>& chunks,
+    const Locator& locator, int64_t length, std::shared_ptr<Buffer>* out_offsets,
+    std::shared_ptr<Buffer>* out_data) {
+  std::vector<const BinaryArray*> binary_chunks;
+  for (const Array* chunk : chunks) {
+    binary_chunks.push_back(static_cast<const BinaryArray*>(chunk));
+  }
+
+  std::shared_ptr<MutableBuffer> offsets_buffer;
+  RETURN_NOT_OK(AllocateBuffer(pool, (length + 1) * sizeof(int32_t), &offsets_buffer));
+  int32_t* offsets = reinterpret_cast<int32_t*>(offsets_buffer->mutable_data());
+
+  // First pass computes the output offsets so the data can be allocated once
+  int64_t total_length = 0;
+  for (int64_t i = 0; i < length; ++i) {
+    offsets[i] = static_cast<int32_t>(total_length);
+    const int chunk = locator.chunk(i);
+    if (chunk >= 0 && !binary_chunks[chunk]->IsNull(locator.index(i))) {
+      total_length += binary_chunks[chunk]->value_length(locator.index(i));
+    }
+  }
+  if (total_length > std::numeric_limits<int32_t>::max()) {
+    return Status::Invalid("Take result exceeds the maximum binary array size");
+  }
+  offsets[length] = static_cast<int32_t>(total_length);
+
+  std::shared_ptr<MutableBuffer> data_buffer;
+  RETURN_NOT_OK(AllocateBuffer(pool, total_length, &data_buffer));
+  uint8_t* data = data_buffer->mutable_data();
+  for (int64_t i = 0; i < length; ++i) {
+    const int32_t nbytes = offsets[i + 1] - offsets[i];
+    if (nbytes > 0) {
+      int32_t unused_length;
+      const BinaryArray& values = *binary_chunks[locator.chunk(i)];
+      memcpy(data + offsets[i], values.GetValue(locator.index(i), &unused_length),
+          nbytes);
+    }
+  }
+  *out_offsets = offsets_buffer;
+  *out_data = data_buffer;
+  return Status::OK();
+}
+
+template <typename Locator>
+static Status TakeChunks(MemoryPool* pool, const std::vector<const Array*>& chunks,
+    const Locator& locator, int64_t length, std::shared_ptr<Array>* out) {
+  std::vector<std::shared_ptr<Buffer>> buffers(1);
+  int64_t null_count;
+  RETURN_NOT_OK(TakeValidity(pool, chunks, locator, length, &buffers[0], &null_count));
+
+  const std::shared_ptr<DataType>& type = chunks[0]->type();
+  const Type::type type_id = type->id();
+  if (type_id == Type::BINARY || type_id == Type::STRING) {
+    std::shared_ptr<Buffer> offsets, data;
+    RETURN_NOT_OK(TakeBinaryValues(pool, chunks, locator, length, &offsets, &data));
+    buffers.push_back(offsets);
+    buffers.push_back(data);
+  } else if (type_id == Type::BOOL || type_id == Type::DICTIONARY ||
+             type_id == Type::FIXED_SIZE_BINARY || is_primitive(type_id)) {
+    if (type_id == Type::NA) {
+      return Status::NotImplemented("Take is not implemented for null arrays");
+    }
+    std::shared_ptr<Buffer> data;
+    RETURN_NOT_OK(TakeFixedWidthValues(pool, chunks, locator, length, &data));
+    buffers.push_back(data);
+  } else {
+    std::stringstream ss;
+    ss << "Take is not implemented for type " << type->ToString();
+    return Status::NotImplemented(ss.str());
+  }
+
+  auto result =
+      std::make_shared<internal::ArrayData>(type, length, std::move(buffers), null_count);
+  return internal::MakeArray(result, out);
+}
+
+static Status CheckIndices(const int64_t* indices, int64_t length, int64_t num_values) {
+  for (int64_t i = 0; i < length; ++i) {
+    if (indices[i] >= num_values) {
+      std::stringstream ss;
+      ss << "Take index " << indices[i] << " out of bounds for array of length "
+         << num_values;
+      return Status::Invalid(ss.str());
+    }
+  }
+  return Status::OK();
+}
+
+Status Take(MemoryPool* pool, const Array& values, const int64_t* indices,
+    int64_t length, std::shared_ptr<Array>* out) {
+  RETURN_NOT_OK(CheckIndices(indices, length, values.length()));
+  return TakeChunks(pool, {&values}, ArrayLocator(indices), length, out);
+}
+
+Status Take(MemoryPool* pool, const ChunkedArray& values, const int64_t* indices,
+    int64_t length, std::shared_ptr<Array>* out) {
+  if (values.num_chunks() == 0) {
+    return Status::Invalid("Cannot take from a chunked array without chunks");
+  }
+  if (values.num_chunks() == 1) {
+    return Take(pool, *values.chunk(0), indices, length, out);
+  }
+  RETURN_NOT_OK(CheckIndices(indices, length, values.length()));
+  std::vector<const Array*> chunks;
+  bool same_types = true;
+  for (const auto& chunk : values.chunks()) {
+    chunks.push_back(chunk.get());
+    same_types = same_types && chunk->type()->Equals(*chunks[0]->type());
+  }
+  if (!same_types && chunks[0]->type_id() == Type::DICTIONARY) {
+    // The indices of chunks with different dictionaries only mean the same
+    // once the dictionaries are unified
+    std::shared_ptr<ChunkedArray> unified;
+    RETURN_NOT_OK(UnifyDictionaries(pool, values, &unified));
+    return Take(pool, *unified, indices, length, out);
+  }
+  return TakeChunks(
+      pool, chunks, ChunkedLocator(chunks, indices, length), length, out);
+}
+
+}  // namespace compute
+}  // namespace arrow
@@ -0,0 +1,61 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef ARROW_COMPUTE_TAKE_H
+#define ARROW_COMPUTE_TAKE_H
+
+#include <cstdint>
+#include <memory>
+
+#include "arrow/util/visibility.h"
+
+namespace arrow {
+
+class Array;
+class ChunkedArray;
+class MemoryPool;
+class Status;
+
+namespace compute {
+
+/// \brief Gather the values of an array at the indicated positions into a
+/// new array of the same type
+///
+/// A negative index produces a null slot in the output. Boolean, fixed-width
+/// (including dictionary-encoded) and variable-length binary / string arrays
+/// are supported.
+///
+/// \param[in] pool memory pool to allocate the result from
+/// \param[in] values the array to gather from
+/// \param[in] indices positions into values, relative to any slice offset
+/// \param[in] length the number of indices and the length of the result
+/// \param[out] out the gathered array
+/// \return Status
+Status ARROW_EXPORT Take(MemoryPool* pool, const Array& values, const int64_t* indices,
+    int64_t length, std::shared_ptr<Array>* out);
+
+/// \brief Gather the values of a chunked array into a single contiguous array
+///
+/// Indices address the logical positions of the chunked array, which must
+/// have at least one chunk. Otherwise the same as Take on an Array
+Status ARROW_EXPORT Take(MemoryPool* pool, const ChunkedArray& values,
+    const int64_t* indices, int64_t length, std::shared_ptr<Array>* out);
+
+}  // namespace compute
+}  // namespace arrow
+
+#endif  // ARROW_COMPUTE_TAKE_H
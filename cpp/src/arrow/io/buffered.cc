@@ -0,0 +1,410 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/io/buffered.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "arrow/buffer.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/util/logging.h"
+
+namespace arrow {
+namespace io {
+
+static Status ValidateBufferSize(int64_t buffer_size) {
+  if (buffer_size <= 0) {
+    std::stringstream ss;
+    ss << "Invalid buffer size: " << buffer_size;
+    return Status::Invalid(ss.str());
+  }
+  return Status::OK();
+}
+
+// ----------------------------------------------------------------------
+// BufferedOutputStream implementation
+
+class BufferedOutputStream::BufferedOutputStreamImpl {
+ public:
+  BufferedOutputStreamImpl(MemoryPool* pool, const std::shared_ptr<OutputStream>& raw)
+      : raw_(raw),
+        buffer_(std::make_shared<PoolBuffer>(pool)),
+        buffer_size_(0),
+        buffer_pos_(0),
+        position_(0),
+        is_open_(false) {}
+
+  Status Init(int64_t buffer_size) {
+    RETURN_NOT_OK(raw_->Tell(&position_));
+    RETURN_NOT_OK(SetBufferSize(buffer_size));
+    is_open_ = true;
+    return Status::OK();
+  }
+
+  Status SetBufferSize(int64_t buffer_size) {
+    RETURN_NOT_OK(ValidateBufferSize(buffer_size));
+    if (buffer_pos_ > buffer_size) { RETURN_NOT_OK(WriteBuffered()); }
+    RETURN_NOT_OK(buffer_->Resize(buffer_size));
+    buffer_size_ = buffer_size;
+    return Status::OK();
+  }
+
+  int64_t buffer_size() const { return buffer_size_; }
+
+  int64_t bytes_buffered() const { return buffer_pos_; }
+
+  Status Close() {
+    if (!is_open_) { return Status::OK(); }
+    is_open_ = false;
+    RETURN_NOT_OK(WriteBuffered());
+    return raw_->Close();
+  }
+
+  Status Tell(int64_t* position) {
+    *position = position_;
+    return Status::OK();
+  }
+
+  Status Write(const uint8_t* data, int64_t nbytes) {
+    if (!is_open_) { return Status::IOError("Stream is closed"); }
+    if (nbytes >= buffer_size_) {
+      // Too large to be worth copying
+      RETURN_NOT_OK(WriteBuffered());
+      RETURN_NOT_OK(raw_->Write(data, nbytes));
+    } else {
+      if (buffer_pos_ + nbytes > buffer_size_) { RETURN_NOT_OK(WriteBuffered()); }
+      memcpy(buffer_->mutable_data() + buffer_pos_, data, nbytes);
+      buffer_pos_ += nbytes;
+    }
+    position_ += nbytes;
+    return Status::OK();
+  }
+
+  Status WriteV(const std::vector<WriteRange>& buffers) {
+    if (!is_open_) { return Status::IOError("Stream is closed"); }
+    int64_t nbytes = 0;
+    for (const WriteRange& buffer : buffers) {
+      nbytes += buffer.second;
+    }
+    if (nbytes >= buffer_size_) {
+      std::vector<WriteRange> gathered;
+      gathered.reserve(buffers.size() + 1);
+      if (buffer_pos_ > 0) { gathered.emplace_back(buffer_->data(), buffer_pos_); }
+      gathered.insert(gathered.end(), buffers.begin(), buffers.end());
+      RETURN_NOT_OK(raw_->WriteV(gathered));
+      buffer_pos_ = 0;
+    } else {
+      if (buffer_pos_ + nbytes > buffer_size_) { RETURN_NOT_OK(WriteBuffered()); }
+      for (const WriteRange& buffer : buffers) {
+        memcpy(buffer_->mutable_data() + buffer_pos_, buffer.first, buffer.second);
+        buffer_pos_ += buffer.second;
+      }
+    }
+    position_ += nbytes;
+    return Status::OK();
+  }
+
+  Status Flush() {
+    if (!is_open_) { return Status::IOError("Stream is closed"); }
+    RETURN_NOT_OK(WriteBuffered());
+    return raw_->Flush();
+  }
+
+  std::shared_ptr<OutputStream> raw() const { return raw_; }
+
+ private:
+  Status WriteBuffered() {
+    if (buffer_pos_ > 0) {
+      RETURN_NOT_OK(raw_->Write(buffer_->data(), buffer_pos_));
+      buffer_pos_ = 0;
+    }
+    return Status::OK();
+  }
+
+  std::shared_ptr<OutputStream> raw_;
+
+  std::shared_ptr<PoolBuffer> buffer_;
+  int64_t buffer_size_;
+  int64_t buffer_pos_;
+  // Number of bytes written, including those of raw_ before wrapping it
+  int64_t position_;
+  bool is_open_;
+};
+
+BufferedOutputStream::BufferedOutputStream() {
+  set_mode(FileMode::WRITE);
+}
+
+BufferedOutputStream::~BufferedOutputStream() {
+  // Write out the buffered data if the stream was not closed
+  DCHECK(impl_->Close().ok());
+}
+
+Status BufferedOutputStream::Create(const std::shared_ptr<OutputStream>& raw,
+    int64_t buffer_size, std::shared_ptr<BufferedOutputStream>* out) {
+  return Create(default_memory_pool(), raw, buffer_size, out);
+}
+
+Status BufferedOutputStream::Create(MemoryPool* pool,
+    const std::shared_ptr<OutputStream>& raw, int64_t buffer_size,
+    std::shared_ptr<BufferedOutputStream>* out) {
+  std::shared_ptr<BufferedOutputStream> result(new BufferedOutputStream());
+  result->impl_.reset(new BufferedOutputStreamImpl(pool, raw));
+  RETURN_NOT_OK(result->impl_->Init(buffer_size));
+  *out = result;
+  return Status::OK();
+}
+
+Status BufferedOutputStream::SetBufferSize(int64_t buffer_size) {
+  return impl_->SetBufferSize(buffer_size);
+}
+
+int64_t BufferedOutputStream::buffer_size() const {
+  return impl_->buffer_size();
+}
+
+int64_t BufferedOutputStream::bytes_buffered() const {
+  return impl_->bytes_buffered();
+}
+
+Status BufferedOutputStream::Close() {
+  return impl_->Close();
+}
+
+Status BufferedOutputStream::Tell(int64_t* position) {
+  return impl_->Tell(position);
+}
+
+Status BufferedOutputStream::Write(const uint8_t* data, int64_t nbytes) {
+  return impl_->Write(data, nbytes);
+}
+
+Status BufferedOutputStream::WriteV(const std::vector<WriteRange>& buffers) {
+  return impl_->WriteV(buffers);
+}
+
+Status BufferedOutputStream::Flush() {
+  return impl_->Flush();
+}
+
+std::shared_ptr<OutputStream> BufferedOutputStream::raw() const {
+  return impl_->raw();
+}
+
+// ----------------------------------------------------------------------
+// BufferedInputStream implementation
+
+class BufferedInputStream::BufferedInputStreamImpl {
+ public:
+  BufferedInputStreamImpl(MemoryPool* pool, const std::shared_ptr<InputStream>& raw)
+      : pool_(pool),
+        raw_(raw),
+        buffer_(std::make_shared<PoolBuffer>(pool)),
+        buffer_size_(0),
+        buffer_pos_(0),
+        buffer_end_(0),
+        position_(0),
+        is_open_(false) {}
+
+  Status Init(int64_t buffer_size) {
+    RETURN_NOT_OK(raw_->Tell(&position_));
+    RETURN_NOT_OK(SetBufferSize(buffer_size));
+    is_open_ = true;
+    return Status::OK();
+  }
+
+  Status SetBufferSize(int64_t buffer_size) {
+    RETURN_NOT_OK(ValidateBufferSize(buffer_size));
+    if (bytes_buffered() > buffer_size) {
+      std::stringstream ss;
+      ss << "Cannot shrink the buffer to " << buffer_size << " bytes while "
+         << bytes_buffered() << " bytes are buffered";
+      return Status::Invalid(ss.str());
+    }
+    Compact();
+    RETURN_NOT_OK(buffer_->Resize(buffer_size));
+    buffer_size_ = buffer_size;
+    return Status::OK();
+  }
+
+  int64_t buffer_size() const { return buffer_size_; }
+
+  int64_t bytes_buffered() const { return buffer_end_ - buffer_pos_; }
+
+  Status Close() {
+    if (!is_open_) { return Status::OK(); }
+    is_open_ = false;
+    return raw_->Close();
+  }
+
+  Status Tell(int64_t* position) {
+    *position = position_;
+    return Status::OK();
+  }
+
+  Status Peek(int64_t nbytes, std::shared_ptr<Buffer>* out) {
+    if (!is_open_) { return Status::IOError("Stream is closed"); }
+    nbytes = std::min(nbytes, buffer_size_);
+    if (bytes_buffered() < nbytes) {
+      Compact();
+      while (buffer_end_ < nbytes) {
+        int64_t bytes_read;
+        RETURN_NOT_OK(raw_->Read(buffer_size_ - buffer_end_, &bytes_read,
+            buffer_->mutable_data() + buffer_end_));
+        if (bytes_read == 0) { break; }
+        buffer_end_ += bytes_read;
+      }
+    }
+    *out = SliceBuffer(buffer_, buffer_pos_, std::min(nbytes, bytes_buffered()));
+    return Status::OK();
+  }
+
+  Status Read(int64_t nbytes, int64_t* bytes_read, uint8_t* out) {
+    if (!is_open_) { return Status::IOError("Stream is closed"); }
+    int64_t total = 0;
+    while (nbytes > 0) {
+      if (bytes_buffered() > 0) {
+        const int64_t n = std::min(nbytes, bytes_buffered());
+        memcpy(out, buffer_->data() + buffer_pos_, n);
+        buffer_pos_ += n;
+        out += n;
+        nbytes -= n;
+        total += n;
+        continue;
+      }
+      int64_t n;
+      if (nbytes >= buffer_size_) {
+        // Too large to be worth copying
+        RETURN_NOT_OK(raw_->Read(nbytes, &n, out));
+        out += n;
+        nbytes -= n;
+        total += n;
+      } else {
+        RETURN_NOT_OK(raw_->Read(buffer_size_, &n, buffer_->mutable_data()));
+        buffer_pos_ = 0;
+        buffer_end_ = n;
+      }
+      if (n == 0) { break; }
+    }
+    *bytes_read = total;
+    position_ += total;
+    return Status::OK();
+  }
+
+  Status Read(int64_t nbytes, std::shared_ptr<Buffer>* out) {
+    auto buffer = std::make_shared<PoolBuffer>(pool_);
+    RETURN_NOT_OK(buffer->Resize(nbytes));
+    int64_t bytes_read;
+    RETURN_NOT_OK(Read(nbytes, &bytes_read, buffer->mutable_data()));
+    RETURN_NOT_OK(buffer->Resize(bytes_read));
+    *out = buffer;
+    return Status::OK();
+  }
+
+  std::shared_ptr<InputStream> raw() const { return raw_; }
+
+ private:
+  // Move the buffered data to the start of the buffer
+  void Compact() {
+    if (buffer_pos_ > 0) {
+      memmove(buffer_->mutable_data(), buffer_->data() + buffer_pos_, bytes_buffered());
+      buffer_end_ -= buffer_pos_;
+      buffer_pos_ = 0;
+    }
+  }
+
+  MemoryPool* pool_;
+  std::shared_ptr<InputStream> raw_;
+
+  // Bytes [buffer_pos_, buffer_end_) of buffer_ are read from raw_ but not
+  // yet from this stream
+  std::shared_ptr<PoolBuffer> buffer_;
+  int64_t buffer_size_;
+  int64_t buffer_pos_;
+  int64_t buffer_end_;
+  // Number of bytes read, including those of raw_ before wrapping it
+  int64_t position_;
+  bool is_open_;
+};
+
+BufferedInputStream::BufferedInputStream() {
+  set_mode(FileMode::READ);
+}
+
+BufferedInputStream::~BufferedInputStream() {
+  DCHECK(impl_->Close().ok());
+}
+
+Status BufferedInputStream::Create(const std::shared_ptr<InputStream>& raw,
+    int64_t buffer_size, std::shared_ptr<BufferedInputStream>* out) {
+  return Create(default_memory_pool(), raw, buffer_size, out);
+}
+
+Status BufferedInputStream::Create(MemoryPool* pool,
+    const std::shared_ptr<InputStream>& raw, int64_t buffer_size,
+    std::shared_ptr<BufferedInputStream>* out) {
+  std::shared_ptr<BufferedInputStream> result(new BufferedInputStream());
+  result->impl_.reset(new BufferedInputStreamImpl(pool, raw));
+  RETURN_NOT_OK(result->impl_->Init(buffer_size));
+  *out = result;
+  return Status::OK();
+}
+
+Status BufferedInputStream::SetBufferSize(int64_t buffer_size) {
+  return impl_->SetBufferSize(buffer_size);
+}
+
+int64_t BufferedInputStream::buffer_size() const {
+  return impl_->buffer_size();
+}
+
+int64_t BufferedInputStream::bytes_buffered() const {
+  return impl_->bytes_buffered();
+}
+
+Status BufferedInputStream::Peek(int64_t nbytes, std::shared_ptr<Buffer>* out) {
+  return impl_->Peek(nbytes, out);
+}
+
+Status BufferedInputStream::Close() {
+  return impl_->Close();
+}
+
+Status BufferedInputStream::Tell(int64_t* position) {
+  return impl_->Tell(position);
+}
+
+Status BufferedInputStream::Read(int64_t nbytes, int64_t* bytes_read, uint8_t* out) {
+  return impl_->Read(nbytes, bytes_read, out);
+}
+
+Status BufferedInputStream::Read(int64_t nbytes, std::shared_ptr<Buffer>* out) {
+  return impl_->Read(nbytes, out);
+}
+
+std::shared_ptr<InputStream> BufferedInputStream::raw() const {
+  return impl_->raw();
+}
+
+}  // namespace io
+}  // namespace arrow
@@ -0,0 +1,160 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Buffered stream implementations
+
+#ifndef ARROW_IO_BUFFERED_H
+#define ARROW_IO_BUFFERED_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "arrow/io/interfaces.h"
+#include "arrow/util/visibility.h"
+
+namespace arrow {
+
+class Buffer;
+class MemoryPool;
+class Status;
+
+namespace io {
+
+constexpr int64_t kDefaultBufferSize = 64 * 1024;
+
+/// \brief An output stream gathering small writes into a buffer, so that the
+/// wrapped stream receives writes of about the buffer size
+///
+/// Writes at least as large as the buffer are passed to the wrapped stream
+/// as is, without being copied, once the buffered data has been written out.
+/// Close and Flush write out the buffered data.
+class ARROW_EXPORT BufferedOutputStream : public OutputStream {
+ public:
+  ~BufferedOutputStream();
+
+  /// \brief Wrap an output stream
+  ///
+  /// \param[in] raw the stream receiving the data
+  /// \param[in] buffer_size the size of the buffer, which must be positive
+  /// \param[out] out the buffered output stream
+  static Status Create(const std::shared_ptr<OutputStream>& raw, int64_t buffer_size,
+      std::shared_ptr<BufferedOutputStream>* out);
+
+  static Status Create(MemoryPool* pool, const std::shared_ptr<OutputStream>& raw,
+      int64_t buffer_size, std::shared_ptr<BufferedOutputStream>* out);
+
+  /// \brief Change the size of the buffer, writing out the buffered data
+  /// first if it does not fit in the new size
+  Status SetBufferSize(int64_t buffer_size);
+
+  int64_t buffer_size() const;
+
+  /// \brief Number of bytes written to this stream but not yet to the
+  /// wrapped one
+  int64_t bytes_buffered() const;
+
+  // OutputStream interface
+
+  /// \brief Write out the buffered data and close the wrapped stream
+  Status Close() override;
+
+  Status Tell(int64_t* position) override;
+
+  Status Write(const uint8_t* data, int64_t nbytes) override;
+
+  /// \brief Buffer the buffers if they fit, else write them out after the
+  /// buffered data with a single WriteV on the wrapped stream
+  Status WriteV(const std::vector<WriteRange>& buffers) override;
+
+  /// \brief Write out the buffered data and flush the wrapped stream
+  Status Flush() override;
+
+  std::shared_ptr<OutputStream> raw() const;
+
+ private:
+  BufferedOutputStream();
+
+  class ARROW_NO_EXPORT BufferedOutputStreamImpl;
+  std::unique_ptr<BufferedOutputStreamImpl> impl_;
+};
+
+/// \brief An input stream reading ahead from another input stream by chunks
+/// of the buffer size, so that small reads do not each reach it
+///
+/// Reads at least as large as the buffer, once the buffered data has been
+/// consumed, are passed to the wrapped stream as is.
+class ARROW_EXPORT BufferedInputStream : public InputStream {
+ public:
+  ~BufferedInputStream();
+
+  /// \brief Wrap an input stream
+  ///
+  /// \param[in] raw the stream providing the data
+  /// \param[in] buffer_size the size of the buffer, which must be positive
+  /// \param[out] out the buffered input stream
+  static Status Create(const std::shared_ptr<InputStream>& raw, int64_t buffer_size,
+      std::shared_ptr<BufferedInputStream>* out);
+
+  static Status Create(MemoryPool* pool, const std::shared_ptr<InputStream>& raw,
+      int64_t buffer_size, std::shared_ptr<BufferedInputStream>* out);
+
+  /// \brief Change the size of the buffer
+  ///
+  /// \return Status, Invalid if more than buffer_size bytes are buffered
+  Status SetBufferSize(int64_t buffer_size);
+
+  int64_t buffer_size() const;
+
+  /// \brief Number of bytes read from the wrapped stream but not yet from
+  /// this one
+  int64_t bytes_buffered() const;
+
+  /// \brief Return the next bytes of the stream without consuming them,
+  /// filling the buffer if needed
+  ///
+  /// At most buffer_size bytes are returned, fewer at the end of the stream.
+  /// The returned buffer points into the stream buffer: it is only valid
+  /// until the next call to the stream.
+  ///
+  /// \param[in] nbytes the number of bytes wanted
+  /// \param[out] out the next bytes
+  Status Peek(int64_t nbytes, std::shared_ptr<Buffer>* out);
+
+  // InputStream interface
+
+  /// \brief Close the wrapped stream
+  Status Close() override;
+
+  Status Tell(int64_t* position) override;
+
+  Status Read(int64_t nbytes, int64_t* bytes_read, uint8_t* out) override;
+  Status Read(int64_t nbytes, std::shared_ptr<Buffer>* out) override;
+
+  std::shared_ptr<InputStream> raw() const;
+
+ private:
+  BufferedInputStream();
+
+  class ARROW_NO_EXPORT BufferedInputStreamImpl;
+  std::unique_ptr<BufferedInputStreamImpl> impl_;
+};
+
+}  // namespace io
+}  // namespace arrow
+
+#endif  // ARROW_IO_BUFFERED_H
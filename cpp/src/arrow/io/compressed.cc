@@ -0,0 +1,377 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/io/compressed.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include "arrow/buffer.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/util/compression.h"
+#include "arrow/util/logging.h"
+
+namespace arrow {
+namespace io {
+
+// Initial size of the buffers of compressed and decompressed data. They are
+// grown if a codec cannot make progress with less
+static constexpr int64_t kChunkSize = 64 * 1024;
+
+// ----------------------------------------------------------------------
+// CompressedOutputStream implementation
+
+class CompressedOutputStream::CompressedOutputStreamImpl {
+ public:
+  CompressedOutputStreamImpl(
+      MemoryPool* pool, Codec* codec, const std::shared_ptr<OutputStream>& raw)
+      : codec_(codec),
+        raw_(raw),
+        compressed_(std::make_shared<PoolBuffer>(pool)),
+        compressed_pos_(0),
+        total_pos_(0),
+        is_open_(false) {}
+
+  Status Init() {
+    RETURN_NOT_OK(codec_->MakeCompressor(&compressor_));
+    RETURN_NOT_OK(compressed_->Resize(kChunkSize));
+    is_open_ = true;
+    return Status::OK();
+  }
+
+  Status Close() {
+    if (!is_open_) { return Status::OK(); }
+    is_open_ = false;
+    RETURN_NOT_OK(FinishCompression(true));
+    return raw_->Close();
+  }
+
+  Status Tell(int64_t* position) {
+    *position = total_pos_;
+    return Status::OK();
+  }
+
+  Status Write(const uint8_t* data, int64_t nbytes) {
+    if (!is_open_) { return Status::IOError("Stream is closed"); }
+    while (nbytes > 0) {
+      int64_t bytes_read, bytes_written;
+      RETURN_NOT_OK(compressor_->Compress(nbytes, data,
+          compressed_->size() - compressed_pos_,
+          compressed_->mutable_data() + compressed_pos_, &bytes_read, &bytes_written));
+      compressed_pos_ += bytes_written;
+      data += bytes_read;
+      nbytes -= bytes_read;
+      total_pos_ += bytes_read;
+      if (bytes_read == 0 || compressed_pos_ == compressed_->size()) {
+        RETURN_NOT_OK(MakeRoom());
+      }
+    }
+    return Status::OK();
+  }
+
+  Status Flush() {
+    if (!is_open_) { return Status::IOError("Stream is closed"); }
+    RETURN_NOT_OK(FinishCompression(false));
+    return raw_->Flush();
+  }
+
+  std::shared_ptr<OutputStream> raw() const { return raw_; }
+
+ private:
+  // Write out the data retained by the compressor, ending the compressed
+  // stream if end is true
+  Status FinishCompression(bool end) {
+    bool should_retry = true;
+    while (should_retry) {
+      const int64_t output_len = compressed_->size() - compressed_pos_;
+      uint8_t* output = compressed_->mutable_data() + compressed_pos_;
+      int64_t bytes_written;
+      if (end) {
+        RETURN_NOT_OK(
+            compressor_->End(output_len, output, &bytes_written, &should_retry));
+      } else {
+        RETURN_NOT_OK(
+            compressor_->Flush(output_len, output, &bytes_written, &should_retry));
+      }
+      compressed_pos_ += bytes_written;
+      if (should_retry) { RETURN_NOT_OK(MakeRoom()); }
+    }
+    return WriteCompressed();
+  }
+
+  // Called when the compressor needs more output space: write out the
+  // compressed data, or grow the buffer if it is empty already
+  Status MakeRoom() {
+    if (compressed_pos_ > 0) { return WriteCompressed(); }
+    return compressed_->Resize(compressed_->size() * 2);
+  }
+
+  Status WriteCompressed() {
+    if (compressed_pos_ > 0) {
+      RETURN_NOT_OK(raw_->Write(compressed_->data(), compressed_pos_));
+      compressed_pos_ = 0;
+    }
+    return Status::OK();
+  }
+
+  Codec* codec_;
+  std::shared_ptr<OutputStream> raw_;
+  std::shared_ptr<Compressor> compressor_;
+
+  std::shared_ptr<PoolBuffer> compressed_;
+  int64_t compressed_pos_;
+  // Number of uncompressed bytes written
+  int64_t total_pos_;
+  bool is_open_;
+};
+
+CompressedOutputStream::CompressedOutputStream() {
+  set_mode(FileMode::WRITE);
+}
+
+CompressedOutputStream::~CompressedOutputStream() {
+  // Complete the compressed stream if it was not closed
+  DCHECK(impl_->Close().ok());
+}
+
+Status CompressedOutputStream::Open(Codec* codec,
+    const std::shared_ptr<OutputStream>& raw,
+    std::shared_ptr<CompressedOutputStream>* out) {
+  return Open(default_memory_pool(), codec, raw, out);
+}
+
+Status CompressedOutputStream::Open(MemoryPool* pool, Codec* codec,
+    const std::shared_ptr<OutputStream>& raw,
+    std::shared_ptr<CompressedOutputStream>* out) {
+  std::shared_ptr<CompressedOutputStream> result(new CompressedOutputStream());
+  result->impl_.reset(new CompressedOutputStreamImpl(pool, codec, raw));
+  RETURN_NOT_OK(result->impl_->Init());
+  *out = result;
+  return Status::OK();
+}
+
+Status CompressedOutputStream::Close() {
+  return impl_->Close();
+}
+
+Status CompressedOutputStream::Tell(int64_t* position) {
+  return impl_->Tell(position);
+}
+
+Status CompressedOutputStream::Write(const uint8_t* data, int64_t nbytes) {
+  return impl_->Write(data, nbytes);
+}
+
+Status CompressedOutputStream::Flush() {
+  return impl_->Flush();
+}
+
+std::shared_ptr<OutputStream> CompressedOutputStream::raw() const {
+  return impl_->raw();
+}
+
+// ----------------------------------------------------------------------
+// CompressedInputStream implementation
+
+class CompressedInputStream::CompressedInputStreamImpl {
+ public:
+  CompressedInputStreamImpl(
+      MemoryPool* pool, Codec* codec, const std::shared_ptr<InputStream>& raw)
+      : pool_(pool),
+        codec_(codec),
+        raw_(raw),
+        compressed_pos_(0),
+        raw_eof_(false),
+        decompressed_(std::make_shared<PoolBuffer>(pool)),
+        decompressed_pos_(0),
+        decompressed_size_(0),
+        fresh_decompressor_(true),
+        total_pos_(0),
+        is_open_(false) {}
+
+  Status Init() {
+    RETURN_NOT_OK(codec_->MakeDecompressor(&decompressor_));
+    RETURN_NOT_OK(decompressed_->Resize(kChunkSize));
+    is_open_ = true;
+    return Status::OK();
+  }
+
+  Status Close() {
+    if (!is_open_) { return Status::OK(); }
+    is_open_ = false;
+    return raw_->Close();
+  }
+
+  Status Tell(int64_t* position) {
+    *position = total_pos_;
+    return Status::OK();
+  }
+
+  Status Read(int64_t nbytes, int64_t* bytes_read, uint8_t* out) {
+    if (!is_open_) { return Status::IOError("Stream is closed"); }
+    int64_t total = 0;
+    while (nbytes > 0) {
+      const int64_t available = decompressed_size_ - decompressed_pos_;
+      if (available > 0) {
+        const int64_t n = std::min(nbytes, available);
+        memcpy(out, decompressed_->data() + decompressed_pos_, n);
+        decompressed_pos_ += n;
+        out += n;
+        nbytes -= n;
+        total += n;
+      } else {
+        bool has_data;
+        RETURN_NOT_OK(DecompressChunk(&has_data));
+        if (!has_data) { break; }
+      }
+    }
+    *bytes_read = total;
+    total_pos_ += total;
+    return Status::OK();
+  }
+
+  Status Read(int64_t nbytes, std::shared_ptr<Buffer>* out) {
+    auto buffer = std::make_shared<PoolBuffer>(pool_);
+    RETURN_NOT_OK(buffer->Resize(nbytes));
+    int64_t bytes_read;
+    RETURN_NOT_OK(Read(nbytes, &bytes_read, buffer->mutable_data()));
+    RETURN_NOT_OK(buffer->Resize(bytes_read));
+    *out = buffer;
+    return Status::OK();
+  }
+
+  std::shared_ptr<InputStream> raw() const { return raw_; }
+
+ private:
+  // Decompress into decompressed_ until some data comes out (has_data is
+  // true) or the end of the compressed data is reached
+  Status DecompressChunk(bool* has_data) {
+    decompressed_pos_ = 0;
+    decompressed_size_ = 0;
+    while (true) {
+      const bool consumed =
+          compressed_ == nullptr || compressed_pos_ == compressed_->size();
+      if (!raw_eof_ && consumed) {
+        RETURN_NOT_OK(raw_->Read(kChunkSize, &compressed_));
+        compressed_pos_ = 0;
+        raw_eof_ = compressed_->size() == 0;
+      }
+      const int64_t input_len = raw_eof_ ? 0 : compressed_->size() - compressed_pos_;
+
+      if (decompressor_->IsFinished() && input_len > 0) {
+        // Another compressed stream follows
+        RETURN_NOT_OK(codec_->MakeDecompressor(&decompressor_));
+        fresh_decompressor_ = true;
+      }
+      if (input_len == 0 && (fresh_decompressor_ || decompressor_->IsFinished())) {
+        *has_data = false;
+        return Status::OK();
+      }
+
+      const uint8_t* input = raw_eof_ ? nullptr : compressed_->data() + compressed_pos_;
+      int64_t bytes_read, bytes_written;
+      bool need_more_output;
+      RETURN_NOT_OK(decompressor_->Decompress(input_len, input, decompressed_->size(),
+          decompressed_->mutable_data(), &bytes_read, &bytes_written, &need_more_output));
+      compressed_pos_ += bytes_read;
+      if (bytes_read > 0) { fresh_decompressor_ = false; }
+
+      if (bytes_written > 0) {
+        decompressed_size_ = bytes_written;
+        *has_data = true;
+        return Status::OK();
+      }
+      if (need_more_output) {
+        RETURN_NOT_OK(decompressed_->Resize(decompressed_->size() * 2));
+      } else if (bytes_read == 0 && !decompressor_->IsFinished()) {
+        return Status::IOError(input_len == 0 ? "Truncated compressed stream"
+                                              : "Decompressor made no progress");
+      }
+    }
+  }
+
+  MemoryPool* pool_;
+  Codec* codec_;
+  std::shared_ptr<InputStream> raw_;
+  std::shared_ptr<Decompressor> decompressor_;
+
+  // Compressed data read from raw_ and not yet decompressed
+  std::shared_ptr<Buffer> compressed_;
+  int64_t compressed_pos_;
+  bool raw_eof_;
+
+  // Decompressed data not yet read
+  std::shared_ptr<PoolBuffer> decompressed_;
+  int64_t decompressed_pos_;
+  int64_t decompressed_size_;
+
+  // Whether the decompressor has not been given any input yet, so that the
+  // end of the input is a clean end of stream
+  bool fresh_decompressor_;
+  // Number of decompressed bytes read
+  int64_t total_pos_;
+  bool is_open_;
+};
+
+CompressedInputStream::CompressedInputStream() {
+  set_mode(FileMode::READ);
+}
+
+CompressedInputStream::~CompressedInputStream() {
+  DCHECK(impl_->Close().ok());
+}
+
+Status CompressedInputStream::Open(Codec* codec, const std::shared_ptr<InputStream>& raw,
+    std::shared_ptr<CompressedInputStream>* out) {
+  return Open(default_memory_pool(), codec, raw, out);
+}
+
+Status CompressedInputStream::Open(MemoryPool* pool, Codec* codec,
+    const std::shared_ptr<InputStream>& raw,
+    std::shared_ptr<CompressedInputStream>* out) {
+  std::shared_ptr<CompressedInputStream> result(new CompressedInputStream());
+  result->impl_.reset(new CompressedInputStreamImpl(pool, codec, raw));
+  RETURN_NOT_OK(result->impl_->Init());
+  *out = result;
+  return Status::OK();
+}
+
+Status CompressedInputStream::Close() {
+  return impl_->Close();
+}
+
+Status CompressedInputStream::Tell(int64_t* position) {
+  return impl_->Tell(position);
+}
+
+Status CompressedInputStream::Read(int64_t nbytes, int64_t* bytes_read, uint8_t* out) {
+  return impl_->Read(nbytes, bytes_read, out);
+}
+
+Status CompressedInputStream::Read(int64_t nbytes, std::shared_ptr<Buffer>* out) {
+  return impl_->Read(nbytes, out);
+}
+
+std::shared_ptr<InputStream> CompressedInputStream::raw() const {
+  return impl_->raw();
+}
+
+}  // namespace io
+}  // namespace arrow
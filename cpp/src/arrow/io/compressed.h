@@ -0,0 +1,126 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Compressed stream implementations
+
+#ifndef ARROW_IO_COMPRESSED_H
+#define ARROW_IO_COMPRESSED_H
+
+#include <cstdint>
+#include <memory>
+
+#include "arrow/io/interfaces.h"
+#include "arrow/util/visibility.h"
+
+namespace arrow {
+
+class Codec;
+class MemoryPool;
+class Status;
+
+namespace io {
+
+/// \brief An output stream compressing what is written to it into another
+/// output stream, with the streaming API of a codec (see Codec::MakeCompressor)
+///
+/// The compressed stream is only complete once Close has been called, which
+/// also closes the wrapped stream. Memory use is bounded by the codec state
+/// and a chunk of compressed output.
+class ARROW_EXPORT CompressedOutputStream : public OutputStream {
+ public:
+  ~CompressedOutputStream();
+
+  /// \brief Wrap an output stream
+  ///
+  /// \param[in] codec the codec, which must outlive the stream
+  /// \param[in] raw the stream receiving the compressed data
+  /// \param[out] out the compressed output stream
+  static Status Open(Codec* codec, const std::shared_ptr<OutputStream>& raw,
+      std::shared_ptr<CompressedOutputStream>* out);
+
+  static Status Open(MemoryPool* pool, Codec* codec,
+      const std::shared_ptr<OutputStream>& raw,
+      std::shared_ptr<CompressedOutputStream>* out);
+
+  // OutputStream interface
+
+  /// \brief End the compressed stream and close the wrapped one
+  Status Close() override;
+
+  /// \brief Return the number of uncompressed bytes written
+  Status Tell(int64_t* position) override;
+
+  Status Write(const uint8_t* data, int64_t nbytes) override;
+
+  /// \brief Write out everything compressed so far, so that it can be
+  /// decompressed without the rest of the stream, and flush the wrapped stream
+  Status Flush() override;
+
+  std::shared_ptr<OutputStream> raw() const;
+
+ private:
+  CompressedOutputStream();
+
+  class ARROW_NO_EXPORT CompressedOutputStreamImpl;
+  std::unique_ptr<CompressedOutputStreamImpl> impl_;
+};
+
+/// \brief An input stream decompressing the data read from another input
+/// stream, with the streaming API of a codec (see Codec::MakeDecompressor)
+///
+/// Concatenated compressed streams are read as one. A stream ending in the
+/// middle of compressed data fails with IOError.
+class ARROW_EXPORT CompressedInputStream : public InputStream {
+ public:
+  ~CompressedInputStream();
+
+  /// \brief Wrap an input stream
+  ///
+  /// \param[in] codec the codec, which must outlive the stream
+  /// \param[in] raw the stream providing the compressed data
+  /// \param[out] out the decompressed input stream
+  static Status Open(Codec* codec, const std::shared_ptr<InputStream>& raw,
+      std::shared_ptr<CompressedInputStream>* out);
+
+  static Status Open(MemoryPool* pool, Codec* codec,
+      const std::shared_ptr<InputStream>& raw,
+      std::shared_ptr<CompressedInputStream>* out);
+
+  // InputStream interface
+
+  /// \brief Close the wrapped stream
+  Status Close() override;
+
+  /// \brief Return the number of decompressed bytes read
+  Status Tell(int64_t* position) override;
+
+  Status Read(int64_t nbytes, int64_t* bytes_read, uint8_t* out) override;
+  Status Read(int64_t nbytes, std::shared_ptr<Buffer>* out) override;
+
+  std::shared_ptr<InputStream> raw() const;
+
+ private:
+  CompressedInputStream();
+
+  class ARROW_NO_EXPORT CompressedInputStreamImpl;
+  std::unique_ptr<CompressedInputStreamImpl> impl_;
+};
+
+}  // namespace io
+}  // namespace arrow
+
+#endif  // ARROW_IO_COMPRESSED_H
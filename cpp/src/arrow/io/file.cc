@@ -51,6 +51,8 @@
 
 #ifndef _MSC_VER  // POSIX-like platforms
 
+#include <climits>
+#include <sys/uio.h>
 #include <unistd.h>
 
 // Not available on some platforms
@@ -78,6 +80,7 @@
 #include <limits>
 #include <mutex>
 #include <sstream>
+#include <utility>
 #include <vector>
 
 #if defined(_MSC_VER)
@@ -112,6 +115,7 @@
 #include "arrow/memory_pool.h"
 #include "arrow/status.h"
 #include "arrow/util/logging.h"
+#include "arrow/util/macros.h"
 
 namespace arrow {
 namespace io {
@@ -272,6 +276,63 @@ static inline Status FileRead(
   return Status::OK();
 }
 
+// Read at an offset without moving the file position (except on Windows,
+// which has no such call), so that reads from several threads need no lock.
+// Reads less than nbytes only at the end of the file
+static inline Status FileReadAt(
+    int fd, uint8_t* buffer, int64_t position, int64_t nbytes, int64_t* bytes_read) {
+  *bytes_read = 0;
+  while (*bytes_read < nbytes) {
+    const int64_t offset = position + *bytes_read;
+    // Large reads are done in pieces, which some platforms require anyway
+    const int64_t chunk_size =
+        std::min<int64_t>(nbytes - *bytes_read, std::numeric_limits<int32_t>::max());
+    int64_t ret;
+#if defined(_MSC_VER)
+    HANDLE handle = reinterpret_cast<HANDLE>(_get_osfhandle(fd));
+    OVERLAPPED overlapped = {0};
+    overlapped.Offset = static_cast<DWORD>(offset & 0xFFFFFFFF);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+    DWORD chunk_read = 0;
+    if (ReadFile(handle, buffer + *bytes_read, static_cast<DWORD>(chunk_size),
+            &chunk_read, &overlapped)) {
+      ret = static_cast<int64_t>(chunk_read);
+    } else {
+      ret = GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+    }
+#else
+    ret = static_cast<int64_t>(pread(fd, buffer + *bytes_read,
+        static_cast<size_t>(chunk_size), static_cast<off_t>(offset)));
+    if (ret == -1 && errno == EINTR) { continue; }
+#endif
+    if (ret == -1) {
+      std::stringstream ss;
+      ss << "Error reading " << nbytes << " bytes from file at position " << position;
+      return Status::IOError(ss.str());
+    }
+    if (ret == 0) {
+      // End of file
+      break;
+    }
+    *bytes_read += ret;
+  }
+  return Status::OK();
+}
+
+// Prefetch hint, a no-op where posix_fadvise is not available
+static inline Status FileWillNeed(int fd, int64_t position, int64_t nbytes) {
+#if defined(POSIX_FADV_WILLNEED)
+  int ret = posix_fadvise(
+      fd, static_cast<off_t>(position), static_cast<off_t>(nbytes), POSIX_FADV_WILLNEED);
+  if (ret != 0) {
+    std::stringstream ss;
+    ss << "posix_fadvise failed, error: " << ret;
+    return Status::IOError(ss.str());
+  }
+#endif
+  return Status::OK();
+}
+
 static inline Status FileWrite(int fd, const uint8_t* buffer, int64_t nbytes) {
   int ret;
 #if defined(_MSC_VER)
@@ -290,6 +351,57 @@ static inline Status FileWrite(int fd, const uint8_t* buffer, int64_t nbytes) {
   return Status::OK();
 }
 
+#ifndef _MSC_VER
+#if defined(IOV_MAX)
+static constexpr size_t kMaxIovecs = IOV_MAX;
+#else
+static constexpr size_t kMaxIovecs = 16;  // _XOPEN_IOV_MAX
+#endif
+#endif
+
+// Write several buffers with as few writev calls as possible, resuming after
+// partial writes
+static inline Status FileWriteV(int fd, const std::vector<WriteRange>& buffers) {
+#if defined(_MSC_VER)
+  for (const WriteRange& buffer : buffers) {
+    RETURN_NOT_OK(FileWrite(fd, buffer.first, buffer.second));
+  }
+  return Status::OK();
+#else
+  std::vector<struct iovec> iov;
+  iov.reserve(buffers.size());
+  for (const WriteRange& buffer : buffers) {
+    if (buffer.second > 0) {
+      iov.push_back({const_cast<uint8_t*>(buffer.first),
+          static_cast<size_t>(buffer.second)});
+    }
+  }
+
+  size_t i = 0;
+  while (i < iov.size()) {
+    const size_t count = std::min(iov.size() - i, kMaxIovecs);
+    const ssize_t ret = writev(fd, iov.data() + i, static_cast<int>(count));
+    if (ret == -1) {
+      if (errno == EINTR) { continue; }
+      std::stringstream ss;
+      ss << "Error writing bytes to file, errno: " << errno;
+      return Status::IOError(ss.str());
+    }
+    // Skip what was written, which may end in the middle of a buffer
+    size_t written = static_cast<size_t>(ret);
+    while (i < iov.size() && written >= iov[i].iov_len) {
+      written -= iov[i].iov_len;
+      ++i;
+    }
+    if (written > 0) {
+      iov[i].iov_base = static_cast<uint8_t*>(iov[i].iov_base) + written;
+      iov[i].iov_len -= written;
+    }
+  }
+  return Status::OK();
+#endif
+}
+
 static inline Status FileGetSize(int fd, int64_t* size) {
   int64_t ret;
 
@@ -327,6 +439,23 @@ static inline Status FileClose(int fd) {
   return Status::OK();
 }
 
+static inline Status FileTruncate(int fd, int64_t size) {
+  int ret;
+
+#if defined(_MSC_VER)
+  ret = static_cast<int>(_chsize_s(fd, static_cast<size_t>(size)));
+#else
+  ret = static_cast<int>(ftruncate(fd, static_cast<off_t>(size)));
+#endif
+
+  if (ret != 0) {
+    std::stringstream ss;
+    ss << "Error truncating file to " << size << " bytes";
+    return Status::IOError(ss.str());
+  }
+  return Status::OK();
+}
+
 class OSFile {
  public:
   OSFile() : fd_(-1), is_open_(false), size_(-1) {}
@@ -370,6 +499,16 @@ class OSFile {
     return FileRead(fd_, out, nbytes, bytes_read);
   }
 
+  // Does not take the lock, the file position being left alone
+  Status ReadAt(int64_t position, int64_t nbytes, int64_t* bytes_read, uint8_t* out) {
+    if (position < 0) { return Status::Invalid("Invalid position"); }
+    return FileReadAt(fd_, out, position, nbytes, bytes_read);
+  }
+
+  Status WillNeed(int64_t position, int64_t nbytes) {
+    return FileWillNeed(fd_, position, nbytes);
+  }
+
   Status Seek(int64_t pos) {
     if (pos < 0) { return Status::Invalid("Invalid position"); }
     return FileSeek(fd_, pos);
@@ -383,6 +522,14 @@ class OSFile {
     return FileWrite(fd_, data, length);
   }
 
+  Status WriteV(const std::vector<WriteRange>& buffers) {
+    std::lock_guard<std::mutex> guard(lock_);
+    for (const WriteRange& buffer : buffers) {
+      if (buffer.second < 0) { return Status::IOError("Length must be non-negative"); }
+    }
+    return FileWriteV(fd_, buffers);
+  }
+
   int fd() const { return fd_; }
 
   bool is_open() const { return is_open_; }
@@ -426,6 +573,17 @@ class ReadableFile::ReadableFileImpl : public OSFile {
     return Status::OK();
   }
 
+  Status ReadBufferAt(int64_t position, int64_t nbytes, std::shared_ptr<Buffer>* out) {
+    std::shared_ptr<ResizableBuffer> buffer;
+    RETURN_NOT_OK(AllocateResizableBuffer(pool_, nbytes, &buffer));
+
+    int64_t bytes_read = 0;
+    RETURN_NOT_OK(ReadAt(position, nbytes, &bytes_read, buffer->mutable_data()));
+    if (bytes_read < nbytes) { RETURN_NOT_OK(buffer->Resize(bytes_read)); }
+    *out = buffer;
+    return Status::OK();
+  }
+
  private:
   MemoryPool* pool_;
 };
@@ -465,6 +623,39 @@ Status ReadableFile::Read(int64_t nbytes, std::shared_ptr<Buffer>* out) {
   return impl_->ReadBuffer(nbytes, out);
 }
 
+Status ReadableFile::ReadAt(
+    int64_t position, int64_t nbytes, int64_t* bytes_read, uint8_t* out) {
+  return impl_->ReadAt(position, nbytes, bytes_read, out);
+}
+
+Status ReadableFile::ReadAt(
+    int64_t position, int64_t nbytes, std::shared_ptr<Buffer>* out) {
+  return impl_->ReadBufferAt(position, nbytes, out);
+}
+
+Status ReadableFile::ReadRanges(const std::vector<ReadRange>& ranges,
+    const ReadRangeOptions& options, std::vector<std::shared_ptr<Buffer>>* out) {
+  // Prefetching makes the kernel read ahead for all the ranges at once,
+  // rather than for as many as there are threads. It is only a hint, so the
+  // reads go ahead if it fails, and report invalid ranges themselves
+  Status prefetch = WillNeed(
+      CoalesceReadRanges(ranges, options.hole_size_limit, options.range_size_limit));
+  UNUSED(prefetch);
+  return RandomAccessFile::ReadRanges(ranges, options, out);
+}
+
+Status ReadableFile::WillNeed(const std::vector<ReadRange>& ranges) {
+  for (const ReadRange& range : ranges) {
+    if (range.offset < 0 || range.length < 0) {
+      return Status::Invalid("Invalid read range");
+    }
+    // posix_fadvise takes a length of 0 to mean up to the end of the file
+    if (range.length == 0) { continue; }
+    RETURN_NOT_OK(impl_->WillNeed(range.offset, range.length));
+  }
+  return Status::OK();
+}
+
 Status ReadableFile::GetSize(int64_t* size) {
   *size = impl_->size();
   return Status::OK();
@@ -525,6 +716,10 @@ Status FileOutputStream::Write(const uint8_t* data, int64_t length) {
   return impl_->Write(data, length);
 }
 
+Status FileOutputStream::WriteV(const std::vector<WriteRange>& buffers) {
+  return impl_->WriteV(buffers);
+}
+
 int FileOutputStream::file_descriptor() const {
   return impl_->fd();
 }
@@ -532,18 +727,65 @@ int FileOutputStream::file_descriptor() const {
 // ----------------------------------------------------------------------
 // Implement MemoryMappedFile
 
+MemoryMapOptions::MemoryMapOptions()
+    : populate(false), advice(MemoryMapAdvice::NORMAL), huge_pages(false) {}
+
+// madvise of the region at offset of a mapping of size bytes, a no-op where
+// madvise is not available
+static Status MemoryMapAdvise(uint8_t* data, int64_t size, int64_t offset,
+    int64_t length, MemoryMapAdvice::type advice) {
+  if (offset < 0 || length < 0) { return Status::Invalid("Invalid memory map region"); }
+#if defined(MADV_WILLNEED)
+  int native_advice;
+  switch (advice) {
+    case MemoryMapAdvice::SEQUENTIAL:
+      native_advice = MADV_SEQUENTIAL;
+      break;
+    case MemoryMapAdvice::RANDOM:
+      native_advice = MADV_RANDOM;
+      break;
+    case MemoryMapAdvice::WILLNEED:
+      native_advice = MADV_WILLNEED;
+      break;
+    case MemoryMapAdvice::DONTNEED:
+      native_advice = MADV_DONTNEED;
+      break;
+    default:
+      native_advice = MADV_NORMAL;
+      break;
+  }
+
+  // madvise takes page-aligned addresses
+  static const int64_t page_size = static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+  const int64_t start = offset - offset % page_size;
+  const int64_t end = std::min(offset + length, size);
+  if (length == 0 || end <= start) { return Status::OK(); }
+  if (madvise(data + start, static_cast<size_t>(end - start), native_advice) != 0) {
+    std::stringstream ss;
+    ss << "madvise failed, errno: " << errno;
+    return Status::IOError(ss.str());
+  }
+#endif
+  return Status::OK();
+}
+
 class MemoryMappedFile::MemoryMap : public MutableBuffer {
  public:
-  MemoryMap() : MutableBuffer(nullptr, 0) {}
+  MemoryMap() : MutableBuffer(nullptr, 0), map_size_(0), growable_(false) {}
 
   ~MemoryMap() {
-    if (file_->is_open()) {
-      munmap(mutable_data_, static_cast<size_t>(size_));
-      DCHECK(file_->Close().ok());
+    if (growable_) { DCHECK(Close().ok()); }
+    if (file_->is_open()) { DCHECK(file_->Close().ok()); }
+    if (mutable_data_ != nullptr) {
+      munmap(mutable_data_, static_cast<size_t>(map_size_));
+    }
+    for (const auto& mapping : retired_mappings_) {
+      munmap(mapping.first, static_cast<size_t>(mapping.second));
     }
   }
 
-  Status Open(const std::string& path, FileMode::type mode) {
+  Status Open(
+      const std::string& path, FileMode::type mode, const MemoryMapOptions& options) {
     int prot_flags;
     int map_mode;
 
@@ -566,6 +808,14 @@ class MemoryMappedFile::MemoryMap : public MutableBuffer {
       is_mutable_ = false;
     }
 
+    bool populated = false;
+#if defined(MAP_POPULATE)
+    if (options.populate) {
+      map_mode |= MAP_POPULATE;
+      populated = true;
+    }
+#endif
+
     void* result = mmap(nullptr, static_cast<size_t>(file_->size()), prot_flags, map_mode,
         file_->fd(), 0);
     if (result == MAP_FAILED) {
@@ -575,13 +825,63 @@ class MemoryMappedFile::MemoryMap : public MutableBuffer {
     }
 
     data_ = mutable_data_ = reinterpret_cast<uint8_t*>(result);
-    size_ = file_->size();
+    size_ = map_size_ = file_->size();
+
+    position_ = 0;
 
+#if defined(MADV_HUGEPAGE)
+    if (options.huge_pages) {
+      // Fails where huge pages cannot back this file, which is fine
+      madvise(mutable_data_, static_cast<size_t>(size_), MADV_HUGEPAGE);
+    }
+#endif
+    if (options.advice != MemoryMapAdvice::NORMAL) {
+      RETURN_NOT_OK(Advise(0, size_, options.advice));
+    }
+    if (options.populate && !populated) {
+      RETURN_NOT_OK(Advise(0, size_, MemoryMapAdvice::WILLNEED));
+    }
+    return Status::OK();
+  }
+
+  // Open an empty file mapped read/write, which grows as it is written
+  Status OpenGrowable(const std::string& path, int64_t growth_size) {
+    file_.reset(new OSFile());
+    constexpr bool append = false;
+    constexpr bool write_only = false;
+    RETURN_NOT_OK(file_->OpenWriteable(path, append, write_only));
+
+    is_mutable_ = true;
+    growable_ = true;
+    growth_size_ = growth_size;
+    size_ = 0;
     position_ = 0;
+    return Reserve(growth_size);
+  }
 
+  // Make room for nbytes at the current position, growing the map if it is
+  // growable
+  Status PrepareWrite(int64_t nbytes) {
+    const int64_t end = position_ + nbytes;
+    if (end <= size_) { return Status::OK(); }
+    if (!growable_) { return Status::Invalid("Cannot write past end of memory map"); }
+    RETURN_NOT_OK(Reserve(end));
+    size_ = end;
     return Status::OK();
   }
 
+  // Truncate a growable file to the bytes written and close it. The mapping
+  // stays, for the buffers read from it
+  Status Close() {
+    if (!growable_ || !file_->is_open()) { return Status::OK(); }
+    RETURN_NOT_OK(FileTruncate(file_->fd(), size_));
+    return file_->Close();
+  }
+
+  Status Advise(int64_t offset, int64_t length, MemoryMapAdvice::type advice) {
+    return MemoryMapAdvise(mutable_data_, size_, offset, length, advice);
+  }
+
   int64_t size() const { return size_; }
 
   Status Seek(int64_t position) {
@@ -602,9 +902,51 @@ class MemoryMappedFile::MemoryMap : public MutableBuffer {
 
   int fd() const { return file_->fd(); }
 
+  bool growable() const { return growable_; }
+
  private:
+  // Extend the file and the mapping to at least capacity bytes, at least
+  // doubling them. The mapping is grown in place where the address space
+  // allows, else the file is mapped anew and the previous mapping is kept
+  // until destruction, as buffers may point into it
+  Status Reserve(int64_t capacity) {
+    if (capacity <= map_size_) { return Status::OK(); }
+    capacity = std::max(capacity, std::max(map_size_ * 2, growth_size_));
+    RETURN_NOT_OK(FileTruncate(file_->fd(), capacity));
+
+#if defined(MREMAP_MAYMOVE)
+    if (mutable_data_ != nullptr &&
+        mremap(mutable_data_, static_cast<size_t>(map_size_),
+            static_cast<size_t>(capacity), 0) != MAP_FAILED) {
+      map_size_ = capacity;
+      return Status::OK();
+    }
+#endif
+
+    void* result = mmap(nullptr, static_cast<size_t>(capacity), PROT_READ | PROT_WRITE,
+        MAP_SHARED, file_->fd(), 0);
+    if (result == MAP_FAILED) {
+      std::stringstream ss;
+      ss << "Memory mapping file failed, errno: " << errno;
+      return Status::IOError(ss.str());
+    }
+    if (mutable_data_ != nullptr) {
+      retired_mappings_.emplace_back(mutable_data_, map_size_);
+    }
+    data_ = mutable_data_ = reinterpret_cast<uint8_t*>(result);
+    map_size_ = capacity;
+    return Status::OK();
+  }
+
   std::unique_ptr<OSFile> file_;
   int64_t position_;
+
+  // Size of the mapping, beyond size_ when growable
+  int64_t map_size_;
+
+  bool growable_;
+  int64_t growth_size_;
+  std::vector<std::pair<uint8_t*, int64_t>> retired_mappings_;
 };
 
 MemoryMappedFile::MemoryMappedFile() {}
@@ -614,46 +956,76 @@ Status MemoryMappedFile::Create(
     const std::string& path, int64_t size, std::shared_ptr<MemoryMappedFile>* out) {
   std::shared_ptr<FileOutputStream> file;
   RETURN_NOT_OK(FileOutputStream::Open(path, &file));
-#ifdef _MSC_VER
-  _chsize_s(file->file_descriptor(), static_cast<size_t>(size));
-#else
-  ftruncate(file->file_descriptor(), static_cast<size_t>(size));
-#endif
+  RETURN_NOT_OK(FileTruncate(file->file_descriptor(), size));
   RETURN_NOT_OK(file->Close());
   return MemoryMappedFile::Open(path, FileMode::READWRITE, out);
 }
 
+Status MemoryMappedFile::CreateGrowable(
+    const std::string& path, std::shared_ptr<MemoryMappedFile>* out) {
+  return CreateGrowable(path, kDefaultMemoryMapGrowthSize, out);
+}
+
+Status MemoryMappedFile::CreateGrowable(const std::string& path, int64_t growth_size,
+    std::shared_ptr<MemoryMappedFile>* out) {
+  if (growth_size <= 0) { return Status::Invalid("Growth size must be positive"); }
+  std::shared_ptr<MemoryMappedFile> result(new MemoryMappedFile());
+
+  result->memory_map_.reset(new MemoryMap());
+  RETURN_NOT_OK(result->memory_map_->OpenGrowable(path, growth_size));
+
+  *out = result;
+  return Status::OK();
+}
+
 Status MemoryMappedFile::Open(const std::string& path, FileMode::type mode,
     std::shared_ptr<MemoryMappedFile>* out) {
+  return Open(path, mode, MemoryMapOptions(), out);
+}
+
+Status MemoryMappedFile::Open(const std::string& path, FileMode::type mode,
+    const MemoryMapOptions& options, std::shared_ptr<MemoryMappedFile>* out) {
   std::shared_ptr<MemoryMappedFile> result(new MemoryMappedFile());
 
   result->memory_map_.reset(new MemoryMap());
-  RETURN_NOT_OK(result->memory_map_->Open(path, mode));
+  RETURN_NOT_OK(result->memory_map_->Open(path, mode, options));
 
   *out = result;
   return Status::OK();
 }
 
+// Writes to a growable file move or extend its mapping, so the methods using
+// the mapping, its size or the position take the lock. Other files need none
+
 Status MemoryMappedFile::GetSize(int64_t* size) {
+  std::unique_lock<std::mutex> guard(lock_, std::defer_lock);
+  if (memory_map_->growable()) { guard.lock(); }
   *size = memory_map_->size();
   return Status::OK();
 }
 
 Status MemoryMappedFile::Tell(int64_t* position) {
+  std::unique_lock<std::mutex> guard(lock_, std::defer_lock);
+  if (memory_map_->growable()) { guard.lock(); }
   *position = memory_map_->position();
   return Status::OK();
 }
 
 Status MemoryMappedFile::Seek(int64_t position) {
+  std::unique_lock<std::mutex> guard(lock_, std::defer_lock);
+  if (memory_map_->growable()) { guard.lock(); }
   return memory_map_->Seek(position);
 }
 
 Status MemoryMappedFile::Close() {
   // munmap handled in pimpl dtor
-  return Status::OK();
+  std::lock_guard<std::mutex> guard(lock_);
+  return memory_map_->Close();
 }
 
 Status MemoryMappedFile::Read(int64_t nbytes, int64_t* bytes_read, uint8_t* out) {
+  std::unique_lock<std::mutex> guard(lock_, std::defer_lock);
+  if (memory_map_->growable()) { guard.lock(); }
   nbytes = std::max<int64_t>(
       0, std::min(nbytes, memory_map_->size() - memory_map_->position()));
   if (nbytes > 0) { std::memcpy(out, memory_map_->head(), static_cast<size_t>(nbytes)); }
@@ -663,6 +1035,8 @@ Status MemoryMappedFile::Read(int64_t nbytes, int64_t* bytes_read, uint8_t* out)
 }
 
 Status MemoryMappedFile::Read(int64_t nbytes, std::shared_ptr<Buffer>* out) {
+  std::unique_lock<std::mutex> guard(lock_, std::defer_lock);
+  if (memory_map_->growable()) { guard.lock(); }
   nbytes = std::max<int64_t>(
       0, std::min(nbytes, memory_map_->size() - memory_map_->position()));
 
@@ -675,6 +1049,63 @@ Status MemoryMappedFile::Read(int64_t nbytes, std::shared_ptr<Buffer>* out) {
   return Status::OK();
 }
 
+Status MemoryMappedFile::ReadAt(
+    int64_t position, int64_t nbytes, int64_t* bytes_read, uint8_t* out) {
+  if (position < 0) { return Status::Invalid("position is out of bounds"); }
+  std::unique_lock<std::mutex> guard(lock_, std::defer_lock);
+  if (memory_map_->growable()) { guard.lock(); }
+  nbytes = std::max<int64_t>(0, std::min(nbytes, memory_map_->size() - position));
+  if (nbytes > 0) {
+    std::memcpy(out, memory_map_->data() + position, static_cast<size_t>(nbytes));
+  }
+  *bytes_read = nbytes;
+  return Status::OK();
+}
+
+Status MemoryMappedFile::ReadAt(
+    int64_t position, int64_t nbytes, std::shared_ptr<Buffer>* out) {
+  if (position < 0) { return Status::Invalid("position is out of bounds"); }
+  std::unique_lock<std::mutex> guard(lock_, std::defer_lock);
+  if (memory_map_->growable()) { guard.lock(); }
+  nbytes = std::max<int64_t>(0, std::min(nbytes, memory_map_->size() - position));
+  if (nbytes > 0) {
+    *out = SliceBuffer(memory_map_, position, nbytes);
+  } else {
+    *out = std::make_shared<Buffer>(nullptr, 0);
+  }
+  return Status::OK();
+}
+
+Status MemoryMappedFile::ReadRanges(const std::vector<ReadRange>& ranges,
+    const ReadRangeOptions& options, std::vector<std::shared_ptr<Buffer>>* out) {
+  out->resize(ranges.size());
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    if (ranges[i].length < 0) { return Status::Invalid("Invalid read range"); }
+    RETURN_NOT_OK(ReadAt(ranges[i].offset, ranges[i].length, &(*out)[i]));
+  }
+  return Status::OK();
+}
+
+Status MemoryMappedFile::WillNeed(const std::vector<ReadRange>& ranges) {
+  for (const ReadRange& range : ranges) {
+    RETURN_NOT_OK(WillNeed(range.offset, range.length));
+  }
+  return Status::OK();
+}
+
+Status MemoryMappedFile::WillNeed(int64_t offset, int64_t length) {
+  std::unique_lock<std::mutex> guard(lock_, std::defer_lock);
+  if (memory_map_->growable()) { guard.lock(); }
+  return memory_map_->Advise(offset, length, MemoryMapAdvice::WILLNEED);
+}
+
+Status MemoryMappedFile::Advise(
+    int64_t offset, int64_t length, MemoryMapAdvice::type advice) {
+  std::unique_lock<std::mutex> guard(lock_, std::defer_lock);
+  if (memory_map_->growable()) { guard.lock(); }
+  return memory_map_->Advise(offset, length, advice);
+}
+
 bool MemoryMappedFile::supports_zero_copy() const {
   return true;
 }
@@ -687,6 +1118,7 @@ Status MemoryMappedFile::WriteAt(int64_t position, const uint8_t* data, int64_t
   }
 
   RETURN_NOT_OK(memory_map_->Seek(position));
+  RETURN_NOT_OK(memory_map_->PrepareWrite(nbytes));
   return WriteInternal(data, nbytes);
 }
 
@@ -696,9 +1128,7 @@ Status MemoryMappedFile::Write(const uint8_t* data, int64_t nbytes) {
   if (!memory_map_->opened() || !memory_map_->writable()) {
     return Status::IOError("Unable to write");
   }
-  if (nbytes + memory_map_->position() > memory_map_->size()) {
-    return Status::Invalid("Cannot write past end of memory map");
-  }
+  RETURN_NOT_OK(memory_map_->PrepareWrite(nbytes));
   return WriteInternal(data, nbytes);
 }
 
@@ -23,6 +23,7 @@
 #include <cstdint>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "arrow/io/interfaces.h"
 #include "arrow/util/macros.h"
@@ -54,6 +55,9 @@ class ARROW_EXPORT FileOutputStream : public OutputStream {
   // Write bytes to the stream. Thread-safe
   Status Write(const uint8_t* data, int64_t nbytes) override;
 
+  // Write the buffers with writev, as few system calls as possible. Thread-safe
+  Status WriteV(const std::vector<WriteRange>& buffers) override;
+
   int file_descriptor() const;
 
  private:
@@ -82,6 +86,26 @@ class ARROW_EXPORT ReadableFile : public RandomAccessFile {
   Status Read(int64_t nbytes, int64_t* bytes_read, uint8_t* buffer) override;
   Status Read(int64_t nbytes, std::shared_ptr<Buffer>* out) override;
 
+  /// \brief Read bytes at a position with pread, which does not change the
+  /// file position. Thread-safe and lock-free, so that several threads can
+  /// read from one file at once
+  Status ReadAt(
+      int64_t position, int64_t nbytes, int64_t* bytes_read, uint8_t* out) override;
+
+  /// \brief Read bytes at a position into a new buffer, see ReadAt above
+  Status ReadAt(int64_t position, int64_t nbytes, std::shared_ptr<Buffer>* out) override;
+
+  /// \brief Read several ranges at once, see RandomAccessFile::ReadRanges.
+  /// The operating system is asked to prefetch all the merged ranges before
+  /// they are read
+  Status ReadRanges(const std::vector<ReadRange>& ranges,
+      const ReadRangeOptions& options,
+      std::vector<std::shared_ptr<Buffer>>* out) override;
+
+  /// \brief Ask the operating system to read the ranges ahead (with
+  /// posix_fadvise, where available)
+  Status WillNeed(const std::vector<ReadRange>& ranges) override;
+
   Status GetSize(int64_t* size) override;
   Status Seek(int64_t position) override;
 
@@ -96,6 +120,42 @@ class ARROW_EXPORT ReadableFile : public RandomAccessFile {
   std::unique_ptr<ReadableFileImpl> impl_;
 };
 
+/// \brief How a memory map will be accessed, for the operating system to
+/// tune its read-ahead and page eviction (madvise)
+struct MemoryMapAdvice {
+  enum type {
+    // Default read-ahead
+    NORMAL,
+    // Read ahead aggressively, pages behind being evicted early
+    SEQUENTIAL,
+    // No read-ahead
+    RANDOM,
+    // Page in the region in the background
+    WILLNEED,
+    // Evict the region from memory, reading it again on the next access
+    DONTNEED
+  };
+};
+
+struct ARROW_EXPORT MemoryMapOptions {
+  MemoryMapOptions();
+
+  /// Fault the whole mapping in when opening it (MAP_POPULATE on Linux,
+  /// MADV_WILLNEED elsewhere), so that scans do not fault page by page
+  bool populate;
+
+  /// Advice applied to the whole mapping when opening it
+  MemoryMapAdvice::type advice;
+
+  /// Ask for the mapping to be backed by transparent huge pages
+  /// (MADV_HUGEPAGE), fewer TLB misses making scans faster. Best effort:
+  /// ignored where the kernel or the file system does not support them
+  bool huge_pages;
+};
+
+/// Default minimum growth of a growable MemoryMappedFile
+constexpr int64_t kDefaultMemoryMapGrowthSize = 64 * 1024 * 1024;
+
 // A file interface that uses memory-mapped files for memory interactions,
 // supporting zero copy reads. The same class is used for both reading and
 // writing.
@@ -110,9 +170,34 @@ class ARROW_EXPORT MemoryMappedFile : public ReadWriteFileInterface {
   static Status Create(
       const std::string& path, int64_t size, std::shared_ptr<MemoryMappedFile>* out);
 
+  /// \brief Create a new file, in read/write mode, which grows as it is
+  /// written
+  ///
+  /// Writes past the end extend the file (ftruncate) and the mapping by at
+  /// least growth_size bytes, doubling them. The mapping is grown in place
+  /// where possible (mremap), else mapped anew, the previous mapping being
+  /// kept until destruction so that buffers read before stay valid. Close
+  /// truncates the file to the bytes written. Reads at a position take the
+  /// file lock, the mapping changing as the file grows
+  ///
+  /// \param[in] path the file to create, truncating any existing one
+  /// \param[in] growth_size the minimum growth, which must be positive
+  /// \param[out] out the memory mapped file
+  static Status CreateGrowable(const std::string& path, int64_t growth_size,
+      std::shared_ptr<MemoryMappedFile>* out);
+
+  static Status CreateGrowable(
+      const std::string& path, std::shared_ptr<MemoryMappedFile>* out);
+
   static Status Open(const std::string& path, FileMode::type mode,
       std::shared_ptr<MemoryMappedFile>* out);
 
+  static Status Open(const std::string& path, FileMode::type mode,
+      const MemoryMapOptions& options, std::shared_ptr<MemoryMappedFile>* out);
+
+  /// \brief Truncate a growable file to the bytes written and close it,
+  /// after which it cannot be written. Other files are unmapped on
+  /// destruction
   Status Close() override;
 
   Status Tell(int64_t* position) override;
@@ -125,6 +210,33 @@ class ARROW_EXPORT MemoryMappedFile : public ReadWriteFileInterface {
   // Zero copy read. Not thread-safe
   Status Read(int64_t nbytes, std::shared_ptr<Buffer>* out) override;
 
+  /// \brief Copy bytes at a position into out. Thread-safe and lock-free,
+  /// the file position being left alone
+  Status ReadAt(
+      int64_t position, int64_t nbytes, int64_t* bytes_read, uint8_t* out) override;
+
+  /// \brief Zero copy read at a position. Thread-safe and lock-free, the file
+  /// position being left alone
+  Status ReadAt(int64_t position, int64_t nbytes, std::shared_ptr<Buffer>* out) override;
+
+  /// \brief Zero copy reads of several ranges, which are not merged, there
+  /// being nothing to gain
+  Status ReadRanges(const std::vector<ReadRange>& ranges,
+      const ReadRangeOptions& options,
+      std::vector<std::shared_ptr<Buffer>>* out) override;
+
+  /// \brief Ask the operating system to page in the ranges (with madvise,
+  /// where available)
+  Status WillNeed(const std::vector<ReadRange>& ranges) override;
+
+  /// \brief Page in a region in the background, e.g. the next record batch
+  /// while decoding the current one
+  Status WillNeed(int64_t offset, int64_t length);
+
+  /// \brief Apply advice to a region of the mapping, which is widened to
+  /// whole pages and clipped to the end of the file
+  Status Advise(int64_t offset, int64_t length, MemoryMapAdvice::type advice);
+
   bool supports_zero_copy() const override;
 
   /// Write data at the current position in the file. Thread-safe
@@ -19,8 +19,10 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <limits>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "arrow/buffer.h"
 #include "arrow/io/hdfs-internal.h"
@@ -115,20 +117,28 @@ class HdfsReadableFile::HdfsReadableFileImpl : public HdfsAnyFileImpl {
   }
 
   Status ReadAt(int64_t position, int64_t nbytes, int64_t* bytes_read, uint8_t* buffer) {
-    tSize ret;
-    if (driver_->HasPread()) {
-      ret = driver_->Pread(fs_, file_, static_cast<tOffset>(position),
-          reinterpret_cast<void*>(buffer), static_cast<tSize>(nbytes));
-    } else {
+    if (!driver_->HasPread()) {
       std::lock_guard<std::mutex> guard(lock_);
       RETURN_NOT_OK(Seek(position));
       return Read(nbytes, bytes_read, buffer);
     }
-    RETURN_NOT_OK(CheckReadResult(ret));
-    *bytes_read = ret;
+    // Pread may return less than asked for, and takes at most 2GB at a time
+    int64_t total_bytes = 0;
+    while (total_bytes < nbytes) {
+      tSize ret = driver_->Pread(fs_, file_, static_cast<tOffset>(position + total_bytes),
+          reinterpret_cast<void*>(buffer + total_bytes),
+          static_cast<tSize>(std::min<int64_t>(
+              nbytes - total_bytes, std::numeric_limits<tSize>::max())));
+      RETURN_NOT_OK(CheckReadResult(ret));
+      total_bytes += ret;
+      if (ret == 0) { break; }
+    }
+    *bytes_read = total_bytes;
     return Status::OK();
   }
 
+  bool has_pread() { return driver_->HasPread(); }
+
   Status ReadAt(int64_t position, int64_t nbytes, std::shared_ptr<Buffer>* out) {
     std::shared_ptr<ResizableBuffer> buffer;
     RETURN_NOT_OK(AllocateResizableBuffer(pool_, nbytes, &buffer));
@@ -209,6 +219,15 @@ Status HdfsReadableFile::ReadAt(
   return impl_->ReadAt(position, nbytes, out);
 }
 
+Status HdfsReadableFile::ReadRanges(const std::vector<ReadRange>& ranges,
+    const ReadRangeOptions& options, std::vector<std::shared_ptr<Buffer>>* out) {
+  if (impl_->has_pread()) { return RandomAccessFile::ReadRanges(ranges, options, out); }
+  // Reads without pread take the file lock, so threads would only wait on it
+  ReadRangeOptions serial_options = options;
+  serial_options.num_threads = 1;
+  return RandomAccessFile::ReadRanges(ranges, serial_options, out);
+}
+
 bool HdfsReadableFile::supports_zero_copy() const {
   return false;
 }
@@ -178,6 +178,13 @@ class ARROW_EXPORT HdfsReadableFile : public RandomAccessFile {
 
   Status ReadAt(int64_t position, int64_t nbytes, std::shared_ptr<Buffer>* out) override;
 
+  /// \brief Read several ranges at once, see RandomAccessFile::ReadRanges.
+  /// Merging ranges saves a round trip to the datanode per range; the merged
+  /// ranges are read concurrently if the driver supports pread
+  Status ReadRanges(const std::vector<ReadRange>& ranges,
+      const ReadRangeOptions& options,
+      std::vector<std::shared_ptr<Buffer>>* out) override;
+
   bool supports_zero_copy() const override;
 
   Status Seek(int64_t position) override;
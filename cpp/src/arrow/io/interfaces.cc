@@ -17,12 +17,17 @@
 
 #include "arrow/io/interfaces.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <sstream>
+#include <vector>
 
 #include "arrow/buffer.h"
 #include "arrow/status.h"
+#include "arrow/util/logging.h"
+#include "arrow/util/parallel.h"
 
 namespace arrow {
 namespace io {
@@ -47,11 +52,99 @@ Status RandomAccessFile::ReadAt(
   return Read(nbytes, out);
 }
 
+ReadRangeOptions::ReadRangeOptions()
+    : hole_size_limit(8 * 1024), range_size_limit(32 * 1024 * 1024), num_threads(0) {}
+
+std::vector<ReadRange> CoalesceReadRanges(std::vector<ReadRange> ranges,
+    int64_t hole_size_limit, int64_t range_size_limit) {
+  std::sort(ranges.begin(), ranges.end(), [](const ReadRange& a, const ReadRange& b) {
+    return a.offset < b.offset;
+  });
+
+  std::vector<ReadRange> merged;
+  for (const ReadRange& range : ranges) {
+    if (range.length == 0) { continue; }
+    if (!merged.empty()) {
+      ReadRange& last = merged.back();
+      const int64_t last_end = last.offset + last.length;
+      const int64_t end = std::max(last_end, range.offset + range.length);
+      if (range.offset - last_end <= hole_size_limit &&
+          end - last.offset <= range_size_limit) {
+        last.length = end - last.offset;
+        continue;
+      }
+      if (end == last_end) {
+        // Contained in the last merged range, which is too large to grow
+        continue;
+      }
+    }
+    merged.push_back(range);
+  }
+  return merged;
+}
+
+static Status ValidateReadRanges(const std::vector<ReadRange>& ranges) {
+  for (const ReadRange& range : ranges) {
+    if (range.offset < 0 || range.length < 0) {
+      std::stringstream ss;
+      ss << "Invalid read range of " << range.length << " bytes at " << range.offset;
+      return Status::Invalid(ss.str());
+    }
+  }
+  return Status::OK();
+}
+
+Status RandomAccessFile::ReadRanges(const std::vector<ReadRange>& ranges,
+    const ReadRangeOptions& options, std::vector<std::shared_ptr<Buffer>>* out) {
+  RETURN_NOT_OK(ValidateReadRanges(ranges));
+  const std::vector<ReadRange> merged =
+      CoalesceReadRanges(ranges, options.hole_size_limit, options.range_size_limit);
+
+  std::vector<std::shared_ptr<Buffer>> merged_buffers(merged.size());
+  RETURN_NOT_OK(ParallelFor(options.num_threads, static_cast<int64_t>(merged.size()),
+      [this, &merged, &merged_buffers](int64_t i) {
+        return ReadAt(merged[i].offset, merged[i].length, &merged_buffers[i]);
+      }));
+
+  out->clear();
+  for (const ReadRange& range : ranges) {
+    if (range.length == 0) {
+      out->push_back(std::make_shared<Buffer>(nullptr, 0));
+      continue;
+    }
+    // The last merged range starting at or before the range contains it
+    auto it = std::upper_bound(merged.begin(), merged.end(), range.offset,
+        [](int64_t offset, const ReadRange& m) { return offset < m.offset; });
+    --it;
+    while (range.offset + range.length > it->offset + it->length) {
+      // A merged range containing it entirely starts earlier
+      DCHECK(it != merged.begin());
+      --it;
+    }
+    const std::shared_ptr<Buffer>& buffer = merged_buffers[it - merged.begin()];
+    const int64_t start = std::min(range.offset - it->offset, buffer->size());
+    out->push_back(
+        SliceBuffer(buffer, start, std::min(range.length, buffer->size() - start)));
+  }
+  return Status::OK();
+}
+
+Status RandomAccessFile::WillNeed(const std::vector<ReadRange>& ranges) {
+  return Status::OK();
+}
+
 Status Writeable::Write(const std::string& data) {
   return Write(
       reinterpret_cast<const uint8_t*>(data.c_str()), static_cast<int64_t>(data.size()));
 }
 
+Status Writeable::WriteV(const std::vector<WriteRange>& buffers) {
+  for (const WriteRange& buffer : buffers) {
+    RETURN_NOT_OK(Write(buffer.first, buffer.second));
+  }
+  return Status::OK();
+}
+
 Status Writeable::Flush() {
   return Status::OK();
 }
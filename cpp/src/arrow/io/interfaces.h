@@ -22,6 +22,8 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "arrow/util/macros.h"
 #include "arrow/util/visibility.h"
@@ -42,6 +44,39 @@ struct ObjectType {
   enum type { FILE, DIRECTORY };
 };
 
+/// \brief The address and length of bytes to write
+using WriteRange = std::pair<const uint8_t*, int64_t>;
+
+/// \brief A range of bytes in a file
+struct ARROW_EXPORT ReadRange {
+  int64_t offset;
+  int64_t length;
+};
+
+struct ARROW_EXPORT ReadRangeOptions {
+  ReadRangeOptions();
+
+  /// Ranges at most this many bytes apart are read as one, the bytes between
+  /// them being read and discarded
+  int64_t hole_size_limit;
+
+  /// Merged reads are not made larger than this, though a single range larger
+  /// than it is read whole
+  int64_t range_size_limit;
+
+  /// Number of threads issuing the merged reads, 0 (the default) for one per
+  /// hardware thread
+  int num_threads;
+};
+
+/// \brief Merge ranges that overlap or are at most hole_size_limit bytes
+/// apart, up to range_size_limit bytes per merged range
+///
+/// \return the merged ranges, sorted by offset
+ARROW_EXPORT
+std::vector<ReadRange> CoalesceReadRanges(std::vector<ReadRange> ranges,
+    int64_t hole_size_limit, int64_t range_size_limit);
+
 class ARROW_EXPORT FileSystemClient {
  public:
   virtual ~FileSystemClient() {}
@@ -73,6 +108,11 @@ class ARROW_EXPORT Writeable {
  public:
   virtual Status Write(const uint8_t* data, int64_t nbytes) = 0;
 
+  /// \brief Write several buffers one after the other, as a single write if
+  /// the stream can (gather write). The default implementation calls Write
+  /// for each buffer
+  virtual Status WriteV(const std::vector<WriteRange>& buffers);
+
   // Default implementation is a no-op
   virtual Status Flush();
 
@@ -106,13 +146,32 @@ class ARROW_EXPORT RandomAccessFile : public InputStream, public Seekable {
   /// Read at position, provide default implementations using Read(...), but can
   /// be overridden
   ///
-  /// Default implementation is thread-safe
+  /// Default implementation is thread-safe, serializing readers with lock()
+  /// and moving the file position. ReadableFile and MemoryMappedFile override
+  /// it to read without locking, leaving the file position alone
   virtual Status ReadAt(
       int64_t position, int64_t nbytes, int64_t* bytes_read, uint8_t* out);
 
   /// Default implementation is thread-safe
   virtual Status ReadAt(int64_t position, int64_t nbytes, std::shared_ptr<Buffer>* out);
 
+  /// \brief Read several ranges at once
+  ///
+  /// The ranges are merged with CoalesceReadRanges, the merged ranges are
+  /// read concurrently with ReadAt, and each output buffer is a slice of a
+  /// merged read. Ranges extending past the end of the file are truncated.
+  /// Thread-safe
+  ///
+  /// \param[in] ranges the ranges to read, in any order
+  /// \param[in] options how to merge and read them
+  /// \param[out] out a buffer for every range, in the order of ranges
+  virtual Status ReadRanges(const std::vector<ReadRange>& ranges,
+      const ReadRangeOptions& options, std::vector<std::shared_ptr<Buffer>>* out);
+
+  /// \brief Hint that the ranges will be read soon, so that they can be
+  /// fetched in the background. The default implementation does nothing
+  virtual Status WillNeed(const std::vector<ReadRange>& ranges);
+
   std::mutex& lock() { return lock_; }
 
  protected:
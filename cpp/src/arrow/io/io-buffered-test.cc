@@ -0,0 +1,290 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "arrow/buffer.h"
+#include "arrow/io/buffered.h"
+#include "arrow/io/memory.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/test-util.h"
+
+namespace arrow {
+namespace io {
+
+// An output stream counting the writes it receives
+class CountingOutputStream : public OutputStream {
+ public:
+  CountingOutputStream() : num_writes_(0), num_flushes_(0), closed_(false) {
+    EXPECT_OK(BufferOutputStream::Create(1024, default_memory_pool(), &sink_));
+  }
+
+  Status Close() override {
+    closed_ = true;
+    return Status::OK();
+  }
+  Status Tell(int64_t* position) override { return sink_->Tell(position); }
+  Status Write(const uint8_t* data, int64_t nbytes) override {
+    ++num_writes_;
+    return sink_->Write(data, nbytes);
+  }
+  Status WriteV(const std::vector<WriteRange>& buffers) override {
+    ++num_writes_;
+    return sink_->WriteV(buffers);
+  }
+  Status Flush() override {
+    ++num_flushes_;
+    return Status::OK();
+  }
+
+  std::vector<uint8_t> written() {
+    std::shared_ptr<Buffer> buffer;
+    EXPECT_OK(sink_->Finish(&buffer));
+    return std::vector<uint8_t>(buffer->data(), buffer->data() + buffer->size());
+  }
+
+  int num_writes() const { return num_writes_; }
+  int num_flushes() const { return num_flushes_; }
+  bool closed() const { return closed_; }
+
+ private:
+  std::shared_ptr<BufferOutputStream> sink_;
+  int num_writes_;
+  int num_flushes_;
+  bool closed_;
+};
+
+// An input stream counting the reads it receives
+class CountingInputStream : public BufferReader {
+ public:
+  explicit CountingInputStream(const std::vector<uint8_t>& data)
+      : BufferReader(data.data(), static_cast<int64_t>(data.size())), num_reads_(0) {}
+
+  using BufferReader::Read;
+
+  Status Read(int64_t nbytes, int64_t* bytes_read, uint8_t* out) override {
+    ++num_reads_;
+    return BufferReader::Read(nbytes, bytes_read, out);
+  }
+
+  int num_reads() const { return num_reads_; }
+
+ private:
+  int num_reads_;
+};
+
+static std::vector<uint8_t> MakeData(int64_t size) {
+  std::vector<uint8_t> data(size);
+  test::random_bytes(size, 42, data.data());
+  return data;
+}
+
+TEST(TestBufferedOutputStream, SmallWrites) {
+  const std::vector<uint8_t> data = MakeData(10000);
+  auto raw = std::make_shared<CountingOutputStream>();
+  std::shared_ptr<BufferedOutputStream> stream;
+  ASSERT_OK(BufferedOutputStream::Create(raw, 1000, &stream));
+  ASSERT_EQ(1000, stream->buffer_size());
+
+  for (size_t pos = 0; pos < data.size(); pos += 10) {
+    ASSERT_OK(stream->Write(data.data() + pos, 10));
+  }
+  ASSERT_EQ(9, raw->num_writes());
+  ASSERT_EQ(1000, stream->bytes_buffered());
+  int64_t position;
+  ASSERT_OK(stream->Tell(&position));
+  ASSERT_EQ(10000, position);
+
+  ASSERT_OK(stream->Close());
+  ASSERT_TRUE(raw->closed());
+  ASSERT_EQ(10, raw->num_writes());
+  ASSERT_EQ(data, raw->written());
+}
+
+TEST(TestBufferedOutputStream, LargeWritesPassThrough) {
+  const std::vector<uint8_t> data = MakeData(10000);
+  auto raw = std::make_shared<CountingOutputStream>();
+  std::shared_ptr<BufferedOutputStream> stream;
+  ASSERT_OK(BufferedOutputStream::Create(raw, 1000, &stream));
+
+  ASSERT_OK(stream->Write(data.data(), 5));
+  ASSERT_OK(stream->Write(data.data() + 5, 4000));
+  // The buffered bytes, then the large write as is
+  ASSERT_EQ(2, raw->num_writes());
+  ASSERT_EQ(0, stream->bytes_buffered());
+  ASSERT_OK(stream->Write(data.data() + 4005, 5995));
+  ASSERT_EQ(3, raw->num_writes());
+  ASSERT_OK(stream->Close());
+  ASSERT_EQ(data, raw->written());
+}
+
+TEST(TestBufferedOutputStream, FlushAndSetBufferSize) {
+  const std::vector<uint8_t> data = MakeData(1000);
+  auto raw = std::make_shared<CountingOutputStream>();
+  std::shared_ptr<BufferedOutputStream> stream;
+  ASSERT_OK(BufferedOutputStream::Create(raw, 1000, &stream));
+
+  ASSERT_OK(stream->Write(data.data(), 100));
+  ASSERT_OK(stream->Flush());
+  ASSERT_EQ(1, raw->num_writes());
+  ASSERT_EQ(1, raw->num_flushes());
+
+  ASSERT_OK(stream->Write(data.data() + 100, 100));
+  ASSERT_OK(stream->SetBufferSize(500));
+  ASSERT_EQ(1, raw->num_writes());
+  ASSERT_OK(stream->SetBufferSize(50));
+  ASSERT_EQ(2, raw->num_writes());
+  ASSERT_OK(stream->Write(data.data() + 200, 800));
+  ASSERT_RAISES(Invalid, stream->SetBufferSize(0));
+
+  ASSERT_OK(stream->Close());
+  ASSERT_OK(stream->Close());
+  ASSERT_EQ(data, raw->written());
+  ASSERT_RAISES(IOError, stream->Write(data.data(), 1));
+}
+
+TEST(TestBufferedOutputStream, WriteV) {
+  const std::vector<uint8_t> data = MakeData(3000);
+  auto raw = std::make_shared<CountingOutputStream>();
+  std::shared_ptr<BufferedOutputStream> stream;
+  ASSERT_OK(BufferedOutputStream::Create(raw, 1000, &stream));
+
+  ASSERT_OK(stream->WriteV({{data.data(), 100}, {data.data() + 100, 100}}));
+  ASSERT_EQ(0, raw->num_writes());
+  ASSERT_EQ(200, stream->bytes_buffered());
+  // Written out with the buffered data
+  ASSERT_OK(stream->WriteV({{data.data() + 200, 600}, {data.data() + 800, 1200}}));
+  ASSERT_EQ(1, raw->num_writes());
+  ASSERT_EQ(0, stream->bytes_buffered());
+  ASSERT_OK(stream->WriteV({{data.data() + 2000, 1000}}));
+  ASSERT_EQ(2, raw->num_writes());
+
+  int64_t position;
+  ASSERT_OK(stream->Tell(&position));
+  ASSERT_EQ(3000, position);
+  ASSERT_OK(stream->Close());
+  ASSERT_EQ(data, raw->written());
+}
+
+TEST(TestBufferedOutputStream, InvalidBufferSize) {
+  std::shared_ptr<BufferedOutputStream> stream;
+  ASSERT_RAISES(Invalid,
+      BufferedOutputStream::Create(std::make_shared<CountingOutputStream>(), 0, &stream));
+}
+
+TEST(TestBufferedInputStream, SmallReads) {
+  const std::vector<uint8_t> data = MakeData(10000);
+  auto raw = std::make_shared<CountingInputStream>(data);
+  std::shared_ptr<BufferedInputStream> stream;
+  ASSERT_OK(BufferedInputStream::Create(raw, 1000, &stream));
+
+  std::vector<uint8_t> read(data.size() + 10);
+  int64_t bytes_read;
+  for (size_t pos = 0; pos < read.size(); pos += 10) {
+    ASSERT_OK(stream->Read(10, &bytes_read, read.data() + pos));
+    ASSERT_EQ(pos < data.size() ? 10 : 0, bytes_read);
+  }
+  // One read per buffer, and one reaching the end
+  ASSERT_EQ(11, raw->num_reads());
+  read.resize(data.size());
+  ASSERT_EQ(data, read);
+
+  int64_t position;
+  ASSERT_OK(stream->Tell(&position));
+  ASSERT_EQ(10000, position);
+  ASSERT_OK(stream->Close());
+  ASSERT_RAISES(IOError, stream->Read(10, &bytes_read, read.data()));
+}
+
+TEST(TestBufferedInputStream, LargeReadsPassThrough) {
+  const std::vector<uint8_t> data = MakeData(10000);
+  auto raw = std::make_shared<CountingInputStream>(data);
+  std::shared_ptr<BufferedInputStream> stream;
+  ASSERT_OK(BufferedInputStream::Create(raw, 1000, &stream));
+
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_OK(stream->Read(5, &buffer));
+  ASSERT_EQ(1, raw->num_reads());
+  ASSERT_OK(stream->Read(5000, &buffer));
+  // The buffered bytes, then the rest read as is
+  ASSERT_EQ(2, raw->num_reads());
+  ASSERT_EQ(5000, buffer->size());
+  ASSERT_EQ(0, memcmp(data.data() + 5, buffer->data(), 5000));
+
+  ASSERT_OK(stream->Read(100000, &buffer));
+  ASSERT_EQ(4995, buffer->size());
+  ASSERT_EQ(0, memcmp(data.data() + 5005, buffer->data(), 4995));
+}
+
+TEST(TestBufferedInputStream, Peek) {
+  const std::vector<uint8_t> data = MakeData(2500);
+  auto raw = std::make_shared<CountingInputStream>(data);
+  std::shared_ptr<BufferedInputStream> stream;
+  ASSERT_OK(BufferedInputStream::Create(raw, 1000, &stream));
+
+  std::shared_ptr<Buffer> peeked;
+  ASSERT_OK(stream->Peek(10, &peeked));
+  ASSERT_EQ(10, peeked->size());
+  ASSERT_EQ(0, memcmp(data.data(), peeked->data(), 10));
+  ASSERT_EQ(1000, stream->bytes_buffered());
+
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_OK(stream->Read(900, &buffer));
+  // Peeking past the buffered bytes refills the buffer, at most buffer_size
+  ASSERT_OK(stream->Peek(5000, &peeked));
+  ASSERT_EQ(1000, peeked->size());
+  ASSERT_EQ(0, memcmp(data.data() + 900, peeked->data(), 1000));
+  ASSERT_EQ(2, raw->num_reads());
+
+  int64_t position;
+  ASSERT_OK(stream->Tell(&position));
+  ASSERT_EQ(900, position);
+
+  ASSERT_OK(stream->Read(1500, &buffer));
+  ASSERT_EQ(0, memcmp(data.data() + 900, buffer->data(), 1500));
+  ASSERT_OK(stream->Peek(1000, &peeked));
+  ASSERT_EQ(100, peeked->size());
+  ASSERT_EQ(0, memcmp(data.data() + 2400, peeked->data(), 100));
+}
+
+TEST(TestBufferedInputStream, SetBufferSize) {
+  const std::vector<uint8_t> data = MakeData(5000);
+  auto raw = std::make_shared<CountingInputStream>(data);
+  std::shared_ptr<BufferedInputStream> stream;
+  ASSERT_OK(BufferedInputStream::Create(raw, 1000, &stream));
+
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_OK(stream->Read(600, &buffer));
+  ASSERT_RAISES(Invalid, stream->SetBufferSize(399));
+  ASSERT_OK(stream->SetBufferSize(400));
+  ASSERT_OK(stream->SetBufferSize(2000));
+  ASSERT_EQ(2000, stream->buffer_size());
+  ASSERT_OK(stream->Read(4400, &buffer));
+  ASSERT_EQ(4400, buffer->size());
+  ASSERT_EQ(0, memcmp(data.data() + 600, buffer->data(), 4400));
+}
+
+}  // namespace io
+}  // namespace arrow
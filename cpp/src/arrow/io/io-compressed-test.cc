@@ -0,0 +1,216 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "arrow/buffer.h"
+#include "arrow/io/compressed.h"
+#include "arrow/io/memory.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/test-util.h"
+#include "arrow/util/compression.h"
+
+namespace arrow {
+namespace io {
+
+// Random bytes, and compressible text
+static std::vector<uint8_t> MakeData(int64_t size, bool compressible) {
+  std::vector<uint8_t> data(size);
+  if (compressible) {
+    const std::string text = "the quick brown fox jumps over the lazy dog ";
+    for (int64_t i = 0; i < size; ++i) {
+      data[i] = static_cast<uint8_t>(text[(i * 7 + i / 1000) % text.size()]);
+    }
+  } else {
+    test::random_bytes(size, 42, data.data());
+  }
+  return data;
+}
+
+class TestCompressedStream : public ::testing::TestWithParam<Compression::type> {
+ public:
+  void SetUp() { ASSERT_OK(Codec::Create(GetParam(), &codec_)); }
+
+  // Compress data, written in pieces of write_size bytes
+  std::shared_ptr<Buffer> Compress(const std::vector<uint8_t>& data, int64_t write_size) {
+    std::shared_ptr<BufferOutputStream> sink;
+    EXPECT_OK(BufferOutputStream::Create(1024, default_memory_pool(), &sink));
+    std::shared_ptr<CompressedOutputStream> stream;
+    EXPECT_OK(CompressedOutputStream::Open(codec_.get(), sink, &stream));
+
+    const int64_t size = static_cast<int64_t>(data.size());
+    for (int64_t pos = 0; pos < size; pos += write_size) {
+      EXPECT_OK(stream->Write(data.data() + pos, std::min(write_size, size - pos)));
+    }
+    int64_t position;
+    EXPECT_OK(stream->Tell(&position));
+    EXPECT_EQ(size, position);
+    EXPECT_OK(stream->Close());
+
+    std::shared_ptr<Buffer> compressed;
+    EXPECT_OK(sink->Finish(&compressed));
+    return compressed;
+  }
+
+  // Decompress everything, read in pieces of read_size bytes
+  Status Decompress(const std::shared_ptr<Buffer>& compressed, int64_t read_size,
+      std::vector<uint8_t>* out) {
+    std::shared_ptr<CompressedInputStream> stream;
+    RETURN_NOT_OK(CompressedInputStream::Open(
+        codec_.get(), std::make_shared<BufferReader>(compressed), &stream));
+    out->clear();
+    while (true) {
+      std::shared_ptr<Buffer> chunk;
+      RETURN_NOT_OK(stream->Read(read_size, &chunk));
+      if (chunk->size() == 0) { break; }
+      out->insert(out->end(), chunk->data(), chunk->data() + chunk->size());
+    }
+    int64_t position;
+    RETURN_NOT_OK(stream->Tell(&position));
+    EXPECT_EQ(static_cast<int64_t>(out->size()), position);
+    return stream->Close();
+  }
+
+  void CheckRoundTrip(
+      const std::vector<uint8_t>& data, int64_t write_size, int64_t read_size) {
+    std::shared_ptr<Buffer> compressed = Compress(data, write_size);
+    std::vector<uint8_t> decompressed;
+    ASSERT_OK(Decompress(compressed, read_size, &decompressed));
+    ASSERT_EQ(data, decompressed);
+  }
+
+ protected:
+  std::unique_ptr<Codec> codec_;
+};
+
+TEST_P(TestCompressedStream, RoundTrip) {
+  for (bool compressible : {false, true}) {
+    const std::vector<uint8_t> data = MakeData(300000, compressible);
+    CheckRoundTrip(data, 300000, 300000);
+    CheckRoundTrip(data, 1000, 3);
+    CheckRoundTrip(data, 70001, 100000);
+  }
+}
+
+TEST_P(TestCompressedStream, Empty) {
+  CheckRoundTrip({}, 1, 1);
+
+  // An empty input is an empty stream
+  std::vector<uint8_t> decompressed;
+  ASSERT_OK(Decompress(std::make_shared<Buffer>(nullptr, 0), 100, &decompressed));
+  ASSERT_EQ(0, decompressed.size());
+}
+
+TEST_P(TestCompressedStream, HighlyCompressible) {
+  // Expands more than the decompression buffers at a time
+  std::vector<uint8_t> data(5 << 20, 'x');
+  std::shared_ptr<Buffer> compressed = Compress(data, 1 << 20);
+  ASSERT_LT(compressed->size(), 1 << 20);
+  std::vector<uint8_t> decompressed;
+  ASSERT_OK(Decompress(compressed, 1 << 22, &decompressed));
+  ASSERT_EQ(data, decompressed);
+}
+
+TEST_P(TestCompressedStream, Concatenated) {
+  const std::vector<uint8_t> data1 = MakeData(100000, true);
+  const std::vector<uint8_t> data2 = MakeData(5000, false);
+  std::shared_ptr<Buffer> compressed1 = Compress(data1, 4096);
+  std::shared_ptr<Buffer> compressed2 = Compress(data2, 4096);
+
+  std::vector<uint8_t> concatenated(
+      compressed1->data(), compressed1->data() + compressed1->size());
+  concatenated.insert(
+      concatenated.end(), compressed2->data(), compressed2->data() + compressed2->size());
+  std::vector<uint8_t> decompressed;
+  ASSERT_OK(Decompress(std::make_shared<Buffer>(concatenated.data(),
+                           static_cast<int64_t>(concatenated.size())),
+      999, &decompressed));
+
+  std::vector<uint8_t> expected(data1);
+  expected.insert(expected.end(), data2.begin(), data2.end());
+  ASSERT_EQ(expected, decompressed);
+}
+
+TEST_P(TestCompressedStream, Truncated) {
+  const std::vector<uint8_t> data = MakeData(100000, true);
+  std::shared_ptr<Buffer> compressed = Compress(data, 100000);
+  std::vector<uint8_t> decompressed;
+  ASSERT_RAISES(IOError, Decompress(SliceBuffer(compressed, 0, compressed->size() / 2),
+      4096, &decompressed));
+}
+
+TEST_P(TestCompressedStream, Flush) {
+  // Flushed data can be decompressed without the end of the stream
+  const std::vector<uint8_t> data = MakeData(10000, true);
+  std::shared_ptr<BufferOutputStream> sink;
+  ASSERT_OK(BufferOutputStream::Create(1024, default_memory_pool(), &sink));
+  std::shared_ptr<CompressedOutputStream> stream;
+  ASSERT_OK(CompressedOutputStream::Open(codec_.get(), sink, &stream));
+  ASSERT_OK(stream->Write(data.data(), static_cast<int64_t>(data.size())));
+  ASSERT_OK(stream->Flush());
+
+  int64_t flushed_size;
+  ASSERT_OK(sink->Tell(&flushed_size));
+  ASSERT_GT(flushed_size, 0);
+  ASSERT_OK(stream->Close());
+  std::shared_ptr<Buffer> compressed;
+  ASSERT_OK(sink->Finish(&compressed));
+
+  std::shared_ptr<CompressedInputStream> input;
+  ASSERT_OK(CompressedInputStream::Open(codec_.get(),
+      std::make_shared<BufferReader>(SliceBuffer(compressed, 0, flushed_size)), &input));
+  std::vector<uint8_t> decompressed(data.size());
+  int64_t bytes_read;
+  ASSERT_OK(input->Read(
+      static_cast<int64_t>(data.size()), &bytes_read, decompressed.data()));
+  ASSERT_EQ(static_cast<int64_t>(data.size()), bytes_read);
+  ASSERT_EQ(data, decompressed);
+}
+
+TEST_P(TestCompressedStream, Closed) {
+  std::shared_ptr<BufferOutputStream> sink;
+  ASSERT_OK(BufferOutputStream::Create(1024, default_memory_pool(), &sink));
+  std::shared_ptr<CompressedOutputStream> stream;
+  ASSERT_OK(CompressedOutputStream::Open(codec_.get(), sink, &stream));
+  ASSERT_OK(stream->Close());
+  ASSERT_OK(stream->Close());
+  const uint8_t data[] = {1, 2, 3};
+  ASSERT_RAISES(IOError, stream->Write(data, 3));
+}
+
+INSTANTIATE_TEST_CASE_P(StreamingCodecs, TestCompressedStream,
+    ::testing::Values(
+        Compression::GZIP, Compression::BROTLI, Compression::ZSTD, Compression::LZ4));
+
+TEST(TestCompressedStreamCodecs, NotImplemented) {
+  std::unique_ptr<Codec> codec;
+  ASSERT_OK(Codec::Create(Compression::SNAPPY, &codec));
+  std::shared_ptr<BufferOutputStream> sink;
+  ASSERT_OK(BufferOutputStream::Create(1024, default_memory_pool(), &sink));
+  std::shared_ptr<CompressedOutputStream> stream;
+  ASSERT_RAISES(NotImplemented, CompressedOutputStream::Open(codec.get(), sink, &stream));
+}
+
+}  // namespace io
+}  // namespace arrow
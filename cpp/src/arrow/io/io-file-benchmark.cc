@@ -0,0 +1,249 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/api.h"
+#include "arrow/io/buffered.h"
+#include "arrow/io/file.h"
+#include "arrow/test-util.h"
+
+#include "benchmark/benchmark.h"
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace arrow {
+
+constexpr int64_t kFileSize = 64 * 1024 * 1024;  // 64MB
+constexpr int64_t kReadSize = 64 * 1024;
+
+// A file of random bytes, opened both ways, removed at exit
+class BenchmarkFile {
+ public:
+  BenchmarkFile() : path_("io-file-benchmark-data") {
+    std::vector<uint8_t> data(kFileSize);
+    test::random_bytes(kFileSize, 0, data.data());
+    std::shared_ptr<io::FileOutputStream> stream;
+    ABORT_NOT_OK(io::FileOutputStream::Open(path_, &stream));
+    ABORT_NOT_OK(stream->Write(data.data(), kFileSize));
+    ABORT_NOT_OK(stream->Close());
+    ABORT_NOT_OK(io::ReadableFile::Open(path_, &readable_file_));
+    ABORT_NOT_OK(io::MemoryMappedFile::Open(path_, io::FileMode::READ, &mapped_file_));
+  }
+
+  ~BenchmarkFile() {
+    readable_file_.reset();
+    mapped_file_.reset();
+    std::remove(path_.c_str());
+  }
+
+  io::ReadableFile* readable_file() { return readable_file_.get(); }
+  io::MemoryMappedFile* mapped_file() { return mapped_file_.get(); }
+  const std::string& path() const { return path_; }
+
+  // Offsets spread over the file, shared by all threads
+  int64_t NextPosition() {
+    const int64_t i = next_read_.fetch_add(1);
+    return (i * 104729 * kReadSize) % (kFileSize - kReadSize);
+  }
+
+ private:
+  std::string path_;
+  std::shared_ptr<io::ReadableFile> readable_file_;
+  std::shared_ptr<io::MemoryMappedFile> mapped_file_;
+  std::atomic<int64_t> next_read_{0};
+};
+
+static BenchmarkFile* GetBenchmarkFile() {
+  static BenchmarkFile file;
+  return &file;
+}
+
+// Arguments: whether to use ReadableFile::ReadAt rather than the locking
+// RandomAccessFile::ReadAt
+static void BM_ReadableFileReadAt(
+    benchmark::State& state) {  // NOLINT non-const reference
+  BenchmarkFile* file = GetBenchmarkFile();
+  std::vector<uint8_t> out(kReadSize);
+  int64_t bytes_read;
+
+  while (state.KeepRunning()) {
+    const int64_t position = file->NextPosition();
+    if (state.range(0)) {
+      ABORT_NOT_OK(
+          file->readable_file()->ReadAt(position, kReadSize, &bytes_read, out.data()));
+    } else {
+      ABORT_NOT_OK(file->readable_file()->RandomAccessFile::ReadAt(
+          position, kReadSize, &bytes_read, out.data()));
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * kReadSize);
+}
+
+// Arguments: whether to use MemoryMappedFile::ReadAt rather than the locking
+// RandomAccessFile::ReadAt
+static void BM_MemoryMappedFileReadAt(
+    benchmark::State& state) {  // NOLINT non-const reference
+  BenchmarkFile* file = GetBenchmarkFile();
+  std::shared_ptr<Buffer> out;
+
+  while (state.KeepRunning()) {
+    const int64_t position = file->NextPosition();
+    if (state.range(0)) {
+      ABORT_NOT_OK(file->mapped_file()->ReadAt(position, kReadSize, &out));
+    } else {
+      ABORT_NOT_OK(
+          file->mapped_file()->RandomAccessFile::ReadAt(position, kReadSize, &out));
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * kReadSize);
+}
+
+constexpr int64_t kSmallIOSize = 64;
+constexpr int64_t kSmallIOTotal = 1 << 20;
+
+// Streams counting the calls reaching the file, each being a system call
+class CountingOutputStream : public io::OutputStream {
+ public:
+  explicit CountingOutputStream(const std::shared_ptr<io::OutputStream>& raw)
+      : raw_(raw), num_calls_(0) {}
+
+  Status Close() override { return raw_->Close(); }
+  Status Tell(int64_t* position) override { return raw_->Tell(position); }
+  Status Write(const uint8_t* data, int64_t nbytes) override {
+    ++num_calls_;
+    return raw_->Write(data, nbytes);
+  }
+
+  int64_t num_calls() const { return num_calls_; }
+
+ private:
+  std::shared_ptr<io::OutputStream> raw_;
+  int64_t num_calls_;
+};
+
+class CountingInputStream : public io::InputStream {
+ public:
+  explicit CountingInputStream(const std::shared_ptr<io::InputStream>& raw)
+      : raw_(raw), num_calls_(0) {}
+
+  // Leaves the file open to be read again
+  Status Close() override { return Status::OK(); }
+  Status Tell(int64_t* position) override { return raw_->Tell(position); }
+  Status Read(int64_t nbytes, int64_t* bytes_read, uint8_t* out) override {
+    ++num_calls_;
+    return raw_->Read(nbytes, bytes_read, out);
+  }
+  Status Read(int64_t nbytes, std::shared_ptr<Buffer>* out) override {
+    ++num_calls_;
+    return raw_->Read(nbytes, out);
+  }
+
+  int64_t num_calls() const { return num_calls_; }
+
+ private:
+  std::shared_ptr<io::InputStream> raw_;
+  int64_t num_calls_;
+};
+
+static void SetCallsLabel(benchmark::State& state,  // NOLINT non-const reference
+    int64_t num_calls) {
+  std::stringstream ss;
+  ss << static_cast<double>(num_calls) / static_cast<double>(state.iterations())
+     << " syscalls/MB";
+  state.SetLabel(ss.str());
+}
+
+// Writes of 64 bytes to a FileOutputStream
+//
+// Arguments: the size of the BufferedOutputStream wrapping it, 0 for none
+static void BM_FileOutputStreamSmallWrites(
+    benchmark::State& state) {  // NOLINT non-const reference
+  const std::string path = "io-file-benchmark-output";
+  std::vector<uint8_t> data(kSmallIOSize);
+  test::random_bytes(kSmallIOSize, 0, data.data());
+
+  std::shared_ptr<io::FileOutputStream> file;
+  ABORT_NOT_OK(io::FileOutputStream::Open(path, &file));
+  auto counting = std::make_shared<CountingOutputStream>(file);
+  std::shared_ptr<io::OutputStream> stream = counting;
+  if (state.range(0) > 0) {
+    std::shared_ptr<io::BufferedOutputStream> buffered;
+    ABORT_NOT_OK(io::BufferedOutputStream::Create(counting, state.range(0), &buffered));
+    stream = buffered;
+  }
+
+  while (state.KeepRunning()) {
+    for (int64_t i = 0; i < kSmallIOTotal; i += kSmallIOSize) {
+      ABORT_NOT_OK(stream->Write(data.data(), kSmallIOSize));
+    }
+  }
+  ABORT_NOT_OK(stream->Close());
+  std::remove(path.c_str());
+  state.SetBytesProcessed(state.iterations() * kSmallIOTotal);
+  SetCallsLabel(state, counting->num_calls());
+}
+
+// Reads of 64 bytes from a ReadableFile
+//
+// Arguments: the size of the BufferedInputStream wrapping it, 0 for none
+static void BM_ReadableFileSmallReads(
+    benchmark::State& state) {  // NOLINT non-const reference
+  std::shared_ptr<io::ReadableFile> file;
+  ABORT_NOT_OK(io::ReadableFile::Open(GetBenchmarkFile()->path(), &file));
+  std::vector<uint8_t> out(kSmallIOSize);
+  int64_t num_calls = 0;
+
+  while (state.KeepRunning()) {
+    // Each iteration reads the same first MB again
+    state.PauseTiming();
+    ABORT_NOT_OK(file->Seek(0));
+    auto counting = std::make_shared<CountingInputStream>(file);
+    std::shared_ptr<io::InputStream> stream = counting;
+    if (state.range(0) > 0) {
+      std::shared_ptr<io::BufferedInputStream> buffered;
+      ABORT_NOT_OK(io::BufferedInputStream::Create(counting, state.range(0), &buffered));
+      stream = buffered;
+    }
+    state.ResumeTiming();
+
+    int64_t bytes_read;
+    for (int64_t i = 0; i < kSmallIOTotal; i += kSmallIOSize) {
+      ABORT_NOT_OK(stream->Read(kSmallIOSize, &bytes_read, out.data()));
+    }
+    num_calls += counting->num_calls();
+  }
+  state.SetBytesProcessed(state.iterations() * kSmallIOTotal);
+  SetCallsLabel(state, num_calls);
+}
+
+BENCHMARK(BM_ReadableFileReadAt)->Arg(false)->Arg(true)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK(BM_MemoryMappedFileReadAt)
+    ->Arg(false)
+    ->Arg(true)
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+BENCHMARK(BM_FileOutputStreamSmallWrites)->Arg(0)->Arg(4096)->Arg(64 * 1024);
+
+BENCHMARK(BM_ReadableFileSmallReads)->Arg(0)->Arg(4096)->Arg(64 * 1024);
+
+}  // namespace arrow
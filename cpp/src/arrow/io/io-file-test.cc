@@ -15,6 +15,7 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 #include <cstdio>
@@ -27,6 +28,7 @@
 #include <sstream>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -162,6 +164,37 @@ TEST_F(TestFileOutputStream, Tell) {
   ASSERT_EQ(8, position);
 }
 
+TEST_F(TestFileOutputStream, WriteV) {
+  OpenFile();
+
+  // More buffers than a single writev takes, some empty
+  const int64_t num_buffers = 3000;
+  std::vector<uint8_t> data(num_buffers * 3);
+  test::random_bytes(static_cast<int64_t>(data.size()), 0, data.data());
+  std::vector<WriteRange> buffers;
+  std::vector<uint8_t> expected;
+  for (int64_t i = 0; i < num_buffers; ++i) {
+    const int64_t length = i % 4;
+    buffers.emplace_back(data.data() + i * 3, length);
+    expected.insert(expected.end(), data.data() + i * 3, data.data() + i * 3 + length);
+  }
+  ASSERT_OK(file_->WriteV(buffers));
+  ASSERT_OK(file_->WriteV({}));
+
+  int64_t position;
+  ASSERT_OK(file_->Tell(&position));
+  ASSERT_EQ(static_cast<int64_t>(expected.size()), position);
+  ASSERT_RAISES(IOError, file_->WriteV({{data.data(), -1}}));
+  ASSERT_OK(file_->Close());
+
+  std::shared_ptr<ReadableFile> rd_file;
+  ASSERT_OK(ReadableFile::Open(path_, &rd_file));
+  std::shared_ptr<Buffer> contents;
+  ASSERT_OK(rd_file->Read(position + 1, &contents));
+  ASSERT_EQ(position, contents->size());
+  ASSERT_EQ(0, memcmp(expected.data(), contents->data(), position));
+}
+
 TEST_F(TestFileOutputStream, TruncatesNewFile) {
   ASSERT_OK(FileOutputStream::Open(path_, &file_));
 
@@ -288,17 +321,18 @@ TEST_F(TestReadableFile, ReadAt) {
   ASSERT_EQ(4, bytes_read);
   ASSERT_EQ(0, std::memcmp(buffer, "test", 4));
 
-  // position advanced
+  // position unchanged
   ASSERT_OK(file_->Tell(&position));
-  ASSERT_EQ(4, position);
+  ASSERT_EQ(0, position);
 
   ASSERT_OK(file_->ReadAt(4, 10, &bytes_read, buffer));
   ASSERT_EQ(4, bytes_read);
   ASSERT_EQ(0, std::memcmp(buffer, "data", 4));
 
-  // position advanced to EOF
-  ASSERT_OK(file_->Tell(&position));
-  ASSERT_EQ(8, position);
+  // past EOF
+  ASSERT_OK(file_->ReadAt(100, 10, &bytes_read, buffer));
+  ASSERT_EQ(0, bytes_read);
+  ASSERT_RAISES(Invalid, file_->ReadAt(-1, 10, &bytes_read, buffer));
 
   // Check buffer API
   std::shared_ptr<Buffer> buffer2;
@@ -309,9 +343,14 @@ TEST_F(TestReadableFile, ReadAt) {
   Buffer expected(reinterpret_cast<const uint8_t*>(test_data), 4);
   ASSERT_TRUE(buffer2->Equals(expected));
 
-  // position advanced
+  ASSERT_OK(file_->ReadAt(6, 4, &buffer2));
+  ASSERT_EQ(2, buffer2->size());
+
+  // Reads continue from the unchanged position
   ASSERT_OK(file_->Tell(&position));
-  ASSERT_EQ(4, position);
+  ASSERT_EQ(0, position);
+  ASSERT_OK(file_->Read(4, &bytes_read, buffer));
+  ASSERT_EQ(0, std::memcmp(buffer, "test", 4));
 }
 
 TEST_F(TestReadableFile, NonExistentFile) {
@@ -395,6 +434,88 @@ TEST_F(TestReadableFile, ThreadSafety) {
   ASSERT_EQ(niter * 2, correct_count);
 }
 
+TEST_F(TestReadableFile, ConcurrentReadAt) {
+  const int64_t size = 1 << 20;
+  std::vector<uint8_t> data(size);
+  test::random_bytes(size, 0, data.data());
+  {
+    std::ofstream stream(path_.c_str(), std::ios::binary);
+    stream.write(reinterpret_cast<const char*>(data.data()), size);
+  }
+  OpenFile();
+
+  // Every thread reads its own ranges, while the main thread reads on
+  std::atomic<int> correct_count(0);
+  const int nthreads = 4;
+  const int niter = 100;
+  auto ReadRanges = [&correct_count, &data, size, niter, this](int thread_index) {
+    std::shared_ptr<Buffer> buffer;
+    for (int i = 0; i < niter; ++i) {
+      const int64_t position = (thread_index * 7919 + i * 104729) % (size - 1000);
+      ASSERT_OK(file_->ReadAt(position, 1000, &buffer));
+      if (buffer->size() == 1000 &&
+          0 == memcmp(data.data() + position, buffer->data(), 1000)) {
+        correct_count += 1;
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nthreads; ++i) {
+    threads.emplace_back(ReadRanges, i);
+  }
+
+  std::vector<uint8_t> sequential(size);
+  int64_t total_read = 0;
+  while (total_read < size) {
+    int64_t bytes_read;
+    ASSERT_OK(file_->Read(4096, &bytes_read, sequential.data() + total_read));
+    ASSERT_GT(bytes_read, 0);
+    total_read += bytes_read;
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(nthreads * niter, correct_count);
+  ASSERT_EQ(data, sequential);
+}
+
+TEST_F(TestReadableFile, ReadRanges) {
+  const int64_t size = 100000;
+  std::vector<uint8_t> data(size);
+  test::random_bytes(size, 0, data.data());
+  {
+    std::ofstream stream(path_.c_str(), std::ios::binary);
+    stream.write(reinterpret_cast<const char*>(data.data()), size);
+  }
+  OpenFile();
+
+  const std::vector<ReadRange> ranges = {
+      {90000, 20000}, {10, 100}, {0, 20}, {50000, 1000}, {52000, 0}, {51000, 10}};
+  ASSERT_OK(file_->WillNeed(ranges));
+  std::vector<std::shared_ptr<Buffer>> buffers;
+  ASSERT_OK(file_->ReadRanges(ranges, ReadRangeOptions(), &buffers));
+  ASSERT_EQ(ranges.size(), buffers.size());
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    const int64_t length = std::min(ranges[i].length, size - ranges[i].offset);
+    ASSERT_EQ(length, buffers[i]->size()) << i;
+    ASSERT_EQ(0, memcmp(data.data() + ranges[i].offset, buffers[i]->data(), length));
+  }
+  // The first two ranges were read as one
+  ASSERT_EQ(buffers[2]->data() + 10, buffers[1]->data());
+  // Invalid ranges are reported by the reads, not by the prefetch hint
+  ASSERT_RAISES(Invalid, file_->ReadRanges({{-1, 10}}, ReadRangeOptions(), &buffers));
+
+  int64_t position;
+  ASSERT_OK(file_->Tell(&position));
+  ASSERT_EQ(0, position);
+
+  // Empty ranges are skipped rather than advised up to the end of the file,
+  // so they succeed even once the descriptor is gone
+  ASSERT_OK(file_->Close());
+  ASSERT_OK(file_->WillNeed({{0, 0}, {size, 0}}));
+}
+
 // ----------------------------------------------------------------------
 // Memory map tests
 
@@ -462,6 +583,204 @@ TEST_F(TestMemoryMappedFile, ReadOnly) {
   ASSERT_OK(rommap->Close());
 }
 
+TEST_F(TestMemoryMappedFile, ReadAt) {
+  const int64_t size = 1024;
+  std::vector<uint8_t> data(size);
+  test::random_bytes(size, 0, data.data());
+
+  std::string path = "ipc-read-at-test";
+  std::shared_ptr<MemoryMappedFile> mmap;
+  ASSERT_OK(InitMemoryMap(size, path, &mmap));
+  ASSERT_OK(mmap->Write(data.data(), size));
+  ASSERT_OK(mmap->Seek(10));
+
+  // Zero copy, and the position is left alone
+  std::shared_ptr<Buffer> first, second;
+  ASSERT_OK(mmap->ReadAt(100, 200, &first));
+  ASSERT_OK(mmap->ReadAt(300, 200, &second));
+  ASSERT_EQ(0, memcmp(data.data() + 100, first->data(), 200));
+  ASSERT_EQ(first->data() + 200, second->data());
+  int64_t position;
+  ASSERT_OK(mmap->Tell(&position));
+  ASSERT_EQ(10, position);
+
+  uint8_t out[100];
+  int64_t bytes_read;
+  ASSERT_OK(mmap->ReadAt(size - 50, 100, &bytes_read, out));
+  ASSERT_EQ(50, bytes_read);
+  ASSERT_EQ(0, memcmp(data.data() + size - 50, out, 50));
+  ASSERT_OK(mmap->ReadAt(size + 10, 100, &first));
+  ASSERT_EQ(0, first->size());
+  ASSERT_RAISES(Invalid, mmap->ReadAt(-1, 100, &first));
+}
+
+TEST_F(TestMemoryMappedFile, ReadRanges) {
+  const int64_t size = 1024;
+  std::vector<uint8_t> data(size);
+  test::random_bytes(size, 0, data.data());
+
+  std::string path = "ipc-read-ranges-test";
+  std::shared_ptr<MemoryMappedFile> mmap;
+  ASSERT_OK(InitMemoryMap(size, path, &mmap));
+  ASSERT_OK(mmap->Write(data.data(), size));
+
+  const std::vector<ReadRange> ranges = {{500, 100}, {0, 10}, {1000, 100}};
+  ASSERT_OK(mmap->WillNeed(ranges));
+  std::vector<std::shared_ptr<Buffer>> buffers;
+  ASSERT_OK(mmap->ReadRanges(ranges, ReadRangeOptions(), &buffers));
+  ASSERT_EQ(3, buffers.size());
+  ASSERT_EQ(buffers[1]->data() + 500, buffers[0]->data());
+  ASSERT_EQ(0, memcmp(data.data() + 500, buffers[0]->data(), 100));
+  ASSERT_EQ(24, buffers[2]->size());
+  ASSERT_RAISES(Invalid, mmap->ReadRanges({{-1, 10}}, ReadRangeOptions(), &buffers));
+}
+
+TEST_F(TestMemoryMappedFile, OpenOptions) {
+  const int64_t size = 100000;
+  std::vector<uint8_t> data(size);
+  test::random_bytes(size, 0, data.data());
+
+  std::string path = "ipc-open-options-test";
+  std::shared_ptr<MemoryMappedFile> rwmmap;
+  ASSERT_OK(InitMemoryMap(size, path, &rwmmap));
+  ASSERT_OK(rwmmap->Write(data.data(), size));
+  ASSERT_OK(rwmmap->Close());
+
+  MemoryMapOptions options;
+  options.populate = true;
+  options.advice = MemoryMapAdvice::SEQUENTIAL;
+  options.huge_pages = true;
+  for (FileMode::type mode : {FileMode::READ, FileMode::READWRITE}) {
+    std::shared_ptr<MemoryMappedFile> mmap;
+    ASSERT_OK(MemoryMappedFile::Open(path, mode, options, &mmap));
+    std::shared_ptr<Buffer> buffer;
+    ASSERT_OK(mmap->Read(size, &buffer));
+    ASSERT_EQ(size, buffer->size());
+    ASSERT_EQ(0, memcmp(data.data(), buffer->data(), size));
+  }
+}
+
+TEST_F(TestMemoryMappedFile, Advise) {
+  const int64_t size = 100000;
+  std::vector<uint8_t> data(size);
+  test::random_bytes(size, 0, data.data());
+
+  std::string path = "ipc-advise-test";
+  std::shared_ptr<MemoryMappedFile> rwmmap;
+  ASSERT_OK(InitMemoryMap(size, path, &rwmmap));
+  ASSERT_OK(rwmmap->Write(data.data(), size));
+  ASSERT_OK(rwmmap->Close());
+
+  std::shared_ptr<MemoryMappedFile> mmap;
+  ASSERT_OK(MemoryMappedFile::Open(path, FileMode::READ, &mmap));
+  ASSERT_OK(mmap->Advise(0, size, MemoryMapAdvice::RANDOM));
+  ASSERT_OK(mmap->WillNeed(5000, 20000));
+  // Unaligned regions and regions past the end are fine
+  ASSERT_OK(mmap->Advise(4097, 100, MemoryMapAdvice::SEQUENTIAL));
+  ASSERT_OK(mmap->Advise(size - 10, 1000, MemoryMapAdvice::NORMAL));
+  ASSERT_OK(mmap->WillNeed(size + 5000, 10));
+
+  // Pages dropped from a read-only mapping are read from the file again
+  ASSERT_OK(mmap->Advise(0, size, MemoryMapAdvice::DONTNEED));
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_OK(mmap->ReadAt(0, size, &buffer));
+  ASSERT_EQ(0, memcmp(data.data(), buffer->data(), size));
+
+  ASSERT_RAISES(Invalid, mmap->Advise(-1, 10, MemoryMapAdvice::WILLNEED));
+  ASSERT_RAISES(Invalid, mmap->WillNeed(0, -1));
+}
+
+TEST_F(TestMemoryMappedFile, Growable) {
+  const int64_t size = 100000;
+  std::vector<uint8_t> data(size);
+  test::random_bytes(size, 0, data.data());
+
+  std::string path = "ipc-growable-test";
+  AppendFile(path);
+  std::shared_ptr<MemoryMappedFile> mmap;
+  ASSERT_OK(MemoryMappedFile::CreateGrowable(path, 4096, &mmap));
+
+  // Buffers read while the file grows stay valid
+  std::vector<std::shared_ptr<Buffer>> buffers;
+  int64_t written = 0;
+  for (int64_t i = 1; written < size; ++i) {
+    const int64_t length = std::min(i * 37, size - written);
+    ASSERT_OK(mmap->Write(data.data() + written, length));
+    written += length;
+    buffers.emplace_back();
+    ASSERT_OK(mmap->ReadAt(0, written, &buffers.back()));
+  }
+  int64_t file_size;
+  ASSERT_OK(mmap->GetSize(&file_size));
+  ASSERT_EQ(size, file_size);
+  for (const auto& buffer : buffers) {
+    ASSERT_EQ(0, memcmp(data.data(), buffer->data(), buffer->size()));
+  }
+
+  // Writing at a position past the end leaves zeros in between
+  ASSERT_OK(mmap->WriteAt(size + 100, data.data(), 10));
+  ASSERT_OK(mmap->GetSize(&file_size));
+  ASSERT_EQ(size + 110, file_size);
+  std::shared_ptr<Buffer> gap;
+  ASSERT_OK(mmap->ReadAt(size, 100, &gap));
+  ASSERT_EQ(100, gap->size());
+  ASSERT_TRUE(std::all_of(
+      gap->data(), gap->data() + 100, [](uint8_t byte) { return byte == 0; }));
+
+  // Close truncates the file to the bytes written
+  ASSERT_OK(mmap->Close());
+  ASSERT_RAISES(IOError, mmap->Write(data.data(), 10));
+  mmap.reset();
+  ASSERT_EQ(0, memcmp(data.data(), buffers.back()->data(), size));
+
+  std::shared_ptr<ReadableFile> file;
+  ASSERT_OK(ReadableFile::Open(path, &file));
+  ASSERT_OK(file->GetSize(&file_size));
+  ASSERT_EQ(size + 110, file_size);
+
+  ASSERT_RAISES(Invalid, MemoryMappedFile::CreateGrowable(path, 0, &mmap));
+}
+
+TEST_F(TestMemoryMappedFile, GrowableConcurrentReads) {
+  const int64_t size = 1 << 20;
+  std::vector<uint8_t> data(size);
+  test::random_bytes(size, 0, data.data());
+
+  std::string path = "ipc-growable-concurrent-test";
+  AppendFile(path);
+  std::shared_ptr<MemoryMappedFile> mmap;
+  ASSERT_OK(MemoryMappedFile::CreateGrowable(path, 4096, &mmap));
+
+  // The file is remapped as it grows, under the readers
+  std::thread writer([&data, &mmap, size]() {
+    for (int64_t written = 0; written < size; written += 1000) {
+      const int64_t length = std::min<int64_t>(1000, size - written);
+      ASSERT_OK(mmap->Write(data.data() + written, length));
+    }
+  });
+  int64_t file_size = 0;
+  while (file_size < size) {
+    ASSERT_OK(mmap->GetSize(&file_size));
+    ASSERT_OK(mmap->WillNeed(0, file_size));
+    ASSERT_OK(mmap->Advise(0, file_size, MemoryMapAdvice::SEQUENTIAL));
+    std::shared_ptr<Buffer> buffer;
+    ASSERT_OK(mmap->ReadAt(0, file_size, &buffer));
+    ASSERT_EQ(file_size, buffer->size());
+    ASSERT_EQ(0, memcmp(data.data(), buffer->data(), file_size));
+  }
+  writer.join();
+  ASSERT_OK(mmap->Close());
+}
+
+TEST_F(TestMemoryMappedFile, WriteAtPastEnd) {
+  std::string path = "ipc-write-at-past-end-test";
+  std::shared_ptr<MemoryMappedFile> mmap;
+  ASSERT_OK(InitMemoryMap(100, path, &mmap));
+  uint8_t data[10] = {0};
+  ASSERT_OK(mmap->WriteAt(90, data, 10));
+  ASSERT_RAISES(Invalid, mmap->WriteAt(95, data, 10));
+}
+
 TEST_F(TestMemoryMappedFile, DISABLED_ReadWriteOver4GbFile) {
   // ARROW-1096
   const int64_t buffer_size = 1000 * 1000;
@@ -15,6 +15,7 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
@@ -115,6 +116,55 @@ TEST(TestBufferReader, RetainParentReference) {
   ASSERT_EQ(0, std::memcmp(slice2->data(), data.c_str() + 4, 6));
 }
 
+static void AssertRanges(const std::vector<ReadRange>& expected,
+    const std::vector<ReadRange>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(expected[i].offset, actual[i].offset) << i;
+    ASSERT_EQ(expected[i].length, actual[i].length) << i;
+  }
+}
+
+TEST(TestCoalesceReadRanges, Basics) {
+  // Merged across small holes, sorted, empty ranges dropped
+  AssertRanges({{0, 30}, {100, 10}},
+      CoalesceReadRanges({{100, 10}, {20, 10}, {0, 15}, {50, 0}}, 5, 1000));
+  // Overlapping and contained ranges
+  AssertRanges({{0, 50}}, CoalesceReadRanges({{0, 40}, {10, 5}, {30, 20}}, 0, 1000));
+  // Size limit, a larger single range being kept whole
+  AssertRanges({{0, 20}, {20, 10}, {30, 100}},
+      CoalesceReadRanges({{0, 10}, {10, 10}, {20, 10}, {30, 100}, {40, 10}}, 0, 20));
+  AssertRanges({}, CoalesceReadRanges({}, 0, 10));
+}
+
+TEST(TestBufferReader, ReadRanges) {
+  const int64_t size = 100000;
+  std::vector<uint8_t> data(size);
+  test::random_bytes(size, 0, data.data());
+  BufferReader reader(std::make_shared<Buffer>(data.data(), size));
+
+  std::vector<ReadRange> ranges = {{5000, 100}, {0, 10}, {20, 10}, {5050, 100},
+      {99990, 100}, {70000, 0}, {30000, 20000}, {40000, 10}};
+  ReadRangeOptions options;
+  options.hole_size_limit = 100;
+  options.range_size_limit = 1000;
+  options.num_threads = 4;
+  std::vector<std::shared_ptr<Buffer>> buffers;
+  ASSERT_OK(reader.ReadRanges(ranges, options, &buffers));
+
+  ASSERT_EQ(ranges.size(), buffers.size());
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    const int64_t offset = ranges[i].offset;
+    const int64_t length = std::min(ranges[i].length, size - offset);
+    ASSERT_EQ(length, buffers[i]->size()) << i;
+    ASSERT_EQ(0, memcmp(data.data() + offset, buffers[i]->data(), length)) << i;
+  }
+
+  ASSERT_RAISES(Invalid, reader.ReadRanges({{-1, 10}}, options, &buffers));
+  ASSERT_RAISES(Invalid, reader.ReadRanges({{0, -1}}, options, &buffers));
+  ASSERT_OK(reader.WillNeed(ranges));
+}
+
 TEST(TestMemcopy, ParallelMemcopy) {
   for (int i = 0; i < 5; ++i) {
     // randomize size so the memcopy alignment is tested
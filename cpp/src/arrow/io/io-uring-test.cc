@@ -0,0 +1,271 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "arrow/buffer.h"
+#include "arrow/io/file.h"
+#include "arrow/io/uring.h"
+#include "arrow/status.h"
+#include "arrow/test-util.h"
+
+namespace arrow {
+namespace io {
+
+class TestUringFile : public ::testing::Test {
+ public:
+  void SetUp() {
+    if (!IsUringSupported()) {
+      std::cout << "io_uring is not supported, skipping" << std::endl;
+      supported_ = false;
+      return;
+    }
+    supported_ = true;
+    path_ = "arrow-test-io-uring-file";
+    std::remove(path_.c_str());
+  }
+
+  void TearDown() { std::remove(path_.c_str()); }
+
+  void WriteTestFile(int64_t size) {
+    data_.resize(size);
+    test::random_bytes(size, 0, data_.data());
+    std::shared_ptr<FileOutputStream> stream;
+    ASSERT_OK(FileOutputStream::Open(path_, &stream));
+    ASSERT_OK(stream->Write(data_.data(), size));
+    ASSERT_OK(stream->Close());
+  }
+
+  void CheckRead(
+      int64_t position, int64_t nbytes, const std::shared_ptr<Buffer>& buffer) {
+    const int64_t size = static_cast<int64_t>(data_.size());
+    const int64_t expected = std::max<int64_t>(std::min(nbytes, size - position), 0);
+    ASSERT_EQ(expected, buffer->size());
+    if (expected > 0) {
+      ASSERT_EQ(0, memcmp(data_.data() + position, buffer->data(), expected));
+    }
+  }
+
+  // Many reads in flight at once, some past the end of the file
+  void CheckAsyncReads(const UringOptions& options) {
+    WriteTestFile(1 << 20);
+    std::shared_ptr<UringReadableFile> file;
+    ASSERT_OK(UringReadableFile::Open(path_, options, &file));
+
+    std::vector<int64_t> positions;
+    std::vector<int64_t> lengths;
+    std::vector<std::unique_ptr<UringReadFuture>> futures;
+    for (int64_t i = 0; i < 100; ++i) {
+      positions.push_back((i * 7919 * 113) % (1 << 20));
+      lengths.push_back((i * 131) % 30000);
+      futures.emplace_back();
+      ASSERT_OK(file->ReadAsync(positions.back(), lengths.back(), &futures.back()));
+    }
+    ASSERT_OK(file->Submit());
+    for (size_t i = futures.size(); i-- > 0;) {
+      std::shared_ptr<Buffer> buffer;
+      ASSERT_OK(futures[i]->Wait(&buffer));
+      CheckRead(positions[i], lengths[i], buffer);
+    }
+    ASSERT_OK(file->Close());
+  }
+
+ protected:
+  bool supported_;
+  std::string path_;
+  std::vector<uint8_t> data_;
+};
+
+TEST_F(TestUringFile, ReadAsync) {
+  if (!supported_) { return; }
+  UringOptions options;
+  options.queue_depth = 8;
+  CheckAsyncReads(options);
+}
+
+TEST_F(TestUringFile, RegisteredBuffers) {
+  if (!supported_) { return; }
+  // Fewer buffers than reads, and reads larger than a buffer
+  UringOptions options;
+  options.queue_depth = 16;
+  options.num_registered_buffers = 4;
+  options.registered_buffer_size = 16 * 1024;
+  CheckAsyncReads(options);
+}
+
+TEST_F(TestUringFile, DirectIO) {
+  if (!supported_) { return; }
+  UringOptions options;
+  options.direct_io = true;
+  WriteTestFile(100);
+  std::shared_ptr<UringReadableFile> file;
+  if (!UringReadableFile::Open(path_, options, &file).ok()) {
+    std::cout << "O_DIRECT is not supported here, skipping" << std::endl;
+    return;
+  }
+  ASSERT_OK(file->Close());
+
+  CheckAsyncReads(options);
+  options.num_registered_buffers = 2;
+  options.registered_buffer_size = 8192;
+  CheckAsyncReads(options);
+}
+
+TEST_F(TestUringFile, RandomAccessFile) {
+  if (!supported_) { return; }
+  WriteTestFile(10000);
+  std::shared_ptr<UringReadableFile> file;
+  ASSERT_OK(UringReadableFile::Open(path_, UringOptions(), &file));
+
+  int64_t size;
+  ASSERT_OK(file->GetSize(&size));
+  ASSERT_EQ(10000, size);
+
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_OK(file->Read(4000, &buffer));
+  CheckRead(0, 4000, buffer);
+  std::vector<uint8_t> out(8000);
+  int64_t bytes_read;
+  ASSERT_OK(file->Read(8000, &bytes_read, out.data()));
+  ASSERT_EQ(6000, bytes_read);
+  ASSERT_EQ(0, memcmp(data_.data() + 4000, out.data(), 6000));
+  int64_t position;
+  ASSERT_OK(file->Tell(&position));
+  ASSERT_EQ(10000, position);
+
+  ASSERT_OK(file->Seek(100));
+  ASSERT_OK(file->ReadAt(9000, 5000, &buffer));
+  CheckRead(9000, 5000, buffer);
+  ASSERT_OK(file->ReadAt(20000, 10, &buffer));
+  ASSERT_EQ(0, buffer->size());
+  ASSERT_OK(file->Tell(&position));
+  ASSERT_EQ(100, position);
+  ASSERT_RAISES(Invalid, file->ReadAt(-1, 10, &buffer));
+
+  std::vector<ReadRange> ranges = {{5000, 10}, {0, 100}, {9990, 100}, {30, 0}};
+  std::vector<std::shared_ptr<Buffer>> buffers;
+  ASSERT_OK(file->ReadRanges(ranges, ReadRangeOptions(), &buffers));
+  ASSERT_EQ(ranges.size(), buffers.size());
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    CheckRead(ranges[i].offset, ranges[i].length, buffers[i]);
+  }
+
+  ASSERT_OK(file->Close());
+  ASSERT_RAISES(IOError, file->ReadAt(0, 10, &buffer));
+}
+
+TEST_F(TestUringFile, ConcurrentWaits) {
+  if (!supported_) { return; }
+  WriteTestFile(1 << 20);
+  UringOptions options;
+  options.queue_depth = 4;
+  std::shared_ptr<UringReadableFile> file;
+  ASSERT_OK(UringReadableFile::Open(path_, options, &file));
+
+  std::vector<std::thread> threads;
+  std::vector<Status> statuses(4);
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([this, t, &file, &statuses]() {
+      for (int64_t i = 0; i < 50 && statuses[t].ok(); ++i) {
+        const int64_t position = ((i * 4 + t) * 7919 * 97) % (1 << 20);
+        std::shared_ptr<Buffer> buffer;
+        statuses[t] = file->ReadAt(position, 4096, &buffer);
+        if (statuses[t].ok() &&
+            memcmp(data_.data() + position, buffer->data(), buffer->size()) != 0) {
+          statuses[t] = Status::Invalid("Read the wrong bytes");
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const Status& status : statuses) {
+    ASSERT_OK(status);
+  }
+}
+
+TEST_F(TestUringFile, AbandonedReads) {
+  if (!supported_) { return; }
+  WriteTestFile(100000);
+  UringOptions options;
+  options.num_registered_buffers = 1;
+  std::shared_ptr<UringReadableFile> file;
+  ASSERT_OK(UringReadableFile::Open(path_, options, &file));
+  for (int i = 0; i < 10; ++i) {
+    std::unique_ptr<UringReadFuture> future;
+    ASSERT_OK(file->ReadAsync(i * 1000, 1000, &future));
+  }
+  std::shared_ptr<Buffer> buffer;
+  ASSERT_OK(file->ReadAt(500, 1000, &buffer));
+  CheckRead(500, 1000, buffer);
+}
+
+TEST_F(TestUringFile, OutputStream) {
+  if (!supported_) { return; }
+  std::vector<uint8_t> data(1 << 20);
+  test::random_bytes(static_cast<int64_t>(data.size()), 1, data.data());
+
+  UringOptions options;
+  options.queue_depth = 4;
+  std::shared_ptr<UringOutputStream> stream;
+  ASSERT_OK(UringOutputStream::Open(path_, options, &stream));
+  int64_t written = 0;
+  for (int64_t i = 0; written < static_cast<int64_t>(data.size()); ++i) {
+    const int64_t length =
+        std::min<int64_t>(i * 97 % 5000, static_cast<int64_t>(data.size()) - written);
+    ASSERT_OK(stream->Write(data.data() + written, length));
+    written += length;
+  }
+  int64_t position;
+  ASSERT_OK(stream->Tell(&position));
+  ASSERT_EQ(static_cast<int64_t>(data.size()), position);
+  ASSERT_OK(stream->Flush());
+  ASSERT_OK(stream->Close());
+  ASSERT_RAISES(IOError, stream->Write(data.data(), 1));
+
+  std::shared_ptr<ReadableFile> file;
+  ASSERT_OK(ReadableFile::Open(path_, &file));
+  std::shared_ptr<Buffer> contents;
+  ASSERT_OK(file->Read(position + 1, &contents));
+  ASSERT_EQ(position, contents->size());
+  ASSERT_EQ(0, memcmp(data.data(), contents->data(), position));
+}
+
+TEST_F(TestUringFile, InvalidOptions) {
+  if (!supported_) { return; }
+  UringOptions options;
+  options.queue_depth = 0;
+  std::shared_ptr<UringOutputStream> stream;
+  ASSERT_RAISES(Invalid, UringOutputStream::Open(path_, options, &stream));
+  std::shared_ptr<UringReadableFile> file;
+  ASSERT_RAISES(IOError,
+      UringReadableFile::Open("nonexistent-io-uring-file", UringOptions(), &file));
+}
+
+}  // namespace io
+}  // namespace arrow
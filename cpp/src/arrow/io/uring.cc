@@ -0,0 +1,867 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/io/uring.h"
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "arrow/buffer.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/util/logging.h"
+#include "arrow/util/macros.h"
+
+namespace arrow {
+namespace io {
+
+UringOptions::UringOptions()
+    : queue_depth(64),
+      direct_io(false),
+      num_registered_buffers(0),
+      registered_buffer_size(1 << 20) {}
+
+// Largest length of a single read or write, longer ones being made in pieces
+static constexpr int64_t kMaxUringChunk = 1 << 30;
+
+static Status ErrnoStatus(const std::string& what, int errnum) {
+  std::stringstream ss;
+  ss << what << ": " << strerror(errnum);
+  return Status::IOError(ss.str());
+}
+
+static inline int64_t AlignDown(int64_t value) {
+  return value & ~(kUringDirectAlignment - 1);
+}
+
+static inline int64_t AlignUp(int64_t value) {
+  return AlignDown(value + kUringDirectAlignment - 1);
+}
+
+static inline uint8_t* AlignUp(uint8_t* data) {
+  return reinterpret_cast<uint8_t*>(AlignUp(reinterpret_cast<int64_t>(data)));
+}
+
+// There is no glibc wrapper for the io_uring system calls
+
+static int UringSetup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int UringEnter(int ring_fd, unsigned to_submit, unsigned min_complete,
+    unsigned flags) {
+  return static_cast<int>(
+      syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+static int UringRegister(
+    int ring_fd, unsigned opcode, const void* arg, unsigned nr_args) {
+  return static_cast<int>(
+      syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args));
+}
+
+bool IsUringSupported() {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  const int ring_fd = UringSetup(1, &params);
+  if (ring_fd < 0) { return false; }
+
+  // The opcodes used were only added in Linux 5.6, as was the probe, which
+  // older kernels reject
+  const size_t probe_size =
+      sizeof(io_uring_probe) + IORING_OP_LAST * sizeof(io_uring_probe_op);
+  std::vector<uint64_t> probe_data(
+      (probe_size + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+  auto probe = reinterpret_cast<io_uring_probe*>(probe_data.data());
+  const bool probed = UringRegister(ring_fd, IORING_REGISTER_PROBE, probe,
+                          static_cast<unsigned>(IORING_OP_LAST)) >= 0;
+  close(ring_fd);
+  if (!probed) { return false; }
+  for (int opcode : {IORING_OP_READ, IORING_OP_WRITE, IORING_OP_READ_FIXED}) {
+    if (opcode > probe->last_op ||
+        (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+namespace internal {
+
+// ----------------------------------------------------------------------
+// Registered buffers
+
+// Memory registered with a ring, cut into buffers each lent to one read at
+// a time
+class RegisteredBuffers {
+ public:
+  RegisteredBuffers(MemoryPool* pool, int num_buffers, int64_t buffer_size)
+      : memory_(std::make_shared<PoolBuffer>(pool)),
+        num_buffers_(num_buffers),
+        buffer_size_(AlignUp(buffer_size)),
+        base_(nullptr) {}
+
+  Status Init() {
+    RETURN_NOT_OK(memory_->Resize(num_buffers_ * buffer_size_ + kUringDirectAlignment));
+    base_ = AlignUp(memory_->mutable_data());
+    for (int i = num_buffers_ - 1; i >= 0; --i) {
+      free_.push_back(i);
+    }
+    return Status::OK();
+  }
+
+  Status Register(int ring_fd) {
+    std::vector<struct iovec> iovecs(num_buffers_);
+    for (int i = 0; i < num_buffers_; ++i) {
+      iovecs[i].iov_base = data(i);
+      iovecs[i].iov_len = static_cast<size_t>(buffer_size_);
+    }
+    if (UringRegister(ring_fd, IORING_REGISTER_BUFFERS, iovecs.data(),
+            static_cast<unsigned>(num_buffers_)) < 0) {
+      return ErrnoStatus("Failed to register io_uring buffers", errno);
+    }
+    return Status::OK();
+  }
+
+  // Take a free buffer, -1 if there is none
+  int Take() {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (free_.empty()) { return -1; }
+    const int index = free_.back();
+    free_.pop_back();
+    return index;
+  }
+
+  void Release(int index) {
+    std::lock_guard<std::mutex> guard(lock_);
+    free_.push_back(index);
+  }
+
+  uint8_t* data(int index) const { return base_ + index * buffer_size_; }
+  int64_t buffer_size() const { return buffer_size_; }
+
+ private:
+  std::shared_ptr<PoolBuffer> memory_;
+  int num_buffers_;
+  int64_t buffer_size_;
+  uint8_t* base_;
+
+  std::mutex lock_;
+  std::vector<int> free_;
+};
+
+// A registered buffer, made free again when released
+class RegisteredBuffer : public Buffer {
+ public:
+  RegisteredBuffer(const std::shared_ptr<RegisteredBuffers>& buffers, int index)
+      : Buffer(buffers->data(index), buffers->buffer_size()),
+        buffers_(buffers),
+        index_(index) {}
+
+  ~RegisteredBuffer() { buffers_->Release(index_); }
+
+ private:
+  std::shared_ptr<RegisteredBuffers> buffers_;
+  int index_;
+};
+
+// ----------------------------------------------------------------------
+// UringFile
+
+class UringFile {
+ public:
+  UringFile(MemoryPool* pool, const UringOptions& options)
+      : pool_(pool),
+        options_(options),
+        direct_(false),
+        fd_(-1),
+        ring_fd_(-1),
+        sq_map_(nullptr),
+        sq_map_size_(0),
+        cq_map_(nullptr),
+        cq_map_size_(0),
+        sqes_(nullptr),
+        sqes_size_(0),
+        sq_tail_(nullptr),
+        sq_mask_(0),
+        sq_array_(nullptr),
+        cq_head_(nullptr),
+        cq_tail_(nullptr),
+        cq_mask_(0),
+        cqes_(nullptr),
+        next_id_(0),
+        num_queued_(0),
+        num_in_flight_(0),
+        reaping_(false),
+        write_position_(0),
+        read_position_(0),
+        is_open_(false) {}
+
+  ~UringFile() {
+    DCHECK(Close().ok());
+    Teardown();
+  }
+
+  Status Open(const std::string& path, bool write) {
+    Status status = OpenInternal(path, write);
+    if (!status.ok()) { Teardown(); }
+    return status;
+  }
+
+  Status Close() {
+    std::unique_lock<std::mutex> lock(lock_);
+    if (!is_open_) { return Status::OK(); }
+    Status status = WaitUntil(&lock, [this]() { return num_in_flight_ == 0; });
+    is_open_ = false;
+    if (close(fd_) == -1 && status.ok()) {
+      status = ErrnoStatus("Failed to close file", errno);
+    }
+    fd_ = -1;
+    Teardown();
+    if (status.ok()) { status = write_error_; }
+    return status;
+  }
+
+  Status GetSize(int64_t* size) {
+    struct stat st;
+    if (fstat(fd_, &st) == -1) { return ErrnoStatus("Failed to stat file", errno); }
+    *size = st.st_size;
+    return Status::OK();
+  }
+
+  Status QueueRead(int64_t position, int64_t nbytes, uint64_t* id) {
+    std::unique_lock<std::mutex> lock(lock_);
+    if (!is_open_) { return Status::IOError("File is closed"); }
+    if (position < 0 || nbytes < 0) {
+      std::stringstream ss;
+      ss << "Invalid read of " << nbytes << " bytes at " << position;
+      return Status::Invalid(ss.str());
+    }
+    RETURN_NOT_OK(WaitUntil(
+        &lock, [this]() { return num_in_flight_ < options_.queue_depth; }));
+
+    Operation op;
+    op.is_write = false;
+    op.position = direct_ ? AlignDown(position) : position;
+    op.length = (direct_ ? AlignUp(position + nbytes) : position + nbytes) - op.position;
+    op.slice_offset = position - op.position;
+    op.requested = nbytes;
+
+    if (registered_ && op.length <= registered_->buffer_size()) {
+      op.buffer_index = registered_->Take();
+    }
+    if (op.buffer_index >= 0) {
+      op.data = registered_->data(op.buffer_index);
+      op.buffer = std::make_shared<RegisteredBuffer>(registered_, op.buffer_index);
+    } else {
+      auto buffer = std::make_shared<PoolBuffer>(pool_);
+      RETURN_NOT_OK(
+          buffer->Resize(op.length + (direct_ ? kUringDirectAlignment : 0), false));
+      op.data = direct_ ? AlignUp(buffer->mutable_data()) : buffer->mutable_data();
+      op.buffer = buffer;
+    }
+
+    *id = next_id_++;
+    if (op.length == 0) {
+      op.complete = true;
+      ops_.insert(std::make_pair(*id, std::move(op)));
+      return Status::OK();
+    }
+    QueueChunk(*id, &ops_.insert(std::make_pair(*id, std::move(op))).first->second);
+    ++num_in_flight_;
+    return Status::OK();
+  }
+
+  Status QueueWrite(const uint8_t* data, int64_t nbytes) {
+    std::unique_lock<std::mutex> lock(lock_);
+    if (!is_open_) { return Status::IOError("File is closed"); }
+    RETURN_NOT_OK(write_error_);
+    if (nbytes < 0) { return Status::IOError("Length must be non-negative"); }
+    if (nbytes == 0) { return Status::OK(); }
+    RETURN_NOT_OK(WaitUntil(
+        &lock, [this]() { return num_in_flight_ < options_.queue_depth; }));
+
+    auto buffer = std::make_shared<PoolBuffer>(pool_);
+    RETURN_NOT_OK(buffer->Resize(nbytes, false));
+    memcpy(buffer->mutable_data(), data, nbytes);
+
+    Operation op;
+    op.is_write = true;
+    op.data = buffer->mutable_data();
+    op.buffer = buffer;
+    op.position = write_position_;
+    op.length = nbytes;
+    write_position_ += nbytes;
+
+    const uint64_t id = next_id_++;
+    QueueChunk(id, &ops_.insert(std::make_pair(id, std::move(op))).first->second);
+    ++num_in_flight_;
+    RETURN_NOT_OK(SubmitQueued());
+    if (!reaping_) { ReapCompletions(); }
+    return Status::OK();
+  }
+
+  Status Submit() {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (!is_open_) { return Status::IOError("File is closed"); }
+    return SubmitQueued();
+  }
+
+  Status WaitRead(uint64_t id, std::shared_ptr<Buffer>* out) {
+    std::unique_lock<std::mutex> lock(lock_);
+    auto it = ops_.find(id);
+    DCHECK(it != ops_.end());
+    Operation* op = &it->second;
+    Status status = WaitUntil(&lock, [op]() { return op->complete; });
+    if (!status.ok()) {
+      Forget(it);
+      return status;
+    }
+
+    Operation done = std::move(*op);
+    ops_.erase(it);
+    RETURN_NOT_OK(done.status);
+    const int64_t available = std::max<int64_t>(done.done - done.slice_offset, 0);
+    const int64_t offset = done.data - done.buffer->data() + done.slice_offset;
+    *out = SliceBuffer(done.buffer, std::min(offset, done.buffer->size()),
+        std::min(done.requested, available));
+    return Status::OK();
+  }
+
+  bool IsReady(uint64_t id) {
+    std::lock_guard<std::mutex> guard(lock_);
+    if (!reaping_) {
+      ReapCompletions();
+      // Reaping may have queued the rest of short reads, which would never
+      // complete unless submitted. A failure resurfaces when they are waited
+      // for
+      if (num_queued_ > 0) {
+        Status submitted = SubmitQueued();
+        UNUSED(submitted);
+      }
+    }
+    auto it = ops_.find(id);
+    DCHECK(it != ops_.end());
+    return it->second.complete;
+  }
+
+  void Abandon(uint64_t id) {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = ops_.find(id);
+    DCHECK(it != ops_.end());
+    Forget(it);
+  }
+
+  Status Flush() {
+    std::unique_lock<std::mutex> lock(lock_);
+    if (!is_open_) { return Status::IOError("File is closed"); }
+    RETURN_NOT_OK(WaitUntil(&lock, [this]() { return num_in_flight_ == 0; }));
+    return write_error_;
+  }
+
+  int64_t write_position() {
+    std::lock_guard<std::mutex> guard(lock_);
+    return write_position_;
+  }
+
+  // The position of the Read and Seek methods of UringReadableFile, which
+  // hold position_lock() while they use it
+  std::mutex& position_lock() { return position_lock_; }
+  int64_t& read_position() { return read_position_; }
+
+ private:
+  struct Operation {
+    Operation()
+        : is_write(false),
+          data(nullptr),
+          position(0),
+          length(0),
+          done(0),
+          chunk(0),
+          slice_offset(0),
+          requested(0),
+          buffer_index(-1),
+          complete(false),
+          abandoned(false) {}
+
+    bool is_write;
+    // The memory read into or written from, data being where the operation
+    // starts in it
+    std::shared_ptr<Buffer> buffer;
+    uint8_t* data;
+    // The bytes of the file read or written, the number of them done so far
+    // and the length of the last piece submitted
+    int64_t position;
+    int64_t length;
+    int64_t done;
+    int64_t chunk;
+    // The bytes asked for, within those read when they were widened for
+    // O_DIRECT
+    int64_t slice_offset;
+    int64_t requested;
+    // The registered buffer read into, -1 if none
+    int buffer_index;
+    bool complete;
+    bool abandoned;
+    Status status;
+  };
+
+  // Forget a read, releasing its buffer once it completes
+  void Forget(std::map<uint64_t, Operation>::iterator it) {
+    if (it->second.complete) {
+      ops_.erase(it);
+    } else {
+      it->second.abandoned = true;
+    }
+  }
+
+  Status OpenInternal(const std::string& path, bool write) {
+    if (options_.queue_depth <= 0) {
+      std::stringstream ss;
+      ss << "Invalid io_uring queue depth: " << options_.queue_depth;
+      return Status::Invalid(ss.str());
+    }
+    direct_ = options_.direct_io && !write;
+
+    int flags = write ? (O_WRONLY | O_CREAT | O_TRUNC) : O_RDONLY;
+    if (direct_) { flags |= O_DIRECT; }
+    fd_ = open(path.c_str(), flags | O_CLOEXEC, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if (fd_ == -1) { return ErrnoStatus("Failed to open " + path, errno); }
+    RETURN_NOT_OK(SetupRing());
+
+    if (!write && options_.num_registered_buffers > 0) {
+      registered_ = std::make_shared<RegisteredBuffers>(
+          pool_, options_.num_registered_buffers, options_.registered_buffer_size);
+      RETURN_NOT_OK(registered_->Init());
+      RETURN_NOT_OK(registered_->Register(ring_fd_));
+    }
+    is_open_ = true;
+    return Status::OK();
+  }
+
+  Status SetupRing() {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring_fd_ = UringSetup(static_cast<unsigned>(options_.queue_depth), &params);
+    if (ring_fd_ < 0) { return ErrnoStatus("io_uring_setup failed", errno); }
+
+    sq_map_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_map_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_map = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_map) {
+      sq_map_size_ = cq_map_size_ = std::max(sq_map_size_, cq_map_size_);
+    }
+
+    RETURN_NOT_OK(MapRing(sq_map_size_, IORING_OFF_SQ_RING, &sq_map_));
+    if (single_map) {
+      cq_map_ = sq_map_;
+    } else {
+      RETURN_NOT_OK(MapRing(cq_map_size_, IORING_OFF_CQ_RING, &cq_map_));
+    }
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = nullptr;
+    RETURN_NOT_OK(MapRing(sqes_size_, IORING_OFF_SQES, &sqes));
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    uint8_t* sq = static_cast<uint8_t*>(sq_map_);
+    sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    uint8_t* cq = static_cast<uint8_t*>(cq_map_);
+    cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    return Status::OK();
+  }
+
+  Status MapRing(size_t size, int64_t offset, void** out) {
+    void* result = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        ring_fd_, offset);
+    if (result == MAP_FAILED) { return ErrnoStatus("Failed to map io_uring", errno); }
+    *out = result;
+    return Status::OK();
+  }
+
+  // Release the ring, and the file if it is still open
+  void Teardown() {
+    if (sqes_ != nullptr) { munmap(sqes_, sqes_size_); }
+    if (cq_map_ != nullptr && cq_map_ != sq_map_) { munmap(cq_map_, cq_map_size_); }
+    if (sq_map_ != nullptr) { munmap(sq_map_, sq_map_size_); }
+    sqes_ = nullptr;
+    cq_map_ = sq_map_ = nullptr;
+    cq_head_ = nullptr;
+    if (ring_fd_ != -1) { close(ring_fd_); }
+    ring_fd_ = -1;
+    if (fd_ != -1) { close(fd_); }
+    fd_ = -1;
+  }
+
+  // Queue the next piece of an operation. There is room in the submission
+  // queue as it has at least queue_depth entries
+  void QueueChunk(uint64_t id, Operation* op) {
+    op->chunk = std::min(op->length - op->done, kMaxUringChunk);
+
+    const unsigned tail = *sq_tail_;
+    const unsigned index = tail & sq_mask_;
+    io_uring_sqe* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    if (op->is_write) {
+      sqe->opcode = IORING_OP_WRITE;
+    } else if (op->buffer_index >= 0) {
+      sqe->opcode = IORING_OP_READ_FIXED;
+      sqe->buf_index = static_cast<uint16_t>(op->buffer_index);
+    } else {
+      sqe->opcode = IORING_OP_READ;
+    }
+    sqe->fd = fd_;
+    sqe->off = static_cast<uint64_t>(op->position + op->done);
+    sqe->addr = reinterpret_cast<uint64_t>(op->data + op->done);
+    sqe->len = static_cast<uint32_t>(op->chunk);
+    sqe->user_data = id;
+    sq_array_[index] = index;
+    // Publish the entry to the kernel
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+    ++num_queued_;
+  }
+
+  Status SubmitQueued() {
+    while (num_queued_ > 0) {
+      const int ret = UringEnter(ring_fd_, num_queued_, 0, 0);
+      if (ret == -1 && errno == EINTR) { continue; }
+      if (ret <= 0) {
+        return ErrnoStatus("io_uring_enter failed", ret == 0 ? EAGAIN : errno);
+      }
+      num_queued_ -= static_cast<unsigned>(ret);
+    }
+    return Status::OK();
+  }
+
+  void ReapCompletions() {
+    if (cq_head_ == nullptr) { return; }
+    unsigned head = *cq_head_;
+    const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+      const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+      Complete(cqe.user_data, cqe.res);
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    cv_.notify_all();
+  }
+
+  void Complete(uint64_t id, int result) {
+    auto it = ops_.find(id);
+    DCHECK(it != ops_.end());
+    Operation* op = &it->second;
+
+    if (result == -EINTR || result == -EAGAIN) {
+      QueueChunk(id, op);
+      return;
+    }
+    if (result < 0) {
+      op->status = ErrnoStatus(op->is_write ? "io_uring write failed"
+                                            : "io_uring read failed",
+          -result);
+    } else if (result == 0 && op->is_write) {
+      op->status = Status::IOError("io_uring write made no progress");
+    } else {
+      op->done += result;
+      // A read ends early at the end of the file, which is the only place an
+      // O_DIRECT read may be short
+      const bool end_of_file = !op->is_write && (result == 0 ||
+                                                    (direct_ && result < op->chunk));
+      if (op->done < op->length && !end_of_file) {
+        QueueChunk(id, op);
+        return;
+      }
+    }
+
+    --num_in_flight_;
+    if (op->is_write) {
+      if (!op->status.ok() && write_error_.ok()) { write_error_ = op->status; }
+      ops_.erase(it);
+    } else if (op->abandoned) {
+      ops_.erase(it);
+    } else {
+      op->complete = true;
+    }
+  }
+
+  // Submit the queued operations and wait for completions until ready()
+  // holds. A single thread at a time waits in the kernel, the others waiting
+  // for it to reap the completions
+  template <typename Predicate>
+  Status WaitUntil(std::unique_lock<std::mutex>* lock, Predicate&& ready) {
+    while (!ready()) {
+      if (ring_fd_ == -1) { return Status::IOError("File is closed"); }
+      if (reaping_) {
+        cv_.wait(*lock);
+        continue;
+      }
+      RETURN_NOT_OK(SubmitQueued());
+      ReapCompletions();
+      if (ready()) { break; }
+      // Reaping may have queued the rest of short reads or writes, which
+      // must be submitted before waiting for them
+      if (num_queued_ > 0) { continue; }
+
+      reaping_ = true;
+      lock->unlock();
+      const int ret = UringEnter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS);
+      const int error = errno;
+      lock->lock();
+      reaping_ = false;
+      ReapCompletions();
+      if (ret == -1 && error != EINTR) {
+        return ErrnoStatus("io_uring_enter failed", error);
+      }
+    }
+    return Status::OK();
+  }
+
+  MemoryPool* pool_;
+  UringOptions options_;
+  bool direct_;
+  int fd_;
+
+  // The ring and its mapped queues
+  int ring_fd_;
+  void* sq_map_;
+  size_t sq_map_size_;
+  void* cq_map_;
+  size_t cq_map_size_;
+  io_uring_sqe* sqes_;
+  size_t sqes_size_;
+  unsigned* sq_tail_;
+  unsigned sq_mask_;
+  unsigned* sq_array_;
+  unsigned* cq_head_;
+  unsigned* cq_tail_;
+  unsigned cq_mask_;
+  io_uring_cqe* cqes_;
+
+  std::shared_ptr<RegisteredBuffers> registered_;
+
+  std::mutex lock_;
+  std::condition_variable cv_;
+  std::map<uint64_t, Operation> ops_;
+  uint64_t next_id_;
+  // Entries queued but not yet submitted, and operations not yet complete
+  unsigned num_queued_;
+  int num_in_flight_;
+  // Whether a thread waits for completions in the kernel
+  bool reaping_;
+  // The first failed write
+  Status write_error_;
+  int64_t write_position_;
+
+  std::mutex position_lock_;
+  int64_t read_position_;
+
+  bool is_open_;
+};
+
+}  // namespace internal
+
+// ----------------------------------------------------------------------
+// UringReadFuture
+
+UringReadFuture::UringReadFuture(
+    const std::shared_ptr<internal::UringFile>& file, uint64_t id)
+    : file_(file), id_(id), waited_(false) {}
+
+UringReadFuture::~UringReadFuture() {
+  if (!waited_) { file_->Abandon(id_); }
+}
+
+Status UringReadFuture::Wait(std::shared_ptr<Buffer>* out) {
+  if (waited_) { return Status::Invalid("The read was waited for already"); }
+  waited_ = true;
+  return file_->WaitRead(id_, out);
+}
+
+bool UringReadFuture::is_ready() const {
+  return waited_ || file_->IsReady(id_);
+}
+
+// ----------------------------------------------------------------------
+// UringReadableFile
+
+UringReadableFile::UringReadableFile() {
+  set_mode(FileMode::READ);
+}
+
+UringReadableFile::~UringReadableFile() {
+  DCHECK(impl_->Close().ok());
+}
+
+Status UringReadableFile::Open(const std::string& path, const UringOptions& options,
+    std::shared_ptr<UringReadableFile>* file) {
+  return Open(path, options, default_memory_pool(), file);
+}
+
+Status UringReadableFile::Open(const std::string& path, const UringOptions& options,
+    MemoryPool* pool, std::shared_ptr<UringReadableFile>* file) {
+  std::shared_ptr<UringReadableFile> result(new UringReadableFile());
+  result->impl_ = std::make_shared<internal::UringFile>(pool, options);
+  RETURN_NOT_OK(result->impl_->Open(path, false));
+  *file = result;
+  return Status::OK();
+}
+
+Status UringReadableFile::ReadAsync(
+    int64_t position, int64_t nbytes, std::unique_ptr<UringReadFuture>* out) {
+  uint64_t id;
+  RETURN_NOT_OK(impl_->QueueRead(position, nbytes, &id));
+  out->reset(new UringReadFuture(impl_, id));
+  return Status::OK();
+}
+
+Status UringReadableFile::Submit() {
+  return impl_->Submit();
+}
+
+Status UringReadableFile::Close() {
+  return impl_->Close();
+}
+
+Status UringReadableFile::Tell(int64_t* position) {
+  std::lock_guard<std::mutex> guard(impl_->position_lock());
+  *position = impl_->read_position();
+  return Status::OK();
+}
+
+Status UringReadableFile::Seek(int64_t position) {
+  if (position < 0) { return Status::Invalid("Invalid position"); }
+  std::lock_guard<std::mutex> guard(impl_->position_lock());
+  impl_->read_position() = position;
+  return Status::OK();
+}
+
+Status UringReadableFile::GetSize(int64_t* size) {
+  return impl_->GetSize(size);
+}
+
+Status UringReadableFile::Read(int64_t nbytes, int64_t* bytes_read, uint8_t* out) {
+  std::lock_guard<std::mutex> guard(impl_->position_lock());
+  RETURN_NOT_OK(ReadAt(impl_->read_position(), nbytes, bytes_read, out));
+  impl_->read_position() += *bytes_read;
+  return Status::OK();
+}
+
+Status UringReadableFile::Read(int64_t nbytes, std::shared_ptr<Buffer>* out) {
+  std::lock_guard<std::mutex> guard(impl_->position_lock());
+  RETURN_NOT_OK(ReadAt(impl_->read_position(), nbytes, out));
+  impl_->read_position() += (*out)->size();
+  return Status::OK();
+}
+
+Status UringReadableFile::ReadAt(
+    int64_t position, int64_t nbytes, int64_t* bytes_read, uint8_t* out) {
+  std::shared_ptr<Buffer> buffer;
+  RETURN_NOT_OK(ReadAt(position, nbytes, &buffer));
+  memcpy(out, buffer->data(), buffer->size());
+  *bytes_read = buffer->size();
+  return Status::OK();
+}
+
+Status UringReadableFile::ReadAt(
+    int64_t position, int64_t nbytes, std::shared_ptr<Buffer>* out) {
+  std::unique_ptr<UringReadFuture> future;
+  RETURN_NOT_OK(ReadAsync(position, nbytes, &future));
+  return future->Wait(out);
+}
+
+Status UringReadableFile::ReadRanges(const std::vector<ReadRange>& ranges,
+    const ReadRangeOptions& options, std::vector<std::shared_ptr<Buffer>>* out) {
+  std::vector<std::unique_ptr<UringReadFuture>> futures(ranges.size());
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    RETURN_NOT_OK(ReadAsync(ranges[i].offset, ranges[i].length, &futures[i]));
+  }
+  RETURN_NOT_OK(Submit());
+  out->resize(ranges.size());
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    RETURN_NOT_OK(futures[i]->Wait(&(*out)[i]));
+  }
+  return Status::OK();
+}
+
+bool UringReadableFile::supports_zero_copy() const {
+  return false;
+}
+
+// ----------------------------------------------------------------------
+// UringOutputStream
+
+UringOutputStream::UringOutputStream() {
+  set_mode(FileMode::WRITE);
+}
+
+UringOutputStream::~UringOutputStream() {
+  // Wait for the writes in flight if the stream was not closed
+  DCHECK(impl_->Close().ok());
+}
+
+Status UringOutputStream::Open(const std::string& path, const UringOptions& options,
+    std::shared_ptr<UringOutputStream>* file) {
+  return Open(path, options, default_memory_pool(), file);
+}
+
+Status UringOutputStream::Open(const std::string& path, const UringOptions& options,
+    MemoryPool* pool, std::shared_ptr<UringOutputStream>* file) {
+  std::shared_ptr<UringOutputStream> result(new UringOutputStream());
+  result->impl_ = std::make_shared<internal::UringFile>(pool, options);
+  RETURN_NOT_OK(result->impl_->Open(path, true));
+  *file = result;
+  return Status::OK();
+}
+
+Status UringOutputStream::Close() {
+  return impl_->Close();
+}
+
+Status UringOutputStream::Tell(int64_t* position) {
+  *position = impl_->write_position();
+  return Status::OK();
+}
+
+Status UringOutputStream::Write(const uint8_t* data, int64_t nbytes) {
+  return impl_->QueueWrite(data, nbytes);
+}
+
+Status UringOutputStream::Flush() {
+  return impl_->Flush();
+}
+
+}  // namespace io
+}  // namespace arrow
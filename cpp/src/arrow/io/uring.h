@@ -0,0 +1,198 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Asynchronous file IO with Linux io_uring, built with ARROW_IO_URING=ON
+
+#ifndef ARROW_IO_URING_H
+#define ARROW_IO_URING_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/io/interfaces.h"
+#include "arrow/util/visibility.h"
+
+namespace arrow {
+
+class Buffer;
+class MemoryPool;
+class Status;
+
+namespace io {
+
+namespace internal {
+
+// The ring and the operations in flight, shared by a file and its reads
+class UringFile;
+
+}  // namespace internal
+
+struct ARROW_EXPORT UringOptions {
+  UringOptions();
+
+  /// Maximum number of operations in flight at once
+  int queue_depth;
+
+  /// Open files with O_DIRECT, bypassing the page cache. Reads are then
+  /// widened to whole blocks of kUringDirectAlignment bytes. Only applies to
+  /// UringReadableFile
+  bool direct_io;
+
+  /// Number of buffers of registered_buffer_size bytes registered with the
+  /// kernel once, into which reads that fit are made without mapping their
+  /// memory each time. 0 (the default) for none
+  int num_registered_buffers;
+  int64_t registered_buffer_size;
+};
+
+/// Alignment of the offsets, lengths and memory of O_DIRECT reads
+constexpr int64_t kUringDirectAlignment = 4096;
+
+/// \brief Whether io_uring can be used, it being missing from older kernels
+/// and possibly disabled
+ARROW_EXPORT bool IsUringSupported();
+
+/// \brief A read in progress, see UringReadableFile::ReadAsync
+class ARROW_EXPORT UringReadFuture {
+ public:
+  /// \brief Abandon the read if it was not waited for, its buffer being
+  /// released once it completes
+  ~UringReadFuture();
+
+  /// \brief Wait for the read to complete, submitting it first if needed
+  ///
+  /// \param[out] out the bytes read, fewer than requested at the end of the
+  /// file
+  /// \return Status, the error of the read if it failed
+  Status Wait(std::shared_ptr<Buffer>* out);
+
+  /// \brief Whether Wait would return without blocking
+  bool is_ready() const;
+
+ private:
+  friend class UringReadableFile;
+
+  UringReadFuture(const std::shared_ptr<internal::UringFile>& file, uint64_t id);
+
+  std::shared_ptr<internal::UringFile> file_;
+  uint64_t id_;
+  bool waited_;
+};
+
+/// \brief A file read with io_uring, many reads being in flight at once
+///
+/// ReadAsync queues reads, which are submitted together by Submit or by
+/// waiting for any of them, so that a reader can keep many requests in
+/// flight while it decodes what already arrived on other threads. All the
+/// methods are thread-safe.
+class ARROW_EXPORT UringReadableFile : public RandomAccessFile {
+ public:
+  ~UringReadableFile();
+
+  static Status Open(const std::string& path, const UringOptions& options,
+      std::shared_ptr<UringReadableFile>* file);
+
+  static Status Open(const std::string& path, const UringOptions& options,
+      MemoryPool* pool, std::shared_ptr<UringReadableFile>* file);
+
+  /// \brief Queue a read of nbytes at position
+  ///
+  /// The read is submitted with the next Submit, or a Wait on any read. If
+  /// queue_depth operations are in flight already, this waits for one of
+  /// them to complete.
+  Status ReadAsync(
+      int64_t position, int64_t nbytes, std::unique_ptr<UringReadFuture>* out);
+
+  /// \brief Submit the queued reads without waiting for them
+  Status Submit();
+
+  // RandomAccessFile interface
+
+  /// \brief Wait for the reads in flight and close the file
+  Status Close() override;
+
+  Status Tell(int64_t* position) override;
+  Status Seek(int64_t position) override;
+  Status GetSize(int64_t* size) override;
+
+  Status Read(int64_t nbytes, int64_t* bytes_read, uint8_t* out) override;
+  Status Read(int64_t nbytes, std::shared_ptr<Buffer>* out) override;
+
+  /// \brief Read at position with a single io_uring read, leaving the file
+  /// position alone
+  Status ReadAt(
+      int64_t position, int64_t nbytes, int64_t* bytes_read, uint8_t* out) override;
+  Status ReadAt(int64_t position, int64_t nbytes, std::shared_ptr<Buffer>* out) override;
+
+  /// \brief Submit a read of every range at once and wait for them
+  ///
+  /// The ranges are read as they are, merging them being of little use
+  /// when they are all in flight together.
+  Status ReadRanges(const std::vector<ReadRange>& ranges,
+      const ReadRangeOptions& options,
+      std::vector<std::shared_ptr<Buffer>>* out) override;
+
+  bool supports_zero_copy() const override;
+
+ private:
+  UringReadableFile();
+
+  std::shared_ptr<internal::UringFile> impl_;
+};
+
+/// \brief An output stream writing a file with io_uring, writes completing
+/// in the background
+///
+/// Every Write copies its data and submits its write at once without
+/// waiting for it, at most queue_depth writes being in flight. An error of
+/// a write is returned by a later Write, Flush or Close. Flush and Close
+/// wait for all the writes. Thread-safe.
+class ARROW_EXPORT UringOutputStream : public OutputStream {
+ public:
+  ~UringOutputStream();
+
+  /// \brief Create the file at path, truncating any existing one
+  static Status Open(const std::string& path, const UringOptions& options,
+      std::shared_ptr<UringOutputStream>* file);
+
+  static Status Open(const std::string& path, const UringOptions& options,
+      MemoryPool* pool, std::shared_ptr<UringOutputStream>* file);
+
+  // OutputStream interface
+
+  /// \brief Wait for the writes in flight and close the file
+  Status Close() override;
+
+  Status Tell(int64_t* position) override;
+
+  Status Write(const uint8_t* data, int64_t nbytes) override;
+
+  /// \brief Wait for the writes in flight
+  Status Flush() override;
+
+ private:
+  UringOutputStream();
+
+  std::shared_ptr<internal::UringFile> impl_;
+};
+
+}  // namespace io
+}  // namespace arrow
+
+#endif  // ARROW_IO_URING_H
@@ -25,6 +25,7 @@
 #include "arrow/io/memory.h"
 #include "arrow/ipc/api.h"
 #include "arrow/test-util.h"
+#include "arrow/util/compression.h"
 
 namespace arrow {
 
@@ -117,6 +118,60 @@ static void BM_ReadRecordBatch(benchmark::State& state) {  // NOLINT non-const r
   state.SetBytesProcessed(int64_t(state.iterations()) * kTotalSize);
 }
 
+// Arguments: number of fields, Compression::type
+static void BM_WriteCompressedRecordBatch(
+    benchmark::State& state) {  // NOLINT non-const reference
+  // 1MB
+  constexpr int64_t kTotalSize = 1 << 20;
+  const auto compression = static_cast<Compression::type>(state.range(1));
+
+  auto buffer = std::make_shared<PoolBuffer>(default_memory_pool());
+  auto record_batch = MakeRecordBatch<Int64Type>(kTotalSize, state.range(0));
+
+  while (state.KeepRunning()) {
+    io::BufferOutputStream stream(buffer);
+    int32_t metadata_length;
+    int64_t body_length;
+    if (!ipc::WriteRecordBatch(*record_batch, 0, &stream, &metadata_length, &body_length,
+            default_memory_pool(), ipc::kMaxNestingDepth, false, compression)
+             .ok()) {
+      state.SkipWithError("Failed to write!");
+    }
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * kTotalSize);
+}
+
+// Arguments: number of fields, Compression::type
+static void BM_ReadCompressedRecordBatch(
+    benchmark::State& state) {  // NOLINT non-const reference
+  // 1MB
+  constexpr int64_t kTotalSize = 1 << 20;
+  const auto compression = static_cast<Compression::type>(state.range(1));
+
+  auto buffer = std::make_shared<PoolBuffer>(default_memory_pool());
+  auto record_batch = MakeRecordBatch<Int64Type>(kTotalSize, state.range(0));
+
+  io::BufferOutputStream stream(buffer);
+
+  int32_t metadata_length;
+  int64_t body_length;
+  if (!ipc::WriteRecordBatch(*record_batch, 0, &stream, &metadata_length, &body_length,
+          default_memory_pool(), ipc::kMaxNestingDepth, false, compression)
+           .ok()) {
+    state.SkipWithError("Failed to write!");
+  }
+
+  while (state.KeepRunning()) {
+    std::shared_ptr<RecordBatch> result;
+    io::BufferReader reader(buffer);
+
+    if (!ipc::ReadRecordBatch(record_batch->schema(), 0, &reader, &result).ok()) {
+      state.SkipWithError("Failed to read!");
+    }
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * kTotalSize);
+}
+
 BENCHMARK(BM_WriteRecordBatch)
     ->RangeMultiplier(4)
     ->Range(1, 1 << 13)
@@ -129,4 +184,20 @@ BENCHMARK(BM_ReadRecordBatch)
     ->MinTime(1.0)
     ->UseRealTime();
 
+BENCHMARK(BM_WriteCompressedRecordBatch)
+    ->Args({1, Compression::LZ4})
+    ->Args({64, Compression::LZ4})
+    ->Args({1, Compression::ZSTD})
+    ->Args({64, Compression::ZSTD})
+    ->MinTime(1.0)
+    ->UseRealTime();
+
+BENCHMARK(BM_ReadCompressedRecordBatch)
+    ->Args({1, Compression::LZ4})
+    ->Args({64, Compression::LZ4})
+    ->Args({1, Compression::ZSTD})
+    ->Args({64, Compression::ZSTD})
+    ->MinTime(1.0)
+    ->UseRealTime();
+
 }  // namespace arrow
@@ -37,6 +37,7 @@
 #include "arrow/tensor.h"
 #include "arrow/test-util.h"
 #include "arrow/util/bit-util.h"
+#include "arrow/util/compression.h"
 
 namespace arrow {
 namespace ipc {
@@ -173,6 +174,7 @@ class IpcTestFixture : public io::MemoryMapFixture {
     std::shared_ptr<RecordBatchFileReader> file_reader;
     RETURN_NOT_OK(RecordBatchFileReader::Open(mmap_, offset, &file_reader));
 
+    RETURN_NOT_OK(file_reader->WillNeed(0));
     return file_reader->ReadRecordBatch(0, result);
   }
 
@@ -373,6 +375,92 @@ void TestGetRecordBatchSize(std::shared_ptr<RecordBatch> batch) {
   ASSERT_EQ(mock.GetExtentBytesWritten(), size);
 }
 
+TEST_F(TestWriteRecordBatch, CompressedBody) {
+  // A column of random bytes, which is stored uncompressed, and a repetitive one
+  const int64_t length = 100000;
+  std::vector<uint8_t> random_values(length);
+  test::random_bytes(length, 0, random_values.data());
+  std::vector<int32_t> repeated_values(length);
+  for (int64_t i = 0; i < length; ++i) {
+    repeated_values[i] = static_cast<int32_t>(i % 10);
+  }
+  std::shared_ptr<Array> random_array, repeated_array;
+  ArrayFromVector<UInt8Type, uint8_t>(random_values, &random_array);
+  ArrayFromVector<Int32Type, int32_t>(repeated_values, &repeated_array);
+
+  auto schema = std::make_shared<Schema>(std::vector<std::shared_ptr<Field>>(
+      {arrow::field("f0", uint8()), arrow::field("f1", int32())}));
+  RecordBatch batch(schema, length, {random_array, repeated_array});
+
+  ASSERT_OK(io::MemoryMapFixture::InitMemoryMap(
+      1 << 20, "test-write-compressed-body", &mmap_));
+  DefaultMemoryPool read_pool;
+  for (Compression::type compression : {Compression::LZ4, Compression::ZSTD}) {
+    int32_t metadata_length;
+    int64_t body_length;
+    ASSERT_OK(mmap_->Seek(0));
+    ASSERT_OK(WriteRecordBatch(batch, 0, mmap_.get(), &metadata_length, &body_length,
+        pool_, kMaxNestingDepth, false, compression));
+    ASSERT_GT(body_length, length);
+    ASSERT_LT(body_length, 2 * length);
+
+    std::unique_ptr<Message> message;
+    ASSERT_OK(ReadMessage(0, metadata_length, mmap_.get(), &message));
+    io::BufferReader buffer_reader(message->body());
+    std::shared_ptr<RecordBatch> result;
+    ASSERT_OK(ReadRecordBatch(*message->metadata(), schema, &buffer_reader, &result));
+    CheckReadResult(*result, batch);
+
+    // The repetitive column is decompressed into the given pool
+    io::BufferReader pool_reader(message->body());
+    ASSERT_OK(ReadRecordBatch(*message->metadata(), schema, kMaxNestingDepth,
+        &pool_reader, &read_pool, &result));
+    ASSERT_GE(read_pool.bytes_allocated(),
+        length * static_cast<int64_t>(sizeof(int32_t)));
+    CheckReadResult(*result, batch);
+
+    // The body starts with the length prefix of the random column. Corrupt
+    // prefixes are rejected before allocating anything
+    for (int64_t prefix : {static_cast<int64_t>(-2), kMaxDecompressedBufferLength + 1}) {
+      std::shared_ptr<Buffer> body;
+      ASSERT_OK(message->body()->Copy(0, message->body()->size(), &body));
+      memcpy(const_cast<uint8_t*>(body->data()), &prefix, sizeof(int64_t));
+      io::BufferReader corrupt_reader(body);
+      ASSERT_RAISES(Invalid,
+          ReadRecordBatch(*message->metadata(), schema, &corrupt_reader, &result));
+    }
+
+    // A compressed buffer claiming more data than its body holds is an error,
+    // not a partly uninitialized result
+    std::shared_ptr<Buffer> body;
+    ASSERT_OK(message->body()->Copy(0, message->body()->size(), &body));
+    uint8_t* body_data = const_cast<uint8_t*>(body->data());
+    const int64_t repeated_size = length * static_cast<int64_t>(sizeof(int32_t));
+    int64_t prefix_offset = -1;
+    for (int64_t offset = 0; offset + 8 <= body->size(); offset += 8) {
+      int64_t prefix;
+      memcpy(&prefix, body_data + offset, sizeof(int64_t));
+      if (prefix == repeated_size) {
+        prefix_offset = offset;
+        break;
+      }
+    }
+    ASSERT_GE(prefix_offset, 0);
+    const int64_t longer_size = repeated_size + 1;
+    memcpy(body_data + prefix_offset, &longer_size, sizeof(int64_t));
+    io::BufferReader corrupt_reader(body);
+    ASSERT_RAISES(IOError,
+        ReadRecordBatch(*message->metadata(), schema, &corrupt_reader, &result));
+  }
+
+  // Only LZ4 and ZSTD are supported
+  int32_t metadata_length;
+  int64_t body_length;
+  ASSERT_OK(mmap_->Seek(0));
+  ASSERT_RAISES(Invalid, WriteRecordBatch(batch, 0, mmap_.get(), &metadata_length,
+      &body_length, pool_, kMaxNestingDepth, false, Compression::SNAPPY));
+}
+
 TEST_F(TestWriteRecordBatch, IntegerGetRecordBatchSize) {
   std::shared_ptr<RecordBatch> batch;
 
@@ -507,6 +595,7 @@ class TestFileFormat : public ::testing::TestWithParam<MakeRecordBatch*> {
     std::shared_ptr<RecordBatchFileWriter> writer;
     RETURN_NOT_OK(
         RecordBatchFileWriter::Open(sink_.get(), in_batches[0]->schema(), &writer));
+    writer->set_compression(compression_);
 
     const int num_batches = static_cast<int>(in_batches.size());
 
@@ -527,16 +616,21 @@ class TestFileFormat : public ::testing::TestWithParam<MakeRecordBatch*> {
 
     EXPECT_EQ(num_batches, reader->num_record_batches());
     for (int i = 0; i < num_batches; ++i) {
+      // Prefetch the next batch while reading this one
+      if (i + 1 < num_batches) { RETURN_NOT_OK(reader->WillNeed(i + 1)); }
       std::shared_ptr<RecordBatch> chunk;
       RETURN_NOT_OK(reader->ReadRecordBatch(i, &chunk));
       out_batches->emplace_back(chunk);
     }
+    EXPECT_TRUE(reader->WillNeed(num_batches).IsInvalid());
+    EXPECT_TRUE(reader->WillNeed(-1).IsInvalid());
 
     return Status::OK();
   }
 
  protected:
   MemoryPool* pool_;
+  Compression::type compression_ = Compression::UNCOMPRESSED;
 
   std::unique_ptr<io::BufferOutputStream> sink_;
   std::shared_ptr<PoolBuffer> buffer_;
@@ -559,6 +653,22 @@ TEST_P(TestFileFormat, RoundTrip) {
   }
 }
 
+TEST_P(TestFileFormat, CompressedRoundTrip) {
+  std::shared_ptr<RecordBatch> batch1;
+  std::shared_ptr<RecordBatch> batch2;
+  ASSERT_OK((*GetParam())(&batch1));  // NOLINT clang-tidy gtest issue
+  ASSERT_OK((*GetParam())(&batch2));  // NOLINT clang-tidy gtest issue
+
+  for (Compression::type compression : {Compression::LZ4, Compression::ZSTD}) {
+    SetUp();
+    compression_ = compression;
+    std::vector<std::shared_ptr<RecordBatch>> out_batches;
+    ASSERT_OK(RoundTripHelper({batch1, batch2}, &out_batches));
+    CompareBatch(*batch1, *out_batches[0]);
+    CompareBatch(*batch2, *out_batches[1]);
+  }
+}
+
 class TestStreamFormat : public ::testing::TestWithParam<MakeRecordBatch*> {
  public:
   void SetUp() {
@@ -573,6 +683,7 @@ class TestStreamFormat : public ::testing::TestWithParam<MakeRecordBatch*> {
     // Write the file
     std::shared_ptr<RecordBatchStreamWriter> writer;
     RETURN_NOT_OK(RecordBatchStreamWriter::Open(sink_.get(), batch.schema(), &writer));
+    writer->set_compression(compression_);
     int num_batches = 5;
     for (int i = 0; i < num_batches; ++i) {
       RETURN_NOT_OK(writer->WriteRecordBatch(batch));
@@ -597,6 +708,7 @@ class TestStreamFormat : public ::testing::TestWithParam<MakeRecordBatch*> {
 
  protected:
   MemoryPool* pool_;
+  Compression::type compression_ = Compression::UNCOMPRESSED;
 
   std::unique_ptr<io::BufferOutputStream> sink_;
   std::shared_ptr<PoolBuffer> buffer_;
@@ -616,6 +728,21 @@ TEST_P(TestStreamFormat, RoundTrip) {
   }
 }
 
+TEST_P(TestStreamFormat, CompressedRoundTrip) {
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK((*GetParam())(&batch));  // NOLINT clang-tidy gtest issue
+
+  for (Compression::type compression : {Compression::LZ4, Compression::ZSTD}) {
+    SetUp();
+    compression_ = compression;
+    std::vector<std::shared_ptr<RecordBatch>> out_batches;
+    ASSERT_OK(RoundTripHelper(*batch, &out_batches));
+    for (size_t i = 0; i < out_batches.size(); ++i) {
+      CompareBatch(*batch, *out_batches[i]);
+    }
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(GenericIpcRoundTripTests, TestIpcRoundTrip, BATCH_CASES());
 INSTANTIATE_TEST_CASE_P(FileRoundTripTests, TestFileFormat, BATCH_CASES());
 INSTANTIATE_TEST_CASE_P(StreamRoundTripTests, TestStreamFormat, BATCH_CASES());
@@ -687,6 +814,30 @@ TEST_F(TestFileFormat, DictionaryRoundTrip) {
   CheckBatchDictionaries(*out_batches[0]);
 }
 
+TEST_F(TestStreamFormat, CompressedDictionaryRoundTrip) {
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(MakeDictionary(&batch));
+
+  compression_ = Compression::ZSTD;
+  std::vector<std::shared_ptr<RecordBatch>> out_batches;
+  ASSERT_OK(RoundTripHelper(*batch, &out_batches));
+
+  CompareBatch(*batch, *out_batches[0]);
+  CheckBatchDictionaries(*out_batches[0]);
+}
+
+TEST_F(TestFileFormat, CompressedDictionaryRoundTrip) {
+  std::shared_ptr<RecordBatch> batch;
+  ASSERT_OK(MakeDictionary(&batch));
+
+  compression_ = Compression::LZ4;
+  std::vector<std::shared_ptr<RecordBatch>> out_batches;
+  ASSERT_OK(RoundTripHelper({batch}, &out_batches));
+
+  CompareBatch(*batch, *out_batches[0]);
+  CheckBatchDictionaries(*out_batches[0]);
+}
+
 class TestTensorRoundTrip : public ::testing::Test, public IpcTestFixture {
  public:
   void SetUp() { pool_ = default_memory_pool(); }
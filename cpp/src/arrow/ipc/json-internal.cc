@@ -377,6 +377,12 @@ class SchemaWriter {
     return VisitType(*type.dictionary()->type());
   }
 
+  Status Visit(const RunEndEncodedType& type) {
+    return Status::NotImplemented("run_end_encoded");
+  }
+
+  Status Visit(const BitPackedType& type) { return Status::NotImplemented("bit_packed"); }
+
  private:
   DictionaryMemo dictionary_memo_;
 
@@ -548,6 +554,14 @@ class ArrayWriter {
     return VisitArrayValues(*array.indices());
   }
 
+  Status Visit(const RunEndEncodedArray& array) {
+    return Status::NotImplemented("run_end_encoded");
+  }
+
+  Status Visit(const BitPackedArray& array) {
+    return Status::NotImplemented("bit_packed");
+  }
+
   Status Visit(const ListArray& array) {
     WriteValidityField(array);
     WriteIntegerField("OFFSET", array.raw_value_offsets(), array.length() + 1);
@@ -1176,6 +1190,12 @@ class ArrayReader {
     return Status::OK();
   }
 
+  Status Visit(const RunEndEncodedType& type) {
+    return Status::NotImplemented("run_end_encoded");
+  }
+
+  Status Visit(const BitPackedType& type) { return Status::NotImplemented("bit_packed"); }
+
   Status GetChildren(const RjObject& obj, const DataType& type,
       std::vector<std::shared_ptr<Array>>* array) {
     const auto& json_children = obj.FindMember("children");
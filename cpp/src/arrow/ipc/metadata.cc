@@ -136,6 +136,44 @@ static Status StructToFlatbuffer(FBB& fbb, const std::shared_ptr<DataType>& type
   return Status::OK();
 }
 
+// ----------------------------------------------------------------------
+// Encoded types
+
+static Status RunEndEncodedFromFlatbuffer(
+    const std::vector<std::shared_ptr<Field>>& children, std::shared_ptr<DataType>* out) {
+  if (children.size() != 2 || children[0]->type()->id() != Type::INT32) {
+    return Status::Invalid("RunEndEncoded must have int32 run ends and values children");
+  }
+  *out = run_end_encoded(children[1]->type());
+  return Status::OK();
+}
+
+static Status BitPackedFromFlatbuffer(
+    const flatbuf::BitPacked* packed_data, std::shared_ptr<DataType>* out) {
+  if (packed_data->valueType() == nullptr) {
+    return Status::Invalid("BitPacked must have a value type");
+  }
+  std::shared_ptr<DataType> value_type;
+  RETURN_NOT_OK(IntFromFlatbuffer(packed_data->valueType(), &value_type));
+  const int bit_width = packed_data->bitWidth();
+  if (bit_width < 1 ||
+      bit_width > static_cast<const FixedWidthType&>(*value_type).bit_width()) {
+    return Status::Invalid("BitPacked bit width out of range for its value type");
+  }
+  *out = bit_packed(value_type, bit_width);
+  return Status::OK();
+}
+
+static Status BitPackedToFlatbuffer(
+    FBB& fbb, const std::shared_ptr<DataType>& type, Offset* offset) {
+  const auto& packed_type = static_cast<const BitPackedType&>(*type);
+  const auto& value_type = static_cast<const Integer&>(*packed_type.value_type());
+  auto fb_value_type =
+      flatbuf::CreateInt(fbb, value_type.bit_width(), value_type.is_signed());
+  *offset = flatbuf::CreateBitPacked(fbb, fb_value_type, packed_type.bit_width()).Union();
+  return Status::OK();
+}
+
 // ----------------------------------------------------------------------
 // Union implementation
 
@@ -303,6 +341,11 @@ static Status TypeFromFlatbuffer(flatbuf::Type type, const void* type_data,
     case flatbuf::Type_Union:
       return UnionFromFlatbuffer(
           static_cast<const flatbuf::Union*>(type_data), children, out);
+    case flatbuf::Type_RunEndEncoded:
+      return RunEndEncodedFromFlatbuffer(children, out);
+    case flatbuf::Type_BitPacked:
+      return BitPackedFromFlatbuffer(
+          static_cast<const flatbuf::BitPacked*>(type_data), out);
     default:
       return Status::Invalid("Unrecognized type");
   }
@@ -426,6 +469,14 @@ static Status TypeToFlatbuffer(FBB& fbb, const std::shared_ptr<DataType>& type,
     case Type::UNION:
       *out_type = flatbuf::Type_Union;
       return UnionToFlatBuffer(fbb, type, children, dictionary_memo, offset);
+    case Type::RUN_END_ENCODED:
+      *out_type = flatbuf::Type_RunEndEncoded;
+      RETURN_NOT_OK(AppendChildFields(fbb, type, children, dictionary_memo));
+      *offset = flatbuf::CreateRunEndEncoded(fbb).Union();
+      break;
+    case Type::BIT_PACKED:
+      *out_type = flatbuf::Type_BitPacked;
+      return BitPackedToFlatbuffer(fbb, type, offset);
     default:
       *out_type = flatbuf::Type_NONE;  // Make clang-tidy happy
       std::stringstream ss;
@@ -679,29 +730,74 @@ static Status WriteBuffers(
   return Status::OK();
 }
 
+static Status CompressionToFlatbuffer(
+    Compression::type compression, flatbuf::CompressionType* out) {
+  switch (compression) {
+    case Compression::LZ4:
+      *out = flatbuf::CompressionType_LZ4;
+      break;
+    case Compression::ZSTD:
+      *out = flatbuf::CompressionType_ZSTD;
+      break;
+    default:
+      return Status::Invalid("IPC bodies can only be compressed with LZ4 or ZSTD");
+  }
+  return Status::OK();
+}
+
 static Status MakeRecordBatch(FBB& fbb, int64_t length, int64_t body_length,
     const std::vector<FieldMetadata>& nodes, const std::vector<BufferMetadata>& buffers,
-    RecordBatchOffset* offset) {
+    Compression::type compression, RecordBatchOffset* offset) {
   FieldNodeVector fb_nodes;
   BufferVector fb_buffers;
 
   RETURN_NOT_OK(WriteFieldNodes(fbb, nodes, &fb_nodes));
   RETURN_NOT_OK(WriteBuffers(fbb, buffers, &fb_buffers));
 
-  *offset = flatbuf::CreateRecordBatch(fbb, length, fb_nodes, fb_buffers);
+  // Absent unless the body is compressed
+  flatbuffers::Offset<flatbuf::BodyCompression> fb_compression;
+  if (compression != Compression::UNCOMPRESSED) {
+    flatbuf::CompressionType codec;
+    RETURN_NOT_OK(CompressionToFlatbuffer(compression, &codec));
+    fb_compression = flatbuf::CreateBodyCompression(fbb, codec);
+  }
+
+  *offset =
+      flatbuf::CreateRecordBatch(fbb, length, fb_nodes, fb_buffers, fb_compression);
   return Status::OK();
 }
 
 Status WriteRecordBatchMessage(int64_t length, int64_t body_length,
     const std::vector<FieldMetadata>& nodes, const std::vector<BufferMetadata>& buffers,
-    std::shared_ptr<Buffer>* out) {
+    std::shared_ptr<Buffer>* out, Compression::type compression) {
   FBB fbb;
   RecordBatchOffset record_batch;
-  RETURN_NOT_OK(MakeRecordBatch(fbb, length, body_length, nodes, buffers, &record_batch));
+  RETURN_NOT_OK(MakeRecordBatch(
+      fbb, length, body_length, nodes, buffers, compression, &record_batch));
   return WriteFBMessage(
       fbb, flatbuf::MessageHeader_RecordBatch, record_batch.Union(), body_length, out);
 }
 
+Status GetBodyCompression(const void* opaque_record_batch, Compression::type* out) {
+  auto batch = static_cast<const flatbuf::RecordBatch*>(opaque_record_batch);
+  const flatbuf::BodyCompression* compression = batch->compression();
+  if (compression == nullptr) {
+    *out = Compression::UNCOMPRESSED;
+    return Status::OK();
+  }
+  switch (compression->codec()) {
+    case flatbuf::CompressionType_LZ4:
+      *out = Compression::LZ4;
+      break;
+    case flatbuf::CompressionType_ZSTD:
+      *out = Compression::ZSTD;
+      break;
+    default:
+      return Status::Invalid("Unknown body compression codec");
+  }
+  return Status::OK();
+}
+
 Status WriteTensorMessage(
     const Tensor& tensor, int64_t buffer_start_offset, std::shared_ptr<Buffer>* out) {
   using TensorDimOffset = flatbuffers::Offset<flatbuf::TensorDim>;
@@ -733,10 +829,11 @@ Status WriteTensorMessage(
 
 Status WriteDictionaryMessage(int64_t id, int64_t length, int64_t body_length,
     const std::vector<FieldMetadata>& nodes, const std::vector<BufferMetadata>& buffers,
-    std::shared_ptr<Buffer>* out) {
+    std::shared_ptr<Buffer>* out, Compression::type compression) {
   FBB fbb;
   RecordBatchOffset record_batch;
-  RETURN_NOT_OK(MakeRecordBatch(fbb, length, body_length, nodes, buffers, &record_batch));
+  RETURN_NOT_OK(MakeRecordBatch(
+      fbb, length, body_length, nodes, buffers, compression, &record_batch));
   auto dictionary_batch = flatbuf::CreateDictionaryBatch(fbb, id, record_batch).Union();
   return WriteFBMessage(
       fbb, flatbuf::MessageHeader_DictionaryBatch, dictionary_batch, body_length, out);
@@ -1157,19 +1254,15 @@ Status WriteMessage(
   // plus padding
   *message_length = padded_message_length;
 
-  // Write the flatbuffer size prefix including padding
+  // Write the flatbuffer size prefix including padding, the flatbuffer and
+  // any padding at once
   int32_t flatbuffer_size = padded_message_length - 4;
-  RETURN_NOT_OK(
-      file->Write(reinterpret_cast<const uint8_t*>(&flatbuffer_size), sizeof(int32_t)));
-
-  // Write the flatbuffer
-  RETURN_NOT_OK(file->Write(message.data(), message.size()));
-
-  // Write any padding
   int32_t padding = padded_message_length - static_cast<int32_t>(message.size()) - 4;
-  if (padding > 0) { RETURN_NOT_OK(file->Write(kPaddingBytes, padding)); }
-
-  return Status::OK();
+  std::vector<io::WriteRange> pieces = {
+      {reinterpret_cast<const uint8_t*>(&flatbuffer_size), sizeof(int32_t)},
+      {message.data(), message.size()}};
+  if (padding > 0) { pieces.emplace_back(kPaddingBytes, padding); }
+  return file->WriteV(pieces);
 }
 
 }  // namespace ipc
@@ -26,6 +26,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "arrow/util/compression.h"
 #include "arrow/util/macros.h"
 #include "arrow/util/visibility.h"
 
@@ -269,16 +270,26 @@ Status ARROW_EXPORT WriteMessage(
 Status ARROW_EXPORT WriteSchemaMessage(
     const Schema& schema, DictionaryMemo* dictionary_memo, std::shared_ptr<Buffer>* out);
 
+// Serialize the metadata of a record batch. buffers are the stored buffers of
+// the body, compressed with compression unless it is
+// Compression::UNCOMPRESSED (see BodyCompression in Message.fbs)
 Status ARROW_EXPORT WriteRecordBatchMessage(int64_t length, int64_t body_length,
     const std::vector<FieldMetadata>& nodes, const std::vector<BufferMetadata>& buffers,
-    std::shared_ptr<Buffer>* out);
+    std::shared_ptr<Buffer>* out,
+    Compression::type compression = Compression::UNCOMPRESSED);
+
+// The compression of the buffers of a RecordBatch flatbuffer,
+// Compression::UNCOMPRESSED if they are stored as is
+Status ARROW_EXPORT GetBodyCompression(
+    const void* opaque_record_batch, Compression::type* out);
 
 Status ARROW_EXPORT WriteTensorMessage(
     const Tensor& tensor, int64_t buffer_start_offset, std::shared_ptr<Buffer>* out);
 
 Status WriteDictionaryMessage(int64_t id, int64_t length, int64_t body_length,
     const std::vector<FieldMetadata>& nodes, const std::vector<BufferMetadata>& buffers,
-    std::shared_ptr<Buffer>* out);
+    std::shared_ptr<Buffer>* out,
+    Compression::type compression = Compression::UNCOMPRESSED);
 
 Status WriteFileFooter(const Schema& schema, const std::vector<FileBlock>& dictionaries,
     const std::vector<FileBlock>& record_batches, DictionaryMemo* dictionary_memo,
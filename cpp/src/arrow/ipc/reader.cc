@@ -30,11 +30,14 @@
 #include "arrow/ipc/Message_generated.h"
 #include "arrow/ipc/metadata.h"
 #include "arrow/ipc/util.h"
+#include "arrow/memory_pool.h"
 #include "arrow/status.h"
 #include "arrow/table.h"
 #include "arrow/tensor.h"
 #include "arrow/type.h"
+#include "arrow/util/compression.h"
 #include "arrow/util/logging.h"
+#include "arrow/util/parallel.h"
 #include "arrow/visitor_inline.h"
 
 namespace arrow {
@@ -49,18 +52,39 @@ namespace ipc {
 /// Accessor class for flatbuffers metadata
 class IpcComponentSource {
  public:
-  IpcComponentSource(const flatbuf::RecordBatch* metadata, io::RandomAccessFile* file)
-      : metadata_(metadata), file_(file) {}
+  IpcComponentSource(const flatbuf::RecordBatch* metadata, io::RandomAccessFile* file,
+      MemoryPool* pool)
+      : metadata_(metadata), file_(file), pool_(pool) {}
+
+  // If the body is compressed, read and decompress all of its buffers up
+  // front, in parallel
+  Status DecompressBuffers() {
+    Compression::type compression;
+    RETURN_NOT_OK(GetBodyCompression(metadata_, &compression));
+    if (compression == Compression::UNCOMPRESSED) { return Status::OK(); }
+    std::unique_ptr<Codec> codec;
+    RETURN_NOT_OK(Codec::Create(compression, &codec));
+
+    const int num_buffers = static_cast<int>(metadata_->buffers()->size());
+    decompressed_.resize(num_buffers);
+    int64_t total_size = 0;
+    for (int i = 0; i < num_buffers; ++i) {
+      RETURN_NOT_OK(ReadBuffer(i, &decompressed_[i]));
+      if (decompressed_[i]) { total_size += decompressed_[i]->size(); }
+    }
+    const int num_threads = total_size < kMinParallelCompressionBytes ? 1 : 0;
+    return ParallelFor(num_threads, num_buffers, [this, &codec](int64_t i) {
+      return DecompressBuffer(codec.get(), &decompressed_[i]);
+    });
+  }
 
   Status GetBuffer(int buffer_index, std::shared_ptr<Buffer>* out) {
-    const flatbuf::Buffer* buffer = metadata_->buffers()->Get(buffer_index);
-
-    if (buffer->length() == 0) {
-      *out = nullptr;
-      return Status::OK();
-    } else {
-      return file_->ReadAt(buffer->offset(), buffer->length(), out);
+    if (decompressed_.empty()) { return ReadBuffer(buffer_index, out); }
+    if (buffer_index >= static_cast<int>(decompressed_.size())) {
+      return Status::Invalid("Ran out of buffer metadata, likely malformed");
     }
+    *out = decompressed_[buffer_index];
+    return Status::OK();
   }
 
   Status GetFieldMetadata(int field_index, internal::ArrayData* out) {
@@ -78,8 +102,52 @@ class IpcComponentSource {
   }
 
  private:
+  Status ReadBuffer(int buffer_index, std::shared_ptr<Buffer>* out) {
+    const flatbuf::Buffer* buffer = metadata_->buffers()->Get(buffer_index);
+
+    if (buffer->length() == 0) {
+      *out = nullptr;
+      return Status::OK();
+    } else {
+      return file_->ReadAt(buffer->offset(), buffer->length(), out);
+    }
+  }
+
+  // See BodyCompression in Message.fbs
+  Status DecompressBuffer(Codec* codec, std::shared_ptr<Buffer>* buffer) const {
+    if (*buffer == nullptr) { return Status::OK(); }
+    const Buffer& stored = **buffer;
+    if (stored.size() < kCompressedBufferPrefixLength) {
+      return Status::Invalid("Compressed buffer is missing its length prefix");
+    }
+    int64_t uncompressed_length;
+    memcpy(&uncompressed_length, stored.data(), sizeof(int64_t));
+    const int64_t compressed_length = stored.size() - kCompressedBufferPrefixLength;
+
+    if (uncompressed_length == kUncompressedBufferMarker) {
+      *buffer = SliceBuffer(*buffer, kCompressedBufferPrefixLength, compressed_length);
+      return Status::OK();
+    }
+    if (uncompressed_length < 0 || uncompressed_length > kMaxDecompressedBufferLength) {
+      std::stringstream ss;
+      ss << "Invalid uncompressed buffer length: " << uncompressed_length;
+      return Status::Invalid(ss.str());
+    }
+    std::shared_ptr<MutableBuffer> result;
+    RETURN_NOT_OK(AllocateBuffer(pool_, uncompressed_length, &result));
+    RETURN_NOT_OK(codec->Decompress(compressed_length,
+        stored.data() + kCompressedBufferPrefixLength, uncompressed_length,
+        result->mutable_data()));
+    *buffer = result;
+    return Status::OK();
+  }
+
   const flatbuf::RecordBatch* metadata_;
   io::RandomAccessFile* file_;
+  MemoryPool* pool_;
+
+  // The decompressed buffers of a compressed body
+  std::vector<std::shared_ptr<Buffer>> decompressed_;
 };
 
 /// Bookkeeping struct for loading array objects from their constituent pieces of raw data
@@ -237,6 +305,12 @@ class ArrayLoader {
     return LoadChildren(type.children());
   }
 
+  Status Visit(const RunEndEncodedType& type) {
+    out_->buffers.resize(1);
+    RETURN_NOT_OK(LoadCommon());
+    return LoadChildren(type.children());
+  }
+
   Status Visit(const DictionaryType& type) {
     RETURN_NOT_OK(LoadArray(type.index_type(), context_, out_));
     out_->type = type_;
@@ -295,8 +369,9 @@ static Status LoadRecordBatchFromSource(const std::shared_ptr<Schema>& schema,
 
 static inline Status ReadRecordBatch(const flatbuf::RecordBatch* metadata,
     const std::shared_ptr<Schema>& schema, int max_recursion_depth,
-    io::RandomAccessFile* file, std::shared_ptr<RecordBatch>* out) {
-  IpcComponentSource source(metadata, file);
+    io::RandomAccessFile* file, MemoryPool* pool, std::shared_ptr<RecordBatch>* out) {
+  IpcComponentSource source(metadata, file, pool);
+  RETURN_NOT_OK(source.DecompressBuffers());
   return LoadRecordBatchFromSource(
       schema, metadata->length(), max_recursion_depth, &source, out);
 }
@@ -304,16 +379,24 @@ static inline Status ReadRecordBatch(const flatbuf::RecordBatch* metadata,
 Status ReadRecordBatch(const Buffer& metadata, const std::shared_ptr<Schema>& schema,
     int max_recursion_depth, io::RandomAccessFile* file,
     std::shared_ptr<RecordBatch>* out) {
+  return ReadRecordBatch(
+      metadata, schema, max_recursion_depth, file, default_memory_pool(), out);
+}
+
+Status ReadRecordBatch(const Buffer& metadata, const std::shared_ptr<Schema>& schema,
+    int max_recursion_depth, io::RandomAccessFile* file, MemoryPool* pool,
+    std::shared_ptr<RecordBatch>* out) {
   auto message = flatbuf::GetMessage(metadata.data());
   if (message->header_type() != flatbuf::MessageHeader_RecordBatch) {
     DCHECK_EQ(message->header_type(), flatbuf::MessageHeader_RecordBatch);
   }
   auto batch = reinterpret_cast<const flatbuf::RecordBatch*>(message->header());
-  return ReadRecordBatch(batch, schema, max_recursion_depth, file, out);
+  return ReadRecordBatch(batch, schema, max_recursion_depth, file, pool, out);
 }
 
 Status ReadDictionary(const Buffer& metadata, const DictionaryTypeMap& dictionary_types,
-    io::RandomAccessFile* file, int64_t* dictionary_id, std::shared_ptr<Array>* out) {
+    io::RandomAccessFile* file, MemoryPool* pool, int64_t* dictionary_id,
+    std::shared_ptr<Array>* out) {
   auto message = flatbuf::GetMessage(metadata.data());
   auto dictionary_batch =
       reinterpret_cast<const flatbuf::DictionaryBatch*>(message->header());
@@ -336,7 +419,7 @@ Status ReadDictionary(const Buffer& metadata, const DictionaryTypeMap& dictionar
   auto batch_meta =
       reinterpret_cast<const flatbuf::RecordBatch*>(dictionary_batch->data());
   RETURN_NOT_OK(
-      ReadRecordBatch(batch_meta, dummy_schema, kMaxNestingDepth, file, &batch));
+      ReadRecordBatch(batch_meta, dummy_schema, kMaxNestingDepth, file, pool, &batch));
 
   if (batch->num_columns() != 1) {
     return Status::Invalid("Dictionary record batch must only contain one field");
@@ -379,7 +462,7 @@ RecordBatchReader::~RecordBatchReader() {}
 
 class RecordBatchStreamReader::RecordBatchStreamReaderImpl {
  public:
-  RecordBatchStreamReaderImpl() {}
+  RecordBatchStreamReaderImpl() : pool_(default_memory_pool()) {}
   ~RecordBatchStreamReaderImpl() {}
 
   Status Open(std::unique_ptr<MessageReader> message_reader) {
@@ -397,7 +480,7 @@ class RecordBatchStreamReader::RecordBatchStreamReaderImpl {
     std::shared_ptr<Array> dictionary;
     int64_t id;
     RETURN_NOT_OK(ReadDictionary(
-        *message->metadata(), dictionary_types_, &reader, &id, &dictionary));
+        *message->metadata(), dictionary_types_, &reader, pool_, &id, &dictionary));
     return dictionary_memo_.AddDictionary(id, dictionary);
   }
 
@@ -430,13 +513,17 @@ class RecordBatchStreamReader::RecordBatchStreamReaderImpl {
     }
 
     io::BufferReader reader(message->body());
-    return ReadRecordBatch(*message->metadata(), schema_, &reader, batch);
+    return ReadRecordBatch(
+        *message->metadata(), schema_, kMaxNestingDepth, &reader, pool_, batch);
   }
 
   std::shared_ptr<Schema> schema() const { return schema_; }
 
+  void set_memory_pool(MemoryPool* pool) { pool_ = pool; }
+
  private:
   std::unique_ptr<MessageReader> message_reader_;
+  MemoryPool* pool_;
 
   // dictionary_id -> type
   DictionaryTypeMap dictionary_types_;
@@ -471,12 +558,18 @@ Status RecordBatchStreamReader::ReadNextRecordBatch(std::shared_ptr<RecordBatch>
   return impl_->ReadNextRecordBatch(batch);
 }
 
+void RecordBatchStreamReader::set_memory_pool(MemoryPool* pool) {
+  impl_->set_memory_pool(pool);
+}
+
 // ----------------------------------------------------------------------
 // Reader implementation
 
 class RecordBatchFileReader::RecordBatchFileReaderImpl {
  public:
-  RecordBatchFileReaderImpl() { dictionary_memo_ = std::make_shared<DictionaryMemo>(); }
+  RecordBatchFileReaderImpl() : pool_(default_memory_pool()) {
+    dictionary_memo_ = std::make_shared<DictionaryMemo>();
+  }
 
   Status ReadFooter() {
     int magic_size = static_cast<int>(strlen(kArrowMagicBytes));
@@ -550,7 +643,17 @@ class RecordBatchFileReader::RecordBatchFileReaderImpl {
         ReadMessage(block.offset, block.metadata_length, file_.get(), &message));
 
     io::BufferReader reader(message->body());
-    return ::arrow::ipc::ReadRecordBatch(*message->metadata(), schema_, &reader, batch);
+    return ::arrow::ipc::ReadRecordBatch(
+        *message->metadata(), schema_, kMaxNestingDepth, &reader, pool_, batch);
+  }
+
+  Status WillNeed(int i) {
+    if (i < 0 || i >= num_record_batches()) {
+      return Status::Invalid("Record batch index out of bounds");
+    }
+    FileBlock block = record_batch(i);
+    return file_->WillNeed(
+        {io::ReadRange{block.offset, block.metadata_length + block.body_length}});
   }
 
   Status ReadSchema() {
@@ -568,7 +671,7 @@ class RecordBatchFileReader::RecordBatchFileReaderImpl {
       std::shared_ptr<Array> dictionary;
       int64_t dictionary_id;
       RETURN_NOT_OK(ReadDictionary(*message->metadata(), dictionary_fields_, &reader,
-          &dictionary_id, &dictionary));
+          pool_, &dictionary_id, &dictionary));
       RETURN_NOT_OK(dictionary_memo_->AddDictionary(dictionary_id, dictionary));
     }
 
@@ -585,8 +688,11 @@ class RecordBatchFileReader::RecordBatchFileReaderImpl {
 
   std::shared_ptr<Schema> schema() const { return schema_; }
 
+  void set_memory_pool(MemoryPool* pool) { pool_ = pool; }
+
  private:
   std::shared_ptr<io::RandomAccessFile> file_;
+  MemoryPool* pool_;
 
   // The location where the Arrow file layout ends. May be the end of the file
   // or some other location if embedded in a larger file.
@@ -639,6 +745,14 @@ Status RecordBatchFileReader::ReadRecordBatch(
   return impl_->ReadRecordBatch(i, batch);
 }
 
+Status RecordBatchFileReader::WillNeed(int i) {
+  return impl_->WillNeed(i);
+}
+
+void RecordBatchFileReader::set_memory_pool(MemoryPool* pool) {
+  impl_->set_memory_pool(pool);
+}
+
 static Status ReadContiguousPayload(
     int64_t offset, io::RandomAccessFile* file, std::unique_ptr<Message>* message) {
   std::shared_ptr<Buffer> buffer;
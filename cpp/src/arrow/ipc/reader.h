@@ -30,6 +30,7 @@
 namespace arrow {
 
 class Buffer;
+class MemoryPool;
 class RecordBatch;
 class Schema;
 class Status;
@@ -85,6 +86,13 @@ class ARROW_EXPORT RecordBatchStreamReader : public RecordBatchReader {
   std::shared_ptr<Schema> schema() const override;
   Status ReadNextRecordBatch(std::shared_ptr<RecordBatch>* batch) override;
 
+  /// Set the memory pool that the buffers of compressed bodies read from now
+  /// on are decompressed into, the default memory pool otherwise. The
+  /// dictionaries were read by Open from the default pool
+  ///
+  /// \param pool the memory pool to use for required allocations
+  void set_memory_pool(MemoryPool* pool);
+
  private:
   RecordBatchStreamReader();
 
@@ -132,6 +140,21 @@ class ARROW_EXPORT RecordBatchFileReader {
   /// \return Status
   Status ReadRecordBatch(int i, std::shared_ptr<RecordBatch>* batch);
 
+  /// Hint that a record batch will be read soon, so that the file can fetch
+  /// it in the background, e.g. the next batch while decoding this one. See
+  /// io::RandomAccessFile::WillNeed
+  ///
+  /// \param(in) i the index of the record batch
+  /// \return Status
+  Status WillNeed(int i);
+
+  /// Set the memory pool that the buffers of compressed bodies read from now
+  /// on are decompressed into, the default memory pool otherwise. The
+  /// dictionaries were read by Open from the default pool
+  ///
+  /// \param pool the memory pool to use for required allocations
+  void set_memory_pool(MemoryPool* pool);
+
  private:
   RecordBatchFileReader();
 
@@ -171,6 +194,19 @@ Status ARROW_EXPORT ReadRecordBatch(const Buffer& metadata,
     const std::shared_ptr<Schema>& schema, int max_recursion_depth,
     io::RandomAccessFile* file, std::shared_ptr<RecordBatch>* out);
 
+/// Read record batch from file given metadata and schema, decompressing a
+/// compressed body into buffers allocated from pool
+///
+/// \param(in) metadata a Message containing the record batch metadata
+/// \param(in) schema the record batch schema
+/// \param(in) max_recursion_depth the maximum permitted nesting depth
+/// \param(in) file a random access file
+/// \param(in) pool the memory pool for decompressed buffers
+/// \param(out) out the read record batch
+Status ARROW_EXPORT ReadRecordBatch(const Buffer& metadata,
+    const std::shared_ptr<Schema>& schema, int max_recursion_depth,
+    io::RandomAccessFile* file, MemoryPool* pool, std::shared_ptr<RecordBatch>* out);
+
 /// Read record batch as encapsulated IPC message with metadata size prefix and
 /// header
 ///
@@ -19,6 +19,7 @@
 #define ARROW_IPC_UTIL_H
 
 #include <cstdint>
+#include <limits>
 
 #include "arrow/array.h"
 #include "arrow/io/interfaces.h"
@@ -37,6 +38,24 @@ static inline int64_t PaddedLength(int64_t nbytes, int64_t alignment = kArrowAli
   return ((nbytes + alignment - 1) / alignment) * alignment;
 }
 
+// Compressed body buffers are prefixed by their uncompressed length as an
+// int64, -1 for buffers stored uncompressed
+static constexpr int64_t kCompressedBufferPrefixLength = sizeof(int64_t);
+static constexpr int64_t kUncompressedBufferMarker = -1;
+
+// Larger uncompressed length prefixes are corrupt: the buffer could not be
+// allocated, its size overflowing once padded
+static constexpr int64_t kMaxDecompressedBufferLength =
+    std::numeric_limits<int64_t>::max() - kArrowAlignment;
+
+// Bodies smaller than this are compressed and decompressed on the calling
+// thread only, starting threads costing more than it saves
+static constexpr int64_t kMinParallelCompressionBytes = 1 << 20;
+
+// Body buffers at least this large are sampled before being compressed, and
+// stored uncompressed if the sample compresses too little (see CodecSelector)
+static constexpr int64_t kMinSampledCompressionBytes = 1 << 18;
+
 }  // namespace ipc
 }  // namespace arrow
 
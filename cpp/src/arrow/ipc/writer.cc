@@ -36,7 +36,10 @@
 #include "arrow/tensor.h"
 #include "arrow/type.h"
 #include "arrow/util/bit-util.h"
+#include "arrow/util/compression.h"
+#include "arrow/util/compression_adaptive.h"
 #include "arrow/util/logging.h"
+#include "arrow/util/parallel.h"
 
 namespace arrow {
 namespace ipc {
@@ -90,11 +93,12 @@ static inline bool NeedTruncate(
 class RecordBatchSerializer : public ArrayVisitor {
  public:
   RecordBatchSerializer(MemoryPool* pool, int64_t buffer_start_offset,
-      int max_recursion_depth, bool allow_64bit)
+      int max_recursion_depth, bool allow_64bit, Compression::type compression)
       : pool_(pool),
         max_recursion_depth_(max_recursion_depth),
         buffer_start_offset_(buffer_start_offset),
-        allow_64bit_(allow_64bit) {
+        allow_64bit_(allow_64bit),
+        compression_(compression) {
     DCHECK_GT(max_recursion_depth, 0);
   }
 
@@ -136,6 +140,8 @@ class RecordBatchSerializer : public ArrayVisitor {
       RETURN_NOT_OK(VisitArray(*batch.column(i)));
     }
 
+    if (compression_ != Compression::UNCOMPRESSED) { RETURN_NOT_OK(CompressBuffers()); }
+
     // The position for the start of a buffer relative to the passed frame of
     // reference. May be 0 or some other position in an address space
     int64_t offset = buffer_start_offset_;
@@ -164,7 +170,12 @@ class RecordBatchSerializer : public ArrayVisitor {
       // are using from any OS-level shared memory. The thought is that systems
       // may (in the future) associate integer page id's with physical memory
       // pages (according to whatever is the desired shared memory mechanism)
-      buffer_meta_.push_back({kNoPageId, offset, size + padding});
+      //
+      // Compressed buffers are described without their padding, so that the
+      // codec is given the compressed bytes only
+      const int64_t length =
+          compression_ == Compression::UNCOMPRESSED ? size + padding : size;
+      buffer_meta_.push_back({kNoPageId, offset, length});
       offset += size + padding;
     }
 
@@ -178,7 +189,7 @@ class RecordBatchSerializer : public ArrayVisitor {
   virtual Status WriteMetadataMessage(
       int64_t num_rows, int64_t body_length, std::shared_ptr<Buffer>* out) {
     return WriteRecordBatchMessage(
-        num_rows, body_length, field_nodes_, buffer_meta_, out);
+        num_rows, body_length, field_nodes_, buffer_meta_, out, compression_);
   }
 
   Status Write(const RecordBatch& batch, io::OutputStream* dst, int32_t* metadata_length,
@@ -204,7 +215,9 @@ class RecordBatchSerializer : public ArrayVisitor {
     DCHECK(BitUtil::IsMultipleOf8(current_position));
 #endif
 
-    // Now write the buffers
+    // Now write the buffers, gathered into a single write
+    std::vector<io::WriteRange> pieces;
+    pieces.reserve(2 * buffers_.size());
     for (size_t i = 0; i < buffers_.size(); ++i) {
       const Buffer* buffer = buffers_[i].get();
       int64_t size = 0;
@@ -216,10 +229,11 @@ class RecordBatchSerializer : public ArrayVisitor {
         padding = BitUtil::RoundUpToMultipleOf64(size) - size;
       }
 
-      if (size > 0) { RETURN_NOT_OK(dst->Write(buffer->data(), size)); }
+      if (size > 0) { pieces.emplace_back(buffer->data(), size); }
 
-      if (padding > 0) { RETURN_NOT_OK(dst->Write(kPaddingBytes, padding)); }
+      if (padding > 0) { pieces.emplace_back(kPaddingBytes, padding); }
     }
+    RETURN_NOT_OK(dst->WriteV(pieces));
 
 #ifndef NDEBUG
     RETURN_NOT_OK(dst->Tell(&current_position));
@@ -230,6 +244,72 @@ class RecordBatchSerializer : public ArrayVisitor {
   }
 
  protected:
+  // Replace every buffer of nonzero length by its compressed form, see
+  // BodyCompression in Message.fbs. The buffers of all columns are compressed
+  // in parallel
+  Status CompressBuffers() {
+    std::unique_ptr<Codec> codec;
+    RETURN_NOT_OK(Codec::Create(compression_, &codec));
+
+    int64_t total_size = 0;
+    int64_t max_size = 0;
+    for (const auto& buffer : buffers_) {
+      if (buffer) {
+        total_size += buffer->size();
+        max_size = std::max(max_size, buffer->size());
+      }
+    }
+    // The selector only chooses between the body codec and no compression
+    std::unique_ptr<CodecSelector> selector;
+    if (max_size >= kMinSampledCompressionBytes) {
+      CodecSelectorOptions options;
+      options.fast_codec = options.strong_codec = compression_;
+      RETURN_NOT_OK(CodecSelector::Make(options, &selector));
+    }
+    const int num_threads = total_size < kMinParallelCompressionBytes ? 1 : 0;
+    return ParallelFor(num_threads, static_cast<int64_t>(buffers_.size()),
+        [this, &codec, &selector](int64_t i) {
+          return CompressBuffer(codec.get(), selector.get(), &buffers_[i]);
+        });
+  }
+
+  Status CompressBuffer(
+      Codec* codec, CodecSelector* selector, std::shared_ptr<Buffer>* buffer) const {
+    const Buffer* input = buffer->get();
+    if (input == nullptr || input->size() == 0) { return Status::OK(); }
+    const int64_t input_size = input->size();
+    const int64_t max_length = codec->MaxCompressedLen(input_size, input->data());
+
+    bool compress = true;
+    if (input_size >= kMinSampledCompressionBytes) {
+      CodecChoice choice;
+      RETURN_NOT_OK(selector->Select(input_size, input->data(), &choice));
+      compress = choice.codec != Compression::UNCOMPRESSED;
+    }
+
+    auto result = std::make_shared<PoolBuffer>(pool_);
+    RETURN_NOT_OK(result->Resize(
+        kCompressedBufferPrefixLength + std::max(max_length, input_size), false));
+    uint8_t* out = result->mutable_data() + kCompressedBufferPrefixLength;
+
+    int64_t uncompressed_length = input_size;
+    int64_t stored_length = input_size;
+    if (compress) {
+      RETURN_NOT_OK(
+          codec->Compress(input_size, input->data(), max_length, out, &stored_length));
+    }
+    if (stored_length >= input_size) {
+      // Incompressible, stored as is
+      uncompressed_length = kUncompressedBufferMarker;
+      memcpy(out, input->data(), input_size);
+      stored_length = input_size;
+    }
+    memcpy(result->mutable_data(), &uncompressed_length, sizeof(int64_t));
+    RETURN_NOT_OK(result->Resize(kCompressedBufferPrefixLength + stored_length, false));
+    *buffer = result;
+    return Status::OK();
+  }
+
   template <typename ArrayType>
   Status VisitFixedWidth(const ArrayType& array) {
     std::shared_ptr<Buffer> data = array.values();
@@ -470,6 +550,47 @@ class RecordBatchSerializer : public ArrayVisitor {
     return array.indices()->Accept(this);
   }
 
+  Status Visit(const RunEndEncodedArray& array) override {
+    std::shared_ptr<Array> run_ends = array.run_ends();
+    std::shared_ptr<Array> values = array.values();
+
+    const int64_t physical_length = array.physical_length();
+    if (array.offset() != 0 || physical_length < run_ends->length()) {
+      // Only write the runs the slice covers, with run ends relative to the
+      // start of the slice and the last one clipped to its length
+      const int64_t physical_offset = array.physical_offset();
+      const int32_t* unshifted_ends = array.raw_run_ends() + physical_offset;
+
+      std::shared_ptr<MutableBuffer> shifted_ends_buffer;
+      RETURN_NOT_OK(
+          AllocateBuffer(pool_, physical_length * sizeof(int32_t), &shifted_ends_buffer));
+      int32_t* shifted_ends =
+          reinterpret_cast<int32_t*>(shifted_ends_buffer->mutable_data());
+      for (int64_t i = 0; i < physical_length; ++i) {
+        shifted_ends[i] = static_cast<int32_t>(
+            std::min(unshifted_ends[i] - array.offset(), array.length()));
+      }
+      run_ends = std::make_shared<Int32Array>(physical_length, shifted_ends_buffer);
+      values = values->Slice(physical_offset, physical_length);
+    }
+
+    --max_recursion_depth_;
+    RETURN_NOT_OK(VisitArray(*run_ends));
+    RETURN_NOT_OK(VisitArray(*values));
+    ++max_recursion_depth_;
+    return Status::OK();
+  }
+
+  Status Visit(const BitPackedArray& array) override {
+    // Values are not byte aligned, so slices are copied out like bitmaps
+    const int64_t bit_width = array.bit_width();
+    std::shared_ptr<Buffer> data;
+    RETURN_NOT_OK(GetTruncatedBitmap(array.offset() * bit_width,
+        array.length() * bit_width, array.values(), pool_, &data));
+    buffers_.push_back(data);
+    return Status::OK();
+  }
+
   // In some cases, intermediate buffers may need to be allocated (with sliced arrays)
   MemoryPool* pool_;
 
@@ -480,6 +601,7 @@ class RecordBatchSerializer : public ArrayVisitor {
   int64_t max_recursion_depth_;
   int64_t buffer_start_offset_;
   bool allow_64bit_;
+  Compression::type compression_;
 };
 
 class DictionaryWriter : public RecordBatchSerializer {
@@ -488,8 +610,8 @@ class DictionaryWriter : public RecordBatchSerializer {
 
   Status WriteMetadataMessage(
       int64_t num_rows, int64_t body_length, std::shared_ptr<Buffer>* out) override {
-    return WriteDictionaryMessage(
-        dictionary_id_, num_rows, body_length, field_nodes_, buffer_meta_, out);
+    return WriteDictionaryMessage(dictionary_id_, num_rows, body_length, field_nodes_,
+        buffer_meta_, out, compression_);
   }
 
   Status Write(int64_t dictionary_id, const std::shared_ptr<Array>& dictionary,
@@ -522,9 +644,10 @@ Status AlignStreamPosition(io::OutputStream* stream) {
 
 Status WriteRecordBatch(const RecordBatch& batch, int64_t buffer_start_offset,
     io::OutputStream* dst, int32_t* metadata_length, int64_t* body_length,
-    MemoryPool* pool, int max_recursion_depth, bool allow_64bit) {
+    MemoryPool* pool, int max_recursion_depth, bool allow_64bit,
+    Compression::type compression) {
   RecordBatchSerializer writer(
-      pool, buffer_start_offset, max_recursion_depth, allow_64bit);
+      pool, buffer_start_offset, max_recursion_depth, allow_64bit, compression);
   return writer.Write(batch, dst, metadata_length, body_length);
 }
 
@@ -557,8 +680,9 @@ Status WriteTensor(const Tensor& tensor, io::OutputStream* dst, int32_t* metadat
 
 Status WriteDictionary(int64_t dictionary_id, const std::shared_ptr<Array>& dictionary,
     int64_t buffer_start_offset, io::OutputStream* dst, int32_t* metadata_length,
-    int64_t* body_length, MemoryPool* pool) {
-  DictionaryWriter writer(pool, buffer_start_offset, kMaxNestingDepth, false);
+    int64_t* body_length, MemoryPool* pool, Compression::type compression) {
+  DictionaryWriter writer(
+      pool, buffer_start_offset, kMaxNestingDepth, false, compression);
   return writer.Write(dictionary_id, dictionary, dst, metadata_length, body_length);
 }
 
@@ -587,13 +711,18 @@ Status GetTensorSize(const Tensor& tensor, int64_t* size) {
 
 RecordBatchWriter::~RecordBatchWriter() {}
 
+void RecordBatchWriter::set_compression(Compression::type compression) {}
+
 // ----------------------------------------------------------------------
 // Stream writer implementation
 
 class RecordBatchStreamWriter::RecordBatchStreamWriterImpl {
  public:
   RecordBatchStreamWriterImpl()
-      : pool_(default_memory_pool()), position_(-1), started_(false) {}
+      : pool_(default_memory_pool()),
+        compression_(Compression::UNCOMPRESSED),
+        position_(-1),
+        started_(false) {}
 
   virtual ~RecordBatchStreamWriterImpl() = default;
 
@@ -653,7 +782,7 @@ class RecordBatchStreamWriter::RecordBatchStreamWriterImpl {
       // Frame of reference in file format is 0, see ARROW-384
       const int64_t buffer_start_offset = 0;
       RETURN_NOT_OK(WriteDictionary(entry.first, entry.second, buffer_start_offset, sink_,
-          &block->metadata_length, &block->body_length, pool_));
+          &block->metadata_length, &block->body_length, pool_, compression_));
       RETURN_NOT_OK(UpdatePosition());
       DCHECK(position_ % 8 == 0) << "WriteDictionary did not perform aligned writes";
     }
@@ -670,7 +799,7 @@ class RecordBatchStreamWriter::RecordBatchStreamWriterImpl {
     const int64_t buffer_start_offset = 0;
     RETURN_NOT_OK(arrow::ipc::WriteRecordBatch(batch, buffer_start_offset, sink_,
         &block->metadata_length, &block->body_length, pool_, kMaxNestingDepth,
-        allow_64bit));
+        allow_64bit, compression_));
     RETURN_NOT_OK(UpdatePosition());
 
     DCHECK(position_ % 8 == 0) << "WriteRecordBatch did not perform aligned writes";
@@ -702,6 +831,8 @@ class RecordBatchStreamWriter::RecordBatchStreamWriterImpl {
 
   void set_memory_pool(MemoryPool* pool) { pool_ = pool; }
 
+  void set_compression(Compression::type compression) { compression_ = compression; }
+
  protected:
   io::OutputStream* sink_;
   std::shared_ptr<Schema> schema_;
@@ -711,6 +842,7 @@ class RecordBatchStreamWriter::RecordBatchStreamWriterImpl {
   DictionaryMemo dictionary_memo_;
 
   MemoryPool* pool_;
+  Compression::type compression_;
 
   int64_t position_;
   bool started_;
@@ -734,6 +866,10 @@ void RecordBatchStreamWriter::set_memory_pool(MemoryPool* pool) {
   impl_->set_memory_pool(pool);
 }
 
+void RecordBatchStreamWriter::set_compression(Compression::type compression) {
+  impl_->set_compression(compression);
+}
+
 Status RecordBatchStreamWriter::Open(io::OutputStream* sink,
     const std::shared_ptr<Schema>& schema,
     std::shared_ptr<RecordBatchStreamWriter>* out) {
@@ -808,5 +944,13 @@ Status RecordBatchFileWriter::Close() {
   return impl_->Close();
 }
 
+void RecordBatchFileWriter::set_memory_pool(MemoryPool* pool) {
+  impl_->set_memory_pool(pool);
+}
+
+void RecordBatchFileWriter::set_compression(Compression::type compression) {
+  impl_->set_compression(compression);
+}
+
 }  // namespace ipc
 }  // namespace arrow
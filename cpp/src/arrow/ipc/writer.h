@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "arrow/ipc/metadata.h"
+#include "arrow/util/compression.h"
 #include "arrow/util/visibility.h"
 
 namespace arrow {
@@ -68,6 +69,18 @@ class ARROW_EXPORT RecordBatchWriter {
   ///
   /// \param pool the memory pool to use for required allocations
   virtual void set_memory_pool(MemoryPool* pool) = 0;
+
+  /// Compress the buffers of the record batches and dictionaries written from
+  /// now on, Compression::UNCOMPRESSED (the default) to write them as is.
+  /// Only LZ4 and ZSTD are supported; writes fail with Invalid for other
+  /// codecs. The buffers of a batch are compressed in parallel, and buffers
+  /// that do not get smaller are stored uncompressed. Large buffers are
+  /// sampled first, and stored uncompressed without compressing them whole
+  /// if the sample compresses too little. Writers that do not support
+  /// compression ignore it, which the default implementation does
+  ///
+  /// \param compression the codec to use
+  virtual void set_compression(Compression::type compression);
 };
 
 /// \class RecordBatchStreamWriter
@@ -90,6 +103,7 @@ class ARROW_EXPORT RecordBatchStreamWriter : public RecordBatchWriter {
   Status WriteRecordBatch(const RecordBatch& batch, bool allow_64bit = false) override;
   Status Close() override;
   void set_memory_pool(MemoryPool* pool) override;
+  void set_compression(Compression::type compression) override;
 
  protected:
   RecordBatchStreamWriter();
@@ -117,6 +131,8 @@ class ARROW_EXPORT RecordBatchFileWriter : public RecordBatchStreamWriter {
 
   Status WriteRecordBatch(const RecordBatch& batch, bool allow_64bit = false) override;
   Status Close() override;
+  void set_memory_pool(MemoryPool* pool) override;
+  void set_compression(Compression::type compression) override;
 
  private:
   RecordBatchFileWriter();
@@ -144,15 +160,18 @@ class ARROW_EXPORT RecordBatchFileWriter : public RecordBatchStreamWriter {
 /// including padding to a 64-byte boundary
 /// \param(out) body_length: the size of the contiguous buffer block plus
 /// padding bytes
+/// \param(in) compression codec compressing each buffer (LZ4 or ZSTD), see
+/// BodyCompression in format/Message.fbs
 Status ARROW_EXPORT WriteRecordBatch(const RecordBatch& batch,
     int64_t buffer_start_offset, io::OutputStream* dst, int32_t* metadata_length,
     int64_t* body_length, MemoryPool* pool, int max_recursion_depth = kMaxNestingDepth,
-    bool allow_64bit = false);
+    bool allow_64bit = false, Compression::type compression = Compression::UNCOMPRESSED);
 
 // Write Array as a DictionaryBatch message
 Status WriteDictionary(int64_t dictionary_id, const std::shared_ptr<Array>& dictionary,
     int64_t buffer_start_offset, io::OutputStream* dst, int32_t* metadata_length,
-    int64_t* body_length, MemoryPool* pool);
+    int64_t* body_length, MemoryPool* pool,
+    Compression::type compression = Compression::UNCOMPRESSED);
 
 // Compute the precise number of bytes needed in a contiguous memory segment to
 // write the record batch. This involves generating the complete serialized
@@ -233,6 +233,33 @@ class ArrayPrinter {
     return PrettyPrint(*array.indices(), indent_ + 2, sink_);
   }
 
+  Status Visit(const RunEndEncodedArray& array) {
+    Newline();
+    Write("-- run_ends: ");
+    RETURN_NOT_OK(PrettyPrint(*array.run_ends(), indent_ + 2, sink_));
+
+    Newline();
+    Write("-- values: ");
+    return PrettyPrint(*array.values(), indent_ + 2, sink_);
+  }
+
+  Status Visit(const BitPackedArray& array) {
+    const bool is_uint64 = array.value_type()->id() == Type::UINT64;
+    OpenArray();
+    for (int64_t i = 0; i < array.length(); ++i) {
+      if (i > 0) { (*sink_) << ", "; }
+      if (array.IsNull(i)) {
+        Write("null");
+      } else if (is_uint64) {
+        (*sink_) << static_cast<uint64_t>(array.Value(i));
+      } else {
+        (*sink_) << array.Value(i);
+      }
+    }
+    CloseArray();
+    return Status::OK();
+  }
+
   Status Print() { return VisitArrayInline(array_, this); }
 
  private:
@@ -622,7 +622,7 @@ Status RawDecimalToString(const uint8_t* bytes, int precision, int scale,
     bool is_negative, std::string* result) {
   DCHECK_NE(bytes, nullptr);
   DCHECK_NE(result, nullptr);
-  RETURN_NOT_OK(ValidateDecimalPrecision<boost::multiprecision::int128_t>(precision));
+  RETURN_NOT_OK(ValidateDecimalPrecision<decimal::Int128>(precision));
   decimal::Decimal128 decimal;
   FromBytes(bytes, is_negative, &decimal);
   *result = ToString(decimal, precision, scale);
@@ -1589,6 +1589,14 @@ class ArrowDeserializer {
 
   Status Visit(const UnionType& type) { return Status::NotImplemented("union type"); }
 
+  Status Visit(const RunEndEncodedType& type) {
+    return Status::NotImplemented("run_end_encoded type");
+  }
+
+  Status Visit(const BitPackedType& type) {
+    return Status::NotImplemented("bit_packed type");
+  }
+
   Status Convert(PyObject** out) {
     RETURN_NOT_OK(VisitTypeInline(*col_->type(), this));
     *out = result_;
@@ -366,6 +366,8 @@ class PandasConverter {
 
   Status Visit(const DictionaryType& type) { return TypeNotImplemented(type.ToString()); }
 
+  Status Visit(const BitPackedType& type) { return TypeNotImplemented(type.ToString()); }
+
   Status Visit(const NestedType& type) { return TypeNotImplemented(type.ToString()); }
 
   Status Convert() {
@@ -63,13 +63,13 @@ TEST(DecimalTest, TestPythonDecimalToString) {
   ASSERT_NE(pydecimal.obj(), nullptr);
   ASSERT_EQ(PyErr_Occurred(), nullptr);
 
-  boost::multiprecision::int128_t boost_decimal(decimal_string);
+  decimal::Int128 expected_value(decimal_string);
   PyObject* python_object = pydecimal.obj();
   ASSERT_NE(python_object, nullptr);
 
   std::string string_result;
   ASSERT_OK(PythonDecimalToString(python_object, &string_result));
-  ASSERT_EQ(boost_decimal.str(), string_result);
+  ASSERT_EQ(expected_value.ToString(), string_result);
 }
 
 TEST(PandasConversionTest, TestObjectBlockWriteFails) {
@@ -246,6 +246,34 @@ std::string DictionaryType::ToString() const {
   return ss.str();
 }
 
+// ----------------------------------------------------------------------
+// Encoded types
+
+RunEndEncodedType::RunEndEncodedType(const std::shared_ptr<DataType>& value_type)
+    : NestedType(Type::RUN_END_ENCODED) {
+  children_ = {std::make_shared<Field>("run_ends", int32(), false),
+      std::make_shared<Field>("values", value_type)};
+}
+
+std::string RunEndEncodedType::ToString() const {
+  std::stringstream ss;
+  ss << "run_end_encoded<" << value_type()->ToString() << ">";
+  return ss.str();
+}
+
+BitPackedType::BitPackedType(const std::shared_ptr<DataType>& value_type, int bit_width)
+    : FixedWidthType(Type::BIT_PACKED), value_type_(value_type), bit_width_(bit_width) {
+  DCHECK(is_integer(value_type->id())) << "Bit-packed values must be integers";
+  DCHECK_GE(bit_width, 1);
+  DCHECK_LE(bit_width, static_cast<const FixedWidthType&>(*value_type).bit_width());
+}
+
+std::string BitPackedType::ToString() const {
+  std::stringstream ss;
+  ss << "bit_packed<" << value_type_->ToString() << ", bits=" << bit_width_ << ">";
+  return ss.str();
+}
+
 // ----------------------------------------------------------------------
 // Null type
 
@@ -364,6 +392,8 @@ ACCEPT_VISITOR(Time64Type);
 ACCEPT_VISITOR(TimestampType);
 ACCEPT_VISITOR(IntervalType);
 ACCEPT_VISITOR(DictionaryType);
+ACCEPT_VISITOR(RunEndEncodedType);
+ACCEPT_VISITOR(BitPackedType);
 
 #define TYPE_FACTORY(NAME, KLASS)                                        \
   std::shared_ptr<DataType> NAME() {                                     \
@@ -431,6 +461,15 @@ std::shared_ptr<DataType> dictionary(const std::shared_ptr<DataType>& index_type
   return std::make_shared<DictionaryType>(index_type, dict_values);
 }
 
+std::shared_ptr<DataType> run_end_encoded(const std::shared_ptr<DataType>& value_type) {
+  return std::make_shared<RunEndEncodedType>(value_type);
+}
+
+std::shared_ptr<DataType> bit_packed(
+    const std::shared_ptr<DataType>& value_type, int bit_width) {
+  return std::make_shared<BitPackedType>(value_type, bit_width);
+}
+
 std::shared_ptr<Field> field(const std::string& name,
     const std::shared_ptr<DataType>& type, bool nullable,
     const std::shared_ptr<const KeyValueMetadata>& metadata) {
@@ -478,6 +517,10 @@ std::vector<BufferDescr> StructType::GetBufferLayout() const {
   return {kValidityBuffer};
 }
 
+std::vector<BufferDescr> RunEndEncodedType::GetBufferLayout() const {
+  return {kValidityBuffer};
+}
+
 std::vector<BufferDescr> UnionType::GetBufferLayout() const {
   if (mode_ == UnionMode::SPARSE) {
     return {kValidityBuffer, kTypeBuffer};
@@ -110,7 +110,13 @@ struct Type {
     UNION,
 
     // Dictionary aka Category type
-    DICTIONARY
+    DICTIONARY,
+
+    // Values stored as runs, see RunEndEncodedType
+    RUN_END_ENCODED,
+
+    // Integers packed into fewer bits, see BitPackedType
+    BIT_PACKED
   };
 };
 
@@ -690,6 +696,57 @@ class ARROW_EXPORT DictionaryType : public FixedWidthType {
   bool ordered_;
 };
 
+// ----------------------------------------------------------------------
+// Encoded types (run-end encoded and bit-packed data in memory)
+
+/// \brief Values stored as runs of equal consecutive values
+///
+/// The type has two children: "run_ends", non-nullable int32 holding for
+/// every run the logical position one past its last slot, and "values",
+/// holding the value of every run. Run ends are absolute positions, so a
+/// slice shares them with its parent. Null slots are runs of null values;
+/// the encoded array itself never has a validity bitmap
+class ARROW_EXPORT RunEndEncodedType : public NestedType {
+ public:
+  static constexpr Type::type type_id = Type::RUN_END_ENCODED;
+
+  explicit RunEndEncodedType(const std::shared_ptr<DataType>& value_type);
+
+  std::shared_ptr<DataType> value_type() const { return children_[1]->type(); }
+
+  Status Accept(TypeVisitor* visitor) const override;
+  std::string ToString() const override;
+  static std::string name() { return "run_end_encoded"; }
+
+  std::vector<BufferDescr> GetBufferLayout() const override;
+};
+
+/// \brief Integers stored in a fixed number of bits each
+///
+/// Values are packed least significant bit first, taking bit_width bits each
+/// of the data buffer. Signed values are stored in two's complement and
+/// sign-extended when decoded
+class ARROW_EXPORT BitPackedType : public FixedWidthType {
+ public:
+  static constexpr Type::type type_id = Type::BIT_PACKED;
+
+  /// value_type must be an integer type at least bit_width bits wide, and
+  /// bit_width at least 1
+  BitPackedType(const std::shared_ptr<DataType>& value_type, int bit_width);
+
+  int bit_width() const override { return bit_width_; }
+
+  std::shared_ptr<DataType> value_type() const { return value_type_; }
+
+  Status Accept(TypeVisitor* visitor) const override;
+  std::string ToString() const override;
+  static std::string name() { return "bit_packed"; }
+
+ private:
+  std::shared_ptr<DataType> value_type_;
+  int bit_width_;
+};
+
 // ----------------------------------------------------------------------
 // Schema
 
@@ -780,6 +837,12 @@ std::shared_ptr<DataType> ARROW_EXPORT union_(
 std::shared_ptr<DataType> ARROW_EXPORT dictionary(
     const std::shared_ptr<DataType>& index_type, const std::shared_ptr<Array>& values);
 
+std::shared_ptr<DataType> ARROW_EXPORT run_end_encoded(
+    const std::shared_ptr<DataType>& value_type);
+
+std::shared_ptr<DataType> ARROW_EXPORT bit_packed(
+    const std::shared_ptr<DataType>& value_type, int bit_width);
+
 std::shared_ptr<Field> ARROW_EXPORT field(const std::string& name,
     const std::shared_ptr<DataType>& type, bool nullable = true,
     const std::shared_ptr<const KeyValueMetadata>& metadata = nullptr);
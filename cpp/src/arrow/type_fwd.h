@@ -40,6 +40,12 @@ class Schema;
 class DictionaryType;
 class DictionaryArray;
 
+class RunEndEncodedType;
+class RunEndEncodedArray;
+
+class BitPackedType;
+class BitPackedArray;
+
 class NullType;
 class NullArray;
 
@@ -296,6 +296,18 @@ struct TypeTraits<DictionaryType> {
   constexpr static bool is_parameter_free = false;
 };
 
+template <>
+struct TypeTraits<RunEndEncodedType> {
+  using ArrayType = RunEndEncodedArray;
+  constexpr static bool is_parameter_free = false;
+};
+
+template <>
+struct TypeTraits<BitPackedType> {
+  using ArrayType = BitPackedArray;
+  constexpr static bool is_parameter_free = false;
+};
+
 // Not all type classes have a c_type
 template <typename T>
 struct as_void {
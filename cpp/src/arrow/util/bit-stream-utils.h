@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <string.h>
+#include <type_traits>
 
 #include "arrow/util/bit-util.h"
 #include "arrow/util/bpacking.h"
@@ -75,6 +76,10 @@ class BitWriter {
   // Writes an int zigzag encoded.
   bool PutZigZagVlqInt(int32_t v);
 
+  /// 64-bit versions of PutVlqInt and PutZigZagVlqInt, taking up to 10 bytes
+  bool PutVlqInt64(uint64_t v);
+  bool PutZigZagVlqInt64(int64_t v);
+
   /// Get a pointer to the next aligned byte and advance the underlying buffer
   /// by num_bytes.
   /// Returns NULL if there was not enough space.
@@ -145,6 +150,10 @@ class BitReader {
   // Reads a zigzag encoded int `into` v.
   bool GetZigZagVlqInt(int32_t* v);
 
+  /// 64-bit versions of GetVlqInt and GetZigZagVlqInt
+  bool GetVlqInt64(uint64_t* v);
+  bool GetZigZagVlqInt64(int64_t* v);
+
   /// Returns the number of bytes left in the stream, not including the current
   /// byte (i.e., there may be an additional fraction of a byte).
   int bytes_left() {
@@ -154,6 +163,9 @@ class BitReader {
   /// Maximum byte length of a vlq encoded int
   static const int MAX_VLQ_BYTE_LEN = 5;
 
+  /// Maximum byte length of a vlq encoded 64-bit int
+  static const int MAX_VLQ_BYTE_LEN_64 = 10;
+
  private:
   const uint8_t* buffer_;
   int max_bytes_;
@@ -301,6 +313,15 @@ inline int BitReader::GetBatch(int num_bits, T* v, int batch_size) {
         reinterpret_cast<uint32_t*>(v + i), batch_size - i, num_bits);
     i += num_unpacked;
     byte_offset += num_unpacked * num_bits / 8;
+  } else if (sizeof(T) <= 2 && !std::is_same<T, bool>::value) {
+    // Narrow integers are unpacked directly, without a 32-bit staging buffer
+    const uint32_t* in = reinterpret_cast<const uint32_t*>(buffer + byte_offset);
+    int num_unpacked =
+        sizeof(T) == 1
+            ? unpack32(in, reinterpret_cast<uint8_t*>(v + i), batch_size - i, num_bits)
+            : unpack32(in, reinterpret_cast<uint16_t*>(v + i), batch_size - i, num_bits);
+    i += num_unpacked;
+    byte_offset += num_unpacked * num_bits / 8;
   } else {
     const int buffer_size = 1024;
     uint32_t unpack_buffer[buffer_size];
@@ -392,6 +413,41 @@ inline bool BitReader::GetZigZagVlqInt(int32_t* v) {
   return true;
 }
 
+inline bool BitWriter::PutVlqInt64(uint64_t v) {
+  bool result = true;
+  while ((v & 0xFFFFFFFFFFFFFF80ULL) != 0) {
+    result &= PutAligned<uint8_t>(static_cast<uint8_t>((v & 0x7F) | 0x80), 1);
+    v >>= 7;
+  }
+  result &= PutAligned<uint8_t>(static_cast<uint8_t>(v & 0x7F), 1);
+  return result;
+}
+
+inline bool BitWriter::PutZigZagVlqInt64(int64_t v) {
+  const uint64_t u = (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+  return PutVlqInt64(u);
+}
+
+inline bool BitReader::GetVlqInt64(uint64_t* v) {
+  *v = 0;
+  int shift = 0;
+  uint8_t byte = 0;
+  do {
+    if (shift >= 7 * MAX_VLQ_BYTE_LEN_64) return false;
+    if (!GetAligned<uint8_t>(1, &byte)) return false;
+    *v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    shift += 7;
+  } while ((byte & 0x80) != 0);
+  return true;
+}
+
+inline bool BitReader::GetZigZagVlqInt64(int64_t* v) {
+  uint64_t u;
+  if (!GetVlqInt64(&u)) return false;
+  *v = static_cast<int64_t>((u >> 1) ^ (~(u & 1) + 1));
+  return true;
+}
+
 }  // namespace arrow
 
 #endif  // ARROW_UTIL_BIT_STREAM_UTILS_H
@@ -0,0 +1,218 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "arrow/test-util.h"
+#include "arrow/util/bit-util.h"
+#include "arrow/util/dispatch.h"
+
+namespace arrow {
+
+typedef void (*BitmapOpFunc)(const uint8_t*, int64_t, const uint8_t*, int64_t, int64_t,
+    int64_t, uint8_t*);
+
+static constexpr int64_t kBitmapBytes = 1 << 16;
+
+// Combine two bitmaps of kBitmapBytes bytes at the given bit offsets
+static void BenchmarkBitmapOp(benchmark::State& state,  // NOLINT non-const reference
+    BitmapOpFunc op, int64_t left_offset, int64_t right_offset) {
+  std::vector<uint8_t> left(kBitmapBytes), right(kBitmapBytes), out(kBitmapBytes);
+  test::random_bytes(kBitmapBytes, 0, left.data());
+  test::random_bytes(kBitmapBytes, 1, right.data());
+  // Leave room for the largest offset
+  const int64_t length = (kBitmapBytes - 8) * 8;
+
+  while (state.KeepRunning()) {
+    op(left.data(), left_offset, right.data(), right_offset, length, 0, out.data());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(state.iterations() * length / 8);
+}
+
+// Bit by bit loop, the baseline for the word-wise kernels
+static void BM_BitmapAndNaive(benchmark::State& state) {  // NOLINT non-const reference
+  std::vector<uint8_t> left(kBitmapBytes), right(kBitmapBytes), out(kBitmapBytes);
+  test::random_bytes(kBitmapBytes, 0, left.data());
+  test::random_bytes(kBitmapBytes, 1, right.data());
+  const int64_t length = (kBitmapBytes - 8) * 8;
+
+  while (state.KeepRunning()) {
+    for (int64_t i = 0; i < length; ++i) {
+      BitUtil::SetBitTo(out.data(), i,
+          BitUtil::GetBit(left.data(), i + 3) && BitUtil::GetBit(right.data(), i + 5));
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(state.iterations() * length / 8);
+}
+
+static void BM_BitmapAndAligned(benchmark::State& state) {  // NOLINT non-const reference
+  BenchmarkBitmapOp(state, BitmapAnd, 0, 0);
+}
+
+static void BM_BitmapAndMisaligned(
+    benchmark::State& state) {  // NOLINT non-const reference
+  BenchmarkBitmapOp(state, BitmapAnd, 3, 5);
+}
+
+static void BM_BitmapOrMisaligned(
+    benchmark::State& state) {  // NOLINT non-const reference
+  BenchmarkBitmapOp(state, BitmapOr, 3, 5);
+}
+
+static void BM_BitmapXorMisaligned(
+    benchmark::State& state) {  // NOLINT non-const reference
+  BenchmarkBitmapOp(state, BitmapXor, 3, 5);
+}
+
+static void BM_BitmapAndNotMisaligned(
+    benchmark::State& state) {  // NOLINT non-const reference
+  BenchmarkBitmapOp(state, BitmapAndNot, 3, 5);
+}
+
+static void BM_CountSetBits(benchmark::State& state) {  // NOLINT non-const reference
+  std::vector<uint8_t> bitmap(kBitmapBytes);
+  test::random_bytes(kBitmapBytes, 0, bitmap.data());
+  const int64_t length = kBitmapBytes * 8;
+
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(CountSetBits(bitmap.data(), 0, length));
+  }
+  state.SetBytesProcessed(state.iterations() * kBitmapBytes);
+}
+
+// A bitmap of kBitmapBytes bytes with the given percentage of bits set
+static std::vector<uint8_t> BitmapWithDensity(int percent) {
+  std::mt19937 gen(0);
+  std::bernoulli_distribution dist(percent / 100.0);
+  std::vector<uint8_t> bitmap(kBitmapBytes, 0);
+  for (int64_t i = 0; i < kBitmapBytes * 8; ++i) {
+    BitUtil::SetBitTo(bitmap.data(), i, dist(gen));
+  }
+  return bitmap;
+}
+
+// Bit by bit loop, the baseline for the selection vector kernels
+static void BM_BitmapToIndicesNaive(
+    benchmark::State& state) {  // NOLINT non-const reference
+  const std::vector<uint8_t> bitmap = BitmapWithDensity(static_cast<int>(state.range(0)));
+  const int64_t length = kBitmapBytes * 8;
+  std::vector<int32_t> indices(length);
+
+  while (state.KeepRunning()) {
+    int32_t* out = indices.data();
+    for (int64_t i = 0; i < length; ++i) {
+      if (BitUtil::GetBit(bitmap.data(), i)) { *out++ = static_cast<int32_t>(i); }
+    }
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetBytesProcessed(state.iterations() * kBitmapBytes);
+}
+
+template <typename IndexType>
+static void BenchmarkBitmapToIndices(benchmark::State& state,  // NOLINT non-const ref
+    DispatchLevel level) {
+  if (!IsDispatchLevelSupported(level)) {
+    state.SkipWithError("CPU does not support the dispatch level");
+    return;
+  }
+  const std::vector<uint8_t> bitmap = BitmapWithDensity(static_cast<int>(state.range(0)));
+  const int64_t length = kBitmapBytes * 8;
+  std::vector<IndexType> indices(CountSetBits(bitmap.data(), 0, length));
+
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(
+        internal::BitmapToIndices(level, bitmap.data(), 0, length, indices.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * kBitmapBytes);
+}
+
+static void BM_BitmapToIndicesScalar(
+    benchmark::State& state) {  // NOLINT non-const reference
+  BenchmarkBitmapToIndices<int32_t>(state, DispatchLevel::NONE);
+}
+
+static void BM_BitmapToIndicesAvx2(
+    benchmark::State& state) {  // NOLINT non-const reference
+  BenchmarkBitmapToIndices<int32_t>(state, DispatchLevel::AVX2);
+}
+
+static void BM_BitmapToIndicesAvx512(
+    benchmark::State& state) {  // NOLINT non-const reference
+  BenchmarkBitmapToIndices<int32_t>(state, DispatchLevel::AVX512);
+}
+
+static void BM_BitmapToIndices64(benchmark::State& state) {  // NOLINT non-const reference
+  BenchmarkBitmapToIndices<int64_t>(state, MaxDispatchLevel());
+}
+
+static void BM_IndicesToBitmap(benchmark::State& state) {  // NOLINT non-const reference
+  const std::vector<uint8_t> bitmap = BitmapWithDensity(static_cast<int>(state.range(0)));
+  const int64_t length = kBitmapBytes * 8;
+  std::vector<int32_t> indices(CountSetBits(bitmap.data(), 0, length));
+  BitmapToIndices(bitmap.data(), 0, length, indices.data());
+  std::vector<uint8_t> out(kBitmapBytes);
+
+  while (state.KeepRunning()) {
+    std::fill(out.begin(), out.end(), 0);
+    IndicesToBitmap(
+        indices.data(), static_cast<int64_t>(indices.size()), 0, out.data());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(state.iterations() * kBitmapBytes);
+}
+
+static void BM_CountBitRuns(benchmark::State& state) {  // NOLINT non-const reference
+  const std::vector<uint8_t> bitmap = BitmapWithDensity(static_cast<int>(state.range(0)));
+  int64_t set_runs, unset_runs;
+
+  while (state.KeepRunning()) {
+    CountBitRuns(bitmap.data(), 0, kBitmapBytes * 8, &set_runs, &unset_runs);
+    benchmark::DoNotOptimize(set_runs + unset_runs);
+  }
+  state.SetBytesProcessed(state.iterations() * kBitmapBytes);
+}
+
+// Percentage of set bits
+static void DensityArguments(benchmark::internal::Benchmark* bench) {
+  for (int percent : {1, 10, 25, 50, 90, 99}) {
+    bench->Arg(percent);
+  }
+}
+
+BENCHMARK(BM_BitmapAndNaive);
+BENCHMARK(BM_BitmapAndAligned);
+BENCHMARK(BM_BitmapAndMisaligned);
+BENCHMARK(BM_BitmapOrMisaligned);
+BENCHMARK(BM_BitmapXorMisaligned);
+BENCHMARK(BM_BitmapAndNotMisaligned);
+BENCHMARK(BM_CountSetBits);
+BENCHMARK(BM_BitmapToIndicesNaive)->Apply(DensityArguments);
+BENCHMARK(BM_BitmapToIndicesScalar)->Apply(DensityArguments);
+BENCHMARK(BM_BitmapToIndicesAvx2)->Apply(DensityArguments);
+BENCHMARK(BM_BitmapToIndicesAvx512)->Apply(DensityArguments);
+BENCHMARK(BM_BitmapToIndices64)->Apply(DensityArguments);
+BENCHMARK(BM_IndicesToBitmap)->Apply(DensityArguments);
+BENCHMARK(BM_CountBitRuns)->Apply(DensityArguments);
+
+}  // namespace arrow
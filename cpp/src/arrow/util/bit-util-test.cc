@@ -15,11 +15,13 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
 #include <limits>
+#include <random>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -30,7 +32,9 @@
 #include "arrow/test-util.h"
 #include "arrow/util/bit-stream-utils.h"
 #include "arrow/util/bit-util.h"
+#include "arrow/util/bpacking.h"
 #include "arrow/util/cpu-info.h"
+#include "arrow/util/dispatch.h"
 
 namespace arrow {
 
@@ -120,6 +124,171 @@ TEST(BitUtilTests, TestCopyBitmap) {
   }
 }
 
+typedef void (*BitmapOpFunc)(const uint8_t*, int64_t, const uint8_t*, int64_t, int64_t,
+    int64_t, uint8_t*);
+
+static void CheckBitmapOp(BitmapOpFunc op, bool (*expected_op)(bool, bool)) {
+  const int kBufferSize = 64;
+  std::vector<uint8_t> left(kBufferSize), right(kBufferSize), out(kBufferSize + 8);
+  test::random_bytes(kBufferSize, 0, left.data());
+  test::random_bytes(kBufferSize, 1, right.data());
+
+  const std::vector<int64_t> offsets = {0, 1, 5, 8, 13, 64, 67};
+  const std::vector<int64_t> lengths = {0, 1, 7, 8, 63, 64, 65, 130, 300};
+  for (int64_t left_offset : offsets) {
+    for (int64_t right_offset : offsets) {
+      for (int64_t out_offset : offsets) {
+        for (int64_t length : lengths) {
+          std::vector<uint8_t> original(out.size());
+          test::random_bytes(out.size(), static_cast<uint32_t>(length), original.data());
+          out = original;
+          op(left.data(), left_offset, right.data(), right_offset, length, out_offset,
+              out.data());
+          for (int64_t i = 0; i < static_cast<int64_t>(out.size()) * 8; ++i) {
+            bool expected;
+            if (i < out_offset || i >= out_offset + length) {
+              // Bits outside of the output range are left alone
+              expected = BitUtil::GetBit(original.data(), i);
+            } else {
+              const int64_t j = i - out_offset;
+              expected = expected_op(BitUtil::GetBit(left.data(), left_offset + j),
+                  BitUtil::GetBit(right.data(), right_offset + j));
+            }
+            ASSERT_EQ(expected, BitUtil::GetBit(out.data(), i))
+                << "left_offset=" << left_offset << " right_offset=" << right_offset
+                << " out_offset=" << out_offset << " length=" << length << " i=" << i;
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(BitUtilTests, TestBitmapAnd) {
+  CheckBitmapOp(BitmapAnd, [](bool l, bool r) { return l && r; });
+}
+
+TEST(BitUtilTests, TestBitmapOr) {
+  CheckBitmapOp(BitmapOr, [](bool l, bool r) { return l || r; });
+}
+
+TEST(BitUtilTests, TestBitmapXor) {
+  CheckBitmapOp(BitmapXor, [](bool l, bool r) { return l != r; });
+}
+
+TEST(BitUtilTests, TestBitmapAndNot) {
+  CheckBitmapOp(BitmapAndNot, [](bool l, bool r) { return l && !r; });
+}
+
+TEST(BitUtilTests, TestBitmapOpAllocate) {
+  const uint8_t left[] = {0xF0, 0x0F};
+  const uint8_t right[] = {0xFF, 0x00};
+  std::shared_ptr<Buffer> out;
+  ASSERT_OK(BitmapXor(default_memory_pool(), left, 4, right, 0, 8, 3, &out));
+  // left bits [4, 12) are all set, right bits [0, 8) are all set
+  ASSERT_EQ(2, out->size());
+  ASSERT_EQ(0, out->data()[0]);
+  ASSERT_EQ(0, out->data()[1] & 0x07);
+}
+
+// A bitmap of num_bytes bytes whose bits are set with the given probability
+static std::vector<uint8_t> RandomBitmap(int64_t num_bytes, double density, int seed) {
+  std::mt19937 gen(seed);
+  std::bernoulli_distribution dist(density);
+  std::vector<uint8_t> bitmap(num_bytes, 0);
+  for (int64_t i = 0; i < num_bytes * 8; ++i) {
+    BitUtil::SetBitTo(bitmap.data(), i, dist(gen));
+  }
+  return bitmap;
+}
+
+template <typename IndexType>
+static void CheckBitmapToIndices(DispatchLevel level) {
+  for (double density : {0.0, 0.01, 0.3, 0.9, 1.0}) {
+    const std::vector<uint8_t> bitmap = RandomBitmap(300, density, 0);
+    for (int64_t offset : {0, 3, 64, 71}) {
+      for (int64_t length : {0, 1, 63, 64, 65, 500, 2000}) {
+        std::vector<IndexType> expected;
+        for (int64_t i = 0; i < length; ++i) {
+          if (BitUtil::GetBit(bitmap.data(), offset + i)) {
+            expected.push_back(static_cast<IndexType>(i));
+          }
+        }
+        // Exactly the promised room, so that writing past it would be caught by
+        // sanitizers
+        std::vector<IndexType> indices(CountSetBits(bitmap.data(), offset, length));
+        const int64_t num_indices = internal::BitmapToIndices(
+            level, bitmap.data(), offset, length, indices.data());
+        ASSERT_EQ(static_cast<int64_t>(expected.size()), num_indices);
+        ASSERT_EQ(expected, indices) << "density=" << density << " offset=" << offset
+                                     << " length=" << length;
+      }
+    }
+  }
+}
+
+TEST(BitUtilTests, TestBitmapToIndices) {
+  EnsureCpuInfoInitialized();
+  for (DispatchLevel level :
+      {DispatchLevel::NONE, DispatchLevel::AVX2, DispatchLevel::AVX512}) {
+    if (!IsDispatchLevelSupported(level)) { continue; }
+    CheckBitmapToIndices<int32_t>(level);
+    CheckBitmapToIndices<int64_t>(level);
+  }
+
+  const uint8_t bitmap[] = {0x81, 0x00, 0x02};
+  std::vector<int64_t> indices(3);
+  ASSERT_EQ(3, BitmapToIndices(bitmap, 0, 24, indices.data()));
+  ASSERT_EQ(std::vector<int64_t>({0, 7, 17}), indices);
+}
+
+TEST(BitUtilTests, TestIndicesToBitmap) {
+  const std::vector<uint8_t> bitmap = RandomBitmap(100, 0.3, 1);
+  const int64_t length = 800;
+  std::vector<int32_t> indices(CountSetBits(bitmap.data(), 0, length));
+  BitmapToIndices(bitmap.data(), 0, length, indices.data());
+
+  std::shared_ptr<Buffer> out;
+  ASSERT_OK(IndicesToBitmap(default_memory_pool(), indices.data(),
+      static_cast<int64_t>(indices.size()), length, &out));
+  ASSERT_EQ(BitUtil::BytesForBits(length), out->size());
+  ASSERT_TRUE(BitmapEquals(bitmap.data(), 0, out->data(), 0, length));
+
+  // Unsorted and repeated indices, at an offset, the other bits kept
+  std::vector<int64_t> shuffled(indices.begin(), indices.end());
+  std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(2));
+  shuffled.push_back(shuffled[0]);
+  std::vector<uint8_t> shifted(102, 0);
+  shifted[0] = 0x07;
+  IndicesToBitmap(
+      shuffled.data(), static_cast<int64_t>(shuffled.size()), 3, shifted.data());
+  ASSERT_EQ(0x07, shifted[0] & 0x07);
+  ASSERT_TRUE(BitmapEquals(bitmap.data(), 0, shifted.data(), 3, length));
+  ASSERT_EQ(0, CountSetBits(shifted.data(), length + 3, 8 * 102 - length - 3));
+}
+
+TEST(BitUtilTests, TestCountBitRuns) {
+  for (double density : {0.0, 0.05, 0.5, 0.95, 1.0}) {
+    const std::vector<uint8_t> bitmap = RandomBitmap(1100, density, 3);
+    for (int64_t offset : {0, 5, 64, 100}) {
+      for (int64_t length : {0, 1, 2, 63, 64, 65, 1000, 8600}) {
+        int64_t expected_set = 0, expected_unset = 0;
+        for (int64_t i = 0; i < length; ++i) {
+          const bool bit = BitUtil::GetBit(bitmap.data(), offset + i);
+          if (i == 0 || bit != BitUtil::GetBit(bitmap.data(), offset + i - 1)) {
+            ++(bit ? expected_set : expected_unset);
+          }
+        }
+        int64_t set_runs, unset_runs;
+        CountBitRuns(bitmap.data(), offset, length, &set_runs, &unset_runs);
+        ASSERT_EQ(expected_set, set_runs) << "offset=" << offset << " length=" << length;
+        ASSERT_EQ(expected_unset, unset_runs)
+            << "offset=" << offset << " length=" << length;
+      }
+    }
+  }
+}
+
 TEST(BitUtil, Ceil) {
   EXPECT_EQ(BitUtil::Ceil(0, 1), 0);
   EXPECT_EQ(BitUtil::Ceil(1, 1), 1);
@@ -271,4 +440,112 @@ TEST(BitStreamUtil, ZigZag) {
   TestZigZag(-std::numeric_limits<int32_t>::max());
 }
 
+void TestZigZag64(int64_t v) {
+  uint8_t buffer[BitReader::MAX_VLQ_BYTE_LEN_64];
+  BitWriter writer(buffer, sizeof(buffer));
+  BitReader reader(buffer, sizeof(buffer));
+  EXPECT_TRUE(writer.PutZigZagVlqInt64(v));
+  int64_t result;
+  EXPECT_TRUE(reader.GetZigZagVlqInt64(&result));
+  EXPECT_EQ(v, result);
+}
+
+TEST(BitStreamUtil, ZigZag64) {
+  TestZigZag64(0);
+  TestZigZag64(1);
+  TestZigZag64(-1);
+  TestZigZag64(1LL << 40);
+  TestZigZag64(std::numeric_limits<int64_t>::max());
+  TestZigZag64(std::numeric_limits<int64_t>::min());
+
+  // Small magnitudes take a single byte
+  uint8_t buffer[BitReader::MAX_VLQ_BYTE_LEN_64];
+  BitWriter writer(buffer, sizeof(buffer));
+  writer.PutZigZagVlqInt64(-64);
+  writer.Flush();
+  ASSERT_EQ(1, writer.bytes_written());
+  ASSERT_EQ(127, buffer[0]);
+}
+
+// Bit-pack random values of every width and check that the dispatched, scalar
+// and (when supported) SIMD kernels all recover them, for every output width
+template <typename T>
+void CheckUnpack32() {
+  const int kNumValues = 32 * 9;
+  for (int num_bits = 0; num_bits <= static_cast<int>(sizeof(T) * 8); ++num_bits) {
+    std::vector<uint32_t> values(kNumValues);
+    const uint64_t max_value = (static_cast<uint64_t>(1) << num_bits) - 1;
+    test::rand_uniform_int(kNumValues, static_cast<uint32_t>(num_bits), 0U,
+        static_cast<uint32_t>(max_value), values.data());
+
+    std::vector<uint8_t> packed(kNumValues * 4 + 8, 0);
+    BitWriter writer(packed.data(), static_cast<int>(packed.size()));
+    for (uint32_t value : values) {
+      ASSERT_TRUE(writer.PutValue(value, num_bits));
+    }
+    writer.Flush();
+    // Trim the input so that reading past the packed values would be caught
+    // by sanitizers
+    std::vector<uint8_t> input(
+        packed.begin(), packed.begin() + kNumValues * num_bits / 8);
+    input.shrink_to_fit();
+    const uint32_t* in = reinterpret_cast<const uint32_t*>(input.data());
+
+    std::vector<T> expected(values.begin(), values.end());
+    std::vector<T> out(kNumValues + 5);
+    ASSERT_EQ(kNumValues - 32, unpack32(in, out.data(), kNumValues - 5, num_bits));
+    ASSERT_EQ(std::vector<T>(expected.begin(), expected.end() - 32),
+        std::vector<T>(out.begin(), out.begin() + kNumValues - 32));
+
+    std::fill(out.begin(), out.end(), 0);
+    ASSERT_EQ(kNumValues, unpack32_scalar(in, out.data(), kNumValues, num_bits));
+    ASSERT_EQ(expected, std::vector<T>(out.begin(), out.begin() + kNumValues));
+
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+    if (IsDispatchLevelSupported(DispatchLevel::AVX2)) {
+      std::fill(out.begin(), out.end(), 0);
+      ASSERT_EQ(kNumValues, unpack32_avx2(in, out.data(), kNumValues, num_bits));
+      ASSERT_EQ(expected, std::vector<T>(out.begin(), out.begin() + kNumValues))
+          << "num_bits=" << num_bits;
+    }
+#endif
+#ifdef ARROW_HAVE_RUNTIME_AVX512
+    if (IsDispatchLevelSupported(DispatchLevel::AVX512)) {
+      std::fill(out.begin(), out.end(), 0);
+      ASSERT_EQ(kNumValues, unpack32_avx512(in, out.data(), kNumValues, num_bits));
+      ASSERT_EQ(expected, std::vector<T>(out.begin(), out.begin() + kNumValues))
+          << "num_bits=" << num_bits;
+    }
+#endif
+  }
+}
+
+TEST(BitStreamUtil, Unpack32) {
+  EnsureCpuInfoInitialized();
+  CheckUnpack32<uint32_t>();
+  CheckUnpack32<uint16_t>();
+  CheckUnpack32<uint8_t>();
+}
+
+TEST(BitStreamUtil, GetBatchNarrow) {
+  EnsureCpuInfoInitialized();
+  const int kNumValues = 100;
+  uint8_t buffer[kNumValues * 2];
+  BitWriter writer(buffer, sizeof(buffer));
+  for (int i = 0; i < kNumValues; ++i) {
+    ASSERT_TRUE(writer.PutValue(i % 53, 6));
+  }
+  writer.Flush();
+
+  BitReader reader(buffer, sizeof(buffer));
+  // A misaligned first value takes the unbuffered path
+  uint8_t first;
+  ASSERT_TRUE(reader.GetValue(6, &first));
+  std::vector<int16_t> values(kNumValues - 1);
+  ASSERT_EQ(kNumValues - 1, reader.GetBatch(6, values.data(), kNumValues - 1));
+  for (int i = 1; i < kNumValues; ++i) {
+    ASSERT_EQ(i % 53, values[i - 1]);
+  }
+}
+
 }  // namespace arrow
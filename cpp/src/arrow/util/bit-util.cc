@@ -27,6 +27,12 @@
 #include <cstring>
 #include <vector>
 
+#include "arrow/util/dispatch.h"
+
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+#include <immintrin.h>
+#endif
+
 #include "arrow/buffer.h"
 #include "arrow/memory_pool.h"
 #include "arrow/status.h"
@@ -54,6 +60,69 @@ Status BitUtil::BytesToBits(
   return Status::OK();
 }
 
+namespace {
+
+typedef int64_t (*PopcountWordsFunc)(const uint64_t*, int64_t);
+
+// Without a popcnt target this compiles to a table-based software popcount
+int64_t PopcountWords(const uint64_t* words, int64_t num_words) {
+  int64_t count = 0;
+  for (int64_t i = 0; i < num_words; ++i) {
+    count += __builtin_popcountll(words[i]);
+  }
+  return count;
+}
+
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+ARROW_TARGET_POPCNT int64_t PopcountWordsPopcnt(
+    const uint64_t* words, int64_t num_words) {
+  int64_t count = 0;
+  for (int64_t i = 0; i < num_words; ++i) {
+    count += __builtin_popcountll(words[i]);
+  }
+  return count;
+}
+
+// Count the bits of each nibble with a shuffle lookup, then sum the bytes of
+// every 64-bit lane with a sum of absolute differences
+ARROW_TARGET_AVX2 int64_t PopcountWordsAvx2(const uint64_t* words, int64_t num_words) {
+  const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3,
+      4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+  const __m256i low_mask = _mm256_set1_epi8(0x0f);
+  __m256i totals = _mm256_setzero_si256();
+  int64_t i = 0;
+  for (; i + 4 <= num_words; i += 4) {
+    const __m256i vector =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i));
+    const __m256i low = _mm256_and_si256(vector, low_mask);
+    const __m256i high = _mm256_and_si256(_mm256_srli_epi16(vector, 4), low_mask);
+    const __m256i counts = _mm256_add_epi8(
+        _mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+    totals = _mm256_add_epi64(totals, _mm256_sad_epu8(counts, _mm256_setzero_si256()));
+  }
+  int64_t count = _mm256_extract_epi64(totals, 0) + _mm256_extract_epi64(totals, 1) +
+                  _mm256_extract_epi64(totals, 2) + _mm256_extract_epi64(totals, 3);
+  for (; i < num_words; ++i) {
+    count += __builtin_popcountll(words[i]);
+  }
+  return count;
+}
+#endif
+
+// popcount as much as possible with the widest possible count
+PopcountWordsFunc GetPopcountWords() {
+  static DynamicDispatch<PopcountWordsFunc> dispatch({
+      {DispatchLevel::NONE, PopcountWords},
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+      {DispatchLevel::SSE4_2, PopcountWordsPopcnt},
+      {DispatchLevel::AVX2, PopcountWordsAvx2},
+#endif
+  });
+  return dispatch.func;
+}
+
+}  // namespace
+
 int64_t CountSetBits(const uint8_t* data, int64_t bit_offset, int64_t length) {
   constexpr int64_t pop_len = sizeof(uint64_t) * 8;
 
@@ -76,10 +145,7 @@ int64_t CountSetBits(const uint8_t* data, int64_t bit_offset, int64_t length) {
 
   const uint64_t* end = u64_data + fast_counts;
 
-  // popcount as much as possible with the widest possible count
-  for (auto iter = u64_data; iter < end; ++iter) {
-    count += __builtin_popcountll(*iter);
-  }
+  count += GetPopcountWords()(u64_data, end - u64_data);
 
   // Account for left over bit (in theory we could fall back to smaller
   // versions of popcount but the code complexity is likely not worth it)
@@ -136,4 +202,541 @@ bool BitmapEquals(const uint8_t* left, int64_t left_offset, const uint8_t* right
   return true;
 }
 
+// ----------------------------------------------------------------------
+// Bitmap operations
+
+namespace {
+
+struct AndOp {
+  uint64_t operator()(uint64_t left, uint64_t right) const { return left & right; }
+};
+
+struct OrOp {
+  uint64_t operator()(uint64_t left, uint64_t right) const { return left | right; }
+};
+
+struct XorOp {
+  uint64_t operator()(uint64_t left, uint64_t right) const { return left ^ right; }
+};
+
+struct AndNotOp {
+  uint64_t operator()(uint64_t left, uint64_t right) const { return left & ~right; }
+};
+
+// Bitmaps are little-endian regardless of the platform
+inline uint64_t LittleEndianWord(uint64_t word) {
+#if __BYTE_ORDER == __LITTLE_ENDIAN
+  return word;
+#else
+  return ARROW_BYTE_SWAP64(word);
+#endif
+}
+
+// Read the 64 bits of a bitmap starting at an arbitrary bit offset. When the
+// offset is not byte aligned, the word is funnel-shifted together with the
+// byte that follows it
+inline uint64_t LoadBits(const uint8_t* bitmap, int64_t bit_offset) {
+  const uint8_t* bytes = bitmap + bit_offset / 8;
+  const int shift = static_cast<int>(bit_offset % 8);
+  uint64_t word;
+  memcpy(&word, bytes, sizeof(word));
+  word = LittleEndianWord(word);
+  if (shift == 0) { return word; }
+  return (word >> shift) | (static_cast<uint64_t>(bytes[8]) << (64 - shift));
+}
+
+// The compiler vectorizes this loop for the build target
+template <typename Op>
+void BytewiseOp(
+    const uint8_t* left, const uint8_t* right, int64_t num_bytes, uint8_t* out) {
+  Op op;
+  for (int64_t j = 0; j < num_bytes; ++j) {
+    out[j] = static_cast<uint8_t>(op(left[j], right[j]));
+  }
+}
+
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+template <typename Op>
+__m256i VectorOp(__m256i left, __m256i right);
+
+template <>
+ARROW_TARGET_AVX2 inline __m256i VectorOp<AndOp>(__m256i left, __m256i right) {
+  return _mm256_and_si256(left, right);
+}
+
+template <>
+ARROW_TARGET_AVX2 inline __m256i VectorOp<OrOp>(__m256i left, __m256i right) {
+  return _mm256_or_si256(left, right);
+}
+
+template <>
+ARROW_TARGET_AVX2 inline __m256i VectorOp<XorOp>(__m256i left, __m256i right) {
+  return _mm256_xor_si256(left, right);
+}
+
+template <>
+ARROW_TARGET_AVX2 inline __m256i VectorOp<AndNotOp>(__m256i left, __m256i right) {
+  return _mm256_andnot_si256(right, left);
+}
+
+template <typename Op>
+ARROW_TARGET_AVX2 void BytewiseOpAvx2(
+    const uint8_t* left, const uint8_t* right, int64_t num_bytes, uint8_t* out) {
+  Op op;
+  int64_t j = 0;
+  for (; j + 32 <= num_bytes; j += 32) {
+    const __m256i left_vector =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left + j));
+    const __m256i right_vector =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right + j));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(out + j), VectorOp<Op>(left_vector, right_vector));
+  }
+  for (; j < num_bytes; ++j) {
+    out[j] = static_cast<uint8_t>(op(left[j], right[j]));
+  }
+}
+#endif
+
+template <typename Op>
+void BitmapOp(const uint8_t* left, int64_t left_offset, const uint8_t* right,
+    int64_t right_offset, int64_t length, int64_t out_offset, uint8_t* out) {
+  Op op;
+  auto OpBit = [&](int64_t i) {
+    return (op(BitUtil::GetBit(left, left_offset + i),
+                BitUtil::GetBit(right, right_offset + i)) &
+               1) != 0;
+  };
+  int64_t i = 0;
+
+  // Bit by bit until the output is byte aligned
+  for (; i < length && (out_offset + i) % 8 != 0; ++i) {
+    BitUtil::SetBitTo(out, out_offset + i, OpBit(i));
+  }
+
+  uint8_t* out_bytes = out + (out_offset + i) / 8;
+  if ((left_offset + i) % 8 == 0 && (right_offset + i) % 8 == 0) {
+    // All three bitmaps are byte aligned, combine them bytewise
+    typedef void (*BytewiseFunc)(const uint8_t*, const uint8_t*, int64_t, uint8_t*);
+    static DynamicDispatch<BytewiseFunc> dispatch({
+        {DispatchLevel::NONE, BytewiseOp<Op>},
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+        {DispatchLevel::AVX2, BytewiseOpAvx2<Op>},
+#endif
+    });
+    const int64_t num_bytes = (length - i) / 8;
+    dispatch.func(left + (left_offset + i) / 8, right + (right_offset + i) / 8,
+        num_bytes, out_bytes);
+    i += num_bytes * 8;
+  } else {
+    // Shift the misaligned inputs into place a word at a time
+    const int64_t num_words = (length - i) / 64;
+    for (int64_t j = 0; j < num_words; ++j) {
+      const uint64_t word =
+          op(LoadBits(left, left_offset + i), LoadBits(right, right_offset + i));
+      const uint64_t out_word = LittleEndianWord(word);
+      memcpy(out_bytes + j * 8, &out_word, sizeof(out_word));
+      i += 64;
+    }
+  }
+
+  // Trailing bits
+  for (; i < length; ++i) {
+    BitUtil::SetBitTo(out, out_offset + i, OpBit(i));
+  }
+}
+
+template <typename Op>
+Status AllocateBitmapOp(MemoryPool* pool, const uint8_t* left, int64_t left_offset,
+    const uint8_t* right, int64_t right_offset, int64_t length, int64_t out_offset,
+    std::shared_ptr<Buffer>* out) {
+  std::shared_ptr<MutableBuffer> buffer;
+  RETURN_NOT_OK(GetEmptyBitmap(pool, out_offset + length, &buffer));
+  BitmapOp<Op>(left, left_offset, right, right_offset, length, out_offset,
+      buffer->mutable_data());
+  *out = buffer;
+  return Status::OK();
+}
+
+}  // namespace
+
+void BitmapAnd(const uint8_t* left, int64_t left_offset, const uint8_t* right,
+    int64_t right_offset, int64_t length, int64_t out_offset, uint8_t* out) {
+  BitmapOp<AndOp>(left, left_offset, right, right_offset, length, out_offset, out);
+}
+
+void BitmapOr(const uint8_t* left, int64_t left_offset, const uint8_t* right,
+    int64_t right_offset, int64_t length, int64_t out_offset, uint8_t* out) {
+  BitmapOp<OrOp>(left, left_offset, right, right_offset, length, out_offset, out);
+}
+
+void BitmapXor(const uint8_t* left, int64_t left_offset, const uint8_t* right,
+    int64_t right_offset, int64_t length, int64_t out_offset, uint8_t* out) {
+  BitmapOp<XorOp>(left, left_offset, right, right_offset, length, out_offset, out);
+}
+
+void BitmapAndNot(const uint8_t* left, int64_t left_offset, const uint8_t* right,
+    int64_t right_offset, int64_t length, int64_t out_offset, uint8_t* out) {
+  BitmapOp<AndNotOp>(left, left_offset, right, right_offset, length, out_offset, out);
+}
+
+Status BitmapAnd(MemoryPool* pool, const uint8_t* left, int64_t left_offset,
+    const uint8_t* right, int64_t right_offset, int64_t length, int64_t out_offset,
+    std::shared_ptr<Buffer>* out) {
+  return AllocateBitmapOp<AndOp>(
+      pool, left, left_offset, right, right_offset, length, out_offset, out);
+}
+
+Status BitmapOr(MemoryPool* pool, const uint8_t* left, int64_t left_offset,
+    const uint8_t* right, int64_t right_offset, int64_t length, int64_t out_offset,
+    std::shared_ptr<Buffer>* out) {
+  return AllocateBitmapOp<OrOp>(
+      pool, left, left_offset, right, right_offset, length, out_offset, out);
+}
+
+Status BitmapXor(MemoryPool* pool, const uint8_t* left, int64_t left_offset,
+    const uint8_t* right, int64_t right_offset, int64_t length, int64_t out_offset,
+    std::shared_ptr<Buffer>* out) {
+  return AllocateBitmapOp<XorOp>(
+      pool, left, left_offset, right, right_offset, length, out_offset, out);
+}
+
+Status BitmapAndNot(MemoryPool* pool, const uint8_t* left, int64_t left_offset,
+    const uint8_t* right, int64_t right_offset, int64_t length, int64_t out_offset,
+    std::shared_ptr<Buffer>* out) {
+  return AllocateBitmapOp<AndNotOp>(
+      pool, left, left_offset, right, right_offset, length, out_offset, out);
+}
+
+// ----------------------------------------------------------------------
+// Selection vectors
+
+namespace {
+
+template <typename IndexType>
+using BitmapToIndicesFunc = int64_t (*)(
+    const uint8_t*, int64_t, int64_t, int64_t, IndexType*);
+
+// Reads the bits of a bitmap range a word at a time: the word at position i
+// holds the bits [offset + i, offset + i + num_bits), the unused high bits of
+// the last word zeroed
+class RangeWords {
+ public:
+  RangeWords(const uint8_t* bitmap, int64_t offset, int64_t length)
+      : bytes_(bitmap + offset / 8), shift_(static_cast<int>(offset % 8)),
+        length_(length) {}
+
+  uint64_t Word(int64_t i, int* num_bits) const {
+    const uint8_t* bytes = bytes_ + i / 8;
+    if (LIKELY(i + 64 < length_)) {
+      // The byte after the word is within the range
+      *num_bits = 64;
+      uint64_t word;
+      memcpy(&word, bytes, sizeof(word));
+      word = LittleEndianWord(word);
+      if (shift_ == 0) { return word; }
+      return (word >> shift_) | (static_cast<uint64_t>(bytes[8]) << (64 - shift_));
+    }
+    *num_bits = static_cast<int>(length_ - i);
+    return BitUtil::LoadBitmapWord(bytes, shift_, *num_bits);
+  }
+
+ private:
+  const uint8_t* bytes_;
+  int shift_;
+  int64_t length_;
+};
+
+// One trailing zero count per set bit
+template <typename IndexType>
+inline IndexType* WordToIndices(uint64_t word, int64_t base, IndexType* out) {
+  while (word != 0) {
+    *out++ = static_cast<IndexType>(base + BitUtil::CountTrailingZeros(word));
+    word &= word - 1;
+  }
+  return out;
+}
+
+template <typename IndexType>
+int64_t BitmapToIndicesScalar(const uint8_t* bitmap, int64_t offset, int64_t length,
+    int64_t /*num_set*/, IndexType* indices) {
+  const RangeWords words(bitmap, offset, length);
+  IndexType* out = indices;
+  int num_bits;
+  for (int64_t i = 0; i < length; i += 64) {
+    out = WordToIndices(words.Word(i, &num_bits), i, out);
+  }
+  return out - indices;
+}
+
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+// The positions of the set bits of every byte value, one per byte from the low
+// byte up
+struct BytePositions {
+  BytePositions() {
+    for (int byte = 0; byte < 256; ++byte) {
+      uint64_t packed = 0;
+      int count = 0;
+      for (int bit = 0; bit < 8; ++bit) {
+        if (byte & (1 << bit)) { packed |= static_cast<uint64_t>(bit) << (8 * count++); }
+      }
+      positions[byte] = packed;
+    }
+  }
+
+  uint64_t positions[256];
+};
+
+const uint64_t* GetBytePositions() {
+  static BytePositions table;
+  return table.positions;
+}
+
+// Write eight indices, base plus each packed position. Only the first
+// popcount(byte) of them are meaningful, the others are overwritten next
+ARROW_TARGET_AVX2 inline void StoreBytePositions(
+    uint64_t positions, int64_t base, int32_t* out) {
+  const __m256i indices = _mm256_add_epi32(
+      _mm256_cvtepu8_epi32(_mm_cvtsi64_si128(static_cast<int64_t>(positions))),
+      _mm256_set1_epi32(static_cast<int32_t>(base)));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), indices);
+}
+
+ARROW_TARGET_AVX2 inline void StoreBytePositions(
+    uint64_t positions, int64_t base, int64_t* out) {
+  const __m128i bytes = _mm_cvtsi64_si128(static_cast<int64_t>(positions));
+  const __m256i base_vector = _mm256_set1_epi64x(base);
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+      _mm256_add_epi64(_mm256_cvtepu8_epi64(bytes), base_vector));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 4),
+      _mm256_add_epi64(_mm256_cvtepu8_epi64(_mm_srli_si128(bytes, 4)), base_vector));
+}
+
+// Words with fewer set bits are cheaper to walk with trailing zero counts
+constexpr int kMinDenseWordBits = 12;
+
+// Dense words are expanded a byte at a time through a table of bit positions,
+// with full-width stores as long as they cannot write past indices + num_set
+template <typename IndexType>
+ARROW_TARGET_AVX2 int64_t BitmapToIndicesAvx2(const uint8_t* bitmap, int64_t offset,
+    int64_t length, int64_t num_set, IndexType* indices) {
+  const uint64_t* byte_positions = GetBytePositions();
+  const RangeWords words(bitmap, offset, length);
+  IndexType* out = indices;
+  IndexType* const end = indices + num_set;
+  int num_bits;
+  for (int64_t i = 0; i < length; i += 64) {
+    const uint64_t word = words.Word(i, &num_bits);
+    const int count = __builtin_popcountll(word);
+    if (count < kMinDenseWordBits || end - out < count + 8) {
+      out = WordToIndices(word, i, out);
+      continue;
+    }
+    for (int j = 0; j < 64; j += 8) {
+      const uint8_t byte = static_cast<uint8_t>(word >> j);
+      StoreBytePositions(byte_positions[byte], i + j, out);
+      out += __builtin_popcount(byte);
+    }
+  }
+  return out - indices;
+}
+#endif
+
+#ifdef ARROW_HAVE_RUNTIME_AVX512
+constexpr int kMinCompressWordBits = 4;
+
+// Dense words compress a vector of consecutive indices by the word, 16 or 8
+// bits at a time, with full-width stores as long as they cannot write past
+// indices + num_set
+ARROW_TARGET_AVX512 int64_t BitmapToIndicesAvx512(const uint8_t* bitmap,
+    int64_t offset, int64_t length, int64_t num_set, int32_t* indices) {
+  const __m512i lanes =
+      _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  const RangeWords words(bitmap, offset, length);
+  int32_t* out = indices;
+  int32_t* const end = indices + num_set;
+  int num_bits;
+  for (int64_t i = 0; i < length; i += 64) {
+    const uint64_t word = words.Word(i, &num_bits);
+    const int count = __builtin_popcountll(word);
+    if (count < kMinCompressWordBits || end - out < count + 16) {
+      out = WordToIndices(word, i, out);
+      continue;
+    }
+    for (int j = 0; j < 64; j += 16) {
+      const __mmask16 mask = static_cast<__mmask16>(word >> j);
+      const __m512i values =
+          _mm512_add_epi32(lanes, _mm512_set1_epi32(static_cast<int32_t>(i + j)));
+      _mm512_storeu_si512(out, _mm512_maskz_compress_epi32(mask, values));
+      out += __builtin_popcount(mask);
+    }
+  }
+  return out - indices;
+}
+
+ARROW_TARGET_AVX512 int64_t BitmapToIndicesAvx512(const uint8_t* bitmap,
+    int64_t offset, int64_t length, int64_t num_set, int64_t* indices) {
+  const __m512i lanes = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+  const RangeWords words(bitmap, offset, length);
+  int64_t* out = indices;
+  int64_t* const end = indices + num_set;
+  int num_bits;
+  for (int64_t i = 0; i < length; i += 64) {
+    const uint64_t word = words.Word(i, &num_bits);
+    const int count = __builtin_popcountll(word);
+    if (count < kMinCompressWordBits || end - out < count + 8) {
+      out = WordToIndices(word, i, out);
+      continue;
+    }
+    for (int j = 0; j < 64; j += 8) {
+      const __mmask8 mask = static_cast<__mmask8>(word >> j);
+      const __m512i values = _mm512_add_epi64(lanes, _mm512_set1_epi64(i + j));
+      _mm512_storeu_si512(out, _mm512_maskz_compress_epi64(mask, values));
+      out += __builtin_popcount(mask);
+    }
+  }
+  return out - indices;
+}
+#endif
+
+template <typename IndexType>
+DynamicDispatch<BitmapToIndicesFunc<IndexType>> BitmapToIndicesDispatch(
+    DispatchLevel max_level) {
+  return DynamicDispatch<BitmapToIndicesFunc<IndexType>>({
+      {DispatchLevel::NONE, BitmapToIndicesScalar<IndexType>},
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+      {DispatchLevel::AVX2, BitmapToIndicesAvx2<IndexType>},
+#endif
+#ifdef ARROW_HAVE_RUNTIME_AVX512
+      {DispatchLevel::AVX512, BitmapToIndicesAvx512},
+#endif
+  }, max_level);
+}
+
+// The vectorized versions need the number of set bits up front to know how
+// far full-width stores may go
+template <typename IndexType>
+int64_t DispatchBitmapToIndices(
+    const DynamicDispatch<BitmapToIndicesFunc<IndexType>>& dispatch,
+    const uint8_t* bitmap, int64_t offset, int64_t length, IndexType* indices) {
+  const int64_t num_set =
+      dispatch.level == DispatchLevel::NONE ? 0 : CountSetBits(bitmap, offset, length);
+  return dispatch.func(bitmap, offset, length, num_set, indices);
+}
+
+// Set bits are gathered into a word for as long as consecutive indices fall
+// into the same 64 bits, so sorted indices cost one read-modify-write per word
+template <typename IndexType>
+void IndicesToBitmapImpl(
+    const IndexType* indices, int64_t num_indices, int64_t offset, uint8_t* bitmap) {
+  int64_t word_index = -1;
+  uint64_t word = 0;
+  auto flush = [&]() {
+    for (int64_t byte = word_index * 8; word != 0; word >>= 8) {
+      bitmap[byte++] |= static_cast<uint8_t>(word);
+    }
+  };
+  for (int64_t i = 0; i < num_indices; ++i) {
+    const int64_t position = offset + indices[i];
+    if (position / 64 != word_index) {
+      flush();
+      word_index = position / 64;
+    }
+    word |= 1ULL << (position % 64);
+  }
+  flush();
+}
+
+template <typename IndexType>
+Status AllocateIndicesToBitmap(MemoryPool* pool, const IndexType* indices,
+    int64_t num_indices, int64_t length, std::shared_ptr<Buffer>* out) {
+  std::shared_ptr<MutableBuffer> buffer;
+  RETURN_NOT_OK(GetEmptyBitmap(pool, length, &buffer));
+  IndicesToBitmapImpl(indices, num_indices, 0, buffer->mutable_data());
+  *out = buffer;
+  return Status::OK();
+}
+
+}  // namespace
+
+int64_t BitmapToIndices(
+    const uint8_t* bitmap, int64_t offset, int64_t length, int32_t* indices) {
+  static const auto dispatch = BitmapToIndicesDispatch<int32_t>(MaxDispatchLevel());
+  return DispatchBitmapToIndices(dispatch, bitmap, offset, length, indices);
+}
+
+int64_t BitmapToIndices(
+    const uint8_t* bitmap, int64_t offset, int64_t length, int64_t* indices) {
+  static const auto dispatch = BitmapToIndicesDispatch<int64_t>(MaxDispatchLevel());
+  return DispatchBitmapToIndices(dispatch, bitmap, offset, length, indices);
+}
+
+void IndicesToBitmap(
+    const int32_t* indices, int64_t num_indices, int64_t offset, uint8_t* bitmap) {
+  IndicesToBitmapImpl(indices, num_indices, offset, bitmap);
+}
+
+void IndicesToBitmap(
+    const int64_t* indices, int64_t num_indices, int64_t offset, uint8_t* bitmap) {
+  IndicesToBitmapImpl(indices, num_indices, offset, bitmap);
+}
+
+Status IndicesToBitmap(MemoryPool* pool, const int32_t* indices, int64_t num_indices,
+    int64_t length, std::shared_ptr<Buffer>* out) {
+  return AllocateIndicesToBitmap(pool, indices, num_indices, length, out);
+}
+
+Status IndicesToBitmap(MemoryPool* pool, const int64_t* indices, int64_t num_indices,
+    int64_t length, std::shared_ptr<Buffer>* out) {
+  return AllocateIndicesToBitmap(pool, indices, num_indices, length, out);
+}
+
+// A run starts at every bit that differs from the one before it, the first bit
+// always starting one. Runs of set and unset bits alternate, so the counts
+// follow from the number of runs and the value of the first bit. The run
+// starts of a block of words are collected and counted with the dispatched
+// popcount
+void CountBitRuns(const uint8_t* bitmap, int64_t offset, int64_t length,
+    int64_t* set_runs, int64_t* unset_runs) {
+  *set_runs = 0;
+  *unset_runs = 0;
+  if (length == 0) { return; }
+  constexpr int kBlockWords = 64;
+  const PopcountWordsFunc popcount_words = GetPopcountWords();
+  const RangeWords words(bitmap, offset, length);
+  const bool first_set = BitUtil::GetBit(bitmap, offset);
+  uint64_t run_starts[kBlockWords];
+  uint64_t previous = first_set ? 0 : 1;
+  int64_t num_runs = 0;
+  for (int64_t i = 0; i < length;) {
+    int num_words = 0;
+    for (; num_words < kBlockWords && i < length; ++num_words, i += 64) {
+      int num_bits;
+      const uint64_t word = words.Word(i, &num_bits);
+      const uint64_t valid = num_bits == 64 ? ~0ULL : (1ULL << num_bits) - 1;
+      run_starts[num_words] = (word ^ ((word << 1) | previous)) & valid;
+      previous = (word >> (num_bits - 1)) & 1;
+    }
+    num_runs += popcount_words(run_starts, num_words);
+  }
+  *set_runs = first_set ? (num_runs + 1) / 2 : num_runs / 2;
+  *unset_runs = num_runs - *set_runs;
+}
+
+namespace internal {
+
+int64_t BitmapToIndices(DispatchLevel max_level, const uint8_t* bitmap, int64_t offset,
+    int64_t length, int32_t* indices) {
+  return DispatchBitmapToIndices(
+      BitmapToIndicesDispatch<int32_t>(max_level), bitmap, offset, length, indices);
+}
+
+int64_t BitmapToIndices(DispatchLevel max_level, const uint8_t* bitmap, int64_t offset,
+    int64_t length, int64_t* indices) {
+  return DispatchBitmapToIndices(
+      BitmapToIndicesDispatch<int64_t>(max_level), bitmap, offset, length, indices);
+}
+
+}  // namespace internal
+
 }  // namespace arrow
@@ -27,6 +27,7 @@
 #endif
 
 #if defined(_MSC_VER)
+#include <intrin.h>
 #define ARROW_BYTE_SWAP64 _byteswap_uint64
 #define ARROW_BYTE_SWAP32 _byteswap_ulong
 #else
@@ -35,6 +36,7 @@
 #endif
 
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <vector>
@@ -94,6 +96,8 @@ class MemoryPool;
 class MutableBuffer;
 class Status;
 
+enum class DispatchLevel : int;
+
 namespace BitUtil {
 
 static constexpr uint8_t kBitmask[] = {1, 2, 4, 8, 16, 32, 64, 128};
@@ -285,6 +289,17 @@ static inline uint64_t TrailingBits(uint64_t v, int num_bits) {
   return (v << n) >> n;
 }
 
+/// Returns the index of the least significant set bit of x, which must not be 0
+static inline int CountTrailingZeros(uint64_t x) {
+#if defined(_MSC_VER)
+  unsigned long index;  // NOLINT
+  _BitScanForward64(&index, x);
+  return static_cast<int>(index);
+#else
+  return __builtin_ctzll(x);
+#endif
+}
+
 /// Returns ceil(log2(x)).
 /// TODO: this could be faster if we use __builtin_clz.  Fix this if this ever shows up
 /// in a hot path.
@@ -441,6 +456,29 @@ static T ShiftRightLogical(T v, int shift) {
   return static_cast<typename make_unsigned<T>::type>(v) >> shift;
 }
 
+/// Returns num_bits (at most 64) bits of a bitmap starting at bit_offset as the
+/// low bits of a word, without reading any byte past the last of them
+static inline uint64_t LoadBitmapWord(
+    const uint8_t* bitmap, int64_t bit_offset, int num_bits) {
+  const uint8_t* bytes = bitmap + bit_offset / 8;
+  const int shift = static_cast<int>(bit_offset % 8);
+  const int num_bytes = (shift + num_bits + 7) / 8;
+  uint64_t word = 0;
+  if (num_bytes >= 8) {
+    memcpy(&word, bytes, sizeof(word));
+#if __BYTE_ORDER != __LITTLE_ENDIAN
+    word = ByteSwap(word);
+#endif
+  } else {
+    for (int i = 0; i < num_bytes; ++i) {
+      word |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    }
+  }
+  word >>= shift;
+  if (num_bytes > 8) { word |= static_cast<uint64_t>(bytes[8]) << (64 - shift); }
+  return TrailingBits(word, num_bits);
+}
+
 void FillBitsFromBytes(const std::vector<uint8_t>& bytes, uint8_t* bits);
 ARROW_EXPORT Status BytesToBits(const std::vector<uint8_t>&, std::shared_ptr<Buffer>*);
 
@@ -476,6 +514,97 @@ int64_t ARROW_EXPORT CountSetBits(
 
 bool ARROW_EXPORT BitmapEquals(const uint8_t* left, int64_t left_offset,
     const uint8_t* right, int64_t right_offset, int64_t bit_length);
+
+/// \brief Bitwise operations on bitmaps with arbitrary bit offsets
+///
+/// Each function combines the bits [left_offset, left_offset + length) of left
+/// with the bits [right_offset, right_offset + length) of right and writes the
+/// result to the bits [out_offset, out_offset + length) of out, leaving the
+/// other bits of out untouched. The offsets need not be aligned with each
+/// other; misaligned inputs are shifted into place a word at a time.
+///
+/// BitmapAndNot computes left & ~right.
+void ARROW_EXPORT BitmapAnd(const uint8_t* left, int64_t left_offset,
+    const uint8_t* right, int64_t right_offset, int64_t length, int64_t out_offset,
+    uint8_t* out);
+void ARROW_EXPORT BitmapOr(const uint8_t* left, int64_t left_offset,
+    const uint8_t* right, int64_t right_offset, int64_t length, int64_t out_offset,
+    uint8_t* out);
+void ARROW_EXPORT BitmapXor(const uint8_t* left, int64_t left_offset,
+    const uint8_t* right, int64_t right_offset, int64_t length, int64_t out_offset,
+    uint8_t* out);
+void ARROW_EXPORT BitmapAndNot(const uint8_t* left, int64_t left_offset,
+    const uint8_t* right, int64_t right_offset, int64_t length, int64_t out_offset,
+    uint8_t* out);
+
+/// \brief Allocating versions of the bitmap operations. The result has
+/// out_offset + length bits, the first out_offset of which are zero
+Status ARROW_EXPORT BitmapAnd(MemoryPool* pool, const uint8_t* left,
+    int64_t left_offset, const uint8_t* right, int64_t right_offset, int64_t length,
+    int64_t out_offset, std::shared_ptr<Buffer>* out);
+Status ARROW_EXPORT BitmapOr(MemoryPool* pool, const uint8_t* left, int64_t left_offset,
+    const uint8_t* right, int64_t right_offset, int64_t length, int64_t out_offset,
+    std::shared_ptr<Buffer>* out);
+Status ARROW_EXPORT BitmapXor(MemoryPool* pool, const uint8_t* left,
+    int64_t left_offset, const uint8_t* right, int64_t right_offset, int64_t length,
+    int64_t out_offset, std::shared_ptr<Buffer>* out);
+Status ARROW_EXPORT BitmapAndNot(MemoryPool* pool, const uint8_t* left,
+    int64_t left_offset, const uint8_t* right, int64_t right_offset, int64_t length,
+    int64_t out_offset, std::shared_ptr<Buffer>* out);
+
+// ----------------------------------------------------------------------
+// Selection vectors
+
+/// \brief Write the positions of the set bits of a bitmap range
+///
+/// \param[in] bitmap source data
+/// \param[in] offset bit offset into the source data
+/// \param[in] length number of bits to inspect
+/// \param[out] indices the positions, relative to offset and in increasing
+/// order. Must have room for CountSetBits(bitmap, offset, length) values
+///
+/// \return the number of indices written
+int64_t ARROW_EXPORT BitmapToIndices(
+    const uint8_t* bitmap, int64_t offset, int64_t length, int32_t* indices);
+int64_t ARROW_EXPORT BitmapToIndices(
+    const uint8_t* bitmap, int64_t offset, int64_t length, int64_t* indices);
+
+/// \brief Set the bits offset + indices[i] of a bitmap, leaving the others
+/// untouched. The indices need not be sorted, though sorted indices are faster
+void ARROW_EXPORT IndicesToBitmap(
+    const int32_t* indices, int64_t num_indices, int64_t offset, uint8_t* bitmap);
+void ARROW_EXPORT IndicesToBitmap(
+    const int64_t* indices, int64_t num_indices, int64_t offset, uint8_t* bitmap);
+
+/// \brief Allocating versions of IndicesToBitmap. The result has length bits,
+/// which all indices must be less than
+Status ARROW_EXPORT IndicesToBitmap(MemoryPool* pool, const int32_t* indices,
+    int64_t num_indices, int64_t length, std::shared_ptr<Buffer>* out);
+Status ARROW_EXPORT IndicesToBitmap(MemoryPool* pool, const int64_t* indices,
+    int64_t num_indices, int64_t length, std::shared_ptr<Buffer>* out);
+
+/// \brief Count the runs of consecutive set bits and of consecutive unset
+/// bits in a bitmap range
+///
+/// \param[in] bitmap source data
+/// \param[in] offset bit offset into the source data
+/// \param[in] length number of bits to inspect
+/// \param[out] set_runs the number of runs of set bits
+/// \param[out] unset_runs the number of runs of unset bits
+void ARROW_EXPORT CountBitRuns(const uint8_t* bitmap, int64_t offset, int64_t length,
+    int64_t* set_runs, int64_t* unset_runs);
+
+namespace internal {
+
+/// \brief BitmapToIndices restricted to the kernels of at most max_level,
+/// which the CPU must support. For testing the kernels against each other
+int64_t ARROW_EXPORT BitmapToIndices(DispatchLevel max_level, const uint8_t* bitmap,
+    int64_t offset, int64_t length, int32_t* indices);
+int64_t ARROW_EXPORT BitmapToIndices(DispatchLevel max_level, const uint8_t* bitmap,
+    int64_t offset, int64_t length, int64_t* indices);
+
+}  // namespace internal
+
 }  // namespace arrow
 
 #endif  // ARROW_UTIL_BIT_UTIL_H
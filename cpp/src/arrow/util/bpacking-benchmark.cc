@@ -0,0 +1,91 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "arrow/test-util.h"
+#include "arrow/util/bpacking.h"
+#include "arrow/util/dispatch.h"
+
+namespace arrow {
+
+static constexpr int kNumValues = 1 << 16;
+
+// Random input holding kNumValues packed values of num_bits bits
+static std::vector<uint32_t> PackedInput(int num_bits) {
+  std::vector<uint32_t> input(kNumValues * num_bits / 32 + 1);
+  test::random_bytes(input.size() * sizeof(uint32_t), 0,
+      reinterpret_cast<uint8_t*>(input.data()));
+  return input;
+}
+
+template <typename T>
+static void BenchmarkUnpack(benchmark::State& state,  // NOLINT non-const reference
+    int (*unpack)(const uint32_t*, T*, int, int), DispatchLevel level) {
+  if (!IsDispatchLevelSupported(level)) {
+    state.SkipWithError("Instruction set not supported");
+    return;
+  }
+  const int num_bits = static_cast<int>(state.range(0));
+  const std::vector<uint32_t> input = PackedInput(num_bits);
+  std::vector<T> output(kNumValues);
+  while (state.KeepRunning()) {
+    unpack(input.data(), output.data(), kNumValues, num_bits);
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+template <typename T>
+static void BM_UnpackScalar(benchmark::State& state) {  // NOLINT non-const reference
+  BenchmarkUnpack<T>(state, unpack32_scalar, DispatchLevel::NONE);
+}
+
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+template <typename T>
+static void BM_UnpackAvx2(benchmark::State& state) {  // NOLINT non-const reference
+  BenchmarkUnpack<T>(state, unpack32_avx2, DispatchLevel::AVX2);
+}
+#endif
+
+#ifdef ARROW_HAVE_RUNTIME_AVX512
+template <typename T>
+static void BM_UnpackAvx512(benchmark::State& state) {  // NOLINT non-const reference
+  BenchmarkUnpack<T>(state, unpack32_avx512, DispatchLevel::AVX512);
+}
+#endif
+
+BENCHMARK_TEMPLATE(BM_UnpackScalar, uint32_t)->DenseRange(1, 32);
+BENCHMARK_TEMPLATE(BM_UnpackScalar, uint16_t)->Arg(1)->Arg(4)->Arg(8)->Arg(12)->Arg(16);
+BENCHMARK_TEMPLATE(BM_UnpackScalar, uint8_t)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+BENCHMARK_TEMPLATE(BM_UnpackAvx2, uint32_t)->DenseRange(1, 32);
+BENCHMARK_TEMPLATE(BM_UnpackAvx2, uint16_t)->Arg(1)->Arg(4)->Arg(8)->Arg(12)->Arg(16);
+BENCHMARK_TEMPLATE(BM_UnpackAvx2, uint8_t)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+#endif
+
+#ifdef ARROW_HAVE_RUNTIME_AVX512
+BENCHMARK_TEMPLATE(BM_UnpackAvx512, uint32_t)->DenseRange(1, 32);
+BENCHMARK_TEMPLATE(BM_UnpackAvx512, uint16_t)->Arg(1)->Arg(4)->Arg(8)->Arg(12)->Arg(16);
+BENCHMARK_TEMPLATE(BM_UnpackAvx512, uint8_t)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+#endif
+
+}  // namespace arrow
@@ -0,0 +1,283 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/util/bpacking.h"
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+#include <immintrin.h>
+#endif
+
+#include "arrow/util/dispatch.h"
+#include "arrow/util/logging.h"
+
+namespace arrow {
+
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+
+namespace {
+
+// Eight consecutive values of num_bits bits occupy exactly num_bits bytes. For
+// a block loaded as eight 32-bit words, each lane gathers the word its value
+// starts in and the word after it, shifts both into place and masks the result
+struct UnpackPlan {
+  __m256i low_words;
+  __m256i high_words;
+  __m256i low_shifts;
+  __m256i high_shifts;
+  __m256i mask;
+};
+
+ARROW_TARGET_AVX2 UnpackPlan MakeUnpackPlan(int num_bits) {
+  alignas(32) int32_t low_words[8], high_words[8], low_shifts[8], high_shifts[8];
+  for (int k = 0; k < 8; ++k) {
+    const int start = k * num_bits;
+    low_words[k] = start / 32;
+    // The lane index wraps around for the last value of 32-bit wide blocks,
+    // whose high shift of 32 clears it anyway
+    high_words[k] = (start / 32 + 1) % 8;
+    low_shifts[k] = start % 32;
+    high_shifts[k] = 32 - start % 32;
+  }
+  UnpackPlan plan;
+  plan.low_words = _mm256_load_si256(reinterpret_cast<const __m256i*>(low_words));
+  plan.high_words = _mm256_load_si256(reinterpret_cast<const __m256i*>(high_words));
+  plan.low_shifts = _mm256_load_si256(reinterpret_cast<const __m256i*>(low_shifts));
+  plan.high_shifts = _mm256_load_si256(reinterpret_cast<const __m256i*>(high_shifts));
+  plan.mask = _mm256_set1_epi32(
+      num_bits == 32 ? -1 : static_cast<int32_t>((1U << num_bits) - 1));
+  return plan;
+}
+
+ARROW_TARGET_AVX2 inline __m256i UnpackBlock(
+    const uint8_t* block, const UnpackPlan& plan) {
+  const __m256i words = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+  const __m256i low = _mm256_srlv_epi32(
+      _mm256_permutevar8x32_epi32(words, plan.low_words), plan.low_shifts);
+  const __m256i high = _mm256_sllv_epi32(
+      _mm256_permutevar8x32_epi32(words, plan.high_words), plan.high_shifts);
+  return _mm256_and_si256(_mm256_or_si256(low, high), plan.mask);
+}
+
+// Store the 32 values of four blocks, narrowing them with saturating packs.
+// The packs work within 128-bit lanes, so a permute restores the order
+ARROW_TARGET_AVX2 inline void StoreGroup(const __m256i* blocks, uint32_t* out) {
+  for (int j = 0; j < 4; ++j) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + j * 8), blocks[j]);
+  }
+}
+
+ARROW_TARGET_AVX2 inline void StoreGroup(const __m256i* blocks, uint16_t* out) {
+  for (int j = 0; j < 4; j += 2) {
+    const __m256i packed = _mm256_packus_epi32(blocks[j], blocks[j + 1]);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + j * 8),
+        _mm256_permute4x64_epi64(packed, 0xD8));
+  }
+}
+
+ARROW_TARGET_AVX2 inline void StoreGroup(const __m256i* blocks, uint8_t* out) {
+  const __m256i packed = _mm256_packus_epi16(_mm256_packus_epi32(blocks[0], blocks[1]),
+      _mm256_packus_epi32(blocks[2], blocks[3]));
+  const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+  _mm256_storeu_si256(
+      reinterpret_cast<__m256i*>(out), _mm256_permutevar8x32_epi32(packed, order));
+}
+
+template <typename T>
+ARROW_TARGET_AVX2 int UnpackAvx2(
+    const uint32_t* in, T* out, int batch_size, int num_bits) {
+  DCHECK_LE(num_bits, static_cast<int>(sizeof(T) * 8));
+  batch_size = batch_size / 32 * 32;
+  if (num_bits == 0) {
+    memset(out, 0, batch_size * sizeof(T));
+    return batch_size;
+  }
+
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(in);
+  const int64_t num_bytes = static_cast<int64_t>(batch_size) * num_bits / 8;
+  const UnpackPlan plan = MakeUnpackPlan(num_bits);
+  __m256i blocks[4];
+
+  // Groups of 32 values take 4 * num_bits bytes. The 32-byte load of their
+  // last block may reach past the input; such groups are copied out first
+  for (int i = 0; i < batch_size; i += 32) {
+    const uint8_t* group = bytes + static_cast<int64_t>(i / 8) * num_bits;
+    alignas(32) uint8_t padded[4 * 32 + 32];
+    if (group + 3 * num_bits + 32 > bytes + num_bytes) {
+      memset(padded, 0, sizeof(padded));
+      memcpy(padded, group, 4 * num_bits);
+      group = padded;
+    }
+    for (int j = 0; j < 4; ++j) {
+      blocks[j] = UnpackBlock(group + j * num_bits, plan);
+    }
+    StoreGroup(blocks, out + i);
+  }
+  return batch_size;
+}
+
+}  // namespace
+
+int unpack32_avx2(const uint32_t* in, uint32_t* out, int batch_size, int num_bits) {
+  return UnpackAvx2(in, out, batch_size, num_bits);
+}
+
+int unpack32_avx2(const uint32_t* in, uint16_t* out, int batch_size, int num_bits) {
+  return UnpackAvx2(in, out, batch_size, num_bits);
+}
+
+int unpack32_avx2(const uint32_t* in, uint8_t* out, int batch_size, int num_bits) {
+  return UnpackAvx2(in, out, batch_size, num_bits);
+}
+
+#endif  // ARROW_HAVE_RUNTIME_AVX2
+
+#ifdef ARROW_HAVE_RUNTIME_AVX512
+
+namespace {
+
+// The AVX2 scheme widened to blocks of 16 values, which occupy 2 * num_bits
+// bytes. AVX-512F narrows with truncating stores, no packing needed
+struct UnpackPlan512 {
+  __m512i low_words;
+  __m512i high_words;
+  __m512i low_shifts;
+  __m512i high_shifts;
+  __m512i mask;
+};
+
+ARROW_TARGET_AVX512 UnpackPlan512 MakeUnpackPlan512(int num_bits) {
+  alignas(64) int32_t low_words[16], high_words[16], low_shifts[16], high_shifts[16];
+  for (int k = 0; k < 16; ++k) {
+    const int start = k * num_bits;
+    low_words[k] = start / 32;
+    high_words[k] = (start / 32 + 1) % 16;
+    low_shifts[k] = start % 32;
+    high_shifts[k] = 32 - start % 32;
+  }
+  UnpackPlan512 plan;
+  plan.low_words = _mm512_load_si512(low_words);
+  plan.high_words = _mm512_load_si512(high_words);
+  plan.low_shifts = _mm512_load_si512(low_shifts);
+  plan.high_shifts = _mm512_load_si512(high_shifts);
+  plan.mask = _mm512_set1_epi32(
+      num_bits == 32 ? -1 : static_cast<int32_t>((1U << num_bits) - 1));
+  return plan;
+}
+
+ARROW_TARGET_AVX512 inline __m512i UnpackBlock512(
+    const uint8_t* block, const UnpackPlan512& plan) {
+  const __m512i words = _mm512_loadu_si512(block);
+  const __m512i low = _mm512_srlv_epi32(
+      _mm512_permutexvar_epi32(plan.low_words, words), plan.low_shifts);
+  const __m512i high = _mm512_sllv_epi32(
+      _mm512_permutexvar_epi32(plan.high_words, words), plan.high_shifts);
+  return _mm512_and_si512(_mm512_or_si512(low, high), plan.mask);
+}
+
+ARROW_TARGET_AVX512 inline void StoreBlock512(__m512i values, uint32_t* out) {
+  _mm512_storeu_si512(out, values);
+}
+
+ARROW_TARGET_AVX512 inline void StoreBlock512(__m512i values, uint16_t* out) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm512_cvtepi32_epi16(values));
+}
+
+ARROW_TARGET_AVX512 inline void StoreBlock512(__m512i values, uint8_t* out) {
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm512_cvtepi32_epi8(values));
+}
+
+template <typename T>
+ARROW_TARGET_AVX512 int UnpackAvx512(
+    const uint32_t* in, T* out, int batch_size, int num_bits) {
+  DCHECK_LE(num_bits, static_cast<int>(sizeof(T) * 8));
+  batch_size = batch_size / 32 * 32;
+  if (num_bits == 0) {
+    memset(out, 0, batch_size * sizeof(T));
+    return batch_size;
+  }
+
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(in);
+  const int64_t num_bytes = static_cast<int64_t>(batch_size) * num_bits / 8;
+  const UnpackPlan512 plan = MakeUnpackPlan512(num_bits);
+
+  // As for AVX2, groups of 32 values whose second 64-byte load would reach
+  // past the input are copied out first
+  for (int i = 0; i < batch_size; i += 32) {
+    const uint8_t* group = bytes + static_cast<int64_t>(i / 8) * num_bits;
+    alignas(64) uint8_t padded[4 * 32 + 64];
+    if (group + 2 * num_bits + 64 > bytes + num_bytes) {
+      memset(padded, 0, sizeof(padded));
+      memcpy(padded, group, 4 * num_bits);
+      group = padded;
+    }
+    StoreBlock512(UnpackBlock512(group, plan), out + i);
+    StoreBlock512(UnpackBlock512(group + 2 * num_bits, plan), out + i + 16);
+  }
+  return batch_size;
+}
+
+}  // namespace
+
+int unpack32_avx512(const uint32_t* in, uint32_t* out, int batch_size, int num_bits) {
+  return UnpackAvx512(in, out, batch_size, num_bits);
+}
+
+int unpack32_avx512(const uint32_t* in, uint16_t* out, int batch_size, int num_bits) {
+  return UnpackAvx512(in, out, batch_size, num_bits);
+}
+
+int unpack32_avx512(const uint32_t* in, uint8_t* out, int batch_size, int num_bits) {
+  return UnpackAvx512(in, out, batch_size, num_bits);
+}
+
+#endif  // ARROW_HAVE_RUNTIME_AVX512
+
+namespace {
+
+template <typename T>
+int DispatchUnpack32(const uint32_t* in, T* out, int batch_size, int num_bits) {
+  typedef int (*UnpackFunc)(const uint32_t*, T*, int, int);
+  static DynamicDispatch<UnpackFunc> dispatch({
+      {DispatchLevel::NONE, unpack32_scalar},
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+      {DispatchLevel::AVX2, unpack32_avx2},
+#endif
+#ifdef ARROW_HAVE_RUNTIME_AVX512
+      {DispatchLevel::AVX512, unpack32_avx512},
+#endif
+  });
+  return dispatch.func(in, out, batch_size, num_bits);
+}
+
+}  // namespace
+
+int unpack32(const uint32_t* in, uint32_t* out, int batch_size, int num_bits) {
+  return DispatchUnpack32(in, out, batch_size, num_bits);
+}
+
+int unpack32(const uint32_t* in, uint16_t* out, int batch_size, int num_bits) {
+  return DispatchUnpack32(in, out, batch_size, num_bits);
+}
+
+int unpack32(const uint32_t* in, uint8_t* out, int batch_size, int num_bits) {
+  return DispatchUnpack32(in, out, batch_size, num_bits);
+}
+
+}  // namespace arrow
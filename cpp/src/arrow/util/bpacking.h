@@ -30,7 +30,12 @@
 #ifndef ARROW_UTIL_BPACKING_H
 #define ARROW_UTIL_BPACKING_H
 
+#include <algorithm>
+#include <cstdint>
+
+#include "arrow/util/dispatch.h"
 #include "arrow/util/logging.h"
+#include "arrow/util/visibility.h"
 
 namespace arrow {
 
@@ -3193,7 +3198,8 @@ inline const uint32_t* nullunpacker32(const uint32_t* in, uint32_t* out) {
   return in;
 }
 
-inline int unpack32(const uint32_t* in, uint32_t* out, int batch_size, int num_bits) {
+inline int unpack32_scalar(
+    const uint32_t* in, uint32_t* out, int batch_size, int num_bits) {
   batch_size = batch_size / 32 * 32;
   int num_loops = batch_size / 32;
 
@@ -3337,6 +3343,58 @@ inline int unpack32(const uint32_t* in, uint32_t* out, int batch_size, int num_b
   return batch_size;
 }
 
+/// Unpack into a narrower output through a 32-bit staging buffer
+template <typename T>
+inline int unpack32_scalar(const uint32_t* in, T* out, int batch_size, int num_bits) {
+  DCHECK_LE(num_bits, static_cast<int>(sizeof(T) * 8));
+  batch_size = batch_size / 32 * 32;
+  const int buffer_size = 1024;
+  uint32_t unpack_buffer[buffer_size];
+  for (int i = 0; i < batch_size; i += buffer_size) {
+    const int unpack_size = std::min(buffer_size, batch_size - i);
+    unpack32_scalar(in, unpack_buffer, unpack_size, num_bits);
+    in += unpack_size * num_bits / 32;
+    for (int k = 0; k < unpack_size; ++k) {
+      out[i + k] = static_cast<T>(unpack_buffer[k]);
+    }
+  }
+  return batch_size;
+}
+
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+/// AVX2 versions of unpack32, extracting 8 values at a time with a permute,
+/// variable shifts and a mask. The CPU must support DispatchLevel::AVX2
+ARROW_EXPORT int unpack32_avx2(
+    const uint32_t* in, uint32_t* out, int batch_size, int num_bits);
+ARROW_EXPORT int unpack32_avx2(
+    const uint32_t* in, uint16_t* out, int batch_size, int num_bits);
+ARROW_EXPORT int unpack32_avx2(
+    const uint32_t* in, uint8_t* out, int batch_size, int num_bits);
+#endif
+
+#ifdef ARROW_HAVE_RUNTIME_AVX512
+/// AVX-512 versions of unpack32, extracting 16 values at a time. The CPU must
+/// support DispatchLevel::AVX512
+ARROW_EXPORT int unpack32_avx512(
+    const uint32_t* in, uint32_t* out, int batch_size, int num_bits);
+ARROW_EXPORT int unpack32_avx512(
+    const uint32_t* in, uint16_t* out, int batch_size, int num_bits);
+ARROW_EXPORT int unpack32_avx512(
+    const uint32_t* in, uint8_t* out, int batch_size, int num_bits);
+#endif
+
+/// \brief Unpack batch_size values of num_bits bits each, rounded down to a
+/// multiple of 32, and return the number of values unpacked
+///
+/// Dispatches to the widest kernel the CPU supports. For 8 and 16-bit
+/// outputs num_bits must fit the output type.
+ARROW_EXPORT int unpack32(
+    const uint32_t* in, uint32_t* out, int batch_size, int num_bits);
+ARROW_EXPORT int unpack32(
+    const uint32_t* in, uint16_t* out, int batch_size, int num_bits);
+ARROW_EXPORT int unpack32(
+    const uint32_t* in, uint8_t* out, int batch_size, int num_bits);
+
 };  // namespace arrow
 
 #endif  // ARROW_UTIL_BPACKING_H
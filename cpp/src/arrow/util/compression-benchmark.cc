@@ -0,0 +1,234 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "arrow/buffer.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/test-util.h"
+#include "arrow/util/compression.h"
+#include "arrow/util/compression_parallel.h"
+#include "arrow/util/compression_zstd.h"
+
+namespace arrow {
+
+// Text-like data: words drawn at random, plus some numbers
+static std::vector<uint8_t> MakeData(int64_t size, uint32_t seed) {
+  const std::vector<std::string> words = {"arrow", "columnar", "memory", "format",
+      "record", "batch", "buffer", "schema", "field", "vector", "null", "true"};
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<size_t> word_dist(0, words.size() - 1);
+  std::uniform_int_distribution<int> number_dist(0, 100000);
+  std::vector<uint8_t> data;
+  while (static_cast<int64_t>(data.size()) < size) {
+    const std::string token =
+        word_dist(gen) == 0 ? std::to_string(number_dist(gen)) : words[word_dist(gen)];
+    data.insert(data.end(), token.begin(), token.end());
+    data.push_back(' ');
+  }
+  data.resize(size);
+  return data;
+}
+
+// The compressed buffers, with room for the worst case
+struct CompressedBuffers {
+  std::vector<std::vector<uint8_t>> data;
+  std::vector<int64_t> sizes;
+  int64_t total_size;
+};
+
+static CompressedBuffers MakeOutput(
+    Codec* codec, const std::vector<std::vector<uint8_t>>& buffers) {
+  CompressedBuffers out;
+  for (const auto& buffer : buffers) {
+    out.data.emplace_back(codec->MaxCompressedLen(buffer.size(), buffer.data()));
+  }
+  out.sizes.resize(buffers.size());
+  return out;
+}
+
+static void CompressBuffers(Codec* codec,
+    const std::vector<std::vector<uint8_t>>& buffers, CompressedBuffers* out) {
+  out->total_size = 0;
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    ABORT_NOT_OK(codec->Compress(buffers[i].size(), buffers[i].data(),
+        out->data[i].size(), out->data[i].data(), &out->sizes[i]));
+    out->total_size += out->sizes[i];
+  }
+}
+
+static void SetRatioLabel(
+    benchmark::State& state, int64_t total_size, int64_t compressed_size) {
+  std::stringstream ss;
+  ss << "ratio " << static_cast<double>(total_size) / compressed_size;
+  state.SetLabel(ss.str());
+}
+
+// 1MB in total, in buffers of the given size
+static std::vector<std::vector<uint8_t>> MakeBuffers(int64_t buffer_size) {
+  constexpr int64_t kTotalSize = 1 << 20;
+  std::vector<std::vector<uint8_t>> buffers;
+  for (int64_t i = 0; i < kTotalSize / buffer_size; ++i) {
+    buffers.push_back(MakeData(buffer_size, static_cast<uint32_t>(i)));
+  }
+  return buffers;
+}
+
+// Arguments: Compression::type, level, buffer size
+static void BM_Compress(benchmark::State& state) {  // NOLINT non-const reference
+  std::unique_ptr<Codec> codec;
+  ABORT_NOT_OK(Codec::Create(static_cast<Compression::type>(state.range(0)),
+      static_cast<int>(state.range(1)), &codec));
+  const std::vector<std::vector<uint8_t>> buffers = MakeBuffers(state.range(2));
+  const int64_t total_size = static_cast<int64_t>(buffers.size()) * state.range(2);
+  CompressedBuffers compressed = MakeOutput(codec.get(), buffers);
+
+  while (state.KeepRunning()) {
+    CompressBuffers(codec.get(), buffers, &compressed);
+  }
+  state.SetBytesProcessed(state.iterations() * total_size);
+  SetRatioLabel(state, total_size, compressed.total_size);
+}
+
+// Arguments: Compression::type, level, buffer size
+static void BM_Decompress(benchmark::State& state) {  // NOLINT non-const reference
+  std::unique_ptr<Codec> codec;
+  ABORT_NOT_OK(Codec::Create(static_cast<Compression::type>(state.range(0)),
+      static_cast<int>(state.range(1)), &codec));
+  const int64_t buffer_size = state.range(2);
+  const std::vector<std::vector<uint8_t>> buffers = MakeBuffers(buffer_size);
+  const int64_t total_size = static_cast<int64_t>(buffers.size()) * buffer_size;
+  CompressedBuffers compressed = MakeOutput(codec.get(), buffers);
+  CompressBuffers(codec.get(), buffers, &compressed);
+  std::vector<uint8_t> decompressed(buffer_size);
+
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < buffers.size(); ++i) {
+      ABORT_NOT_OK(codec->Decompress(compressed.sizes[i], compressed.data[i].data(),
+          buffer_size, decompressed.data()));
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * total_size);
+  SetRatioLabel(state, total_size, compressed.total_size);
+}
+
+static void CodecArguments(benchmark::internal::Benchmark* bench) {
+  const std::vector<std::pair<Compression::type, std::vector<int>>> levels = {
+      {Compression::SNAPPY, {kUseDefaultCompressionLevel}},
+      {Compression::LZ4, {1, 9}},
+      {Compression::ZSTD, {1, 3, 9, 19}},
+      {Compression::GZIP, {1, 6, 9}},
+      {Compression::BROTLI, {1, 5, 8}}};
+  for (const auto& codec_levels : levels) {
+    for (int level : codec_levels.second) {
+      // Whole buffers, and the small ones of many small batches
+      for (int buffer_size : {1 << 20, 1 << 12}) {
+        bench->Args({codec_levels.first, level, buffer_size});
+      }
+    }
+  }
+}
+
+// Arguments: whether to use a dictionary
+static void BM_ZSTDSmallBuffers(benchmark::State& state) {  // NOLINT non-const reference
+  constexpr int64_t kBufferSize = 256;
+  const std::vector<std::vector<uint8_t>> buffers = MakeBuffers(kBufferSize);
+  const int64_t total_size = static_cast<int64_t>(buffers.size()) * kBufferSize;
+
+  ZSTDCodec codec;
+  if (state.range(0)) {
+    std::vector<std::shared_ptr<Buffer>> samples;
+    for (size_t i = 0; i < buffers.size(); i += 4) {
+      std::shared_ptr<Buffer> sample;
+      ABORT_NOT_OK(
+          test::CopyBufferFromVector(buffers[i], default_memory_pool(), &sample));
+      samples.push_back(sample);
+    }
+    std::shared_ptr<Buffer> dictionary;
+    ABORT_NOT_OK(ZSTDCodec::TrainDictionary(
+        samples, 16 * 1024, default_memory_pool(), &dictionary));
+    ABORT_NOT_OK(codec.SetDictionary(dictionary));
+  }
+  CompressedBuffers compressed = MakeOutput(&codec, buffers);
+
+  while (state.KeepRunning()) {
+    CompressBuffers(&codec, buffers, &compressed);
+  }
+  state.SetBytesProcessed(state.iterations() * total_size);
+  SetRatioLabel(state, total_size, compressed.total_size);
+}
+
+// Arguments: Compression::type, number of threads
+static void BM_ParallelBlockCompress(
+    benchmark::State& state) {  // NOLINT non-const reference
+  std::unique_ptr<ParallelBlockCodec> codec;
+  ABORT_NOT_OK(ParallelBlockCodec::Make(static_cast<Compression::type>(state.range(0)),
+      kUseDefaultCompressionLevel, kDefaultCompressionBlockSize,
+      static_cast<int>(state.range(1)), &codec));
+  const std::vector<std::vector<uint8_t>> buffers = {MakeData(32 << 20, 0)};
+  CompressedBuffers compressed = MakeOutput(codec.get(), buffers);
+
+  while (state.KeepRunning()) {
+    CompressBuffers(codec.get(), buffers, &compressed);
+  }
+  state.SetBytesProcessed(state.iterations() * buffers[0].size());
+  SetRatioLabel(state, buffers[0].size(), compressed.total_size);
+}
+
+// Arguments: Compression::type, number of threads
+static void BM_ParallelBlockDecompress(
+    benchmark::State& state) {  // NOLINT non-const reference
+  std::unique_ptr<ParallelBlockCodec> codec;
+  ABORT_NOT_OK(ParallelBlockCodec::Make(static_cast<Compression::type>(state.range(0)),
+      kUseDefaultCompressionLevel, kDefaultCompressionBlockSize,
+      static_cast<int>(state.range(1)), &codec));
+  const std::vector<std::vector<uint8_t>> buffers = {MakeData(32 << 20, 0)};
+  CompressedBuffers compressed = MakeOutput(codec.get(), buffers);
+  CompressBuffers(codec.get(), buffers, &compressed);
+  std::vector<uint8_t> decompressed(buffers[0].size());
+
+  while (state.KeepRunning()) {
+    ABORT_NOT_OK(codec->Decompress(compressed.sizes[0], compressed.data[0].data(),
+        decompressed.size(), decompressed.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * buffers[0].size());
+}
+
+static void ParallelArguments(benchmark::internal::Benchmark* bench) {
+  for (Compression::type type : {Compression::LZ4, Compression::ZSTD}) {
+    for (int num_threads : {1, 2, 4, 8}) {
+      bench->Args({type, num_threads});
+    }
+  }
+}
+
+BENCHMARK(BM_Compress)->Apply(CodecArguments);
+BENCHMARK(BM_Decompress)->Apply(CodecArguments);
+BENCHMARK(BM_ZSTDSmallBuffers)->Arg(false)->Arg(true);
+BENCHMARK(BM_ParallelBlockCompress)->Apply(ParallelArguments)->UseRealTime();
+BENCHMARK(BM_ParallelBlockDecompress)->Apply(ParallelArguments)->UseRealTime();
+
+}  // namespace arrow
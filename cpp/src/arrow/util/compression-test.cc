@@ -16,13 +16,24 @@
 // under the License.
 
 #include <cstdint>
+#include <cstring>
 #include <gtest/gtest.h>
+#include <limits>
+#include <random>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "arrow/buffer.h"
+#include "arrow/memory_pool.h"
 #include "arrow/status.h"
 #include "arrow/test-common.h"
+#include "arrow/test-util.h"
 #include "arrow/util/compression.h"
+#include "arrow/util/compression_adaptive.h"
+#include "arrow/util/compression_parallel.h"
+#include "arrow/util/compression_zstd.h"
+#include "arrow/util/parallel.h"
 
 using std::string;
 using std::vector;
@@ -30,12 +41,13 @@ using std::vector;
 namespace arrow {
 
 template <Compression::type CODEC>
-void CheckCodecRoundtrip(const vector<uint8_t>& data) {
+void CheckCodecRoundtrip(
+    const vector<uint8_t>& data, int level = kUseDefaultCompressionLevel) {
   // create multiple compressors to try to break them
   std::unique_ptr<Codec> c1, c2;
 
-  ASSERT_OK(Codec::Create(CODEC, &c1));
-  ASSERT_OK(Codec::Create(CODEC, &c2));
+  ASSERT_OK(Codec::Create(CODEC, level, &c1));
+  ASSERT_OK(Codec::Create(CODEC, level, &c2));
 
   int max_compressed_len = static_cast<int>(c1->MaxCompressedLen(data.size(), &data[0]));
   std::vector<uint8_t> compressed(max_compressed_len);
@@ -53,6 +65,11 @@ void CheckCodecRoundtrip(const vector<uint8_t>& data) {
 
   ASSERT_EQ(data, decompressed);
 
+  // Expecting more output than the input holds must not leave a tail unwritten
+  std::vector<uint8_t> longer(data.size() + 1);
+  ASSERT_RAISES(IOError,
+      c2->Decompress(compressed.size(), &compressed[0], longer.size(), &longer[0]));
+
   // compress with c2
   int64_t actual_size2;
   ASSERT_OK(c2->Compress(
@@ -67,15 +84,51 @@ void CheckCodecRoundtrip(const vector<uint8_t>& data) {
 }
 
 template <Compression::type CODEC>
-void CheckCodec() {
+void CheckCodec(int level = kUseDefaultCompressionLevel) {
   int sizes[] = {10000, 100000};
   for (int data_size : sizes) {
     vector<uint8_t> data(data_size);
     test::random_bytes(data_size, 1234, data.data());
-    CheckCodecRoundtrip<CODEC>(data);
+    CheckCodecRoundtrip<CODEC>(data, level);
+  }
+}
+
+// Text-like data, which compresses better at higher levels
+static vector<uint8_t> MakeCompressibleData(int64_t size, uint32_t seed) {
+  const vector<string> words = {"arrow", "columnar", "memory", "format", "record",
+      "batch", "buffer", "schema", "field", "vector", "compression", "level"};
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<size_t> dist(0, words.size() - 1);
+  vector<uint8_t> data;
+  while (static_cast<int64_t>(data.size()) < size) {
+    const string& word = words[dist(gen)];
+    data.insert(data.end(), word.begin(), word.end());
+    data.push_back(' ');
+  }
+  data.resize(size);
+  return data;
+}
+
+template <Compression::type CODEC>
+void CheckLevels(const vector<int>& levels, const vector<int>& invalid_levels) {
+  for (int level : levels) {
+    CheckCodec<CODEC>(level);
+    CheckCodecRoundtrip<CODEC>(MakeCompressibleData(100000, level), level);
+  }
+  for (int level : invalid_levels) {
+    std::unique_ptr<Codec> codec;
+    ASSERT_RAISES(Invalid, Codec::Create(CODEC, level, &codec));
   }
 }
 
+static int64_t CompressedSize(Codec* codec, const vector<uint8_t>& data) {
+  vector<uint8_t> compressed(codec->MaxCompressedLen(data.size(), data.data()));
+  int64_t compressed_size;
+  EXPECT_OK(codec->Compress(data.size(), data.data(), compressed.size(),
+      compressed.data(), &compressed_size));
+  return compressed_size;
+}
+
 TEST(TestCompressors, Snappy) {
   CheckCodec<Compression::SNAPPY>();
 }
@@ -96,4 +149,293 @@ TEST(TestCompressors, Lz4) {
   CheckCodec<Compression::LZ4>();
 }
 
+TEST(TestCompressors, Levels) {
+  CheckLevels<Compression::BROTLI>({0, 5, 11}, {-1, 12});
+  CheckLevels<Compression::GZIP>({0, 1, 9}, {-1, 10});
+  CheckLevels<Compression::ZSTD>({1, 3, 19}, {0, 23});
+  CheckLevels<Compression::LZ4>({1, 3, 12}, {0, 13});
+  CheckLevels<Compression::SNAPPY>({}, {1});
+}
+
+TEST(TestCompressors, HigherLevelsCompressBetter) {
+  const vector<uint8_t> data = MakeCompressibleData(1 << 18, 0);
+  for (Compression::type type : {Compression::BROTLI, Compression::GZIP,
+           Compression::ZSTD, Compression::LZ4}) {
+    std::unique_ptr<Codec> fast, small;
+    ASSERT_OK(Codec::Create(type, type == Compression::BROTLI ? 0 : 1, &fast));
+    ASSERT_OK(Codec::Create(type, 9, &small));
+    ASSERT_LT(CompressedSize(small.get(), data), CompressedSize(fast.get(), data))
+        << fast->name();
+  }
+}
+
+TEST(TestCompressors, ZSTDDictionary) {
+  // Small buffers resembling each other
+  std::vector<std::shared_ptr<Buffer>> samples;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    vector<uint8_t> sample = MakeCompressibleData(200, i);
+    std::shared_ptr<Buffer> buffer;
+    ASSERT_OK(test::CopyBufferFromVector(sample, default_memory_pool(), &buffer));
+    samples.push_back(buffer);
+  }
+  std::shared_ptr<Buffer> dictionary;
+  ASSERT_OK(
+      ZSTDCodec::TrainDictionary(samples, 4096, default_memory_pool(), &dictionary));
+  ASSERT_GT(dictionary->size(), 0);
+  ASSERT_LE(dictionary->size(), 4096);
+
+  ZSTDCodec plain;
+  ZSTDCodec with_dictionary;
+  ASSERT_OK(with_dictionary.SetDictionary(dictionary));
+
+  const vector<uint8_t> data = MakeCompressibleData(200, 12345);
+  const int64_t plain_size = CompressedSize(&plain, data);
+  vector<uint8_t> compressed(with_dictionary.MaxCompressedLen(data.size(), data.data()));
+  int64_t compressed_size;
+  ASSERT_OK(with_dictionary.Compress(data.size(), data.data(), compressed.size(),
+      compressed.data(), &compressed_size));
+  ASSERT_LT(compressed_size, plain_size);
+
+  vector<uint8_t> decompressed(data.size());
+  ASSERT_OK(with_dictionary.Decompress(
+      compressed_size, compressed.data(), decompressed.size(), decompressed.data()));
+  ASSERT_EQ(data, decompressed);
+
+  // The dictionary is needed to decompress
+  ASSERT_RAISES(IOError, plain.Decompress(compressed_size, compressed.data(),
+      decompressed.size(), decompressed.data()));
+
+  // Too little data to train on
+  ASSERT_RAISES(Invalid, ZSTDCodec::TrainDictionary(
+      {samples[0]}, 4096, default_memory_pool(), &dictionary));
+}
+
+TEST(TestCompressors, ZSTDConcurrentUse) {
+  // Contexts are pooled, so one codec can be used from several threads
+  std::unique_ptr<Codec> codec;
+  ASSERT_OK(Codec::Create(Compression::ZSTD, 3, &codec));
+  ASSERT_OK(ParallelFor(4, 64, [&codec](int64_t i) {
+    const vector<uint8_t> data = MakeCompressibleData(10000, static_cast<uint32_t>(i));
+    vector<uint8_t> compressed(codec->MaxCompressedLen(data.size(), data.data()));
+    int64_t compressed_size;
+    RETURN_NOT_OK(codec->Compress(data.size(), data.data(), compressed.size(),
+        compressed.data(), &compressed_size));
+    vector<uint8_t> decompressed(data.size());
+    RETURN_NOT_OK(codec->Decompress(
+        compressed_size, compressed.data(), decompressed.size(), decompressed.data()));
+    if (data != decompressed) { return Status::Invalid("Round trip failed"); }
+    return Status::OK();
+  }));
+}
+
+// Compressible data followed by random bytes, so that some blocks are stored
+// as is
+static vector<uint8_t> MakeMixedData(int64_t size) {
+  vector<uint8_t> data = MakeCompressibleData(size / 2, 0);
+  vector<uint8_t> random(size - size / 2);
+  test::random_bytes(random.size(), 0, random.data());
+  data.insert(data.end(), random.begin(), random.end());
+  return data;
+}
+
+static vector<uint8_t> Compress(Codec* codec, const vector<uint8_t>& data) {
+  vector<uint8_t> compressed(codec->MaxCompressedLen(data.size(), data.data()));
+  int64_t compressed_size;
+  EXPECT_OK(codec->Compress(data.size(), data.data(), compressed.size(),
+      compressed.data(), &compressed_size));
+  compressed.resize(compressed_size);
+  return compressed;
+}
+
+TEST(TestParallelBlockCodec, RoundTrip) {
+  for (Compression::type type : {Compression::SNAPPY, Compression::GZIP,
+           Compression::BROTLI, Compression::ZSTD, Compression::LZ4}) {
+    for (int num_threads : {1, 4}) {
+      std::unique_ptr<ParallelBlockCodec> codec;
+      ASSERT_OK(ParallelBlockCodec::Make(
+          type, kUseDefaultCompressionLevel, 4096, num_threads, &codec));
+      for (int64_t size : {0, 1, 4096, 100000}) {
+        const vector<uint8_t> data = MakeMixedData(size);
+        const vector<uint8_t> compressed = Compress(codec.get(), data);
+        int64_t uncompressed_length;
+        ASSERT_OK(ParallelBlockCodec::GetUncompressedLength(
+            compressed.size(), compressed.data(), &uncompressed_length));
+        ASSERT_EQ(size, uncompressed_length);
+
+        vector<uint8_t> decompressed(size);
+        ASSERT_OK(codec->Decompress(
+            compressed.size(), compressed.data(), size, decompressed.data()));
+        ASSERT_EQ(data, decompressed) << codec->name() << " " << size;
+      }
+    }
+  }
+}
+
+TEST(TestParallelBlockCodec, CompressesLikeItsCodec) {
+  const vector<uint8_t> data = MakeCompressibleData(1 << 20, 0);
+  std::unique_ptr<Codec> zstd;
+  ASSERT_OK(Codec::Create(Compression::ZSTD, &zstd));
+  std::unique_ptr<ParallelBlockCodec> codec;
+  ASSERT_OK(ParallelBlockCodec::Make(Compression::ZSTD, 1, 1 << 18, 0, &codec));
+  const int64_t parallel_size = static_cast<int64_t>(Compress(codec.get(), data).size());
+  ASSERT_LT(parallel_size, CompressedSize(zstd.get(), data) * 11 / 10);
+}
+
+TEST(TestParallelBlockCodec, DecompressRange) {
+  std::unique_ptr<ParallelBlockCodec> codec;
+  ASSERT_OK(ParallelBlockCodec::Make(
+      Compression::LZ4, kUseDefaultCompressionLevel, 1000, 0, &codec));
+  const vector<uint8_t> data = MakeMixedData(10000);
+  const vector<uint8_t> compressed = Compress(codec.get(), data);
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int64_t> dist(0, 10000);
+  for (int i = 0; i < 100; ++i) {
+    int64_t start = dist(gen);
+    int64_t end = dist(gen);
+    if (start > end) { std::swap(start, end); }
+    vector<uint8_t> range(end - start);
+    ASSERT_OK(codec->DecompressRange(
+        compressed.size(), compressed.data(), start, end - start, range.data()));
+    ASSERT_EQ(vector<uint8_t>(data.begin() + start, data.begin() + end), range);
+  }
+
+  uint8_t out[10];
+  ASSERT_RAISES(Invalid,
+      codec->DecompressRange(compressed.size(), compressed.data(), 9995, 10, out));
+  ASSERT_RAISES(Invalid,
+      codec->DecompressRange(compressed.size(), compressed.data(), -1, 1, out));
+}
+
+TEST(TestParallelBlockCodec, Errors) {
+  std::unique_ptr<ParallelBlockCodec> codec;
+  ASSERT_RAISES(Invalid, ParallelBlockCodec::Make(
+      Compression::LZ4, kUseDefaultCompressionLevel, 0, 0, &codec));
+  ASSERT_RAISES(Invalid, ParallelBlockCodec::Make(Compression::LZ4, 13, 1000, 0, &codec));
+  ASSERT_RAISES(Invalid, ParallelBlockCodec::Make(
+      Compression::UNCOMPRESSED, kUseDefaultCompressionLevel, 1000, 0, &codec));
+  ASSERT_OK(ParallelBlockCodec::Make(
+      Compression::LZ4, kUseDefaultCompressionLevel, 1000, 0, &codec));
+
+  const vector<uint8_t> data = MakeMixedData(10000);
+  vector<uint8_t> compressed = Compress(codec.get(), data);
+  vector<uint8_t> decompressed(data.size() + 1);
+
+  // Wrong uncompressed length
+  ASSERT_RAISES(IOError, codec->Decompress(compressed.size(), compressed.data(),
+      data.size() + 1, decompressed.data()));
+  // Truncated, in the index and in the blocks
+  ASSERT_RAISES(IOError,
+      codec->Decompress(20, compressed.data(), data.size(), decompressed.data()));
+  ASSERT_RAISES(IOError, codec->Decompress(compressed.size() - 1, compressed.data(),
+      data.size(), decompressed.data()));
+  // Corrupt index headers: uncompressed length, then block size
+  const int64_t max_length = std::numeric_limits<int64_t>::max();
+  for (const auto& header : vector<std::pair<int64_t, int64_t>>(
+           {{max_length, 1000}, {max_length, 1}, {-1, 1000}, {10000, 0}, {10000, -1}})) {
+    vector<uint8_t> corrupt = compressed;
+    memcpy(corrupt.data(), &header.first, sizeof(int64_t));
+    memcpy(corrupt.data() + sizeof(int64_t), &header.second, sizeof(int64_t));
+    ASSERT_RAISES(IOError, codec->Decompress(corrupt.size(), corrupt.data(), data.size(),
+        decompressed.data()));
+  }
+  // A compressed last block that decompresses short of its length
+  const vector<uint8_t> text = MakeCompressibleData(9500, 0);
+  vector<uint8_t> short_block = Compress(codec.get(), text);
+  const int64_t longer_length = 9501;
+  memcpy(short_block.data(), &longer_length, sizeof(int64_t));
+  vector<uint8_t> longer(longer_length);
+  ASSERT_RAISES(IOError, codec->Decompress(short_block.size(), short_block.data(),
+      longer_length, longer.data()));
+  // Output too small
+  int64_t compressed_size;
+  ASSERT_RAISES(IOError, codec->Compress(data.size(), data.data(),
+      compressed.size() - 1, compressed.data(), &compressed_size));
+}
+
+static CodecChoice SelectCodec(CodecSelector* selector, const vector<uint8_t>& data) {
+  CodecChoice choice;
+  EXPECT_OK(selector->Select(data.size(), data.data(), &choice));
+  return choice;
+}
+
+TEST(TestCodecSelector, Choices) {
+  std::unique_ptr<CodecSelector> selector;
+  ASSERT_OK(CodecSelector::Make(CodecSelectorOptions(), &selector));
+
+  // Random bytes are not even tried
+  vector<uint8_t> random(1 << 20);
+  test::random_bytes(random.size(), 0, random.data());
+  CodecChoice choice = SelectCodec(selector.get(), random);
+  ASSERT_EQ(Compression::UNCOMPRESSED, choice.codec);
+  ASSERT_GT(choice.entropy, 7.9);
+  ASSERT_EQ(0, choice.fast_ratio);
+
+  // Random floats compress too little to be worth it
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> float_dist(0, 1);
+  vector<float> floats(1 << 18);
+  for (float& value : floats) {
+    value = float_dist(gen);
+  }
+  const auto float_bytes = reinterpret_cast<const uint8_t*>(floats.data());
+  ASSERT_OK(selector->Select(floats.size() * sizeof(float), float_bytes, &choice));
+  ASSERT_EQ(Compression::UNCOMPRESSED, choice.codec);
+  ASSERT_GT(choice.fast_ratio, 0);
+
+  // Few distinct values compress much better with entropy coding
+  vector<uint8_t> letters(1 << 20);
+  for (uint8_t& value : letters) {
+    value = static_cast<uint8_t>('a' + gen() % 8);
+  }
+  choice = SelectCodec(selector.get(), letters);
+  ASSERT_EQ(Compression::ZSTD, choice.codec);
+  ASSERT_GT(choice.strong_ratio, choice.fast_ratio);
+
+  // Small data is sampled as a whole
+  choice = SelectCodec(selector.get(), MakeCompressibleData(1000, 0));
+  ASSERT_NE(Compression::UNCOMPRESSED, choice.codec);
+  ASSERT_OK(selector->Select(0, nullptr, &choice));
+  ASSERT_EQ(Compression::UNCOMPRESSED, choice.codec);
+
+  const CodecSelectorStats stats = selector->stats();
+  ASSERT_EQ(3, stats.num_buffers.at(Compression::UNCOMPRESSED));
+  ASSERT_EQ(2, stats.num_buffers.at(Compression::ZSTD));
+  ASSERT_EQ(static_cast<int64_t>(random.size() + floats.size() * sizeof(float)),
+      stats.num_bytes.at(Compression::UNCOMPRESSED));
+  ASSERT_EQ(0, stats.num_buffers.count(Compression::LZ4));
+  ASSERT_GT(stats.num_trial_bytes, 0);
+}
+
+TEST(TestCodecSelector, ThroughputVersusRatio) {
+  const vector<uint8_t> data = MakeCompressibleData(1 << 20, 0);
+  CodecSelectorOptions options;
+
+  // Favoring throughput
+  options.min_strong_codec_gain = 100;
+  std::unique_ptr<CodecSelector> selector;
+  ASSERT_OK(CodecSelector::Make(options, &selector));
+  ASSERT_EQ(Compression::LZ4, SelectCodec(selector.get(), data).codec);
+
+  // Favoring ratio
+  options.min_strong_codec_gain = 1;
+  ASSERT_OK(CodecSelector::Make(options, &selector));
+  ASSERT_EQ(Compression::ZSTD, SelectCodec(selector.get(), data).codec);
+
+  // Requiring more than any codec achieves
+  options.min_compression_ratio = 1000;
+  ASSERT_OK(CodecSelector::Make(options, &selector));
+  ASSERT_EQ(Compression::UNCOMPRESSED, SelectCodec(selector.get(), data).codec);
+}
+
+TEST(TestCodecSelector, InvalidOptions) {
+  std::unique_ptr<CodecSelector> selector;
+  CodecSelectorOptions options;
+  options.num_samples = 0;
+  ASSERT_RAISES(Invalid, CodecSelector::Make(options, &selector));
+  options = CodecSelectorOptions();
+  options.strong_compression_level = 100;
+  ASSERT_RAISES(Invalid, CodecSelector::Make(options, &selector));
+}
+
 }  // namespace arrow
@@ -47,14 +47,53 @@
 
 namespace arrow {
 
+Compressor::~Compressor() {}
+
+Decompressor::~Decompressor() {}
+
 Codec::~Codec() {}
 
+Status Codec::MakeCompressor(std::shared_ptr<Compressor>* out) {
+  std::stringstream ss;
+  ss << "Streaming compression is not supported by the " << name() << " codec";
+  return Status::NotImplemented(ss.str());
+}
+
+Status Codec::MakeDecompressor(std::shared_ptr<Decompressor>* out) {
+  std::stringstream ss;
+  ss << "Streaming decompression is not supported by the " << name() << " codec";
+  return Status::NotImplemented(ss.str());
+}
+
+// Check that a level other than the default is within [min_level, max_level],
+// replacing the default by default_level
+static Status ResolveCompressionLevel(const char* codec_name, int min_level,
+    int max_level, int default_level, int* compression_level) {
+  if (*compression_level == kUseDefaultCompressionLevel) {
+    *compression_level = default_level;
+  } else if (*compression_level < min_level || *compression_level > max_level) {
+    std::stringstream ss;
+    ss << "Compression level " << *compression_level << " is out of range for "
+       << codec_name << ", which supports levels " << min_level << " to " << max_level;
+    return Status::Invalid(ss.str());
+  }
+  return Status::OK();
+}
+
 Status Codec::Create(Compression::type codec_type, std::unique_ptr<Codec>* result) {
+  return Create(codec_type, kUseDefaultCompressionLevel, result);
+}
+
+Status Codec::Create(Compression::type codec_type, int compression_level,
+    std::unique_ptr<Codec>* result) {
   switch (codec_type) {
     case Compression::UNCOMPRESSED:
       break;
     case Compression::SNAPPY:
 #ifdef ARROW_WITH_SNAPPY
+      if (compression_level != kUseDefaultCompressionLevel) {
+        return Status::Invalid("The snappy codec does not support compression levels");
+      }
       result->reset(new SnappyCodec());
 #else
       return Status::NotImplemented("Snappy codec support not built");
@@ -62,7 +101,9 @@ Status Codec::Create(Compression::type codec_type, std::unique_ptr<Codec>* resul
       break;
     case Compression::GZIP:
 #ifdef ARROW_WITH_ZLIB
-      result->reset(new GZipCodec());
+      RETURN_NOT_OK(ResolveCompressionLevel("gzip", kGZipMinCompressionLevel,
+          kGZipMaxCompressionLevel, kGZipDefaultCompressionLevel, &compression_level));
+      result->reset(new GZipCodec(GZipCodec::GZIP, compression_level));
 #else
       return Status::NotImplemented("Gzip codec support not built");
 #endif
@@ -71,21 +112,28 @@ Status Codec::Create(Compression::type codec_type, std::unique_ptr<Codec>* resul
       return Status::NotImplemented("LZO codec not implemented");
     case Compression::BROTLI:
 #ifdef ARROW_WITH_BROTLI
-      result->reset(new BrotliCodec());
+      RETURN_NOT_OK(ResolveCompressionLevel("brotli", kBrotliMinCompressionLevel,
+          kBrotliMaxCompressionLevel, kBrotliDefaultCompressionLevel,
+          &compression_level));
+      result->reset(new BrotliCodec(compression_level));
 #else
       return Status::NotImplemented("Brotli codec support not built");
 #endif
       break;
     case Compression::LZ4:
 #ifdef ARROW_WITH_LZ4
-      result->reset(new Lz4Codec());
+      RETURN_NOT_OK(ResolveCompressionLevel("lz4", kLz4MinCompressionLevel,
+          kLz4MaxCompressionLevel, kLz4DefaultCompressionLevel, &compression_level));
+      result->reset(new Lz4Codec(compression_level));
 #else
       return Status::NotImplemented("LZ4 codec support not built");
 #endif
       break;
     case Compression::ZSTD:
 #ifdef ARROW_WITH_ZSTD
-      result->reset(new ZSTDCodec());
+      RETURN_NOT_OK(ResolveCompressionLevel("zstd", kZSTDMinCompressionLevel,
+          kZSTDMaxCompressionLevel, kZSTDDefaultCompressionLevel, &compression_level));
+      result->reset(new ZSTDCodec(compression_level));
 #else
       return Status::NotImplemented("ZSTD codec support not built");
 #endif
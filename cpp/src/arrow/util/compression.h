@@ -19,6 +19,7 @@
 #define ARROW_UTIL_COMPRESSION_H
 
 #include <cstdint>
+#include <limits>
 #include <memory>
 
 #include "arrow/status.h"
@@ -30,12 +31,83 @@ struct Compression {
   enum type { UNCOMPRESSED, SNAPPY, GZIP, LZO, BROTLI, ZSTD, LZ4 };
 };
 
+/// \brief Compression level standing for the default level of a codec
+constexpr int kUseDefaultCompressionLevel = std::numeric_limits<int>::min();
+
+/// \brief Incremental compressor producing a single compressed stream
+///
+/// Output may be retained internally until Flush or End are called, so the
+/// compressed stream is only complete once End has returned should_retry false.
+class ARROW_EXPORT Compressor {
+ public:
+  virtual ~Compressor();
+
+  /// \brief Compress some of the input
+  ///
+  /// If bytes_read is 0 on return, the output buffer was too small to make
+  /// progress and a larger one should be supplied.
+  virtual Status Compress(int64_t input_len, const uint8_t* input, int64_t output_len,
+      uint8_t* output, int64_t* bytes_read, int64_t* bytes_written) = 0;
+
+  /// \brief Write out the data retained so far, so that it can be
+  /// decompressed without the rest of the stream
+  ///
+  /// If should_retry is true on return, call again with more output space.
+  virtual Status Flush(int64_t output_len, uint8_t* output, int64_t* bytes_written,
+      bool* should_retry) = 0;
+
+  /// \brief Write out the retained data and the end of stream marker
+  ///
+  /// If should_retry is true on return, call again with more output space.
+  /// No other method may be called afterwards.
+  virtual Status End(int64_t output_len, uint8_t* output, int64_t* bytes_written,
+      bool* should_retry) = 0;
+};
+
+/// \brief Incremental decompressor of a single compressed stream
+class ARROW_EXPORT Decompressor {
+ public:
+  virtual ~Decompressor();
+
+  /// \brief Decompress some of the input
+  ///
+  /// If need_more_output is true on return, the output buffer is too small to
+  /// make progress and a larger one should be supplied.
+  virtual Status Decompress(int64_t input_len, const uint8_t* input, int64_t output_len,
+      uint8_t* output, int64_t* bytes_read, int64_t* bytes_written,
+      bool* need_more_output) = 0;
+
+  /// \brief Whether the end of the compressed stream has been reached
+  virtual bool IsFinished() = 0;
+};
+
 class ARROW_EXPORT Codec {
  public:
   virtual ~Codec();
 
   static Status Create(Compression::type codec, std::unique_ptr<Codec>* out);
 
+  /// \brief Create a codec compressing at the given level, higher levels
+  /// trading speed for compression ratio
+  ///
+  /// The valid levels depend on the codec: 0 to 9 for GZIP, 0 to 11 for
+  /// BROTLI, 1 to 22 for ZSTD, and 1 to 12 for LZ4, levels from 3 on using
+  /// LZ4 HC. SNAPPY only has its default level
+  ///
+  /// \return Status, Invalid if the level is out of range for the codec
+  static Status Create(Compression::type codec, int compression_level,
+      std::unique_ptr<Codec>* out);
+
+  /// \brief Create a streaming compressor. The codecs with a streaming format
+  /// (GZIP, BROTLI, ZSTD and LZ4, the latter writing LZ4 frames rather than
+  /// the raw blocks of Compress) support it; the others return NotImplemented
+  virtual Status MakeCompressor(std::shared_ptr<Compressor>* out);
+
+  /// \brief Create a streaming decompressor, see MakeCompressor
+  virtual Status MakeDecompressor(std::shared_ptr<Decompressor>* out);
+
+  /// \brief Decompress the whole input, which must yield exactly output_len
+  /// bytes; an IOError is returned otherwise
   virtual Status Decompress(int64_t input_len, const uint8_t* input, int64_t output_len,
       uint8_t* output_buffer) = 0;
 
@@ -0,0 +1,147 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/util/compression_adaptive.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+#include "arrow/status.h"
+
+namespace arrow {
+
+CodecSelectorOptions::CodecSelectorOptions()
+    : fast_codec(Compression::LZ4),
+      fast_compression_level(kUseDefaultCompressionLevel),
+      strong_codec(Compression::ZSTD),
+      strong_compression_level(kUseDefaultCompressionLevel),
+      min_compression_ratio(1.2),
+      min_strong_codec_gain(1.25),
+      max_entropy(7.5),
+      sample_size(16 * 1024),
+      num_samples(4) {}
+
+// Shannon entropy of the byte values, in bits per byte
+static double ByteEntropy(int64_t length, const uint8_t* data) {
+  int64_t counts[256] = {0};
+  for (int64_t i = 0; i < length; ++i) {
+    ++counts[data[i]];
+  }
+  double entropy = 0;
+  for (int64_t count : counts) {
+    if (count > 0) {
+      const double p = static_cast<double>(count) / static_cast<double>(length);
+      entropy -= p * std::log2(p);
+    }
+  }
+  return entropy;
+}
+
+CodecSelector::CodecSelector(const CodecSelectorOptions& options) : options_(options) {}
+
+Status CodecSelector::Make(
+    const CodecSelectorOptions& options, std::unique_ptr<CodecSelector>* out) {
+  if (options.sample_size <= 0 || options.num_samples <= 0) {
+    std::stringstream ss;
+    ss << "Invalid codec selector sampling: " << options.num_samples << " samples of "
+       << options.sample_size << " bytes";
+    return Status::Invalid(ss.str());
+  }
+  std::unique_ptr<CodecSelector> result(new CodecSelector(options));
+  RETURN_NOT_OK(Codec::Create(
+      options.fast_codec, options.fast_compression_level, &result->fast_codec_));
+  RETURN_NOT_OK(Codec::Create(
+      options.strong_codec, options.strong_compression_level, &result->strong_codec_));
+  *out = std::move(result);
+  return Status::OK();
+}
+
+Status CodecSelector::TrialRatio(
+    Codec* codec, const uint8_t* sample, int64_t sample_length, double* ratio) {
+  std::vector<uint8_t> compressed(codec->MaxCompressedLen(sample_length, sample));
+  int64_t compressed_length;
+  RETURN_NOT_OK(codec->Compress(sample_length, sample,
+      static_cast<int64_t>(compressed.size()), compressed.data(), &compressed_length));
+  *ratio = static_cast<double>(sample_length) /
+           static_cast<double>(std::max<int64_t>(compressed_length, 1));
+  return Status::OK();
+}
+
+Status CodecSelector::Select(int64_t length, const uint8_t* data, CodecChoice* out) {
+  out->codec = Compression::UNCOMPRESSED;
+  out->entropy = 0;
+  out->fast_ratio = 0;
+  out->strong_ratio = 0;
+
+  // Slices spread over the data, so that a buffer changing along its length
+  // is judged as a whole
+  const uint8_t* sample = data;
+  int64_t sample_length = length;
+  std::vector<uint8_t> slices;
+  if (length > options_.sample_size * options_.num_samples) {
+    const int64_t stride = length / options_.num_samples;
+    for (int i = 0; i < options_.num_samples; ++i) {
+      const uint8_t* slice = data + i * stride;
+      slices.insert(slices.end(), slice, slice + options_.sample_size);
+    }
+    sample = slices.data();
+    sample_length = static_cast<int64_t>(slices.size());
+  }
+
+  int64_t trial_bytes = 0;
+  if (sample_length > 0) {
+    out->entropy = ByteEntropy(sample_length, sample);
+    if (out->entropy <= options_.max_entropy) {
+      RETURN_NOT_OK(
+          TrialRatio(fast_codec_.get(), sample, sample_length, &out->fast_ratio));
+      trial_bytes += sample_length;
+      if (options_.strong_codec != options_.fast_codec ||
+          options_.strong_compression_level != options_.fast_compression_level) {
+        RETURN_NOT_OK(
+            TrialRatio(strong_codec_.get(), sample, sample_length, &out->strong_ratio));
+        trial_bytes += sample_length;
+      } else {
+        out->strong_ratio = out->fast_ratio;
+      }
+
+      if (out->strong_ratio >= out->fast_ratio * options_.min_strong_codec_gain &&
+          out->strong_ratio >= options_.min_compression_ratio) {
+        out->codec = options_.strong_codec;
+      } else if (out->fast_ratio >= options_.min_compression_ratio) {
+        out->codec = options_.fast_codec;
+      }
+    }
+  }
+
+  std::lock_guard<std::mutex> guard(stats_mutex_);
+  ++stats_.num_buffers[out->codec];
+  stats_.num_bytes[out->codec] += length;
+  stats_.num_trial_bytes += trial_bytes;
+  return Status::OK();
+}
+
+CodecSelectorStats CodecSelector::stats() const {
+  std::lock_guard<std::mutex> guard(stats_mutex_);
+  return stats_;
+}
+
+}  // namespace arrow
@@ -0,0 +1,120 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef ARROW_UTIL_COMPRESSION_ADAPTIVE_H
+#define ARROW_UTIL_COMPRESSION_ADAPTIVE_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "arrow/status.h"
+#include "arrow/util/compression.h"
+#include "arrow/util/visibility.h"
+
+namespace arrow {
+
+struct ARROW_EXPORT CodecSelectorOptions {
+  CodecSelectorOptions();
+
+  /// The codec favoring speed (LZ4 by default) and its level
+  Compression::type fast_codec;
+  int fast_compression_level;
+
+  /// The codec favoring compression ratio (ZSTD by default) and its level
+  Compression::type strong_codec;
+  int strong_compression_level;
+
+  /// Smallest compression ratio worth compressing for, below which data is
+  /// left uncompressed
+  double min_compression_ratio;
+
+  /// How many times better than the fast codec's the ratio of the strong
+  /// codec must be for it to be chosen. Higher values favor throughput, 1
+  /// picks the strong codec whenever it compresses better
+  double min_strong_codec_gain;
+
+  /// Entropy in bits per byte above which data is left uncompressed without
+  /// trying the codecs, at most 8
+  double max_entropy;
+
+  /// Data is sampled with num_samples slices of sample_size bytes spread over
+  /// it, or as a whole when not larger than those
+  int64_t sample_size;
+  int num_samples;
+};
+
+/// \brief The choice of a codec for some data, and the estimates leading to it
+struct ARROW_EXPORT CodecChoice {
+  /// The codec to use, Compression::UNCOMPRESSED to leave the data as is
+  Compression::type codec;
+
+  /// Byte entropy of the sample, in bits per byte
+  double entropy;
+
+  /// Compression ratios of the sample, 0 when a codec was not tried
+  double fast_ratio;
+  double strong_ratio;
+};
+
+/// \brief Counts of the choices made by a CodecSelector
+struct ARROW_EXPORT CodecSelectorStats {
+  /// Number of buffers and bytes for which each codec was chosen
+  std::map<Compression::type, int64_t> num_buffers;
+  std::map<Compression::type, int64_t> num_bytes;
+
+  /// Number of bytes compressed to try the codecs
+  int64_t num_trial_bytes = 0;
+};
+
+/// \brief Choose per buffer between leaving it uncompressed and compressing it
+/// with a fast or a strong codec, by estimating the entropy of a sample and
+/// compressing the sample with both codecs
+///
+/// Select may be called from several threads at once, provided the codecs
+/// are safe to share between threads (all but GZIP).
+class ARROW_EXPORT CodecSelector {
+ public:
+  static Status Make(
+      const CodecSelectorOptions& options, std::unique_ptr<CodecSelector>* out);
+
+  /// \brief Choose a codec for length bytes of data
+  Status Select(int64_t length, const uint8_t* data, CodecChoice* out);
+
+  /// \brief Counts of the choices made so far
+  CodecSelectorStats stats() const;
+
+  const CodecSelectorOptions& options() const { return options_; }
+
+ private:
+  explicit CodecSelector(const CodecSelectorOptions& options);
+
+  Status TrialRatio(Codec* codec, const uint8_t* sample, int64_t sample_length,
+      double* ratio);
+
+  CodecSelectorOptions options_;
+  std::unique_ptr<Codec> fast_codec_;
+  std::unique_ptr<Codec> strong_codec_;
+
+  mutable std::mutex stats_mutex_;
+  CodecSelectorStats stats_;
+};
+
+}  // namespace arrow
+
+#endif  // ARROW_UTIL_COMPRESSION_ADAPTIVE_H
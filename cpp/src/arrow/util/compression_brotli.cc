@@ -37,7 +37,8 @@ Status BrotliCodec::Decompress(
     int64_t input_len, const uint8_t* input, int64_t output_len, uint8_t* output_buffer) {
   size_t output_size = output_len;
   if (BrotliDecoderDecompress(input_len, input, &output_size, output_buffer) !=
-      BROTLI_DECODER_RESULT_SUCCESS) {
+          BROTLI_DECODER_RESULT_SUCCESS ||
+      static_cast<int64_t>(output_size) != output_len) {
     return Status::IOError("Corrupt brotli compressed data.");
   }
   return Status::OK();
@@ -50,14 +51,133 @@ int64_t BrotliCodec::MaxCompressedLen(int64_t input_len, const uint8_t* input) {
 Status BrotliCodec::Compress(int64_t input_len, const uint8_t* input,
     int64_t output_buffer_len, uint8_t* output_buffer, int64_t* output_length) {
   size_t output_len = output_buffer_len;
-  // TODO: Make quality configurable. We use 8 as a default as it is the best
-  //       trade-off for Parquet workload
-  if (BrotliEncoderCompress(8, BROTLI_DEFAULT_WINDOW, BROTLI_DEFAULT_MODE, input_len,
-          input, &output_len, output_buffer) == BROTLI_FALSE) {
+  if (BrotliEncoderCompress(compression_level_, BROTLI_DEFAULT_WINDOW,
+          BROTLI_DEFAULT_MODE, input_len, input, &output_len,
+          output_buffer) == BROTLI_FALSE) {
     return Status::IOError("Brotli compression failure.");
   }
   *output_length = output_len;
   return Status::OK();
 }
 
+// ----------------------------------------------------------------------
+// Brotli streaming implementation
+
+class BrotliCompressor : public Compressor {
+ public:
+  BrotliCompressor() : state_(nullptr) {}
+
+  ~BrotliCompressor() override {
+    if (state_ != nullptr) { BrotliEncoderDestroyInstance(state_); }
+  }
+
+  Status Init(int compression_level) {
+    state_ = BrotliEncoderCreateInstance(nullptr, nullptr, nullptr);
+    if (state_ == nullptr) { return Status::IOError("Brotli init failed"); }
+    if (!BrotliEncoderSetParameter(state_, BROTLI_PARAM_QUALITY, compression_level)) {
+      return Status::IOError("Brotli set quality failed");
+    }
+    return Status::OK();
+  }
+
+  Status Compress(int64_t input_len, const uint8_t* input, int64_t output_len,
+      uint8_t* output, int64_t* bytes_read, int64_t* bytes_written) override {
+    size_t avail_in = static_cast<size_t>(input_len);
+    size_t avail_out = static_cast<size_t>(output_len);
+    if (!BrotliEncoderCompressStream(state_, BROTLI_OPERATION_PROCESS, &avail_in,
+            &input, &avail_out, &output, nullptr)) {
+      return Status::IOError("Brotli compress failed");
+    }
+    *bytes_read = input_len - static_cast<int64_t>(avail_in);
+    *bytes_written = output_len - static_cast<int64_t>(avail_out);
+    return Status::OK();
+  }
+
+  Status Flush(int64_t output_len, uint8_t* output, int64_t* bytes_written,
+      bool* should_retry) override {
+    return Finish(BROTLI_OPERATION_FLUSH, output_len, output, bytes_written,
+        should_retry);
+  }
+
+  Status End(int64_t output_len, uint8_t* output, int64_t* bytes_written,
+      bool* should_retry) override {
+    RETURN_NOT_OK(Finish(BROTLI_OPERATION_FINISH, output_len, output, bytes_written,
+        should_retry));
+    *should_retry = !BrotliEncoderIsFinished(state_);
+    return Status::OK();
+  }
+
+ private:
+  Status Finish(BrotliEncoderOperation op, int64_t output_len, uint8_t* output,
+      int64_t* bytes_written, bool* should_retry) {
+    size_t avail_in = 0;
+    const uint8_t* next_in = nullptr;
+    size_t avail_out = static_cast<size_t>(output_len);
+    if (!BrotliEncoderCompressStream(
+            state_, op, &avail_in, &next_in, &avail_out, &output, nullptr)) {
+      return Status::IOError("Brotli flush failed");
+    }
+    *bytes_written = output_len - static_cast<int64_t>(avail_out);
+    *should_retry = !!BrotliEncoderHasMoreOutput(state_);
+    return Status::OK();
+  }
+
+  BrotliEncoderState* state_;
+};
+
+class BrotliDecompressor : public Decompressor {
+ public:
+  BrotliDecompressor() : state_(nullptr), finished_(false) {}
+
+  ~BrotliDecompressor() override {
+    if (state_ != nullptr) { BrotliDecoderDestroyInstance(state_); }
+  }
+
+  Status Init() {
+    state_ = BrotliDecoderCreateInstance(nullptr, nullptr, nullptr);
+    if (state_ == nullptr) { return Status::IOError("Brotli init failed"); }
+    return Status::OK();
+  }
+
+  Status Decompress(int64_t input_len, const uint8_t* input, int64_t output_len,
+      uint8_t* output, int64_t* bytes_read, int64_t* bytes_written,
+      bool* need_more_output) override {
+    size_t avail_in = static_cast<size_t>(input_len);
+    size_t avail_out = static_cast<size_t>(output_len);
+    BrotliDecoderResult ret = BrotliDecoderDecompressStream(
+        state_, &avail_in, &input, &avail_out, &output, nullptr);
+    if (ret == BROTLI_DECODER_RESULT_ERROR) {
+      std::stringstream ss;
+      ss << "Brotli decompress failed: "
+         << BrotliDecoderErrorString(BrotliDecoderGetErrorCode(state_));
+      return Status::IOError(ss.str());
+    }
+    finished_ = ret == BROTLI_DECODER_RESULT_SUCCESS;
+    *bytes_read = input_len - static_cast<int64_t>(avail_in);
+    *bytes_written = output_len - static_cast<int64_t>(avail_out);
+    *need_more_output = ret == BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT;
+    return Status::OK();
+  }
+
+  bool IsFinished() override { return finished_; }
+
+ private:
+  BrotliDecoderState* state_;
+  bool finished_;
+};
+
+Status BrotliCodec::MakeCompressor(std::shared_ptr<Compressor>* out) {
+  auto result = std::make_shared<BrotliCompressor>();
+  RETURN_NOT_OK(result->Init(compression_level_));
+  *out = result;
+  return Status::OK();
+}
+
+Status BrotliCodec::MakeDecompressor(std::shared_ptr<Decompressor>* out) {
+  auto result = std::make_shared<BrotliDecompressor>();
+  RETURN_NOT_OK(result->Init());
+  *out = result;
+  return Status::OK();
+}
+
 }  // namespace arrow
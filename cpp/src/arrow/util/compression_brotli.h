@@ -26,9 +26,17 @@
 
 namespace arrow {
 
+constexpr int kBrotliMinCompressionLevel = 0;
+constexpr int kBrotliMaxCompressionLevel = 11;
+// The best trade-off for Parquet workloads
+constexpr int kBrotliDefaultCompressionLevel = 8;
+
 // Brotli codec.
 class ARROW_EXPORT BrotliCodec : public Codec {
  public:
+  explicit BrotliCodec(int compression_level = kBrotliDefaultCompressionLevel)
+      : compression_level_(compression_level) {}
+
   Status Decompress(int64_t input_len, const uint8_t* input, int64_t output_len,
       uint8_t* output_buffer) override;
 
@@ -37,7 +45,14 @@ class ARROW_EXPORT BrotliCodec : public Codec {
 
   int64_t MaxCompressedLen(int64_t input_len, const uint8_t* input) override;
 
+  Status MakeCompressor(std::shared_ptr<Compressor>* out) override;
+
+  Status MakeDecompressor(std::shared_ptr<Decompressor>* out) override;
+
   const char* name() const override { return "brotli"; }
+
+ private:
+  int compression_level_;
 };
 
 }  // namespace arrow
@@ -18,11 +18,14 @@
 #include "arrow/util/compression_lz4.h"
 
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <sstream>
 #include <string>
 
 #include <lz4.h>
+#include <lz4frame.h>
+#include <lz4hc.h>
 
 #include "arrow/status.h"
 #include "arrow/util/logging.h"
@@ -37,7 +40,9 @@ Status Lz4Codec::Decompress(
   int64_t decompressed_size = LZ4_decompress_safe(reinterpret_cast<const char*>(input),
       reinterpret_cast<char*>(output_buffer), static_cast<int>(input_len),
       static_cast<int>(output_len));
-  if (decompressed_size < 1) { return Status::IOError("Corrupt Lz4 compressed data."); }
+  if (decompressed_size < 0 || decompressed_size != output_len) {
+    return Status::IOError("Corrupt Lz4 compressed data.");
+  }
   return Status::OK();
 }
 
@@ -47,11 +52,166 @@ int64_t Lz4Codec::MaxCompressedLen(int64_t input_len, const uint8_t* input) {
 
 Status Lz4Codec::Compress(int64_t input_len, const uint8_t* input,
     int64_t output_buffer_len, uint8_t* output_buffer, int64_t* output_length) {
-  *output_length = LZ4_compress_default(reinterpret_cast<const char*>(input),
-      reinterpret_cast<char*>(output_buffer), static_cast<int>(input_len),
-      static_cast<int>(output_buffer_len));
+  if (compression_level_ >= LZ4HC_CLEVEL_MIN) {
+    *output_length = LZ4_compress_HC(reinterpret_cast<const char*>(input),
+        reinterpret_cast<char*>(output_buffer), static_cast<int>(input_len),
+        static_cast<int>(output_buffer_len), compression_level_);
+  } else {
+    *output_length = LZ4_compress_default(reinterpret_cast<const char*>(input),
+        reinterpret_cast<char*>(output_buffer), static_cast<int>(input_len),
+        static_cast<int>(output_buffer_len));
+  }
   if (*output_length < 1) { return Status::IOError("Lz4 compression failure."); }
   return Status::OK();
 }
 
+// ----------------------------------------------------------------------
+// Lz4 streaming implementation, in the LZ4 frame format
+
+static Status LZ4Error(LZ4F_errorCode_t ret, const char* prefix_msg) {
+  std::stringstream ss;
+  ss << prefix_msg << LZ4F_getErrorName(ret);
+  return Status::IOError(ss.str());
+}
+
+class Lz4Compressor : public Compressor {
+ public:
+  explicit Lz4Compressor(int compression_level) : ctx_(nullptr), first_time_(true) {
+    memset(&prefs_, 0, sizeof(prefs_));
+    prefs_.compressionLevel = compression_level;
+  }
+
+  ~Lz4Compressor() override {
+    if (ctx_ != nullptr) { LZ4F_freeCompressionContext(ctx_); }
+  }
+
+  Status Init() {
+    LZ4F_errorCode_t ret = LZ4F_createCompressionContext(&ctx_, LZ4F_VERSION);
+    if (LZ4F_isError(ret)) { return LZ4Error(ret, "LZ4 init failed: "); }
+    return Status::OK();
+  }
+
+  Status Compress(int64_t input_len, const uint8_t* input, int64_t output_len,
+      uint8_t* output, int64_t* bytes_read, int64_t* bytes_written) override {
+    *bytes_read = 0;
+    *bytes_written = 0;
+    RETURN_NOT_OK(WriteHeader(&output_len, &output, bytes_written));
+    if (first_time_) { return Status::OK(); }
+
+    // LZ4F_compressUpdate needs room for the worst case of the data it
+    // buffers plus the input, so only hand it as much input as fits
+    size_t input_size = static_cast<size_t>(input_len);
+    while (input_size > 0 &&
+           LZ4F_compressBound(input_size, &prefs_) > static_cast<size_t>(output_len)) {
+      input_size /= 2;
+    }
+    if (input_size == 0) { return Status::OK(); }
+
+    size_t ret = LZ4F_compressUpdate(
+        ctx_, output, static_cast<size_t>(output_len), input, input_size, nullptr);
+    if (LZ4F_isError(ret)) { return LZ4Error(ret, "LZ4 compress update failed: "); }
+    *bytes_read = static_cast<int64_t>(input_size);
+    *bytes_written += static_cast<int64_t>(ret);
+    return Status::OK();
+  }
+
+  Status Flush(int64_t output_len, uint8_t* output, int64_t* bytes_written,
+      bool* should_retry) override {
+    return Finish(false, output_len, output, bytes_written, should_retry);
+  }
+
+  Status End(int64_t output_len, uint8_t* output, int64_t* bytes_written,
+      bool* should_retry) override {
+    return Finish(true, output_len, output, bytes_written, should_retry);
+  }
+
+ private:
+  // The frame header is written before anything else
+  Status WriteHeader(int64_t* output_len, uint8_t** output, int64_t* bytes_written) {
+    if (!first_time_ || *output_len < LZ4F_HEADER_SIZE_MAX) { return Status::OK(); }
+    size_t ret = LZ4F_compressBegin(
+        ctx_, *output, static_cast<size_t>(*output_len), &prefs_);
+    if (LZ4F_isError(ret)) { return LZ4Error(ret, "LZ4 compress begin failed: "); }
+    first_time_ = false;
+    *output += ret;
+    *output_len -= static_cast<int64_t>(ret);
+    *bytes_written += static_cast<int64_t>(ret);
+    return Status::OK();
+  }
+
+  Status Finish(bool end, int64_t output_len, uint8_t* output, int64_t* bytes_written,
+      bool* should_retry) {
+    *bytes_written = 0;
+    *should_retry = true;
+    RETURN_NOT_OK(WriteHeader(&output_len, &output, bytes_written));
+    if (first_time_) { return Status::OK(); }
+
+    // Room for the buffered data and the end mark is needed
+    if (static_cast<size_t>(output_len) < LZ4F_compressBound(0, &prefs_)) {
+      return Status::OK();
+    }
+    size_t ret = end ? LZ4F_compressEnd(ctx_, output, output_len, nullptr)
+                     : LZ4F_flush(ctx_, output, output_len, nullptr);
+    if (LZ4F_isError(ret)) { return LZ4Error(ret, "LZ4 flush failed: "); }
+    *bytes_written += static_cast<int64_t>(ret);
+    *should_retry = false;
+    return Status::OK();
+  }
+
+  LZ4F_compressionContext_t ctx_;
+  LZ4F_preferences_t prefs_;
+  bool first_time_;
+};
+
+class Lz4Decompressor : public Decompressor {
+ public:
+  Lz4Decompressor() : ctx_(nullptr), finished_(false) {}
+
+  ~Lz4Decompressor() override {
+    if (ctx_ != nullptr) { LZ4F_freeDecompressionContext(ctx_); }
+  }
+
+  Status Init() {
+    LZ4F_errorCode_t ret = LZ4F_createDecompressionContext(&ctx_, LZ4F_VERSION);
+    if (LZ4F_isError(ret)) { return LZ4Error(ret, "LZ4 init failed: "); }
+    return Status::OK();
+  }
+
+  Status Decompress(int64_t input_len, const uint8_t* input, int64_t output_len,
+      uint8_t* output, int64_t* bytes_read, int64_t* bytes_written,
+      bool* need_more_output) override {
+    size_t src_size = static_cast<size_t>(input_len);
+    size_t dst_size = static_cast<size_t>(output_len);
+
+    // The return value is 0 once a frame is completely decoded and flushed
+    size_t ret = LZ4F_decompress(ctx_, output, &dst_size, input, &src_size, nullptr);
+    if (LZ4F_isError(ret)) { return LZ4Error(ret, "LZ4 decompress failed: "); }
+    finished_ = ret == 0;
+    *bytes_read = static_cast<int64_t>(src_size);
+    *bytes_written = static_cast<int64_t>(dst_size);
+    *need_more_output = !finished_ && *bytes_written == output_len;
+    return Status::OK();
+  }
+
+  bool IsFinished() override { return finished_; }
+
+ private:
+  LZ4F_decompressionContext_t ctx_;
+  bool finished_;
+};
+
+Status Lz4Codec::MakeCompressor(std::shared_ptr<Compressor>* out) {
+  auto result = std::make_shared<Lz4Compressor>(compression_level_);
+  RETURN_NOT_OK(result->Init());
+  *out = result;
+  return Status::OK();
+}
+
+Status Lz4Codec::MakeDecompressor(std::shared_ptr<Decompressor>* out) {
+  auto result = std::make_shared<Lz4Decompressor>();
+  RETURN_NOT_OK(result->Init());
+  *out = result;
+  return Status::OK();
+}
+
 }  // namespace arrow
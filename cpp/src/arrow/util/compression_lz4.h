@@ -26,9 +26,17 @@
 
 namespace arrow {
 
-// Lz4 codec.
+constexpr int kLz4MinCompressionLevel = 1;
+constexpr int kLz4MaxCompressionLevel = 12;
+constexpr int kLz4DefaultCompressionLevel = 1;
+
+// Lz4 codec. Levels from 3 on compress with LZ4 HC, whose output decompresses
+// as fast
 class ARROW_EXPORT Lz4Codec : public Codec {
  public:
+  explicit Lz4Codec(int compression_level = kLz4DefaultCompressionLevel)
+      : compression_level_(compression_level) {}
+
   Status Decompress(int64_t input_len, const uint8_t* input, int64_t output_len,
       uint8_t* output_buffer) override;
 
@@ -37,7 +45,14 @@ class ARROW_EXPORT Lz4Codec : public Codec {
 
   int64_t MaxCompressedLen(int64_t input_len, const uint8_t* input) override;
 
+  Status MakeCompressor(std::shared_ptr<Compressor>* out) override;
+
+  Status MakeDecompressor(std::shared_ptr<Decompressor>* out) override;
+
   const char* name() const override { return "lz4"; }
+
+ private:
+  int compression_level_;
 };
 
 }  // namespace arrow
@@ -0,0 +1,366 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/util/compression_parallel.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "arrow/buffer.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/util/parallel.h"
+
+namespace arrow {
+
+// ----------------------------------------------------------------------
+// Block index
+
+static constexpr int64_t kUncompressedBlockMarker = -1;
+
+// Rounded up without adding to length, which may be as large as a corrupt
+// index makes it
+static int64_t NumBlocks(int64_t length, int64_t block_size) {
+  return length / block_size + (length % block_size != 0);
+}
+
+static int64_t IndexLength(int64_t num_blocks) {
+  return static_cast<int64_t>(sizeof(int64_t)) * (2 + num_blocks);
+}
+
+static int64_t ReadInt64(const uint8_t* data) {
+  int64_t value;
+  memcpy(&value, data, sizeof(int64_t));
+  return value;
+}
+
+namespace {
+
+// The index at the start of compressed data, see ParallelBlockCodec
+struct BlockIndex {
+  int64_t uncompressed_length;
+  int64_t block_size;
+  // Where the stored bytes of each block start in the compressed data, and
+  // their length, kUncompressedBlockMarker if stored as is
+  std::vector<int64_t> offsets;
+  std::vector<int64_t> stored_lengths;
+
+  int64_t num_blocks() const { return static_cast<int64_t>(offsets.size()); }
+
+  int64_t block_length(int64_t i) const {
+    return std::min(block_size, uncompressed_length - i * block_size);
+  }
+};
+
+}  // namespace
+
+static Status ReadIndexHeader(int64_t input_len, const uint8_t* input,
+    int64_t* uncompressed_length, int64_t* block_size) {
+  if (input_len < IndexLength(0)) {
+    return Status::IOError("Compressed data is too short for its block index");
+  }
+  *uncompressed_length = ReadInt64(input);
+  *block_size = ReadInt64(input + sizeof(int64_t));
+  if (*uncompressed_length < 0 || *block_size <= 0) {
+    return Status::IOError("Corrupt block index in compressed data");
+  }
+  return Status::OK();
+}
+
+static Status ReadIndex(int64_t input_len, const uint8_t* input, BlockIndex* out) {
+  RETURN_NOT_OK(
+      ReadIndexHeader(input_len, input, &out->uncompressed_length, &out->block_size));
+  // Every block has an entry in the index, which bounds their number before
+  // anything is sized after it
+  const int64_t num_blocks = NumBlocks(out->uncompressed_length, out->block_size);
+  if (num_blocks > (input_len - IndexLength(0)) / static_cast<int64_t>(sizeof(int64_t))) {
+    return Status::IOError("Compressed data is too short for its block index");
+  }
+  out->offsets.resize(num_blocks);
+  out->stored_lengths.resize(num_blocks);
+
+  int64_t offset = IndexLength(num_blocks);
+  for (int64_t i = 0; i < num_blocks; ++i) {
+    const int64_t stored_length = ReadInt64(input + IndexLength(i));
+    const int64_t length = stored_length == kUncompressedBlockMarker
+                               ? out->block_length(i)
+                               : stored_length;
+    if (length < 0 || length > input_len - offset) {
+      return Status::IOError("Corrupt block index in compressed data");
+    }
+    out->offsets[i] = offset;
+    out->stored_lengths[i] = stored_length;
+    offset += length;
+  }
+  return Status::OK();
+}
+
+// ----------------------------------------------------------------------
+// ParallelBlockCodec implementation
+
+class ParallelBlockCodec::ParallelBlockCodecImpl {
+ public:
+  ParallelBlockCodecImpl(Compression::type codec, int compression_level,
+      int64_t block_size, int num_threads)
+      : codec_(codec),
+        compression_level_(compression_level),
+        block_size_(block_size),
+        num_threads_(num_threads) {}
+
+  Status Init() {
+    RETURN_NOT_OK(TakeCodec(&bound_codec_));
+    name_ = std::string("parallel-") + bound_codec_->name();
+    return Status::OK();
+  }
+
+  Status Decompress(int64_t input_len, const uint8_t* input, int64_t output_len,
+      uint8_t* output_buffer) {
+    BlockIndex index;
+    RETURN_NOT_OK(ReadIndex(input_len, input, &index));
+    if (index.uncompressed_length != output_len) {
+      std::stringstream ss;
+      ss << "Expected " << output_len << " bytes of decompressed data, the index gives "
+         << index.uncompressed_length;
+      return Status::IOError(ss.str());
+    }
+    return ParallelFor(num_threads_, index.num_blocks(), [&](int64_t i) {
+      return DecompressBlock(
+          index, input, i, output_buffer + i * index.block_size, index.block_length(i));
+    });
+  }
+
+  Status DecompressRange(int64_t input_len, const uint8_t* input, int64_t offset,
+      int64_t length, uint8_t* output_buffer) {
+    BlockIndex index;
+    RETURN_NOT_OK(ReadIndex(input_len, input, &index));
+    if (offset < 0 || length < 0 || offset > index.uncompressed_length - length) {
+      std::stringstream ss;
+      ss << "Range of " << length << " bytes at " << offset
+         << " is out of bounds of the " << index.uncompressed_length
+         << " uncompressed bytes";
+      return Status::Invalid(ss.str());
+    }
+    if (length == 0) { return Status::OK(); }
+
+    const int64_t first_block = offset / index.block_size;
+    const int64_t num_blocks = (offset + length - 1) / index.block_size - first_block + 1;
+    return ParallelFor(num_threads_, num_blocks, [&](int64_t task) {
+      const int64_t i = first_block + task;
+      const int64_t block_start = i * index.block_size;
+      const int64_t block_length = index.block_length(i);
+      const int64_t start = std::max(offset, block_start);
+      const int64_t end = std::min(offset + length, block_start + block_length);
+      uint8_t* out = output_buffer + (start - offset);
+
+      if (start == block_start && end == block_start + block_length) {
+        return DecompressBlock(index, input, i, out, block_length);
+      }
+      if (index.stored_lengths[i] == kUncompressedBlockMarker) {
+        memcpy(out, input + index.offsets[i] + (start - block_start), end - start);
+        return Status::OK();
+      }
+      // Part of a block, decompressed aside
+      std::shared_ptr<MutableBuffer> block;
+      RETURN_NOT_OK(AllocateBuffer(default_memory_pool(), block_length, &block));
+      RETURN_NOT_OK(
+          DecompressBlock(index, input, i, block->mutable_data(), block_length));
+      memcpy(out, block->data() + (start - block_start), end - start);
+      return Status::OK();
+    });
+  }
+
+  Status Compress(int64_t input_len, const uint8_t* input, int64_t output_buffer_len,
+      uint8_t* output_buffer, int64_t* output_length) {
+    const int64_t num_blocks = NumBlocks(input_len, block_size_);
+    std::vector<std::shared_ptr<MutableBuffer>> blocks(num_blocks);
+    std::vector<int64_t> stored_lengths(num_blocks);
+
+    RETURN_NOT_OK(ParallelFor(num_threads_, num_blocks, [&](int64_t i) {
+      const uint8_t* block_input = input + i * block_size_;
+      const int64_t block_length = std::min(block_size_, input_len - i * block_size_);
+      std::unique_ptr<Codec> codec;
+      RETURN_NOT_OK(TakeCodec(&codec));
+      const int64_t max_length = codec->MaxCompressedLen(block_length, block_input);
+      RETURN_NOT_OK(AllocateBuffer(default_memory_pool(), max_length, &blocks[i]));
+      Status s = codec->Compress(block_length, block_input, max_length,
+          blocks[i]->mutable_data(), &stored_lengths[i]);
+      PutCodec(std::move(codec));
+      RETURN_NOT_OK(s);
+      if (stored_lengths[i] >= block_length) {
+        // Incompressible, stored as is
+        blocks[i].reset();
+        stored_lengths[i] = kUncompressedBlockMarker;
+      }
+      return Status::OK();
+    }));
+
+    int64_t length = IndexLength(num_blocks);
+    for (int64_t i = 0; i < num_blocks; ++i) {
+      length += blocks[i] ? stored_lengths[i]
+                          : std::min(block_size_, input_len - i * block_size_);
+    }
+    if (length > output_buffer_len) {
+      std::stringstream ss;
+      ss << "Output buffer of " << output_buffer_len << " bytes is too small for "
+         << length << " bytes of compressed data";
+      return Status::IOError(ss.str());
+    }
+
+    memcpy(output_buffer, &input_len, sizeof(int64_t));
+    memcpy(output_buffer + sizeof(int64_t), &block_size_, sizeof(int64_t));
+    uint8_t* out = output_buffer + IndexLength(num_blocks);
+    for (int64_t i = 0; i < num_blocks; ++i) {
+      memcpy(output_buffer + IndexLength(i), &stored_lengths[i], sizeof(int64_t));
+      if (blocks[i]) {
+        memcpy(out, blocks[i]->data(), stored_lengths[i]);
+        out += stored_lengths[i];
+      } else {
+        const int64_t block_length = std::min(block_size_, input_len - i * block_size_);
+        memcpy(out, input + i * block_size_, block_length);
+        out += block_length;
+      }
+    }
+    *output_length = length;
+    return Status::OK();
+  }
+
+  int64_t MaxCompressedLen(int64_t input_len, const uint8_t* input) {
+    const int64_t num_blocks = NumBlocks(input_len, block_size_);
+    int64_t length = IndexLength(num_blocks);
+    std::lock_guard<std::mutex> guard(bound_mutex_);
+    for (int64_t i = 0; i < num_blocks; ++i) {
+      const int64_t block_length = std::min(block_size_, input_len - i * block_size_);
+      length += std::max(block_length,
+          bound_codec_->MaxCompressedLen(block_length, input + i * block_size_));
+    }
+    return length;
+  }
+
+  const char* name() const { return name_.c_str(); }
+
+ private:
+  Status DecompressBlock(const BlockIndex& index, const uint8_t* input, int64_t i,
+      uint8_t* output, int64_t block_length) {
+    if (index.stored_lengths[i] == kUncompressedBlockMarker) {
+      memcpy(output, input + index.offsets[i], block_length);
+      return Status::OK();
+    }
+    // Decompress fails unless the block yields exactly block_length bytes
+    std::unique_ptr<Codec> codec;
+    RETURN_NOT_OK(TakeCodec(&codec));
+    Status s = codec->Decompress(
+        index.stored_lengths[i], input + index.offsets[i], block_length, output);
+    PutCodec(std::move(codec));
+    return s;
+  }
+
+  // Codecs are not all safe to share between threads, so each block is
+  // handled by a codec taken out of a pool of them
+  Status TakeCodec(std::unique_ptr<Codec>* out) {
+    {
+      std::lock_guard<std::mutex> guard(mutex_);
+      if (!codecs_.empty()) {
+        *out = std::move(codecs_.back());
+        codecs_.pop_back();
+        return Status::OK();
+      }
+    }
+    RETURN_NOT_OK(Codec::Create(codec_, compression_level_, out));
+    // UNCOMPRESSED has no codec to bind
+    if (*out == nullptr) { return Status::Invalid("No codec to compress blocks with"); }
+    return Status::OK();
+  }
+
+  void PutCodec(std::unique_ptr<Codec> codec) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    codecs_.push_back(std::move(codec));
+  }
+
+  Compression::type codec_;
+  int compression_level_;
+  int64_t block_size_;
+  int num_threads_;
+  std::string name_;
+
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<Codec>> codecs_;
+
+  // Created by Init, so that MaxCompressedLen, which cannot fail, need not
+  // create a codec
+  std::mutex bound_mutex_;
+  std::unique_ptr<Codec> bound_codec_;
+};
+
+ParallelBlockCodec::ParallelBlockCodec() {}
+
+ParallelBlockCodec::~ParallelBlockCodec() {}
+
+Status ParallelBlockCodec::Make(Compression::type codec, int compression_level,
+    int64_t block_size, int num_threads, std::unique_ptr<ParallelBlockCodec>* out) {
+  if (block_size <= 0) {
+    std::stringstream ss;
+    ss << "Invalid compression block size: " << block_size;
+    return Status::Invalid(ss.str());
+  }
+  std::unique_ptr<ParallelBlockCodec> result(new ParallelBlockCodec());
+  result->impl_.reset(
+      new ParallelBlockCodecImpl(codec, compression_level, block_size, num_threads));
+  RETURN_NOT_OK(result->impl_->Init());
+  *out = std::move(result);
+  return Status::OK();
+}
+
+Status ParallelBlockCodec::Make(
+    Compression::type codec, std::unique_ptr<ParallelBlockCodec>* out) {
+  return Make(codec, kUseDefaultCompressionLevel, kDefaultCompressionBlockSize, 0, out);
+}
+
+Status ParallelBlockCodec::Decompress(int64_t input_len, const uint8_t* input,
+    int64_t output_len, uint8_t* output_buffer) {
+  return impl_->Decompress(input_len, input, output_len, output_buffer);
+}
+
+Status ParallelBlockCodec::Compress(int64_t input_len, const uint8_t* input,
+    int64_t output_buffer_len, uint8_t* output_buffer, int64_t* output_length) {
+  return impl_->Compress(
+      input_len, input, output_buffer_len, output_buffer, output_length);
+}
+
+int64_t ParallelBlockCodec::MaxCompressedLen(int64_t input_len, const uint8_t* input) {
+  return impl_->MaxCompressedLen(input_len, input);
+}
+
+const char* ParallelBlockCodec::name() const { return impl_->name(); }
+
+Status ParallelBlockCodec::DecompressRange(int64_t input_len, const uint8_t* input,
+    int64_t offset, int64_t length, uint8_t* output_buffer) {
+  return impl_->DecompressRange(input_len, input, offset, length, output_buffer);
+}
+
+Status ParallelBlockCodec::GetUncompressedLength(
+    int64_t input_len, const uint8_t* input, int64_t* out) {
+  int64_t block_size;
+  return ReadIndexHeader(input_len, input, out, &block_size);
+}
+
+}  // namespace arrow
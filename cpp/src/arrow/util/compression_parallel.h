@@ -0,0 +1,93 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef ARROW_UTIL_COMPRESSION_PARALLEL_H
+#define ARROW_UTIL_COMPRESSION_PARALLEL_H
+
+#include <cstdint>
+#include <memory>
+
+#include "arrow/status.h"
+#include "arrow/util/compression.h"
+#include "arrow/util/visibility.h"
+
+namespace arrow {
+
+constexpr int64_t kDefaultCompressionBlockSize = 1 << 20;
+
+/// \brief Codec splitting its input into independent blocks that are
+/// compressed and decompressed on several threads with another codec
+///
+/// The compressed data starts with an index of the blocks, all integers being
+/// little-endian int64:
+///
+/// <uncompressed length> <block size> <stored length of each block> <blocks>
+///
+/// Every block but the last holds block size bytes of input. A stored length
+/// of -1 marks a block stored as is because compressing it did not make it
+/// smaller. The index also allows decompressing a range of the input alone,
+/// see DecompressRange.
+///
+/// Compress and Decompress may be called from several threads at once.
+class ARROW_EXPORT ParallelBlockCodec : public Codec {
+ public:
+  ~ParallelBlockCodec() override;
+
+  /// \brief Create a codec
+  ///
+  /// \param[in] codec the codec compressing each block
+  /// \param[in] compression_level its level, see Codec::Create
+  /// \param[in] block_size the number of input bytes in a block
+  /// \param[in] num_threads the maximum number of threads to use, 0 meaning
+  /// one per hardware thread
+  /// \param[out] out the created codec
+  static Status Make(Compression::type codec, int compression_level,
+      int64_t block_size, int num_threads, std::unique_ptr<ParallelBlockCodec>* out);
+
+  static Status Make(Compression::type codec, std::unique_ptr<ParallelBlockCodec>* out);
+
+  Status Decompress(int64_t input_len, const uint8_t* input, int64_t output_len,
+      uint8_t* output_buffer) override;
+
+  Status Compress(int64_t input_len, const uint8_t* input, int64_t output_buffer_len,
+      uint8_t* output_buffer, int64_t* output_length) override;
+
+  int64_t MaxCompressedLen(int64_t input_len, const uint8_t* input) override;
+
+  const char* name() const override;
+
+  /// \brief Decompress the length bytes of the original input starting at
+  /// offset, decompressing only the blocks that overlap them
+  ///
+  /// \return Status, Invalid if the range is out of bounds
+  Status DecompressRange(int64_t input_len, const uint8_t* input, int64_t offset,
+      int64_t length, uint8_t* output_buffer);
+
+  /// \brief Read the uncompressed length from the index of compressed data
+  static Status GetUncompressedLength(
+      int64_t input_len, const uint8_t* input, int64_t* out);
+
+ private:
+  ParallelBlockCodec();
+
+  class ParallelBlockCodecImpl;
+  std::unique_ptr<ParallelBlockCodecImpl> impl_;
+};
+
+}  // namespace arrow
+
+#endif  // ARROW_UTIL_COMPRESSION_PARALLEL_H
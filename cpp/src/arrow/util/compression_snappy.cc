@@ -39,6 +39,13 @@ namespace arrow {
 
 Status SnappyCodec::Decompress(
     int64_t input_len, const uint8_t* input, int64_t output_len, uint8_t* output_buffer) {
+  // RawUncompress writes as many bytes as the input header says
+  size_t decompressed_size;
+  if (!snappy::GetUncompressedLength(reinterpret_cast<const char*>(input),
+          static_cast<size_t>(input_len), &decompressed_size) ||
+      static_cast<int64_t>(decompressed_size) != output_len) {
+    return Status::IOError("Corrupt snappy compressed data.");
+  }
   if (!snappy::RawUncompress(reinterpret_cast<const char*>(input),
           static_cast<size_t>(input_len), reinterpret_cast<char*>(output_buffer))) {
     return Status::IOError("Corrupt snappy compressed data.");
@@ -17,7 +17,10 @@
 
 #include "arrow/util/compression_zlib.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -44,10 +47,165 @@ static constexpr int GZIP_CODEC = 16;
 // Determine if this is libz or gzip from header.
 static constexpr int DETECT_CODEC = 32;
 
+static int CompressionWindowBitsForFormat(GZipCodec::Format format) {
+  int window_bits = WINDOW_BITS;
+  if (format == GZipCodec::DEFLATE) {
+    window_bits = -window_bits;
+  } else if (format == GZipCodec::GZIP) {
+    window_bits += GZIP_CODEC;
+  }
+  return window_bits;
+}
+
+static int DecompressionWindowBitsForFormat(GZipCodec::Format format) {
+  // Either deflate or autodetected zlib/gzip
+  return format == GZipCodec::DEFLATE ? -WINDOW_BITS : WINDOW_BITS | DETECT_CODEC;
+}
+
+static Status ZlibError(const z_stream& stream, const char* prefix_msg) {
+  std::stringstream ss;
+  ss << prefix_msg;
+  if (stream.msg != NULL) { ss << stream.msg; }
+  return Status::IOError(ss.str());
+}
+
+// zlib takes lengths as uInt; larger inputs and outputs are processed over
+// several calls
+static uInt ClampLength(int64_t length) {
+  return static_cast<uInt>(
+      std::min<int64_t>(length, std::numeric_limits<uInt>::max()));
+}
+
+// ----------------------------------------------------------------------
+// gzip streaming implementation
+
+class GZipCompressor : public Compressor {
+ public:
+  GZipCompressor() : initialized_(false) {}
+
+  ~GZipCompressor() override {
+    if (initialized_) { (void)deflateEnd(&stream_); }
+  }
+
+  Status Init(GZipCodec::Format format, int compression_level) {
+    memset(&stream_, 0, sizeof(stream_));
+    if (deflateInit2(&stream_, compression_level, Z_DEFLATED,
+            CompressionWindowBitsForFormat(format), 9, Z_DEFAULT_STRATEGY) != Z_OK) {
+      return ZlibError(stream_, "zlib deflateInit failed: ");
+    }
+    initialized_ = true;
+    return Status::OK();
+  }
+
+  Status Compress(int64_t input_len, const uint8_t* input, int64_t output_len,
+      uint8_t* output, int64_t* bytes_read, int64_t* bytes_written) override {
+    const uInt input_size = ClampLength(input_len);
+    const uInt output_size = ClampLength(output_len);
+    stream_.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(input));
+    stream_.avail_in = input_size;
+    stream_.next_out = reinterpret_cast<Bytef*>(output);
+    stream_.avail_out = output_size;
+
+    // Z_BUF_ERROR only means that no progress was possible
+    int ret = deflate(&stream_, Z_NO_FLUSH);
+    if (ret != Z_OK && ret != Z_BUF_ERROR) {
+      return ZlibError(stream_, "zlib deflate failed: ");
+    }
+    *bytes_read = input_size - stream_.avail_in;
+    *bytes_written = output_size - stream_.avail_out;
+    return Status::OK();
+  }
+
+  Status Flush(int64_t output_len, uint8_t* output, int64_t* bytes_written,
+      bool* should_retry) override {
+    const uInt output_size = ClampLength(output_len);
+    stream_.avail_in = 0;
+    stream_.next_out = reinterpret_cast<Bytef*>(output);
+    stream_.avail_out = output_size;
+
+    int ret = deflate(&stream_, Z_SYNC_FLUSH);
+    if (ret != Z_OK && ret != Z_BUF_ERROR) {
+      return ZlibError(stream_, "zlib flush failed: ");
+    }
+    *bytes_written = output_size - stream_.avail_out;
+    // The flush is complete when deflate leaves output space unused
+    *should_retry = stream_.avail_out == 0;
+    return Status::OK();
+  }
+
+  Status End(int64_t output_len, uint8_t* output, int64_t* bytes_written,
+      bool* should_retry) override {
+    const uInt output_size = ClampLength(output_len);
+    stream_.avail_in = 0;
+    stream_.next_out = reinterpret_cast<Bytef*>(output);
+    stream_.avail_out = output_size;
+
+    int ret = deflate(&stream_, Z_FINISH);
+    if (ret != Z_STREAM_END && ret != Z_OK && ret != Z_BUF_ERROR) {
+      return ZlibError(stream_, "zlib end failed: ");
+    }
+    *bytes_written = output_size - stream_.avail_out;
+    *should_retry = ret != Z_STREAM_END;
+    return Status::OK();
+  }
+
+ private:
+  z_stream stream_;
+  bool initialized_;
+};
+
+class GZipDecompressor : public Decompressor {
+ public:
+  GZipDecompressor() : initialized_(false), finished_(false) {}
+
+  ~GZipDecompressor() override {
+    if (initialized_) { (void)inflateEnd(&stream_); }
+  }
+
+  Status Init(GZipCodec::Format format) {
+    memset(&stream_, 0, sizeof(stream_));
+    if (inflateInit2(&stream_, DecompressionWindowBitsForFormat(format)) != Z_OK) {
+      return ZlibError(stream_, "zlib inflateInit failed: ");
+    }
+    initialized_ = true;
+    return Status::OK();
+  }
+
+  Status Decompress(int64_t input_len, const uint8_t* input, int64_t output_len,
+      uint8_t* output, int64_t* bytes_read, int64_t* bytes_written,
+      bool* need_more_output) override {
+    const uInt input_size = ClampLength(input_len);
+    const uInt output_size = ClampLength(output_len);
+    stream_.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(input));
+    stream_.avail_in = input_size;
+    stream_.next_out = reinterpret_cast<Bytef*>(output);
+    stream_.avail_out = output_size;
+
+    // Z_BUF_ERROR only means that no progress was possible
+    int ret = inflate(&stream_, Z_SYNC_FLUSH);
+    if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+      return ZlibError(stream_, "zlib inflate failed: ");
+    }
+    finished_ = ret == Z_STREAM_END;
+    *bytes_read = input_size - stream_.avail_in;
+    *bytes_written = output_size - stream_.avail_out;
+    *need_more_output = !finished_ && stream_.avail_out == 0;
+    return Status::OK();
+  }
+
+  bool IsFinished() override { return finished_; }
+
+ private:
+  z_stream stream_;
+  bool initialized_;
+  bool finished_;
+};
+
 class GZipCodec::GZipCodecImpl {
  public:
-  explicit GZipCodecImpl(GZipCodec::Format format)
+  GZipCodecImpl(GZipCodec::Format format, int compression_level)
       : format_(format),
+        compression_level_(compression_level),
         compressor_initialized_(false),
         decompressor_initialized_(false) {}
 
@@ -62,13 +220,8 @@ class GZipCodec::GZipCodecImpl {
 
     int ret;
     // Initialize to run specified format
-    int window_bits = WINDOW_BITS;
-    if (format_ == DEFLATE) {
-      window_bits = -window_bits;
-    } else if (format_ == GZIP) {
-      window_bits += GZIP_CODEC;
-    }
-    if ((ret = deflateInit2(&stream_, Z_DEFAULT_COMPRESSION, Z_DEFLATED, window_bits, 9,
+    int window_bits = CompressionWindowBitsForFormat(format_);
+    if ((ret = deflateInit2(&stream_, compression_level_, Z_DEFLATED, window_bits, 9,
              Z_DEFAULT_STRATEGY)) != Z_OK) {
       std::stringstream ss;
       ss << "zlib deflateInit failed: " << std::string(stream_.msg);
@@ -88,8 +241,7 @@ class GZipCodec::GZipCodecImpl {
     memset(&stream_, 0, sizeof(stream_));
     int ret;
 
-    // Initialize to run either deflate or zlib/gzip format
-    int window_bits = format_ == DEFLATE ? -WINDOW_BITS : WINDOW_BITS | DETECT_CODEC;
+    int window_bits = DecompressionWindowBitsForFormat(format_);
     if ((ret = inflateInit2(&stream_, window_bits)) != Z_OK) {
       std::stringstream ss;
       ss << "zlib inflateInit failed: " << std::string(stream_.msg);
@@ -154,6 +306,23 @@ class GZipCodec::GZipCodecImpl {
       if (stream_.msg != NULL) ss << stream_.msg;
       return Status::IOError(ss.str());
     }
+    if (static_cast<int64_t>(stream_.total_out) != output_length) {
+      return Status::IOError("GZipCodec failed: compressed data is too short");
+    }
+    return Status::OK();
+  }
+
+  Status MakeCompressor(std::shared_ptr<Compressor>* out) {
+    auto result = std::make_shared<GZipCompressor>();
+    RETURN_NOT_OK(result->Init(format_, compression_level_));
+    *out = result;
+    return Status::OK();
+  }
+
+  Status MakeDecompressor(std::shared_ptr<Decompressor>* out) {
+    auto result = std::make_shared<GZipDecompressor>();
+    RETURN_NOT_OK(result->Init(format_));
+    *out = result;
     return Status::OK();
   }
 
@@ -207,6 +376,8 @@ class GZipCodec::GZipCodecImpl {
   // configure
   GZipCodec::Format format_;
 
+  int compression_level_;
+
   // These variables are mutually exclusive. When the codec is in "compressor"
   // state, compressor_initialized_ is true while decompressor_initialized_ is
   // false. When it's decompressing, the opposite is true.
@@ -218,8 +389,8 @@ class GZipCodec::GZipCodecImpl {
   bool decompressor_initialized_;
 };
 
-GZipCodec::GZipCodec(Format format) {
-  impl_.reset(new GZipCodecImpl(format));
+GZipCodec::GZipCodec(Format format, int compression_level) {
+  impl_.reset(new GZipCodecImpl(format, compression_level));
 }
 
 GZipCodec::~GZipCodec() {}
@@ -238,6 +409,14 @@ Status GZipCodec::Compress(int64_t input_length, const uint8_t* input,
   return impl_->Compress(input_length, input, output_buffer_len, output, output_length);
 }
 
+Status GZipCodec::MakeCompressor(std::shared_ptr<Compressor>* out) {
+  return impl_->MakeCompressor(out);
+}
+
+Status GZipCodec::MakeDecompressor(std::shared_ptr<Decompressor>* out) {
+  return impl_->MakeDecompressor(out);
+}
+
 const char* GZipCodec::name() const {
   return "gzip";
 }
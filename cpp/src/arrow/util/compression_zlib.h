@@ -26,6 +26,11 @@
 
 namespace arrow {
 
+constexpr int kGZipMinCompressionLevel = 0;
+constexpr int kGZipMaxCompressionLevel = 9;
+// The level zlib itself defaults to
+constexpr int kGZipDefaultCompressionLevel = 6;
+
 // GZip codec.
 class ARROW_EXPORT GZipCodec : public Codec {
  public:
@@ -36,7 +41,8 @@ class ARROW_EXPORT GZipCodec : public Codec {
     GZIP,
   };
 
-  explicit GZipCodec(Format format = GZIP);
+  explicit GZipCodec(
+      Format format = GZIP, int compression_level = kGZipDefaultCompressionLevel);
   virtual ~GZipCodec();
 
   Status Decompress(int64_t input_len, const uint8_t* input, int64_t output_len,
@@ -47,6 +53,10 @@ class ARROW_EXPORT GZipCodec : public Codec {
 
   int64_t MaxCompressedLen(int64_t input_len, const uint8_t* input) override;
 
+  Status MakeCompressor(std::shared_ptr<Compressor>* out) override;
+
+  Status MakeDecompressor(std::shared_ptr<Decompressor>* out) override;
+
   const char* name() const override;
 
  private:
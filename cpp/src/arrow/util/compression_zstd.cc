@@ -19,11 +19,16 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <vector>
 
+#include <zdict.h>
 #include <zstd.h>
 
+#include "arrow/buffer.h"
+#include "arrow/memory_pool.h"
 #include "arrow/status.h"
 #include "arrow/util/logging.h"
 
@@ -32,14 +37,125 @@ namespace arrow {
 // ----------------------------------------------------------------------
 // ZSTD implementation
 
+// Contexts kept for reuse. Taking a context out of the pool for each call,
+// rather than sharing one, lets several threads use the codec at once
+template <typename Context, size_t (*FreeContext)(Context*)>
+class ContextPool {
+ public:
+  ~ContextPool() {
+    for (Context* context : contexts_) {
+      FreeContext(context);
+    }
+  }
+
+  // Return nullptr if no context is available
+  Context* Take() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (contexts_.empty()) { return nullptr; }
+    Context* context = contexts_.back();
+    contexts_.pop_back();
+    return context;
+  }
+
+  void Put(Context* context) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    contexts_.push_back(context);
+  }
+
+ private:
+  std::mutex mutex_;
+  std::vector<Context*> contexts_;
+};
+
+class ZSTDCodec::ZSTDCodecImpl {
+ public:
+  explicit ZSTDCodecImpl(int compression_level)
+      : compression_level_(compression_level), cdict_(nullptr), ddict_(nullptr) {}
+
+  ~ZSTDCodecImpl() { FreeDictionary(); }
+
+  Status Decompress(int64_t input_len, const uint8_t* input, int64_t output_len,
+      uint8_t* output_buffer) {
+    ZSTD_DCtx* dctx = decompress_contexts_.Take();
+    if (dctx == nullptr && (dctx = ZSTD_createDCtx()) == nullptr) {
+      return Status::OutOfMemory("Could not create ZSTD decompression context");
+    }
+    size_t ret;
+    if (ddict_ != nullptr) {
+      ret = ZSTD_decompress_usingDDict(dctx, output_buffer,
+          static_cast<size_t>(output_len), input, static_cast<size_t>(input_len), ddict_);
+    } else {
+      ret = ZSTD_decompressDCtx(dctx, output_buffer, static_cast<size_t>(output_len),
+          input, static_cast<size_t>(input_len));
+    }
+    decompress_contexts_.Put(dctx);
+    if (ZSTD_isError(ret) || static_cast<int64_t>(ret) != output_len) {
+      return Status::IOError("Corrupt ZSTD compressed data.");
+    }
+    return Status::OK();
+  }
+
+  Status Compress(int64_t input_len, const uint8_t* input, int64_t output_buffer_len,
+      uint8_t* output_buffer, int64_t* output_length) {
+    ZSTD_CCtx* cctx = compress_contexts_.Take();
+    if (cctx == nullptr && (cctx = ZSTD_createCCtx()) == nullptr) {
+      return Status::OutOfMemory("Could not create ZSTD compression context");
+    }
+    size_t ret;
+    if (cdict_ != nullptr) {
+      ret = ZSTD_compress_usingCDict(cctx, output_buffer,
+          static_cast<size_t>(output_buffer_len), input, static_cast<size_t>(input_len),
+          cdict_);
+    } else {
+      ret = ZSTD_compressCCtx(cctx, output_buffer, static_cast<size_t>(output_buffer_len),
+          input, static_cast<size_t>(input_len), compression_level_);
+    }
+    compress_contexts_.Put(cctx);
+    if (ZSTD_isError(ret)) { return Status::IOError("ZSTD compression failure."); }
+    *output_length = static_cast<int64_t>(ret);
+    return Status::OK();
+  }
+
+  Status SetDictionary(const std::shared_ptr<Buffer>& dictionary) {
+    FreeDictionary();
+    // The dictionary contents are copied
+    cdict_ = ZSTD_createCDict(dictionary->data(),
+        static_cast<size_t>(dictionary->size()), compression_level_);
+    ddict_ =
+        ZSTD_createDDict(dictionary->data(), static_cast<size_t>(dictionary->size()));
+    if (cdict_ == nullptr || ddict_ == nullptr) {
+      FreeDictionary();
+      return Status::Invalid("Could not load ZSTD dictionary");
+    }
+    return Status::OK();
+  }
+
+  int compression_level() const { return compression_level_; }
+
+ private:
+  void FreeDictionary() {
+    ZSTD_freeCDict(cdict_);
+    ZSTD_freeDDict(ddict_);
+    cdict_ = nullptr;
+    ddict_ = nullptr;
+  }
+
+  int compression_level_;
+  ZSTD_CDict* cdict_;
+  ZSTD_DDict* ddict_;
+  ContextPool<ZSTD_CCtx, ZSTD_freeCCtx> compress_contexts_;
+  ContextPool<ZSTD_DCtx, ZSTD_freeDCtx> decompress_contexts_;
+};
+
+ZSTDCodec::ZSTDCodec(int compression_level) {
+  impl_.reset(new ZSTDCodecImpl(compression_level));
+}
+
+ZSTDCodec::~ZSTDCodec() {}
+
 Status ZSTDCodec::Decompress(
     int64_t input_len, const uint8_t* input, int64_t output_len, uint8_t* output_buffer) {
-  int64_t decompressed_size = ZSTD_decompress(output_buffer,
-      static_cast<size_t>(output_len), input, static_cast<size_t>(input_len));
-  if (decompressed_size != output_len) {
-    return Status::IOError("Corrupt ZSTD compressed data.");
-  }
-  return Status::OK();
+  return impl_->Decompress(input_len, input, output_len, output_buffer);
 }
 
 int64_t ZSTDCodec::MaxCompressedLen(int64_t input_len, const uint8_t* input) {
@@ -48,11 +164,173 @@ int64_t ZSTDCodec::MaxCompressedLen(int64_t input_len, const uint8_t* input) {
 
 Status ZSTDCodec::Compress(int64_t input_len, const uint8_t* input,
     int64_t output_buffer_len, uint8_t* output_buffer, int64_t* output_length) {
-  *output_length = ZSTD_compress(output_buffer, static_cast<size_t>(output_buffer_len),
-      input, static_cast<size_t>(input_len), 1);
-  if (ZSTD_isError(*output_length)) {
-    return Status::IOError("ZSTD compression failure.");
+  return impl_->Compress(
+      input_len, input, output_buffer_len, output_buffer, output_length);
+}
+
+Status ZSTDCodec::SetDictionary(const std::shared_ptr<Buffer>& dictionary) {
+  return impl_->SetDictionary(dictionary);
+}
+
+Status ZSTDCodec::TrainDictionary(const std::vector<std::shared_ptr<Buffer>>& samples,
+    int64_t max_size, MemoryPool* pool, std::shared_ptr<Buffer>* out) {
+  // The trainer takes the samples end to end
+  std::vector<uint8_t> sample_data;
+  std::vector<size_t> sample_sizes;
+  for (const auto& sample : samples) {
+    sample_data.insert(
+        sample_data.end(), sample->data(), sample->data() + sample->size());
+    sample_sizes.push_back(static_cast<size_t>(sample->size()));
   }
+
+  std::shared_ptr<MutableBuffer> dictionary;
+  RETURN_NOT_OK(AllocateBuffer(pool, max_size, &dictionary));
+  size_t ret = ZDICT_trainFromBuffer(dictionary->mutable_data(),
+      static_cast<size_t>(max_size), sample_data.data(), sample_sizes.data(),
+      static_cast<unsigned>(sample_sizes.size()));
+  if (ZDICT_isError(ret)) {
+    std::stringstream ss;
+    ss << "ZSTD dictionary training failed: " << ZDICT_getErrorName(ret);
+    return Status::Invalid(ss.str());
+  }
+  *out = SliceBuffer(dictionary, 0, static_cast<int64_t>(ret));
+  return Status::OK();
+}
+
+// ----------------------------------------------------------------------
+// ZSTD streaming implementation
+
+static Status ZSTDError(size_t ret, const char* prefix_msg) {
+  std::stringstream ss;
+  ss << prefix_msg << ZSTD_getErrorName(ret);
+  return Status::IOError(ss.str());
+}
+
+class ZSTDCompressor : public Compressor {
+ public:
+  explicit ZSTDCompressor(int compression_level)
+      : stream_(nullptr), compression_level_(compression_level) {}
+
+  ~ZSTDCompressor() override { ZSTD_freeCStream(stream_); }
+
+  Status Init() {
+    stream_ = ZSTD_createCStream();
+    if (stream_ == nullptr) {
+      return Status::OutOfMemory("Could not create ZSTD stream");
+    }
+    size_t ret = ZSTD_initCStream(stream_, compression_level_);
+    if (ZSTD_isError(ret)) { return ZSTDError(ret, "ZSTD init failed: "); }
+    return Status::OK();
+  }
+
+  Status Compress(int64_t input_len, const uint8_t* input, int64_t output_len,
+      uint8_t* output, int64_t* bytes_read, int64_t* bytes_written) override {
+    ZSTD_inBuffer in_buf;
+    ZSTD_outBuffer out_buf;
+    in_buf.src = input;
+    in_buf.size = static_cast<size_t>(input_len);
+    in_buf.pos = 0;
+    out_buf.dst = output;
+    out_buf.size = static_cast<size_t>(output_len);
+    out_buf.pos = 0;
+
+    size_t ret = ZSTD_compressStream(stream_, &out_buf, &in_buf);
+    if (ZSTD_isError(ret)) { return ZSTDError(ret, "ZSTD compress failed: "); }
+    *bytes_read = static_cast<int64_t>(in_buf.pos);
+    *bytes_written = static_cast<int64_t>(out_buf.pos);
+    return Status::OK();
+  }
+
+  Status Flush(int64_t output_len, uint8_t* output, int64_t* bytes_written,
+      bool* should_retry) override {
+    ZSTD_outBuffer out_buf;
+    out_buf.dst = output;
+    out_buf.size = static_cast<size_t>(output_len);
+    out_buf.pos = 0;
+
+    // The return value is the number of bytes still to be flushed
+    size_t ret = ZSTD_flushStream(stream_, &out_buf);
+    if (ZSTD_isError(ret)) { return ZSTDError(ret, "ZSTD flush failed: "); }
+    *bytes_written = static_cast<int64_t>(out_buf.pos);
+    *should_retry = ret > 0;
+    return Status::OK();
+  }
+
+  Status End(int64_t output_len, uint8_t* output, int64_t* bytes_written,
+      bool* should_retry) override {
+    ZSTD_outBuffer out_buf;
+    out_buf.dst = output;
+    out_buf.size = static_cast<size_t>(output_len);
+    out_buf.pos = 0;
+
+    size_t ret = ZSTD_endStream(stream_, &out_buf);
+    if (ZSTD_isError(ret)) { return ZSTDError(ret, "ZSTD end failed: "); }
+    *bytes_written = static_cast<int64_t>(out_buf.pos);
+    *should_retry = ret > 0;
+    return Status::OK();
+  }
+
+ private:
+  ZSTD_CStream* stream_;
+  int compression_level_;
+};
+
+class ZSTDDecompressor : public Decompressor {
+ public:
+  ZSTDDecompressor() : stream_(nullptr), finished_(false) {}
+
+  ~ZSTDDecompressor() override { ZSTD_freeDStream(stream_); }
+
+  Status Init() {
+    stream_ = ZSTD_createDStream();
+    if (stream_ == nullptr) {
+      return Status::OutOfMemory("Could not create ZSTD stream");
+    }
+    size_t ret = ZSTD_initDStream(stream_);
+    if (ZSTD_isError(ret)) { return ZSTDError(ret, "ZSTD init failed: "); }
+    return Status::OK();
+  }
+
+  Status Decompress(int64_t input_len, const uint8_t* input, int64_t output_len,
+      uint8_t* output, int64_t* bytes_read, int64_t* bytes_written,
+      bool* need_more_output) override {
+    ZSTD_inBuffer in_buf;
+    ZSTD_outBuffer out_buf;
+    in_buf.src = input;
+    in_buf.size = static_cast<size_t>(input_len);
+    in_buf.pos = 0;
+    out_buf.dst = output;
+    out_buf.size = static_cast<size_t>(output_len);
+    out_buf.pos = 0;
+
+    // The return value is 0 once a frame is completely decoded and flushed
+    size_t ret = ZSTD_decompressStream(stream_, &out_buf, &in_buf);
+    if (ZSTD_isError(ret)) { return ZSTDError(ret, "ZSTD decompress failed: "); }
+    finished_ = ret == 0;
+    *bytes_read = static_cast<int64_t>(in_buf.pos);
+    *bytes_written = static_cast<int64_t>(out_buf.pos);
+    *need_more_output = !finished_ && out_buf.pos == out_buf.size;
+    return Status::OK();
+  }
+
+  bool IsFinished() override { return finished_; }
+
+ private:
+  ZSTD_DStream* stream_;
+  bool finished_;
+};
+
+Status ZSTDCodec::MakeCompressor(std::shared_ptr<Compressor>* out) {
+  auto result = std::make_shared<ZSTDCompressor>(impl_->compression_level());
+  RETURN_NOT_OK(result->Init());
+  *out = result;
+  return Status::OK();
+}
+
+Status ZSTDCodec::MakeDecompressor(std::shared_ptr<Decompressor>* out) {
+  auto result = std::make_shared<ZSTDDecompressor>();
+  RETURN_NOT_OK(result->Init());
+  *out = result;
   return Status::OK();
 }
 
@@ -20,15 +20,28 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "arrow/status.h"
 #include "arrow/util/compression.h"
 
 namespace arrow {
 
-// ZSTD codec.
+class Buffer;
+class MemoryPool;
+
+constexpr int kZSTDMinCompressionLevel = 1;
+constexpr int kZSTDMaxCompressionLevel = 22;
+constexpr int kZSTDDefaultCompressionLevel = 1;
+
+// ZSTD codec. Compression and decompression contexts are kept for reuse, so
+// that compressing many small buffers does not set up a context for each.
+// Compress and Decompress may be called from several threads at once.
 class ARROW_EXPORT ZSTDCodec : public Codec {
  public:
+  explicit ZSTDCodec(int compression_level = kZSTDDefaultCompressionLevel);
+  ~ZSTDCodec() override;
+
   Status Decompress(int64_t input_len, const uint8_t* input, int64_t output_len,
       uint8_t* output_buffer) override;
 
@@ -37,7 +50,29 @@ class ARROW_EXPORT ZSTDCodec : public Codec {
 
   int64_t MaxCompressedLen(int64_t input_len, const uint8_t* input) override;
 
+  Status MakeCompressor(std::shared_ptr<Compressor>* out) override;
+
+  Status MakeDecompressor(std::shared_ptr<Decompressor>* out) override;
+
   const char* name() const override { return "zstd"; }
+
+  /// \brief Compress and decompress with a dictionary, such as one from
+  /// TrainDictionary, from now on. Dictionaries help most with small buffers
+  /// that resemble each other. Data compressed with a dictionary can only be
+  /// decompressed with the same one. Streaming compression does not use it.
+  ///
+  /// Must not be called concurrently with Compress or Decompress
+  Status SetDictionary(const std::shared_ptr<Buffer>& dictionary);
+
+  /// \brief Train a dictionary of at most max_size bytes on sample buffers
+  ///
+  /// \return Status, Invalid if there is too little sample data to train on
+  static Status TrainDictionary(const std::vector<std::shared_ptr<Buffer>>& samples,
+      int64_t max_size, MemoryPool* pool, std::shared_ptr<Buffer>* out);
+
+ private:
+  class ZSTDCodecImpl;
+  std::unique_ptr<ZSTDCodecImpl> impl_;
 };
 
 }  // namespace arrow
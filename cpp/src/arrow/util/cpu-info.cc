@@ -34,6 +34,11 @@
 #include <windows.h>
 #endif
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define ARROW_HAVE_CPUID
+#endif
+
 #include <boost/algorithm/string.hpp>
 
 #include <algorithm>
@@ -46,7 +51,6 @@
 
 #include "arrow/util/logging.h"
 
-using boost::algorithm::contains;
 using boost::algorithm::trim;
 using std::max;
 using std::string;
@@ -67,21 +71,66 @@ static struct {
   int64_t flag;
 } flag_mappings[] = {
     {"ssse3", CpuInfo::SSSE3}, {"sse4_1", CpuInfo::SSE4_1}, {"sse4_2", CpuInfo::SSE4_2},
-    {"popcnt", CpuInfo::POPCNT},
+    {"popcnt", CpuInfo::POPCNT}, {"avx", CpuInfo::AVX}, {"avx2", CpuInfo::AVX2},
+    {"avx512f", CpuInfo::AVX512F}, {"avx512bw", CpuInfo::AVX512BW},
+    {"avx512vl", CpuInfo::AVX512VL}, {"bmi2", CpuInfo::BMI2}, {"abm", CpuInfo::LZCNT},
 };
 static const int64_t num_flags = sizeof(flag_mappings) / sizeof(flag_mappings[0]);
 
 // Helper function to parse for hardware flags.
 // values contains a list of space-seperated flags.  check to see if the flags we
-// care about are present.
+// care about are present. Flags are compared whole, as some are prefixes of
+// others (avx, avx2, avx512f).
 // Returns a bitmap of flags.
 int64_t ParseCPUFlags(const string& values) {
   int64_t flags = 0;
-  for (int i = 0; i < num_flags; ++i) {
-    if (contains(values, flag_mappings[i].name)) { flags |= flag_mappings[i].flag; }
+  std::istringstream tokens(values);
+  string token;
+  while (tokens >> token) {
+    for (int i = 0; i < num_flags; ++i) {
+      if (token == flag_mappings[i].name) { flags |= flag_mappings[i].flag; }
+    }
+  }
+  return flags;
+}
+
+#ifdef ARROW_HAVE_CPUID
+// Read the hardware flags from cpuid. The AVX and AVX-512 flags are only set
+// when the OS has enabled saving the wider registers (checked with xgetbv).
+int64_t CpuidFlags() {
+  unsigned int eax, ebx, ecx, edx;
+  if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) { return 0; }
+  int64_t flags = 0;
+  if (ecx & (1 << 9)) { flags |= CpuInfo::SSSE3; }
+  if (ecx & (1 << 19)) { flags |= CpuInfo::SSE4_1; }
+  if (ecx & (1 << 20)) { flags |= CpuInfo::SSE4_2; }
+  if (ecx & (1 << 23)) { flags |= CpuInfo::POPCNT; }
+
+  // XCR0 bits: 1-2 for the SSE and AVX state, 5-7 for the AVX-512 state
+  uint64_t xcr0 = 0;
+  if (ecx & (1 << 27)) {
+    unsigned int xcr0_low, xcr0_high;
+    __asm__("xgetbv" : "=a"(xcr0_low), "=d"(xcr0_high) : "c"(0));
+    xcr0 = (static_cast<uint64_t>(xcr0_high) << 32) | xcr0_low;
+  }
+  const bool os_avx = (xcr0 & 0x6) == 0x6;
+  const bool os_avx512 = (xcr0 & 0xe6) == 0xe6;
+  if (os_avx && (ecx & (1 << 28))) { flags |= CpuInfo::AVX; }
+
+  if (__get_cpuid_max(0, nullptr) >= 7) {
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    if (os_avx && (ebx & (1 << 5))) { flags |= CpuInfo::AVX2; }
+    if (ebx & (1 << 8)) { flags |= CpuInfo::BMI2; }
+    if (os_avx512 && (ebx & (1 << 16))) { flags |= CpuInfo::AVX512F; }
+    if (os_avx512 && (ebx & (1 << 30))) { flags |= CpuInfo::AVX512BW; }
+    if (os_avx512 && (ebx & (1U << 31))) { flags |= CpuInfo::AVX512VL; }
+  }
+  if (__get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx) && (ecx & (1 << 5))) {
+    flags |= CpuInfo::LZCNT;
   }
   return flags;
 }
+#endif
 
 #ifdef _WIN32
 bool RetrieveCacheSize(int64_t* cache_sizes) {
@@ -199,6 +248,9 @@ void CpuInfo::Init() {
   } else {
     cycles_per_ms_ = 1000000;
   }
+#ifdef ARROW_HAVE_CPUID
+  hardware_flags_ = CpuidFlags();
+#endif
   original_hardware_flags_ = hardware_flags_;
 
   if (num_cores > 0) {
@@ -31,13 +31,21 @@ namespace arrow {
 /// CpuInfo is an interface to query for cpu information at runtime.  The caller can
 /// ask for the sizes of the caches and what hardware features are supported.
 /// On Linux, this information is pulled from a couple of sys files (/proc/cpuinfo and
-/// /sys/devices)
+/// /sys/devices). On x86 with GCC or clang, the hardware flags come from cpuid, which
+/// also tells whether the OS saves the AVX and AVX-512 registers
 class ARROW_EXPORT CpuInfo {
  public:
   static const int64_t SSSE3 = (1 << 1);
   static const int64_t SSE4_1 = (1 << 2);
   static const int64_t SSE4_2 = (1 << 3);
   static const int64_t POPCNT = (1 << 4);
+  static const int64_t AVX2 = (1 << 5);
+  static const int64_t AVX = (1 << 6);
+  static const int64_t AVX512F = (1 << 7);
+  static const int64_t AVX512BW = (1 << 8);
+  static const int64_t AVX512VL = (1 << 9);
+  static const int64_t BMI2 = (1 << 10);
+  static const int64_t LZCNT = (1 << 11);
 
   /// Cache enums for L1 (data), L2 and L3
   enum CacheLevel {
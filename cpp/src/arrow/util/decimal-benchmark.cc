@@ -0,0 +1,176 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "arrow/util/decimal.h"
+
+namespace arrow {
+namespace decimal {
+
+static constexpr int kNumValues = 1 << 12;
+
+// kNumValues decimal strings with up to num_digits digits, two of them after the
+// point, half of them negative
+static std::vector<std::string> DecimalStrings(int num_digits) {
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int> digit_dist(0, 9);
+  std::uniform_int_distribution<int> length_dist(3, num_digits);
+  std::vector<std::string> strings;
+  for (int i = 0; i < kNumValues; ++i) {
+    std::string s = i % 2 == 0 ? "-" : "";
+    const int length = length_dist(gen);
+    for (int j = 0; j < length; ++j) {
+      if (j == length - 2) { s += '.'; }
+      s += static_cast<char>('0' + digit_dist(gen));
+    }
+    strings.push_back(s);
+  }
+  return strings;
+}
+
+template <typename T>
+static std::vector<Decimal<T>> Decimals(int num_digits) {
+  std::vector<Decimal<T>> values;
+  for (const std::string& s : DecimalStrings(num_digits)) {
+    values.emplace_back(s);
+  }
+  return values;
+}
+
+template <typename T>
+static void BM_FromString(benchmark::State& state) {  // NOLINT non-const reference
+  const std::vector<std::string> strings =
+      DecimalStrings(DecimalPrecision<T>::maximum);
+  int64_t total_bytes = 0;
+  for (const std::string& s : strings) {
+    total_bytes += static_cast<int64_t>(s.size());
+  }
+  Decimal<T> value;
+  int precision, scale;
+
+  while (state.KeepRunning()) {
+    for (const std::string& s : strings) {
+      benchmark::DoNotOptimize(FromString(
+          s.data(), static_cast<int64_t>(s.size()), &value, &precision, &scale));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+  state.SetBytesProcessed(state.iterations() * total_bytes);
+}
+
+template <typename T>
+static void BM_FormatDecimal(benchmark::State& state) {  // NOLINT non-const reference
+  const int precision = DecimalPrecision<T>::maximum;
+  const std::vector<Decimal<T>> values = Decimals<T>(precision);
+  char buffer[kMaxDecimalStringLength];
+
+  while (state.KeepRunning()) {
+    for (const Decimal<T>& value : values) {
+      benchmark::DoNotOptimize(FormatDecimal(value, precision, 2, buffer));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+template <typename T>
+static void BM_Rescale(benchmark::State& state) {  // NOLINT non-const reference
+  const std::vector<Decimal<T>> values = Decimals<T>(DecimalPrecision<T>::maximum - 4);
+  Decimal<T> out;
+
+  while (state.KeepRunning()) {
+    for (const Decimal<T>& value : values) {
+      benchmark::DoNotOptimize(Rescale(value, 2, 4, &out));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+static void BM_Int128Add(benchmark::State& state) {  // NOLINT non-const reference
+  const std::vector<Decimal128> values = Decimals<Int128>(36);
+  std::vector<Int128> sums(kNumValues);
+
+  while (state.KeepRunning()) {
+    for (int i = 0; i < kNumValues; ++i) {
+      sums[i] = values[i].value + values[kNumValues - 1 - i].value;
+    }
+    benchmark::DoNotOptimize(sums.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+static void BM_Int128Multiply(benchmark::State& state) {  // NOLINT non-const reference
+  const std::vector<Decimal128> values = Decimals<Int128>(18);
+  std::vector<Int128> products(kNumValues);
+
+  while (state.KeepRunning()) {
+    for (int i = 0; i < kNumValues; ++i) {
+      products[i] = values[i].value * values[kNumValues - 1 - i].value;
+    }
+    benchmark::DoNotOptimize(products.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+static void BM_Int128Compare(benchmark::State& state) {  // NOLINT non-const reference
+  const std::vector<Decimal128> values = Decimals<Int128>(36);
+  std::vector<uint8_t> less(kNumValues);
+
+  while (state.KeepRunning()) {
+    for (int i = 0; i < kNumValues; ++i) {
+      less[i] = values[i].value < values[kNumValues - 1 - i].value;
+    }
+    benchmark::DoNotOptimize(less.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+static void BM_Int128Divide(benchmark::State& state) {  // NOLINT non-const reference
+  const std::vector<Decimal128> values = Decimals<Int128>(36);
+  const Int128 divisor = PowerOfTen(static_cast<int>(state.range(0)));
+  Int128 quotient;
+
+  while (state.KeepRunning()) {
+    for (const Decimal128& value : values) {
+      benchmark::DoNotOptimize(value.value.Divide(divisor, &quotient));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+BENCHMARK_TEMPLATE(BM_FromString, int32_t);
+BENCHMARK_TEMPLATE(BM_FromString, int64_t);
+BENCHMARK_TEMPLATE(BM_FromString, Int128);
+BENCHMARK_TEMPLATE(BM_FormatDecimal, int32_t);
+BENCHMARK_TEMPLATE(BM_FormatDecimal, int64_t);
+BENCHMARK_TEMPLATE(BM_FormatDecimal, Int128);
+BENCHMARK_TEMPLATE(BM_Rescale, int32_t);
+BENCHMARK_TEMPLATE(BM_Rescale, int64_t);
+BENCHMARK_TEMPLATE(BM_Rescale, Int128);
+BENCHMARK(BM_Int128Add);
+BENCHMARK(BM_Int128Multiply);
+BENCHMARK(BM_Int128Compare);
+// Divisors of one and two words
+BENCHMARK(BM_Int128Divide)->Arg(9)->Arg(30);
+
+}  // namespace decimal
+}  // namespace arrow
@@ -18,6 +18,10 @@
 
 #include "arrow/util/decimal.h"
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "arrow/test-util.h"
@@ -33,7 +37,7 @@ class DecimalTest : public ::testing::Test {
   std::string string_value;
 };
 
-typedef ::testing::Types<int32_t, int64_t, int128_t> DecimalTypes;
+typedef ::testing::Types<int32_t, int64_t, Int128> DecimalTypes;
 TYPED_TEST_CASE(DecimalTest, DecimalTypes);
 
 TYPED_TEST(DecimalTest, TestToString) {
@@ -67,7 +71,7 @@ TEST(DecimalTest, TestStringStartingWithPlus) {
 
 TEST(DecimalTest, TestStringStartingWithPlus128) {
   std::string plus_value("+2342394230592.232349023094");
-  decimal::int128_t expected_value("2342394230592232349023094");
+  decimal::Int128 expected_value("2342394230592232349023094");
   Decimal128 out;
   int scale;
   int precision;
@@ -90,15 +94,15 @@ TEST(DecimalTest, TestStringToInt64) {
 }
 
 TEST(DecimalTest, TestStringToInt128) {
-  int128_t value = 0;
+  Int128 value = 0;
   StringToInteger("123456789", "456789123", 1, &value);
   ASSERT_EQ(value, 123456789456789123);
 }
 
 TEST(DecimalTest, TestFromString128) {
   static const std::string string_value("-23049223942343532412");
-  Decimal<int128_t> result(string_value);
-  int128_t expected = -230492239423435324;
+  Decimal<Int128> result(string_value);
+  Int128 expected = -230492239423435324;
   ASSERT_EQ(result.value, expected * 100 - 12);
 
   // Sanity check that our number is actually using more than 64 bits
@@ -107,8 +111,8 @@ TEST(DecimalTest, TestFromString128) {
 
 TEST(DecimalTest, TestFromDecimalString128) {
   static const std::string string_value("-23049223942343.532412");
-  Decimal<int128_t> result(string_value);
-  int128_t expected = -230492239423435324;
+  Decimal<Int128> result(string_value);
+  Int128 expected = -230492239423435324;
   ASSERT_EQ(result.value, expected * 100 - 12);
 
   // Sanity check that our number is actually using more than 64 bits
@@ -130,8 +134,8 @@ TEST(DecimalTest, TestDecimal64Precision) {
 }
 
 TEST(DecimalTest, TestDecimal128Precision) {
-  auto min_precision = DecimalPrecision<int128_t>::minimum;
-  auto max_precision = DecimalPrecision<int128_t>::maximum;
+  auto min_precision = DecimalPrecision<Int128>::minimum;
+  auto max_precision = DecimalPrecision<Int128>::maximum;
   ASSERT_EQ(min_precision, 19);
   ASSERT_EQ(max_precision, 38);
 }
@@ -166,7 +170,7 @@ TEST(DecimalTest, TestDecimal128StringAndBytesRoundTrip) {
   Decimal128 expected(string_value);
 
   std::string expected_string_value("-340282366920938463463374607431711455");
-  int128_t expected_underlying_value(expected_string_value);
+  Int128 expected_underlying_value(expected_string_value);
 
   ASSERT_EQ(expected.value, expected_underlying_value);
 
@@ -279,5 +283,137 @@ TYPED_TEST(DecimalZerosTest, NoLeadingZerosDecimalPoint) {
   ASSERT_EQ(d.value, 0);
 }
 
+TEST(Int128Test, Arithmetic) {
+  // Carries and borrows between the words
+  const Int128 low_max(0, ~0ULL);
+  ASSERT_EQ(Int128(1, 0), low_max + 1);
+  ASSERT_EQ(low_max, Int128(1, 0) - 1);
+  ASSERT_EQ(Int128(-1, ~0ULL), Int128(0) - 1);
+  ASSERT_EQ(-1, Int128(-1, ~0ULL));
+
+  const Int128 value("123456789012345678901234567890");
+  ASSERT_EQ(Int128("-123456789012345678901234567890"), -value);
+  ASSERT_EQ(Int128("246913578024691357802469135780"), value * 2);
+  ASSERT_EQ(Int128("-1234567890123456789012345678900000"), value * -10000);
+  ASSERT_EQ(value, value.Abs());
+  ASSERT_EQ(value, (-value).Abs());
+  ASSERT_EQ(static_cast<int64_t>(-12345), static_cast<int64_t>(Int128(-12345)));
+}
+
+TEST(Int128Test, Divide) {
+  const Int128 value("123456789012345678901234567890");
+  Int128 quotient, remainder;
+  ASSERT_OK(value.Divide(1000000007, &quotient, &remainder));
+  ASSERT_EQ(value, quotient * 1000000007 + remainder);
+  ASSERT_TRUE(remainder >= 0 && remainder < 1000000007);
+
+  // Truncation towards zero, the remainder taking the sign of the dividend
+  ASSERT_OK((-value).Divide(1000000007, &quotient, &remainder));
+  ASSERT_EQ(-value, quotient * 1000000007 + remainder);
+  ASSERT_TRUE(remainder <= 0);
+  ASSERT_EQ(Int128(-3), Int128(-7) / 2);
+  ASSERT_EQ(Int128(-1), Int128(-7) % 2);
+  ASSERT_EQ(Int128(-3), Int128(7) / -2);
+
+  // Divisors of more than 64 bits
+  const Int128 divisor("98765432109876543210");
+  ASSERT_OK(value.Divide(divisor, &quotient, &remainder));
+  ASSERT_EQ(Int128(1249999988), quotient);
+  ASSERT_EQ(value, quotient * divisor + remainder);
+  ASSERT_TRUE(remainder < divisor);
+  ASSERT_EQ(Int128(-1249999988), value / -divisor);
+
+  ASSERT_RAISES(Invalid, value.Divide(0, &quotient));
+}
+
+TEST(Int128Test, Compare) {
+  const std::vector<Int128> ordered = {Int128("-99999999999999999999999"),
+      Int128(-1, 0), Int128(-2), Int128(0), Int128(1), Int128(0, ~0ULL),
+      Int128(1, 0), Int128("99999999999999999999999")};
+  for (size_t i = 0; i < ordered.size(); ++i) {
+    for (size_t j = 0; j < ordered.size(); ++j) {
+      ASSERT_EQ(i < j, ordered[i] < ordered[j]) << i << " " << j;
+      ASSERT_EQ(i <= j, ordered[i] <= ordered[j]) << i << " " << j;
+      ASSERT_EQ(i == j, ordered[i] == ordered[j]) << i << " " << j;
+    }
+  }
+}
+
+TEST(Int128Test, ToString) {
+  ASSERT_EQ("0", Int128(0).ToString());
+  ASSERT_EQ("-42", Int128(-42).ToString());
+  ASSERT_EQ("1000000000000000000", Int128(1000000000000000000LL).ToString());
+  ASSERT_EQ("-170141183460469231731687303715884105728", Int128(INT64_MIN, 0).ToString());
+  ASSERT_EQ("170141183460469231731687303715884105727",
+      Int128(INT64_MAX, ~0ULL).ToString());
+  ASSERT_EQ("100000000000000000000000000000000000000", PowerOfTen(38).ToString());
+}
+
+TEST(DecimalTest, TestFromCharacterRange) {
+  // No null terminator needed, only length characters are read
+  const char buffer[] = "-12.3456789";
+  Decimal64 out;
+  int precision, scale;
+  ASSERT_OK(FromString(buffer, 6, &out, &precision, &scale));
+  ASSERT_EQ(-1234, out.value);
+  ASSERT_EQ(4, precision);
+  ASSERT_EQ(2, scale);
+  ASSERT_RAISES(Invalid, FromString(buffer, 0, &out));
+}
+
+TEST(DecimalTest, TestTooManyDigits) {
+  Decimal32 out32;
+  ASSERT_OK(FromString("999999999", &out32));
+  ASSERT_RAISES(Invalid, FromString("99999.99999", &out32));
+  // Precision and scale can still be inferred
+  int precision, scale;
+  ASSERT_OK(FromString("99999.99999", static_cast<Decimal32*>(nullptr), &precision,
+      &scale));
+  ASSERT_EQ(10, precision);
+
+  Decimal128 out128;
+  ASSERT_OK(FromString(std::string(38, '9'), &out128));
+  ASSERT_EQ(PowerOfTen(38) - 1, out128.value);
+  ASSERT_RAISES(Invalid, FromString(std::string(39, '9'), &out128));
+}
+
+TEST(DecimalTest, TestFormatScales) {
+  ASSERT_EQ("0.005", ToString(Decimal32(5), 3, 3));
+  ASSERT_EQ("-0.05", ToString(Decimal64(-5), 4, 2));
+  ASSERT_EQ("0.00", ToString(Decimal32(0), 4, 2));
+  ASSERT_EQ("-9223372036854775808", ToString(Decimal64(INT64_MIN), 18, 0));
+  ASSERT_EQ("-123456789012345678.90123456789012345678",
+      ToString(Decimal128(Int128("-12345678901234567890123456789012345678")), 38, 20));
+
+  char buffer[kMaxDecimalStringLength];
+  const Decimal128 smallest(-(PowerOfTen(38) - 1));
+  const std::string expected = "-0." + std::string(38, '9');
+  ASSERT_EQ(expected, std::string(buffer, FormatDecimal(smallest, 38, 38, buffer)));
+}
+
+TYPED_TEST(DecimalTest, TestStringRoundTrip) {
+  const int max_precision = DecimalPrecision<TypeParam>::maximum;
+  for (const std::string input : {"0.5", "-1", "123.45", "-0.001"}) {
+    Decimal<TypeParam> value;
+    int precision, scale;
+    ASSERT_OK(FromString(input, &value, &precision, &scale));
+    ASSERT_EQ(input, ToString(value, max_precision, scale));
+  }
+}
+
+TYPED_TEST(DecimalTest, TestRescale) {
+  Decimal<TypeParam> value(std::string("-12.5"));
+  Decimal<TypeParam> out;
+  ASSERT_OK(Rescale(value, 1, 4, &out));
+  ASSERT_EQ(Decimal<TypeParam>(std::string("-125000")).value, out.value);
+  ASSERT_OK(Rescale(out, 4, 1, &out));
+  ASSERT_EQ(value.value, out.value);
+  ASSERT_RAISES(Invalid, Rescale(value, 1, 0, &out));
+
+  // Beyond the storage type
+  const int max_precision = DecimalPrecision<TypeParam>::maximum;
+  ASSERT_RAISES(Invalid, Rescale(value, 1, max_precision + 1, &out));
+}
+
 }  // namespace decimal
 }  // namespace arrow
@@ -17,24 +17,281 @@
 
 #include "arrow/util/decimal.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <sstream>
+
 namespace arrow {
 namespace decimal {
 
+namespace {
+
+// Digits are accumulated into a 64-bit word before touching the wider
+// decimal value, 18 at a time so that the word cannot overflow
+constexpr int kWordDigits = 18;
+
+constexpr uint64_t kWordPowersOfTen[kWordDigits + 1] = {1ULL, 10ULL, 100ULL, 1000ULL,
+    10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+    10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL};
+
+const char kDigitPairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+inline bool IsDigit(char c) { return static_cast<unsigned char>(c - '0') < 10; }
+
+// Append the base ten digits to the value: value * 10^length + digits
+template <typename T>
+void AccumulateDigits(const char* digits, int64_t length, T* out) {
+  for (int64_t position = 0; position < length;) {
+    const int group = static_cast<int>(std::min<int64_t>(kWordDigits, length - position));
+    uint64_t word = 0;
+    for (int i = 0; i < group; ++i) {
+      word = word * 10 + static_cast<uint64_t>(digits[position + i] - '0');
+    }
+    *out = *out * static_cast<T>(kWordPowersOfTen[group]) + static_cast<T>(word);
+    position += group;
+  }
+}
+
+template <>
+void AccumulateDigits(const char* digits, int64_t length, Int128* out) {
+  for (int64_t position = 0; position < length;) {
+    const int group = static_cast<int>(std::min<int64_t>(kWordDigits, length - position));
+    uint64_t word = 0;
+    for (int i = 0; i < group; ++i) {
+      word = word * 10 + static_cast<uint64_t>(digits[position + i] - '0');
+    }
+    *out *= Int128(0, kWordPowersOfTen[group]);
+    *out += Int128(0, word);
+    position += group;
+  }
+}
+
+// Divide the unsigned 128-bit value in place by a 64-bit divisor, returning
+// the remainder
+uint64_t DivideByWord(uint64_t* high, uint64_t* low, uint64_t divisor) {
+#ifdef __SIZEOF_INT128__
+  const unsigned __int128 dividend = (static_cast<unsigned __int128>(*high) << 64) | *low;
+  const unsigned __int128 quotient = dividend / divisor;
+  *high = static_cast<uint64_t>(quotient >> 64);
+  *low = static_cast<uint64_t>(quotient);
+  return static_cast<uint64_t>(dividend - quotient * divisor);
+#else
+  uint64_t remainder = *high % divisor;
+  *high /= divisor;
+  uint64_t quotient = 0;
+  for (int bit = 63; bit >= 0; --bit) {
+    const bool carry = (remainder >> 63) != 0;
+    remainder = (remainder << 1) | ((*low >> bit) & 1);
+    if (carry || remainder >= divisor) {
+      remainder -= divisor;
+      quotient |= 1ULL << bit;
+    }
+  }
+  *low = quotient;
+  return remainder;
+#endif
+}
+
+// Unsigned 128-bit division by a divisor of at least 2^64, one quotient bit at
+// a time without compiler support. The quotient is less than 2^64
+void DivideByWide(uint64_t* high, uint64_t* low, uint64_t divisor_high,
+    uint64_t divisor_low, uint64_t* remainder_high, uint64_t* remainder_low) {
+#ifdef __SIZEOF_INT128__
+  const unsigned __int128 dividend = (static_cast<unsigned __int128>(*high) << 64) | *low;
+  const unsigned __int128 divisor =
+      (static_cast<unsigned __int128>(divisor_high) << 64) | divisor_low;
+  const unsigned __int128 remainder = dividend % divisor;
+  *high = 0;
+  *low = static_cast<uint64_t>(dividend / divisor);
+  *remainder_high = static_cast<uint64_t>(remainder >> 64);
+  *remainder_low = static_cast<uint64_t>(remainder);
+#else
+  uint64_t rem_high = 0, rem_low = 0, quotient = 0;
+  for (int bit = 127; bit >= 0; --bit) {
+    rem_high = (rem_high << 1) | (rem_low >> 63);
+    rem_low = (rem_low << 1) | (((bit >= 64 ? *high : *low) >> (bit % 64)) & 1);
+    if (rem_high > divisor_high || (rem_high == divisor_high && rem_low >= divisor_low)) {
+      rem_high -= divisor_high + (rem_low < divisor_low);
+      rem_low -= divisor_low;
+      if (bit < 64) { quotient |= 1ULL << bit; }
+    }
+  }
+  *high = 0;
+  *low = quotient;
+  *remainder_high = rem_high;
+  *remainder_low = rem_low;
+#endif
+}
+
+// Write the digits of value backwards, ending at end. At least one digit is
+// written, or exactly min_digits when zero-padding
+char* WriteWordDigits(uint64_t value, char* end, int min_digits = 1) {
+  char* p = end;
+  while (value >= 100) {
+    const uint64_t pair = value % 100;
+    value /= 100;
+    p -= 2;
+    memcpy(p, kDigitPairs + pair * 2, 2);
+  }
+  if (value >= 10) {
+    p -= 2;
+    memcpy(p, kDigitPairs + value * 2, 2);
+  } else {
+    *--p = static_cast<char>('0' + value);
+  }
+  while (end - p < min_digits) {
+    *--p = '0';
+  }
+  return p;
+}
+
+char* WriteMagnitudeDigits(uint64_t high, uint64_t low, char* end) {
+  char* p = end;
+  while (high != 0) {
+    const uint64_t chunk = DivideByWord(&high, &low, kWordPowersOfTen[kWordDigits]);
+    p = WriteWordDigits(chunk, p, kWordDigits);
+  }
+  return WriteWordDigits(low, p);
+}
+
+// Lay out [-]digits as a decimal with scale digits after the point
+int LayOutDecimal(
+    bool negative, const char* digits, int num_digits, int scale, char* out) {
+  char* p = out;
+  if (negative) { *p++ = '-'; }
+  if (num_digits <= scale) {
+    *p++ = '0';
+    *p++ = '.';
+    memset(p, '0', scale - num_digits);
+    p += scale - num_digits;
+    memcpy(p, digits, num_digits);
+    p += num_digits;
+  } else {
+    const int whole_digits = num_digits - scale;
+    memcpy(p, digits, whole_digits);
+    p += whole_digits;
+    if (scale > 0) {
+      *p++ = '.';
+      memcpy(p, digits + whole_digits, scale);
+      p += scale;
+    }
+  }
+  return static_cast<int>(p - out);
+}
+
+inline Int128 ToInt128(int32_t value) { return Int128(value); }
+inline Int128 ToInt128(int64_t value) { return Int128(value); }
+inline Int128 ToInt128(const Int128& value) { return value; }
+
+// Narrow to the storage type, false if the value does not fit
+inline bool FromInt128(const Int128& value, int32_t* out) {
+  *out = static_cast<int32_t>(static_cast<int64_t>(value));
+  return Int128(*out) == value;
+}
+
+inline bool FromInt128(const Int128& value, int64_t* out) {
+  *out = static_cast<int64_t>(value);
+  return Int128(*out) == value;
+}
+
+inline bool FromInt128(const Int128& value, Int128* out) {
+  *out = value;
+  return true;
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------
+// Int128
+
+Int128::Int128(const std::string& s) : Int128() {
+  Decimal128 value;
+  int scale = 0;
+  DCHECK(FromString(s, &value, nullptr, &scale).ok());
+  DCHECK_EQ(scale, 0) << "Not an integer: " << s;
+  *this = value.value;
+}
+
+Status Int128::Divide(const Int128& divisor, Int128* result, Int128* remainder) const {
+  if (divisor == 0) { return Status::Invalid("Division by zero"); }
+  const bool negative_quotient = IsNegative() != divisor.IsNegative();
+  const bool negative_remainder = IsNegative();
+  const Int128 dividend_magnitude = Abs();
+  const Int128 divisor_magnitude = divisor.Abs();
+
+  uint64_t high = static_cast<uint64_t>(dividend_magnitude.high_bits());
+  uint64_t low = dividend_magnitude.low_bits();
+  uint64_t remainder_high = 0, remainder_low;
+  if (divisor_magnitude.high_bits() == 0) {
+    remainder_low = DivideByWord(&high, &low, divisor_magnitude.low_bits());
+  } else {
+    DivideByWide(&high, &low, static_cast<uint64_t>(divisor_magnitude.high_bits()),
+        divisor_magnitude.low_bits(), &remainder_high, &remainder_low);
+  }
+
+  Int128 quotient(static_cast<int64_t>(high), low);
+  Int128 rest(static_cast<int64_t>(remainder_high), remainder_low);
+  if (negative_quotient) { quotient.Negate(); }
+  if (negative_remainder) { rest.Negate(); }
+  *result = quotient;
+  if (remainder != nullptr) { *remainder = rest; }
+  return Status::OK();
+}
+
+std::string Int128::ToString() const {
+  const Int128 magnitude = Abs();
+  char digits[40];
+  char* digits_end = digits + sizeof(digits);
+  const char* first_digit = WriteMagnitudeDigits(
+      static_cast<uint64_t>(magnitude.high_bits()), magnitude.low_bits(), digits_end);
+  std::string result(IsNegative() ? "-" : "");
+  return result.append(first_digit, digits_end - first_digit);
+}
+
+std::ostream& operator<<(std::ostream& os, const Int128& value) {
+  return os << value.ToString();
+}
+
+Int128 PowerOfTen(int exponent) {
+  struct Powers {
+    Powers() {
+      values[0] = 1;
+      for (int i = 1; i <= 38; ++i) {
+        values[i] = values[i - 1] * 10;
+      }
+    }
+    Int128 values[39];
+  };
+  static const Powers powers;
+  DCHECK(exponent >= 0 && exponent <= 38) << "Invalid power of ten: " << exponent;
+  return powers.values[exponent];
+}
+
+// ----------------------------------------------------------------------
+// Parsing
+
 template <typename T>
-ARROW_EXPORT Status FromString(
-    const std::string& s, Decimal<T>* out, int* precision, int* scale) {
+Status FromString(
+    const char* s, int64_t length, Decimal<T>* out, int* precision, int* scale) {
   // Implements this regex: "(\\+?|-?)((0*)(\\d*))(\\.(\\d+))?";
-  if (s.empty()) {
+  if (length == 0) {
     return Status::Invalid("Empty string cannot be converted to decimal");
   }
 
-  int8_t sign = 1;
-  std::string::const_iterator charp = s.cbegin();
-  std::string::const_iterator end = s.cend();
+  bool negative = false;
+  const char* charp = s;
+  const char* end = s + length;
 
-  char first_char = *charp;
+  const char first_char = *charp;
   if (first_char == '+' || first_char == '-') {
-    if (first_char == '-') { sign = -1; }
+    negative = first_char == '-';
     ++charp;
   }
 
@@ -44,9 +301,7 @@ ARROW_EXPORT Status FromString(
     return Status::Invalid(ss.str());
   }
 
-  std::string::const_iterator numeric_string_start = charp;
-
-  DCHECK_LT(charp, end);
+  const char* numeric_string_start = charp;
 
   // skip leading zeros
   while (charp != end && *charp == '0') {
@@ -68,14 +323,13 @@ ARROW_EXPORT Status FromString(
     return Status::OK();
   }
 
-  std::string::const_iterator whole_part_start = charp;
+  const char* whole_part_start = charp;
 
-  while (charp != end && isdigit(*charp)) {
+  while (charp != end && IsDigit(*charp)) {
     ++charp;
   }
 
-  std::string::const_iterator whole_part_end = charp;
-  std::string whole_part(whole_part_start, whole_part_end);
+  const char* whole_part_end = charp;
 
   if (charp != end && *charp == '.') {
     ++charp;
@@ -86,7 +340,7 @@ ARROW_EXPORT Status FromString(
           "end of the string.");
     }
 
-    if (!isdigit(*charp)) {
+    if (!IsDigit(*charp)) {
       std::stringstream ss;
       ss << "Decimal point must be followed by a base ten digit. Found '" << *charp
          << "'";
@@ -101,39 +355,61 @@ ARROW_EXPORT Status FromString(
     }
   }
 
-  std::string::const_iterator fractional_part_start = charp;
+  const char* fractional_part_start = charp;
 
   // The rest must be digits, because if we have a decimal point it must be followed by
   // digits
-  if (charp != end) {
-    while (charp != end && isdigit(*charp)) {
-      ++charp;
-    }
+  while (charp != end && IsDigit(*charp)) {
+    ++charp;
+  }
 
-    // The while loop has ended before the end of the string which means we've hit a
-    // character that isn't a base ten digit
-    if (charp != end) {
-      std::stringstream ss;
-      ss << "Found non base ten digit character '" << *charp
-         << "' before the end of the string";
-      return Status::Invalid(ss.str());
-    }
+  // The while loop has ended before the end of the string which means we've hit a
+  // character that isn't a base ten digit
+  if (charp != end) {
+    std::stringstream ss;
+    ss << "Found non base ten digit character '" << *charp
+       << "' before the end of the string";
+    return Status::Invalid(ss.str());
   }
 
-  std::string::const_iterator fractional_part_end = charp;
-  std::string fractional_part(fractional_part_start, fractional_part_end);
+  const int64_t whole_digits = whole_part_end - whole_part_start;
+  const int64_t fractional_digits = charp - fractional_part_start;
 
   if (precision != nullptr) {
-    *precision = static_cast<int>(whole_part.size() + fractional_part.size());
+    *precision = static_cast<int>(whole_digits + fractional_digits);
   }
 
-  if (scale != nullptr) { *scale = static_cast<int>(fractional_part.size()); }
+  if (scale != nullptr) { *scale = static_cast<int>(fractional_digits); }
 
-  if (out != nullptr) { StringToInteger(whole_part, fractional_part, sign, &out->value); }
+  if (out != nullptr) {
+    if (whole_digits + fractional_digits > DecimalPrecision<T>::maximum) {
+      std::stringstream ss;
+      ss << "Decimal value with " << whole_digits + fractional_digits
+         << " digits exceeds the maximum precision of "
+         << DecimalPrecision<T>::maximum;
+      return Status::Invalid(ss.str());
+    }
+    T value = T();
+    AccumulateDigits(whole_part_start, whole_digits, &value);
+    AccumulateDigits(fractional_part_start, fractional_digits, &value);
+    out->value = negative ? -value : value;
+  }
 
   return Status::OK();
 }
 
+template <typename T>
+Status FromString(const std::string& s, Decimal<T>* out, int* precision, int* scale) {
+  return FromString(s.data(), static_cast<int64_t>(s.size()), out, precision, scale);
+}
+
+template ARROW_EXPORT Status FromString(
+    const char* s, int64_t length, Decimal32* out, int* precision, int* scale);
+template ARROW_EXPORT Status FromString(
+    const char* s, int64_t length, Decimal64* out, int* precision, int* scale);
+template ARROW_EXPORT Status FromString(
+    const char* s, int64_t length, Decimal128* out, int* precision, int* scale);
+
 template ARROW_EXPORT Status FromString(
     const std::string& s, Decimal32* out, int* precision, int* scale);
 template ARROW_EXPORT Status FromString(
@@ -141,40 +417,130 @@ template ARROW_EXPORT Status FromString(
 template ARROW_EXPORT Status FromString(
     const std::string& s, Decimal128* out, int* precision, int* scale);
 
-void StringToInteger(
-    const std::string& whole, const std::string& fractional, int8_t sign, int32_t* out) {
+template <typename T>
+static void StringToIntegerImpl(
+    const std::string& whole, const std::string& fractional, int8_t sign, T* out) {
   DCHECK(sign == -1 || sign == 1);
   DCHECK_NE(out, nullptr);
   DCHECK(!whole.empty() || !fractional.empty());
-  if (!whole.empty()) {
-    *out = std::stoi(whole, nullptr, 10) *
-           static_cast<int32_t>(pow(10.0, static_cast<double>(fractional.size())));
-  }
-  if (!fractional.empty()) { *out += std::stoi(fractional, nullptr, 10); }
-  *out *= sign;
+  *out = 0;
+  AccumulateDigits(whole.data(), static_cast<int64_t>(whole.size()), out);
+  AccumulateDigits(fractional.data(), static_cast<int64_t>(fractional.size()), out);
+  if (sign < 0) { *out = -*out; }
+}
+
+void StringToInteger(
+    const std::string& whole, const std::string& fractional, int8_t sign, int32_t* out) {
+  StringToIntegerImpl(whole, fractional, sign, out);
 }
 
 void StringToInteger(
     const std::string& whole, const std::string& fractional, int8_t sign, int64_t* out) {
-  DCHECK(sign == -1 || sign == 1);
-  DCHECK_NE(out, nullptr);
-  DCHECK(!whole.empty() || !fractional.empty());
-  if (!whole.empty()) {
-    *out = static_cast<int64_t>(std::stoll(whole, nullptr, 10)) *
-           static_cast<int64_t>(pow(10.0, static_cast<double>(fractional.size())));
-  }
-  if (!fractional.empty()) { *out += std::stoll(fractional, nullptr, 10); }
-  *out *= sign;
+  StringToIntegerImpl(whole, fractional, sign, out);
 }
 
 void StringToInteger(
-    const std::string& whole, const std::string& fractional, int8_t sign, int128_t* out) {
-  DCHECK(sign == -1 || sign == 1);
-  DCHECK_NE(out, nullptr);
-  DCHECK(!whole.empty() || !fractional.empty());
-  *out = int128_t(whole + fractional) * sign;
+    const std::string& whole, const std::string& fractional, int8_t sign, Int128* out) {
+  StringToIntegerImpl(whole, fractional, sign, out);
+}
+
+// ----------------------------------------------------------------------
+// Formatting
+
+template <typename T>
+int FormatDecimal(const Decimal<T>& decimal_value, int precision, int scale, char* out) {
+  DCHECK(scale >= 0 && scale <= DecimalPrecision<Int128>::maximum);
+  // Negating as unsigned also handles the most negative value
+  const bool negative = decimal_value.value < 0;
+  uint64_t magnitude = static_cast<uint64_t>(decimal_value.value);
+  if (negative) { magnitude = 0 - magnitude; }
+
+  char digits[24];
+  char* digits_end = digits + sizeof(digits);
+  const char* first_digit = WriteWordDigits(magnitude, digits_end);
+  return LayOutDecimal(negative, first_digit,
+      static_cast<int>(digits_end - first_digit), scale, out);
 }
 
+template <>
+int FormatDecimal(const Decimal128& decimal_value, int precision, int scale, char* out) {
+  DCHECK(scale >= 0 && scale <= DecimalPrecision<Int128>::maximum);
+  const bool negative = decimal_value.value.IsNegative();
+  const Int128 magnitude = decimal_value.value.Abs();
+
+  char digits[40];
+  char* digits_end = digits + sizeof(digits);
+  const char* first_digit = WriteMagnitudeDigits(
+      static_cast<uint64_t>(magnitude.high_bits()), magnitude.low_bits(), digits_end);
+  return LayOutDecimal(negative, first_digit,
+      static_cast<int>(digits_end - first_digit), scale, out);
+}
+
+template ARROW_EXPORT int FormatDecimal(
+    const Decimal32& decimal_value, int precision, int scale, char* out);
+template ARROW_EXPORT int FormatDecimal(
+    const Decimal64& decimal_value, int precision, int scale, char* out);
+
+template <typename T>
+std::string ToString(const Decimal<T>& decimal_value, int precision, int scale) {
+  char buffer[kMaxDecimalStringLength];
+  return std::string(buffer, FormatDecimal(decimal_value, precision, scale, buffer));
+}
+
+template ARROW_EXPORT std::string ToString(
+    const Decimal32& decimal_value, int precision, int scale);
+template ARROW_EXPORT std::string ToString(
+    const Decimal64& decimal_value, int precision, int scale);
+template ARROW_EXPORT std::string ToString(
+    const Decimal128& decimal_value, int precision, int scale);
+
+// ----------------------------------------------------------------------
+// Rescaling
+
+template <typename T>
+Status Rescale(
+    const Decimal<T>& value, int original_scale, int new_scale, Decimal<T>* out) {
+  const int delta = new_scale - original_scale;
+  const int max_delta = DecimalPrecision<Int128>::maximum;
+  if (delta < -max_delta || delta > max_delta) {
+    std::stringstream ss;
+    ss << "Cannot rescale decimal from scale " << original_scale << " to " << new_scale;
+    return Status::Invalid(ss.str());
+  }
+
+  Int128 wide = ToInt128(value.value);
+  if (delta > 0) {
+    const Int128 multiplier = PowerOfTen(delta);
+    Int128 bound;
+    RETURN_NOT_OK(Int128(std::numeric_limits<int64_t>::max(),
+        std::numeric_limits<uint64_t>::max()).Divide(multiplier, &bound));
+    if (wide.Abs() > bound || wide.Abs().IsNegative()) {
+      return Status::Invalid("Rescaling decimal value would overflow");
+    }
+    wide *= multiplier;
+  } else if (delta < 0) {
+    Int128 remainder;
+    RETURN_NOT_OK(wide.Divide(PowerOfTen(-delta), &wide, &remainder));
+    if (remainder != 0) {
+      return Status::Invalid("Rescaling decimal value would cause data loss");
+    }
+  }
+  if (!FromInt128(wide, &out->value)) {
+    return Status::Invalid("Rescaling decimal value would overflow");
+  }
+  return Status::OK();
+}
+
+template ARROW_EXPORT Status Rescale(
+    const Decimal32& value, int original_scale, int new_scale, Decimal32* out);
+template ARROW_EXPORT Status Rescale(
+    const Decimal64& value, int original_scale, int new_scale, Decimal64* out);
+template ARROW_EXPORT Status Rescale(
+    const Decimal128& value, int original_scale, int new_scale, Decimal128* out);
+
+// ----------------------------------------------------------------------
+// Byte conversion
+
 void FromBytes(const uint8_t* bytes, Decimal32* decimal) {
   DCHECK_NE(bytes, nullptr);
   DCHECK_NE(decimal, nullptr);
@@ -187,20 +553,16 @@ void FromBytes(const uint8_t* bytes, Decimal64* decimal) {
   decimal->value = *reinterpret_cast<const int64_t*>(bytes);
 }
 
-constexpr static const size_t BYTES_IN_128_BITS = 128 / CHAR_BIT;
-constexpr static const size_t LIMB_SIZE =
-    sizeof(std::remove_pointer<int128_t::backend_type::limb_pointer>::type);
-constexpr static const size_t LIMBS_IN_INT128 = BYTES_IN_128_BITS / LIMB_SIZE;
-
+// 128-bit decimals are stored as their magnitude, low word first, with the
+// sign kept in a separate bitmap
 void FromBytes(const uint8_t* bytes, bool is_negative, Decimal128* decimal) {
   DCHECK_NE(bytes, nullptr);
   DCHECK_NE(decimal, nullptr);
 
-  auto& decimal_value(decimal->value);
-  int128_t::backend_type& backend(decimal_value.backend());
-  backend.resize(LIMBS_IN_INT128, LIMBS_IN_INT128);
-  std::memcpy(backend.limbs(), bytes, BYTES_IN_128_BITS);
-  if (is_negative) { decimal->value = -decimal->value; }
+  uint64_t words[2];
+  memcpy(words, bytes, sizeof(words));
+  decimal->value = Int128(static_cast<int64_t>(words[1]), words[0]);
+  if (is_negative) { decimal->value.Negate(); }
 }
 
 void ToBytes(const Decimal32& value, uint8_t** bytes) {
@@ -217,12 +579,11 @@ void ToBytes(const Decimal128& decimal, uint8_t** bytes, bool* is_negative) {
   DCHECK_NE(*bytes, nullptr);
   DCHECK_NE(is_negative, nullptr);
 
-  /// TODO(phillipc): boost multiprecision is unreliable here, int128_t can't be
-  /// roundtripped
-  const auto& backend(decimal.value.backend());
-  const size_t bytes_in_use = LIMB_SIZE * backend.size();
-  std::memcpy(*bytes, backend.limbs(), bytes_in_use);
-  *is_negative = backend.isneg();
+  const Int128 magnitude = decimal.value.Abs();
+  const uint64_t words[2] = {
+      magnitude.low_bits(), static_cast<uint64_t>(magnitude.high_bits())};
+  memcpy(*bytes, words, sizeof(words));
+  *is_negative = decimal.value.IsNegative();
 }
 
 }  // namespace decimal
@@ -18,21 +18,154 @@
 #ifndef ARROW_DECIMAL_H
 #define ARROW_DECIMAL_H
 
-#include <cmath>
-#include <cstdlib>
-#include <iterator>
+#include <cstdint>
+#include <iosfwd>
 #include <string>
 
 #include "arrow/status.h"
-#include "arrow/util/bit-util.h"
 #include "arrow/util/logging.h"
-
-#include <boost/multiprecision/cpp_int.hpp>
+#include "arrow/util/visibility.h"
 
 namespace arrow {
 namespace decimal {
 
-using boost::multiprecision::int128_t;
+/// \brief A 128-bit two's complement integer held in two 64-bit words
+///
+/// The storage type of Decimal128. Addition, subtraction, multiplication and
+/// comparison are inline and branch-free; like the built-in integers they
+/// wrap around on overflow, so callers check decimal precision themselves.
+class ARROW_EXPORT Int128 {
+ public:
+  constexpr Int128() : high_bits_(0), low_bits_(0) {}
+  constexpr Int128(int64_t high_bits, uint64_t low_bits)
+      : high_bits_(static_cast<uint64_t>(high_bits)), low_bits_(low_bits) {}
+
+  /// Sign-extend value. Implicit, so that integers mix with Int128 in
+  /// arithmetic and comparisons
+  constexpr Int128(int64_t value)  // NOLINT implicit conversion
+      : high_bits_(value < 0 ? ~0ULL : 0ULL), low_bits_(static_cast<uint64_t>(value)) {}
+
+  /// Parse an optionally signed string of base ten digits
+  explicit Int128(const std::string& s);
+
+  int64_t high_bits() const { return static_cast<int64_t>(high_bits_); }
+  uint64_t low_bits() const { return low_bits_; }
+
+  bool IsNegative() const { return static_cast<int64_t>(high_bits_) < 0; }
+
+  Int128& Negate() {
+    low_bits_ = ~low_bits_ + 1;
+    high_bits_ = ~high_bits_ + (low_bits_ == 0);
+    return *this;
+  }
+
+  Int128 Abs() const {
+    Int128 result(*this);
+    return IsNegative() ? result.Negate() : result;
+  }
+
+  Int128& operator+=(const Int128& right) {
+    const uint64_t sum = low_bits_ + right.low_bits_;
+    high_bits_ += right.high_bits_ + (sum < low_bits_);
+    low_bits_ = sum;
+    return *this;
+  }
+
+  Int128& operator-=(const Int128& right) {
+    const uint64_t difference = low_bits_ - right.low_bits_;
+    high_bits_ -= right.high_bits_ + (difference > low_bits_);
+    low_bits_ = difference;
+    return *this;
+  }
+
+  Int128& operator*=(const Int128& right) {
+    uint64_t high, low;
+    MultiplyWords(low_bits_, right.low_bits_, &high, &low);
+    high_bits_ = high + low_bits_ * right.high_bits_ + high_bits_ * right.low_bits_;
+    low_bits_ = low;
+    return *this;
+  }
+
+  /// \brief Divide, rounding the quotient towards zero like the built-in
+  /// integers. The remainder takes the sign of the dividend
+  ///
+  /// \param[in] divisor the value to divide by
+  /// \param[out] result the quotient
+  /// \param[out] remainder the remainder, may be null
+  /// \return Status, Invalid when dividing by zero
+  Status Divide(const Int128& divisor, Int128* result, Int128* remainder = nullptr) const;
+
+  Int128& operator/=(const Int128& divisor) {
+    DCHECK(Divide(divisor, this).ok());
+    return *this;
+  }
+
+  Int128& operator%=(const Int128& divisor) {
+    Int128 quotient;
+    DCHECK(Divide(divisor, &quotient, this).ok());
+    return *this;
+  }
+
+  /// Truncate to the low 64 bits
+  explicit operator int64_t() const { return static_cast<int64_t>(low_bits_); }
+
+  /// \return the base ten representation, with a leading '-' when negative
+  std::string ToString() const;
+
+  /// Full 64x64 to 128-bit unsigned multiplication
+  static void MultiplyWords(
+      uint64_t left, uint64_t right, uint64_t* high, uint64_t* low) {
+#ifdef __SIZEOF_INT128__
+    const unsigned __int128 product = static_cast<unsigned __int128>(left) * right;
+    *high = static_cast<uint64_t>(product >> 64);
+    *low = static_cast<uint64_t>(product);
+#else
+    const uint64_t left_low = left & 0xFFFFFFFFULL, left_high = left >> 32;
+    const uint64_t right_low = right & 0xFFFFFFFFULL, right_high = right >> 32;
+    const uint64_t low_low = left_low * right_low;
+    const uint64_t high_low = left_high * right_low + (low_low >> 32);
+    const uint64_t low_high = left_low * right_high + (high_low & 0xFFFFFFFFULL);
+    *high = left_high * right_high + (high_low >> 32) + (low_high >> 32);
+    *low = (low_high << 32) | (low_low & 0xFFFFFFFFULL);
+#endif
+  }
+
+ private:
+  uint64_t high_bits_;
+  uint64_t low_bits_;
+};
+
+inline Int128 operator-(const Int128& operand) { return Int128(operand).Negate(); }
+inline Int128 operator+(Int128 left, const Int128& right) { return left += right; }
+inline Int128 operator-(Int128 left, const Int128& right) { return left -= right; }
+inline Int128 operator*(Int128 left, const Int128& right) { return left *= right; }
+inline Int128 operator/(Int128 left, const Int128& right) { return left /= right; }
+inline Int128 operator%(Int128 left, const Int128& right) { return left %= right; }
+
+inline bool operator==(const Int128& left, const Int128& right) {
+  return (left.high_bits() == right.high_bits()) & (left.low_bits() == right.low_bits());
+}
+
+inline bool operator!=(const Int128& left, const Int128& right) {
+  return !(left == right);
+}
+
+inline bool operator<(const Int128& left, const Int128& right) {
+  return (left.high_bits() < right.high_bits()) |
+         ((left.high_bits() == right.high_bits()) & (left.low_bits() < right.low_bits()));
+}
+
+inline bool operator<=(const Int128& left, const Int128& right) {
+  return !(right < left);
+}
+
+inline bool operator>(const Int128& left, const Int128& right) { return right < left; }
+
+inline bool operator>=(const Int128& left, const Int128& right) {
+  return !(left < right);
+}
+
+ARROW_EXPORT std::ostream& operator<<(std::ostream& os, const Int128& value);
 
 template <typename T>
 struct ARROW_EXPORT Decimal;
@@ -42,7 +175,19 @@ ARROW_EXPORT void StringToInteger(
 ARROW_EXPORT void StringToInteger(
     const std::string& whole, const std::string& fractional, int8_t sign, int64_t* out);
 ARROW_EXPORT void StringToInteger(
-    const std::string& whole, const std::string& fractional, int8_t sign, int128_t* out);
+    const std::string& whole, const std::string& fractional, int8_t sign, Int128* out);
+
+/// \brief Parse a decimal string of the form [+-]digits[.digits]
+///
+/// \param[in] s the characters to parse, need not be null-terminated
+/// \param[in] length the number of characters
+/// \param[out] out the unscaled value, may be null to only validate s
+/// \param[out] precision the number of significant digits, may be null
+/// \param[out] scale the number of digits after the decimal point, may be null
+/// \return Status, Invalid for malformed input or more digits than T holds
+template <typename T>
+ARROW_EXPORT Status FromString(const char* s, int64_t length, Decimal<T>* out,
+    int* precision = nullptr, int* scale = nullptr);
 
 template <typename T>
 ARROW_EXPORT Status FromString(const std::string& s, Decimal<T>* out,
@@ -61,7 +206,7 @@ struct ARROW_EXPORT Decimal {
 
 using Decimal32 = Decimal<int32_t>;
 using Decimal64 = Decimal<int64_t>;
-using Decimal128 = Decimal<int128_t>;
+using Decimal128 = Decimal<Int128>;
 
 template <typename T>
 struct ARROW_EXPORT DecimalPrecision {};
@@ -79,56 +224,42 @@ struct ARROW_EXPORT DecimalPrecision<int64_t> {
 };
 
 template <>
-struct ARROW_EXPORT DecimalPrecision<int128_t> {
+struct ARROW_EXPORT DecimalPrecision<Int128> {
   constexpr static const int minimum = 19;
   constexpr static const int maximum = 38;
 };
 
+/// Enough room for any decimal FormatDecimal writes: 38 digits, a sign, a
+/// decimal point and a leading zero
+constexpr static const int kMaxDecimalStringLength = 41;
+
+/// \brief Write the string representation of a decimal value
+///
+/// \param[in] decimal_value the unscaled value
+/// \param[in] precision the precision of the decimal type
+/// \param[in] scale the number of digits after the decimal point
+/// \param[out] out at least kMaxDecimalStringLength characters, not
+/// null-terminated
+/// \return the number of characters written
+template <typename T>
+ARROW_EXPORT int FormatDecimal(
+    const Decimal<T>& decimal_value, int precision, int scale, char* out);
+
 template <typename T>
 ARROW_EXPORT std::string ToString(
-    const Decimal<T>& decimal_value, int precision, int scale) {
-  T value = decimal_value.value;
-
-  // Decimal values are sent to clients as strings so in the interest of
-  // speed the string will be created without the using stringstream with the
-  // whole/fractional_part().
-  size_t last_char_idx = precision + (scale > 0)  // Add a space for decimal place
-                         + (scale == precision)   // Add a space for leading 0
-                         + (value < 0);           // Add a space for negative sign
-  std::string str = std::string(last_char_idx, '0');
-  // Start filling in the values in reverse order by taking the last digit
-  // of the value. Use a positive value and worry about the sign later. At this
-  // point the last_char_idx points to the string terminator.
-  T remaining_value = value;
-  size_t first_digit_idx = 0;
-  if (value < 0) {
-    remaining_value = -value;
-    first_digit_idx = 1;
-  }
-  if (scale > 0) {
-    int remaining_scale = scale;
-    do {
-      str[--last_char_idx] = static_cast<char>(
-          (remaining_value % 10) + static_cast<T>('0'));  // Ascii offset
-      remaining_value /= 10;
-    } while (--remaining_scale > 0);
-    str[--last_char_idx] = '.';
-    DCHECK_GT(last_char_idx, first_digit_idx) << "Not enough space remaining";
-  }
-  do {
-    str[--last_char_idx] =
-        static_cast<char>((remaining_value % 10) + static_cast<T>('0'));  // Ascii offset
-    remaining_value /= 10;
-    if (remaining_value == 0) {
-      // Trim any extra leading 0's.
-      if (last_char_idx > first_digit_idx) str.erase(0, last_char_idx - first_digit_idx);
-      break;
-    }
-    // For safety, enforce string length independent of remaining_value.
-  } while (last_char_idx > first_digit_idx);
-  if (value < 0) str[0] = '-';
-  return str;
-}
+    const Decimal<T>& decimal_value, int precision, int scale);
+
+/// \brief Change the scale of a decimal value, multiplying or dividing the
+/// unscaled value by a power of ten
+///
+/// \return Status, Invalid when reducing the scale would drop nonzero digits
+/// or the rescaled value does not fit T
+template <typename T>
+ARROW_EXPORT Status Rescale(
+    const Decimal<T>& value, int original_scale, int new_scale, Decimal<T>* out);
+
+/// \return ten to the given power, which is at most 38
+ARROW_EXPORT Int128 PowerOfTen(int exponent);
 
 /// Conversion from raw bytes to a Decimal value
 ARROW_EXPORT void FromBytes(const uint8_t* bytes, Decimal32* value);
@@ -0,0 +1,92 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "gtest/gtest.h"
+
+#include "arrow/util/cpu-info.h"
+#include "arrow/util/dispatch.h"
+
+namespace arrow {
+
+static int ScalarVersion() { return 0; }
+static int Sse42Version() { return 1; }
+static int Avx2Version() { return 2; }
+static int Avx512Version() { return 3; }
+
+typedef int (*VersionFunc)();
+
+TEST(CpuInfo, FlagImplications) {
+  CpuInfo::Init();
+  if (CpuInfo::IsSupported(CpuInfo::AVX2)) {
+    ASSERT_TRUE(CpuInfo::IsSupported(CpuInfo::AVX));
+  }
+  if (CpuInfo::IsSupported(CpuInfo::AVX512BW) ||
+      CpuInfo::IsSupported(CpuInfo::AVX512VL)) {
+    ASSERT_TRUE(CpuInfo::IsSupported(CpuInfo::AVX512F));
+  }
+  if (CpuInfo::IsSupported(CpuInfo::AVX512F)) {
+    ASSERT_TRUE(CpuInfo::IsSupported(CpuInfo::AVX2));
+  }
+}
+
+TEST(DynamicDispatch, SupportedLevels) {
+  ASSERT_TRUE(IsDispatchLevelSupported(DispatchLevel::NONE));
+  ASSERT_TRUE(IsDispatchLevelSupported(MaxDispatchLevel()));
+  // Levels are cumulative
+  const DispatchLevel levels[] = {DispatchLevel::NONE, DispatchLevel::SSE4_2,
+      DispatchLevel::AVX2, DispatchLevel::AVX512};
+  for (int i = 1; i < 4; ++i) {
+    if (IsDispatchLevelSupported(levels[i])) {
+      ASSERT_TRUE(IsDispatchLevelSupported(levels[i - 1]));
+    }
+  }
+}
+
+TEST(DynamicDispatch, PicksHighestAllowedVersion) {
+  const std::initializer_list<DynamicDispatch<VersionFunc>::Version> versions = {
+      {DispatchLevel::NONE, ScalarVersion}, {DispatchLevel::AVX2, Avx2Version},
+      {DispatchLevel::SSE4_2, Sse42Version}, {DispatchLevel::AVX512, Avx512Version}};
+
+  DynamicDispatch<VersionFunc> none(versions, DispatchLevel::NONE);
+  ASSERT_EQ(0, none.func());
+  ASSERT_EQ(DispatchLevel::NONE, none.level);
+
+  DynamicDispatch<VersionFunc> sse42(versions, DispatchLevel::SSE4_2);
+  ASSERT_EQ(1, sse42.func());
+
+  DynamicDispatch<VersionFunc> avx2(versions, DispatchLevel::AVX2);
+  ASSERT_EQ(2, avx2.func());
+  ASSERT_EQ(DispatchLevel::AVX2, avx2.level);
+
+  DynamicDispatch<VersionFunc> avx512(versions, DispatchLevel::AVX512);
+  ASSERT_EQ(3, avx512.func());
+}
+
+TEST(DynamicDispatch, FallsBackToLowerVersion) {
+  // No SSE4.2 or AVX2 version, an AVX2 CPU uses the scalar one
+  DynamicDispatch<VersionFunc> dispatch(
+      {{DispatchLevel::NONE, ScalarVersion}, {DispatchLevel::AVX512, Avx512Version}},
+      DispatchLevel::AVX2);
+  ASSERT_EQ(0, dispatch.func());
+  ASSERT_EQ(DispatchLevel::NONE, dispatch.level);
+
+  DynamicDispatch<VersionFunc> host(
+      {{DispatchLevel::NONE, ScalarVersion}, {DispatchLevel::AVX512, Avx512Version}});
+  ASSERT_EQ(MaxDispatchLevel() >= DispatchLevel::AVX512 ? 3 : 0, host.func());
+}
+
+}  // namespace arrow
@@ -0,0 +1,93 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/util/dispatch.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+#include "arrow/util/cpu-info.h"
+#include "arrow/util/logging.h"
+
+namespace arrow {
+
+namespace {
+
+DispatchLevel DetectMaxDispatchLevel() {
+  DispatchLevel level = DispatchLevel::NONE;
+  for (DispatchLevel candidate :
+      {DispatchLevel::SSE4_2, DispatchLevel::AVX2, DispatchLevel::AVX512}) {
+    if (!IsDispatchLevelSupported(candidate)) { break; }
+    level = candidate;
+  }
+
+  const char* user_level = std::getenv("ARROW_USER_SIMD_LEVEL");
+  if (user_level == nullptr) { return level; }
+  const std::string name(user_level);
+  DispatchLevel cap;
+  if (name == "none") {
+    cap = DispatchLevel::NONE;
+  } else if (name == "sse4_2") {
+    cap = DispatchLevel::SSE4_2;
+  } else if (name == "avx2") {
+    cap = DispatchLevel::AVX2;
+  } else if (name == "avx512") {
+    cap = DispatchLevel::AVX512;
+  } else {
+    ARROW_LOG(WARNING) << "Ignoring invalid ARROW_USER_SIMD_LEVEL: " << name;
+    return level;
+  }
+  return std::min(level, cap);
+}
+
+}  // namespace
+
+bool IsDispatchLevelSupported(DispatchLevel level) {
+  if (!CpuInfo::initialized()) { CpuInfo::Init(); }
+  switch (level) {
+    case DispatchLevel::NONE:
+      return true;
+    case DispatchLevel::SSE4_2:
+      return CpuInfo::IsSupported(CpuInfo::SSE4_2) &&
+             CpuInfo::IsSupported(CpuInfo::POPCNT);
+    case DispatchLevel::AVX2:
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+      return IsDispatchLevelSupported(DispatchLevel::SSE4_2) &&
+             CpuInfo::IsSupported(CpuInfo::AVX2) && CpuInfo::IsSupported(CpuInfo::BMI2);
+#else
+      return false;
+#endif
+    case DispatchLevel::AVX512:
+#ifdef ARROW_HAVE_RUNTIME_AVX512
+      return IsDispatchLevelSupported(DispatchLevel::AVX2) &&
+             CpuInfo::IsSupported(CpuInfo::AVX512F) &&
+             CpuInfo::IsSupported(CpuInfo::AVX512BW) &&
+             CpuInfo::IsSupported(CpuInfo::AVX512VL);
+#else
+      return false;
+#endif
+  }
+  return false;
+}
+
+DispatchLevel MaxDispatchLevel() {
+  static const DispatchLevel level = DetectMaxDispatchLevel();
+  return level;
+}
+
+}  // namespace arrow
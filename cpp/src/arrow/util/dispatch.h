@@ -0,0 +1,111 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Runtime selection between versions of a kernel compiled for different
+// instruction sets
+
+#ifndef ARROW_UTIL_DISPATCH_H
+#define ARROW_UTIL_DISPATCH_H
+
+#include <initializer_list>
+
+#include "arrow/util/visibility.h"
+
+// GCC and clang compile single functions for instruction sets beyond those
+// of the build target through target attributes. Such functions may only be
+// called once the dispatcher has checked that the CPU supports them
+#if defined(__GNUC__) && defined(__x86_64__)
+#define ARROW_HAVE_RUNTIME_SSE4_2
+#define ARROW_HAVE_RUNTIME_AVX2
+#define ARROW_TARGET_POPCNT __attribute__((target("popcnt")))
+#define ARROW_TARGET_SSE4_2 __attribute__((target("sse4.2,popcnt")))
+#define ARROW_TARGET_AVX2 __attribute__((target("avx2,bmi2,popcnt")))
+#if defined(__clang__) || __GNUC__ >= 5
+#define ARROW_HAVE_RUNTIME_AVX512
+#define ARROW_TARGET_AVX512 \
+  __attribute__((target("avx512f,avx512bw,avx512vl,avx2,bmi2,popcnt")))
+#endif
+#endif
+
+namespace arrow {
+
+/// Instruction set levels a kernel can be compiled for, in increasing order
+enum class DispatchLevel : int {
+  /// The build target, no runtime requirement
+  NONE = 0,
+  /// SSE4.2 and POPCNT
+  SSE4_2,
+  /// AVX2 and BMI2
+  AVX2,
+  /// AVX-512 F, BW and VL
+  AVX512
+};
+
+/// \brief Whether the CPU supports every instruction set of a level
+ARROW_EXPORT bool IsDispatchLevelSupported(DispatchLevel level);
+
+/// \brief The highest level kernels are dispatched to: the highest level the
+/// CPU supports, capped by the ARROW_USER_SIMD_LEVEL environment variable
+/// (one of "none", "sse4_2", "avx2" or "avx512") if set. Computed once
+ARROW_EXPORT DispatchLevel MaxDispatchLevel();
+
+/// \brief A kernel resolved once to the best version for the CPU
+///
+/// Each version is tagged with the level it requires; the highest one not
+/// above MaxDispatchLevel() wins. A version for DispatchLevel::NONE must be
+/// given. Typically a function-local static, so the choice is made on first
+/// use and costs a single indirect call afterwards:
+///
+///   static DynamicDispatch<UnpackFunc> dispatch(
+///       {{DispatchLevel::NONE, UnpackScalar}, {DispatchLevel::AVX2, UnpackAvx2}});
+///   return dispatch.func(in, out, n);
+template <typename FunctionType>
+class DynamicDispatch {
+ public:
+  struct Version {
+    DispatchLevel level;
+    FunctionType func;
+  };
+
+  explicit DynamicDispatch(std::initializer_list<Version> versions)
+      : func(nullptr), level(DispatchLevel::NONE) {
+    Resolve(versions, MaxDispatchLevel());
+  }
+
+  DynamicDispatch(std::initializer_list<Version> versions, DispatchLevel max_level)
+      : func(nullptr), level(DispatchLevel::NONE) {
+    Resolve(versions, max_level);
+  }
+
+  /// The chosen version and its level
+  FunctionType func;
+  DispatchLevel level;
+
+ private:
+  void Resolve(std::initializer_list<Version> versions, DispatchLevel max_level) {
+    for (const Version& version : versions) {
+      if (version.level <= max_level && (func == nullptr || version.level >= level)) {
+        func = version.func;
+        level = version.level;
+      }
+    }
+  }
+};
+
+}  // namespace arrow
+
+#endif  // ARROW_UTIL_DISPATCH_H
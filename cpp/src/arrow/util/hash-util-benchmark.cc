@@ -0,0 +1,115 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "benchmark/benchmark.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/buffer.h"
+#include "arrow/builder.h"
+#include "arrow/test-util.h"
+#include "arrow/util/hash-util.h"
+
+namespace arrow {
+
+static constexpr int64_t kNumValues = 1 << 16;
+
+static std::shared_ptr<Array> MakeInt64Input() {
+  std::vector<int64_t> values(kNumValues);
+  test::randint<int64_t>(kNumValues, 0, 1 << 30, &values);
+  Int64Builder builder(default_memory_pool());
+  ABORT_NOT_OK(builder.Append(values.data(), kNumValues));
+  std::shared_ptr<Array> array;
+  ABORT_NOT_OK(builder.Finish(&array));
+  return array;
+}
+
+// kNumValues random strings of the given length. The buffers are filled
+// directly, appending large strings one by one to a builder is slow
+static std::shared_ptr<Array> MakeStringInput(int length) {
+  std::vector<uint8_t> bytes(kNumValues * length);
+  test::random_bytes(bytes.size(), 0, bytes.data());
+  std::vector<int32_t> offsets(kNumValues + 1);
+  for (int64_t i = 0; i <= kNumValues; ++i) {
+    offsets[i] = static_cast<int32_t>(i * length);
+  }
+  MemoryPool* pool = default_memory_pool();
+  std::shared_ptr<Buffer> offsets_buffer, data_buffer;
+  ABORT_NOT_OK(test::CopyBufferFromVector(offsets, pool, &offsets_buffer));
+  ABORT_NOT_OK(test::CopyBufferFromVector(bytes, pool, &data_buffer));
+  return std::make_shared<StringArray>(kNumValues, offsets_buffer, data_buffer);
+}
+
+// Baseline: the value-at-a-time hash used before HashArray
+static void BM_MurmurInt64(benchmark::State& state) {  // NOLINT non-const reference
+  auto array = MakeInt64Input();
+  const int64_t* values = static_cast<const Int64Array&>(*array).raw_values();
+  std::vector<uint64_t> hashes(kNumValues);
+  while (state.KeepRunning()) {
+    for (int64_t i = 0; i < kNumValues; ++i) {
+      hashes[i] = HashUtil::MurmurHash2_64(values + i, sizeof(int64_t), 0);
+    }
+    benchmark::DoNotOptimize(hashes.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+static void BM_HashArrayInt64(benchmark::State& state) {  // NOLINT non-const reference
+  auto array = MakeInt64Input();
+  std::vector<uint64_t> hashes(kNumValues);
+  while (state.KeepRunning()) {
+    ABORT_NOT_OK(HashUtil::HashArray(*array, hashes.data()));
+    benchmark::DoNotOptimize(hashes.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+static void BM_MurmurStrings(benchmark::State& state) {  // NOLINT non-const reference
+  auto array = MakeStringInput(static_cast<int>(state.range(0)));
+  const auto& strings = static_cast<const StringArray&>(*array);
+  std::vector<uint64_t> hashes(kNumValues);
+  int32_t length;
+  while (state.KeepRunning()) {
+    for (int64_t i = 0; i < kNumValues; ++i) {
+      const uint8_t* value = strings.GetValue(i, &length);
+      hashes[i] = HashUtil::MurmurHash2_64(value, length, 0);
+    }
+    benchmark::DoNotOptimize(hashes.data());
+  }
+  state.SetBytesProcessed(state.iterations() * kNumValues * state.range(0));
+}
+
+static void BM_HashArrayStrings(benchmark::State& state) {  // NOLINT non-const reference
+  auto array = MakeStringInput(static_cast<int>(state.range(0)));
+  std::vector<uint64_t> hashes(kNumValues);
+  while (state.KeepRunning()) {
+    ABORT_NOT_OK(HashUtil::HashArray(*array, hashes.data()));
+    benchmark::DoNotOptimize(hashes.data());
+  }
+  state.SetBytesProcessed(state.iterations() * kNumValues * state.range(0));
+}
+
+BENCHMARK(BM_MurmurInt64);
+BENCHMARK(BM_HashArrayInt64);
+BENCHMARK(BM_MurmurStrings)->Arg(8)->Arg(32)->Arg(256);
+BENCHMARK(BM_HashArrayStrings)->Arg(8)->Arg(32)->Arg(256);
+
+}  // namespace arrow
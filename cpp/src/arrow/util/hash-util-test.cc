@@ -0,0 +1,211 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "arrow/array.h"
+#include "arrow/buffer.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/test-util.h"
+#include "arrow/type.h"
+#include "arrow/util/bit-util.h"
+#include "arrow/util/hash-util.h"
+
+namespace arrow {
+
+std::vector<uint64_t> HashArray(const Array& array, uint64_t seed = 0) {
+  std::vector<uint64_t> hashes(array.length());
+  EXPECT_OK(HashUtil::HashArray(array, hashes.data(), seed));
+  return hashes;
+}
+
+TEST(HashUtil, HashBytesMatchesScalar) {
+  std::mt19937_64 gen(42);
+  std::vector<uint8_t> data(200);
+  for (auto& byte : data) {
+    byte = static_cast<uint8_t>(gen());
+  }
+  for (int64_t length = 0; length <= 100; ++length) {
+    for (int64_t offset : {0, 1, 7}) {
+      const uint64_t seed = gen();
+      ASSERT_EQ(HashUtil::HashBytesScalar(data.data() + offset, length, seed),
+          HashUtil::HashBytes(data.data() + offset, length, seed))
+          << "length=" << length;
+    }
+  }
+}
+
+TEST(HashUtil, HashBytesDistinguishes) {
+  // Trailing zero bytes, one flipped bit and the seed all change the hash
+  std::unordered_set<uint64_t> hashes;
+  std::vector<uint8_t> data(64, 0);
+  for (int64_t length = 0; length <= 64; ++length) {
+    ASSERT_TRUE(hashes.insert(HashUtil::HashBytes(data.data(), length, 0)).second);
+  }
+  for (int64_t length : {12, 20, 64}) {
+    for (int bit = 0; bit < length * 8; ++bit) {
+      data[bit / 8] ^= static_cast<uint8_t>(1 << (bit % 8));
+      ASSERT_TRUE(hashes.insert(HashUtil::HashBytes(data.data(), length, 0)).second);
+      data[bit / 8] ^= static_cast<uint8_t>(1 << (bit % 8));
+    }
+  }
+  ASSERT_NE(
+      HashUtil::HashBytes(data.data(), 30, 1), HashUtil::HashBytes(data.data(), 30, 2));
+}
+
+template <typename ArrowType>
+void CheckIntegerHashes() {
+  using c_type = typename ArrowType::c_type;
+  using unsigned_type = typename std::make_unsigned<c_type>::type;
+  const int64_t length = 103;
+  std::vector<c_type> values;
+  std::vector<bool> is_valid;
+  for (int64_t i = 0; i < length; ++i) {
+    values.push_back(static_cast<c_type>(i * 37 - 50));
+    is_valid.push_back(i % 7 != 3);
+  }
+  std::shared_ptr<Array> array;
+  ArrayFromVector<ArrowType, c_type>(is_valid, values, &array);
+
+  const uint64_t seed = 12345;
+  for (int64_t offset : {0, 1, 5}) {
+    auto slice = array->Slice(offset);
+    std::vector<uint64_t> hashes = HashArray(*slice, seed);
+    for (int64_t i = 0; i < slice->length(); ++i) {
+      const uint64_t expected =
+          is_valid[offset + i]
+              ? HashUtil::HashInt(static_cast<unsigned_type>(values[offset + i]), seed)
+              : HashUtil::NullHash(seed);
+      ASSERT_EQ(expected, hashes[i]) << "offset=" << offset << " i=" << i;
+    }
+  }
+}
+
+TEST(HashUtil, HashArrayIntegers) {
+  CheckIntegerHashes<Int8Type>();
+  CheckIntegerHashes<UInt16Type>();
+  CheckIntegerHashes<Int32Type>();
+  CheckIntegerHashes<Int64Type>();
+}
+
+TEST(HashUtil, HashArrayIntegersDistinct) {
+  std::vector<int64_t> values;
+  for (int64_t i = 0; i < 100000; ++i) {
+    values.push_back(i << 20);
+  }
+  std::shared_ptr<Array> array;
+  ArrayFromVector<Int64Type, int64_t>(values, &array);
+  std::vector<uint64_t> hashes = HashArray(*array);
+  // The low bits, used to index hash tables, are spread too
+  std::unordered_set<uint64_t> low_bits;
+  for (uint64_t hash : hashes) {
+    low_bits.insert(hash & 0xffff);
+  }
+  ASSERT_GT(low_bits.size(), 50000);
+  ASSERT_EQ(
+      hashes.size(), std::unordered_set<uint64_t>(hashes.begin(), hashes.end()).size());
+}
+
+TEST(HashUtil, HashArrayStrings) {
+  std::vector<std::string> values = {"", "a", "abcdefgh", "abcdefghi",
+      "a string longer than sixteen bytes", "", "a"};
+  std::vector<bool> is_valid = {true, true, true, true, true, false, true};
+  std::shared_ptr<Array> array;
+  ArrayFromVector<StringType, std::string>(is_valid, values, &array);
+
+  std::vector<uint64_t> hashes = HashArray(*array->Slice(1), 7);
+  ASSERT_EQ(HashUtil::HashBytes("a", 1, 7), hashes[0]);
+  ASSERT_EQ(hashes[0], hashes[5]);
+  ASSERT_EQ(HashUtil::NullHash(7), hashes[4]);
+  ASSERT_EQ(HashUtil::HashBytes(values[4].data(), values[4].size(), 7), hashes[3]);
+  ASSERT_NE(HashArray(*array)[0], HashUtil::NullHash(0));
+}
+
+TEST(HashUtil, HashArrayOtherTypes) {
+  std::shared_ptr<Array> array;
+  ArrayFromVector<BooleanType, bool>({true, false, true}, {true, false, false}, &array);
+  std::vector<uint64_t> hashes = HashArray(*array);
+  ASSERT_EQ(HashUtil::HashInt(1, 0), hashes[0]);
+  ASSERT_EQ(HashUtil::NullHash(0), hashes[1]);
+  ASSERT_EQ(HashUtil::HashInt(0, 0), hashes[2]);
+
+  ArrayFromVector<DoubleType, double>({1.5, -0.0, 0.0}, &array);
+  hashes = HashArray(*array);
+  ASSERT_NE(hashes[1], hashes[2]);
+
+  NullArray nulls(3);
+  ASSERT_EQ(std::vector<uint64_t>(3, HashUtil::NullHash(3)), HashArray(nulls, 3));
+
+  std::shared_ptr<Array> values, offsets;
+  ArrayFromVector<Int32Type, int32_t>({1, 2}, &values);
+  ArrayFromVector<Int32Type, int32_t>({0, 2}, &offsets);
+  std::shared_ptr<Array> list;
+  ASSERT_OK(ListArray::FromArrays(*offsets, *values, default_memory_pool(), &list));
+  std::vector<uint64_t> out(list->length());
+  ASSERT_RAISES(NotImplemented, HashUtil::HashArray(*list, out.data()));
+}
+
+TEST(HashUtil, HashArrayAllNullWithoutValues) {
+  // All-null arrays may have no values buffer
+  std::shared_ptr<MutableBuffer> null_bitmap;
+  ASSERT_OK(GetEmptyBitmap(default_memory_pool(), 5, &null_bitmap));
+  const std::vector<uint64_t> expected(5, HashUtil::NullHash(0));
+  ASSERT_EQ(expected, HashArray(Int64Array(5, nullptr, null_bitmap, 5)));
+  ASSERT_EQ(expected, HashArray(BooleanArray(5, nullptr, null_bitmap, 5)));
+  ASSERT_EQ(expected, HashArray(StringArray(5, nullptr, nullptr, null_bitmap, 5)));
+  ASSERT_EQ(expected, HashArray(FixedSizeBinaryArray(
+                          fixed_size_binary(3), 5, nullptr, null_bitmap, 5)));
+}
+
+TEST(HashUtil, HashArrayDictionary) {
+  // Dictionary-encoded values hash like the decoded values
+  std::shared_ptr<Array> dict, indices, decoded;
+  ArrayFromVector<StringType, std::string>({"foo", "bar", "baz"}, &dict);
+  ArrayFromVector<Int8Type, int8_t>(
+      {true, true, false, true, true}, {2, 0, 0, 1, 2}, &indices);
+  ArrayFromVector<StringType, std::string>(
+      {true, true, false, true, true}, {"baz", "foo", "", "bar", "baz"}, &decoded);
+  DictionaryArray encoded(dictionary(int8(), dict), indices);
+  ASSERT_EQ(HashArray(*decoded, 3), HashArray(encoded, 3));
+}
+
+TEST(HashUtil, CombineHashArray) {
+  std::shared_ptr<Array> a, b;
+  ArrayFromVector<Int32Type, int32_t>({1, 2, 1, 2}, &a);
+  ArrayFromVector<StringType, std::string>({"x", "x", "x", "y"}, &b);
+
+  std::vector<uint64_t> hashes = HashArray(*a);
+  ASSERT_OK(HashUtil::CombineHashArray(*b, hashes.data()));
+  ASSERT_EQ(hashes[0], hashes[2]);
+  ASSERT_NE(hashes[0], hashes[1]);
+  ASSERT_NE(hashes[1], hashes[3]);
+
+  // The order of the columns matters
+  std::vector<uint64_t> swapped = HashArray(*b);
+  ASSERT_OK(HashUtil::CombineHashArray(*a, swapped.data()));
+  ASSERT_NE(hashes[0], swapped[0]);
+}
+
+}  // namespace arrow
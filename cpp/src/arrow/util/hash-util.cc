@@ -0,0 +1,448 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/util/hash-util.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include "arrow/array.h"
+#include "arrow/status.h"
+#include "arrow/type.h"
+#include "arrow/util/bit-util.h"
+#include "arrow/util/dispatch.h"
+
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+#include <immintrin.h>
+#endif
+
+namespace arrow {
+
+namespace {
+
+// ----------------------------------------------------------------------
+// CRC32C of 64-bit words, as computed by the SSE4.2 crc32q instruction
+// (reflected Castagnoli polynomial, without pre- or post-inversion)
+
+class Crc32cTable {
+ public:
+  Crc32cTable() {
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t crc = i;
+      for (int k = 0; k < 8; ++k) {
+        crc = (crc >> 1) ^ (0x82f63b78U & (0U - (crc & 1)));
+      }
+      entries_[0][i] = crc;
+    }
+    for (int j = 1; j < 8; ++j) {
+      for (uint32_t i = 0; i < 256; ++i) {
+        const uint32_t prev = entries_[j - 1][i];
+        entries_[j][i] = (prev >> 8) ^ entries_[0][prev & 0xff];
+      }
+    }
+  }
+
+  // Slicing-by-8: one lookup per byte of the word, all independent
+  uint32_t Update(uint32_t crc, uint64_t word) const {
+    word ^= crc;
+    return entries_[7][word & 0xff] ^ entries_[6][(word >> 8) & 0xff] ^
+           entries_[5][(word >> 16) & 0xff] ^ entries_[4][(word >> 24) & 0xff] ^
+           entries_[3][(word >> 32) & 0xff] ^ entries_[2][(word >> 40) & 0xff] ^
+           entries_[1][(word >> 48) & 0xff] ^ entries_[0][word >> 56];
+  }
+
+ private:
+  uint32_t entries_[8][256];
+};
+
+struct TableCrc32c {
+  TableCrc32c() : table(Instance()) {}
+
+  uint32_t operator()(uint32_t crc, uint64_t word) const {
+    return table.Update(crc, word);
+  }
+
+  static const Crc32cTable& Instance() {
+    static const Crc32cTable instance;
+    return instance;
+  }
+
+  const Crc32cTable& table;
+};
+
+#ifdef ARROW_HAVE_RUNTIME_SSE4_2
+// Inline assembly rather than the intrinsic, which would need the caller to
+// be compiled for SSE4.2 as well. Only reached once the CPU is checked
+struct HardwareCrc32c {
+  uint32_t operator()(uint32_t crc, uint64_t word) const {
+    uint64_t result = crc;
+    __asm__("crc32q %1, %0" : "+r"(result) : "rm"(word));
+    return static_cast<uint32_t>(result);
+  }
+};
+#endif
+
+// ----------------------------------------------------------------------
+// Byte strings
+
+inline uint64_t LoadWord(const uint8_t* data) {
+  uint64_t word;
+  memcpy(&word, data, sizeof(word));
+  return word;
+}
+
+inline uint32_t LoadHalfWord(const uint8_t* data) {
+  uint32_t word;
+  memcpy(&word, data, sizeof(word));
+  return word;
+}
+
+inline uint64_t RotateLeft(uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+// Short strings are folded into a single word from two possibly overlapping
+// loads, avoiding a loop or a variable-length copy. Up to 8 bytes the fold
+// is lossless, the length is mixed in through the seed
+template <typename Crc>
+inline uint64_t HashBytesImpl(
+    const uint8_t* data, int64_t length, uint64_t seed, const Crc& crc) {
+  const uint64_t length_seed =
+      seed ^ (static_cast<uint64_t>(length) * 0x9e3779b97f4a7c15ULL);
+  if (length <= 16) {
+    uint64_t word = 0;
+    if (length > 8) {
+      // Shift out the bytes shared with the first word
+      const uint64_t high = LoadWord(data + length - 8) >> (128 - 8 * length);
+      word = LoadWord(data) ^ RotateLeft(high * 0xc2b2ae3d27d4eb4fULL, 32);
+    } else if (length >= 4) {
+      word = LoadHalfWord(data) |
+             (static_cast<uint64_t>(LoadHalfWord(data + length - 4)) << 32);
+    } else if (length > 0) {
+      word = data[0] | (data[length / 2] << 8) | (data[length - 1] << 16);
+    }
+    return HashUtil::HashInt(word, length_seed);
+  }
+
+  // Every stream depends on a different part of the seed
+  uint32_t crc0 = static_cast<uint32_t>(seed);
+  uint32_t crc1 = static_cast<uint32_t>(seed >> 32);
+  uint32_t crc2 = crc0 ^ 0x6b43a9b5U;
+  const uint8_t* end = data + length;
+  for (; end - data >= 24; data += 24) {
+    crc0 = crc(crc0, LoadWord(data));
+    crc1 = crc(crc1, LoadWord(data + 8));
+    crc2 = crc(crc2, LoadWord(data + 16));
+  }
+  if (end - data >= 8) {
+    crc0 = crc(crc0, LoadWord(data));
+    data += 8;
+  }
+  if (end - data >= 8) {
+    crc1 = crc(crc1, LoadWord(data));
+    data += 8;
+  }
+  // The last word overlaps bytes already hashed
+  if (end > data) { crc2 = crc(crc2, LoadWord(end - 8)); }
+
+  const uint64_t crc01 = (static_cast<uint64_t>(crc0) << 32) | crc1;
+  return HashUtil::HashInt(crc01 ^ (crc2 * 0xc2b2ae3d27d4eb4fULL), length_seed);
+}
+
+template <typename Crc>
+void HashBinaryValues(const BinaryArray& array, uint64_t seed, uint64_t* out) {
+  const Crc crc;
+  int32_t length;
+  for (int64_t i = 0; i < array.length(); ++i) {
+    const uint8_t* value = array.GetValue(i, &length);
+    out[i] = HashBytesImpl(value, length, seed, crc);
+  }
+}
+
+template <typename Crc>
+void HashFixedSizeValues(const uint8_t* values, int32_t byte_width, int64_t length,
+    uint64_t seed, uint64_t* out) {
+  const Crc crc;
+  for (int64_t i = 0; i < length; ++i) {
+    out[i] = HashBytesImpl(values + i * byte_width, byte_width, seed, crc);
+  }
+}
+
+typedef uint64_t (*HashBytesFunc)(const void*, int64_t, uint64_t);
+typedef void (*HashBinaryFunc)(const BinaryArray&, uint64_t, uint64_t*);
+typedef void (*HashFixedSizeFunc)(const uint8_t*, int32_t, int64_t, uint64_t, uint64_t*);
+
+#ifdef ARROW_HAVE_RUNTIME_SSE4_2
+uint64_t HashBytesSse42(const void* data, int64_t length, uint64_t seed) {
+  return HashBytesImpl(
+      reinterpret_cast<const uint8_t*>(data), length, seed, HardwareCrc32c());
+}
+#endif
+
+// Whole arrays are dispatched at once, so that the hash of every value is
+// inlined into the loop
+void HashBinary(const BinaryArray& array, uint64_t seed, uint64_t* out) {
+  static DynamicDispatch<HashBinaryFunc> dispatch({
+      {DispatchLevel::NONE, HashBinaryValues<TableCrc32c>},
+#ifdef ARROW_HAVE_RUNTIME_SSE4_2
+      {DispatchLevel::SSE4_2, HashBinaryValues<HardwareCrc32c>},
+#endif
+  });
+  dispatch.func(array, seed, out);
+}
+
+void HashFixedSize(const uint8_t* values, int32_t byte_width, int64_t length,
+    uint64_t seed, uint64_t* out) {
+  static DynamicDispatch<HashFixedSizeFunc> dispatch({
+      {DispatchLevel::NONE, HashFixedSizeValues<TableCrc32c>},
+#ifdef ARROW_HAVE_RUNTIME_SSE4_2
+      {DispatchLevel::SSE4_2, HashFixedSizeValues<HardwareCrc32c>},
+#endif
+  });
+  dispatch.func(values, byte_width, length, seed, out);
+}
+
+// ----------------------------------------------------------------------
+// Integers, zero-extended to 64 bits
+
+template <typename T>
+void HashIntegersScalar(const T* values, int64_t length, uint64_t seed, uint64_t* out) {
+  for (int64_t i = 0; i < length; ++i) {
+    out[i] = HashUtil::HashInt(static_cast<uint64_t>(values[i]), seed);
+  }
+}
+
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+
+// Multiply 64-bit lanes by a constant, from 32-bit multiplies: the high
+// half of the product of the high halves does not reach the result
+ARROW_TARGET_AVX2 inline __m256i MultiplyLanes(__m256i a, __m256i b, __m256i b_high) {
+  const __m256i low = _mm256_mul_epu32(a, b);
+  const __m256i cross = _mm256_add_epi64(
+      _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b), _mm256_mul_epu32(a, b_high));
+  return _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+}
+
+// HashUtil::HashInt() of four lanes
+ARROW_TARGET_AVX2 inline __m256i HashLanes(__m256i values, __m256i seed) {
+  const __m256i m1 = _mm256_set1_epi64x(static_cast<int64_t>(0xff51afd7ed558ccdULL));
+  const __m256i m1_high = _mm256_srli_epi64(m1, 32);
+  const __m256i m2 = _mm256_set1_epi64x(static_cast<int64_t>(0xc4ceb9fe1a85ec53ULL));
+  const __m256i m2_high = _mm256_srli_epi64(m2, 32);
+  __m256i h = _mm256_xor_si256(values, seed);
+  h = _mm256_xor_si256(h, _mm256_srli_epi64(h, 33));
+  h = MultiplyLanes(h, m1, m1_high);
+  h = _mm256_xor_si256(h, _mm256_srli_epi64(h, 33));
+  h = MultiplyLanes(h, m2, m2_high);
+  return _mm256_xor_si256(h, _mm256_srli_epi64(h, 33));
+}
+
+ARROW_TARGET_AVX2 inline __m256i LoadLanes(const uint8_t* values) {
+  int32_t word;
+  memcpy(&word, values, sizeof(word));
+  return _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(word));
+}
+
+ARROW_TARGET_AVX2 inline __m256i LoadLanes(const uint16_t* values) {
+  return _mm256_cvtepu16_epi64(
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(values)));
+}
+
+ARROW_TARGET_AVX2 inline __m256i LoadLanes(const uint32_t* values) {
+  return _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values)));
+}
+
+ARROW_TARGET_AVX2 inline __m256i LoadLanes(const uint64_t* values) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+}
+
+template <typename T>
+ARROW_TARGET_AVX2 void HashIntegersAvx2(
+    const T* values, int64_t length, uint64_t seed, uint64_t* out) {
+  // HashInt() folds a constant into the seed
+  const __m256i lane_seed =
+      _mm256_set1_epi64x(static_cast<int64_t>(seed ^ 0x2545f4914f6cdd1dULL));
+  int64_t i = 0;
+  for (; i + 4 <= length; i += 4) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+        HashLanes(LoadLanes(values + i), lane_seed));
+  }
+  HashIntegersScalar(values + i, length - i, seed, out + i);
+}
+
+#endif  // ARROW_HAVE_RUNTIME_AVX2
+
+template <typename T>
+void HashIntegers(const T* values, int64_t length, uint64_t seed, uint64_t* out) {
+  typedef void (*HashIntegersFunc)(const T*, int64_t, uint64_t, uint64_t*);
+  static DynamicDispatch<HashIntegersFunc> dispatch({
+      {DispatchLevel::NONE, HashIntegersScalar<T>},
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+      {DispatchLevel::AVX2, HashIntegersAvx2<T>},
+#endif
+  });
+  dispatch.func(values, length, seed, out);
+}
+
+// ----------------------------------------------------------------------
+// Arrays
+
+template <typename T>
+void HashFixedWidth(const Array& array, uint64_t seed, uint64_t* out) {
+  // Empty and all-null arrays may have no data buffer
+  if (array.length() == 0 || !array.data()->buffers[1]) { return; }
+  const T* values =
+      reinterpret_cast<const T*>(array.data()->buffers[1]->data()) + array.offset();
+  HashIntegers(values, array.length(), seed, out);
+}
+
+template <typename IndexType>
+void GatherDictionaryHashes(const Array& indices, const uint64_t* value_hashes,
+    uint64_t null_hash, uint64_t* out) {
+  const auto& typed = static_cast<const NumericArray<IndexType>&>(indices);
+  const auto* values = typed.raw_values();
+  for (int64_t i = 0; i < typed.length(); ++i) {
+    out[i] = typed.IsNull(i) ? null_hash : value_hashes[values[i]];
+  }
+}
+
+Status HashDictionary(const DictionaryArray& array, uint64_t seed, uint64_t* out) {
+  // Dictionary values are hashed once and gathered by index
+  const Array& dictionary = *array.dictionary();
+  std::vector<uint64_t> value_hashes(dictionary.length());
+  RETURN_NOT_OK(HashUtil::HashArray(dictionary, value_hashes.data(), seed));
+  const uint64_t null_hash = HashUtil::NullHash(seed);
+  const Array& indices = *array.indices();
+  switch (indices.type_id()) {
+    case Type::INT8:
+      GatherDictionaryHashes<Int8Type>(indices, value_hashes.data(), null_hash, out);
+      break;
+    case Type::INT16:
+      GatherDictionaryHashes<Int16Type>(indices, value_hashes.data(), null_hash, out);
+      break;
+    case Type::INT32:
+      GatherDictionaryHashes<Int32Type>(indices, value_hashes.data(), null_hash, out);
+      break;
+    case Type::INT64:
+      GatherDictionaryHashes<Int64Type>(indices, value_hashes.data(), null_hash, out);
+      break;
+    default:
+      return Status::NotImplemented("Dictionary indices must be signed integers");
+  }
+  return Status::OK();
+}
+
+// Hash the values of every slot, whether null or not. Arrays without value
+// buffers, which are empty or all null, are skipped
+Status HashValues(const Array& array, uint64_t seed, uint64_t* out) {
+  const Type::type type_id = array.type_id();
+  const int64_t length = array.length();
+  if (type_id == Type::BOOL) {
+    const auto& values = array.data()->buffers[1];
+    if (!values) { return Status::OK(); }
+    const uint8_t* bits = values->data();
+    const uint64_t hashes[2] = {HashUtil::HashInt(0, seed), HashUtil::HashInt(1, seed)};
+    for (int64_t i = 0; i < length; ++i) {
+      out[i] = hashes[BitUtil::GetBit(bits, array.offset() + i)];
+    }
+  } else if (type_id == Type::BINARY || type_id == Type::STRING) {
+    if (!array.data()->buffers[1]) { return Status::OK(); }
+    HashBinary(static_cast<const BinaryArray&>(array), seed, out);
+  } else if (type_id == Type::FIXED_SIZE_BINARY || type_id == Type::DECIMAL ||
+             is_primitive(type_id)) {
+    const int byte_width =
+        static_cast<const FixedWidthType&>(*array.type()).bit_width() / 8;
+    switch (byte_width) {
+      case 1:
+        HashFixedWidth<uint8_t>(array, seed, out);
+        break;
+      case 2:
+        HashFixedWidth<uint16_t>(array, seed, out);
+        break;
+      case 4:
+        HashFixedWidth<uint32_t>(array, seed, out);
+        break;
+      case 8:
+        HashFixedWidth<uint64_t>(array, seed, out);
+        break;
+      default: {
+        if (length == 0 || !array.data()->buffers[1]) { break; }
+        const uint8_t* values =
+            array.data()->buffers[1]->data() + array.offset() * byte_width;
+        HashFixedSize(values, byte_width, length, seed, out);
+      } break;
+    }
+  } else {
+    std::stringstream ss;
+    ss << "Hashing " << array.type()->ToString() << " values is not supported";
+    return Status::NotImplemented(ss.str());
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+uint64_t HashUtil::HashBytes(const void* data, int64_t length, uint64_t seed) {
+  static DynamicDispatch<HashBytesFunc> dispatch({
+      {DispatchLevel::NONE, HashUtil::HashBytesScalar},
+#ifdef ARROW_HAVE_RUNTIME_SSE4_2
+      {DispatchLevel::SSE4_2, HashBytesSse42},
+#endif
+  });
+  return dispatch.func(data, length, seed);
+}
+
+uint64_t HashUtil::HashBytesScalar(const void* data, int64_t length, uint64_t seed) {
+  return HashBytesImpl(
+      reinterpret_cast<const uint8_t*>(data), length, seed, TableCrc32c());
+}
+
+Status HashUtil::HashArray(const Array& array, uint64_t* out_hashes, uint64_t seed) {
+  const int64_t length = array.length();
+  const uint64_t null_hash = NullHash(seed);
+  if (array.type_id() == Type::NA) {
+    std::fill(out_hashes, out_hashes + length, null_hash);
+    return Status::OK();
+  }
+  if (array.type_id() == Type::DICTIONARY) {
+    return HashDictionary(static_cast<const DictionaryArray&>(array), seed, out_hashes);
+  }
+  RETURN_NOT_OK(HashValues(array, seed, out_hashes));
+  if (array.null_count() > 0) {
+    const uint8_t* null_bitmap = array.null_bitmap_data();
+    for (int64_t i = 0; i < length; ++i) {
+      if (!BitUtil::GetBit(null_bitmap, array.offset() + i)) {
+        out_hashes[i] = null_hash;
+      }
+    }
+  }
+  return Status::OK();
+}
+
+Status HashUtil::CombineHashArray(const Array& array, uint64_t* hashes) {
+  std::vector<uint64_t> column_hashes(array.length());
+  RETURN_NOT_OK(HashArray(array, column_hashes.data()));
+  for (int64_t i = 0; i < array.length(); ++i) {
+    hashes[i] = HashCombine64(column_hashes[i], hashes[i]);
+  }
+  return Status::OK();
+}
+
+}  // namespace arrow
@@ -26,11 +26,15 @@
 #include "arrow/util/cpu-info.h"
 #include "arrow/util/logging.h"
 #include "arrow/util/sse-util.h"
+#include "arrow/util/visibility.h"
 
 namespace arrow {
 
+class Array;
+class Status;
+
 /// Utility class to compute hash values.
-class HashUtil {
+class ARROW_EXPORT HashUtil {
  public:
   /// Compute the Crc32 hash for data using SSE4 instructions.  The input hash
   /// parameter is the current hash/seed value.
@@ -251,6 +255,69 @@ class HashUtil {
     const uint64_t hash2 = (static_cast<uint64_t>(hash) * m2 + a2) >> 32;
     return hash1 | (hash2 << 32);
   }
+
+  // ----------------------------------------------------------------------
+  // 64-bit hashes of values and of whole columns
+
+  /// The finalizer of MurmurHash3: a bijection spreading every input bit over
+  /// the whole result
+  static inline uint64_t Mix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+  }
+
+  /// Hash of an integer, a bijection for a given seed. Narrower integers are
+  /// hashed zero-extended
+  static inline uint64_t HashInt(uint64_t value, uint64_t seed) {
+    return Mix64(value ^ seed ^ 0x2545f4914f6cdd1dULL);
+  }
+
+  /// The hash HashArray() gives null slots
+  static inline uint64_t NullHash(uint64_t seed) {
+    return HashInt(seed, 0x9ae16a3b2f90404fULL);
+  }
+
+  /// Combine 64-bit hashes 'value' and 'seed', like HashCombine32()
+  static inline uint64_t HashCombine64(uint64_t value, uint64_t seed) {
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+  }
+
+  /// \brief Hash of a byte string
+  ///
+  /// Strings of up to 16 bytes are mixed as two words with HashInt(). Longer
+  /// strings go through CRC32C in three interleaved streams, which hides the
+  /// latency of the CRC instruction. The SSE4.2 instruction is used where the
+  /// CPU supports it and a lookup table otherwise, with the same result.
+  /// This is unrelated to the XXH64 object digests of Plasma, which are sent
+  /// between clients and stores and so must stay as they are
+  static uint64_t HashBytes(const void* data, int64_t length, uint64_t seed);
+
+  /// HashBytes() without SSE4.2, exposed for testing
+  static uint64_t HashBytesScalar(const void* data, int64_t length, uint64_t seed);
+
+  /// \brief Hash every slot of an array into out_hashes
+  ///
+  /// Fixed-width values are hashed by bit pattern with HashInt() (vectorized
+  /// with AVX2 where supported) or, if wider than 8 bytes, with HashBytes().
+  /// Booleans hash as the integers 0 and 1, binary and string values with
+  /// HashBytes(). Dictionary-encoded arrays hash like their decoded values.
+  /// All null slots hash to NullHash(seed). The hashes do not depend on the
+  /// CPU, so they may be used to partition data across processes
+  ///
+  /// \param[in] array the values to hash
+  /// \param[out] out_hashes array.length() hashes
+  /// \param[in] seed seed of the hash function
+  /// \return Status, NotImplemented for nested types
+  static Status HashArray(const Array& array, uint64_t* out_hashes, uint64_t seed = 0);
+
+  /// \brief Fold the hashes of the slots of array into hashes, computed by
+  /// HashArray() over another column of the same rows. Repeated over the
+  /// columns of a multi-column key, this gives a hash of every key
+  static Status CombineHashArray(const Array& array, uint64_t* hashes);
 };
 
 }  // namespace arrow
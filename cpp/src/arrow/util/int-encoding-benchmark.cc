@@ -0,0 +1,137 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include "arrow/buffer.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/test-util.h"
+#include "arrow/util/dispatch.h"
+#include "arrow/util/int-encoding.h"
+
+namespace arrow {
+
+static constexpr int kNumValues = 1 << 16;
+
+enum class Input { TIMESTAMPS = 0, SORTED = 1, SMALL = 2 };
+
+// Millisecond timestamps at steps of up to a second, sorted values of the full
+// int32 range and values of -100 to 100
+template <typename T>
+static std::vector<T> MakeInput(Input input) {
+  std::mt19937_64 gen(0);
+  std::vector<T> values(kNumValues);
+  if (input == Input::TIMESTAMPS) {
+    std::uniform_int_distribution<int64_t> step_dist(0, 1000);
+    int64_t timestamp = 1500000000000LL;
+    for (T& value : values) {
+      timestamp += step_dist(gen);
+      value = static_cast<T>(timestamp);
+    }
+  } else if (input == Input::SORTED) {
+    std::uniform_int_distribution<int32_t> dist;
+    for (T& value : values) {
+      value = dist(gen);
+    }
+    std::sort(values.begin(), values.end());
+  } else {
+    std::uniform_int_distribution<int32_t> dist(-100, 100);
+    for (T& value : values) {
+      value = static_cast<T>(dist(gen));
+    }
+  }
+  return values;
+}
+
+// Arguments: encoding, input
+static void EncodingArguments(benchmark::internal::Benchmark* bench) {
+  for (IntegerEncoding encoding : {IntegerEncoding::DELTA,
+           IntegerEncoding::FRAME_OF_REFERENCE, IntegerEncoding::ZIGZAG_VLQ}) {
+    for (Input input : {Input::TIMESTAMPS, Input::SORTED, Input::SMALL}) {
+      bench->Args({static_cast<int>(encoding), static_cast<int>(input)});
+    }
+  }
+}
+
+template <typename T>
+static void BM_EncodeIntegers(benchmark::State& state) {  // NOLINT non-const reference
+  const auto encoding = static_cast<IntegerEncoding>(state.range(0));
+  const std::vector<T> values = MakeInput<T>(static_cast<Input>(state.range(1)));
+  std::shared_ptr<Buffer> encoded;
+
+  while (state.KeepRunning()) {
+    ABORT_NOT_OK(EncodeIntegers(
+        default_memory_pool(), encoding, values.data(), kNumValues, &encoded));
+  }
+  state.SetBytesProcessed(state.iterations() * kNumValues * sizeof(T));
+  std::stringstream ss;
+  ss << 8.0 * encoded->size() / kNumValues << " bits/value";
+  state.SetLabel(ss.str());
+}
+
+template <typename T>
+static void BM_DecodeIntegers(benchmark::State& state) {  // NOLINT non-const reference
+  const auto encoding = static_cast<IntegerEncoding>(state.range(0));
+  const std::vector<T> values = MakeInput<T>(static_cast<Input>(state.range(1)));
+  std::shared_ptr<Buffer> encoded;
+  ABORT_NOT_OK(EncodeIntegers(
+      default_memory_pool(), encoding, values.data(), kNumValues, &encoded));
+  std::vector<T> decoded(kNumValues);
+
+  while (state.KeepRunning()) {
+    ABORT_NOT_OK(DecodeIntegers(encoded->data(), encoded->size(), decoded.data()));
+    benchmark::DoNotOptimize(decoded.data());
+  }
+  state.SetBytesProcessed(state.iterations() * kNumValues * sizeof(T));
+}
+
+template <typename T>
+static void BM_PrefixSum(benchmark::State& state) {  // NOLINT non-const reference
+  const auto level = static_cast<DispatchLevel>(state.range(0));
+  if (!IsDispatchLevelSupported(level)) {
+    state.SkipWithError("CPU does not support the dispatch level");
+    return;
+  }
+  std::vector<T> values = MakeInput<T>(Input::SMALL);
+
+  while (state.KeepRunning()) {
+    internal::PrefixSum(level, values.data(), kNumValues, static_cast<T>(0));
+    benchmark::DoNotOptimize(values.data());
+  }
+  state.SetBytesProcessed(state.iterations() * kNumValues * sizeof(T));
+}
+
+BENCHMARK_TEMPLATE(BM_EncodeIntegers, int32_t)->Apply(EncodingArguments);
+BENCHMARK_TEMPLATE(BM_EncodeIntegers, int64_t)->Apply(EncodingArguments);
+BENCHMARK_TEMPLATE(BM_DecodeIntegers, int32_t)->Apply(EncodingArguments);
+BENCHMARK_TEMPLATE(BM_DecodeIntegers, int64_t)->Apply(EncodingArguments);
+BENCHMARK_TEMPLATE(BM_PrefixSum, int32_t)
+    ->Arg(static_cast<int>(DispatchLevel::NONE))
+    ->Arg(static_cast<int>(DispatchLevel::AVX2));
+BENCHMARK_TEMPLATE(BM_PrefixSum, int64_t)
+    ->Arg(static_cast<int>(DispatchLevel::NONE))
+    ->Arg(static_cast<int>(DispatchLevel::AVX2));
+
+}  // namespace arrow
@@ -0,0 +1,195 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/util/int-encoding.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "arrow/buffer.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/test-util.h"
+#include "arrow/util/dispatch.h"
+
+namespace arrow {
+
+static const IntegerEncoding kEncodings[] = {IntegerEncoding::DELTA,
+    IntegerEncoding::FRAME_OF_REFERENCE, IntegerEncoding::ZIGZAG_VLQ};
+
+template <typename T>
+class TestIntegerEncoding : public ::testing::Test {
+ public:
+  std::shared_ptr<Buffer> Encode(IntegerEncoding encoding, const std::vector<T>& values) {
+    std::shared_ptr<Buffer> encoded;
+    EXPECT_OK(EncodeIntegers(default_memory_pool(), encoding, values.data(),
+        static_cast<int64_t>(values.size()), &encoded));
+    return encoded;
+  }
+
+  void CheckRoundTrip(IntegerEncoding encoding, const std::vector<T>& values) {
+    std::shared_ptr<Buffer> encoded = Encode(encoding, values);
+
+    IntegerEncoding header_encoding;
+    int byte_width;
+    int64_t num_values;
+    ASSERT_OK(ReadIntegerEncodingHeader(encoded->data(), encoded->size(),
+        &header_encoding, &byte_width, &num_values));
+    ASSERT_EQ(encoding, header_encoding);
+    ASSERT_EQ(static_cast<int>(sizeof(T)), byte_width);
+    ASSERT_EQ(static_cast<int64_t>(values.size()), num_values);
+
+    std::vector<T> decoded(values.size());
+    ASSERT_OK(DecodeIntegers(encoded->data(), encoded->size(), decoded.data()));
+    ASSERT_EQ(values, decoded);
+  }
+
+  void CheckRoundTrip(const std::vector<T>& values) {
+    for (IntegerEncoding encoding : kEncodings) {
+      CheckRoundTrip(encoding, values);
+    }
+  }
+
+  std::vector<T> Random(int64_t length, T min, T max) {
+    std::mt19937_64 gen(42);
+    std::uniform_int_distribution<T> dist(min, max);
+    std::vector<T> values(length);
+    for (T& value : values) {
+      value = dist(gen);
+    }
+    return values;
+  }
+};
+
+typedef ::testing::Types<int32_t, int64_t> IntegerTypes;
+TYPED_TEST_CASE(TestIntegerEncoding, IntegerTypes);
+
+TYPED_TEST(TestIntegerEncoding, EdgeCases) {
+  using T = TypeParam;
+  const T min = std::numeric_limits<T>::min();
+  const T max = std::numeric_limits<T>::max();
+  this->CheckRoundTrip({});
+  this->CheckRoundTrip({0});
+  this->CheckRoundTrip({min});
+  this->CheckRoundTrip({max, min, 0, -1, 1, max, max, min, min, -1});
+  this->CheckRoundTrip(std::vector<T>(1000, -7));
+}
+
+TYPED_TEST(TestIntegerEncoding, PartialBlocks) {
+  for (int64_t length : {1, 2, 127, 128, 129, 255, 256, 257, 1000}) {
+    this->CheckRoundTrip(this->Random(length, -1000, 1000));
+  }
+}
+
+TYPED_TEST(TestIntegerEncoding, FullRange) {
+  using T = TypeParam;
+  // Bit widths of up to 64, above 32 for int64
+  this->CheckRoundTrip(this->Random(
+      1000, std::numeric_limits<T>::min(), std::numeric_limits<T>::max()));
+  for (int bits = 1; bits < static_cast<int>(sizeof(T) * 8); bits += 3) {
+    const T bound = static_cast<T>((static_cast<uint64_t>(1) << bits) - 1);
+    this->CheckRoundTrip(this->Random(300, 0, bound));
+    this->CheckRoundTrip(this->Random(300, static_cast<T>(-bound), 0));
+  }
+}
+
+TYPED_TEST(TestIntegerEncoding, Monotonic) {
+  using T = TypeParam;
+  // Timestamps at irregular steps, and a decreasing sequence
+  std::vector<T> increasing, decreasing;
+  std::vector<T> steps = this->Random(2000, 1, 20);
+  T timestamp = static_cast<T>(sizeof(T) == 8 ? 1500000000000LL : 1500000000);
+  for (size_t i = 0; i < steps.size(); ++i) {
+    timestamp += steps[i];
+    increasing.push_back(timestamp);
+    decreasing.push_back(static_cast<T>(-3 * static_cast<int64_t>(i)));
+  }
+  this->CheckRoundTrip(increasing);
+  this->CheckRoundTrip(decreasing);
+
+  // Deltas of up to 20 take 5 bits per value, whatever the width of the values
+  const int64_t delta_size = this->Encode(IntegerEncoding::DELTA, increasing)->size();
+  ASSERT_LT(delta_size, static_cast<int64_t>(increasing.size()));
+  for (IntegerEncoding encoding :
+      {IntegerEncoding::FRAME_OF_REFERENCE, IntegerEncoding::ZIGZAG_VLQ}) {
+    ASSERT_LT(delta_size, this->Encode(encoding, increasing)->size());
+  }
+}
+
+TYPED_TEST(TestIntegerEncoding, SmallValues) {
+  // Mostly single-byte quantities, with longer ones in between
+  std::vector<TypeParam> values = this->Random(1000, -60, 60);
+  for (size_t i = 0; i < values.size(); i += 37) {
+    values[i] = static_cast<TypeParam>(values[i] * 1000);
+  }
+  this->CheckRoundTrip(values);
+  ASSERT_LT(this->Encode(IntegerEncoding::ZIGZAG_VLQ, values)->size(),
+      static_cast<int64_t>(values.size() * 2));
+}
+
+TYPED_TEST(TestIntegerEncoding, Invalid) {
+  using T = TypeParam;
+  using Other = typename std::conditional<sizeof(T) == 4, int64_t, int32_t>::type;
+  const std::vector<T> values = this->Random(300, -100000, 100000);
+  std::vector<T> decoded(values.size());
+  std::vector<Other> other(values.size());
+
+  for (IntegerEncoding encoding : kEncodings) {
+    std::shared_ptr<Buffer> encoded = this->Encode(encoding, values);
+    for (int64_t size = 0; size < encoded->size(); ++size) {
+      ASSERT_RAISES(Invalid, DecodeIntegers(encoded->data(), size, decoded.data()));
+    }
+    ASSERT_RAISES(
+        Invalid, DecodeIntegers(encoded->data(), encoded->size(), other.data()));
+
+    std::vector<uint8_t> corrupt(encoded->data(), encoded->data() + encoded->size());
+    const int64_t size = encoded->size();
+    corrupt[0] = 0;
+    ASSERT_RAISES(Invalid, DecodeIntegers(corrupt.data(), size, decoded.data()));
+    corrupt[0] = encoded->data()[0];
+    corrupt[1] = 2;
+    ASSERT_RAISES(Invalid, DecodeIntegers(corrupt.data(), size, decoded.data()));
+  }
+}
+
+TYPED_TEST(TestIntegerEncoding, PrefixSum) {
+  using T = TypeParam;
+  for (DispatchLevel level : {DispatchLevel::NONE, DispatchLevel::AVX2}) {
+    if (!IsDispatchLevelSupported(level)) { continue; }
+    for (int64_t length = 0; length < 40; ++length) {
+      // Sums wrap around
+      std::vector<T> values = this->Random(
+          length, std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+      std::vector<T> expected(values);
+      uint64_t sum = 12345;
+      for (T& value : expected) {
+        sum += static_cast<uint64_t>(value);
+        value = static_cast<T>(sum);
+      }
+      internal::PrefixSum(level, values.data(), length, static_cast<T>(12345));
+      ASSERT_EQ(expected, values) << "length " << length;
+    }
+  }
+}
+
+}  // namespace arrow
@@ -0,0 +1,473 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/util/int-encoding.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "arrow/util/dispatch.h"
+
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+#include <immintrin.h>
+#endif
+
+#include "arrow/buffer.h"
+#include "arrow/memory_pool.h"
+#include "arrow/status.h"
+#include "arrow/util/bit-stream-utils.h"
+#include "arrow/util/bit-util.h"
+#include "arrow/util/logging.h"
+
+namespace arrow {
+
+namespace {
+
+// Header: encoding, byte width and the number of values
+constexpr int64_t kMaxHeaderSize = 2 + BitReader::MAX_VLQ_BYTE_LEN_64;
+
+// A block: its reference, bit width and up to kIntegerEncodingBlockSize packed
+// values of up to 64 bits
+constexpr int kMaxBlockSize =
+    BitReader::MAX_VLQ_BYTE_LEN_64 + 1 + kIntegerEncodingBlockSize * 8;
+
+inline uint64_t ZigZag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t UnZigZag(uint64_t value) {
+  return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+}
+
+// The VLQ of the body of ZIGZAG_VLQ is written and read byte by byte rather
+// than through BitWriter and BitReader, whose lengths are limited to int
+
+inline uint8_t* PutVlq(uint64_t value, uint8_t* out) {
+  while (value >= 0x80) {
+    *out++ = static_cast<uint8_t>(value | 0x80);
+    value >>= 7;
+  }
+  *out++ = static_cast<uint8_t>(value);
+  return out;
+}
+
+// Returns nullptr if the quantity is truncated or longer than 10 bytes
+inline const uint8_t* GetVlq(const uint8_t* data, const uint8_t* end, uint64_t* value) {
+  uint64_t result = 0;
+  for (int shift = 0; shift < 7 * BitReader::MAX_VLQ_BYTE_LEN_64; shift += 7) {
+    if (data == end) { return nullptr; }
+    const uint8_t byte = *data++;
+    result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      *value = result;
+      return data;
+    }
+  }
+  return nullptr;
+}
+
+// ----------------------------------------------------------------------
+// Prefix sums
+
+template <typename U>
+using PrefixSumFunc = void (*)(U*, int64_t, U);
+
+template <typename U>
+void PrefixSumScalar(U* values, int64_t num_values, U initial) {
+  U sum = initial;
+  for (int64_t i = 0; i < num_values; ++i) {
+    sum += values[i];
+    values[i] = sum;
+  }
+}
+
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+// Eight sums at a time: a prefix sum within each 128-bit lane by shifts, the
+// last sum of the low lane added to the high lane, then the running total of
+// the previous vectors added to all
+ARROW_TARGET_AVX2 void PrefixSumAvx2(uint32_t* values, int64_t num_values,
+    uint32_t initial) {
+  const __m256i last_of_low_lane = _mm256_set1_epi32(3);
+  const __m256i last = _mm256_set1_epi32(7);
+  __m256i carry = _mm256_set1_epi32(static_cast<int>(initial));
+  int64_t i = 0;
+  for (; i + 8 <= num_values; i += 8) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+    x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+    x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+    const __m256i low_sum = _mm256_permutevar8x32_epi32(x, last_of_low_lane);
+    x = _mm256_add_epi32(x, _mm256_blend_epi32(_mm256_setzero_si256(), low_sum, 0xF0));
+    x = _mm256_add_epi32(x, carry);
+    carry = _mm256_permutevar8x32_epi32(x, last);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(values + i), x);
+  }
+  PrefixSumScalar(values + i, num_values - i,
+      static_cast<uint32_t>(_mm256_extract_epi32(carry, 0)));
+}
+
+ARROW_TARGET_AVX2 void PrefixSumAvx2(uint64_t* values, int64_t num_values,
+    uint64_t initial) {
+  __m256i carry = _mm256_set1_epi64x(static_cast<int64_t>(initial));
+  int64_t i = 0;
+  for (; i + 4 <= num_values; i += 4) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+    x = _mm256_add_epi64(x, _mm256_slli_si256(x, 8));
+    const __m256i low_sum = _mm256_permute4x64_epi64(x, 0x55);
+    x = _mm256_add_epi64(x, _mm256_blend_epi32(_mm256_setzero_si256(), low_sum, 0xF0));
+    x = _mm256_add_epi64(x, carry);
+    carry = _mm256_permute4x64_epi64(x, 0xFF);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(values + i), x);
+  }
+  PrefixSumScalar(values + i, num_values - i,
+      static_cast<uint64_t>(_mm256_extract_epi64(carry, 0)));
+}
+#endif
+
+template <typename U>
+DynamicDispatch<PrefixSumFunc<U>> PrefixSumDispatch(DispatchLevel max_level) {
+  return DynamicDispatch<PrefixSumFunc<U>>({
+      {DispatchLevel::NONE, PrefixSumScalar<U>},
+#ifdef ARROW_HAVE_RUNTIME_AVX2
+      {DispatchLevel::AVX2, static_cast<PrefixSumFunc<U>>(PrefixSumAvx2)},
+#endif
+  }, max_level);
+}
+
+template <typename U>
+void DispatchPrefixSum(U* values, int64_t num_values, U initial) {
+  static DynamicDispatch<PrefixSumFunc<U>> dispatch =
+      PrefixSumDispatch<U>(MaxDispatchLevel());
+  dispatch.func(values, num_values, initial);
+}
+
+// ----------------------------------------------------------------------
+// Bit-packed blocks
+
+// Write a block of values relative to reference, values of more than 32 bits
+// as their low 32 bits followed by their high bits. Returns the end of the
+// block
+template <typename U>
+uint8_t* PutBlock(const U* values, int num_values, U reference, uint8_t* out) {
+  using Signed = typename std::make_signed<U>::type;
+  U max_offset = 0;
+  for (int i = 0; i < num_values; ++i) {
+    max_offset |= static_cast<U>(values[i] - reference);
+  }
+  const int bit_width = BitUtil::NumRequiredBits(max_offset);
+
+  BitWriter writer(out, kMaxBlockSize);
+  bool ok = writer.PutZigZagVlqInt64(static_cast<Signed>(reference));
+  ok &= writer.PutAligned<uint8_t>(static_cast<uint8_t>(bit_width), 1);
+  if (bit_width > 0) {
+    const int low_width = std::min(bit_width, 32);
+    for (int i = 0; i < num_values; ++i) {
+      const uint64_t offset = static_cast<U>(values[i] - reference);
+      ok &= writer.PutValue(offset & BitUtil::TrailingBits(~0ULL, low_width), low_width);
+    }
+    for (int i = 0; bit_width > 32 && i < num_values; ++i) {
+      const uint64_t offset = static_cast<U>(values[i] - reference);
+      ok &= writer.PutValue(offset >> 32, bit_width - 32);
+    }
+  }
+  writer.Flush();
+  DCHECK(ok);
+  return out + writer.bytes_written();
+}
+
+// Read a block written by PutBlock. Returns nullptr if it is truncated or
+// malformed
+template <typename U>
+const uint8_t* GetBlock(const uint8_t* data, const uint8_t* end, int num_values,
+    U* values) {
+  const int size = static_cast<int>(std::min<int64_t>(end - data, kMaxBlockSize));
+  BitReader reader(data, size);
+  int64_t reference;
+  uint8_t bit_width;
+  if (!reader.GetZigZagVlqInt64(&reference) || !reader.GetAligned(1, &bit_width) ||
+      bit_width > sizeof(U) * 8) {
+    return nullptr;
+  }
+  if (bit_width == 0) {
+    std::fill(values, values + num_values, static_cast<U>(reference));
+    return data + size - reader.bytes_left();
+  }
+
+  uint32_t low[kIntegerEncodingBlockSize];
+  uint32_t* low_out =
+      sizeof(U) == 4 ? reinterpret_cast<uint32_t*>(values) : low;
+  const int low_width = std::min<int>(bit_width, 32);
+  if (reader.GetBatch(low_width, low_out, num_values) != num_values) { return nullptr; }
+  if (bit_width <= 32) {
+    for (int i = 0; i < num_values; ++i) {
+      values[i] = static_cast<U>(low_out[i] + static_cast<U>(reference));
+    }
+  } else {
+    uint32_t high[kIntegerEncodingBlockSize];
+    if (reader.GetBatch(bit_width - 32, high, num_values) != num_values) {
+      return nullptr;
+    }
+    for (int i = 0; i < num_values; ++i) {
+      const uint64_t offset = (static_cast<uint64_t>(high[i]) << 32) | low[i];
+      values[i] = static_cast<U>(offset + static_cast<U>(reference));
+    }
+  }
+  return data + size - reader.bytes_left();
+}
+
+// ----------------------------------------------------------------------
+// Encoders and decoders of the body, after the header
+
+template <typename U>
+uint8_t* EncodeDelta(const U* values, int64_t num_values, uint8_t* out) {
+  using Signed = typename std::make_signed<U>::type;
+  if (num_values == 0) { return out; }
+  out = PutVlq(ZigZag(static_cast<Signed>(values[0])), out);
+
+  U deltas[kIntegerEncodingBlockSize];
+  for (int64_t start = 1; start < num_values; start += kIntegerEncodingBlockSize) {
+    const int block_size = static_cast<int>(
+        std::min<int64_t>(kIntegerEncodingBlockSize, num_values - start));
+    // The smallest delta as a signed value, so that blocks mixing small
+    // increases and decreases pack into few bits
+    Signed min_delta = std::numeric_limits<Signed>::max();
+    for (int i = 0; i < block_size; ++i) {
+      deltas[i] = values[start + i] - values[start + i - 1];
+      min_delta = std::min(min_delta, static_cast<Signed>(deltas[i]));
+    }
+    out = PutBlock(deltas, block_size, static_cast<U>(min_delta), out);
+  }
+  return out;
+}
+
+template <typename U>
+const uint8_t* DecodeDelta(const uint8_t* data, const uint8_t* end,
+    int64_t num_values, U* values) {
+  if (num_values == 0) { return data; }
+  uint64_t first;
+  if ((data = GetVlq(data, end, &first)) == nullptr) { return nullptr; }
+  values[0] = static_cast<U>(UnZigZag(first));
+  for (int64_t start = 1; start < num_values; start += kIntegerEncodingBlockSize) {
+    const int block_size = static_cast<int>(
+        std::min<int64_t>(kIntegerEncodingBlockSize, num_values - start));
+    if ((data = GetBlock(data, end, block_size, values + start)) == nullptr) {
+      return nullptr;
+    }
+  }
+  DispatchPrefixSum(values + 1, num_values - 1, values[0]);
+  return data;
+}
+
+template <typename U>
+uint8_t* EncodeFrameOfReference(const U* values, int64_t num_values, uint8_t* out) {
+  using Signed = typename std::make_signed<U>::type;
+  for (int64_t start = 0; start < num_values; start += kIntegerEncodingBlockSize) {
+    const int block_size = static_cast<int>(
+        std::min<int64_t>(kIntegerEncodingBlockSize, num_values - start));
+    Signed reference = std::numeric_limits<Signed>::max();
+    for (int i = 0; i < block_size; ++i) {
+      reference = std::min(reference, static_cast<Signed>(values[start + i]));
+    }
+    out = PutBlock(values + start, block_size, static_cast<U>(reference), out);
+  }
+  return out;
+}
+
+template <typename U>
+const uint8_t* DecodeFrameOfReference(const uint8_t* data, const uint8_t* end,
+    int64_t num_values, U* values) {
+  for (int64_t start = 0; start < num_values; start += kIntegerEncodingBlockSize) {
+    const int block_size = static_cast<int>(
+        std::min<int64_t>(kIntegerEncodingBlockSize, num_values - start));
+    if ((data = GetBlock(data, end, block_size, values + start)) == nullptr) {
+      return nullptr;
+    }
+  }
+  return data;
+}
+
+template <typename U>
+uint8_t* EncodeZigZagVlq(const U* values, int64_t num_values, uint8_t* out) {
+  using Signed = typename std::make_signed<U>::type;
+  for (int64_t i = 0; i < num_values; ++i) {
+    out = PutVlq(ZigZag(static_cast<Signed>(values[i])), out);
+  }
+  return out;
+}
+
+template <typename U>
+const uint8_t* DecodeZigZagVlq(const uint8_t* data, const uint8_t* end,
+    int64_t num_values, U* values) {
+  int64_t i = 0;
+  while (i < num_values) {
+    // Runs of values of a single byte, eight at a time
+    uint64_t word;
+    if (end - data >= 8 && num_values - i >= 8) {
+      memcpy(&word, data, 8);
+      if ((word & 0x8080808080808080ULL) == 0) {
+        for (int k = 0; k < 8; ++k) {
+          values[i + k] = static_cast<U>(UnZigZag((word >> (8 * k)) & 0xFF));
+        }
+        data += 8;
+        i += 8;
+        continue;
+      }
+    }
+    if (end - data >= BitReader::MAX_VLQ_BYTE_LEN_64) {
+      // No bounds checks needed within the longest quantity
+      word = 0;
+      int shift = 0;
+      uint8_t byte;
+      do {
+        byte = *data++;
+        word |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        shift += 7;
+      } while ((byte & 0x80) != 0 && shift < 7 * BitReader::MAX_VLQ_BYTE_LEN_64);
+      if ((byte & 0x80) != 0) { return nullptr; }
+    } else if ((data = GetVlq(data, end, &word)) == nullptr) {
+      return nullptr;
+    }
+    values[i++] = static_cast<U>(UnZigZag(word));
+  }
+  return data;
+}
+
+int64_t MaxBodySize(IntegerEncoding encoding, int byte_width, int64_t num_values) {
+  if (encoding == IntegerEncoding::ZIGZAG_VLQ) {
+    return num_values * (byte_width == 4 ? BitReader::MAX_VLQ_BYTE_LEN
+                                         : BitReader::MAX_VLQ_BYTE_LEN_64);
+  }
+  const int64_t num_blocks = BitUtil::Ceil(num_values, kIntegerEncodingBlockSize);
+  return BitReader::MAX_VLQ_BYTE_LEN_64 +
+         num_blocks * (BitReader::MAX_VLQ_BYTE_LEN_64 + 1) + num_values * byte_width;
+}
+
+Status ReadHeader(const uint8_t* data, int64_t size, IntegerEncoding* encoding,
+    int* byte_width, int64_t* num_values, const uint8_t** body) {
+  uint64_t length;
+  if (size < 2 || (*body = GetVlq(data + 2, data + size, &length)) == nullptr) {
+    return Status::Invalid("Truncated integer encoding header");
+  }
+  if (data[0] < static_cast<uint8_t>(IntegerEncoding::DELTA) ||
+      data[0] > static_cast<uint8_t>(IntegerEncoding::ZIGZAG_VLQ)) {
+    return Status::Invalid("Unknown integer encoding");
+  }
+  if ((data[1] != 4 && data[1] != 8) ||
+      length > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+    return Status::Invalid("Malformed integer encoding header");
+  }
+  *encoding = static_cast<IntegerEncoding>(data[0]);
+  *byte_width = data[1];
+  *num_values = static_cast<int64_t>(length);
+  return Status::OK();
+}
+
+}  // namespace
+
+template <typename T>
+Status EncodeIntegers(MemoryPool* pool, IntegerEncoding encoding, const T* values,
+    int64_t num_values, std::shared_ptr<Buffer>* out) {
+  using U = typename std::make_unsigned<T>::type;
+  const U* unsigned_values = reinterpret_cast<const U*>(values);
+
+  auto buffer = std::make_shared<PoolBuffer>(pool);
+  RETURN_NOT_OK(buffer->Resize(
+      kMaxHeaderSize + MaxBodySize(encoding, sizeof(T), num_values), false));
+  uint8_t* data = buffer->mutable_data();
+  data[0] = static_cast<uint8_t>(encoding);
+  data[1] = static_cast<uint8_t>(sizeof(T));
+  uint8_t* end = PutVlq(static_cast<uint64_t>(num_values), data + 2);
+
+  switch (encoding) {
+    case IntegerEncoding::DELTA:
+      end = EncodeDelta(unsigned_values, num_values, end);
+      break;
+    case IntegerEncoding::FRAME_OF_REFERENCE:
+      end = EncodeFrameOfReference(unsigned_values, num_values, end);
+      break;
+    case IntegerEncoding::ZIGZAG_VLQ:
+      end = EncodeZigZagVlq(unsigned_values, num_values, end);
+      break;
+    default:
+      return Status::Invalid("Unknown integer encoding");
+  }
+  RETURN_NOT_OK(buffer->Resize(end - data));
+  *out = buffer;
+  return Status::OK();
+}
+
+Status ReadIntegerEncodingHeader(const uint8_t* data, int64_t size,
+    IntegerEncoding* encoding, int* byte_width, int64_t* num_values) {
+  const uint8_t* body;
+  return ReadHeader(data, size, encoding, byte_width, num_values, &body);
+}
+
+template <typename T>
+Status DecodeIntegers(const uint8_t* data, int64_t size, T* values) {
+  using U = typename std::make_unsigned<T>::type;
+  U* unsigned_values = reinterpret_cast<U*>(values);
+
+  IntegerEncoding encoding;
+  int byte_width;
+  int64_t num_values;
+  const uint8_t* body;
+  RETURN_NOT_OK(ReadHeader(data, size, &encoding, &byte_width, &num_values, &body));
+  if (byte_width != static_cast<int>(sizeof(T))) {
+    return Status::Invalid("Encoded integers are of another width");
+  }
+
+  const uint8_t* end = data + size;
+  switch (encoding) {
+    case IntegerEncoding::DELTA:
+      body = DecodeDelta(body, end, num_values, unsigned_values);
+      break;
+    case IntegerEncoding::FRAME_OF_REFERENCE:
+      body = DecodeFrameOfReference(body, end, num_values, unsigned_values);
+      break;
+    default:
+      body = DecodeZigZagVlq(body, end, num_values, unsigned_values);
+      break;
+  }
+  if (body == nullptr) {
+    return Status::Invalid("Truncated or malformed encoded integers");
+  }
+  return Status::OK();
+}
+
+template ARROW_EXPORT Status EncodeIntegers<int32_t>(
+    MemoryPool*, IntegerEncoding, const int32_t*, int64_t, std::shared_ptr<Buffer>*);
+template ARROW_EXPORT Status EncodeIntegers<int64_t>(
+    MemoryPool*, IntegerEncoding, const int64_t*, int64_t, std::shared_ptr<Buffer>*);
+template ARROW_EXPORT Status DecodeIntegers<int32_t>(const uint8_t*, int64_t, int32_t*);
+template ARROW_EXPORT Status DecodeIntegers<int64_t>(const uint8_t*, int64_t, int64_t*);
+
+namespace internal {
+
+template <typename T>
+void PrefixSum(DispatchLevel max_level, T* values, int64_t num_values, T initial) {
+  using U = typename std::make_unsigned<T>::type;
+  PrefixSumDispatch<U>(max_level).func(
+      reinterpret_cast<U*>(values), num_values, static_cast<U>(initial));
+}
+
+template ARROW_EXPORT void PrefixSum<int32_t>(DispatchLevel, int32_t*, int64_t, int32_t);
+template ARROW_EXPORT void PrefixSum<int64_t>(DispatchLevel, int64_t*, int64_t, int64_t);
+
+}  // namespace internal
+
+}  // namespace arrow
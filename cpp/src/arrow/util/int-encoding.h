@@ -0,0 +1,119 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+// Lightweight encodings of integer buffers: delta, frame of reference and
+// zig-zag variable-length quantities
+
+#ifndef ARROW_UTIL_INT_ENCODING_H
+#define ARROW_UTIL_INT_ENCODING_H
+
+#include <cstdint>
+#include <memory>
+
+#include "arrow/util/visibility.h"
+
+namespace arrow {
+
+class Buffer;
+class MemoryPool;
+class Status;
+
+enum class DispatchLevel : int;
+
+/// \brief Encodings of a buffer of 32 or 64-bit integers
+///
+/// An encoded buffer is self-describing. It starts with the encoding, the byte
+/// width of the values and their number, so it can be carried as an opaque
+/// body buffer and decoded without further metadata:
+///
+///   encoded := encoding:uint8 byte_width:uint8 vlq(num_values) body
+///
+/// Arithmetic wraps around, so every signed and unsigned value round trips.
+///
+/// The encodings are not an IPC BodyCompression codec. Which buffers they
+/// apply to depends on the type of every field, so readers in every Arrow
+/// implementation would need per-buffer metadata in Message.fbs.
+enum class IntegerEncoding : uint8_t {
+  /// Differences between consecutive values, bit-packed in blocks relative to
+  /// the smallest difference of the block:
+  ///
+  ///   body  := zigzag_vlq(first value) block*
+  ///   block := zigzag_vlq(min delta) bit_width:uint8 packed(delta - min delta)
+  ///
+  /// Sorted or monotonic columns with regular steps, such as timestamps and
+  /// sequence numbers, take a few bits per value.
+  DELTA = 1,
+  /// Values bit-packed in blocks relative to the smallest value of the block:
+  ///
+  ///   block := zigzag_vlq(min value) bit_width:uint8 packed(value - min value)
+  FRAME_OF_REFERENCE = 2,
+  /// Every value mapped to unsigned by zig-zag (0, -1, 1, -2, ... to 0, 1, 2,
+  /// 3, ...) and written as a variable-length quantity of 7 bits per byte.
+  /// Suits values of small magnitude
+  ZIGZAG_VLQ = 3
+};
+
+/// \brief Number of values per bit-packed block of the DELTA and
+/// FRAME_OF_REFERENCE encodings. Packed values of widths above 32 bits are
+/// stored as their low 32 bits followed by the high bits
+constexpr int kIntegerEncodingBlockSize = 128;
+
+/// \brief Encode int32_t or int64_t values into a newly allocated buffer
+///
+/// \param[in] pool memory pool to allocate the result from
+/// \param[in] encoding the encoding to use
+/// \param[in] values the values to encode
+/// \param[in] num_values the number of values
+/// \param[out] out the encoded buffer
+/// \return Status
+template <typename T>
+ARROW_EXPORT Status EncodeIntegers(MemoryPool* pool, IntegerEncoding encoding,
+    const T* values, int64_t num_values, std::shared_ptr<Buffer>* out);
+
+/// \brief Read the header of an encoded buffer
+///
+/// \return Status, Invalid if the header is truncated or malformed
+ARROW_EXPORT Status ReadIntegerEncodingHeader(const uint8_t* data, int64_t size,
+    IntegerEncoding* encoding, int* byte_width, int64_t* num_values);
+
+/// \brief Decode a buffer of encoded int32_t or int64_t values
+///
+/// Bit-packed blocks are unpacked with the SIMD kernels of unpack32, and
+/// deltas are accumulated with a vectorized prefix sum.
+///
+/// \param[in] data the encoded buffer
+/// \param[in] size its size in bytes
+/// \param[out] values room for the number of values given in the header
+/// \return Status, Invalid if the buffer is truncated or malformed, or holds
+/// values of another width than T
+template <typename T>
+ARROW_EXPORT Status DecodeIntegers(const uint8_t* data, int64_t size, T* values);
+
+namespace internal {
+
+/// \brief Replace every value by initial plus the sum of the values up to and
+/// including it, with the kernels of at most max_level, which the CPU must
+/// support. For testing the kernels against each other
+template <typename T>
+ARROW_EXPORT void PrefixSum(
+    DispatchLevel max_level, T* values, int64_t num_values, T initial);
+
+}  // namespace internal
+
+}  // namespace arrow
+
+#endif  // ARROW_UTIL_INT_ENCODING_H
@@ -0,0 +1,69 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "arrow/util/parallel.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "arrow/status.h"
+#include "arrow/test-util.h"
+
+namespace arrow {
+
+TEST(ParallelFor, RunsEveryTaskOnce) {
+  for (int num_threads : {0, 1, 2, 7}) {
+    std::vector<std::atomic<int>> counts(1000);
+    for (auto& count : counts) {
+      count = 0;
+    }
+    ASSERT_OK(ParallelFor(num_threads, 1000, [&](int64_t task) {
+      ++counts[task];
+      return Status::OK();
+    }));
+    for (const auto& count : counts) {
+      ASSERT_EQ(1, count.load());
+    }
+  }
+  ASSERT_OK(ParallelFor(4, 0, [](int64_t task) { return Status::Invalid("no tasks"); }));
+}
+
+TEST(ParallelFor, ReturnsError) {
+  for (int num_threads : {1, 4}) {
+    std::atomic<int64_t> num_run(0);
+    Status s = ParallelFor(num_threads, 1000, [&](int64_t task) {
+      ++num_run;
+      return task == 10 ? Status::IOError("task 10") : Status::OK();
+    });
+    ASSERT_TRUE(s.IsIOError());
+    ASSERT_EQ("task 10", s.message());
+    // Tasks stop being handed out after the error
+    ASSERT_LT(num_run.load(), 1000);
+  }
+}
+
+TEST(ParallelFor, NumThreads) {
+  ASSERT_EQ(1, GetNumThreads(8, 1));
+  ASSERT_EQ(1, GetNumThreads(8, 0));
+  ASSERT_EQ(3, GetNumThreads(3, 100));
+  ASSERT_GE(GetNumThreads(0, 100), 1);
+}
+
+}  // namespace arrow
@@ -0,0 +1,89 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef ARROW_UTIL_PARALLEL_H
+#define ARROW_UTIL_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "arrow/status.h"
+
+namespace arrow {
+
+/// \brief The number of threads to use for num_tasks independent tasks when
+/// num_threads are requested, 0 meaning one per hardware thread
+inline int GetNumThreads(int num_threads, int64_t num_tasks) {
+  if (num_threads <= 0) {
+    num_threads = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  return static_cast<int>(
+      std::max<int64_t>(1, std::min<int64_t>(num_threads, num_tasks)));
+}
+
+/// \brief Call func(task) for every task in [0, num_tasks) on up to
+/// num_threads threads (see GetNumThreads), tasks being handed out in order
+/// as threads become free. With a single thread the tasks run on the calling
+/// thread. Stops handing out tasks after the first error, which is returned
+template <typename Function>
+Status ParallelFor(int num_threads, int64_t num_tasks, Function&& func) {
+  num_threads = GetNumThreads(num_threads, num_tasks);
+  if (num_threads == 1) {
+    for (int64_t task = 0; task < num_tasks; ++task) {
+      RETURN_NOT_OK(func(task));
+    }
+    return Status::OK();
+  }
+
+  std::atomic<int64_t> task_counter(0);
+  std::atomic<bool> error_occurred(false);
+  std::mutex error_mtx;
+  Status error;
+
+  auto work = [&]() {
+    while (!error_occurred.load()) {
+      const int64_t task = task_counter.fetch_add(1);
+      if (task >= num_tasks) { break; }
+      Status s = func(task);
+      if (!s.ok()) {
+        std::lock_guard<std::mutex> lock(error_mtx);
+        if (!error_occurred.exchange(true)) { error = s; }
+        break;
+      }
+    }
+  };
+
+  std::vector<std::thread> thread_pool;
+  thread_pool.reserve(num_threads - 1);
+  for (int i = 0; i < num_threads - 1; ++i) {
+    thread_pool.emplace_back(work);
+  }
+  // The calling thread takes part
+  work();
+  for (auto&& thread : thread_pool) {
+    thread.join();
+  }
+  return error;
+}
+
+}  // namespace arrow
+
+#endif  // ARROW_UTIL_PARALLEL_H
@@ -0,0 +1,150 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "arrow/util/bit-util.h"
+#include "arrow/util/rle-encoding.h"
+
+namespace arrow {
+
+static constexpr int kNumValues = 1 << 16;
+
+// kNumValues values of bit_width bits, in runs of mean_run values on average
+static std::vector<int32_t> RunsInput(int bit_width, int mean_run) {
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int32_t> value_dist(0, (1 << bit_width) - 1);
+  std::geometric_distribution<int> run_dist(1.0 / mean_run);
+  std::vector<int32_t> values;
+  while (static_cast<int>(values.size()) < kNumValues) {
+    const int run = std::min(
+        1 + run_dist(gen), kNumValues - static_cast<int>(values.size()));
+    values.insert(values.end(), run, value_dist(gen));
+  }
+  return values;
+}
+
+static std::vector<uint8_t> Encode(const std::vector<int32_t>& values, int bit_width) {
+  const int len = RleEncoder::MaxBufferSize(bit_width, kNumValues) +
+                  RleEncoder::MinBufferSize(bit_width);
+  std::vector<uint8_t> buffer(len);
+  RleEncoder encoder(buffer.data(), len, bit_width);
+  encoder.PutBatch(values.data(), kNumValues);
+  buffer.resize(encoder.Flush());
+  return buffer;
+}
+
+// Arguments: bit width, mean run length
+static void RunsArguments(benchmark::internal::Benchmark* bench) {
+  for (int bit_width : {1, 4, 8, 16}) {
+    for (int mean_run : {1, 8, 64, 1024}) {
+      bench->Args({bit_width, mean_run});
+    }
+  }
+}
+
+static void BM_RleEncodePut(benchmark::State& state) {  // NOLINT non-const reference
+  const int bit_width = static_cast<int>(state.range(0));
+  const std::vector<int32_t> values =
+      RunsInput(bit_width, static_cast<int>(state.range(1)));
+  const int len = RleEncoder::MaxBufferSize(bit_width, kNumValues) +
+                  RleEncoder::MinBufferSize(bit_width);
+  std::vector<uint8_t> buffer(len);
+
+  while (state.KeepRunning()) {
+    RleEncoder encoder(buffer.data(), len, bit_width);
+    for (int32_t value : values) {
+      encoder.Put(value);
+    }
+    benchmark::DoNotOptimize(encoder.Flush());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+static void BM_RleEncodePutBatch(benchmark::State& state) {  // NOLINT non-const reference
+  const int bit_width = static_cast<int>(state.range(0));
+  const std::vector<int32_t> values =
+      RunsInput(bit_width, static_cast<int>(state.range(1)));
+  const int len = RleEncoder::MaxBufferSize(bit_width, kNumValues) +
+                  RleEncoder::MinBufferSize(bit_width);
+  std::vector<uint8_t> buffer(len);
+
+  while (state.KeepRunning()) {
+    RleEncoder encoder(buffer.data(), len, bit_width);
+    encoder.PutBatch(values.data(), kNumValues);
+    benchmark::DoNotOptimize(encoder.Flush());
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+static void BM_RleDecodeGetBatch(benchmark::State& state) {  // NOLINT non-const reference
+  const int bit_width = static_cast<int>(state.range(0));
+  const std::vector<uint8_t> encoded =
+      Encode(RunsInput(bit_width, static_cast<int>(state.range(1))), bit_width);
+  std::vector<int32_t> values(kNumValues);
+
+  while (state.KeepRunning()) {
+    RleDecoder decoder(encoded.data(), static_cast<int>(encoded.size()), bit_width);
+    benchmark::DoNotOptimize(decoder.GetBatch(values.data(), kNumValues));
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+// One null in every 10 slots
+static void BM_RleDecodeDictSpaced(benchmark::State& state) {  // NOLINT non-const ref
+  const int bit_width = static_cast<int>(state.range(0));
+  const int num_valid = kNumValues - kNumValues / 10;
+  std::vector<int32_t> indices = RunsInput(bit_width, static_cast<int>(state.range(1)));
+  indices.resize(num_valid);
+  const int len = RleEncoder::MaxBufferSize(bit_width, num_valid) +
+                  RleEncoder::MinBufferSize(bit_width);
+  std::vector<uint8_t> encoded(len);
+  RleEncoder encoder(encoded.data(), len, bit_width);
+  encoder.PutBatch(indices.data(), num_valid);
+  const int encoded_len = encoder.Flush();
+
+  std::vector<uint8_t> valid_bits(BitUtil::BytesForBits(kNumValues), 0);
+  int null_count = 0;
+  for (int i = 0; i < kNumValues; ++i) {
+    if (i % 10 == 9 && null_count < kNumValues - num_valid) {
+      ++null_count;
+    } else {
+      BitUtil::SetBit(valid_bits.data(), i);
+    }
+  }
+  std::vector<double> dictionary(1 << bit_width, 1.5);
+  std::vector<double> values(kNumValues);
+
+  while (state.KeepRunning()) {
+    RleDecoder decoder(encoded.data(), encoded_len, bit_width);
+    benchmark::DoNotOptimize(decoder.GetBatchWithDictSpaced(dictionary.data(),
+        values.data(), kNumValues, null_count, valid_bits.data(), 0));
+  }
+  state.SetItemsProcessed(state.iterations() * kNumValues);
+}
+
+BENCHMARK(BM_RleEncodePut)->Apply(RunsArguments);
+BENCHMARK(BM_RleEncodePutBatch)->Apply(RunsArguments);
+BENCHMARK(BM_RleDecodeGetBatch)->Apply(RunsArguments);
+BENCHMARK(BM_RleDecodeDictSpaced)->Apply(RunsArguments);
+
+}  // namespace arrow
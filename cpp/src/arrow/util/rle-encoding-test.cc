@@ -24,6 +24,7 @@
 
 #include <boost/utility.hpp>
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <random>
@@ -457,4 +458,116 @@ TEST(BitRle, Overflow) {
   }
 }
 
+// Runs of random values whose lengths follow a geometric distribution
+static vector<int> RandomRuns(int num_values, int bit_width, double mean_run, int seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> value_dist(0, (1 << bit_width) - 1);
+  std::geometric_distribution<int> run_dist(1.0 / mean_run);
+  vector<int> values;
+  while (static_cast<int>(values.size()) < num_values) {
+    const int value = value_dist(gen);
+    const int run =
+        std::min(1 + run_dist(gen), num_values - static_cast<int>(values.size()));
+    values.insert(values.end(), run, value);
+  }
+  return values;
+}
+
+TEST(Rle, PutBatchMatchesPut) {
+  const int kNumValues = 5000;
+  for (int bit_width : {1, 2, 3, 8, 13, 20, 30}) {
+    for (double mean_run : {1.0, 4.0, 12.0, 100.0}) {
+      const vector<int> values = RandomRuns(kNumValues, bit_width, mean_run, bit_width);
+      const int len = RleEncoder::MaxBufferSize(bit_width, kNumValues) +
+                      RleEncoder::MinBufferSize(bit_width);
+
+      vector<uint8_t> expected(len);
+      RleEncoder put_encoder(expected.data(), len, bit_width);
+      for (int value : values) {
+        ASSERT_TRUE(put_encoder.Put(value));
+      }
+      const int expected_len = put_encoder.Flush();
+
+      // Split the batch so that state carries over between calls
+      vector<uint8_t> actual(len);
+      RleEncoder batch_encoder(actual.data(), len, bit_width);
+      ASSERT_EQ(777, batch_encoder.PutBatch(values.data(), 777));
+      ASSERT_EQ(kNumValues - 777,
+          batch_encoder.PutBatch(values.data() + 777, kNumValues - 777));
+      ASSERT_EQ(expected_len, batch_encoder.Flush());
+      ASSERT_EQ(expected, actual)
+          << "bit_width=" << bit_width << " mean_run=" << mean_run;
+    }
+  }
+}
+
+TEST(Rle, PutBatchOverflow) {
+  for (int bit_width : {1, 5, 17}) {
+    const vector<int> values = RandomRuns(10000, bit_width, 3.0, 0);
+    const int len = RleEncoder::MinBufferSize(bit_width) * 4;
+
+    vector<uint8_t> expected(len);
+    RleEncoder put_encoder(expected.data(), len, bit_width);
+    int num_put = 0;
+    while (put_encoder.Put(values[num_put])) {
+      ++num_put;
+    }
+
+    vector<uint8_t> actual(len);
+    RleEncoder batch_encoder(actual.data(), len, bit_width);
+    ASSERT_EQ(num_put, batch_encoder.PutBatch(values.data(), 10000));
+    ASSERT_EQ(put_encoder.Flush(), batch_encoder.Flush());
+    ASSERT_EQ(expected, actual);
+  }
+}
+
+TEST(Rle, GetBatchWithDictSpaced) {
+  const int kNumValues = 3000;
+  const int bit_width = 4;
+  const vector<double> dictionary = {0.5, 1.5, 2.5, 3.5, 4.5, 5.5, 6.5, 7.5, 8.5, 9.5,
+      10.5, 11.5, 12.5, 13.5, 14.5, 15.5};
+  std::mt19937 gen(42);
+
+  for (double mean_run : {1.0, 10.0, 200.0}) {
+    for (double null_probability : {0.0, 0.1, 0.6, 1.0}) {
+      std::bernoulli_distribution null_dist(null_probability);
+      vector<uint8_t> valid_bits(BitUtil::BytesForBits(kNumValues + 3), 0);
+      vector<int> valid_slots;
+      for (int i = 0; i < kNumValues; ++i) {
+        if (!null_dist(gen)) {
+          BitUtil::SetBit(valid_bits.data(), i + 3);
+          valid_slots.push_back(i);
+        }
+      }
+      const int num_valid = static_cast<int>(valid_slots.size());
+      const vector<int> indices = RandomRuns(num_valid, bit_width, mean_run, num_valid);
+
+      const int len = RleEncoder::MaxBufferSize(bit_width, num_valid) +
+                      RleEncoder::MinBufferSize(bit_width);
+      vector<uint8_t> buffer(len);
+      RleEncoder encoder(buffer.data(), len, bit_width);
+      ASSERT_EQ(num_valid, encoder.PutBatch(indices.data(), num_valid));
+      const int encoded_len = encoder.Flush();
+
+      // Decode in two batches starting at bit offset 3 of the bitmap
+      RleDecoder decoder(buffer.data(), encoded_len, bit_width);
+      vector<double> values(kNumValues);
+      const int split = 1234;
+      const int first_valid = static_cast<int>(
+          std::lower_bound(valid_slots.begin(), valid_slots.end(), split) -
+          valid_slots.begin());
+      ASSERT_EQ(split, decoder.GetBatchWithDictSpaced(dictionary.data(), values.data(),
+                           split, split - first_valid, valid_bits.data(), 3));
+      ASSERT_EQ(kNumValues - split,
+          decoder.GetBatchWithDictSpaced(dictionary.data(), values.data() + split,
+              kNumValues - split, kNumValues - split - (num_valid - first_valid),
+              valid_bits.data(), 3 + split));
+      for (int i = 0; i < num_valid; ++i) {
+        ASSERT_EQ(dictionary[indices[i]], values[valid_slots[i]])
+            << "mean_run=" << mean_run << " null_probability=" << null_probability;
+      }
+    }
+  }
+}
+
 }  // namespace arrow
@@ -119,7 +119,9 @@ class RleDecoder {
   template <typename T>
   int GetBatchWithDict(const T* dictionary, T* values, int batch_size);
 
-  /// Like GetBatchWithDict but add spacing for null entries
+  /// Like GetBatchWithDict but add spacing for null entries. Whole runs are
+  /// decoded at once, the validity bitmap being read a word at a time; null
+  /// slots are left unspecified
   template <typename T>
   int GetBatchWithDictSpaced(const T* dictionary, T* values, int batch_size,
       int null_count, const uint8_t* valid_bits, int64_t valid_bits_offset);
@@ -199,6 +201,16 @@ class RleEncoder {
   /// This value must be representable with bit_width_ bits.
   bool Put(uint64_t value);
 
+  /// Encode a batch of values, producing the same output as calling Put() on
+  /// each. Returns the number of values encoded, less than num_values if the
+  /// buffer filled up.
+  ///
+  /// Long repeated runs are skipped over with a vectorizable scan instead of
+  /// value by value, and groups of 8 values that cannot start a repeated run
+  /// are added to the literal run at once.
+  template <typename T>
+  int PutBatch(const T* values, int num_values);
+
   /// Flushes any pending values to the underlying buffer.
   /// Returns the total number of bytes written
   int Flush();
@@ -343,6 +355,32 @@ inline int RleDecoder::GetBatchWithDict(const T* dictionary, T* values, int batc
   return values_read;
 }
 
+namespace internal {
+
+/// Number of slots from bit_offset on, at most max_slots, up to and including
+/// the num_valid-th set bit of the bitmap. All max_slots if there are fewer
+static inline int SpanOfSetBits(
+    const uint8_t* bitmap, int64_t bit_offset, int max_slots, int num_valid) {
+  int span = 0;
+  while (span < max_slots) {
+    const int num_bits = std::min(64, max_slots - span);
+    uint64_t word = BitUtil::LoadBitmapWord(bitmap, bit_offset + span, num_bits);
+    const int count = BitUtil::Popcount(word);
+    if (count < num_valid) {
+      num_valid -= count;
+      span += num_bits;
+      continue;
+    }
+    for (; num_valid > 1; --num_valid) {
+      word &= word - 1;
+    }
+    return span + BitUtil::CountTrailingZeros(word) + 1;
+  }
+  return span;
+}
+
+}  // namespace internal
+
 template <typename T>
 inline int RleDecoder::GetBatchWithDictSpaced(const T* dictionary, T* values,
     int batch_size, int null_count, const uint8_t* valid_bits,
@@ -350,68 +388,57 @@ inline int RleDecoder::GetBatchWithDictSpaced(const T* dictionary, T* values,
   DCHECK_GE(bit_width_, 0);
   int values_read = 0;
   int remaining_nulls = null_count;
-  INIT_BITSET(valid_bits, static_cast<int>(valid_bits_offset));
 
   while (values_read < batch_size) {
-    bool is_valid = (bitset_valid_bits & (1 << bit_offset_valid_bits)) != 0;
-    READ_NEXT_BITSET(valid_bits);
+    const int remaining_valid = batch_size - values_read - remaining_nulls;
+    if (remaining_valid == 0) {
+      // Only nulls are left
+      return batch_size;
+    }
+    if ((repeat_count_ == 0) && (literal_count_ == 0)) {
+      if (!NextCounts<T>()) return values_read;
+    }
 
-    if (is_valid) {
-      if ((repeat_count_ == 0) && (literal_count_ == 0)) {
-        if (!NextCounts<T>()) return values_read;
-      }
-      if (repeat_count_ > 0) {
-        T value = dictionary[current_value_];
-        // The current index is already valid, we don't need to check that again
-        int repeat_batch = 1;
-        repeat_count_--;
-
-        while (repeat_count_ > 0 && (values_read + repeat_batch) < batch_size) {
-          if (bitset_valid_bits & (1 << bit_offset_valid_bits)) {
-            repeat_count_--;
-          } else {
-            remaining_nulls--;
-          }
-          repeat_batch++;
-
-          READ_NEXT_BITSET(valid_bits);
-        }
-        std::fill(values + values_read, values + values_read + repeat_batch, value);
-        values_read += repeat_batch;
-      } else if (literal_count_ > 0) {
-        int literal_batch = std::min(
-            batch_size - values_read - remaining_nulls, static_cast<int>(literal_count_));
-
-        // Decode the literals
-        constexpr int kBufferSize = 1024;
-        int indices[kBufferSize];
-        literal_batch = std::min(literal_batch, kBufferSize);
-        int actual_read = bit_reader_.GetBatch(bit_width_, &indices[0], literal_batch);
-        DCHECK_EQ(actual_read, literal_batch);
-
-        int skipped = 0;
-        int literals_read = 1;
-        values[values_read] = dictionary[indices[0]];
-
-        // Read the first bitset to the end
-        while (literals_read < literal_batch) {
-          if (bitset_valid_bits & (1 << bit_offset_valid_bits)) {
-            values[values_read + literals_read + skipped] =
-                dictionary[indices[literals_read]];
-            literals_read++;
-          } else {
-            skipped++;
-          }
-
-          READ_NEXT_BITSET(valid_bits);
+    const int64_t bit_offset = valid_bits_offset + values_read;
+    const int max_slots = batch_size - values_read;
+    if (repeat_count_ > 0) {
+      // Fill the whole span of the run, nulls included
+      const int num_valid = std::min(remaining_valid, static_cast<int>(repeat_count_));
+      const int span =
+          internal::SpanOfSetBits(valid_bits, bit_offset, max_slots, num_valid);
+      std::fill(
+          values + values_read, values + values_read + span, dictionary[current_value_]);
+      repeat_count_ -= num_valid;
+      remaining_nulls -= span - num_valid;
+      values_read += span;
+    } else {
+      // Decode the literals, then spread them over the valid slots without
+      // branching on validity: every slot is written, but only a valid one
+      // moves on to the next literal
+      constexpr int kBufferSize = 1024;
+      int indices[kBufferSize];
+      const int num_valid = std::min(
+          std::min(remaining_valid, static_cast<int>(literal_count_)), kBufferSize);
+      int actual_read = bit_reader_.GetBatch(bit_width_, &indices[0], num_valid);
+      DCHECK_EQ(actual_read, num_valid);
+
+      T* out = values + values_read;
+      int decoded = 0;
+      int span = 0;
+      while (decoded < num_valid && span < max_slots) {
+        const int num_bits = std::min(64, max_slots - span);
+        const uint64_t word =
+            BitUtil::LoadBitmapWord(valid_bits, bit_offset + span, num_bits);
+        int k = 0;
+        for (; k < num_bits && decoded < num_valid; ++k) {
+          out[span + k] = dictionary[indices[decoded]];
+          decoded += static_cast<int>((word >> k) & 1);
         }
-        literal_count_ -= literal_batch;
-        values_read += literal_batch + skipped;
-        remaining_nulls -= skipped;
+        span += k;
       }
-    } else {
-      values_read++;
-      remaining_nulls--;
+      literal_count_ -= num_valid;
+      remaining_nulls -= span - num_valid;
+      values_read += span;
     }
   }
 
@@ -473,6 +500,60 @@ inline bool RleEncoder::Put(uint64_t value) {
   return true;
 }
 
+namespace internal {
+
+/// Number of leading values equal to value. The values are compared in blocks
+/// of 8 whose differences are or'ed together, which the compiler vectorizes
+template <typename T>
+inline int RunLength(const T* values, int num_values, uint64_t value) {
+  int i = 0;
+  for (; i + 8 <= num_values; i += 8) {
+    uint64_t diff = 0;
+    for (int j = 0; j < 8; ++j) {
+      diff |= static_cast<uint64_t>(values[i + j]) ^ value;
+    }
+    if (diff != 0) { break; }
+  }
+  while (i < num_values && static_cast<uint64_t>(values[i]) == value) {
+    ++i;
+  }
+  return i;
+}
+
+}  // namespace internal
+
+template <typename T>
+inline int RleEncoder::PutBatch(const T* values, int num_values) {
+  int i = 0;
+  while (i < num_values) {
+    if (UNLIKELY(buffer_full_)) { break; }
+    if (repeat_count_ > 8) {
+      // Continuation of a repeated run that Put() would not buffer
+      const int run = internal::RunLength(values + i, num_values - i, current_value_);
+      repeat_count_ += run;
+      i += run;
+      if (i == num_values) { break; }
+    } else if (repeat_count_ == 0 && num_buffered_values_ == 0 && i + 8 <= num_values &&
+               internal::RunLength(values + i, 8, static_cast<uint64_t>(values[i])) < 8) {
+      // A group of 8 values that are not all equal is flushed as literals,
+      // after which Put() would have reset the repeat count
+      for (int j = 0; j < 8; ++j) {
+        DCHECK(bit_width_ == 64 ||
+               static_cast<uint64_t>(values[i + j]) < (1ULL << bit_width_));
+        buffered_values_[j] = static_cast<uint64_t>(values[i + j]);
+      }
+      current_value_ = static_cast<uint64_t>(values[i + 7]);
+      num_buffered_values_ = 8;
+      FlushBufferedValues(false);
+      i += 8;
+      continue;
+    }
+    Put(static_cast<uint64_t>(values[i]));
+    ++i;
+  }
+  return i;
+}
+
 inline void RleEncoder::FlushLiteralRun(bool update_indicator_byte) {
   if (literal_indicator_byte_ == NULL) {
     // The literal indicator byte has not been reserved yet, get one now.
@@ -39,6 +39,7 @@ static const int CHARS_PER_128_BIT_REGISTER = 16;
 /// GCC's _SIDD_CMP_EQUAL_ANY, etc).
 static const int PCMPSTR_EQUAL_ANY = 0x00;     // strchr
 static const int PCMPSTR_EQUAL_EACH = 0x08;    // strcmp
+static const int PCMPSTR_EQUAL_ORDERED = 0x0C;  // strstr
 static const int PCMPSTR_UBYTE_OPS = 0x00;     // unsigned char (8-bits, rather than 16)
 static const int PCMPSTR_NEG_POLARITY = 0x10;  // see Intel SDM chapter 4.1.4.
 
@@ -51,6 +52,11 @@ static const int STRCHR_MODE = PCMPSTR_EQUAL_ANY | PCMPSTR_UBYTE_OPS;
 static const int STRCMP_MODE =
     PCMPSTR_EQUAL_EACH | PCMPSTR_UBYTE_OPS | PCMPSTR_NEG_POLARITY;
 
+/// In this mode, SSE text processing functions will return the index of the
+/// first position where the needle matches the haystack, including partial
+/// matches running off the end of the haystack.
+static const int STRSTR_MODE = PCMPSTR_EQUAL_ORDERED | PCMPSTR_UBYTE_OPS;
+
 /// Precomputed mask values up to 16 bits.
 static const int SSE_BITMASK[CHARS_PER_128_BIT_REGISTER] = {
     1 << 0, 1 << 1, 1 << 2, 1 << 3, 1 << 4, 1 << 5, 1 << 6, 1 << 7, 1 << 8, 1 << 9,
@@ -54,6 +54,8 @@ ARRAY_VISITOR_DEFAULT(ListArray);
 ARRAY_VISITOR_DEFAULT(StructArray);
 ARRAY_VISITOR_DEFAULT(UnionArray);
 ARRAY_VISITOR_DEFAULT(DictionaryArray);
+ARRAY_VISITOR_DEFAULT(RunEndEncodedArray);
+ARRAY_VISITOR_DEFAULT(BitPackedArray);
 
 Status ArrayVisitor::Visit(const DecimalArray& array) {
   return Status::NotImplemented("decimal");
@@ -94,5 +96,7 @@ TYPE_VISITOR_DEFAULT(ListType);
 TYPE_VISITOR_DEFAULT(StructType);
 TYPE_VISITOR_DEFAULT(UnionType);
 TYPE_VISITOR_DEFAULT(DictionaryType);
+TYPE_VISITOR_DEFAULT(RunEndEncodedType);
+TYPE_VISITOR_DEFAULT(BitPackedType);
 
 }  // namespace arrow
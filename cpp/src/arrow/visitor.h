@@ -55,6 +55,8 @@ class ARROW_EXPORT ArrayVisitor {
   virtual Status Visit(const StructArray& array);
   virtual Status Visit(const UnionArray& array);
   virtual Status Visit(const DictionaryArray& type);
+  virtual Status Visit(const RunEndEncodedArray& array);
+  virtual Status Visit(const BitPackedArray& array);
 };
 
 class ARROW_EXPORT TypeVisitor {
@@ -88,6 +90,8 @@ class ARROW_EXPORT TypeVisitor {
   virtual Status Visit(const StructType& type);
   virtual Status Visit(const UnionType& type);
   virtual Status Visit(const DictionaryType& type);
+  virtual Status Visit(const RunEndEncodedType& type);
+  virtual Status Visit(const BitPackedType& type);
 };
 
 }  // namespace arrow
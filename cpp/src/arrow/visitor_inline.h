@@ -59,6 +59,8 @@ inline Status VisitTypeInline(const DataType& type, VISITOR* visitor) {
     TYPE_VISIT_INLINE(StructType);
     TYPE_VISIT_INLINE(UnionType);
     TYPE_VISIT_INLINE(DictionaryType);
+    TYPE_VISIT_INLINE(RunEndEncodedType);
+    TYPE_VISIT_INLINE(BitPackedType);
     default:
       break;
   }
@@ -98,6 +100,8 @@ inline Status VisitArrayInline(const Array& array, VISITOR* visitor) {
     ARRAY_VISIT_INLINE(StructType);
     ARRAY_VISIT_INLINE(UnionType);
     ARRAY_VISIT_INLINE(DictionaryType);
+    ARRAY_VISIT_INLINE(RunEndEncodedType);
+    ARRAY_VISIT_INLINE(BitPackedType);
     default:
       break;
   }